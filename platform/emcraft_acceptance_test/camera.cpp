@@ -3,7 +3,7 @@
 
 #include <royale/ICameraDevice.hpp>
 
-#include <CameraFactory.hpp>
+#include <FrameSource.hpp>
 
 using namespace royale;
 using namespace platform;
@@ -93,6 +93,12 @@ Camera::CameraError Camera::RunAccessLevelTests(int user_level)
 
 Camera::CameraError Camera::RunUseCaseTests()
 {
+    if (IsReplay())
+    {
+        std::clog << "[WARNING] Ignoring RunUseCaseTests() - a recording can't be changed. " << std::endl;
+        return NONE;
+    }
+
     // Test retrieval of use cases / current use case
     royale::Vector<royale::String> use_cases;
     royale::CameraStatus status = camera_->getUseCases(use_cases);
@@ -159,6 +165,12 @@ Camera::CameraError Camera::RunUseCaseTests()
 
 Camera::CameraError Camera::RunExposureTests()
 {
+    if (IsReplay())
+    {
+        std::clog << "[WARNING] Ignoring RunExposureTests() - a recording can't be changed. " << std::endl;
+        return NONE;
+    }
+
     // Set Auto Exposure
     royale::CameraStatus status = camera_->setExposureMode(royale::ExposureMode::AUTOMATIC);
     if (status != royale::CameraStatus::SUCCESS)
@@ -205,6 +217,12 @@ Camera::CameraError Camera::RunExposureTests()
 
 Camera::CameraError Camera::RunProcessingParametersTests()
 {
+    if (IsReplay())
+    {
+        std::clog << "[WARNING] Ignoring RunProcessingParametersTests() - a recording can't be changed. " << std::endl;
+        return NONE;
+    }
+
     // Must be level 2.
     if (access_level_ < 2)
     {
@@ -1,13 +1,19 @@
 #ifndef __CAMERA_H__
 #define __CAMERA_H__
 
+#include <memory>
 #include <string>
 
+#include <FrameSource.hpp>
+
 class Camera : public royale::IDepthDataListener
 {
 private:
     void onNewData(const royale::DepthData *data) override;
-    std::unique_ptr<royale::ICameraDevice> camera_; // The camera device
+    // A recording can't be reconfigured, the tests that change settings are skipped for it
+    bool IsReplay() const { return source_ != nullptr && !source_->isLive(); }
+    std::unique_ptr<platform::FrameSource> source_; // The live camera or the replayed recording
+    royale::ICameraDevice *camera_;                 // The camera device
     int access_level_;
     std::string id_;                                // Unique ID for the camera device
     std::string use_case_;                          // Camera use_case_
@@ -27,8 +33,9 @@ public:
     };
 
     Camera() : camera_(nullptr) {};
-    Camera(std::unique_ptr<royale::ICameraDevice> c)
-        : camera_(std::move(c))
+    Camera(std::unique_ptr<platform::FrameSource> s)
+        : source_(std::move(s)),
+          camera_(source_ ? &source_->device() : nullptr)
     {};
     inline const std::string GetID() const { return id_; }
 
@@ -1,7 +1,8 @@
+#include <getopt.h>
 #include <iostream>
 #include <string>
 #include <royale/ICameraDevice.hpp>
-#include <CameraFactory.hpp>
+#include <FrameSource.hpp>
 
 using namespace std;
 using namespace royale;
@@ -12,15 +13,33 @@ const bool EXIT_ON_ERROR = true;
 
 int main(int argc, char **argv)
 {
+    // -s, --source live|<file.rrf> selects the live camera (default) or a recording to replay
+    std::string source = FrameSource::LIVE;
+    const struct option long_options[] = {{"source", required_argument, nullptr, 's'}, {nullptr, 0, nullptr, 0}};
+    int opt;
+    while ((opt = getopt_long(argc, argv, "s:", long_options, nullptr)) != -1)
+    {
+        if (opt != 's')
+        {
+            std::cerr << "Usage: " << argv[0] << " [-s|--source live|<file.rrf>] [access code]" << std::endl;
+            return 1;
+        }
+        source = optarg;
+    }
+
     std::string ACCESS_CODE;
-    if (argc >= 2)
+    const int num_positional = argc - optind;
+    if (num_positional >= 3)
     {
         // ACCESS_CODE = argv[1]; //Running.G Edit 
-        ACCESS_CODE = argv[3]; 
+        ACCESS_CODE = argv[optind + 2];
+    }
+    else if (num_positional >= 1)
+    {
+        ACCESS_CODE = argv[optind];
     }
 
-    CameraFactory factory;
-    Camera cam = Camera(factory.createCamera());
+    Camera cam = Camera(FrameSource::create(source));
 
     // [Setup] Camera Initialization Test
     Camera::CameraError error = cam.RunInitializeTests();
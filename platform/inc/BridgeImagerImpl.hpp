@@ -13,11 +13,12 @@
 #include <memory>
 
 #include <hal/IBridgeImager.hpp>
+#include <hal/IBridgeImagerTransactionCost.hpp>
 #include <pal/Access2I2cDeviceAdapter.hpp>
 
 namespace platform
 {
-    class BridgeImagerImpl : public royale::hal::IBridgeImager
+    class BridgeImagerImpl : public royale::hal::IBridgeImager, public royale::hal::IBridgeImagerTransactionCost
     {
     public:
         BridgeImagerImpl(std::shared_ptr<royale::pal::Access2I2cDeviceAdapter> i2c_adapter);
@@ -34,6 +35,8 @@ namespace platform
         void writeImagerBurst (uint16_t firstRegAddr, const std::vector<uint16_t> &values) override;
 
         void sleepFor (std::chrono::microseconds sleepDuration) override;
+
+        royale::hal::BridgeImagerTransactionCost getTransactionCost() const override;
     private:
         std::shared_ptr<royale::pal::Access2I2cDeviceAdapter> m_adapter;
     };
@@ -0,0 +1,96 @@
+/****************************************************************************\
+* Copyright (C) 2019 pmdtechnologies ag
+*
+* THIS CODE AND INFORMATION ARE PROVIDED "AS IS" WITHOUT WARRANTY OF ANY
+* KIND, EITHER EXPRESSED OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE
+* IMPLIED WARRANTIES OF MERCHANTABILITY AND/OR FITNESS FOR A
+* PARTICULAR PURPOSE.
+*
+\****************************************************************************/
+
+#pragma once
+
+#include <royale/Definitions.hpp>
+#include <royale/ICameraDevice.hpp>
+
+#include <chrono>
+#include <memory>
+#include <string>
+
+namespace platform
+{
+    /**
+     * Where the test and calibration tools get their frames from: the live camera, or a
+     * recording (.rrf) that is replayed.
+     *
+     * A replay runs as fast as the tool consumes the frames.  The tool's data listener calls
+     * admitFrame() for each new frame, and the tool calls requestFrame() before it waits for the
+     * next one.  A replay delivers exactly one frame per request and doesn't skip any, so the
+     * results only depend on the recording and are the same on every run.  For the live camera
+     * admitFrame() always returns true and requestFrame() does nothing, the tools behave as
+     * before.
+     */
+    class FrameSource
+    {
+    public:
+        /** The source name for the live camera, this is also used for an empty name */
+        ROYALE_API static const char *const LIVE;
+
+        /**
+         * Creates the source named on the command line, either LIVE or the file name of a
+         * recording.  Returns nullptr if the camera or playback device couldn't be created.
+         */
+        ROYALE_API static std::unique_ptr<FrameSource> create (const std::string &source);
+
+        ROYALE_API virtual ~FrameSource() = default;
+
+        /**
+         * The camera device, for a replay this is a playback device.  It stays owned by the
+         * FrameSource.
+         */
+        ROYALE_API royale::ICameraDevice &device();
+
+        /**
+         * True for the live camera.  A replay can't change the use case, exposure or
+         * processing parameters, it uses the ones that were recorded.
+         */
+        ROYALE_API virtual bool isLive() const = 0;
+
+        /**
+         * Waits for the camera to settle after starting it or changing a setting.  A replay
+         * doesn't need to wait and returns immediately.
+         */
+        ROYALE_API virtual void settle (std::chrono::milliseconds time) = 0;
+
+        /**
+         * Stops the capture.  Use this instead of device().stopCapture(), a replay may be
+         * waiting in admitFrame() and has to be released first.
+         */
+        ROYALE_API virtual royale::CameraStatus stopCapture();
+
+        /**
+         * Called by the consumer before waiting for a frame.  Requests don't add up, until the
+         * listener has admitted a frame more requests have no effect.
+         */
+        ROYALE_API virtual void requestFrame() = 0;
+
+        /**
+         * Called by the data listener for each new frame, before it takes any lock that the
+         * consumer holds while calling requestFrame().  The listener ignores the frame if this
+         * returns false.  A replay waits here until a frame is requested, which also holds the
+         * playback back until the consumer is ready.
+         */
+        ROYALE_API virtual bool admitFrame() = 0;
+
+        /**
+         * True when a replay has delivered all frames of the recording.  Always false for the
+         * live camera.
+         */
+        ROYALE_API virtual bool isFinished() const = 0;
+
+    protected:
+        explicit FrameSource (std::unique_ptr<royale::ICameraDevice> device);
+
+        std::unique_ptr<royale::ICameraDevice> m_device;
+    };
+}
@@ -0,0 +1,112 @@
+/****************************************************************************\
+* Copyright (C) 2019 pmdtechnologies ag
+*
+* THIS CODE AND INFORMATION ARE PROVIDED "AS IS" WITHOUT WARRANTY OF ANY
+* KIND, EITHER EXPRESSED OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE
+* IMPLIED WARRANTIES OF MERCHANTABILITY AND/OR FITNESS FOR A
+* PARTICULAR PURPOSE.
+*
+\****************************************************************************/
+
+#pragma once
+
+#include <pal/II2cDeviceAccess.hpp>
+
+#include <chrono>
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <vector>
+
+namespace platform
+{
+    /**
+    * One step of bringing up a device which is configured over I2C (the ds90ub95x serializer and
+    * deserializer, and the imager behind them).
+    *
+    * Devices with 8-bit register addresses have 8-bit values, devices with 16-bit register
+    * addresses have 16-bit big-endian values.
+    */
+    struct I2cInitStep
+    {
+        enum class Kind
+        {
+            WRITE,          ///< write value to reg
+            WAIT_FOR_VALUE, ///< read reg until (reg & mask) == value, or any of values, or until time has passed
+            DELAY           ///< sleep for time, for hold times that can't be read back
+        };
+
+        Kind kind;
+        bool address16;
+        uint16_t reg;
+        uint16_t mask;
+        uint16_t value;
+        std::chrono::microseconds time;
+        std::string description;
+        std::vector<uint16_t> values;   ///< if not empty, WAIT_FOR_VALUE accepts any of these (value is the first)
+
+        static I2cInitStep write8 (uint8_t reg, uint8_t value);
+        static I2cInitStep write16 (uint16_t reg, uint16_t value);
+        static I2cInitStep waitFor8 (uint8_t reg, uint8_t mask, uint8_t value,
+                                     std::chrono::microseconds timeout, const std::string &description);
+        static I2cInitStep waitFor16 (uint16_t reg, uint16_t mask, uint16_t value,
+                                      std::chrono::microseconds timeout, const std::string &description);
+        /**
+        * Waits until the register reads as one of the values, e.g. one of the known design steps
+        * of an imager.
+        */
+        static I2cInitStep waitForAny16 (uint16_t reg, const std::vector<uint16_t> &values,
+                                         std::chrono::microseconds timeout, const std::string &description);
+        static I2cInitStep delay (std::chrono::microseconds duration);
+
+        /**
+        * True if a WAIT_FOR_VALUE step would be finished by reading readValue.
+        */
+        bool accepts (uint16_t readValue) const;
+    };
+
+    using I2cInitSequence = std::vector<I2cInitStep>;
+
+    /**
+    * Executes an I2cInitSequence.
+    *
+    * WAIT_FOR_VALUE steps read the register immediately and then with exponentially growing
+    * delays, so a device which is already ready costs one read instead of a fixed sleep.  The
+    * step's timeout is the longest time that will be waited, it should be the worst case from
+    * the data sheet.
+    *
+    * The sleep function can be replaced, so that tests can run the sequences on a simulated
+    * clock.
+    */
+    class I2cInitSequenceRunner
+    {
+    public:
+        using SleepFunction = std::function<void (std::chrono::microseconds)>;
+
+        /**
+        * \param sleep function used for all waiting, if empty std::this_thread::sleep_for is used
+        */
+        explicit I2cInitSequenceRunner (SleepFunction sleep = SleepFunction());
+
+        /**
+        * Runs all steps of the sequence.  A WAIT_FOR_VALUE step which times out is logged and
+        * the remaining steps are still executed, the same as the previous fixed-sleep bring-up
+        * did when a device didn't respond in time.
+        *
+        * \return true if all WAIT_FOR_VALUE steps saw the expected value
+        */
+        bool run (royale::pal::II2cDeviceAccess &device, const I2cInitSequence &sequence);
+
+        /**
+        * Executes a single step.
+        *
+        * \return false if the step was a WAIT_FOR_VALUE and it timed out
+        */
+        bool runStep (royale::pal::II2cDeviceAccess &device, const I2cInitStep &step);
+
+    private:
+        bool readMatches (royale::pal::II2cDeviceAccess &device, const I2cInitStep &step);
+
+        SleepFunction m_sleep;
+    };
+}
@@ -0,0 +1,81 @@
+/****************************************************************************\
+* Copyright (C) 2019 pmdtechnologies ag
+*
+* THIS CODE AND INFORMATION ARE PROVIDED "AS IS" WITHOUT WARRANTY OF ANY
+* KIND, EITHER EXPRESSED OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE
+* IMPLIED WARRANTIES OF MERCHANTABILITY AND/OR FITNESS FOR A
+* PARTICULAR PURPOSE.
+*
+\****************************************************************************/
+
+#pragma once
+
+#include <royale/Definitions.hpp>
+
+#include <running_stat_planes.hpp>
+
+#include <cstddef>
+#include <ostream>
+#include <utility>
+
+namespace platform
+{
+    /**
+     * The per-pixel statistics over all frames of a test, as tof-testing checks them against
+     * its limits.  Only the pixels that were valid in at least minSamples frames are included.
+     */
+    struct TemporalDepthMetrics
+    {
+        std::size_t pixelCount = 0u;
+        float depthPrecision = 0.0f;            //!< Mean of the pixels' standard deviation of the depth
+        float depthPrecisionQ90 = 0.0f;         //!< The pixels' standard deviation at the 90th percentile
+        float depthAccuracy = 0.0f;             //!< Mean difference of the pixels' mean depth to the ground truth
+        float depthAccuracyPercent = 0.0f;
+        float depthAccuracyPercentQ90 = 0.0f;
+        float amplitudeStdDev = 0.0f;           //!< Mean of the pixels' standard deviation of the amplitude
+        float amplitudeMean = 0.0f;
+        float amplitudeMin = 10000.0f;          //!< Lowest mean amplitude of a pixel
+        float amplitudeMax = -10000.0f;         //!< Highest mean amplitude of a pixel
+
+        ROYALE_API static TemporalDepthMetrics compute (const RunningStatPlanes &depth,
+                const RunningStatPlanes &amplitude,
+                float minSamples,
+                float groundTruthDistance);
+    };
+
+    /**
+     * Writes the result lines of the test tools.  A measurement that is checked is written as
+     * "[PASS]:Name:value" or "[FAIL]:Name:value", one that isn't as "[INFO]:Name:value".  The
+     * values use the formatting of the stream.  A group of tests ends with a "[SUCCESS]" line, or
+     * a "[SKIPPED]" line if it couldn't run.
+     */
+    class TestReport
+    {
+    public:
+        ROYALE_API explicit TestReport (std::ostream &os);
+
+        /**
+         * Passes if the value is within the limits, which may be given in either order.
+         */
+        ROYALE_API bool check (const char *name, float value, const std::pair<float, float> &limits);
+
+        /**
+         * For a check that isn't a range, the caller has already decided if it passed.
+         */
+        ROYALE_API bool check (const char *name, int value, bool passed);
+
+        ROYALE_API void info (const char *name, float value);
+
+        ROYALE_API void groupPassed (const char *group);
+        ROYALE_API void groupSkipped (const char *group, const char *reason);
+
+        /**
+         * The number of checks that failed so far.
+         */
+        ROYALE_API std::size_t failures() const;
+
+    private:
+        std::ostream &m_os;
+        std::size_t m_failures;
+    };
+}
@@ -147,6 +147,8 @@ static const std::pair<int, int> kRowDetectionBounds(20, 149);
 static const std::pair<int, int> kColDetectionBounds(20, 200);
 //  Threshold the span of the detected LDS signal to maximize resolution, set to 85% of kColDetectionBounds
 static const float kLdsPtsPlaneFitMinRange = 153.0f;
+// Detected LDS points closer to each other than this distance (in pixels) are duplicates, only one of them is used for the fit
+static const double kDuplicatePointDistance(0.1);
 // Sensor Parameter settings
 static const royale::ProcessingParameterPair NOISE_THRESHOLD({royale::ProcessingFlag::NoiseThreshold_Float, 0.01f});
 static const royale::ProcessingParameterPair AUTO_EXPOSURE_REF_VALUE({royale::ProcessingFlag::AutoExposureRefValue_Float, 1000.0f});
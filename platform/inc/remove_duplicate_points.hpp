@@ -0,0 +1,187 @@
+/*
+ * Copyright (c) 2019, Neato Robotics, Inc.. All Rights Reserved.
+ *
+ * This file may contain contributions from others.
+ *
+ * This software is proprietary to Neato Robotics, Inc. and its transference
+ * and use is to be strictly controlled.
+ * Transference of this software to another party requires that all of the
+ * following conditions be met:
+ * 	A)	Neato has a copy of a signed NDA agreement with the receiving
+ *      party
+ * 	B)	Neato Software Engineering has explicitly authorized the
+ *      receiving party to have a copy of this software
+ * 	C)	When the work is completed or terminated by the receiving party,
+ *      all copies of this software that the receiving party holds must be
+ *      returned to Neato, or destroyed.
+ * The receiving party is under legal obligation to not disclose or  transfer
+ * this software.
+ * The receiving party may not appropriate, transform or re-use this software
+ * for any purpose other than a Neato Robotics authorized purpose.
+ */
+
+/**
+ * Removal of points that are closer to each other than a given distance, with a uniform grid as
+ * spatial index.
+ *
+ * Gives exactly the result of the quadratic algorithm that pmd-tof-calibration used before:
+ * going through the points from the front, a point is removed if any point behind it is closer
+ * than the distance, and its place is taken by the last point.  The removed points end up at the
+ * back and are erased.  The grid cells are as wide as the distance, so the points to compare with
+ * are in the 3 x 3 cells around a point.  The points that are kept are never closer than the
+ * distance to each other, so each cell only holds a few of them, and with the removed points
+ * taken out of the grid this is close to linear in the number of points.
+ */
+#ifndef INCLUDE_REMOVE_DUPLICATE_POINTS_H_
+#define INCLUDE_REMOVE_DUPLICATE_POINTS_H_
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+/**
+ * Removes the points that have another point closer than distance, see above.  Point is any type
+ * with x and y members, e.g. cv::Point2d.  The order of the remaining points is deterministic and
+ * the same as with the quadratic algorithm.
+ */
+template <typename Point>
+void RemoveDuplicatePoints(std::vector<Point>& points, double distance) {
+  const size_t size = points.size();
+  if (size < 2u || !(distance > 0.0)) {
+    return;
+  }
+
+  // The points sorted by cell, each cell is a range of members.  Removed points are swapped to
+  // the end of their cell's range, which then gets shorter.
+  typedef std::pair<int64_t, int64_t> Cell;
+  struct Entry {
+    Cell cell;
+    size_t id;
+    bool operator<(const Entry& other) const {
+      return (cell != other.cell) ? cell < other.cell : id < other.id;
+    }
+  };
+  std::vector<Entry> sorted(size);
+  for (size_t id = 0u; id < size; ++id) {
+    sorted[id].cell = Cell(static_cast<int64_t>(std::floor(points[id].x / distance)),
+                           static_cast<int64_t>(std::floor(points[id].y / distance)));
+    sorted[id].id = id;
+  }
+  std::sort(sorted.begin(), sorted.end());
+
+  std::vector<Cell> cells;
+  std::vector<size_t> cell_begin;
+  std::vector<size_t> cell_count;
+  std::vector<size_t> members(size);
+  std::vector<size_t> cell_index(size);
+  std::vector<size_t> slot(size);
+  cells.reserve(size);
+  cell_begin.reserve(size);
+  cell_count.reserve(size);
+  for (size_t k = 0u; k < size; ++k) {
+    const size_t id = sorted[k].id;
+    if (cells.empty() || cells.back() != sorted[k].cell) {
+      cells.push_back(sorted[k].cell);
+      cell_begin.push_back(k);
+      cell_count.push_back(0u);
+    }
+    members[k] = id;
+    cell_index[id] = cells.size() - 1u;
+    slot[id] = k;
+    ++cell_count.back();
+  }
+  std::vector<Entry>().swap(sorted);
+
+  // For each cell, the first cell of each of the three neighbouring columns.  The cells of a
+  // column are consecutive, so the neighbours are found by walking from there.  The start
+  // cells grow with c, so one cursor per column finds them in a single pass.
+  std::vector<size_t> first_neighbour(3u * cells.size());
+  for (size_t column = 0u; column < 3u; ++column) {
+    const int64_t dx = static_cast<int64_t>(column) - 1;
+    size_t cursor = 0u;
+    for (size_t c = 0u; c < cells.size(); ++c) {
+      const Cell start(cells[c].first + dx, cells[c].second - 1);
+      while (cursor < cells.size() && cells[cursor] < start) {
+        ++cursor;
+      }
+      first_neighbour[3u * c + column] = cursor;
+    }
+  }
+
+  // at[i] is the original index of the point at position i, pos is the inverse
+  std::vector<size_t> at(size);
+  std::vector<size_t> pos(size);
+  for (size_t id = 0u; id < size; ++id) {
+    at[id] = id;
+    pos[id] = id;
+  }
+
+  const auto cell_has_neighbour_behind = [&](size_t n, size_t id, size_t i) {
+    const auto& p = points[id];
+    for (size_t k = cell_begin[n]; k < cell_begin[n] + cell_count[n]; ++k) {
+      const size_t other = members[k];
+      if (pos[other] > i) {
+        const double x = p.x - points[other].x;
+        const double y = p.y - points[other].y;
+        if (std::sqrt(x * x + y * y) < distance) {
+          return true;
+        }
+      }
+    }
+    return false;
+  };
+
+  // Most close points are in the point's own cell, so that is searched first.  In dense
+  // clusters this avoids going through whole cells of points that are just out of reach.
+  const auto has_neighbour_behind = [&](size_t id, size_t i) {
+    const size_t c = cell_index[id];
+    if (cell_has_neighbour_behind(c, id, i)) {
+      return true;
+    }
+    for (int64_t dx = -1; dx <= 1; ++dx) {
+      const Cell last(cells[c].first + dx, cells[c].second + 1);
+      for (size_t n = first_neighbour[3u * c + static_cast<size_t>(dx + 1)]; n < cells.size() && !(last < cells[n]); ++n) {
+        if (n != c && cell_has_neighbour_behind(n, id, i)) {
+          return true;
+        }
+      }
+    }
+    return false;
+  };
+
+  size_t active = size;
+  size_t i = 0u;
+  while (i < active) {
+    const size_t id = at[i];
+    if (!has_neighbour_behind(id, i)) {
+      ++i;
+      continue;
+    }
+
+    // Move the last active point to position i, and check it next
+    const size_t last = at[active - 1u];
+    at[i] = last;
+    pos[last] = i;
+    at[active - 1u] = id;
+    pos[id] = active - 1u;
+    --active;
+
+    const size_t c = cell_index[id];
+    const size_t moved = members[cell_begin[c] + cell_count[c] - 1u];
+    members[slot[id]] = moved;
+    slot[moved] = slot[id];
+    --cell_count[c];
+  }
+
+  std::vector<Point> kept;
+  kept.reserve(active);
+  for (size_t k = 0u; k < active; ++k) {
+    kept.push_back(points[at[k]]);
+  }
+  points.swap(kept);
+}
+
+#endif
@@ -0,0 +1,203 @@
+/*
+ * Copyright (c) 2019, Neato Robotics, Inc.. All Rights Reserved.
+ *
+ * This file may contain contributions from others.
+ *
+ * This software is proprietary to Neato Robotics, Inc. and its transference
+ * and use is to be strictly controlled.
+ * Transference of this software to another party requires that all of the
+ * following conditions be met:
+ * 	A)	Neato has a copy of a signed NDA agreement with the receiving
+ *      party
+ * 	B)	Neato Software Engineering has explicitly authorized the
+ *      receiving party to have a copy of this software
+ * 	C)	When the work is completed or terminated by the receiving party,
+ *      all copies of this software that the receiving party holds must be
+ *      returned to Neato, or destroyed.
+ * The receiving party is under legal obligation to not disclose or  transfer
+ * this software.
+ * The receiving party may not appropriate, transform or re-use this software
+ * for any purpose other than a Neato Robotics authorized purpose.
+ */
+
+/**
+ * Running mean, standard deviation, min and max for every pixel of an image.
+ *
+ * Does the same as a std::vector<RunningStat> with one entry per pixel, but keeps each quantity
+ * in its own contiguous plane and updates a whole frame in one pass.  The update loops have no
+ * branches and no dependencies between pixels, so the compiler turns them into SIMD code.  The
+ * sums are kept in double, with thousands of frames the float sums of RunningStat lose several
+ * digits of the mean.
+ */
+#ifndef INCLUDE_RUNNING_STAT_PLANES_H_
+#define INCLUDE_RUNNING_STAT_PLANES_H_
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <thread>
+#include <vector>
+
+class RunningStatPlanes {
+ public:
+  explicit RunningStatPlanes(size_t size = 0u) { Resize(size); }
+
+  // Changes the number of pixels, and clears all values
+  void Resize(size_t size) {
+    m_n.resize(size);
+    m_mean.resize(size);
+    m_m2.resize(size);
+    m_min.resize(size);
+    m_max.resize(size);
+    Clear();
+  }
+
+  void Clear() {
+    std::fill(m_n.begin(), m_n.end(), 0.0);
+    std::fill(m_mean.begin(), m_mean.end(), 0.0);
+    std::fill(m_m2.begin(), m_m2.end(), 0.0);
+    std::fill(m_min.begin(), m_min.end(), std::numeric_limits<float>::infinity());
+    std::fill(m_max.begin(), m_max.end(), -std::numeric_limits<float>::infinity());
+  }
+
+  size_t Size() const { return m_n.size(); }
+
+  // Adds values[i] to pixel i, for all pixels
+  void Push(const float* values) { Push(values, nullptr, 0u, Size()); }
+
+  // Adds values[i] to pixel i, for the pixels where valid[i] is not zero.  All values must be
+  // finite, also those of the invalid pixels.
+  void Push(const float* values, const uint8_t* valid) { Push(values, valid, 0u, Size()); }
+
+  /**
+   * Adds values[i] to pixel i for the pixels begin <= i < end, and only where valid[i] is not
+   * zero if valid isn't null.  values and valid point to the whole frame.  The values of the
+   * invalid pixels are read as well, and must not be inf or NaN.  Calls for non-overlapping
+   * ranges may run in parallel.
+   */
+  void Push(const float* values, const uint8_t* valid, size_t begin, size_t end) {
+    const size_t count = end - begin;
+    if (valid == nullptr) {
+      Update(values + begin, count, m_n.data() + begin, m_mean.data() + begin, m_m2.data() + begin,
+             m_min.data() + begin, m_max.data() + begin);
+    } else {
+      Update(values + begin, valid + begin, count, m_n.data() + begin, m_mean.data() + begin,
+             m_m2.data() + begin, m_min.data() + begin, m_max.data() + begin);
+    }
+  }
+
+  /**
+   * Push() with the pixels split into num_threads bands of rows.  Starting the threads costs
+   * about as much as updating a 224 x 172 frame, this only pays off for bigger images or when
+   * several planes are updated with one call each.
+   */
+  void PushParallel(const float* values, const uint8_t* valid, size_t row_width, unsigned num_threads) {
+    const size_t rows = (row_width > 0u) ? (Size() + row_width - 1u) / row_width : 0u;
+    num_threads = std::max(1u, std::min(num_threads, static_cast<unsigned>(rows)));
+    if (num_threads <= 1u) {
+      Push(values, valid, 0u, Size());
+      return;
+    }
+
+    std::vector<std::thread> threads;
+    threads.reserve(num_threads - 1u);
+    const size_t rows_per_thread = (rows + num_threads - 1u) / num_threads;
+    for (unsigned t = 1u; t < num_threads; ++t) {
+      const size_t begin = std::min(Size(), t * rows_per_thread * row_width);
+      const size_t end = std::min(Size(), (t + 1u) * rows_per_thread * row_width);
+      threads.emplace_back([this, values, valid, begin, end]() { Push(values, valid, begin, end); });
+    }
+    Push(values, valid, 0u, std::min(Size(), rows_per_thread * row_width));
+    for (auto& thread : threads) {
+      thread.join();
+    }
+  }
+
+  /**
+   * Adds the values collected by other, as if they had been pushed to this object.  other must
+   * have the same size.  Uses the pairwise update of Chan, Golub and LeVeque.
+   */
+  void Merge(const RunningStatPlanes& other) {
+    const size_t size = std::min(Size(), other.Size());
+    for (size_t i = 0u; i < size; ++i) {
+      const double na = m_n[i];
+      const double nb = other.m_n[i];
+      const double count = na + nb;
+      const double delta = other.m_mean[i] - m_mean[i];
+      const double weight = (count > 0.0) ? nb / count : 0.0;
+      m_mean[i] += delta * weight;
+      m_m2[i] += other.m_m2[i] + delta * delta * na * weight;
+      m_n[i] += other.m_n[i];
+      m_min[i] = std::min(m_min[i], other.m_min[i]);
+      m_max[i] = std::max(m_max[i], other.m_max[i]);
+    }
+  }
+
+  // The per-pixel accessors match RunningStat
+  float NumDataValues(size_t i) const { return static_cast<float>(m_n[i]); }
+  float Mean(size_t i) const { return static_cast<float>(m_mean[i]); }
+  float Variance(size_t i) const { return (m_n[i] > 1.0) ? static_cast<float>(m_m2[i] / (m_n[i] - 1.0)) : 0.0f; }
+  float StandardDeviation(size_t i) const { return std::sqrt(Variance(i)); }
+  // Smallest and largest value of pixel i, +inf and -inf if no value was pushed
+  float Min(size_t i) const { return m_min[i]; }
+  float Max(size_t i) const { return m_max[i]; }
+
+  // Direct access to the planes
+  const double* CountPlane() const { return m_n.data(); }
+  const double* MeanPlane() const { return m_mean.data(); }
+  const double* M2Plane() const { return m_m2.data(); }
+  const float* MinPlane() const { return m_min.data(); }
+  const float* MaxPlane() const { return m_max.data(); }
+
+ private:
+  // The planes never overlap.  Without __restrict the compiler has to add run time checks for
+  // that, and with this many planes it doesn't vectorize the loops at all.
+  static void Update(const float* __restrict values, size_t size, double* __restrict n,
+                     double* __restrict mean, double* __restrict m2, float* __restrict minimum,
+                     float* __restrict maximum) {
+    for (size_t i = 0u; i < size; ++i) {
+      const float value = values[i];
+      const double count = n[i] + 1.0;
+      const double delta = value - mean[i];
+      const double new_mean = mean[i] + delta / count;
+      m2[i] += delta * (value - new_mean);
+      mean[i] = new_mean;
+      n[i] = count;
+      minimum[i] = (value < minimum[i]) ? value : minimum[i];
+      maximum[i] = (value > maximum[i]) ? value : maximum[i];
+    }
+  }
+
+  // Invalid pixels are updated with a weight of zero and compared against +-inf, which leaves
+  // all their values unchanged.  Written like this the loop has no branches and no conditional
+  // stores; a select on the value or a division by max(count, 1) makes GCC keep a branch,
+  // because the operations might raise floating point exceptions.
+  static void Update(const float* __restrict values, const uint8_t* __restrict valid, size_t size,
+                     double* __restrict n, double* __restrict mean, double* __restrict m2,
+                     float* __restrict minimum, float* __restrict maximum) {
+    for (size_t i = 0u; i < size; ++i) {
+      const bool use = valid[i] != 0u;
+      const double weight = use ? 1.0 : 0.0;
+      const float bias = use ? 0.0f : std::numeric_limits<float>::infinity();
+      const float value = values[i];
+      const double delta = (value - mean[i]) * weight;
+      const double new_mean = mean[i] + delta / (n[i] + 1.0);
+      m2[i] += delta * (value - new_mean);
+      mean[i] = new_mean;
+      n[i] += weight;
+      minimum[i] = std::min(minimum[i], value + bias);
+      maximum[i] = std::max(maximum[i], value - bias);
+    }
+  }
+
+  // The counts are kept in double as well, so that the update loops only mix float and double
+  std::vector<double> m_n;
+  std::vector<double> m_mean;
+  std::vector<double> m_m2;
+  std::vector<float> m_min;
+  std::vector<float> m_max;
+};
+
+#endif
@@ -20,6 +20,22 @@ Camera::CameraError Camera::RunInitializeTests(royale::String useCase) {
               << royale::getStatusString(status).c_str() << std::endl;
     return CAM_NOT_INITIALIZED;
   }
+
+  // A recording is replayed with the use case it was recorded with
+  if (!source_->isLive()) {
+    status = camera_->getCurrentUseCase(use_case_);
+    if (status == royale::CameraStatus::SUCCESS) {
+      status = camera_->getFrameRate(fps_);
+    }
+    if (status != royale::CameraStatus::SUCCESS) {
+      std::cerr << "[ERROR] Could not get the recorded use case. "
+                << royale::getStatusString(status).c_str() << std::endl;
+      return USE_CASE_ERROR;
+    }
+    report_.groupSkipped("initialize", "a recording is replayed with the use case it was recorded with.");
+    return NONE;
+  }
+
   use_case_ = useCase;
   royale::Vector<royale::String> useCaseList;
   status = camera_->getUseCases(useCaseList);
@@ -72,7 +88,7 @@ Camera::CameraError Camera::RunInitializeTests(royale::String useCase) {
     return USE_CASE_ERROR;
   }
 
-  std::clog << "[SUCCESS] All initialize tests passed. " << std::endl;
+  report_.groupPassed("initialize");
   return NONE;
 }
 
@@ -96,7 +112,7 @@ Camera::CameraError Camera::RunStreamTests() {
     return CAM_STREAM_ERROR;
   }
 
-  std::clog << "[SUCCESS] All camera stream tests passed. " << std::endl;
+  report_.groupPassed("camera stream");
   return NONE;
 }
 
@@ -125,7 +141,7 @@ Camera::CameraError Camera::RunAccessLevelTests(int user_level) {
     return ACCESS_LEVEL_ERROR;
   }
 
-  std::clog << "[SUCCESS] All access level tests passed. " << std::endl;
+  report_.groupPassed("access level");
   return NONE;
 }
 
@@ -179,7 +195,7 @@ Camera::CameraError Camera::RunUseCaseTests() {
     }
   }
   use_case_ = current_use_case.c_str();
-  std::clog << "[SUCCESS] All use case tests passed. " << std::endl;
+  report_.groupPassed("use case");
   return NONE;
 }
 
@@ -200,12 +216,14 @@ Camera::CameraError Camera::RunExposureTests() {
 
 
   // Running.G edit-Change register to place camera under test mode
-  std::clog << "[--------RUNNINGGAO-------PATTERNTEST] Writing to register now with LEVEL 3-Sequence: before capture mode" << std::endl;
-  royale::Vector<royale::Pair<royale::String, uint64_t>> registers;
-  registers.push_back(royale::Pair<royale::String, uint64_t> ("0xA026", 0x1000));
-  status = camera_->writeRegisters(registers);
-  std::clog << "[--------print out STATUS ID after writing register-------- ] " << status << std::endl;
-  std::clog << status << std::endl;
+  if (source_->isLive()) {
+    std::clog << "[--------RUNNINGGAO-------PATTERNTEST] Writing to register now with LEVEL 3-Sequence: before capture mode" << std::endl;
+    royale::Vector<royale::Pair<royale::String, uint64_t>> registers;
+    registers.push_back(royale::Pair<royale::String, uint64_t> ("0xA026", 0x1000));
+    status = camera_->writeRegisters(registers);
+    std::clog << "[--------print out STATUS ID after writing register-------- ] " << status << std::endl;
+    std::clog << status << std::endl;
+  }
 
 
 
@@ -218,7 +236,13 @@ Camera::CameraError Camera::RunExposureTests() {
     return EXPOSURE_MODE_ERROR;
   }
 
-  std::this_thread::sleep_for(std::chrono::seconds(1));
+  // The exposure of a recording can't be changed
+  if (!source_->isLive()) {
+    report_.groupSkipped("exposure", "the exposure of a recording can't be changed.");
+    return NONE;
+  }
+
+  source_->settle(std::chrono::seconds(1));
 
   // Set Manual Exposure
   status = camera_->setExposureMode(royale::ExposureMode::MANUAL);
@@ -229,7 +253,7 @@ Camera::CameraError Camera::RunExposureTests() {
       return EXPOSURE_MODE_ERROR;
   }
 
-  std::this_thread::sleep_for (std::chrono::seconds (1));
+  source_->settle(std::chrono::seconds(1));
 
   // Get Exposure Limits
   royale::Pair<std::uint32_t, std::uint32_t> limits;
@@ -241,7 +265,7 @@ Camera::CameraError Camera::RunExposureTests() {
       return EXPOSURE_MODE_ERROR;
   }
 
-  std::this_thread::sleep_for (std::chrono::seconds (5));
+  source_->settle(std::chrono::seconds(5));
 
   // Set Exposure Time (Manual ONLY!)
   std::uint32_t man_exposure_low = limits.first;
@@ -254,7 +278,7 @@ Camera::CameraError Camera::RunExposureTests() {
   }
 
   // Wait for 1 second before changing exposure
-  std::this_thread::sleep_for (std::chrono::seconds (1));
+  source_->settle(std::chrono::seconds(1));
 
   std::uint32_t man_exposure_high = limits.second;
   status = camera_->setExposureTime(man_exposure_high, stream_id_);
@@ -269,7 +293,7 @@ Camera::CameraError Camera::RunExposureTests() {
   //       via exposure member of data in onNewData
 
   // Wait for 1 second before changing exposure
-  std::this_thread::sleep_for(std::chrono::seconds(1));
+  source_->settle(std::chrono::seconds(1));
 
   // Set Auto Exposure
   status = camera_->setExposureMode(royale::ExposureMode::AUTOMATIC);
@@ -279,7 +303,7 @@ Camera::CameraError Camera::RunExposureTests() {
     return EXPOSURE_MODE_ERROR;
   }
 
-  std::clog << "[SUCCESS] All exposure tests passed. " << std::endl;
+  report_.groupPassed("exposure");
   return NONE;
 }
 
@@ -307,19 +331,55 @@ Camera::CameraError Camera::RunLensParametersTest() {
     return LENS_PARAMETER_ERROR;
   }
 
-  std::clog << "[SUCCESS] All lens parameters tests passed. " << std::endl;
+  report_.groupPassed("lens parameters");
   return NONE;
 }
 
+// Replays the rest of the recording one frame at a time, returns the number of frames
+int Camera::ReplayAllFrames() {
+  int count = 0;
+  {
+    std::lock_guard<std::mutex> lock(rawListener_.m_lock);
+    count = rawListener_.m_count;
+  }
+  for (;;) {
+    source_->requestFrame();
+    if (rawListener_.WaitForCount(count, std::chrono::milliseconds(1000))) {
+      count++;
+    } else if (source_->isFinished()) {
+      return count;
+    }
+  }
+}
+
 Camera::CameraError Camera::RunTestReceiveData(int secondsToStream) {
-  // Let the camera run for a second
-  std::this_thread::sleep_for(std::chrono::seconds(1));
+  // Let the camera run for a second, a replay only needs the first frame
+  source_->settle(std::chrono::seconds(1));
+  if (!source_->isLive()) {
+    source_->requestFrame();
+    rawListener_.WaitForCount(0, std::chrono::milliseconds(1000));
+  }
 
   if (rawListener_.m_count == 0) {
     std::cerr << "[ERROR] Not receiving new depth data" << std::endl;
     return RECEIVE_DATA_ERROR;
   }
 
+  if (!source_->isLive()) {
+    // The whole recording is used, its frame rate is measured with the recorded timestamps
+    {
+      std::lock_guard<std::mutex> lock(rawListener_.m_lock);
+      rawListener_.m_count = 0;
+    }
+    const int number_of_frames = ReplayAllFrames();
+    const auto duration = std::chrono::duration<float>(rawListener_.m_lastTimestamp - rawListener_.m_firstTimestamp);
+    if (number_of_frames < 2 || duration.count() <= 0.0f) {
+      std::cerr << "[ERROR] The recording has too few frames to measure the frame rate" << std::endl;
+      return RECEIVE_DATA_ERROR;
+    }
+    return CheckReceivedData(static_cast<float>(number_of_frames - 1), duration.count());
+  }
+
   // Record to output file
   if (secondsToStream > 300) {
     // Stream to /dev/null otherwise you will run out of disk space...
@@ -330,12 +390,19 @@ Camera::CameraError Camera::RunTestReceiveData(int secondsToStream) {
 
   std::clog << "Begin Recording for " << secondsToStream << " seconds" << std::endl;
 
-  rawListener_.m_count = 0u;
+  {
+    std::lock_guard<std::mutex> lock(rawListener_.m_lock);
+    rawListener_.m_count = 0;
+  }
   std::this_thread::sleep_for(std::chrono::seconds(secondsToStream));
 
   // Stop the recording
   camera_->stopRecording();
-  float number_of_frames = static_cast<float>(rawListener_.m_count);
+  return CheckReceivedData(static_cast<float>(rawListener_.m_count), static_cast<float>(secondsToStream));
+}
+
+// Checks the temperature readings, and that number_of_frames in seconds matches the frame rate
+Camera::CameraError Camera::CheckReceivedData(float number_of_frames, float seconds) {
 
   float current_temp = 0.0f;
   for (auto& tmp : rawListener_.m_cur_temp) {
@@ -349,23 +416,23 @@ Camera::CameraError Camera::RunTestReceiveData(int secondsToStream) {
   std::clog << "[SUCCESS] Temperature sensor working, reading is " << current_temp << std::endl;
 
   // Stop the capturing mode
-  royale::CameraStatus status = camera_->stopCapture();
+  royale::CameraStatus status = source_->stopCapture();
   if (status != royale::CameraStatus::SUCCESS) {
     std::cerr << "[ERROR] Could not stop the camera capture. "
               << royale::getStatusString(status).c_str() << std::endl;
     return RECEIVE_DATA_ERROR;
   }
-  float measuredFPS = number_of_frames / static_cast<float>(secondsToStream);
+  float measuredFPS = number_of_frames / seconds;
   float fps_lower_limit = static_cast<float>(fps_) - 0.5f;
   float fps_upper_limit = static_cast<float>(fps_) + 0.5f;
 
   if (measuredFPS < fps_lower_limit || measuredFPS > fps_upper_limit) {
     std::cerr << "[ERROR] FPS is outside of limits at " << measuredFPS << std::endl;
-    std::cerr << "[ERROR] " << rawListener_.m_count << " frames in " << secondsToStream << " seconds." << std::endl;
+    std::cerr << "[ERROR] " << number_of_frames << " frames in " << seconds << " seconds." << std::endl;
     return RECEIVE_DATA_ERROR;
   }
   std::clog << "[SUCCESS] FPS is inside limits " << measuredFPS << std::endl;
-  std::clog << "[SUCCESS] All receive data tests passed. " << std::endl;
+  report_.groupPassed("receive data");
 
   return NONE;
 }
@@ -492,6 +559,6 @@ Camera::CameraError Camera::RunProcessingParametersTests() {
     }
   }
 
-  std::clog << "[SUCCESS] All processing parameters tests passed. " << std::endl;
+  report_.groupPassed("processing parameters");
   return err;
 }
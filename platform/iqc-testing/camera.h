@@ -5,57 +5,94 @@
 #include <string>
 #include <thread>
 #include <chrono>
+#include <condition_variable>
+#include <iostream>
+#include <mutex>
 
 #include <royale/ICameraDevice.hpp>
-#include <CameraFactory.hpp>
+#include <FrameSource.hpp>
+#include <TestReport.hpp>
 
 
 class MyRawListener : public royale::IExtendedDataListener
 {
 public:
     MyRawListener() :
-        m_count (0)
+        m_count (0),
+        m_source (nullptr)
     {
     }
 
     void onNewData (const royale::IExtendedData *data) override
     {
+        if (m_source != nullptr && !m_source->admitFrame()) {
+          return;
+        }
+        std::lock_guard<std::mutex> lock (m_lock);
         m_count++;
 
         if (data->hasDepthData()) {
           auto depth = data->getDepthData();
           m_streamIds.insert (depth->streamId);
           m_expoTimes = depth->exposureTimes;
+          // The recorded time of the frames since the count was reset
+          if (m_count == 1) {
+            m_firstTimestamp = depth->timeStamp;
+          }
+          m_lastTimestamp = depth->timeStamp;
         }
         if (data->hasRawData()) {
           auto raw = data->getRawData();
           m_cur_temp.push_back(raw->illuminationTemperature);
         }
+        m_newData.notify_all();
+    }
+
+    // Waits until more than count frames have been received, returns false on timeout
+    bool WaitForCount (int count, std::chrono::milliseconds timeout)
+    {
+        std::unique_lock<std::mutex> lock (m_lock);
+        return m_newData.wait_for (lock, timeout, [&] { return m_count > count; });
     }
 
     std::set<royale::StreamId> m_streamIds;
     royale::Vector<uint32_t> m_expoTimes;
     int m_count;
     std::vector<float> m_cur_temp;
+    std::chrono::microseconds m_firstTimestamp;
+    std::chrono::microseconds m_lastTimestamp;
+    platform::FrameSource *m_source;                // Admits the frames, see FrameSource::admitFrame()
+    std::mutex m_lock;
+    std::condition_variable m_newData;
 };
 
 class Camera
 {
 public:
     // Camera() : camera_(nullptr) {}
-    Camera()
+    explicit Camera (const std::string &source) :
+      source_ (platform::FrameSource::create (source)),
+      camera_ (source_ ? &source_->device() : nullptr),
+      report_ (std::clog)
     {
-      platform::CameraFactory factory;
-      camera_ = factory.createCamera();
+      rawListener_.m_source = source_.get();
     }
 
-    std::unique_ptr<royale::ICameraDevice> camera_; // The camera device
+    ~Camera()
+    {
+      // The playback of a replay must end before the listener is destroyed
+      source_.reset();
+    }
+
+    std::unique_ptr<platform::FrameSource> source_; // The live camera or the replayed recording
+    royale::ICameraDevice *camera_;                 // The camera device
     MyRawListener rawListener_;
     int access_level_;
     std::string id_;                                // Unique ID for the camera device
     royale::String use_case_;                       // Camera use_case_
     royale::StreamId stream_id_;                    // FIRST stream ID for the given use_case_
     uint16_t fps_;
+    platform::TestReport report_;                   // Writes the results of the tests
 
     enum CameraError
     {
@@ -82,6 +119,10 @@ public:
     CameraError RunUseCaseTests();
     CameraError RunLensParametersTest();
     CameraError RunTestReceiveData(int secondsToStream);
+
+private:
+    int ReplayAllFrames();
+    CameraError CheckReceivedData(float number_of_frames, float seconds);
 };
 
 #endif // __CAMERA_H__
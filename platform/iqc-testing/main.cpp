@@ -1,7 +1,7 @@
 #include <getopt.h>
 #include <unistd.h>
 
-#include <CameraFactory.hpp>
+#include <FrameSource.hpp>
 #include <iostream>
 #include <royale/ICameraDevice.hpp>
 #include <string>
@@ -21,30 +21,36 @@ void print_help() {
   std::cout << "-v                   Show program version.\n"
                "-r <n>               Set number of seconds to record: -r 60\n"
                "-m <str>             Set ToF mode: -m MODE_9_5FPS\n"
+               "-s, --source <src>   Test the live camera (default) or replay a recording: -s session.rrf\n"
+               "                     A recording is replayed as fast as possible with its own use case\n"
+               "                     and exposure, the frame rate is measured with its timestamps.\n"
                "-h                   Show help\n";
   exit(EXIT_FAILURE);
 }
 
-#define OPTSTR "vr:m:h"
+#define OPTSTR "vr:m:s:h"
+
+const struct option LONG_OPTIONS[] = {
+  {"source", required_argument, nullptr, 's'},
+  {nullptr, 0, nullptr, 0},
+};
 
 typedef struct {
   string version;
   int numSecondsToStream;
   royale::String test_mode;
+  string source;
 } options_t;
 
 int main(int argc, char **argv) {
   int opt;
   // Default options
-  options_t options = {VERSION, 15, "MODE_9_5FPS"};
+  options_t options = {VERSION, 15, "MODE_9_5FPS", FrameSource::LIVE};
   // std::string ACCESS_CODE = "d79dab562f13ef8373e906d919aec323a2857388"; //Original code for level 2
   std::string ACCESS_CODE = "c715e2ca31e816b1ef17ba487e2a5e9efc6bbd7b";  //Running.G added new code for level 3
 
-  // CameraFactory factory;
-  Camera cam;
-
   if (argc > 1) {
-    while ((opt = getopt(argc, argv, OPTSTR)) != -1) {
+    while ((opt = getopt_long(argc, argv, OPTSTR, LONG_OPTIONS, nullptr)) != -1) {
       switch (opt) {
         case 'v':
           std::cout << "Version: " << options.version << std::endl;
@@ -65,6 +71,10 @@ int main(int argc, char **argv) {
           options.test_mode = royale::String(optarg);
           std::cout << "Setting ToF Mode: " << options.test_mode << std::endl;
           break;
+        case 's':
+          options.source = optarg;
+          std::cout << "Frame Source: " << options.source << std::endl;
+          break;
         case 'h':
         default:
           print_help();
@@ -83,6 +93,7 @@ int main(int argc, char **argv) {
 // ctime() used to give the present time
     printf("%s", ctime(&my_time));
 
+  Camera cam(options.source);
 
 
   // [Setup] Camera Initialization Test
@@ -32,7 +32,8 @@
  * file.  The 16 coefficients are formated as one per line.
  */
 
-#include <CameraFactory.hpp>
+#include <FrameSource.hpp>
+#include <getopt.h>
 #include <chrono>
 #include <condition_variable>
 #include <iostream>
@@ -43,25 +44,35 @@
 #include <string>
 
 #include "parameters.hpp"
+#include "remove_duplicate_points.hpp"
 #include "running_stat.hpp"
+#include "running_stat_planes.hpp"
 
 // Image is 172 x 224 pixels
 #define NUM_IMAGE_ELEMENTS 38528
 
 // Simplify memory handeling for testing
 namespace {
-// The camera device
-std::unique_ptr<royale::ICameraDevice> camera_;
+// The camera or the recording that is replayed, and its camera device
+std::unique_ptr<platform::FrameSource> source_;
+royale::ICameraDevice *camera_ = nullptr;
 // Running Mean and Standard Deviation collections
 // Intensity Data
-std::vector<RunningStat> pt_intensity_running_stat;
+RunningStatPlanes pt_intensity_running_stat;
 // ToF 3D X/Y/Z values in meters
-std::vector<RunningStat> pt_x_running_stat;
-std::vector<RunningStat> pt_y_running_stat;
-std::vector<RunningStat> pt_z_running_stat;
+RunningStatPlanes pt_x_running_stat;
+RunningStatPlanes pt_y_running_stat;
+RunningStatPlanes pt_z_running_stat;
 // ToF Depth Confidence Level, royale::DepthPoint.depthConfidence
 // A value from 0 (invalid) to 255 (full confidence)
-std::vector<RunningStat> confident_pixel;
+RunningStatPlanes confident_pixel;
+// One frame of each value as planes, filled by the listener and pushed to the running stats
+std::vector<float> frame_intensity;
+std::vector<float> frame_x;
+std::vector<float> frame_y;
+std::vector<float> frame_z;
+std::vector<float> frame_confidence;
+std::vector<uint8_t> frame_valid;
 std::mutex cloudMutex;
 std::condition_variable cloudCV;
 bool newDataAvailable;
@@ -71,13 +82,15 @@ std::string VERSION{"1.1"};
 
 //  When exiting application stop LDS and Camera.
 void terminate() {
-  const char *stop_lds_command = ToF_calibration_params::kStopLdsString.c_str();
-  system(stop_lds_command);
-  if (camera_) {
+  if (source_ == nullptr || source_->isLive()) {
+    const char *stop_lds_command = ToF_calibration_params::kStopLdsString.c_str();
+    system(stop_lds_command);
+  }
+  if (source_) {
     bool camera_is_capturing = false;
     camera_->isCapturing(camera_is_capturing);
     if (camera_is_capturing) {
-      if (camera_->stopCapture() != royale::CameraStatus::SUCCESS) {
+      if (source_->stopCapture() != royale::CameraStatus::SUCCESS) {
         std::cout << "Error stopping camera" << std::endl;
       }
     }
@@ -240,21 +253,21 @@ cv::Point2f FindLdsReturn(const cv::Size &camera_size, std::vector<cv::Point2d>
     y_bar = 0.0f;
     for (int row = 0; row < cam_height; row++) {
       pt_index = row * cam_width + col;
-      pix_val = pt_intensity_running_stat[pt_index].Mean();
+      pix_val = pt_intensity_running_stat.Mean(pt_index);
       if (pix_val > 0.0f) {
         y_bar += static_cast<float>(row) * pix_val;
         x_bar += static_cast<float>(col) * pix_val;
         sum_region += pix_val;
       }
       pt_index = row * cam_width + col + 1;
-      pix_val = pt_intensity_running_stat[pt_index].Mean();
+      pix_val = pt_intensity_running_stat.Mean(pt_index);
       if (pix_val > 0.0f) {
         y_bar += static_cast<float>(row) * pix_val;
         x_bar += static_cast<float>(col + 1) * pix_val;
         sum_region += pix_val;
       }
       pt_index = row * cam_width + col + 2;
-      pix_val = pt_intensity_running_stat[pt_index].Mean();
+      pix_val = pt_intensity_running_stat.Mean(pt_index);
       if (pix_val > 0.0f) {
         y_bar += static_cast<float>(row) * pix_val;
         x_bar += static_cast<float>(col + 2) * pix_val;
@@ -291,6 +304,9 @@ class MyListener : public royale::IExtendedDataListener {
   }
 
   void onNewData(const royale::IExtendedData *data) {
+    if (!source_->admitFrame()) {
+      return;
+    }
     if (current_mode != DataCollectionMode::NONE) {
       putchar(spin_chars[m_counter % sizeof(spin_chars)]);
       putchar('\r');
@@ -302,27 +318,33 @@ class MyListener : public royale::IExtendedDataListener {
       float intensity_val = 0.0f;
       int row;
       int col;
-      for (size_t i = 0u; i < NUM_IMAGE_ELEMENTS; ++i) {
-        if (current_mode == DataCollectionMode::LDS_DATA) {
+      bool in_bounds;
+      if (current_mode == DataCollectionMode::LDS_DATA) {
+        for (size_t i = 0u; i < NUM_IMAGE_ELEMENTS; ++i) {
           // Temporary ignore region at top and bottom of image due to incorrect calibration changes
           row = static_cast<int>(static_cast<int>(i) / static_cast<int>(intermed->width));
           col = static_cast<int>(i) % static_cast<int>(intermed->width);
           // Skip if outside of detection boundary
-          if (row < ToF_calibration_params::kRowDetectionBounds.first || row > ToF_calibration_params::kRowDetectionBounds.second) continue;
-          if (col < ToF_calibration_params::kColDetectionBounds.first || col > ToF_calibration_params::kColDetectionBounds.second) continue;
+          in_bounds = row >= ToF_calibration_params::kRowDetectionBounds.first && row <= ToF_calibration_params::kRowDetectionBounds.second &&
+                      col >= ToF_calibration_params::kColDetectionBounds.first && col <= ToF_calibration_params::kColDetectionBounds.second;
 
           intensity_val = intermed->points[i].intensity;
-          if (intensity_val > ToF_calibration_params::kLdsDetectionThreshold) {
-            pt_intensity_running_stat[i].Push(intensity_val);
-          }
-        } else if (current_mode == DataCollectionMode::TOF_DATA) {
-          confident_pixel[i].Push(depth->points[i].depthConfidence);
-          if (depth->points[i].depthConfidence > 0) {
-            pt_x_running_stat[i].Push(depth->points[i].x);
-            pt_y_running_stat[i].Push(depth->points[i].y);
-            pt_z_running_stat[i].Push(depth->points[i].z);
-          }
+          frame_intensity[i] = intensity_val;
+          frame_valid[i] = (in_bounds && intensity_val > ToF_calibration_params::kLdsDetectionThreshold) ? 1u : 0u;
         }
+        pt_intensity_running_stat.Push(frame_intensity.data(), frame_valid.data());
+      } else if (current_mode == DataCollectionMode::TOF_DATA) {
+        for (size_t i = 0u; i < NUM_IMAGE_ELEMENTS; ++i) {
+          frame_confidence[i] = depth->points[i].depthConfidence;
+          frame_x[i] = depth->points[i].x;
+          frame_y[i] = depth->points[i].y;
+          frame_z[i] = depth->points[i].z;
+          frame_valid[i] = depth->points[i].depthConfidence > 0 ? 1u : 0u;
+        }
+        confident_pixel.Push(frame_confidence.data());
+        pt_x_running_stat.Push(frame_x.data(), frame_valid.data());
+        pt_y_running_stat.Push(frame_y.data(), frame_valid.data());
+        pt_z_running_stat.Push(frame_z.data(), frame_valid.data());
       }
       newDataAvailable = true;
       cloudCV.notify_all();
@@ -341,7 +363,7 @@ class MyListener : public royale::IExtendedDataListener {
   DataCollectionMode current_mode;
 };
 
-int setCameraProperties(std::unique_ptr<royale::ICameraDevice> &camera_) {
+int setCameraProperties(royale::ICameraDevice *camera_) {
   // set ToF module processing parameters
   if (camera_->setProcessingParameters({ToF_calibration_params::USE_ADAPTIVE_NOISE_FILTER}) != royale::CameraStatus::SUCCESS) {
     std::cout << "[ERROR] Could not set USE_ADAPTIVE_NOISE_FILTER." << std::endl;
@@ -428,19 +450,7 @@ bool inRange(royale::Pair<std::uint32_t, std::uint32_t> range_vals, std::uint32_
 
 // Removes duplicate points from a vector
 bool RemoveDuplicates(std::vector<cv::Point2d> &xy_vals) {
-  unsigned nb_removed = 0;  // count number of removed from back
-  double threshold_distance = 0.1;
-  for (size_t i = 0; i < xy_vals.size() - nb_removed; ++i) {
-    for (size_t j = i + 1; j < xy_vals.size() - nb_removed; ++j) {
-      if (cv::norm(xy_vals[i] - xy_vals[j]) < threshold_distance) {
-        std::iter_swap(xy_vals.begin() + i, xy_vals.end() - nb_removed - 1);
-        nb_removed += 1;
-        --i;
-        break;
-      }
-    }
-  }
-  xy_vals.erase(xy_vals.end() - nb_removed, xy_vals.end());
+  RemoveDuplicatePoints(xy_vals, ToF_calibration_params::kDuplicatePointDistance);
   if (xy_vals.size() < 2) {
     return false;
   } else {
@@ -448,12 +458,36 @@ bool RemoveDuplicates(std::vector<cv::Point2d> &xy_vals) {
   }
 }
 
+void usage(const char *name) {
+  std::cout << "Usage: " << name << " [-s|--source live|<file.rrf>] [-h|--help] [timeout_seconds]" << std::endl;
+  std::cout << "  -s, --source  Where the frames come from, the camera (default) or a recording. A" << std::endl;
+  std::cout << "                recording is replayed as fast as possible with its own settings, the" << std::endl;
+  std::cout << "                LDS isn't started and the timeout isn't used." << std::endl;
+}
+
 // Main Program Entry
 int main(int argc, char **argv) {
 
   int calibration_timeout_seconds = ToF_calibration_params::kCalibrationTtimeoutSeconds;
-  if (argc == 2) {
-    calibration_timeout_seconds = atoi(argv[1]);
+  std::string source_name = platform::FrameSource::LIVE;
+
+  const struct option long_options[] = {{"source", required_argument, nullptr, 's'}, {"help", no_argument, nullptr, 'h'}, {nullptr, 0, nullptr, 0}};
+  int opt;
+  while ((opt = getopt_long(argc, argv, "s:h", long_options, nullptr)) != -1) {
+    switch (opt) {
+      case 's':
+        source_name = optarg;
+        break;
+      case 'h':
+        usage(argv[0]);
+        return 0;
+      default:
+        usage(argv[0]);
+        return -1;
+    }
+  }
+  if (optind < argc) {
+    calibration_timeout_seconds = atoi(argv[optind]);
   }
 
   // Default options
@@ -463,7 +497,6 @@ int main(int argc, char **argv) {
   royale::CameraStatus status;
   std::unique_ptr<MyListener> listener_;
   newDataAvailable = false;
-  platform::CameraFactory factory;
   Timer timer;
   // MODE_5 allows longer exposure times allowing more opportunity to see the LDS signal
   royale::String useCase_LDS = "MODE_5_5FPS";
@@ -473,28 +506,41 @@ int main(int argc, char **argv) {
   std::uint32_t tof_exposure_time = 900;
   std::uint32_t current_exposure;
 
-  pt_intensity_running_stat.resize(NUM_IMAGE_ELEMENTS);
-  pt_x_running_stat.resize(NUM_IMAGE_ELEMENTS);
-  pt_y_running_stat.resize(NUM_IMAGE_ELEMENTS);
-  pt_z_running_stat.resize(NUM_IMAGE_ELEMENTS);
-  confident_pixel.resize(NUM_IMAGE_ELEMENTS);
+  pt_intensity_running_stat.Resize(NUM_IMAGE_ELEMENTS);
+  pt_x_running_stat.Resize(NUM_IMAGE_ELEMENTS);
+  pt_y_running_stat.Resize(NUM_IMAGE_ELEMENTS);
+  pt_z_running_stat.Resize(NUM_IMAGE_ELEMENTS);
+  confident_pixel.Resize(NUM_IMAGE_ELEMENTS);
+  frame_intensity.resize(NUM_IMAGE_ELEMENTS);
+  frame_x.resize(NUM_IMAGE_ELEMENTS);
+  frame_y.resize(NUM_IMAGE_ELEMENTS);
+  frame_z.resize(NUM_IMAGE_ELEMENTS);
+  frame_confidence.resize(NUM_IMAGE_ELEMENTS);
+  frame_valid.resize(NUM_IMAGE_ELEMENTS);
 
   const char *start_lds_command = ToF_calibration_params::kStartLdsString.c_str();
   const char *stop_lds_command = ToF_calibration_params::kStopLdsString.c_str();
 
-  // Starting LDS
-  std::cout << "Starting LDS Closed Loop" << std::endl;
-  system(start_lds_command);
-
   // [Setup] Camera Initialization
-  camera_ = factory.createCamera();
+  source_ = platform::FrameSource::create(source_name);
 
   // Test if CameraDevice was created
-  if (camera_ == nullptr) {
+  if (source_ == nullptr) {
     std::cout << "[ERROR] Camera device could not be created." << std::endl;
     terminate();
     return -1;
   }
+  camera_ = &source_->device();
+
+  // A recording is replayed with the use case, exposure and processing parameters it was
+  // recorded with, and the LDS isn't needed for it
+  const bool live = source_->isLive();
+  if (live) {
+    std::cout << "Starting LDS Closed Loop" << std::endl;
+    system(start_lds_command);
+  } else {
+    std::cout << "Replaying " << source_name << std::endl;
+  }
   // Initialize()
   if ((status = camera_->initialize()) != royale::CameraStatus::SUCCESS) {
     std::cout << royale::getStatusString(status).c_str() << std::endl;
@@ -511,7 +557,7 @@ int main(int argc, char **argv) {
   royale::String current_use_case;
   camera_->getCurrentUseCase(current_use_case);
   royale::Vector<royale::String> useCaseList;
-  if (current_use_case != useCase_LDS) {
+  if (live && current_use_case != useCase_LDS) {
     if ((status = camera_->getUseCases(useCaseList)) != royale::CameraStatus::SUCCESS || useCaseList.empty()) {
       std::cout << "[ERROR] Could not get use cases. " << royale::getStatusString(status).c_str() << std::endl;
       terminate();
@@ -537,24 +583,26 @@ int main(int argc, char **argv) {
     return -1;
   }
 
-  if ((status = camera_->setExposureMode(royale::ExposureMode::MANUAL)) != royale::CameraStatus::SUCCESS) {
-    std::cout << "[ERROR] Could not set exposure to manual" << royale::getStatusString(status).c_str() << std::endl;
-    terminate();
-    return -1;
-  }
-
-  // Get Exposure Limits
   royale::Pair<std::uint32_t, std::uint32_t> exposure_limits;
-  if ((status = camera_->getExposureLimits(exposure_limits)) != royale::CameraStatus::SUCCESS) {
-    std::cout << "[ERROR] Could not get exposure limits. " << royale::getStatusString(status).c_str() << std::endl;
-    terminate();
-    return -1;
-  }
+  if (live) {
+    if ((status = camera_->setExposureMode(royale::ExposureMode::MANUAL)) != royale::CameraStatus::SUCCESS) {
+      std::cout << "[ERROR] Could not set exposure to manual" << royale::getStatusString(status).c_str() << std::endl;
+      terminate();
+      return -1;
+    }
 
-  if ((status = camera_->setExposureTime(exposure_limits.second)) != royale::CameraStatus::SUCCESS) {
-    std::cout << "[ERROR] setting exposure time to: " << exposure_limits.second << royale::getStatusString(status).c_str() << std::endl;
-    terminate();
-    return -1;
+    // Get Exposure Limits
+    if ((status = camera_->getExposureLimits(exposure_limits)) != royale::CameraStatus::SUCCESS) {
+      std::cout << "[ERROR] Could not get exposure limits. " << royale::getStatusString(status).c_str() << std::endl;
+      terminate();
+      return -1;
+    }
+
+    if ((status = camera_->setExposureTime(exposure_limits.second)) != royale::CameraStatus::SUCCESS) {
+      std::cout << "[ERROR] setting exposure time to: " << exposure_limits.second << royale::getStatusString(status).c_str() << std::endl;
+      terminate();
+      return -1;
+    }
   }
   current_exposure = exposure_limits.second;
 
@@ -569,16 +617,16 @@ int main(int argc, char **argv) {
   }
 
   // capture for a few seconds
-  std::this_thread::sleep_for(std::chrono::seconds(3));
+  source_->settle(std::chrono::seconds(3));
 
   // Set camera properties
-  if (setCameraProperties(camera_) == -1) {
+  if (live && setCameraProperties(camera_) == -1) {
     terminate();
     return -1;
   }
 
   // warm up camera
-  std::this_thread::sleep_for(std::chrono::seconds(1));
+  source_->settle(std::chrono::seconds(1));
 
   std::vector<cv::Mat> vec_pt_cloud;
   std::vector<cv::Mat> vec_pt_intensity;
@@ -600,11 +648,13 @@ int main(int argc, char **argv) {
   // the points are not sufficiently spread across the width of the sensor.  A robust solution for an accurate plane increases
   // as both of these criteria are met.  The chances of catching the LDS signal increase by incrementally varying the exposure.
   // In case a system cannot be calibrated the application will exit after a user specified timeout is reached.  If not specified
-  // the default timeout is 90 seconds.
+  // the default timeout is 90 seconds.  A replay runs until the end of the recording instead, so
+  // that the result doesn't depend on how fast the frames are processed.
   timer.start();
-  while (timer.elapsedSeconds() < calibration_timeout_seconds &&
+  while ((!live || timer.elapsedSeconds() < calibration_timeout_seconds) &&
         ((xy_vals.size() < static_cast<size_t>(kLdsSampleSize) || col_range < ToF_calibration_params::kLdsPtsPlaneFitMinRange))) {
     std::unique_lock<std::mutex> lock(cloudMutex);
+    source_->requestFrame();
     auto timeOut = (std::chrono::system_clock::now() + std::chrono::milliseconds(1000));
     if (cloudCV.wait_until(lock, timeOut, [&] { return newDataAvailable; })) {
       min_max_col = FindLdsReturn(camera_size, xy_vals);
@@ -615,9 +665,11 @@ int main(int argc, char **argv) {
         num_last_xy_pts = static_cast<int>(xy_vals.size());
       }
       newDataAvailable = false;
+    } else if (source_->isFinished()) {
+      break;
     }
     // Update the exposure if points were detected
-    if (num_new_collected > 0) {
+    if (live && num_new_collected > 0) {
       listener_.get()->setDataCollectionMode(MyListener::DataCollectionMode::NONE);
       num_new_collected = 0;
       // Adjust the exposure
@@ -653,7 +705,7 @@ int main(int argc, char **argv) {
     }
   }
 
-  if (timer.elapsedSeconds() > calibration_timeout_seconds) {
+  if (live && timer.elapsedSeconds() > calibration_timeout_seconds) {
     std::cout << "[WARNING] Timer Has Expired at " << timer.elapsedSeconds() << " seconds." << std::endl;
   }
 
@@ -674,57 +726,59 @@ int main(int argc, char **argv) {
     return -1;
   }
 
-  // Stopping LDS
-  std::cout << "Stopping LDS Closed Loop" << std::endl;
-  system(stop_lds_command);
+  // A replay continues with the frames that follow in the recording
+  if (live) {
+    // Stopping LDS
+    std::cout << "Stopping LDS Closed Loop" << std::endl;
+    system(stop_lds_command);
 
-  // Set use case for collecting the point cloud
-  for (auto i = 0u; i < useCaseList.size(); ++i) {
-    if (useCaseList.at(i) == useCase_TOF) {
-      if ((status = camera_->setUseCase(useCaseList.at(i))) != royale::CameraStatus::SUCCESS) {
-        std::cout << "[ERROR] Could not set a new use case. " << useCaseList[i].c_str() << "   " << royale::getStatusString(status).c_str() << std::endl;
-        terminate();
-        return -1;
+    // Set use case for collecting the point cloud
+    for (auto i = 0u; i < useCaseList.size(); ++i) {
+      if (useCaseList.at(i) == useCase_TOF) {
+        if ((status = camera_->setUseCase(useCaseList.at(i))) != royale::CameraStatus::SUCCESS) {
+          std::cout << "[ERROR] Could not set a new use case. " << useCaseList[i].c_str() << "   " << royale::getStatusString(status).c_str() << std::endl;
+          terminate();
+          return -1;
+        }
       }
     }
-  }
-  // wait on camera
-  std::this_thread::sleep_for(std::chrono::seconds(1));
+    // wait on camera
+    source_->settle(std::chrono::seconds(1));
 
-  if ((status = camera_->setExposureMode(royale::ExposureMode::MANUAL)) != royale::CameraStatus::SUCCESS) {
-    std::cout << "[ERROR] Could not set exposure to manual" << royale::getStatusString(status).c_str() << std::endl;
-    terminate();
-    return -1;
-  }
-
-  // Get Exposure Limits
-  if ((status = camera_->getExposureLimits(exposure_limits)) != royale::CameraStatus::SUCCESS) {
-    std::cout << "[ERROR] Could not get exposure limits. " << royale::getStatusString(status).c_str() << std::endl;
-    terminate();
-    return -1;
-  }
+    if ((status = camera_->setExposureMode(royale::ExposureMode::MANUAL)) != royale::CameraStatus::SUCCESS) {
+      std::cout << "[ERROR] Could not set exposure to manual" << royale::getStatusString(status).c_str() << std::endl;
+      terminate();
+      return -1;
+    }
 
-  if (inRange(exposure_limits, tof_exposure_time)) {
-    if ((status = camera_->setExposureTime(tof_exposure_time)) != royale::CameraStatus::SUCCESS) {
-      std::cout << "[ERROR] setting exposure time to: " << tof_exposure_time << royale::getStatusString(status).c_str() << std::endl;
+    // Get Exposure Limits
+    if ((status = camera_->getExposureLimits(exposure_limits)) != royale::CameraStatus::SUCCESS) {
+      std::cout << "[ERROR] Could not get exposure limits. " << royale::getStatusString(status).c_str() << std::endl;
       terminate();
       return -1;
     }
-  } else {
-    std::cout << "Requested manual exposure time: " << tof_exposure_time << " outside of safe limits[" << exposure_limits.first << "," << exposure_limits.second << "]"
-              << std::endl;
-    std::cout << "Keeping current exposure." << std::endl;
-  }
 
-  // Set camera properties
-  if (setCameraProperties(camera_) == -1) {
-    terminate();
-    return -1;
-  }
+    if (inRange(exposure_limits, tof_exposure_time)) {
+      if ((status = camera_->setExposureTime(tof_exposure_time)) != royale::CameraStatus::SUCCESS) {
+        std::cout << "[ERROR] setting exposure time to: " << tof_exposure_time << royale::getStatusString(status).c_str() << std::endl;
+        terminate();
+        return -1;
+      }
+    } else {
+      std::cout << "Requested manual exposure time: " << tof_exposure_time << " outside of safe limits[" << exposure_limits.first << "," << exposure_limits.second << "]"
+                << std::endl;
+      std::cout << "Keeping current exposure." << std::endl;
+    }
 
+    // Set camera properties
+    if (setCameraProperties(camera_) == -1) {
+      terminate();
+      return -1;
+    }
+  }
 
   // wait for camera
-  std::this_thread::sleep_for(std::chrono::seconds(1));
+  source_->settle(std::chrono::seconds(1));
 
   // Set collect data mode to TOF_DATA
   listener_.get()->setDataCollectionMode(MyListener::DataCollectionMode::TOF_DATA);
@@ -732,10 +786,15 @@ int main(int argc, char **argv) {
   num_frames_collected = 0;
   while (num_frames_collected < kTofSampleSize) {
     std::unique_lock<std::mutex> lock(cloudMutex);
+    source_->requestFrame();
     auto timeOut = (std::chrono::system_clock::now() + std::chrono::milliseconds(1000));
     if (cloudCV.wait_until(lock, timeOut, [&] { return newDataAvailable; })) {
       num_frames_collected++;
       newDataAvailable = false;
+    } else if (source_->isFinished()) {
+      std::cout << "[ERROR] The recording ended after " << num_frames_collected << " of " << kTofSampleSize << " ToF frames." << std::endl;
+      terminate();
+      return -1;
     }
   }
 
@@ -780,9 +839,9 @@ int main(int argc, char **argv) {
   for (int row = 0; row < line_image.rows; ++row) {
     uchar *line_image_ptr = line_image.ptr<uchar>(row);
     for (int col = 0; col < line_image.cols; ++col) {
-      if ((line_image_ptr[col] > 0) && (confident_pixel[confident_image_index].Mean() > ToF_calibration_params::kConfidentPixelThreshold)) {
-        cv::Point3f pt_3d(pt_x_running_stat[confident_image_index].Mean() * 1000.0f, pt_y_running_stat[confident_image_index].Mean() * 1000.0f,
-                          pt_z_running_stat[confident_image_index].Mean() * 1000.0f);
+      if ((line_image_ptr[col] > 0) && (confident_pixel.Mean(confident_image_index) > ToF_calibration_params::kConfidentPixelThreshold)) {
+        cv::Point3f pt_3d(pt_x_running_stat.Mean(confident_image_index) * 1000.0f, pt_y_running_stat.Mean(confident_image_index) * 1000.0f,
+                          pt_z_running_stat.Mean(confident_image_index) * 1000.0f);
         pt_3d_vector.push_back(pt_3d);
       }
       confident_image_index++;
@@ -916,11 +975,11 @@ int main(int argc, char **argv) {
     if (intensityFile.fail() || pointFile.fail()) {
       std::cout << "Couldn't open intensity or point output file" << std::endl;
     } else {
-      stringStream3 << pt_intensity_running_stat[0].Mean();
-      stringStream2 << pt_x_running_stat[0].Mean() << " " << pt_y_running_stat[0].Mean() << " " << pt_z_running_stat[0].Mean() << std::endl;
-      for (size_t index = 1; index < pt_intensity_running_stat.size(); ++index) {
-        stringStream3 << " " << pt_intensity_running_stat[index].Mean();
-        stringStream2 << pt_x_running_stat[index].Mean() << " " << pt_y_running_stat[index].Mean() << " " << pt_z_running_stat[index].Mean() << std::endl;
+      stringStream3 << pt_intensity_running_stat.Mean(0);
+      stringStream2 << pt_x_running_stat.Mean(0) << " " << pt_y_running_stat.Mean(0) << " " << pt_z_running_stat.Mean(0) << std::endl;
+      for (size_t index = 1; index < pt_intensity_running_stat.Size(); ++index) {
+        stringStream3 << " " << pt_intensity_running_stat.Mean(index);
+        stringStream2 << pt_x_running_stat.Mean(index) << " " << pt_y_running_stat.Mean(index) << " " << pt_z_running_stat.Mean(index) << std::endl;
       }
       stringStream3 << std::endl;
       intensityFile << stringStream3.str();
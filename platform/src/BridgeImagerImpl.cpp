@@ -72,4 +72,9 @@ void BridgeImagerImpl::sleepFor (std::chrono::microseconds sleepDuration)
     std::this_thread::sleep_for (sleepDuration);
 }
 
+royale::hal::BridgeImagerTransactionCost BridgeImagerImpl::getTransactionCost() const
+{
+    return royale::hal::BridgeImagerTransactionCost::i2c();
+}
+
 } // namespace platform
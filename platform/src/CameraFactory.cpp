@@ -8,6 +8,7 @@
 *
 \****************************************************************************/
 
+#include <common/exceptions/Exception.hpp>
 #include <common/MakeUnique.hpp>
 #include <common/SensorRoutingConfigI2c.hpp>
 #include <config/CoreConfig.hpp>
@@ -15,6 +16,7 @@
 #include <config/TemperatureSensorConfig.hpp>
 #include <device/CameraCore.hpp>
 #include <device/CameraDevice.hpp>
+#include <imager/ImagerM2452_B1x_AIO.hpp>
 #include <imager/M2452/PseudoDataInterpreter.hpp>
 #include <pal/II2cBusAccess.hpp>
 #include <pal/Access2I2cDeviceAdapter.hpp>
@@ -25,6 +27,7 @@
 #include <storage/StorageFormatPolar.hpp>
 #include <storage/StorageI2cEeprom.hpp>
 #include <storage/NonVolatileStoragePersistent.hpp>
+#include <storage/NonVolatileStorageShadow.hpp>
 #include <temperature/TemperatureSensorTMP102.hpp>
 #include <processing/ProcessingSpectre.hpp>
 #include <SensorMap.hpp>
@@ -41,6 +44,7 @@
 
 #include <BridgeImagerImpl.hpp>
 #include <I2cAccessImpl.hpp>
+#include <I2cInitSequence.hpp>
 
 #include <string>
 #include <thread>
@@ -108,76 +112,141 @@ namespace
     }
 
 #ifdef ROYALE_ENABLE_PLATFORM_CODE
-    bool ds90ub95xDigitalReset (royale::pal::II2cDeviceAccess &i2cDev)
+    const uint8_t DESERIALIZER_I2C_ADDRESS = 0x30;
+    const uint8_t SERIALIZER_I2C_ADDRESS = 0x0C;
+    const uint8_t IMAGER_I2C_ADDRESS = 0x3d;
+
+    /**
+    * Triggers the ds90ub95x digital reset and waits for the reset bit to clear again.
+    */
+    I2cInitSequence ds90ub95xDigitalReset (const std::string &name)
     {
-        unsigned tries = 4;
-        std::vector<uint8_t> temp (1);
-        i2cDev.writeI2cAddress8 (0x01, {0x06});
-        while (tries--)
+        return
         {
-            std::this_thread::sleep_for (std::chrono::milliseconds (4));
-            i2cDev.readI2cAddress8 (0x01, temp);
-            if (!temp[0])
-            {
-                return true;
-            }
-            else if (tries == 0)
-            {
-                return false;
-            }
-        }
-        return false;
+            I2cInitStep::write8 (0x01, 0x06),
+            I2cInitStep::waitFor8 (0x01, 0xff, 0x00, std::chrono::milliseconds (16), name + " digital reset"),
+        };
     }
 
-    void initDeserializer (royale::pal::II2cDeviceAccess &deser)
+    I2cInitSequence deserializerInit()
     {
-        if (!ds90ub95xDigitalReset (deser))
+        auto sequence = ds90ub95xDigitalReset ("deserializer");
+        sequence.insert (sequence.end(),
         {
-            LOG (WARN) << "Failed to reset deserializer" << std::endl;
-        }
+            I2cInitStep::write8 (0x16, 0x31),   //To configure GPIO6 to bring out RX Port 1 Lock indication
+            I2cInitStep::write8 (0x1f, 0x02),   //CSI Speed 800Mbps Serial rate
+            I2cInitStep::write8 (0x33, 0x21),   //Enable CSI output, CSI lane count : 2 Lane
+            I2cInitStep::write8 (0x20, 0x10),   //Enabled FWD for RX Port 1, disabled FWD for RX Port 0
+            I2cInitStep::write8 (0x4c, 0x12),   //Write/Read Enable for RX port 1
+            I2cInitStep::write8 (0x58, 0x5a),   //Enable I2C pass through to serializer
+            I2cInitStep::write8 (0x5c, 0x18),   //Serializer alias ID
+            I2cInitStep::write8 (0x5d, 0x7a),   //Sensor Slave ID
+            I2cInitStep::write8 (0x65, 0x7a),   //Slave alias ID
+            I2cInitStep::write8 (0x5e, 0x92),   //TMP Sensor Slave ID
+            I2cInitStep::write8 (0x66, 0x92),   //TMP Sensor Slave alias ID
+            I2cInitStep::write8 (0x5f, 0xA0),   //TMP Sensor Slave ID
+            I2cInitStep::write8 (0x67, 0xA0),   //TMP Sensor Slave alias ID
+            I2cInitStep::write8 (0x60, 0xA2),   //TMP Sensor Slave ID
+            I2cInitStep::write8 (0x68, 0xA2),   //TMP Sensor Slave alias ID
+            I2cInitStep::write8 (0x61, 0xA4),   //TMP Sensor Slave ID
+            I2cInitStep::write8 (0x69, 0xA4),   //TMP Sensor Slave alias ID
+            I2cInitStep::write8 (0x7c, 0x41),   //FV active low
+            I2cInitStep::write8 (0x6d, 0x78),   //CSI Mode
+            I2cInitStep::write8 (0x02, 0x3E),   //CSI Mode
+            I2cInitStep::write8 (0x0A, 0x13),   //CSI Mode
+            I2cInitStep::write8 (0x0B, 0x25),   //CSI Mode
+        });
+        return sequence;
+    }
+
+    /**
+    * Resets the serializer and pulses the imager's reset line (GPIO0 of the serializer).
+    */
+    I2cInitSequence serializerReset()
+    {
+        auto sequence = ds90ub95xDigitalReset ("serializer");
+        sequence.insert (sequence.end(),
+        {
+            I2cInitStep::write8 (0x0E, 0x10),
+            I2cInitStep::write8 (0x0D, 0x00),
+            I2cInitStep::delay (std::chrono::milliseconds (50)),
+            I2cInitStep::write8 (0x0D, 0x01),
+        });
+        return sequence;
+    }
+
+    /**
+    * Waits for the imager to answer after its reset has been released, this replaces a fixed
+    * 500ms sleep.  Reads fail or return garbage until the imager is up, the design step is
+    * the first register that is known to have a fixed value.
+    */
+    I2cInitSequence imagerReady (const DesignStepInfo &designStep)
+    {
+        return
+        {
+            I2cInitStep::waitForAny16 (designStep.ANAIP_DESIGNSTEP_Address, designStep.designSteps,
+                                       std::chrono::milliseconds (500), "imager to leave reset"),
+        };
+    }
+
+    I2cInitSequence serializerLinkConfig()
+    {
+        return
+        {
+            I2cInitStep::write8 (0x02, 0x53),
+            I2cInitStep::write8 (0x03, 0x13),
+            I2cInitStep::write8 (0x05, 0x03),
+            I2cInitStep::write8 (0x0B, 0x13),
+            I2cInitStep::write8 (0x0C, 0x26),
+        };
+    }
 
-        deser.writeI2cAddress8 (0x16, { 0x31 });   //To configure GPIO6 to bring out RX Port 1 Lock indication
-        deser.writeI2cAddress8 (0x1f, { 0x02 });   //CSI Speed 800Mbps Serial rate
-        deser.writeI2cAddress8 (0x33, { 0x21 });   //Enable CSI output, CSI lane count : 2 Lane
-        deser.writeI2cAddress8 (0x20, { 0x10 });   //Enabled FWD for RX Port 1, disabled FWD for RX Port 0
-        deser.writeI2cAddress8 (0x4c, { 0x12 });   //Write/Read Enable for RX port 1
-        deser.writeI2cAddress8 (0x58, { 0x5a });   //Enable I2C pass through to serializer
-        deser.writeI2cAddress8 (0x5c, { 0x18 });   //Serializer alias ID
-        deser.writeI2cAddress8 (0x5d, { 0x7a });   //Sensor Slave ID
-        deser.writeI2cAddress8 (0x65, { 0x7a });   //Slave alias ID
-        deser.writeI2cAddress8 (0x5e, { 0x92 });   //TMP Sensor Slave ID
-        deser.writeI2cAddress8 (0x66, { 0x92 });   //TMP Sensor Slave alias ID
-        deser.writeI2cAddress8 (0x5f, { 0xA0 });   //TMP Sensor Slave ID
-        deser.writeI2cAddress8 (0x67, { 0xA0 });   //TMP Sensor Slave alias ID
-        deser.writeI2cAddress8 (0x60, { 0xA2 });   //TMP Sensor Slave ID
-        deser.writeI2cAddress8 (0x68, { 0xA2 });   //TMP Sensor Slave alias ID
-        deser.writeI2cAddress8 (0x61, { 0xA4 });   //TMP Sensor Slave ID
-        deser.writeI2cAddress8 (0x69, { 0xA4 });   //TMP Sensor Slave alias ID
-        deser.writeI2cAddress8 (0x7c, { 0x41 });   //FV active low
-        deser.writeI2cAddress8 (0x6d, { 0x78 });   //CSI Mode
-        deser.writeI2cAddress8 (0x02, { 0x3E });   //CSI Mode
-        deser.writeI2cAddress8 (0x0A, { 0x13 });   //CSI Mode
-        deser.writeI2cAddress8 (0x0B, { 0x25 });   //CSI Mode
+    /**
+    * Waits for the deserializer's RX port 1 (selected with register 0x4c) to report LOCK_STS in
+    * RX_PORT_STS1.
+    */
+    I2cInitSequence deserializerLocked()
+    {
+        return
+        {
+            I2cInitStep::waitFor8 (0x4D, 0x01, 0x01, std::chrono::milliseconds (50), "deserializer lock"),
+        };
     }
 
-    void initSerializer (royale::pal::II2cDeviceAccess &serializer)
+    /**
+    * Brings up the link and the imager.  The calibration EEPROM behind the serializer is read
+    * once the imager is up, on success flash is replaced by the copy that was read.
+    */
+    void initLink (royale::pal::II2cDeviceAccess &deserializer,
+                   royale::pal::II2cDeviceAccess &serializer,
+                   royale::pal::II2cDeviceAccess &imager,
+                   const DesignStepInfo &designStep,
+                   std::shared_ptr<royale::hal::INonVolatileStorage> &flash)
     {
-        if (!ds90ub95xDigitalReset (serializer))
+        I2cInitSequenceRunner runner;
+        runner.run (deserializer, deserializerInit());
+        runner.run (serializer, serializerReset());
+        runner.run (imager, imagerReady (designStep));
+
+        // The EEPROM and the imager share the bus behind the serializer, and I2cAccessImpl
+        // doesn't serialize the transfers, so the EEPROM is only read after the imager's
+        // polling.  It has to be read before the serializer's remote I2C master settings change.
+        try
         {
-            LOG (WARN) << "Failed to reset serializer" << std::endl;
+            flash = std::make_shared<NonVolatileStorageShadow> (*flash);
+        }
+        catch (const Exception &e)
+        {
+            // Keep the original storage, the error will be reported when the calibration is used
+            LOG (WARN) << "Reading the calibration during bring-up failed: " << e.getTechnicalDescription();
+        }
+        catch (const std::exception &e)
+        {
+            LOG (WARN) << "Reading the calibration during bring-up failed: " << e.what();
         }
 
-        serializer.writeI2cAddress8 (0x0E, {0x10});
-        serializer.writeI2cAddress8 (0x0D, {0x00});
-        std::this_thread::sleep_for (std::chrono::milliseconds (50));
-        serializer.writeI2cAddress8 (0x0D, {0x01});
-        std::this_thread::sleep_for (std::chrono::milliseconds (500));
-        serializer.writeI2cAddress8 (0x02, {0x53});
-        serializer.writeI2cAddress8 (0x03, {0x13});
-        serializer.writeI2cAddress8 (0x05, {0x03});
-        serializer.writeI2cAddress8 (0x0B, {0x13});
-        serializer.writeI2cAddress8 (0x0C, {0x26});
-        std::this_thread::sleep_for (std::chrono::milliseconds (50));
+        runner.run (serializer, serializerLinkConfig());
+        runner.run (deserializer, deserializerLocked());
     }
 #endif
 }
@@ -252,13 +321,18 @@ std::unique_ptr<ICameraDevice> CameraFactory::createDevice (
     uint16_t rawFrameRate = 0u;
     flowControl.reset (new FlowControlStrategyFixed (rawFrameRate));
 
-    // Configure Deserializer
-    auto deserializer = std::make_shared<royale::pal::Access2I2cDeviceAdapter> (i2cAccess, 0x30);
-    initDeserializer (*deserializer);
+    // The bring-up waits for the imager's design step, which is only known for the M2452
+    if (imagerConfig->imagerType != royale::config::ImagerType::M2452_B1x_AIO)
+    {
+        LOG (ERROR) << "The link bring-up doesn't support the configured imager";
+        return nullptr;
+    }
 
-    // Configure Serializer
-    auto serializer = std::make_shared<royale::pal::Access2I2cDeviceAdapter> (i2cAccess, 0x0C);
-    initSerializer (*serializer);
+    // Configure Deserializer and Serializer
+    royale::pal::Access2I2cDeviceAdapter deserializer (i2cAccess, DESERIALIZER_I2C_ADDRESS);
+    royale::pal::Access2I2cDeviceAdapter serializer (i2cAccess, SERIALIZER_I2C_ADDRESS);
+    royale::pal::Access2I2cDeviceAdapter imagerDevice (i2cAccess, IMAGER_I2C_ADDRESS);
+    initLink (deserializer, serializer, imagerDevice, ImagerM2452_B1x_AIO::getDesignStepInfo(), flash);
 
     std::unique_ptr<CameraCore> cameraModule = nullptr;
 
@@ -341,7 +415,7 @@ std::unique_ptr<ICameraDevice> CameraFactory::createCamera()
     // create an instance of a I2CAccess
     std::shared_ptr<royale::pal::II2cBusAccess> i2cAccess = std::make_shared<I2cAccessImpl> ("/dev/i2c-3");
 
-    auto imagerAdapter = std::make_shared<royale::pal::Access2I2cDeviceAdapter> (i2cAccess, 0x3d);
+    auto imagerAdapter = std::make_shared<royale::pal::Access2I2cDeviceAdapter> (i2cAccess, IMAGER_I2C_ADDRESS);
     // get an implementation of the IBridgeImager interface in order to talk to the imager
     std::shared_ptr<royale::hal::IBridgeImager> bridgeImager = std::make_shared<BridgeImagerImpl> (imagerAdapter);
 
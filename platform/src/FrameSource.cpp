@@ -0,0 +1,219 @@
+/****************************************************************************\
+* Copyright (C) 2019 pmdtechnologies ag
+*
+* THIS CODE AND INFORMATION ARE PROVIDED "AS IS" WITHOUT WARRANTY OF ANY
+* KIND, EITHER EXPRESSED OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE
+* IMPLIED WARRANTIES OF MERCHANTABILITY AND/OR FITNESS FOR A
+* PARTICULAR PURPOSE.
+*
+\****************************************************************************/
+
+#include <FrameSource.hpp>
+#include <CameraFactory.hpp>
+
+#include <royale/IPlaybackStopListener.hpp>
+#include <royale/IReplay.hpp>
+
+#include <condition_variable>
+#include <fstream>
+#include <iostream>
+#include <mutex>
+#include <thread>
+
+using namespace platform;
+using namespace royale;
+
+namespace
+{
+    class LiveFrameSource : public FrameSource
+    {
+    public:
+        explicit LiveFrameSource (std::unique_ptr<ICameraDevice> device) :
+            FrameSource (std::move (device))
+        {
+        }
+
+        bool isLive() const override
+        {
+            return true;
+        }
+
+        void settle (std::chrono::milliseconds time) override
+        {
+            std::this_thread::sleep_for (time);
+        }
+
+        void requestFrame() override
+        {
+        }
+
+        bool admitFrame() override
+        {
+            return true;
+        }
+
+        bool isFinished() const override
+        {
+            return false;
+        }
+    };
+
+    /**
+    * Plays a recording once, without waiting for the recorded timestamps.  The playback thread
+    * is held in admitFrame() until the consumer requests the next frame.
+    */
+    class ReplayFrameSource : public FrameSource, public IPlaybackStopListener
+    {
+    public:
+        explicit ReplayFrameSource (std::unique_ptr<ICameraDevice> device, IReplay &replay) :
+            FrameSource (std::move (device)),
+            m_replay (replay),
+            m_requested (false),
+            m_released (false),
+            m_finished (false)
+        {
+            m_replay.loop (false);
+            m_replay.useTimestamps (false);
+            m_replay.registerStopListener (this);
+        }
+
+        ~ReplayFrameSource() override
+        {
+            // The playback thread calls admitFrame(), it has to end before this object does
+            release();
+            m_replay.unregisterStopListener();
+            m_device->stopCapture();
+        }
+
+        bool isLive() const override
+        {
+            return false;
+        }
+
+        void settle (std::chrono::milliseconds) override
+        {
+        }
+
+        CameraStatus stopCapture() override
+        {
+            // CameraPlayback joins its playback thread, which may be waiting in admitFrame()
+            release();
+            return FrameSource::stopCapture();
+        }
+
+        void requestFrame() override
+        {
+            {
+                std::lock_guard<std::mutex> lock (m_lock);
+                m_requested = true;
+            }
+            m_changed.notify_all();
+        }
+
+        bool admitFrame() override
+        {
+            std::unique_lock<std::mutex> lock (m_lock);
+            m_changed.wait (lock, [this] { return m_requested || m_released; });
+            if (m_released)
+            {
+                return false;
+            }
+            m_requested = false;
+            return true;
+        }
+
+        bool isFinished() const override
+        {
+            std::lock_guard<std::mutex> lock (m_lock);
+            return m_finished;
+        }
+
+        void onPlaybackStopped() override
+        {
+            std::lock_guard<std::mutex> lock (m_lock);
+            m_finished = true;
+        }
+
+    private:
+        /**
+        * Lets the listener return from admitFrame(), and makes it ignore all further frames.
+        */
+        void release()
+        {
+            {
+                std::lock_guard<std::mutex> lock (m_lock);
+                m_released = true;
+            }
+            m_changed.notify_all();
+        }
+
+        IReplay &m_replay;
+        mutable std::mutex m_lock;
+        std::condition_variable m_changed;
+        bool m_requested;
+        bool m_released;
+        bool m_finished;
+    };
+}
+
+const char *const FrameSource::LIVE = "live";
+
+FrameSource::FrameSource (std::unique_ptr<ICameraDevice> device) :
+    m_device (std::move (device))
+{
+}
+
+ICameraDevice &FrameSource::device()
+{
+    return *m_device;
+}
+
+CameraStatus FrameSource::stopCapture()
+{
+    return m_device->stopCapture();
+}
+
+std::unique_ptr<FrameSource> FrameSource::create (const std::string &source)
+{
+    CameraFactory factory;
+    if (source.empty() || source == LIVE)
+    {
+        auto device = factory.createCamera();
+        if (device == nullptr)
+        {
+            return nullptr;
+        }
+        return std::unique_ptr<FrameSource> (new LiveFrameSource (std::move (device)));
+    }
+
+#ifdef ROYALE_FACTORY_PLAYBACK
+    // The playback device only opens the file in initialize(), but then the tools can only
+    // report that the camera couldn't be initialized
+    if (!std::ifstream (source).good())
+    {
+        std::cerr << "[ERROR] Could not open the recording " << source << std::endl;
+        return nullptr;
+    }
+
+    std::unique_ptr<ICameraDevice> device;
+    try
+    {
+        device = factory.createPlaybackDevice (source.c_str());
+    }
+    catch (const std::exception &e)
+    {
+        std::cerr << "[ERROR] Could not open the recording " << source << ": " << e.what() << std::endl;
+        return nullptr;
+    }
+
+    auto replay = dynamic_cast<IReplay *> (device.get());
+    if (replay == nullptr)
+    {
+        return nullptr;
+    }
+    return std::unique_ptr<FrameSource> (new ReplayFrameSource (std::move (device), *replay));
+#else
+    std::cerr << "[ERROR] This build can't replay recordings" << std::endl;
+    return nullptr;
+#endif
+}
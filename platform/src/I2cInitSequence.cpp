@@ -0,0 +1,172 @@
+/****************************************************************************\
+* Copyright (C) 2019 pmdtechnologies ag
+*
+* THIS CODE AND INFORMATION ARE PROVIDED "AS IS" WITHOUT WARRANTY OF ANY
+* KIND, EITHER EXPRESSED OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE
+* IMPLIED WARRANTIES OF MERCHANTABILITY AND/OR FITNESS FOR A
+* PARTICULAR PURPOSE.
+*
+\****************************************************************************/
+
+#include <I2cInitSequence.hpp>
+
+#include <common/ExponentialBackoff.hpp>
+#include <common/exceptions/Exception.hpp>
+#include <common/RoyaleLogger.hpp>
+
+#include <algorithm>
+#include <thread>
+
+using namespace platform;
+using namespace royale::common;
+
+namespace
+{
+    /**
+    * Delays between two reads of a WAIT_FOR_VALUE step.  Each read is a full I2C transaction,
+    * polling faster than this mostly adds bus traffic.
+    */
+    const auto POLL_INITIAL_DELAY = std::chrono::microseconds (500);
+    const auto POLL_MAXIMUM_DELAY = std::chrono::milliseconds (16);
+}
+
+I2cInitStep I2cInitStep::write8 (uint8_t reg, uint8_t value)
+{
+    return { Kind::WRITE, false, reg, 0xff, value, std::chrono::microseconds::zero(), "", {} };
+}
+
+I2cInitStep I2cInitStep::write16 (uint16_t reg, uint16_t value)
+{
+    return { Kind::WRITE, true, reg, 0xffff, value, std::chrono::microseconds::zero(), "", {} };
+}
+
+I2cInitStep I2cInitStep::waitFor8 (uint8_t reg, uint8_t mask, uint8_t value,
+                                   std::chrono::microseconds timeout, const std::string &description)
+{
+    return { Kind::WAIT_FOR_VALUE, false, reg, mask, value, timeout, description, {} };
+}
+
+I2cInitStep I2cInitStep::waitFor16 (uint16_t reg, uint16_t mask, uint16_t value,
+                                    std::chrono::microseconds timeout, const std::string &description)
+{
+    return { Kind::WAIT_FOR_VALUE, true, reg, mask, value, timeout, description, {} };
+}
+
+I2cInitStep I2cInitStep::waitForAny16 (uint16_t reg, const std::vector<uint16_t> &values,
+                                       std::chrono::microseconds timeout, const std::string &description)
+{
+    return { Kind::WAIT_FOR_VALUE, true, reg, 0xffff, values.empty() ? uint16_t (0) : values.front(), timeout, description, values };
+}
+
+I2cInitStep I2cInitStep::delay (std::chrono::microseconds duration)
+{
+    return { Kind::DELAY, false, 0, 0, 0, duration, "", {} };
+}
+
+bool I2cInitStep::accepts (uint16_t readValue) const
+{
+    if (values.empty())
+    {
+        return (readValue & mask) == value;
+    }
+    return std::find (values.begin(), values.end(), readValue) != values.end();
+}
+
+I2cInitSequenceRunner::I2cInitSequenceRunner (SleepFunction sleep) :
+    m_sleep (std::move (sleep))
+{
+    if (!m_sleep)
+    {
+        m_sleep = [] (std::chrono::microseconds duration)
+        {
+            std::this_thread::sleep_for (duration);
+        };
+    }
+}
+
+bool I2cInitSequenceRunner::run (royale::pal::II2cDeviceAccess &device, const I2cInitSequence &sequence)
+{
+    bool allReady = true;
+    for (const auto &step : sequence)
+    {
+        allReady &= runStep (device, step);
+    }
+    return allReady;
+}
+
+bool I2cInitSequenceRunner::runStep (royale::pal::II2cDeviceAccess &device, const I2cInitStep &step)
+{
+    switch (step.kind)
+    {
+        case I2cInitStep::Kind::WRITE:
+            if (step.address16)
+            {
+                device.writeI2cAddress16 (step.reg, { static_cast<uint8_t> (step.value >> 8),
+                                                      static_cast<uint8_t> (step.value & 0xff)
+                                                    });
+            }
+            else
+            {
+                device.writeI2cAddress8 (static_cast<uint8_t> (step.reg), { static_cast<uint8_t> (step.value) });
+            }
+            return true;
+
+        case I2cInitStep::Kind::DELAY:
+            m_sleep (step.time);
+            return true;
+
+        case I2cInitStep::Kind::WAIT_FOR_VALUE:
+            break;
+    }
+
+    ExponentialBackoff backoff (POLL_INITIAL_DELAY, POLL_MAXIMUM_DELAY, step.time);
+    std::chrono::microseconds delay;
+    while (!readMatches (device, step))
+    {
+        if (!backoff.next (delay))
+        {
+            LOG (WARN) << "Timed out waiting for " << step.description << " after "
+                       << backoff.elapsed().count() << "us";
+            return false;
+        }
+        m_sleep (delay);
+    }
+
+    LOG (DEBUG) << step.description << " after " << backoff.elapsed().count() << "us";
+    return true;
+}
+
+bool I2cInitSequenceRunner::readMatches (royale::pal::II2cDeviceAccess &device, const I2cInitStep &step)
+{
+    // Some II2cBusAccess implementations leave the buffer unchanged when the device doesn't
+    // acknowledge, so preset it with a value that can't match.  Of values.size() + 1 candidates
+    // at least one isn't in values.
+    uint16_t notReady = static_cast<uint16_t> (~step.value);
+    for (std::size_t i = 0; i < step.values.size() && step.accepts (notReady); ++i)
+    {
+        notReady++;
+    }
+    uint16_t value;
+    try
+    {
+        if (step.address16)
+        {
+            std::vector<uint8_t> buf { static_cast<uint8_t> (notReady >> 8), static_cast<uint8_t> (notReady & 0xff) };
+            device.readI2cAddress16 (step.reg, buf);
+            value = static_cast<uint16_t> ( (buf.at (0) << 8) | buf.at (1));
+        }
+        else
+        {
+            std::vector<uint8_t> buf { static_cast<uint8_t> (notReady & 0xff) };
+            device.readI2cAddress8 (static_cast<uint8_t> (step.reg), buf);
+            value = buf.at (0);
+        }
+    }
+    catch (const Exception &)
+    {
+        // A device behind the serializer doesn't respond until the link is up
+        return false;
+    }
+
+    return step.accepts (value);
+}
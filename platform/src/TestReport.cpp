@@ -0,0 +1,124 @@
+/****************************************************************************\
+* Copyright (C) 2019 pmdtechnologies ag
+*
+* THIS CODE AND INFORMATION ARE PROVIDED "AS IS" WITHOUT WARRANTY OF ANY
+* KIND, EITHER EXPRESSED OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE
+* IMPLIED WARRANTIES OF MERCHANTABILITY AND/OR FITNESS FOR A
+* PARTICULAR PURPOSE.
+*
+\****************************************************************************/
+
+#include <TestReport.hpp>
+
+#include <algorithm>
+#include <functional>
+#include <vector>
+
+using namespace platform;
+
+namespace
+{
+    /**
+     * The value at the 90th percentile, zero for no values.
+     */
+    float calculateQ90 (std::vector<float> values)
+    {
+        if (values.empty())
+        {
+            return 0.0f;
+        }
+        std::nth_element (values.begin(), values.begin() + values.size() / 10, values.end(), std::greater<float>());
+        return values[values.size() / 10];
+    }
+}
+
+TemporalDepthMetrics TemporalDepthMetrics::compute (const RunningStatPlanes &depth,
+        const RunningStatPlanes &amplitude,
+        float minSamples,
+        float groundTruthDistance)
+{
+    TemporalDepthMetrics metrics;
+    std::vector<float> precisions;
+    std::vector<float> accuracyPercents;
+    for (std::size_t i = 0u; i < depth.Size(); ++i)
+    {
+        if (depth.NumDataValues (i) < minSamples)
+        {
+            continue;
+        }
+        const auto stdDev = depth.StandardDeviation (i);
+        precisions.push_back (stdDev);
+        metrics.depthPrecision += stdDev;
+
+        const auto accuracy = depth.Mean (i) - groundTruthDistance;
+        metrics.depthAccuracy += accuracy;
+        accuracyPercents.push_back (accuracy / groundTruthDistance);
+
+        metrics.amplitudeStdDev += amplitude.StandardDeviation (i);
+        const auto amplitudeMean = amplitude.Mean (i);
+        metrics.amplitudeMean += amplitudeMean;
+        metrics.amplitudeMin = std::min (metrics.amplitudeMin, amplitudeMean);
+        metrics.amplitudeMax = std::max (metrics.amplitudeMax, amplitudeMean);
+        metrics.pixelCount++;
+    }
+
+    if (metrics.pixelCount > 0u)
+    {
+        const auto count = static_cast<float> (metrics.pixelCount);
+        metrics.depthPrecision /= count;
+        metrics.depthAccuracy /= count;
+        metrics.amplitudeStdDev /= count;
+        metrics.amplitudeMean /= count;
+    }
+    metrics.depthAccuracyPercent = 100.0f * (metrics.depthAccuracy / groundTruthDistance);
+    metrics.depthPrecisionQ90 = calculateQ90 (std::move (precisions));
+    metrics.depthAccuracyPercentQ90 = 100.0f * calculateQ90 (std::move (accuracyPercents));
+    return metrics;
+}
+
+TestReport::TestReport (std::ostream &os) :
+    m_os (os),
+    m_failures (0u)
+{
+}
+
+bool TestReport::check (const char *name, float value, const std::pair<float, float> &limits)
+{
+    const bool passed = (value - limits.second) * (value - limits.first) <= 0.0f;
+    m_os << (passed ? "[PASS]:" : "[FAIL]:") << name << ":" << value << std::endl;
+    if (!passed)
+    {
+        m_failures++;
+    }
+    return passed;
+}
+
+bool TestReport::check (const char *name, int value, bool passed)
+{
+    m_os << (passed ? "[PASS]:" : "[FAIL]:") << name << ":" << value << std::endl;
+    if (!passed)
+    {
+        m_failures++;
+    }
+    return passed;
+}
+
+void TestReport::info (const char *name, float value)
+{
+    m_os << "[INFO]:" << name << ":" << value << std::endl;
+}
+
+void TestReport::groupPassed (const char *group)
+{
+    m_os << "[SUCCESS] All " << group << " tests passed." << std::endl;
+}
+
+void TestReport::groupSkipped (const char *group, const char *reason)
+{
+    m_os << "[SKIPPED] The " << group << " tests didn't run, " << reason << std::endl;
+}
+
+std::size_t TestReport::failures() const
+{
+    return m_failures;
+}
@@ -0,0 +1,448 @@
+/****************************************************************************\
+* Copyright (C) 2019 pmdtechnologies ag
+*
+* THIS CODE AND INFORMATION ARE PROVIDED "AS IS" WITHOUT WARRANTY OF ANY
+* KIND, EITHER EXPRESSED OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE
+* IMPLIED WARRANTIES OF MERCHANTABILITY AND/OR FITNESS FOR A
+* PARTICULAR PURPOSE.
+*
+\****************************************************************************/
+
+#include <gtest/gtest.h>
+
+#include <FrameSource.hpp>
+#include <TestReport.hpp>
+#include <parameters.hpp>
+#include <running_stat_planes.hpp>
+#include <record/FileReaderDispatcher.hpp>
+#include <record/FileWriter.hpp>
+#include <royale/IDepthDataListener.hpp>
+#include <royale/IReplay.hpp>
+
+#include <chrono>
+#include <condition_variable>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <iomanip>
+#include <iterator>
+#include <mutex>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace platform;
+
+namespace
+{
+    const char *const RRF_FILE_NAME = ROYALE_TEST_FILE_PATH "/ListenerTest.rrf";
+    const char *const GOLDEN_REPORT_FILE_NAME = PLATFORM_TEST_FILE_PATH "/ListenerTest_Report.txt";
+
+    /** Written by writeMultiFrameRecording(), in the working directory of the test */
+    const char *const MULTI_FRAME_FILE_NAME = "TestFrameSource_MultiFrame.rrf";
+    const uint32_t MULTI_FRAME_COUNT = 8u;
+
+    /**
+    * Requests the frames of a replay one at a time, and passes each admitted frame to collect(),
+    * the way the tools' listeners use a frame.
+    */
+    class ReplayListener : public royale::IDepthDataListener
+    {
+    public:
+        explicit ReplayListener (FrameSource &source) :
+            m_source (source),
+            m_count (0u)
+        {
+        }
+
+        void onNewData (const royale::DepthData *data) override
+        {
+            if (!m_source.admitFrame())
+            {
+                return;
+            }
+
+            {
+                std::lock_guard<std::mutex> lock (m_lock);
+                collect (data);
+                m_count++;
+            }
+            m_newData.notify_all();
+        }
+
+        /**
+        * Requests frames one at a time until the recording ends.
+        */
+        void replayAll()
+        {
+            for (;;)
+            {
+                std::unique_lock<std::mutex> lock (m_lock);
+                const auto count = m_count;
+                m_source.requestFrame();
+                if (!m_newData.wait_for (lock, std::chrono::seconds (1), [&] { return m_count > count; }) &&
+                        m_source.isFinished())
+                {
+                    return;
+                }
+            }
+        }
+
+        size_t count()
+        {
+            std::lock_guard<std::mutex> lock (m_lock);
+            return m_count;
+        }
+
+        bool waitForCount (size_t count)
+        {
+            std::unique_lock<std::mutex> lock (m_lock);
+            return m_newData.wait_for (lock, std::chrono::seconds (5), [&] { return m_count >= count; });
+        }
+
+    protected:
+        /** Called with the lock held for each admitted frame */
+        virtual void collect (const royale::DepthData *)
+        {
+        }
+
+    private:
+        FrameSource &m_source;
+        std::mutex m_lock;
+        std::condition_variable m_newData;
+        size_t m_count;
+    };
+
+    /**
+    * Collects a digest of each admitted frame.
+    */
+    class DigestListener : public ReplayListener
+    {
+    public:
+        explicit DigestListener (FrameSource &source) :
+            ReplayListener (source)
+        {
+        }
+
+        std::vector<uint64_t> m_digests;
+
+    protected:
+        void collect (const royale::DepthData *data) override
+        {
+            // FNV-1a over the fields of the points, bit-identical frames give the same digest.
+            // DepthPoint has padding, so the points can't be hashed as a whole.
+            uint64_t digest = 14695981039346656037ull;
+            const auto add = [&digest] (const void *value, size_t size)
+            {
+                const auto bytes = static_cast<const uint8_t *> (value);
+                for (size_t i = 0u; i < size; ++i)
+                {
+                    digest = (digest ^ bytes[i]) * 1099511628211ull;
+                }
+            };
+            for (const auto &point : data->points)
+            {
+                add (&point.x, sizeof (point.x));
+                add (&point.y, sizeof (point.y));
+                add (&point.z, sizeof (point.z));
+                add (&point.noise, sizeof (point.noise));
+                add (&point.grayValue, sizeof (point.grayValue));
+                add (&point.depthConfidence, sizeof (point.depthConfidence));
+            }
+            m_digests.push_back (digest);
+        }
+    };
+
+    /**
+    * Collects the per-pixel statistics that tof-testing keeps, with the gray value as the
+    * amplitude, and writes the temporal part of tof-testing's report with the same code.  The
+    * values are written with 4 significant digits, so that the report doesn't depend on the
+    * last bits of the compiler's floating point code.
+    */
+    class ReportListener : public ReplayListener
+    {
+    public:
+        explicit ReportListener (FrameSource &source) :
+            ReplayListener (source)
+        {
+        }
+
+        std::string report()
+        {
+            const auto metrics = TemporalDepthMetrics::compute (m_depth, m_amplitude,
+                                 static_cast<float> (m_frameCount) / 2.0f,
+                                 ToF_test_params::kGroundTruthDistance);
+            const auto pixelCount = static_cast<int> (metrics.pixelCount);
+
+            std::ostringstream os;
+            os << std::setprecision (4);
+            TestReport report (os);
+            report.info ("Frames", static_cast<float> (m_frameCount));
+            report.check ("Valid_Pixel_Count", pixelCount, pixelCount >= ToF_testing_limits::kConfidentPixelCount);
+            report.check ("Temporal_Depth_Precision", metrics.depthPrecision, ToF_testing_limits::kDepthPrecisionTemporal);
+            report.check ("Temporal_Depth_Precision_Q90", metrics.depthPrecisionQ90, ToF_testing_limits::kDepthPrecisionTemporalQ90);
+            report.check ("Depth_Accuracy", metrics.depthAccuracy, ToF_testing_limits::kDepthAccuracy);
+            report.check ("Depth_Accuracy_Percent", metrics.depthAccuracyPercent, ToF_testing_limits::kDepthAccuracyPercent);
+            report.check ("Depth_Accuracy_Percent_Q90", metrics.depthAccuracyPercentQ90, ToF_testing_limits::kDepthAccuracyPercentQ90);
+            report.check ("Amplitude_Temporal_Std_Dev", metrics.amplitudeStdDev, ToF_testing_limits::kAmplitudeStdTemporal);
+            report.check ("Amplitude_Mean", metrics.amplitudeMean, ToF_testing_limits::kAmplitudeMean);
+            report.check ("Amplitude_Max", metrics.amplitudeMax, ToF_testing_limits::kAmplitudeMax);
+            report.check ("Amplitude_Min", metrics.amplitudeMin, ToF_testing_limits::kAmplitudeMin);
+            report.info ("Failures", static_cast<float> (report.failures()));
+            return os.str();
+        }
+
+    protected:
+        void collect (const royale::DepthData *data) override
+        {
+            const auto size = data->points.size();
+            if (m_depth.Size() != size)
+            {
+                m_depth.Resize (size);
+                m_amplitude.Resize (size);
+            }
+
+            std::vector<float> depth (size);
+            std::vector<float> amplitude (size);
+            std::vector<uint8_t> valid (size);
+            for (size_t i = 0u; i < size; ++i)
+            {
+                const auto &point = data->points[i];
+                depth[i] = point.z;
+                amplitude[i] = static_cast<float> (point.grayValue);
+                valid[i] = point.depthConfidence > 0u ? 1u : 0u;
+            }
+            m_depth.Push (depth.data(), valid.data());
+            m_amplitude.Push (amplitude.data(), valid.data());
+            m_frameCount++;
+        }
+
+    private:
+        RunningStatPlanes m_depth;
+        RunningStatPlanes m_amplitude;
+        size_t m_frameCount = 0u;
+    };
+
+    /**
+    * Writes a recording of MULTI_FRAME_COUNT frames, each one is the frame of ListenerTest.rrf
+    * with a different deterministic noise of a few digits added to the raw data.  The checked-in
+    * recordings only have one frame, which gives no temporal statistics.
+    */
+    void writeMultiFrameRecording()
+    {
+        using namespace royale::record;
+
+        FileReaderDispatcher reader;
+        reader.open (RRF_FILE_NAME);
+
+        std::vector<std::vector<uint16_t>> imageData;
+        std::vector<std::vector<uint16_t>> pseudoData;
+        royale_frameheader_v3 frameHeader;
+        std::vector<royale_streamheader_v3> streamHeaders;
+        std::vector<royale_framegroupheader_v3> frameGroupHeaders;
+        std::vector<royale_exposuregroupheader_v3> exposureGroupHeaders;
+        std::vector<royale_rawframesetheader_v3> rawFrameSetHeaders;
+        std::vector<royale_processingparameter_v3> processingParameters;
+        std::vector<std::pair<std::string, std::vector<uint8_t>>> additionalData;
+        reader.get (imageData, pseudoData, &frameHeader, streamHeaders, frameGroupHeaders,
+                    exposureGroupHeaders, rawFrameSetHeaders, processingParameters, additionalData);
+
+        std::vector<std::string> componentNames;
+        std::vector<std::string> componentTypes;
+        std::vector<std::string> componentVersions;
+        for (const auto &version : reader.getComponentVersions())
+        {
+            componentNames.push_back (version.componentName);
+            componentTypes.push_back (version.componentType);
+            componentVersions.push_back (version.componentVersion);
+        }
+
+        std::vector<royale_additionaldata_v3> additionalHeaders (additionalData.size());
+        for (size_t i = 0u; i < additionalData.size(); ++i)
+        {
+            std::strncpy (additionalHeaders[i].dataName, additionalData[i].first.c_str(), sizeof (additionalHeaders[i].dataName) - 1u);
+            additionalHeaders[i].dataSize = additionalData[i].second.size();
+            additionalHeaders[i].data = additionalData[i].second.data();
+        }
+
+        FileWriter writer;
+        writer.open (MULTI_FRAME_FILE_NAME, reader.getCalibrationData(), reader.imagerSerial(),
+                     reader.cameraName(), reader.imagerType(), reader.pseudoDataInterpreterType(),
+                     reader.royaleMajor(), reader.royaleMinor(), reader.royalePatch(), reader.royaleBuild(),
+                     reader.platform(), componentNames, componentTypes, componentVersions);
+
+        std::vector<const uint16_t *> pseudoPointers;
+        for (const auto &pseudo : pseudoData)
+        {
+            pseudoPointers.push_back (pseudo.data());
+        }
+
+        // A linear congruential generator, so that the noise is the same on every platform
+        uint32_t random = 12345u;
+        std::vector<std::vector<uint16_t>> noisyData (imageData.size());
+        const auto firstTimestamp = frameHeader.timestamp;
+        for (uint32_t frame = 0u; frame < MULTI_FRAME_COUNT; ++frame)
+        {
+            std::vector<const uint16_t *> imagePointers;
+            for (size_t i = 0u; i < imageData.size(); ++i)
+            {
+                noisyData[i] = imageData[i];
+                for (auto &value : noisyData[i])
+                {
+                    random = random * 1664525u + 1013904223u;
+                    const auto noise = static_cast<int> (random >> 29) - 3;
+                    if (value >= 4u && value <= 4091u)
+                    {
+                        value = static_cast<uint16_t> (value + noise);
+                    }
+                }
+                imagePointers.push_back (noisyData[i].data());
+            }
+            frameHeader.timestamp = firstTimestamp + frame * 200u;
+            writer.put (imagePointers, pseudoPointers, &frameHeader, streamHeaders, frameGroupHeaders,
+                        exposureGroupHeaders, rawFrameSetHeaders, processingParameters, additionalHeaders);
+        }
+        writer.close();
+    }
+
+    std::unique_ptr<FrameSource> openReplay (const char *fileName = RRF_FILE_NAME)
+    {
+        auto source = FrameSource::create (fileName);
+        if (source != nullptr)
+        {
+            EXPECT_EQ (royale::CameraStatus::SUCCESS, source->device().initialize());
+        }
+        return source;
+    }
+
+    /**
+    * Replays the whole recording into listener, and returns the number of frames in the recording.
+    */
+    uint32_t replayInto (ReplayListener &listener, FrameSource &source)
+    {
+        auto replay = dynamic_cast<royale::IReplay *> (&source.device());
+        EXPECT_NE (nullptr, replay);
+
+        EXPECT_EQ (royale::CameraStatus::SUCCESS, source.device().registerDataListener (&listener));
+        EXPECT_EQ (royale::CameraStatus::SUCCESS, source.device().startCapture());
+        listener.replayAll();
+        EXPECT_EQ (royale::CameraStatus::SUCCESS, source.stopCapture());
+        return replay ? replay->frameCount() : 0u;
+    }
+
+    std::vector<uint64_t> replayDigests (uint32_t &frameCount)
+    {
+        auto source = openReplay();
+        EXPECT_TRUE (source != nullptr);
+        if (source == nullptr)
+        {
+            return {};
+        }
+
+        DigestListener listener (*source);
+        frameCount = replayInto (listener, *source);
+        return listener.m_digests;
+    }
+
+    std::string replayReport (const char *fileName)
+    {
+        auto source = openReplay (fileName);
+        EXPECT_TRUE (source != nullptr);
+        if (source == nullptr)
+        {
+            return {};
+        }
+
+        ReportListener listener (*source);
+        replayInto (listener, *source);
+        return listener.report();
+    }
+
+    std::string readFile (const char *fileName)
+    {
+        // Text mode, the checkout may have converted the line endings
+        std::ifstream file (fileName);
+        EXPECT_TRUE (file.is_open()) << "Can't open " << fileName;
+        return std::string (std::istreambuf_iterator<char> (file), std::istreambuf_iterator<char>());
+    }
+}
+
+TEST (TestFrameSource, ReplayIsNotLive)
+{
+    auto source = openReplay();
+    ASSERT_TRUE (source != nullptr);
+    EXPECT_FALSE (source->isLive());
+    EXPECT_FALSE (source->isFinished());
+
+    // A replay doesn't wait for the camera
+    const auto start = std::chrono::steady_clock::now();
+    source->settle (std::chrono::seconds (10));
+    const auto elapsed = std::chrono::steady_clock::now() - start;
+    EXPECT_LT (std::chrono::duration_cast<std::chrono::milliseconds> (elapsed).count(), 1000);
+}
+
+TEST (TestFrameSource, MissingRecording)
+{
+    EXPECT_TRUE (FrameSource::create (ROYALE_TEST_FILE_PATH "/doesNotExist.rrf") == nullptr);
+}
+
+/**
+ * The result of a replay only depends on the recording: every frame is delivered exactly once,
+ * and two runs see bit-identical frames in the same order.
+ */
+TEST (TestFrameSource, ReplayIsDeterministic)
+{
+    uint32_t frameCount = 0u;
+    const auto first = replayDigests (frameCount);
+    ASSERT_NE (0u, frameCount);
+    EXPECT_EQ (frameCount, first.size());
+
+    uint32_t secondFrameCount = 0u;
+    const auto second = replayDigests (secondFrameCount);
+    EXPECT_EQ (first, second);
+}
+
+/**
+ * The report of tof-testing's statistics over a replay of several frames is byte-identical to
+ * the one that was checked in.  If the recording, the processing or the report change on
+ * purpose, replace the file with the report that the failure prints.
+ */
+TEST (TestFrameSource, ReplayMatchesGoldenReport)
+{
+    ASSERT_NO_THROW (writeMultiFrameRecording());
+
+    const auto golden = readFile (GOLDEN_REPORT_FILE_NAME);
+    const auto report = replayReport (MULTI_FRAME_FILE_NAME);
+    EXPECT_FALSE (report.empty());
+    EXPECT_EQ (golden, report) << "The report of this replay was:" << std::endl << report;
+
+    // A second replay gives the same report
+    EXPECT_EQ (report, replayReport (MULTI_FRAME_FILE_NAME));
+
+    std::remove (MULTI_FRAME_FILE_NAME);
+}
+
+/**
+ * The playback thread waits in admitFrame() while no frame is requested, stopping the capture
+ * must release it instead of dead-locking on the join.
+ */
+TEST (TestFrameSource, StopWhileWaiting)
+{
+    auto source = openReplay();
+    ASSERT_TRUE (source != nullptr);
+
+    ReplayListener listener (*source);
+    ASSERT_EQ (royale::CameraStatus::SUCCESS, source->device().registerDataListener (&listener));
+    ASSERT_EQ (royale::CameraStatus::SUCCESS, source->device().startCapture());
+
+    source->requestFrame();
+    ASSERT_TRUE (listener.waitForCount (1u));
+
+    // Without a request no further frame is admitted
+    std::this_thread::sleep_for (std::chrono::milliseconds (100));
+    EXPECT_EQ (1u, listener.count());
+
+    EXPECT_EQ (royale::CameraStatus::SUCCESS, source->stopCapture());
+    EXPECT_EQ (1u, listener.count());
+}
@@ -0,0 +1,267 @@
+/****************************************************************************\
+* Copyright (C) 2019 pmdtechnologies ag
+*
+* THIS CODE AND INFORMATION ARE PROVIDED "AS IS" WITHOUT WARRANTY OF ANY
+* KIND, EITHER EXPRESSED OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE
+* IMPLIED WARRANTIES OF MERCHANTABILITY AND/OR FITNESS FOR A
+* PARTICULAR PURPOSE.
+*
+\****************************************************************************/
+
+#include <gtest/gtest.h>
+
+#include <I2cInitSequence.hpp>
+
+#include <map>
+#include <utility>
+
+using namespace platform;
+using namespace std::chrono;
+
+namespace
+{
+    /**
+    * A device on a simulated I2C bus.  The time is advanced only by the runner's sleep function,
+    * so the tests can check how long a sequence would have taken on the real hardware.
+    *
+    * Until the link is up (respondsFrom), reads behave like I2cAccessImpl when the device
+    * doesn't acknowledge: the buffer is left unchanged.
+    */
+    class FakeI2cDevice : public royale::pal::II2cDeviceAccess
+    {
+    public:
+        explicit FakeI2cDevice (const microseconds &clock) :
+            m_clock (clock),
+            m_respondsFrom (microseconds::zero())
+        {
+        }
+
+        void setRespondsFrom (microseconds time)
+        {
+            m_respondsFrom = time;
+        }
+
+        /**
+        * The register reads as value once the clock reaches the given time.
+        */
+        void setValueAt (uint16_t reg, microseconds time, uint16_t value)
+        {
+            m_scheduled[reg] = std::make_pair (time, value);
+        }
+
+        /**
+        * After a write, the register reads back the written value for latency, then zero.
+        */
+        void setSelfClearing (uint16_t reg, microseconds latency)
+        {
+            m_selfClearing[reg] = latency;
+        }
+
+        void readI2cNoAddress (std::vector<uint8_t> &) override
+        {
+        }
+
+        void writeI2cNoAddress (const std::vector<uint8_t> &) override
+        {
+        }
+
+        void readI2cAddress8 (uint8_t regAddr, std::vector<uint8_t> &buf) override
+        {
+            m_reads++;
+            if (m_clock >= m_respondsFrom)
+            {
+                buf.at (0) = static_cast<uint8_t> (valueNow (regAddr));
+            }
+        }
+
+        void writeI2cAddress8 (uint8_t regAddr, const std::vector<uint8_t> &buf) override
+        {
+            write (regAddr, buf.at (0));
+        }
+
+        void readI2cAddress16 (uint16_t regAddr, std::vector<uint8_t> &buf) override
+        {
+            m_reads++;
+            if (m_clock >= m_respondsFrom)
+            {
+                const auto value = valueNow (regAddr);
+                buf.at (0) = static_cast<uint8_t> (value >> 8);
+                buf.at (1) = static_cast<uint8_t> (value & 0xff);
+            }
+        }
+
+        void writeI2cAddress16 (uint16_t regAddr, const std::vector<uint8_t> &buf) override
+        {
+            write (regAddr, static_cast<uint16_t> ( (buf.at (0) << 8) | buf.at (1)));
+        }
+
+        std::vector<std::pair<uint16_t, uint16_t>> m_writes;
+        std::size_t m_reads = 0;
+
+    private:
+        void write (uint16_t reg, uint16_t value)
+        {
+            m_writes.emplace_back (reg, value);
+            m_registers[reg] = value;
+
+            const auto selfClearing = m_selfClearing.find (reg);
+            if (selfClearing != m_selfClearing.end())
+            {
+                setValueAt (reg, m_clock + selfClearing->second, 0);
+            }
+        }
+
+        uint16_t valueNow (uint16_t reg) const
+        {
+            const auto scheduled = m_scheduled.find (reg);
+            if (scheduled != m_scheduled.end() && m_clock >= scheduled->second.first)
+            {
+                return scheduled->second.second;
+            }
+            const auto current = m_registers.find (reg);
+            return current == m_registers.end() ? 0 : current->second;
+        }
+
+        const microseconds &m_clock;
+        microseconds m_respondsFrom;
+        std::map<uint16_t, uint16_t> m_registers;
+        std::map<uint16_t, std::pair<microseconds, uint16_t>> m_scheduled;
+        std::map<uint16_t, microseconds> m_selfClearing;
+    };
+
+    class TestI2cInitSequence : public ::testing::Test
+    {
+    protected:
+        TestI2cInitSequence() :
+            m_clock (microseconds::zero()),
+            m_device (m_clock),
+            m_runner ([this] (microseconds duration)
+        {
+            m_clock += duration;
+        })
+        {
+        }
+
+        microseconds m_clock;
+        FakeI2cDevice m_device;
+        I2cInitSequenceRunner m_runner;
+    };
+}
+
+TEST_F (TestI2cInitSequence, WritesInOrder)
+{
+    const I2cInitSequence sequence
+    {
+        I2cInitStep::write8 (0x0E, 0x10),
+        I2cInitStep::write8 (0x0D, 0x00),
+        I2cInitStep::delay (milliseconds (50)),
+        I2cInitStep::write8 (0x0D, 0x01),
+        I2cInitStep::write16 (0xa0a5, 0x0b12),
+    };
+
+    EXPECT_TRUE (m_runner.run (m_device, sequence));
+
+    const std::vector<std::pair<uint16_t, uint16_t>> expected
+    {
+        { 0x0E, 0x10 }, { 0x0D, 0x00 }, { 0x0D, 0x01 }, { 0xa0a5, 0x0b12 }
+    };
+    EXPECT_EQ (expected, m_device.m_writes);
+    EXPECT_EQ (milliseconds (50), m_clock);
+    EXPECT_EQ (0u, m_device.m_reads);
+}
+
+TEST_F (TestI2cInitSequence, ReadyDeviceDoesNotSleep)
+{
+    m_device.setValueAt (0x4D, microseconds::zero(), 0x03);
+
+    EXPECT_TRUE (m_runner.run (m_device, { I2cInitStep::waitFor8 (0x4D, 0x01, 0x01, milliseconds (50), "lock") }));
+    EXPECT_EQ (microseconds::zero(), m_clock);
+    EXPECT_EQ (1u, m_device.m_reads);
+}
+
+TEST_F (TestI2cInitSequence, DigitalResetFinishesEarly)
+{
+    // The reset bit clears 300us after it was set, the old code always slept 4ms
+    m_device.setSelfClearing (0x01, microseconds (300));
+
+    const I2cInitSequence sequence
+    {
+        I2cInitStep::write8 (0x01, 0x06),
+        I2cInitStep::waitFor8 (0x01, 0xff, 0x00, milliseconds (16), "reset"),
+    };
+
+    EXPECT_TRUE (m_runner.run (m_device, sequence));
+    EXPECT_GE (m_clock, microseconds (300));
+    EXPECT_LT (m_clock, milliseconds (1));
+}
+
+TEST_F (TestI2cInitSequence, ImagerBehindTheLink)
+{
+    // The imager doesn't acknowledge until the link is up.  The expected value is checked with a
+    // mask, so that a read which leaves the buffer unchanged can't be taken for a ready device.
+    m_device.setRespondsFrom (milliseconds (20));
+    m_device.setValueAt (0xa0a5, microseconds::zero(), 0x0b12);
+
+    EXPECT_TRUE (m_runner.run (m_device, { I2cInitStep::waitFor16 (0xa0a5, 0xff00, 0x0b00, milliseconds (500), "imager") }));
+    EXPECT_GE (m_clock, milliseconds (20));
+
+    // Once the backoff has reached its maximum delay, the link-up is detected within one step of it
+    EXPECT_LT (m_clock, milliseconds (20 + 16));
+}
+
+TEST_F (TestI2cInitSequence, ImagerDesignStep)
+{
+    // Waiting for any of the design steps, as CameraFactory does with the imager's list
+    m_device.setRespondsFrom (milliseconds (20));
+    m_device.setValueAt (0xa0a5, microseconds::zero(), 0x0b12);
+
+    EXPECT_TRUE (m_runner.run (m_device, { I2cInitStep::waitForAny16 (0xa0a5, { 0x0b11, 0x0b12 }, milliseconds (500), "imager") }));
+    EXPECT_GE (m_clock, milliseconds (20));
+    EXPECT_LT (m_clock, milliseconds (20 + 16));
+}
+
+TEST_F (TestI2cInitSequence, UnknownDesignStepTimesOut)
+{
+    m_device.setValueAt (0xa0a5, microseconds::zero(), 0x0b13);
+
+    EXPECT_FALSE (m_runner.run (m_device, { I2cInitStep::waitForAny16 (0xa0a5, { 0x0b11, 0x0b12 }, milliseconds (50), "imager") }));
+    EXPECT_EQ (milliseconds (50), m_clock);
+}
+
+TEST_F (TestI2cInitSequence, AnyOfDoesNotMatchUnchangedBuffer)
+{
+    // The complement of the first value is also in the list, the read buffer still has to be
+    // preset with a value that doesn't match
+    m_device.setRespondsFrom (milliseconds (5));
+    m_device.setValueAt (0x1000, microseconds::zero(), 0x00ff);
+
+    EXPECT_TRUE (m_runner.run (m_device, { I2cInitStep::waitForAny16 (0x1000, { 0xff00, 0x00ff }, milliseconds (50), "device") }));
+    EXPECT_GE (m_clock, milliseconds (5));
+}
+
+TEST_F (TestI2cInitSequence, UnresponsiveDeviceWithZeroExpected)
+{
+    // Waiting for zero must not succeed on a device which doesn't answer at all
+    m_device.setRespondsFrom (milliseconds (5));
+    m_device.setValueAt (0x01, microseconds::zero(), 0x00);
+
+    EXPECT_TRUE (m_runner.run (m_device, { I2cInitStep::waitFor8 (0x01, 0xff, 0x00, milliseconds (16), "reset") }));
+    EXPECT_GE (m_clock, milliseconds (5));
+}
+
+TEST_F (TestI2cInitSequence, TimeoutContinuesSequence)
+{
+    const I2cInitSequence sequence
+    {
+        I2cInitStep::waitFor8 (0x4D, 0x01, 0x01, milliseconds (50), "lock"),
+        I2cInitStep::write8 (0x02, 0x53),
+    };
+
+    EXPECT_FALSE (m_runner.run (m_device, sequence));
+
+    // The timeout is exactly the old fixed sleep, so the worst case doesn't get slower
+    EXPECT_EQ (milliseconds (50), m_clock);
+    ASSERT_EQ (1u, m_device.m_writes.size());
+    EXPECT_EQ (0x02, m_device.m_writes.front().first);
+    EXPECT_EQ (0x53, m_device.m_writes.front().second);
+}
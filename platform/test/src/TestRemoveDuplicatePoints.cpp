@@ -0,0 +1,188 @@
+/****************************************************************************\
+* Copyright (C) 2019 pmdtechnologies ag
+*
+* THIS CODE AND INFORMATION ARE PROVIDED "AS IS" WITHOUT WARRANTY OF ANY
+* KIND, EITHER EXPRESSED OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE
+* IMPLIED WARRANTIES OF MERCHANTABILITY AND/OR FITNESS FOR A
+* PARTICULAR PURPOSE.
+*
+\****************************************************************************/
+
+
+#include <gtest/gtest.h>
+
+#include <remove_duplicate_points.hpp>
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <iostream>
+#include <random>
+#include <vector>
+
+namespace
+{
+    struct Point
+    {
+        double x;
+        double y;
+
+        bool operator== (const Point &other) const
+        {
+            return x == other.x && y == other.y;
+        }
+    };
+
+    std::ostream &operator<< (std::ostream &os, const Point &point)
+    {
+        return os << "(" << point.x << ", " << point.y << ")";
+    }
+
+    /**
+    * The quadratic algorithm that pmd-tof-calibration used before RemoveDuplicatePoints, with
+    * cv::norm replaced by the same calculation.
+    */
+    void removeDuplicatesReference (std::vector<Point> &points, double distance)
+    {
+        size_t removed = 0;
+        for (size_t i = 0; i < points.size() - removed; ++i)
+        {
+            for (size_t j = i + 1; j < points.size() - removed; ++j)
+            {
+                const double x = points[i].x - points[j].x;
+                const double y = points[i].y - points[j].y;
+                if (std::sqrt (x * x + y * y) < distance)
+                {
+                    std::iter_swap (points.begin() + i, points.end() - removed - 1);
+                    removed += 1;
+                    --i;
+                    break;
+                }
+            }
+        }
+        points.erase (points.end() - removed, points.end());
+    }
+
+    /**
+    * Points in the area of the sensor, half of them in clusters around a few centers like the
+    * LDS detections, and some exact copies.
+    */
+    std::vector<Point> randomPoints (std::mt19937 &random, size_t count, double spread)
+    {
+        std::uniform_real_distribution<double> uniformX (0.0, 224.0);
+        std::uniform_real_distribution<double> uniformY (0.0, 172.0);
+        std::normal_distribution<double> noise (0.0, spread);
+        std::uniform_int_distribution<int> kind (0, 3);
+
+        std::vector<Point> centers;
+        for (int i = 0; i < 20; ++i)
+        {
+            centers.push_back ({ uniformX (random), uniformY (random) });
+        }
+
+        std::vector<Point> points;
+        points.reserve (count);
+        while (points.size() < count)
+        {
+            switch (kind (random))
+            {
+                case 0:
+                case 1:
+                    {
+                        const auto &center = centers[random() % centers.size()];
+                        points.push_back ({ center.x + noise (random), center.y + noise (random) });
+                        break;
+                    }
+                case 2:
+                    if (!points.empty())
+                    {
+                        points.push_back (points[random() % points.size()]);
+                        break;
+                    }
+                // fall through
+                default:
+                    points.push_back ({ uniformX (random), uniformY (random) });
+                    break;
+            }
+        }
+        return points;
+    }
+}
+
+TEST (TestRemoveDuplicatePoints, Simple)
+{
+    std::vector<Point> points = { { 0.0, 0.0 }, { 1.0, 1.0 }, { 0.05, 0.0 }, { 2.0, 2.0 }, { 1.0, 1.09 } };
+    RemoveDuplicatePoints (points, 0.1);
+    const std::vector<Point> expected = { { 2.0, 2.0 }, { 1.0, 1.0 }, { 0.05, 0.0 } };
+    EXPECT_EQ (expected, points);
+
+    // Points at exactly the distance are kept
+    points = { { 0.0, 0.0 }, { 0.5, 0.0 } };
+    RemoveDuplicatePoints (points, 0.5);
+    EXPECT_EQ (2u, points.size());
+
+    points.clear();
+    RemoveDuplicatePoints (points, 0.1);
+    EXPECT_TRUE (points.empty());
+}
+
+TEST (TestRemoveDuplicatePoints, NegativeCoordinates)
+{
+    // Neighbours across the cell boundaries at zero
+    std::vector<Point> points = { { -0.01, -0.01 }, { 0.01, 0.01 }, { -0.01, 0.01 }, { 0.01, -0.01 }, { -3.0, 0.0 } };
+    auto expected = points;
+    removeDuplicatesReference (expected, 0.1);
+    RemoveDuplicatePoints (points, 0.1);
+    EXPECT_EQ (expected, points);
+    EXPECT_EQ (2u, points.size());
+}
+
+TEST (TestRemoveDuplicatePoints, MatchesReference)
+{
+    std::mt19937 random (1u);
+    const size_t sizes[] = { 2u, 10u, 100u, 1000u, 3000u };
+    const double distances[] = { 0.1, 0.5, 3.0 };
+    for (const auto size : sizes)
+    {
+        for (const auto distance : distances)
+        {
+            auto points = randomPoints (random, size, distance);
+            auto expected = points;
+            removeDuplicatesReference (expected, distance);
+            RemoveDuplicatePoints (points, distance);
+            ASSERT_EQ (expected, points) << size << " points, distance " << distance;
+        }
+    }
+}
+
+/**
+ * Reports the time for different numbers of points.  The quadratic reference only runs for the
+ * smallest set.
+ */
+TEST (TestRemoveDuplicatePoints, DISABLED_Benchmark)
+{
+    using Clock = std::chrono::steady_clock;
+    std::mt19937 random (2u);
+    const size_t sizes[] = { 10000u, 100000u, 1000000u };
+    for (const auto size : sizes)
+    {
+        const auto points = randomPoints (random, size, 0.1);
+
+        auto grid = points;
+        auto start = Clock::now();
+        RemoveDuplicatePoints (grid, 0.1);
+        const auto gridTime = std::chrono::duration<double, std::milli> (Clock::now() - start).count();
+        std::cout << size << " points, " << grid.size() << " kept: grid " << gridTime << " ms";
+
+        if (size <= 10000u)
+        {
+            auto reference = points;
+            start = Clock::now();
+            removeDuplicatesReference (reference, 0.1);
+            const auto referenceTime = std::chrono::duration<double, std::milli> (Clock::now() - start).count();
+            std::cout << ", quadratic " << referenceTime << " ms";
+            EXPECT_EQ (reference, grid);
+        }
+        std::cout << std::endl;
+    }
+}
@@ -0,0 +1,256 @@
+/****************************************************************************\
+* Copyright (C) 2019 pmdtechnologies ag
+*
+* THIS CODE AND INFORMATION ARE PROVIDED "AS IS" WITHOUT WARRANTY OF ANY
+* KIND, EITHER EXPRESSED OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE
+* IMPLIED WARRANTIES OF MERCHANTABILITY AND/OR FITNESS FOR A
+* PARTICULAR PURPOSE.
+*
+\****************************************************************************/
+
+#include <gtest/gtest.h>
+
+#include <running_stat.hpp>
+#include <running_stat_planes.hpp>
+
+#include <chrono>
+#include <iostream>
+#include <random>
+#include <vector>
+
+namespace
+{
+    const size_t WIDTH = 224u;
+    const size_t HEIGHT = 172u;
+    const size_t NUM_PIXELS = WIDTH * HEIGHT;
+
+    /**
+    * Random frames around a per-pixel offset, similar to the z values of a flat wall, with
+    * roughly a quarter of the pixels invalid.
+    */
+    class FrameGenerator
+    {
+    public:
+        explicit FrameGenerator (unsigned seed) :
+            m_random (seed),
+            m_noise (0.0f, 0.005f),
+            m_values (NUM_PIXELS),
+            m_valid (NUM_PIXELS),
+            m_offset (NUM_PIXELS)
+        {
+            std::uniform_real_distribution<float> offset (0.2f, 0.4f);
+            for (auto &o : m_offset)
+            {
+                o = offset (m_random);
+            }
+        }
+
+        void next()
+        {
+            std::uniform_int_distribution<int> valid (0, 3);
+            for (size_t i = 0u; i < NUM_PIXELS; ++i)
+            {
+                m_values[i] = m_offset[i] + m_noise (m_random);
+                m_valid[i] = valid (m_random) != 0 ? 1u : 0u;
+            }
+        }
+
+        const float *values() const
+        {
+            return m_values.data();
+        }
+
+        const uint8_t *valid() const
+        {
+            return m_valid.data();
+        }
+
+    private:
+        std::mt19937 m_random;
+        std::normal_distribution<float> m_noise;
+        std::vector<float> m_values;
+        std::vector<uint8_t> m_valid;
+        std::vector<float> m_offset;
+    };
+
+    void expectNear (const RunningStatPlanes &a, const RunningStatPlanes &b)
+    {
+        ASSERT_EQ (a.Size(), b.Size());
+        for (size_t i = 0u; i < a.Size(); ++i)
+        {
+            ASSERT_EQ (a.NumDataValues (i), b.NumDataValues (i)) << "pixel " << i;
+            ASSERT_NEAR (a.Mean (i), b.Mean (i), 1e-6f) << "pixel " << i;
+            ASSERT_NEAR (a.StandardDeviation (i), b.StandardDeviation (i), 1e-6f) << "pixel " << i;
+            ASSERT_EQ (a.Min (i), b.Min (i)) << "pixel " << i;
+            ASSERT_EQ (a.Max (i), b.Max (i)) << "pixel " << i;
+        }
+    }
+}
+
+TEST (TestRunningStatPlanes, Empty)
+{
+    RunningStatPlanes stats (4u);
+    EXPECT_EQ (4u, stats.Size());
+    for (size_t i = 0u; i < stats.Size(); ++i)
+    {
+        EXPECT_EQ (0.0f, stats.NumDataValues (i));
+        EXPECT_EQ (0.0f, stats.Mean (i));
+        EXPECT_EQ (0.0f, stats.Variance (i));
+    }
+}
+
+TEST (TestRunningStatPlanes, SmallExample)
+{
+    RunningStatPlanes stats (2u);
+    const float frames[][2] = { { 2.0f, 1.0f }, { 4.0f, 100.0f }, { 4.0f, 1.0f }, { 4.0f, 1.0f },
+        { 5.0f, 1.0f }, { 5.0f, 1.0f }, { 7.0f, 1.0f }, { 9.0f, 1.0f }
+    };
+    const uint8_t valid[] = { 1u, 0u };
+    for (const auto &frame : frames)
+    {
+        stats.Push (frame, valid);
+    }
+
+    EXPECT_EQ (8.0f, stats.NumDataValues (0));
+    EXPECT_FLOAT_EQ (5.0f, stats.Mean (0));
+    EXPECT_FLOAT_EQ (32.0f / 7.0f, stats.Variance (0));
+    EXPECT_EQ (2.0f, stats.Min (0));
+    EXPECT_EQ (9.0f, stats.Max (0));
+
+    // The second pixel is never valid
+    EXPECT_EQ (0.0f, stats.NumDataValues (1));
+    EXPECT_EQ (0.0f, stats.Mean (1));
+    EXPECT_EQ (0.0f, stats.Variance (1));
+
+    stats.Clear();
+    EXPECT_EQ (0.0f, stats.NumDataValues (0));
+}
+
+TEST (TestRunningStatPlanes, MatchesRunningStat)
+{
+    const int numFrames = 200;
+    FrameGenerator generator (1u);
+    RunningStatPlanes planes (NUM_PIXELS);
+    RunningStatPlanes masked (NUM_PIXELS);
+    std::vector<RunningStat> reference (NUM_PIXELS);
+    std::vector<RunningStat> maskedReference (NUM_PIXELS);
+
+    for (int frame = 0; frame < numFrames; ++frame)
+    {
+        generator.next();
+        planes.Push (generator.values());
+        masked.Push (generator.values(), generator.valid());
+        for (size_t i = 0u; i < NUM_PIXELS; ++i)
+        {
+            reference[i].Push (generator.values() [i]);
+            if (generator.valid() [i])
+            {
+                maskedReference[i].Push (generator.values() [i]);
+            }
+        }
+    }
+
+    // RunningStat accumulates in float, so this can only be compared with a tolerance
+    for (size_t i = 0u; i < NUM_PIXELS; ++i)
+    {
+        ASSERT_EQ (reference[i].NumDataValues(), planes.NumDataValues (i));
+        ASSERT_NEAR (reference[i].Mean(), planes.Mean (i), 1e-5f);
+        ASSERT_NEAR (reference[i].StandardDeviation(), planes.StandardDeviation (i), 1e-5f);
+
+        ASSERT_EQ (maskedReference[i].NumDataValues(), masked.NumDataValues (i));
+        ASSERT_NEAR (maskedReference[i].Mean(), masked.Mean (i), 1e-5f);
+        ASSERT_NEAR (maskedReference[i].StandardDeviation(), masked.StandardDeviation (i), 1e-5f);
+    }
+}
+
+TEST (TestRunningStatPlanes, MergeMatchesSequential)
+{
+    FrameGenerator generator (2u);
+    RunningStatPlanes all (NUM_PIXELS);
+    RunningStatPlanes first (NUM_PIXELS);
+    RunningStatPlanes second (NUM_PIXELS);
+    RunningStatPlanes empty (NUM_PIXELS);
+
+    for (int frame = 0; frame < 50; ++frame)
+    {
+        generator.next();
+        all.Push (generator.values(), generator.valid());
+        (frame < 20 ? first : second).Push (generator.values(), generator.valid());
+    }
+
+    first.Merge (second);
+    expectNear (all, first);
+
+    // Merging into or from an empty object doesn't change the result
+    first.Merge (empty);
+    expectNear (all, first);
+    empty.Merge (all);
+    expectNear (all, empty);
+}
+
+TEST (TestRunningStatPlanes, ParallelMatchesSequential)
+{
+    FrameGenerator generator (3u);
+    RunningStatPlanes sequential (NUM_PIXELS);
+    RunningStatPlanes parallel (NUM_PIXELS);
+
+    for (int frame = 0; frame < 20; ++frame)
+    {
+        generator.next();
+        sequential.Push (generator.values(), generator.valid());
+        parallel.PushParallel (generator.values(), generator.valid(), WIDTH, 3u);
+    }
+
+    expectNear (sequential, parallel);
+}
+
+/**
+ * Compares the update rate of a std::vector<RunningStat> with RunningStatPlanes, for the
+ * masked updates that the calibration tools do.
+ */
+TEST (TestRunningStatPlanes, DISABLED_Benchmark)
+{
+    const int numFrames = 500;
+    FrameGenerator generator (4u);
+    generator.next();
+
+    using Clock = std::chrono::steady_clock;
+    const auto report = [numFrames] (const char *name, Clock::duration time)
+    {
+        const auto seconds = std::chrono::duration<double> (time).count();
+        std::cout << name << (seconds * 1e6 / numFrames) << " us per frame, "
+                  << (static_cast<double> (numFrames * NUM_PIXELS) / seconds / 1e6) << " M updates/s" << std::endl;
+    };
+
+    std::vector<RunningStat> reference (NUM_PIXELS);
+    auto start = Clock::now();
+    for (int frame = 0; frame < numFrames; ++frame)
+    {
+        for (size_t i = 0u; i < NUM_PIXELS; ++i)
+        {
+            if (generator.valid() [i])
+            {
+                reference[i].Push (generator.values() [i]);
+            }
+        }
+    }
+    report ("std::vector<RunningStat>:         ", Clock::now() - start);
+
+    RunningStatPlanes planes (NUM_PIXELS);
+    start = Clock::now();
+    for (int frame = 0; frame < numFrames; ++frame)
+    {
+        planes.Push (generator.values(), generator.valid());
+    }
+    report ("RunningStatPlanes:                ", Clock::now() - start);
+
+    RunningStatPlanes parallel (NUM_PIXELS);
+    start = Clock::now();
+    for (int frame = 0; frame < numFrames; ++frame)
+    {
+        parallel.PushParallel (generator.values(), generator.valid(), WIDTH, 4u);
+    }
+    report ("RunningStatPlanes, 4 threads:     ", Clock::now() - start);
+
+    EXPECT_NEAR (reference[0].Mean(), planes.Mean (0), 1e-5f);
+}
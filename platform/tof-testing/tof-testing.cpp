@@ -1,6 +1,8 @@
+#include <getopt.h>
 #include <unistd.h>
 
-#include <CameraFactory.hpp>
+#include <FrameSource.hpp>
+#include <TestReport.hpp>
 #include <chrono>
 #include <condition_variable>
 #include <iostream>
@@ -14,6 +16,7 @@
 
 #include "parameters.hpp"
 #include "running_stat.hpp"
+#include "running_stat_planes.hpp"
 
 // Image is 172 x 224 pixels
 #define NUM_IMAGE_ELEMENTS 38528
@@ -22,9 +25,14 @@
 namespace {
 std::vector<cv::Point3f> pt_cloud;
 std::vector<float> pt_amplitude;
-std::vector<RunningStat> confident_pixel;
-std::vector<RunningStat> v_pt_cloud_running_stats;
-std::vector<RunningStat> v_pt_amplitude_running_stats;
+RunningStatPlanes confident_pixel;
+RunningStatPlanes v_pt_cloud_running_stats;
+RunningStatPlanes v_pt_amplitude_running_stats;
+// One frame of each value as planes, filled by the listener and pushed to the running stats
+std::vector<float> frame_confidence;
+std::vector<float> frame_depth;
+std::vector<float> frame_amplitude;
+std::vector<uint8_t> frame_valid;
 std::mutex cloudMutex;
 std::condition_variable cloudCV;
 bool newDataAvailable;
@@ -53,6 +61,7 @@ enum CameraError {
 struct options_t {
   std::string version;
   royale::String test_mode;
+  std::string source;
 };
 
 // The plane fitting parameters
@@ -113,9 +122,12 @@ inline TestMetrics::TestMetrics()
 // Listener for new ToF frames
 class MyListener : public royale::IExtendedDataListener {
  public:
-  MyListener() {}
+  explicit MyListener(platform::FrameSource& source) : source_(source) {}
 
   void onNewData(const royale::IExtendedData* data) {
+    if (!source_.admitFrame()) {
+      return;
+    }
     std::unique_lock<std::mutex> lock(cloudMutex);
     pt_cloud.clear();
     pt_amplitude.clear();
@@ -123,18 +135,23 @@ class MyListener : public royale::IExtendedDataListener {
       auto depth = data->getDepthData();
       auto intermed = data->getIntermediateData();
       for (size_t i = 0u; i < NUM_IMAGE_ELEMENTS; ++i) {
-        confident_pixel[i].Push(depth->points[i].depthConfidence);
         pt_cloud.push_back(cv::Point3f(depth->points[i].x, depth->points[i].y, depth->points[i].z));
         pt_amplitude.push_back(intermed->points[i].amplitude);
-        if (depth->points[i].depthConfidence > 0) {
-          v_pt_cloud_running_stats[i].Push(depth->points[i].z);
-          v_pt_amplitude_running_stats[i].Push(intermed->points[i].amplitude);
-        }
+        frame_confidence[i] = depth->points[i].depthConfidence;
+        frame_depth[i] = depth->points[i].z;
+        frame_amplitude[i] = intermed->points[i].amplitude;
+        frame_valid[i] = depth->points[i].depthConfidence > 0 ? 1u : 0u;
       }
+      confident_pixel.Push(frame_confidence.data());
+      v_pt_cloud_running_stats.Push(frame_depth.data(), frame_valid.data());
+      v_pt_amplitude_running_stats.Push(frame_amplitude.data(), frame_valid.data());
     }
     newDataAvailable = true;
     cloudCV.notify_all();
   }
+
+ private:
+  platform::FrameSource& source_;
 };
 
 // Holds max and min exposure values
@@ -166,31 +183,47 @@ std::pair<int, int> getExposureMinMax(const royale::String& tof_mode) {
   }
 }
 
-// Find the value at the 90'th Quartile
-float calculate_Q90(const std::vector<float>& data_in) {
-  std::vector<float> data_in_copy = data_in;
-  std::nth_element(data_in_copy.begin(), data_in_copy.begin() + data_in_copy.size() / 10, data_in_copy.end(), std::greater<float>());
-  return data_in_copy[data_in_copy.size() / 10];
+void usage(const char* name) {
+  std::cout << "Usage: " << name << " [-s|--source live|<file.rrf>] [-h|--help]" << std::endl;
+  std::cout << "  -s, --source  Where the frames come from, the camera (default) or a recording. A" << std::endl;
+  std::cout << "                recording is replayed as fast as possible with its own settings." << std::endl;
 }
 
-// For testing if a value is inside a range
-bool inRange(std::pair<float, float> range_vals, float val) { return ((val - range_vals.second) * (val - range_vals.first) <= 0); }
-
 // Main Program Entry
 int main(int argc, char** argv) {
   // The test results reside in validation_test_metrics
   TestMetrics validation_test_metrics;
   // Default options
-  options_t options = {VERSION, "MODE_9_5FPS"};
+  options_t options = {VERSION, "MODE_9_5FPS", platform::FrameSource::LIVE};
+
+  const struct option long_options[] = {{"source", required_argument, nullptr, 's'}, {"help", no_argument, nullptr, 'h'}, {nullptr, 0, nullptr, 0}};
+  int opt;
+  while ((opt = getopt_long(argc, argv, "s:h", long_options, nullptr)) != -1) {
+    switch (opt) {
+      case 's':
+        options.source = optarg;
+        break;
+      case 'h':
+        usage(argv[0]);
+        return 0;
+      default:
+        usage(argv[0]);
+        return 1;
+    }
+  }
   //std::string ACCESS_CODE = "d79dab562f13ef8373e906d919aec323a2857388";
   std::string ACCESS_CODE = "c715e2ca31e816b1ef17ba487e2a5e9efc6bbd7b";  //Running.G Edit
 
   
   royale::String useCase;
   std::vector<PlaneParams> plane_coeffs;
-  v_pt_cloud_running_stats.resize(NUM_IMAGE_ELEMENTS);
-  v_pt_amplitude_running_stats.resize(NUM_IMAGE_ELEMENTS);
-  confident_pixel.resize(NUM_IMAGE_ELEMENTS);
+  v_pt_cloud_running_stats.Resize(NUM_IMAGE_ELEMENTS);
+  v_pt_amplitude_running_stats.Resize(NUM_IMAGE_ELEMENTS);
+  confident_pixel.Resize(NUM_IMAGE_ELEMENTS);
+  frame_confidence.resize(NUM_IMAGE_ELEMENTS);
+  frame_depth.resize(NUM_IMAGE_ELEMENTS);
+  frame_amplitude.resize(NUM_IMAGE_ELEMENTS);
+  frame_valid.resize(NUM_IMAGE_ELEMENTS);
 
   useCase = options.test_mode;
 
@@ -198,17 +231,18 @@ int main(int argc, char** argv) {
   pt_amplitude.reserve(NUM_IMAGE_ELEMENTS);
 
   // [Setup] Camera Initialization
+  // The source is declared after the listener, on every return it's destroyed first, which
+  // stops the capture before the listener goes away
   std::unique_ptr<MyListener> listener_;
   newDataAvailable = false;
-  std::unique_ptr<royale::ICameraDevice> camera_;  // The camera device
-  platform::CameraFactory factory;
-  camera_ = factory.createCamera();
+  std::unique_ptr<platform::FrameSource> source_ = platform::FrameSource::create(options.source);
 
   // Test if CameraDevice was created
-  if (camera_ == nullptr) {
+  if (source_ == nullptr) {
     std::cerr << "[ERROR] Camera device could not be created." << std::endl;
     return CAM_NOT_CREATED;
   }
+  royale::ICameraDevice* camera_ = &source_->device();  // The camera device
   // Initialize()
   royale::CameraStatus status = camera_->initialize();
   if (status != royale::CameraStatus::SUCCESS) {
@@ -216,9 +250,10 @@ int main(int argc, char** argv) {
     return CAM_NOT_INITIALIZED;
   }
 
+  // A recording is replayed with the use case it was recorded with
   royale::String current_use_case;
   camera_->getCurrentUseCase(current_use_case);
-  if (current_use_case != useCase) {
+  if (source_->isLive() && current_use_case != useCase) {
     royale::Vector<royale::String> useCaseList;
     status = camera_->getUseCases(useCaseList);
     if (status != royale::CameraStatus::SUCCESS || useCaseList.empty()) {
@@ -238,17 +273,19 @@ int main(int argc, char** argv) {
     }
   }
 
-  listener_.reset(new MyListener());
+  listener_.reset(new MyListener(*source_));
   status = camera_->registerDataListenerExtended(listener_.get());
   if (status != royale::CameraStatus::SUCCESS) {
     std::cerr << "[ERROR] Could not register the extended data listener" << royale::getStatusString(status).c_str() << std::endl;
     return LISTENER_MODE_ERROR;
   }
 
-  status = camera_->setExposureMode(royale::ExposureMode::AUTOMATIC);
-  if (status != royale::CameraStatus::SUCCESS) {
-    std::cerr << "[ERROR] Could not set exposure to automatic" << royale::getStatusString(status).c_str() << std::endl;
-    return EXPOSURE_MODE_ERROR;
+  if (source_->isLive()) {
+    status = camera_->setExposureMode(royale::ExposureMode::AUTOMATIC);
+    if (status != royale::CameraStatus::SUCCESS) {
+      std::cerr << "[ERROR] Could not set exposure to automatic" << royale::getStatusString(status).c_str() << std::endl;
+      return EXPOSURE_MODE_ERROR;
+    }
   }
 
   // Start Capture
@@ -258,71 +295,73 @@ int main(int argc, char** argv) {
     return CAPTURE_START_ERROR;
   }
   // capture for a few seconds
-  std::this_thread::sleep_for(std::chrono::seconds(5));
+  source_->settle(std::chrono::seconds(5));
 
-  // set ToF module processing parameters
-  if (camera_->setProcessingParameters({ToF_test_params::USE_ADAPTIVE_NOISE_FILTER}) != royale::CameraStatus::SUCCESS) {
-    std::cout << "[ERROR] Could not set USE_ADAPTIVE_NOISE_FILTER." << std::endl;
-    return PROCESSING_PARAMETER_ERROR;
-  }
-  if (camera_->setProcessingParameters({ToF_test_params::USE_FLYING_PIXEL}) != royale::CameraStatus::SUCCESS) {
-    std::cout << "[ERROR] Could not set USE_FLYING_PIXEL." << std::endl;
-    return PROCESSING_PARAMETER_ERROR;
-  }
-  if (camera_->setProcessingParameters({ToF_test_params::USE_MPI_AVERAGE}) != royale::CameraStatus::SUCCESS) {
-    std::cout << "[ERROR] Could not set USE_MPI_AVERAGE." << std::endl;
-    return PROCESSING_PARAMETER_ERROR;
-  }
-  if (camera_->setProcessingParameters({ToF_test_params::USE_MPI_AMP}) != royale::CameraStatus::SUCCESS) {
-    std::cout << "[ERROR] Could not set USE_MPI_AMP." << std::endl;
-    return PROCESSING_PARAMETER_ERROR;
-  }
-  if (camera_->setProcessingParameters({ToF_test_params::USE_MPI_DIST}) != royale::CameraStatus::SUCCESS) {
-    std::cout << "[ERROR] Could not set USE_MPI_DIST." << std::endl;
-    return PROCESSING_PARAMETER_ERROR;
-  }
-  if (camera_->setProcessingParameters({ToF_test_params::USE_VALIDATE_IMAGE}) != royale::CameraStatus::SUCCESS) {
-    std::cout << "[ERROR] Could not set USE_VALIDATE_IMAGE." << std::endl;
-    return PROCESSING_PARAMETER_ERROR;
-  }
-  if (camera_->setProcessingParameters({ToF_test_params::USE_STRAY_LIGHT}) != royale::CameraStatus::SUCCESS) {
-    std::cout << "[ERROR] Could not set USE_STRAY_LIGHT." << std::endl;
-    return PROCESSING_PARAMETER_ERROR;
-  }
-  if (camera_->setProcessingParameters({ToF_test_params::USE_FILTER_2_FREQ}) != royale::CameraStatus::SUCCESS) {
-    std::cout << "[ERROR] Could not set USE_FILTER_2_FREQ." << std::endl;
-    return PROCESSING_PARAMETER_ERROR;
-  }
-  if (camera_->setProcessingParameters({ToF_test_params::USE_SBI_FLAG}) != royale::CameraStatus::SUCCESS) {
-    std::cout << "[ERROR] Could not set USE_SBI_FLAG." << std::endl;
-    return PROCESSING_PARAMETER_ERROR;
-  }
-  if (camera_->setProcessingParameters({ToF_test_params::USE_SMOOTHING_FILTER}) != royale::CameraStatus::SUCCESS) {
-    std::cout << "[ERROR] Could not set USE_SMOOTHING_FILTER." << std::endl;
-    return PROCESSING_PARAMETER_ERROR;
-  }
-  if (camera_->setProcessingParameters({ToF_test_params::USE_HOLE_FILLING}) != royale::CameraStatus::SUCCESS) {
-    std::cout << "[ERROR] Could not set USE_HOLE_FILLING." << std::endl;
-    return PROCESSING_PARAMETER_ERROR;
-  }
-  if (camera_->setProcessingParameters({ToF_test_params::NOISE_THRESHOLD}) != royale::CameraStatus::SUCCESS) {
-    std::cout << "[ERROR] Could not set NOISE_THRESHOLD." << std::endl;
-    return PROCESSING_PARAMETER_ERROR;
-  }
-  if (camera_->setProcessingParameters({ToF_test_params::AUTO_EXPOSURE_REF_VALUE}) != royale::CameraStatus::SUCCESS) {
-    std::cout << "[ERROR] Could not set AUTO_EXPOSURE_REF_VALUE." << std::endl;
-    return PROCESSING_PARAMETER_ERROR;
-  }
-  if (camera_->setProcessingParameters({ToF_test_params::ADAPTIVE_NOISE_FILTER_TYPE}) != royale::CameraStatus::SUCCESS) {
-    std::cout << "[ERROR] Could not set ADAPTIVE_NOISE_FILTER_TYPE." << std::endl;
-    return PROCESSING_PARAMETER_ERROR;
-  }
-  if (camera_->setProcessingParameters({ToF_test_params::GLOBAL_BINNING}) != royale::CameraStatus::SUCCESS) {
-    std::cout << "[ERROR] Could not set GLOBAL_BINNING." << std::endl;
-    return PROCESSING_PARAMETER_ERROR;
+  // set ToF module processing parameters, a recording uses the recorded ones
+  if (source_->isLive()) {
+    if (camera_->setProcessingParameters({ToF_test_params::USE_ADAPTIVE_NOISE_FILTER}) != royale::CameraStatus::SUCCESS) {
+      std::cout << "[ERROR] Could not set USE_ADAPTIVE_NOISE_FILTER." << std::endl;
+      return PROCESSING_PARAMETER_ERROR;
+    }
+    if (camera_->setProcessingParameters({ToF_test_params::USE_FLYING_PIXEL}) != royale::CameraStatus::SUCCESS) {
+      std::cout << "[ERROR] Could not set USE_FLYING_PIXEL." << std::endl;
+      return PROCESSING_PARAMETER_ERROR;
+    }
+    if (camera_->setProcessingParameters({ToF_test_params::USE_MPI_AVERAGE}) != royale::CameraStatus::SUCCESS) {
+      std::cout << "[ERROR] Could not set USE_MPI_AVERAGE." << std::endl;
+      return PROCESSING_PARAMETER_ERROR;
+    }
+    if (camera_->setProcessingParameters({ToF_test_params::USE_MPI_AMP}) != royale::CameraStatus::SUCCESS) {
+      std::cout << "[ERROR] Could not set USE_MPI_AMP." << std::endl;
+      return PROCESSING_PARAMETER_ERROR;
+    }
+    if (camera_->setProcessingParameters({ToF_test_params::USE_MPI_DIST}) != royale::CameraStatus::SUCCESS) {
+      std::cout << "[ERROR] Could not set USE_MPI_DIST." << std::endl;
+      return PROCESSING_PARAMETER_ERROR;
+    }
+    if (camera_->setProcessingParameters({ToF_test_params::USE_VALIDATE_IMAGE}) != royale::CameraStatus::SUCCESS) {
+      std::cout << "[ERROR] Could not set USE_VALIDATE_IMAGE." << std::endl;
+      return PROCESSING_PARAMETER_ERROR;
+    }
+    if (camera_->setProcessingParameters({ToF_test_params::USE_STRAY_LIGHT}) != royale::CameraStatus::SUCCESS) {
+      std::cout << "[ERROR] Could not set USE_STRAY_LIGHT." << std::endl;
+      return PROCESSING_PARAMETER_ERROR;
+    }
+    if (camera_->setProcessingParameters({ToF_test_params::USE_FILTER_2_FREQ}) != royale::CameraStatus::SUCCESS) {
+      std::cout << "[ERROR] Could not set USE_FILTER_2_FREQ." << std::endl;
+      return PROCESSING_PARAMETER_ERROR;
+    }
+    if (camera_->setProcessingParameters({ToF_test_params::USE_SBI_FLAG}) != royale::CameraStatus::SUCCESS) {
+      std::cout << "[ERROR] Could not set USE_SBI_FLAG." << std::endl;
+      return PROCESSING_PARAMETER_ERROR;
+    }
+    if (camera_->setProcessingParameters({ToF_test_params::USE_SMOOTHING_FILTER}) != royale::CameraStatus::SUCCESS) {
+      std::cout << "[ERROR] Could not set USE_SMOOTHING_FILTER." << std::endl;
+      return PROCESSING_PARAMETER_ERROR;
+    }
+    if (camera_->setProcessingParameters({ToF_test_params::USE_HOLE_FILLING}) != royale::CameraStatus::SUCCESS) {
+      std::cout << "[ERROR] Could not set USE_HOLE_FILLING." << std::endl;
+      return PROCESSING_PARAMETER_ERROR;
+    }
+    if (camera_->setProcessingParameters({ToF_test_params::NOISE_THRESHOLD}) != royale::CameraStatus::SUCCESS) {
+      std::cout << "[ERROR] Could not set NOISE_THRESHOLD." << std::endl;
+      return PROCESSING_PARAMETER_ERROR;
+    }
+    if (camera_->setProcessingParameters({ToF_test_params::AUTO_EXPOSURE_REF_VALUE}) != royale::CameraStatus::SUCCESS) {
+      std::cout << "[ERROR] Could not set AUTO_EXPOSURE_REF_VALUE." << std::endl;
+      return PROCESSING_PARAMETER_ERROR;
+    }
+    if (camera_->setProcessingParameters({ToF_test_params::ADAPTIVE_NOISE_FILTER_TYPE}) != royale::CameraStatus::SUCCESS) {
+      std::cout << "[ERROR] Could not set ADAPTIVE_NOISE_FILTER_TYPE." << std::endl;
+      return PROCESSING_PARAMETER_ERROR;
+    }
+    if (camera_->setProcessingParameters({ToF_test_params::GLOBAL_BINNING}) != royale::CameraStatus::SUCCESS) {
+      std::cout << "[ERROR] Could not set GLOBAL_BINNING." << std::endl;
+      return PROCESSING_PARAMETER_ERROR;
+    }
   }
   // warm up camera
-  std::this_thread::sleep_for(std::chrono::seconds(1));
+  source_->settle(std::chrono::seconds(1));
 
   std::vector<cv::Mat> vec_pt_cloud;
   std::vector<cv::Mat> vec_pt_amplitude;
@@ -331,6 +370,7 @@ int main(int argc, char** argv) {
 
   while (num_frames_collected < test_sample_size) {
     std::unique_lock<std::mutex> lock(cloudMutex);
+    source_->requestFrame();
     auto timeOut = (std::chrono::system_clock::now() + std::chrono::milliseconds(1000));
     if (cloudCV.wait_until(lock, timeOut, [&] { return newDataAvailable; })) {
       cv::Mat A = cv::Mat(pt_cloud).reshape(1).t();
@@ -339,6 +379,9 @@ int main(int argc, char** argv) {
       vec_pt_amplitude.push_back(B);
       num_frames_collected++;
       newDataAvailable = false;
+    } else if (source_->isFinished()) {
+      std::cerr << "[ERROR] The recording ended after " << num_frames_collected << " of " << test_sample_size << " frames." << std::endl;
+      return RECEIVE_DATA_ERROR;
     }
   }
 
@@ -346,8 +389,8 @@ int main(int argc, char** argv) {
   RunningStat amplitude_uniformity_j;
 
   cv::Mat confidence_mask = cv::Mat::zeros(1, NUM_IMAGE_ELEMENTS, CV_8UC1);
-  for (int index = 0; index < (int)confident_pixel.size(); ++index) {
-    if (confident_pixel[index].Mean() >= ToF_test_params::kMinConfidenceThreshold) {
+  for (int index = 0; index < (int)confident_pixel.Size(); ++index) {
+    if (confident_pixel.Mean(index) >= ToF_test_params::kMinConfidenceThreshold) {
       confidence_mask.at<uchar>(index) = 1;
     } else {
       confidence_mask.at<uchar>(index) = 0;
@@ -497,57 +540,20 @@ int main(int argc, char** argv) {
   validation_test_metrics.avg_plane_residual /= static_cast<float>(test_sample_size);
   validation_test_metrics.kAmplitudeStd /= static_cast<float>(test_sample_size);
 
-  float std_dev = 0.0f;
-  float mean_val = 0.0f;
   // The min # frames a pixel must be valid for temporal stats.
   float sample_threshold_size = static_cast<float>(test_sample_size) / 2.0f;
-  // The number of pixels passing the sample_threshold_size
-  float pixel_count = 0.0f;
-  // Holds std(z)_i
-  std::vector<float> v_depth_precision_temporal_std;
-  // Holds (mean(z)_i - ground_truth) / ground_truth
-  std::vector<float> v_depth_accuracy_percent;
-  for (size_t pt_index = 0u; pt_index < NUM_IMAGE_ELEMENTS; ++pt_index) {
-    // only use pixels seen in this many "sample_threshold_size" frames
-    if (v_pt_cloud_running_stats[pt_index].NumDataValues() >= sample_threshold_size) {
-      // running stat for temporal depth precision
-      std_dev = v_pt_cloud_running_stats[pt_index].StandardDeviation();
-      v_depth_precision_temporal_std.push_back(std_dev);
-      validation_test_metrics.kDepthPrecisionTemporal += std_dev;
-
-      // depth accuracy and percent
-      validation_test_metrics.kDepthAccuracy += (v_pt_cloud_running_stats[pt_index].Mean() - ToF_test_params::kGroundTruthDistance);
-      v_depth_accuracy_percent.push_back((v_pt_cloud_running_stats[pt_index].Mean() - ToF_test_params::kGroundTruthDistance) / ToF_test_params::kGroundTruthDistance);
-
-      // amplitude temporal standard deviation
-      validation_test_metrics.kAmplitudeStdTemporal += v_pt_amplitude_running_stats[pt_index].StandardDeviation();
-
-      // amplitude mean
-      mean_val = v_pt_amplitude_running_stats[pt_index].Mean();
-      validation_test_metrics.kAmplitudeMean += mean_val;
-
-      // amplitude min
-      if (mean_val < validation_test_metrics.kAmplitudeMin) {
-        validation_test_metrics.kAmplitudeMin = mean_val;
-      }
-      // amplitude max
-      if (mean_val > validation_test_metrics.kAmplitudeMax) {
-        validation_test_metrics.kAmplitudeMax = mean_val;
-      }
-      pixel_count++;
-    }
-  }
-
-  // finalize avarages and statistics
-  validation_test_metrics.kDepthPrecisionTemporal /= pixel_count;
-  validation_test_metrics.kDepthAccuracy /= pixel_count;
-  validation_test_metrics.kAmplitudeStdTemporal /= pixel_count;
-  validation_test_metrics.kAmplitudeMean /= pixel_count;
-  validation_test_metrics.kDepthAccuracyPercent = 100.0f * (validation_test_metrics.kDepthAccuracy / ToF_test_params::kGroundTruthDistance);
+  const auto temporal = platform::TemporalDepthMetrics::compute(v_pt_cloud_running_stats, v_pt_amplitude_running_stats, sample_threshold_size,
+                                                                ToF_test_params::kGroundTruthDistance);
+  validation_test_metrics.kDepthPrecisionTemporal = temporal.depthPrecision;
+  validation_test_metrics.kDepthPrecisionTemporalQ90 = temporal.depthPrecisionQ90;
+  validation_test_metrics.kDepthAccuracy = temporal.depthAccuracy;
+  validation_test_metrics.kDepthAccuracyPercent = temporal.depthAccuracyPercent;
+  validation_test_metrics.kDepthAccuracyPercentQ90 = temporal.depthAccuracyPercentQ90;
+  validation_test_metrics.kAmplitudeStdTemporal = temporal.amplitudeStdDev;
+  validation_test_metrics.kAmplitudeMean = temporal.amplitudeMean;
+  validation_test_metrics.kAmplitudeMin = temporal.amplitudeMin;
+  validation_test_metrics.kAmplitudeMax = temporal.amplitudeMax;
   validation_test_metrics.kSingleShotDepthError = single_shot_depth_error_j.Mean();
-  // Q90
-  validation_test_metrics.kDepthPrecisionTemporalQ90 = calculate_Q90(v_depth_precision_temporal_std);
-  validation_test_metrics.kDepthAccuracyPercentQ90 = 100.0f * calculate_Q90(v_depth_accuracy_percent);
 
   // plane distance, rotation, equation, and residual parameters
   if (std::fabs(ave_dist_to_plane - ToF_test_params::kGroundTruthDistance) > ToF_testing_limits::kGroundTruthDistanceCheck) {
@@ -562,57 +568,24 @@ int main(int argc, char** argv) {
   std::cout << "[INFO]:Plane_Rotation_X:" << validation_test_metrics.plane_rot_x_axis << ":Y:" << validation_test_metrics.plane_rot_y_axis << std::endl;
 
   // test if test metrics are within limits
-  if (num_good_pixels >= ToF_testing_limits::kConfidentPixelCount) {
-    std::cout << "[PASS]:";
-  }
-  else {
-    std::cout << "[FAIL]:";
-  }
-  std::cout << "Valid_Pixel_Count:" << num_good_pixels << std::endl;
-
-  inRange(ToF_testing_limits::kDepthPrecisionSpatial, validation_test_metrics.kDepthPrecisionSpatial) ? std::cout << "[PASS]:" : std::cout << "[FAIL]:";
-  std::cout << "Spatial_Depth_Precision:" << validation_test_metrics.kDepthPrecisionSpatial << std::endl;
-
-  inRange(ToF_testing_limits::kDepthPrecisionTemporal, validation_test_metrics.kDepthPrecisionTemporal) ? std::cout << "[PASS]:" : std::cout << "[FAIL]:";
-  std::cout << "Temporal_Depth_Precision:" << validation_test_metrics.kDepthPrecisionTemporal << std::endl;
-
-  inRange(ToF_testing_limits::kDepthPrecisionTemporalQ90, validation_test_metrics.kDepthPrecisionTemporalQ90) ? std::cout << "[PASS]:" : std::cout << "[FAIL]:";
-  std::cout << "Temporal_Depth_Precision_Q90:" << validation_test_metrics.kDepthPrecisionTemporalQ90 << std::endl;
-
-  inRange(ToF_testing_limits::kSingleShotDepthError, validation_test_metrics.kSingleShotDepthError) ? std::cout << "[PASS]:" : std::cout << "[FAIL]:";
-  std::cout << "Single_Shot_Depth_Error:" << validation_test_metrics.kSingleShotDepthError << std::endl;
-
-  inRange(ToF_testing_limits::kDepthAccuracy, validation_test_metrics.kDepthAccuracy) ? std::cout << "[PASS]:" : std::cout << "[FAIL]:";
-  std::cout << "Depth_Accuracy:" << validation_test_metrics.kDepthAccuracy << std::endl;
-
-  inRange(ToF_testing_limits::kDepthAccuracyPercent, validation_test_metrics.kDepthAccuracyPercent) ? std::cout << "[PASS]:" : std::cout << "[FAIL]:";
-  std::cout << "Depth_Accuracy_Percent:" << validation_test_metrics.kDepthAccuracyPercent << std::endl;
-
-  inRange(ToF_testing_limits::kDepthAccuracyPercentQ90, validation_test_metrics.kDepthAccuracyPercentQ90) ? std::cout << "[PASS]:" : std::cout << "[FAIL]:";
-  std::cout << "Depth_Accuracy_Percent_Q90:" << validation_test_metrics.kDepthAccuracyPercentQ90 << std::endl;
-
-  inRange(ToF_testing_limits::kAmplitudeStd, validation_test_metrics.kAmplitudeStd) ? std::cout << "[PASS]:" : std::cout << "[FAIL]:";
-  std::cout << "Amplitude_Std_Dev:" << validation_test_metrics.kAmplitudeStd << std::endl;
-
-  inRange(ToF_testing_limits::kAmplitudeStdTemporal, validation_test_metrics.kAmplitudeStdTemporal) ? std::cout << "[PASS]:" : std::cout << "[FAIL]:";
-  std::cout << "Amplitude_Temporal_Std_Dev:" << validation_test_metrics.kAmplitudeStdTemporal << std::endl;
-
-  inRange(ToF_testing_limits::kAmplitudeMean, validation_test_metrics.kAmplitudeMean) ? std::cout << "[PASS]:" : std::cout << "[FAIL]:";
-  std::cout << "Amplitude_Mean:" << validation_test_metrics.kAmplitudeMean << std::endl;
-
-  inRange(ToF_testing_limits::kAmplitudeMax, validation_test_metrics.kAmplitudeMax) ? std::cout << "[PASS]:" : std::cout << "[FAIL]:";
-  std::cout << "Amplitude_Max:" << validation_test_metrics.kAmplitudeMax << std::endl;
-
-  inRange(ToF_testing_limits::kAmplitudeMin, validation_test_metrics.kAmplitudeMin) ? std::cout << "[PASS]:" : std::cout << "[FAIL]:";
-  std::cout << "Amplitude_Min:" << validation_test_metrics.kAmplitudeMin << std::endl;
-
-  inRange(ToF_testing_limits::kAmplitudeMaxMax, validation_test_metrics.kAmplitudeMaxMax) ? std::cout << "[PASS]:" : std::cout << "[FAIL]:";
-  std::cout << "Amplitude_Max_Of_Maxs:" << validation_test_metrics.kAmplitudeMaxMax << std::endl;
-
-  inRange(ToF_testing_limits::kAmplitudeMinMin, validation_test_metrics.kAmplitudeMinMin) ? std::cout << "[PASS]:" : std::cout << "[FAIL]:";
-  std::cout << "Amplitude_Min_Of_Mins:" << validation_test_metrics.kAmplitudeMinMin << std::endl;
-
-  if (camera_->stopCapture() != royale::CameraStatus::SUCCESS) {
+  platform::TestReport report(std::cout);
+  report.check("Valid_Pixel_Count", num_good_pixels, num_good_pixels >= ToF_testing_limits::kConfidentPixelCount);
+  report.check("Spatial_Depth_Precision", validation_test_metrics.kDepthPrecisionSpatial, ToF_testing_limits::kDepthPrecisionSpatial);
+  report.check("Temporal_Depth_Precision", validation_test_metrics.kDepthPrecisionTemporal, ToF_testing_limits::kDepthPrecisionTemporal);
+  report.check("Temporal_Depth_Precision_Q90", validation_test_metrics.kDepthPrecisionTemporalQ90, ToF_testing_limits::kDepthPrecisionTemporalQ90);
+  report.check("Single_Shot_Depth_Error", validation_test_metrics.kSingleShotDepthError, ToF_testing_limits::kSingleShotDepthError);
+  report.check("Depth_Accuracy", validation_test_metrics.kDepthAccuracy, ToF_testing_limits::kDepthAccuracy);
+  report.check("Depth_Accuracy_Percent", validation_test_metrics.kDepthAccuracyPercent, ToF_testing_limits::kDepthAccuracyPercent);
+  report.check("Depth_Accuracy_Percent_Q90", validation_test_metrics.kDepthAccuracyPercentQ90, ToF_testing_limits::kDepthAccuracyPercentQ90);
+  report.check("Amplitude_Std_Dev", validation_test_metrics.kAmplitudeStd, ToF_testing_limits::kAmplitudeStd);
+  report.check("Amplitude_Temporal_Std_Dev", validation_test_metrics.kAmplitudeStdTemporal, ToF_testing_limits::kAmplitudeStdTemporal);
+  report.check("Amplitude_Mean", validation_test_metrics.kAmplitudeMean, ToF_testing_limits::kAmplitudeMean);
+  report.check("Amplitude_Max", validation_test_metrics.kAmplitudeMax, ToF_testing_limits::kAmplitudeMax);
+  report.check("Amplitude_Min", validation_test_metrics.kAmplitudeMin, ToF_testing_limits::kAmplitudeMin);
+  report.check("Amplitude_Max_Of_Maxs", validation_test_metrics.kAmplitudeMaxMax, ToF_testing_limits::kAmplitudeMaxMax);
+  report.check("Amplitude_Min_Of_Mins", validation_test_metrics.kAmplitudeMinMin, ToF_testing_limits::kAmplitudeMinMin);
+
+  if (source_->stopCapture() != royale::CameraStatus::SUCCESS) {
     std::cout << "Error stopping camera" << std::endl;
   }
   return 0;
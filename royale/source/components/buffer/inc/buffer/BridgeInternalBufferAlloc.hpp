@@ -13,8 +13,10 @@
 #include <hal/IBridgeDataReceiver.hpp>
 #include <buffer/OffsetBasedCapturedBuffer.hpp>
 
+#include <common/EventForwarder.hpp>
 #include <common/exceptions/LogicError.hpp>
 
+#include <chrono>
 #include <condition_variable>
 #include <memory>
 #include <mutex>
@@ -49,7 +51,30 @@ namespace royale
              */
             ROYALE_API void setBufferCaptureListener (royale::hal::IBufferCaptureListener *listener) override;
 
+            /**
+             * Statistics about the times that the bridge had to wait for a buffer, because all of
+             * them were held by the IBufferCaptureListener (or the processing code).
+             */
+            struct StarvationStats
+            {
+                /** Number of times that a wait started, including one that hasn't ended yet */
+                std::size_t episodes;
+                /** Total time of the waits that have ended */
+                std::chrono::microseconds totalTime;
+                /** The longest wait that has ended */
+                std::chrono::microseconds longestTime;
+            };
+
+            ROYALE_API StarvationStats getStarvationStats();
+
         protected:
+            /**
+             * How long the subclasses' acquisition waits in dequeueInternalBuffer for a free
+             * buffer before calling reportStarvation().  A buffer that is released during the wait
+             * is used immediately.
+             */
+            static const std::chrono::milliseconds BUFFER_WAIT_TIMEOUT;
+
             /**
              * Expected to be called during the subclass' executeUseCase(), creates and queues all
              * buffers for capturing images.
@@ -98,6 +123,32 @@ namespace royale
              */
             ROYALE_API royale::buffer::OffsetBasedCapturedBuffer *dequeueInternalBuffer();
 
+            /**
+             * Version of dequeueInternalBuffer() that gives up after the timeout, returning nullptr.
+             * The wait is woken by queueBuffer, so the buffer is returned as soon as the
+             * IBufferCaptureListener releases one.
+             *
+             * While waitCaptureBufferDealloc() is changing the buffers, this waits for the new
+             * buffers instead of returning nullptr immediately, so callers that retry don't need
+             * to sleep between the calls.
+             */
+            ROYALE_API royale::buffer::OffsetBasedCapturedBuffer *dequeueInternalBuffer (std::chrono::microseconds timeout);
+
+            /**
+             * For a caller of dequeueInternalBuffer that didn't get a buffer, returns whether it
+             * should log or send an event about it.  This is true for the first time, and then at
+             * most once a second, so that a consumer that holds all the buffers doesn't cause an
+             * event for each retry.
+             */
+            ROYALE_API bool shouldReportStarvation();
+
+            /**
+             * For a caller of dequeueInternalBuffer that didn't get a buffer while capturing, logs
+             * the starvation and sends an EventCaptureStream warning, rate-limited by
+             * shouldReportStarvation().
+             */
+            ROYALE_API void reportStarvation (const royale::EventForwarder &eventForwarder);
+
             /**
              * If dequeueInternalBuffer is called and no buffers are available, this function will
              * be called.  If this returns false, then dequeueInternalBuffer will return nullptr.
@@ -163,6 +214,29 @@ namespace royale
              */
             void tryDeallocBuffersLocked();
 
+            /**
+             * Implementation of both versions of dequeueInternalBuffer, without a timeout if
+             * deadline is nullptr.
+             */
+            royale::buffer::OffsetBasedCapturedBuffer *dequeueInternalBufferLocked (std::unique_lock<std::mutex> &lock,
+                    const std::chrono::steady_clock::time_point *deadline);
+
+            /**
+             * Called with m_lock held, when the caller of dequeueInternalBuffer stops waiting.
+             */
+            void endStarvationLocked();
+
+            /**
+             * True while a caller of dequeueInternalBuffer is waiting for a buffer, from the time
+             * that it found no buffer available until it gets one or stops waiting.  A timeout
+             * doesn't end it, the caller is expected to try again.
+             */
+            bool m_starving;
+            std::chrono::steady_clock::time_point m_starvationStart;
+            StarvationStats m_starvationStats;
+            /** When shouldReportStarvation last returned true, zero if it never did */
+            std::chrono::steady_clock::time_point m_lastStarvationReport;
+
             /**
              * Must be held when accessing m_captureListener.
              */
@@ -16,6 +16,7 @@
 #include <common/exceptions/LogicError.hpp>
 
 #include <algorithm>
+#include <chrono>
 
 using namespace royale::common;
 using namespace royale::buffer;
@@ -83,9 +84,16 @@ void BridgeCopyAndNormalize::bridgeAcquisitionCallback (
         return;
     }
 
-    auto frame = dequeueInternalBuffer();
+    auto frame = dequeueInternalBuffer (BUFFER_WAIT_TIMEOUT);
     if (!frame)
     {
+        // Either stopCapture() has been called, or the IBufferCaptureListener is holding all of
+        // the buffers.  In the second case this frame is dropped, rather than blocking the
+        // thread that delivers the frames until a buffer is released.
+        if (m_captureStarted)
+        {
+            reportStarvation (m_eventForwarder);
+        }
         return;
     }
 
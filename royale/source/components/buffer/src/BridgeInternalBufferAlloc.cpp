@@ -14,7 +14,9 @@
 #include <buffer/SimpleCapturedBuffer.hpp>
 
 #include <common/MakeUnique.hpp>
+#include <common/events/EventCaptureStream.hpp>
 
+#include <algorithm>
 #include <chrono>
 #include <cstring>
 #include <iterator>
@@ -24,12 +26,26 @@
 using namespace royale::common;
 using namespace royale::buffer;
 
+namespace
+{
+    /**
+     * Minimum time between two reports of buffer starvation, see shouldReportStarvation().
+     */
+    const auto STARVATION_REPORT_INTERVAL = std::chrono::seconds (1);
+}
+
+const std::chrono::milliseconds BridgeInternalBufferAlloc::BUFFER_WAIT_TIMEOUT = std::chrono::milliseconds (100);
+
 BridgeInternalBufferAlloc::BridgeInternalBufferAlloc () :
     m_currentBuffers(),
     m_queuedBuffers(),
     m_bufferChangeInProgress (false),
     m_lock(),
     m_sleepCV(),
+    m_starving (false),
+    m_starvationStart(),
+    m_starvationStats {0, std::chrono::microseconds::zero(), std::chrono::microseconds::zero()},
+    m_lastStarvationReport(),
     m_captureListener (nullptr)
 {
 }
@@ -128,32 +144,113 @@ void BridgeInternalBufferAlloc::queueBufferLocked (OffsetBasedCapturedBuffer *bu
 OffsetBasedCapturedBuffer *BridgeInternalBufferAlloc::dequeueInternalBuffer()
 {
     std::unique_lock<std::mutex> lock (m_lock);
-    auto blockWhile = [this]
+    return dequeueInternalBufferLocked (lock, nullptr);
+}
+
+OffsetBasedCapturedBuffer *BridgeInternalBufferAlloc::dequeueInternalBuffer (std::chrono::microseconds timeout)
+{
+    const auto deadline = std::chrono::steady_clock::now() + timeout;
+    std::unique_lock<std::mutex> lock (m_lock);
+    return dequeueInternalBufferLocked (lock, &deadline);
+}
+
+OffsetBasedCapturedBuffer *BridgeInternalBufferAlloc::dequeueInternalBufferLocked (std::unique_lock<std::mutex> &lock,
+        const std::chrono::steady_clock::time_point *deadline)
+{
+    bool stopWaiting = false;
+    auto blockWhile = [this, deadline, &stopWaiting]
     {
-        if (! m_queuedBuffers.empty())
+        if (! m_queuedBuffers.empty() && ! m_bufferChangeInProgress)
         {
             // there's a buffer available
             return true;
         }
-        if (m_bufferChangeInProgress)
+        if (m_bufferChangeInProgress && ! deadline)
         {
             // return nullptr
             return true;
         }
-        return !shouldBlockForDequeue();
+        if (! shouldBlockForDequeue())
+        {
+            stopWaiting = true;
+            return true;
+        }
+        if (! m_starving && ! m_bufferChangeInProgress)
+        {
+            m_starving = true;
+            m_starvationStart = std::chrono::steady_clock::now();
+            m_starvationStats.episodes++;
+        }
+        return false;
     };
-    m_sleepCV.wait (lock, blockWhile);
+    if (deadline)
+    {
+        m_sleepCV.wait_until (lock, *deadline, blockWhile);
+    }
+    else
+    {
+        m_sleepCV.wait (lock, blockWhile);
+    }
 
     if (m_queuedBuffers.empty() || m_bufferChangeInProgress)
     {
+        if (stopWaiting)
+        {
+            endStarvationLocked();
+        }
         return nullptr;
     }
 
+    endStarvationLocked();
     OffsetBasedCapturedBuffer *pHandle = m_queuedBuffers.back();
     m_queuedBuffers.pop_back();
     return pHandle;
 }
 
+void BridgeInternalBufferAlloc::endStarvationLocked()
+{
+    if (! m_starving)
+    {
+        return;
+    }
+    m_starving = false;
+
+    const auto duration = std::chrono::duration_cast<std::chrono::microseconds> (std::chrono::steady_clock::now() - m_starvationStart);
+    m_starvationStats.totalTime += duration;
+    m_starvationStats.longestTime = std::max (m_starvationStats.longestTime, duration);
+}
+
+bool BridgeInternalBufferAlloc::shouldReportStarvation()
+{
+    std::lock_guard<std::mutex> lock (m_lock);
+    const auto now = std::chrono::steady_clock::now();
+    if (m_lastStarvationReport != std::chrono::steady_clock::time_point() &&
+            now - m_lastStarvationReport < STARVATION_REPORT_INTERVAL)
+    {
+        return false;
+    }
+    m_lastStarvationReport = now;
+    return true;
+}
+
+void BridgeInternalBufferAlloc::reportStarvation (const royale::EventForwarder &eventForwarder)
+{
+    if (! shouldReportStarvation())
+    {
+        return;
+    }
+    const auto stats = getStarvationStats();
+    LOG (ERROR) << "No free buffers from BridgeInternalBufferAlloc, waited for buffers "
+                << stats.episodes << " times";
+    eventForwarder.event<royale::event::EventCaptureStream> (royale::EventSeverity::ROYALE_WARNING, "No free buffers from BridgeInternalBufferAlloc");
+}
+
+BridgeInternalBufferAlloc::StarvationStats BridgeInternalBufferAlloc::getStarvationStats()
+{
+    std::lock_guard<std::mutex> lock (m_lock);
+    return m_starvationStats;
+}
+
 bool BridgeInternalBufferAlloc::shouldBlockForDequeue()
 {
     return false;
@@ -20,7 +20,10 @@
 #include <RoyaleLogger.hpp>
 
 #include <algorithm>
+#include <atomic>
+#include <chrono>
 #include <memory>
+#include <thread>
 
 using namespace royale::buffer;
 using namespace royale::common;
@@ -81,6 +84,30 @@ namespace
             return BridgeInternalBufferAlloc::dequeueInternalBuffer();
         }
 
+        /**
+         * Make the timed dequeueInternalBuffer public
+         */
+        OffsetBasedCapturedBuffer *dequeueInternalBuffer (std::chrono::microseconds timeout)
+        {
+            return BridgeInternalBufferAlloc::dequeueInternalBuffer (timeout);
+        }
+
+        /**
+         * Make shouldReportStarvation public
+         */
+        bool shouldReportStarvation()
+        {
+            return BridgeInternalBufferAlloc::shouldReportStarvation();
+        }
+
+        /**
+         * Make reportStarvation public
+         */
+        void reportStarvation (const royale::EventForwarder &eventForwarder)
+        {
+            BridgeInternalBufferAlloc::reportStarvation (eventForwarder);
+        }
+
         /**
          * Make queueBuffer public
          */
@@ -92,7 +119,15 @@ namespace
         bool shouldBlockForDequeue() override
         {
             m_queryShouldBlock++;
-            return false;
+            return m_shouldBlock;
+        }
+
+        /**
+         * Sets the value that shouldBlockForDequeue() returns, the default is false.
+         */
+        void setShouldBlock (bool block)
+        {
+            m_shouldBlock = block;
         }
 
         /**
@@ -105,6 +140,22 @@ namespace
 
     private:
         std::atomic<unsigned int> m_queryShouldBlock {0};
+        std::atomic<bool> m_shouldBlock {false};
+    };
+
+    /**
+     * Counts the events that the bridge sends.
+     */
+    class CountingEventListener : public royale::IEventListener
+    {
+    public:
+        void onEvent (std::unique_ptr<royale::IEvent> &&event) override
+        {
+            (void) event;
+            m_count++;
+        }
+
+        std::atomic<unsigned int> m_count {0};
     };
 }
 
@@ -170,3 +221,99 @@ TEST_F (TestBridgeInternalBufferAlloc, CheckBufferAllocation)
     ASSERT_NE (nullptr, m_buffers.back());
     ASSERT_EQ (counter, m_bridge->getShouldBlockCounter());
 }
+
+/**
+ * A consumer that holds all the buffers releases one while the bridge is waiting, the bridge must
+ * be woken by the release, not only after the timeout.
+ */
+TEST_F (TestBridgeInternalBufferAlloc, TimedDequeueWakesOnQueue)
+{
+    const std::size_t BUFFER_COUNT = 2;
+    ASSERT_NO_THROW (m_bridge->executeUseCase (100, 5, BUFFER_COUNT));
+    for (std::size_t i = 0; i < BUFFER_COUNT; i++)
+    {
+        m_buffers.push_back (m_bridge->dequeueInternalBuffer());
+        ASSERT_NE (nullptr, m_buffers.back());
+    }
+    m_bridge->setShouldBlock (true);
+
+    // The consumer releases a buffer as soon as the bridge has started waiting
+    auto released = m_buffers.back();
+    m_buffers.pop_back();
+    std::atomic<bool> isReleased {false};
+    std::thread consumer ([&]
+    {
+        while (m_bridge->getShouldBlockCounter() == 0)
+        {
+            std::this_thread::yield();
+        }
+        isReleased = true;
+        m_bridge->queueBuffer (released);
+    });
+
+    auto buffer = m_bridge->dequeueInternalBuffer (std::chrono::seconds (10));
+    const bool wasReleased = isReleased;
+    consumer.join();
+    m_buffers.push_back (buffer);
+
+    // The bridge got the released buffer, and only after it was released
+    ASSERT_EQ (released, buffer);
+    ASSERT_TRUE (wasReleased);
+
+    const auto stats = m_bridge->getStarvationStats();
+    EXPECT_EQ (1u, stats.episodes);
+    EXPECT_LE (stats.longestTime.count(), stats.totalTime.count());
+}
+
+/**
+ * A timeout doesn't end the starvation episode, retrying is still the same episode.
+ */
+TEST_F (TestBridgeInternalBufferAlloc, TimedDequeueTimesOut)
+{
+    const std::size_t BUFFER_COUNT = 2;
+    const auto timeout = std::chrono::milliseconds (20);
+    ASSERT_NO_THROW (m_bridge->executeUseCase (100, 5, BUFFER_COUNT));
+    for (std::size_t i = 0; i < BUFFER_COUNT; i++)
+    {
+        m_buffers.push_back (m_bridge->dequeueInternalBuffer());
+        ASSERT_NE (nullptr, m_buffers.back());
+    }
+    m_bridge->setShouldBlock (true);
+
+    ASSERT_EQ (nullptr, m_bridge->dequeueInternalBuffer (timeout));
+    ASSERT_EQ (nullptr, m_bridge->dequeueInternalBuffer (timeout));
+    EXPECT_EQ (1u, m_bridge->getStarvationStats().episodes);
+    EXPECT_EQ (0, m_bridge->getStarvationStats().totalTime.count());
+
+    requeueABuffer();
+    m_buffers.push_back (m_bridge->dequeueInternalBuffer (timeout));
+    ASSERT_NE (nullptr, m_buffers.back());
+
+    const auto stats = m_bridge->getStarvationStats();
+    EXPECT_EQ (1u, stats.episodes);
+    EXPECT_GE (stats.totalTime.count(), std::chrono::microseconds (2 * timeout).count());
+    EXPECT_EQ (stats.longestTime.count(), stats.totalTime.count());
+
+    // Stopping (shouldBlockForDequeue returning false) returns immediately, and ends the episode
+    m_bridge->setShouldBlock (false);
+    ASSERT_EQ (nullptr, m_bridge->dequeueInternalBuffer (std::chrono::seconds (10)));
+    EXPECT_EQ (1u, m_bridge->getStarvationStats().episodes);
+}
+
+TEST_F (TestBridgeInternalBufferAlloc, StarvationReportIsRateLimited)
+{
+    EXPECT_TRUE (m_bridge->shouldReportStarvation());
+    EXPECT_FALSE (m_bridge->shouldReportStarvation());
+    EXPECT_FALSE (m_bridge->shouldReportStarvation());
+}
+
+TEST_F (TestBridgeInternalBufferAlloc, StarvationEventIsRateLimited)
+{
+    CountingEventListener listener;
+    royale::EventForwarder eventForwarder;
+    eventForwarder.setEventListener (&listener);
+
+    m_bridge->reportStarvation (eventForwarder);
+    m_bridge->reportStarvation (eventForwarder);
+    EXPECT_EQ (1u, listener.m_count);
+}
@@ -12,8 +12,12 @@
 
 #include <imager/ImagerMeasurementBlockBase.hpp>
 #include <imager/ImagerParameters.hpp>
+#include <imager/ImagerUseCaseCache.hpp>
 #include <imager/IPllStrategy.hpp>
 
+#include <memory>
+#include <string>
+
 namespace royale
 {
     namespace imager
@@ -57,6 +61,25 @@ namespace royale
             uint16_t stopCapture() override;
             void setExternalTrigger (bool useExternalTrigger) override;
 
+            /**
+            * The result of prepareUseCase is cached, so that executeUseCase can switch back to a
+            * previously executed use case without recalculating its register configuration.  The
+            * cache is enabled by default, disabling it also clears it.
+            */
+            void setUseCaseCacheEnabled (bool enabled);
+
+            /**
+            * Fills the use case cache from a file written by saveUseCaseCache.  Files written for a
+            * different imager type or module configuration are ignored.
+            * \return true if the file was loaded
+            */
+            bool loadUseCaseCache (const std::string &filename);
+
+            /**
+            * \return false if the file couldn't be written
+            */
+            bool saveUseCaseCache (const std::string &filename);
+
         protected:
             const static std::string MSG_CFGCONFLICT;
             const static std::string MSG_USECASEEXECUTION;
@@ -198,6 +221,47 @@ namespace royale
             */
             virtual std::map < uint16_t, uint16_t > prepareUseCase (const ImagerUseCaseDefinition &useCase) = 0;
 
+            /**
+            * Called by executeUseCase before prepareUseCase, for the parts of preparing a use case
+            * that must happen on every switch (for example invalidating tracked registers when the
+            * firmware mode changes), and which therefore can't be replaced by a cached result.
+            * After this call, the result of prepareUseCase must only depend on the use case, the
+            * LUT assignment, m_regPllLutLower and the SSC setting of the executing use case.
+            *
+            * The default implementation does nothing.
+            */
+            virtual void prepareImagerMode (const ImagerUseCaseDefinition &useCase);
+
+            /**
+            * Returns the result of prepareUseCase, either from the use case cache or by calling it
+            * and adding the result to the cache.  Either way m_mbList and m_lutAssignment are left
+            * in the state that prepareUseCase would leave them.
+            */
+            std::map < uint16_t, uint16_t > prepareUseCaseCached (const ImagerUseCaseDefinition &useCase);
+
+            /**
+            * Identifies the imager type and the parts of the module configuration that
+            * prepareUseCase depends on, so that saved caches are only reused with the same setup.
+            */
+            virtual std::string getUseCaseCacheFingerprint() const;
+
+            /**
+            * Returns m_useCaseCache, creating it if necessary.  Only call while caching is enabled.
+            */
+            ImagerUseCaseCache &getUseCaseCache();
+
+            /**
+            * Created on first use (the fingerprint uses the dynamic type, which isn't available
+            * during construction), nullptr while caching is disabled.
+            */
+            std::unique_ptr<ImagerUseCaseCache> m_useCaseCache;
+            bool m_useCaseCacheEnabled;
+
+            /**
+            * Returns the trigger, status and reconfiguration counter registers.
+            */
+            std::vector < uint16_t > getSideEffectRegisters() const override;
+
             /**
             *  rowLimit ROI column upper limit defines the number of accessible rows the imager sensor array
             */
@@ -12,6 +12,7 @@
 
 #include <imager/IImagerComponent.hpp>
 #include <hal/IBridgeImager.hpp>
+#include <hal/IBridgeImagerTransactionCost.hpp>
 
 #include <map>
 
@@ -83,6 +84,17 @@ namespace royale
             * of the settings on the imager hardware. The address/value pairs
             * are stored only if the hardware register write call succeeded.
             *
+            * Registers with consecutive addresses are combined in to a single burst. If two
+            * bursts are only separated by a short gap of registers whose values are already
+            * known (tracked in m_regDownloaded), and writing those values again is cheaper than
+            * starting a new transaction on the bridge, then the gap is filled with the known
+            * values and a single burst is written. Registers returned by getSideEffectRegisters()
+            * are never used to fill a gap.
+            *
+            * Gaps are only filled if the bridge implements IBridgeImagerTransactionCost and the
+            * imager lists its side-effect registers, otherwise exactly the given registers are
+            * written.
+            *
             * The caller must handle thread safety of the tracked register cache.
             *
             * \param  registers       The register address/value pairs.
@@ -142,6 +154,18 @@ namespace royale
 
             virtual std::vector < uint16_t > getSerialRegisters() = 0;
 
+            /**
+            * Registers where a write has an effect beyond storing the value (for example triggers,
+            * status registers which are cleared on write, or counters that start a
+            * reconfiguration). trackAndWriteRegisters will only write these registers if they are
+            * explicitly part of the requested change, they are never rewritten to fill a gap
+            * between two bursts.
+            *
+            * An empty list means that the side effects of this imager's registers are not known,
+            * and disables filling gaps. The default implementation returns an empty list.
+            */
+            virtual std::vector < uint16_t > getSideEffectRegisters() const;
+
             std::shared_ptr<royale::hal::IBridgeImager> m_bridge;
             /**
              * Registers which have been successfully set on the hardware.
@@ -159,6 +183,12 @@ namespace royale
             static uint32_t s_imagerIdCounter;
             uint32_t m_imagerMyId;
 
+            /**
+            * The cost model of the bridge, used by trackAndWriteRegisters for deciding whether to
+            * fill gaps between bursts.
+            */
+            royale::hal::BridgeImagerTransactionCost m_transactionCost;
+
             /**
             *  Helper for emitting a specialized message for register operations
             */
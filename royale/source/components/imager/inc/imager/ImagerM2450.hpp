@@ -119,6 +119,8 @@ namespace royale
 
             bool isFirstFrame (const std::vector<ImagerRawFrame> &rfList, size_t index) const override;
 
+            std::vector < uint16_t > getSideEffectRegisters() const override;
+
         private:
             /**
             * Contains the mapping phase-angle to register value for each supported dutycycle.
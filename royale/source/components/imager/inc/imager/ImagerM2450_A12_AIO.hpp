@@ -52,6 +52,7 @@ namespace royale
         protected:
             std::vector < uint16_t > getSerialRegisters() override;
             ImagerVerificationStatus verifyRegion (const ImagerUseCaseDefinition &useCase) override;
+            void prepareImagerMode (const ImagerUseCaseDefinition &useCase) override;
             std::map < uint16_t, uint16_t > prepareUseCase (const ImagerUseCaseDefinition &useCase) override;
             void getReadoutDelays (double &ifdel, double &lblank, double &cycAdcSocd, double &cycAdcOddd) const override;
             ImagerVerificationStatus verifySSCSettings (const ImagerUseCaseDefinition &useCase) final;
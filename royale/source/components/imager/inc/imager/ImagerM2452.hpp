@@ -108,6 +108,8 @@ namespace royale
 
             bool isFirstFrame (const std::vector<ImagerRawFrame> &rfList, size_t index) const override;
 
+            std::vector < uint16_t > getSideEffectRegisters() const override;
+
             const static std::string MSG_STARTLPFSMIDLE;
             const static std::string MSG_DPHYPLLLOCK;
             const static std::string MSG_MODPLLLOCK;
@@ -10,6 +10,7 @@
 
 #pragma once
 
+#include <imager/FlashDefinedImagerComponent.hpp>
 #include <imager/ImagerM2452.hpp>
 
 namespace royale
@@ -29,6 +30,12 @@ namespace royale
             IMAGER_EXPORT explicit ImagerM2452_B1x_AIO (const ImagerParameters &params);
             ~ImagerM2452_B1x_AIO();
 
+            /**
+            * The design steps that are supported.  The register can be read as soon as the imager
+            * has left reset, so this is also used to wait for the imager during a bring-up.
+            */
+            IMAGER_EXPORT static DesignStepInfo getDesignStepInfo();
+
             std::unique_ptr<common::IPseudoDataInterpreter> createPseudoDataInterpreter() override;
 
             void initialize() override;
@@ -48,6 +55,7 @@ namespace royale
             ImagerVerificationStatus verifyFrameRateSettings (const ImagerUseCaseDefinition &useCase,
                     bool rawFrameBasedFrameRate) override;
             ImagerVerificationStatus verifySSCSettings (const ImagerUseCaseDefinition &useCase) final;
+            void prepareImagerMode (const ImagerUseCaseDefinition &useCase) override;
             std::map < uint16_t, uint16_t > prepareUseCase (const ImagerUseCaseDefinition &useCase) override;
             void prepareSSCSettings (const uint16_t lutIndex,
                                      const std::vector<uint16_t> &pllCfg,
@@ -67,13 +67,15 @@ namespace royale
 
             /**
             * This will unconditionally sleep for firstSleep, and then in a loop read register reg,
-            * if it's not equal to expectedVal it will sleep for pollSleep and then retry (repeatedly).
+            * if it's not equal to expectedVal it will sleep and then retry (repeatedly).  The sleeps
+            * between the polls start shorter than pollSleep and double until they reach it, so that
+            * a register which changes soon after firstSleep is noticed quickly.
             *
             * \param   reg           The register address of the register which's value should be polled for
             * \param   expectedVal   The register value which is expected to end the polling
             * \param   firstSleep    Time to sleep before the polling is started
-            * \param   pollSleep     Time to sleep between every poll
-            * \throw Timeout after a number of retries (the number is defined in the function)
+            * \param   pollSleep     Maximum time to sleep between two polls
+            * \throw Timeout after sleeping for a multiple of pollSleep (the factor is defined in the function)
             */
             IMAGER_EXPORT void pollUntil (uint16_t reg,
                                           const uint16_t expectedVal,
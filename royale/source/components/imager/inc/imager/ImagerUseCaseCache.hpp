@@ -0,0 +1,95 @@
+/****************************************************************************\
+* Copyright (C) 2019 pmdtechnologies ag
+*
+* THIS CODE AND INFORMATION ARE PROVIDED "AS IS" WITHOUT WARRANTY OF ANY
+* KIND, EITHER EXPRESSED OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE
+* IMPLIED WARRANTIES OF MERCHANTABILITY AND/OR FITNESS FOR A
+* PARTICULAR PURPOSE.
+*
+\****************************************************************************/
+
+#pragma once
+
+#include <imager/ImagerUseCaseDefinition.hpp>
+#include <imager/MeasurementBlock.hpp>
+
+#include <cstdint>
+#include <map>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace royale
+{
+    namespace imager
+    {
+        /**
+        * Stores the outcome of Imager::prepareUseCase, so that switching back to a use case which
+        * has already been executed doesn't need to recalculate the sequencer entries, PLL settings,
+        * LUT assignment, exposure and ROI registers.
+        *
+        * The key is an exact byte representation of everything prepareUseCase depends on (the
+        * complete use case definition plus the imager's state before the call), the cache itself
+        * doesn't know how to build it. The cache can optionally be saved to and restored from a
+        * file; the fingerprint identifies the imager type and module configuration that the cached
+        * entries are valid for, and a file with a different fingerprint is not loaded.
+        */
+        class ImagerUseCaseCache
+        {
+        public:
+            /**
+            * The result of preparing a use case, and the imager state after doing so.
+            */
+            struct Entry
+            {
+                std::map < uint16_t, uint16_t > registers;
+                std::vector<MeasurementBlock> mbList;
+                std::map < uint32_t, uint16_t > lutAssignment;
+            };
+
+            /**
+            * \param fingerprint  identifies the imager and module configuration, see the class documentation
+            * \param maxEntries   if the cache grows beyond this size it is cleared
+            */
+            explicit ImagerUseCaseCache (const std::string &fingerprint, std::size_t maxEntries = 64u);
+
+            /**
+            * Returns the entry for the key, or nullptr if there is none.  The pointer is
+            * invalidated by the next call to insert(), clear() or load().
+            */
+            const Entry *find (const std::string &key) const;
+            void insert (const std::string &key, Entry entry);
+            void clear();
+            std::size_t size() const;
+
+            /**
+            * Writes all entries to the file.
+            * \return false if the file couldn't be written
+            */
+            bool save (const std::string &filename) const;
+
+            /**
+            * Replaces the current entries with the ones read from the file.  If the file doesn't
+            * exist, can't be parsed or was saved with a different fingerprint, the cache is left
+            * unchanged.
+            * \return true if the entries were loaded
+            */
+            bool load (const std::string &filename);
+
+            /**
+            * Helpers for building keys and fingerprints.  The values are appended in a fixed
+            * byte order, so the result can be compared with the one from a saved file.  Doubles
+            * are appended with their bit pattern.
+            */
+            static void appendToKey (std::string &key, uint64_t value);
+            static void appendDoubleToKey (std::string &key, double value);
+            static void appendToKey (std::string &key, const std::string &value);
+            static void appendToKey (std::string &key, const ImagerUseCaseDefinition &useCase);
+
+        private:
+            const std::string m_fingerprint;
+            const std::size_t m_maxEntries;
+            std::unordered_map<std::string, Entry> m_entries;
+        };
+    }
+}
@@ -47,6 +47,15 @@ namespace royale
                 {
                     eyeError = 0u;
                 }
+
+                void decodeFields (const common::ICapturedRawFrame &frame, common::PseudoDataFields &fields) const override
+                {
+                    const auto pseudoData = frame.getPseudoData();
+                    fields.frameNumber = pseudoData[0];
+                    fields.reconfigIndex = pseudoData[0];
+                    fields.sequenceIndex = static_cast<uint16_t> (pseudoData[1] >> 7);
+                    fields.eyeError = 0u;
+                }
             };
         }
     }
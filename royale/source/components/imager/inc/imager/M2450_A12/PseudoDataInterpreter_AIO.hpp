@@ -54,6 +54,15 @@ namespace royale
                     return METAFRAMECNTR + 1;
                 }
 
+                void decodeFields (const common::ICapturedRawFrame &frame, common::PseudoDataFields &fields) const override
+                {
+                    const auto pseudoData = frame.getPseudoData();
+                    fields.frameNumber = pseudoData[METAFRAMECNTR];
+                    fields.reconfigIndex = pseudoData[RECONFIG_INDEX];
+                    fields.sequenceIndex = pseudoData[METASEQ_INDEX];
+                    fields.eyeError = 0u;
+                }
+
             };
         }
     }
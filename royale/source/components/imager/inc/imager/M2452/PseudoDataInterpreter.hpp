@@ -99,6 +99,15 @@ namespace royale
                     eyeError = 0u;
                 }
 
+                void decodeFields (const common::ICapturedRawFrame &frame, common::PseudoDataFields &fields) const override
+                {
+                    const auto pseudoData = frame.getPseudoData();
+                    fields.frameNumber = pseudoData[0];
+                    fields.reconfigIndex = pseudoData[14];
+                    fields.sequenceIndex = pseudoData[1];
+                    fields.eyeError = 0u;
+                }
+
                 bool supportsExposureFromPseudoData() const override
                 {
                     return false;
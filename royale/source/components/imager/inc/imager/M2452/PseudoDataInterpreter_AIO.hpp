@@ -62,6 +62,15 @@ namespace royale
                     return frame.getPseudoData() [163];
                 }
 
+                void decodeFields (const common::ICapturedRawFrame &frame, common::PseudoDataFields &fields) const override
+                {
+                    const auto pseudoData = frame.getPseudoData();
+                    fields.frameNumber = pseudoData[0];
+                    fields.reconfigIndex = pseudoData[14];
+                    fields.sequenceIndex = pseudoData[163];
+                    fields.eyeError = 0u;
+                }
+
             private:
 
                 void discardAllSurplusBits (uint16_t &vRef1,
@@ -118,6 +118,20 @@ namespace royale
                     }
                 }
 
+                void decodeFields (const common::ICapturedRawFrame &frame, common::PseudoDataFields &fields) const override
+                {
+                    const auto pseudoData = frame.getPseudoData();
+                    fields.frameNumber = pseudoData[3];
+                    fields.reconfigIndex = pseudoData[2];
+                    fields.sequenceIndex = pseudoData[4];
+                    fields.eyeError = 0u;
+                    if (m_usesInternalCurrentMonitor)
+                    {
+                        fields.eyeError |= pseudoData[41] & 0x3FFu;
+                        fields.eyeError |= (pseudoData[42] & 0x1Fu) << 16u;
+                    }
+                }
+
                 bool supportsExposureFromPseudoData() const override
                 {
                     return false;
@@ -122,6 +122,20 @@ namespace royale
                     }
                 }
 
+                void decodeFields (const common::ICapturedRawFrame &frame, common::PseudoDataFields &fields) const override
+                {
+                    const auto pseudoData = frame.getPseudoData();
+                    fields.frameNumber = pseudoData[3];
+                    fields.reconfigIndex = pseudoData[2];
+                    fields.sequenceIndex = pseudoData[5];
+                    fields.eyeError = 0u;
+                    if (m_usesInternalCurrentMonitor)
+                    {
+                        fields.eyeError |= pseudoData[42] & 0xFFFu;
+                        fields.eyeError |= (pseudoData[43] & 0xF00u) << 16u;
+                    }
+                }
+
                 bool supportsExposureFromPseudoData() const override
                 {
                     return true;
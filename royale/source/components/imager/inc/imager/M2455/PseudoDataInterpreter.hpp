@@ -117,6 +117,20 @@ namespace royale
                     }
                 }
 
+                void decodeFields (const common::ICapturedRawFrame &frame, common::PseudoDataFields &fields) const override
+                {
+                    const auto pseudoData = frame.getPseudoData();
+                    fields.frameNumber = pseudoData[4];
+                    fields.reconfigIndex = pseudoData[2];
+                    fields.sequenceIndex = static_cast<uint16_t> (pseudoData[5] & 0x7F);
+                    fields.eyeError = 0u;
+                    if (m_usesInternalCurrentMonitor)
+                    {
+                        fields.eyeError |= pseudoData[42] & 0x3FFu;
+                        fields.eyeError |= (pseudoData[43] & 0x3FFu) << 16u;
+                    }
+                }
+
                 bool supportsExposureFromPseudoData() const override
                 {
                     return false;
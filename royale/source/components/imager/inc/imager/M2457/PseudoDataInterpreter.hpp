@@ -129,6 +129,20 @@ namespace royale
                     }
                 }
 
+                void decodeFields (const common::ICapturedRawFrame &frame, common::PseudoDataFields &fields) const override
+                {
+                    const auto pseudoData = frame.getPseudoData();
+                    fields.frameNumber = pseudoData[4];
+                    fields.reconfigIndex = pseudoData[2];
+                    fields.sequenceIndex = pseudoData[5];
+                    fields.eyeError = 0u;
+                    if (m_usesInternalCurrentMonitor)
+                    {
+                        fields.eyeError |= pseudoData[42] & 0x3FFu;
+                        fields.eyeError |= (pseudoData[43] & 0x1Fu) << 16u;
+                    }
+                }
+
                 bool supportsExposureFromPseudoData() const override
                 {
                     return true;
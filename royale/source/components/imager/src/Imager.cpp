@@ -25,6 +25,7 @@
 #include <numeric>
 #include <algorithm>
 #include <cmath>
+#include <typeinfo>
 
 using namespace royale::imager;
 using namespace royale::common;
@@ -63,6 +64,8 @@ Imager::Imager (const ImagerParameters &params,
     m_statusIdle (0),
     m_regPllLutLower (0),
     m_regReconfCnt (0),
+    m_useCaseCache(),
+    m_useCaseCacheEnabled (true),
     m_rowLimitSensor (0),
     m_columnLimitSensor (0),
     m_currentTrigger (ImgTrigger::I2C),
@@ -810,7 +813,8 @@ void Imager::executeUseCase (const ImagerUseCaseDefinition &useCase)
 
     //use concrete imager implementation to gather the config from the use case definition
     // and resolve it by comparision with the current configuration of the hardware
-    std::map < uint16_t, uint16_t > regChanges = resolveConfiguration (prepareUseCase (useCase));
+    prepareImagerMode (useCase);
+    std::map < uint16_t, uint16_t > regChanges = resolveConfiguration (prepareUseCaseCached (useCase));
 
     try
     {
@@ -838,6 +842,112 @@ void Imager::executeUseCase (const ImagerUseCaseDefinition &useCase)
     }
 }
 
+void Imager::prepareImagerMode (const ImagerUseCaseDefinition &useCase)
+{
+}
+
+std::map < uint16_t, uint16_t > Imager::prepareUseCaseCached (const ImagerUseCaseDefinition &useCase)
+{
+    if (!m_useCaseCacheEnabled)
+    {
+        return prepareUseCase (useCase);
+    }
+
+    //everything that prepareUseCase reads, m_mbList and m_rfAssignment are already
+    //derived from the use case at this point
+    std::string key;
+    ImagerUseCaseCache::appendToKey (key, useCase);
+    ImagerUseCaseCache::appendToKey (key, m_executingUcd.getSSCEnabled());
+    ImagerUseCaseCache::appendToKey (key, m_regPllLutLower);
+    ImagerUseCaseCache::appendToKey (key, m_lutAssignment.size());
+    for (const auto &lut : m_lutAssignment)
+    {
+        ImagerUseCaseCache::appendToKey (key, lut.first);
+        ImagerUseCaseCache::appendToKey (key, lut.second);
+    }
+
+    const auto cached = getUseCaseCache().find (key);
+    if (cached)
+    {
+        LOG (DEBUG) << "[Imager] use case configuration taken from the cache";
+        //the measurement blocks have const members, so they can't be copy-assigned
+        m_mbList = std::vector<MeasurementBlock> (cached->mbList);
+        m_lutAssignment = cached->lutAssignment;
+        return cached->registers;
+    }
+
+    ImagerUseCaseCache::Entry entry;
+    entry.registers = prepareUseCase (useCase);
+    entry.mbList = std::vector<MeasurementBlock> (m_mbList);
+    entry.lutAssignment = m_lutAssignment;
+
+    auto regChanges = entry.registers;
+    getUseCaseCache().insert (key, std::move (entry));
+    return regChanges;
+}
+
+ImagerUseCaseCache &Imager::getUseCaseCache()
+{
+    if (!m_useCaseCache)
+    {
+        m_useCaseCache.reset (new ImagerUseCaseCache (getUseCaseCacheFingerprint()));
+    }
+    return *m_useCaseCache;
+}
+
+std::string Imager::getUseCaseCacheFingerprint() const
+{
+    std::string fingerprint;
+    ImagerUseCaseCache::appendToKey (fingerprint, std::string (typeid (*this).name()));
+    ImagerUseCaseCache::appendToKey (fingerprint, m_imagerParams.systemFrequency);
+    ImagerUseCaseCache::appendToKey (fingerprint, static_cast<uint64_t> (m_imagerParams.dutyCycle));
+    ImagerUseCaseCache::appendToKey (fingerprint, static_cast<uint64_t> (m_imagerParams.imageDataTransferType));
+    ImagerUseCaseCache::appendToKey (fingerprint, static_cast<uint64_t> (m_imagerParams.illuminationPad));
+    ImagerUseCaseCache::appendDoubleToKey (fingerprint, m_imagerParams.interfaceDelay);
+    ImagerUseCaseCache::appendToKey (fingerprint, m_imagerParams.maxModulationFrequency);
+    ImagerUseCaseCache::appendToKey (fingerprint, m_imagerParams.useSuperframe);
+    // getReadoutDelays reads registers which the module's base config may set
+    ImagerUseCaseCache::appendToKey (fingerprint, m_imagerParams.baseConfig.size());
+    for (const auto &reg : m_imagerParams.baseConfig)
+    {
+        ImagerUseCaseCache::appendToKey (fingerprint, reg.first);
+        ImagerUseCaseCache::appendToKey (fingerprint, reg.second);
+    }
+    ImagerUseCaseCache::appendToKey (fingerprint, MODPLLLUTCOUNT);
+    ImagerUseCaseCache::appendToKey (fingerprint, LUTIDXOFFSET);
+    ImagerUseCaseCache::appendToKey (fingerprint, CLKDIV);
+    return fingerprint;
+}
+
+void Imager::setUseCaseCacheEnabled (bool enabled)
+{
+    m_useCaseCacheEnabled = enabled;
+    if (!enabled)
+    {
+        m_useCaseCache.reset();
+    }
+}
+
+bool Imager::loadUseCaseCache (const std::string &filename)
+{
+    if (!m_useCaseCacheEnabled)
+    {
+        return false;
+    }
+
+    return getUseCaseCache().load (filename);
+}
+
+bool Imager::saveUseCaseCache (const std::string &filename)
+{
+    if (!m_useCaseCacheEnabled)
+    {
+        return false;
+    }
+
+    return getUseCaseCache().save (filename);
+}
+
 void Imager::setExternalTrigger (bool useExternalTrigger)
 {
     if (m_imagerState != ImagerState::PowerDown &&
@@ -863,3 +973,16 @@ void Imager::setExternalTrigger (bool useExternalTrigger)
         m_currentTrigger = ImgTrigger::I2C;
     }
 }
+
+std::vector < uint16_t > Imager::getSideEffectRegisters() const
+{
+    std::vector < uint16_t > registers;
+    for (auto reg : { m_regTrigger, m_regStatus, m_regReconfCnt })
+    {
+        if (reg != 0u)
+        {
+            registers.push_back (reg);
+        }
+    }
+    return registers;
+}
@@ -32,7 +32,8 @@ using namespace royale::common;
 uint32_t ImagerBase::s_imagerIdCounter = 0;
 
 ImagerBase::ImagerBase (const std::shared_ptr<royale::hal::IBridgeImager> &bridge) :
-    m_loggingListener (nullptr)
+    m_loggingListener (nullptr),
+    m_transactionCost (royale::hal::BridgeImagerTransactionCost::unknown())
 {
     if (bridge == nullptr)
     {
@@ -41,6 +42,12 @@ ImagerBase::ImagerBase (const std::shared_ptr<royale::hal::IBridgeImager> &bridg
 
     m_bridge = bridge;
 
+    auto costModel = std::dynamic_pointer_cast<royale::hal::IBridgeImagerTransactionCost> (bridge);
+    if (costModel)
+    {
+        m_transactionCost = costModel->getTransactionCost();
+    }
+
     m_imagerMyId = s_imagerIdCounter;
     s_imagerIdCounter++;
     m_serial = "Unidentified device " + toStdString (m_imagerMyId);
@@ -189,37 +196,72 @@ void ImagerBase::trackAndWriteRegisters (const std::map < uint16_t, uint16_t > &
         return;
     }
 
-    //download to imager
-    uint16_t firstAddress = registers.begin()->first;
-    uint16_t currentAddress = 0;
-    std::vector<uint16_t> regBatch{};
+    auto sideEffectRegisters = getSideEffectRegisters();
+    std::sort (sideEffectRegisters.begin(), sideEffectRegisters.end());
+    const auto fillGaps = !sideEffectRegisters.empty();
+
+    //a gap can be filled if all registers in it have a known value and rewriting
+    // them is cheaper than the overhead of starting another burst
+    auto canFillGap = [&] (uint32_t gapStart, uint32_t gapEnd)
+    {
+        if (!fillGaps ||
+                (gapEnd - gapStart) * m_transactionCost.perRegister >= m_transactionCost.perTransaction)
+        {
+            return false;
+        }
+
+        for (auto address = gapStart; address < gapEnd; address++)
+        {
+            const auto regAddress = static_cast<uint16_t> (address);
+            if (m_regDownloaded.count (regAddress) == 0 ||
+                    std::binary_search (sideEffectRegisters.begin(), sideEffectRegisters.end(), regAddress))
+            {
+                return false;
+            }
+        }
+
+        return true;
+    };
 
-    auto writeAndRemember = [ = ] (uint16_t firstAddress, std::vector<uint16_t> &regBatch)
+    auto writeAndRemember = [this] (uint16_t firstAddress, const std::vector<uint16_t> &regBatch)
     {
         logMessage (ImageSensorLogType::BurstStart, toStdString (regBatch.size()));
 
         //a consecutive batch is ready to be written
         m_bridge->writeImagerBurst (firstAddress, regBatch);
 
+        LOG (DEBUG) << "Register burst written: 0x" << std::hex << firstAddress << " (" << std::dec << regBatch.size() << " registers)";
+
         //write succeeded if no exception interrupted the call
-        for (auto regBlockAddress : regBatch)
+        for (auto regValue : regBatch)
         {
-            logRegister (ImageSensorLogType::I2CWrite, firstAddress, regBlockAddress);
-            LOG (INFO) << "Register written: 0x" << std::hex << firstAddress << " <= 0x" << std::hex << regBlockAddress;
+            logRegister (ImageSensorLogType::I2CWrite, firstAddress, regValue);
 
             //remember what was written
-            m_regDownloaded[firstAddress++] = regBlockAddress;
+            m_regDownloaded[firstAddress++] = regValue;
         }
 
         logMessage (ImageSensorLogType::BurstEnd, toStdString (regBatch.size()));
     };
 
-    for (auto reg : registers)
+    //download to imager
+    uint16_t firstAddress = registers.begin()->first;
+    uint32_t nextAddress = firstAddress;
+    std::vector<uint16_t> regBatch{};
+
+    for (const auto &reg : registers)
     {
-        //check for consecutivity
-        if (currentAddress != reg.first - 1)
+        if (reg.first != nextAddress)
         {
-            if (regBatch.size())
+            if (canFillGap (nextAddress, reg.first))
+            {
+                //extend the burst by rewriting the values which are already on the imager
+                for (; nextAddress < reg.first; nextAddress++)
+                {
+                    regBatch.push_back (m_regDownloaded[static_cast<uint16_t> (nextAddress)]);
+                }
+            }
+            else
             {
                 writeAndRemember (firstAddress, regBatch);
 
@@ -227,22 +269,14 @@ void ImagerBase::trackAndWriteRegisters (const std::map < uint16_t, uint16_t > &
                 regBatch.clear();
                 firstAddress = reg.first;
             }
-
-            currentAddress = reg.first;
-        }
-        else
-        {
-            currentAddress++;
         }
 
-        //it was a consecutive address entry, stage for burst write
+        //stage for burst write
         regBatch.push_back (reg.second);
+        nextAddress = reg.first + 1u;
     }
 
-    if (regBatch.size())
-    {
-        writeAndRemember (firstAddress, regBatch);
-    }
+    writeAndRemember (firstAddress, regBatch);
 }
 
 void ImagerBase::trackShadowedRegisters (const std::map < uint16_t, uint16_t > &registers)
@@ -283,6 +317,11 @@ void ImagerBase::maskedWriteRegister (uint16_t address, uint16_t mask, uint16_t
     trackAndWriteRegisters ({ { address, newValue } });
 }
 
+std::vector < uint16_t > ImagerBase::getSideEffectRegisters() const
+{
+    return {};
+}
+
 std::map < uint16_t, uint16_t > ImagerBase::resolveConfiguration (const std::map < uint16_t, uint16_t > &regChanges)
 {
     //create map for gathering all differences
@@ -367,3 +367,11 @@ bool ImagerM2450::isFirstFrame (const std::vector<ImagerRawFrame> &rfList, size_
     //all remaining cases
     return false;
 }
+
+std::vector < uint16_t > ImagerM2450::getSideEffectRegisters() const
+{
+    auto registers = Imager::getSideEffectRegisters();
+    registers.push_back (M2450_A11::CFGCNT_TRIG);
+    registers.push_back (M2450_A11::MTCU_TRIG);
+    return registers;
+}
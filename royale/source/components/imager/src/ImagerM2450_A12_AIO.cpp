@@ -682,6 +682,8 @@ void ImagerM2450_A12_AIO::reconfigure (const ImagerUseCaseDefinition &useCase, u
         }
         commitOrRollbackShadowedRegisters (true);
 
+        prepareImagerMode (useCase);
+
         //create map for staging the changes of exposure time and/or frame rate
         const auto regChanges = resolveConfiguration (prepareUseCase (useCase));
 
@@ -889,7 +891,7 @@ void ImagerM2450_A12_AIO::prepareMeasurementBlockTargetTime (MeasurementBlockId
     m_mbList[mbId].frameRateCounter = 0u;
 }
 
-std::map < uint16_t, uint16_t > ImagerM2450_A12_AIO::prepareUseCase (const ImagerUseCaseDefinition &useCase)
+void ImagerM2450_A12_AIO::prepareImagerMode (const ImagerUseCaseDefinition &useCase)
 {
     const auto newMode = useCase.getMixedModeEnabled();
     const auto modeChanged = (newMode != m_currentModeIsMixedMode);
@@ -944,7 +946,10 @@ std::map < uint16_t, uint16_t > ImagerM2450_A12_AIO::prepareUseCase (const Image
     //  and it would be necessary to read the register (to avoid this read
     //  the tracked address will be cleared to force a write)
     m_regDownloaded.erase (CFGCNT_CTRLSEQ);
+}
 
+std::map < uint16_t, uint16_t > ImagerM2450_A12_AIO::prepareUseCase (const ImagerUseCaseDefinition &useCase)
+{
     prepareFrameRateSettings (useCase);
     preparePsSettings (useCase);
     prepareExposureSettings (useCase);
@@ -642,3 +642,10 @@ bool ImagerM2452::isFirstFrame (const std::vector<ImagerRawFrame> &rfList, size_
     //all remaining cases
     return false;
 }
+
+std::vector < uint16_t > ImagerM2452::getSideEffectRegisters() const
+{
+    auto registers = Imager::getSideEffectRegisters();
+    registers.push_back (CFGCNT_TRIG);
+    return registers;
+}
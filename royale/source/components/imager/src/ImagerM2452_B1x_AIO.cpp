@@ -20,6 +20,7 @@
 #include <imager/M2452_B1x/ImagerAIOFirmware.hpp>
 #include <imager/M2452/PseudoDataInterpreter_AIO.hpp>
 
+#include <algorithm>
 #include <limits>
 #include <thread>
 
@@ -277,6 +278,11 @@ ImagerM2452_B1x_AIO::~ImagerM2452_B1x_AIO()
 
 }
 
+DesignStepInfo ImagerM2452_B1x_AIO::getDesignStepInfo()
+{
+    return { ANAIP_DESIGNSTEP, { 0x0B11, 0x0B12 } };
+}
+
 std::unique_ptr<IPseudoDataInterpreter> ImagerM2452_B1x_AIO::createPseudoDataInterpreter()
 {
     std::unique_ptr<IPseudoDataInterpreter> pseudoDataInter (new PseudoDataInterpreter_AIO);
@@ -290,10 +296,10 @@ void ImagerM2452_B1x_AIO::initialize()
     uint16_t regValue = 0;
     uint16_t regDs = 0;
 
-    readImagerRegister (ANAIP_DESIGNSTEP, regDs);
+    const auto dsInfo = getDesignStepInfo();
+    readImagerRegister (dsInfo.ANAIP_DESIGNSTEP_Address, regDs);
 
-    if (0x0B11 != regDs &&
-            0x0B12 != regDs)
+    if (std::find (dsInfo.designSteps.begin(), dsInfo.designSteps.end(), regDs) == dsInfo.designSteps.end())
     {
         throw Exception ("wrong design step");
     }
@@ -376,6 +382,8 @@ void ImagerM2452_B1x_AIO::reconfigure (const ImagerUseCaseDefinition &useCase, u
         }
         commitOrRollbackShadowedRegisters (true);
 
+        prepareImagerMode (useCase);
+
         //create map for staging the changes of exposure time and/or frame rate
         const auto regChanges = resolveConfiguration (prepareUseCase (useCase));
 
@@ -529,7 +537,7 @@ std::vector<MeasurementBlock> ImagerM2452_B1x_AIO::createMeasurementBlockList (c
     return std::vector<MeasurementBlock> (m_defaultMeasurementBlockCount, MeasurementBlock (m_defaultMeasurementBlockCapacity));
 }
 
-std::map < uint16_t, uint16_t > ImagerM2452_B1x_AIO::prepareUseCase (const ImagerUseCaseDefinition &useCase)
+void ImagerM2452_B1x_AIO::prepareImagerMode (const ImagerUseCaseDefinition &useCase)
 {
     const auto newMode = useCase.getMixedModeEnabled();
     const auto modeChanged = (newMode != m_currentModeIsMixedMode);
@@ -576,7 +584,10 @@ std::map < uint16_t, uint16_t > ImagerM2452_B1x_AIO::prepareUseCase (const Image
     }
 
     m_regDownloaded.erase (CFGCNT_CTRLSEQ); //force write (firmware possibly changed the register value)
+}
 
+std::map < uint16_t, uint16_t > ImagerM2452_B1x_AIO::prepareUseCase (const ImagerUseCaseDefinition &useCase)
+{
     //create map for staging all changes
     std::map < uint16_t, uint16_t > regChanges;
     prepareFrameRateSettings (useCase);
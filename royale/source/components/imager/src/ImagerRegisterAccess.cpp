@@ -16,6 +16,7 @@
 #include <common/exceptions/RuntimeError.hpp>
 #include <common/exceptions/Timeout.hpp>
 #include <common/exceptions/WrongState.hpp>
+#include <common/ExponentialBackoff.hpp>
 #include <common/NarrowCast.hpp>
 
 #include <algorithm>
@@ -32,10 +33,16 @@ using namespace royale::common;
 namespace
 {
     /**
-    * The number of times that pollUntil sleeps for pollingInterval, before it throws a
-    * Timeout.
+    * pollUntil throws a Timeout after it has slept for this many times pollSleep (in addition to
+    * firstSleep).
     */
     const auto MAX_POLL_RETRIES = 4;
+
+    /**
+    * The first sleep between polls is pollSleep divided by this, the following ones double until
+    * they reach pollSleep.
+    */
+    const auto POLL_BACKOFF_DIVISOR = 8;
 }
 
 ImagerRegisterAccess::ImagerRegisterAccess (const std::shared_ptr<royale::hal::IBridgeImager> &bridge) :
@@ -110,31 +117,22 @@ void ImagerRegisterAccess::pollUntil (uint16_t reg,
                                       const std::chrono::microseconds pollSleep)
 {
     m_bridge->sleepFor (firstSleep);
-    bool done = false;
 
     uint16_t polledVal;
     m_bridge->readImagerRegister (reg, polledVal);
-    if (polledVal == expectedVal)
-    {
-        done = true;
-    }
 
-    int retries = 0;
-    while (!done && retries < MAX_POLL_RETRIES)
+    ExponentialBackoff backoff (pollSleep / POLL_BACKOFF_DIVISOR, pollSleep, MAX_POLL_RETRIES * pollSleep);
+    std::chrono::microseconds delay;
+    while (polledVal != expectedVal)
     {
-        LOG (DEBUG) << "Additional sleep in pollUntil";
-        retries++;
-        m_bridge->sleepFor (pollSleep);
-        m_bridge->readImagerRegister (reg, polledVal);
-        if (polledVal == expectedVal)
+        if (!backoff.next (delay))
         {
-            done = true;
+            throw Timeout ("Expected value not read even after polling");
         }
-    }
 
-    if (!done)
-    {
-        throw Timeout ("Expected value not read even after polling");
+        LOG (DEBUG) << "Additional sleep in pollUntil";
+        m_bridge->sleepFor (delay);
+        m_bridge->readImagerRegister (reg, polledVal);
     }
 }
 
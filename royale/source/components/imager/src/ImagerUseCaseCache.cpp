@@ -0,0 +1,357 @@
+/****************************************************************************\
+* Copyright (C) 2019 pmdtechnologies ag
+*
+* THIS CODE AND INFORMATION ARE PROVIDED "AS IS" WITHOUT WARRANTY OF ANY
+* KIND, EITHER EXPRESSED OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE
+* IMPLIED WARRANTIES OF MERCHANTABILITY AND/OR FITNESS FOR A
+* PARTICULAR PURPOSE.
+*
+\****************************************************************************/
+
+#include <imager/ImagerUseCaseCache.hpp>
+
+#include <common/RoyaleLogger.hpp>
+
+#include <cstring>
+#include <fstream>
+#include <iterator>
+
+using namespace royale::imager;
+
+namespace
+{
+    /**
+    * Identifies the file format, the last byte is the version.
+    */
+    const std::string CACHE_FILE_MAGIC ("RoyUCC\x00\x01", 8);
+
+    /**
+    * Reads values in the format written by ImagerUseCaseCache::appendToKey.  All read functions
+    * return false when the end of the data is reached.
+    */
+    class Reader
+    {
+    public:
+        Reader (const std::string &data, std::size_t pos) :
+            m_data (data),
+            m_pos (pos)
+        {
+        }
+
+        bool read (uint64_t &value)
+        {
+            if (m_data.size() - m_pos < sizeof (value))
+            {
+                return false;
+            }
+            value = 0u;
+            for (std::size_t i = 0; i < sizeof (value); i++)
+            {
+                value |= static_cast<uint64_t> (static_cast<uint8_t> (m_data[m_pos++])) << (8u * i);
+            }
+            return true;
+        }
+
+        template<typename T>
+        bool readAs (T &value)
+        {
+            uint64_t raw;
+            if (!read (raw))
+            {
+                return false;
+            }
+            value = static_cast<T> (raw);
+            return true;
+        }
+
+        bool read (std::string &value)
+        {
+            uint64_t length;
+            if (!read (length) || m_data.size() - m_pos < length)
+            {
+                return false;
+            }
+            value = m_data.substr (m_pos, static_cast<std::size_t> (length));
+            m_pos += static_cast<std::size_t> (length);
+            return true;
+        }
+
+        bool atEnd() const
+        {
+            return m_pos == m_data.size();
+        }
+
+    private:
+        const std::string &m_data;
+        std::size_t m_pos;
+    };
+
+    void appendEntry (std::string &data, const ImagerUseCaseCache::Entry &entry)
+    {
+        ImagerUseCaseCache::appendToKey (data, entry.registers.size());
+        for (const auto &reg : entry.registers)
+        {
+            ImagerUseCaseCache::appendToKey (data, reg.first);
+            ImagerUseCaseCache::appendToKey (data, reg.second);
+        }
+
+        ImagerUseCaseCache::appendToKey (data, entry.lutAssignment.size());
+        for (const auto &lut : entry.lutAssignment)
+        {
+            ImagerUseCaseCache::appendToKey (data, lut.first);
+            ImagerUseCaseCache::appendToKey (data, lut.second);
+        }
+
+        ImagerUseCaseCache::appendToKey (data, entry.mbList.size());
+        for (const auto &mb : entry.mbList)
+        {
+            ImagerUseCaseCache::appendToKey (data, mb.maxSequenceLength);
+            ImagerUseCaseCache::appendToKey (data, mb.sequence.size());
+            for (const auto &seq : mb.sequence)
+            {
+                ImagerUseCaseCache::appendToKey (data, seq.expo);
+                ImagerUseCaseCache::appendToKey (data, seq.fr);
+                ImagerUseCaseCache::appendToKey (data, seq.ps);
+                ImagerUseCaseCache::appendToKey (data, seq.pllset);
+                ImagerUseCaseCache::appendToKey (data, seq.fr_valEqZero);
+            }
+            ImagerUseCaseCache::appendToKey (data, mb.cycles);
+            ImagerUseCaseCache::appendToKey (data, mb.frameRateCounter);
+            ImagerUseCaseCache::appendToKey (data, mb.safeForReconfig);
+        }
+    }
+
+    bool readEntry (Reader &reader, ImagerUseCaseCache::Entry &entry)
+    {
+        uint64_t count;
+        if (!reader.read (count))
+        {
+            return false;
+        }
+        for (uint64_t i = 0; i < count; i++)
+        {
+            uint16_t address, value;
+            if (!reader.readAs (address) || !reader.readAs (value))
+            {
+                return false;
+            }
+            entry.registers[address] = value;
+        }
+
+        if (!reader.read (count))
+        {
+            return false;
+        }
+        for (uint64_t i = 0; i < count; i++)
+        {
+            uint32_t frequency;
+            uint16_t lutIndex;
+            if (!reader.readAs (frequency) || !reader.readAs (lutIndex))
+            {
+                return false;
+            }
+            entry.lutAssignment[frequency] = lutIndex;
+        }
+
+        if (!reader.read (count))
+        {
+            return false;
+        }
+        for (uint64_t i = 0; i < count; i++)
+        {
+            std::size_t capacity, sequenceLength;
+            if (!reader.readAs (capacity) || !reader.readAs (sequenceLength) || sequenceLength > capacity)
+            {
+                return false;
+            }
+
+            MeasurementBlock mb (capacity);
+            mb.sequence.resize (sequenceLength);
+            for (auto &seq : mb.sequence)
+            {
+                if (!reader.readAs (seq.expo) || !reader.readAs (seq.fr) ||
+                        !reader.readAs (seq.ps) || !reader.readAs (seq.pllset) ||
+                        !reader.readAs (seq.fr_valEqZero))
+                {
+                    return false;
+                }
+            }
+            if (!reader.readAs (mb.cycles) || !reader.readAs (mb.frameRateCounter) || !reader.readAs (mb.safeForReconfig))
+            {
+                return false;
+            }
+            entry.mbList.push_back (std::move (mb));
+        }
+
+        return true;
+    }
+}
+
+ImagerUseCaseCache::ImagerUseCaseCache (const std::string &fingerprint, std::size_t maxEntries) :
+    m_fingerprint (fingerprint),
+    m_maxEntries (maxEntries)
+{
+}
+
+const ImagerUseCaseCache::Entry *ImagerUseCaseCache::find (const std::string &key) const
+{
+    const auto it = m_entries.find (key);
+    if (it == m_entries.end())
+    {
+        return nullptr;
+    }
+    return &it->second;
+}
+
+void ImagerUseCaseCache::insert (const std::string &key, Entry entry)
+{
+    if (m_entries.size() >= m_maxEntries)
+    {
+        // The number of different use cases is small for any real module, this only stops
+        // unbounded growth if the LUT state keeps producing new keys.
+        LOG (DEBUG) << "Use case cache is full, clearing it";
+        m_entries.clear();
+    }
+    m_entries[key] = std::move (entry);
+}
+
+void ImagerUseCaseCache::clear()
+{
+    m_entries.clear();
+}
+
+std::size_t ImagerUseCaseCache::size() const
+{
+    return m_entries.size();
+}
+
+bool ImagerUseCaseCache::save (const std::string &filename) const
+{
+    std::string data (CACHE_FILE_MAGIC);
+    appendToKey (data, m_fingerprint);
+    appendToKey (data, m_entries.size());
+    for (const auto &entry : m_entries)
+    {
+        appendToKey (data, entry.first);
+        appendEntry (data, entry.second);
+    }
+
+    std::ofstream f (filename, std::ios_base::out | std::ios_base::binary | std::ios_base::trunc);
+    if (!f.is_open())
+    {
+        LOG (WARN) << "Can't open use case cache file " << filename << " for writing";
+        return false;
+    }
+    f.write (data.data(), static_cast<std::streamsize> (data.size()));
+    return f.good();
+}
+
+bool ImagerUseCaseCache::load (const std::string &filename)
+{
+    std::ifstream f (filename, std::ios_base::in | std::ios_base::binary);
+    if (!f.is_open())
+    {
+        return false;
+    }
+    const std::string data ( (std::istreambuf_iterator<char> (f)), std::istreambuf_iterator<char>());
+
+    if (data.compare (0, CACHE_FILE_MAGIC.size(), CACHE_FILE_MAGIC) != 0)
+    {
+        LOG (WARN) << "Use case cache file " << filename << " has an unknown format";
+        return false;
+    }
+
+    Reader reader (data, CACHE_FILE_MAGIC.size());
+    std::string fingerprint;
+    uint64_t count;
+    if (!reader.read (fingerprint) || !reader.read (count))
+    {
+        LOG (WARN) << "Use case cache file " << filename << " is truncated";
+        return false;
+    }
+    if (fingerprint != m_fingerprint)
+    {
+        LOG (INFO) << "Use case cache file " << filename << " was saved for a different imager configuration";
+        return false;
+    }
+
+    std::unordered_map<std::string, Entry> entries;
+    for (uint64_t i = 0; i < count; i++)
+    {
+        std::string key;
+        Entry entry;
+        if (!reader.read (key) || !readEntry (reader, entry))
+        {
+            LOG (WARN) << "Use case cache file " << filename << " is truncated";
+            return false;
+        }
+        entries[key] = std::move (entry);
+    }
+    if (!reader.atEnd())
+    {
+        LOG (WARN) << "Use case cache file " << filename << " has trailing data";
+        return false;
+    }
+
+    m_entries = std::move (entries);
+    return true;
+}
+
+void ImagerUseCaseCache::appendToKey (std::string &key, uint64_t value)
+{
+    for (std::size_t i = 0; i < sizeof (value); i++)
+    {
+        key.push_back (static_cast<char> ( (value >> (8u * i)) & 0xffu));
+    }
+}
+
+void ImagerUseCaseCache::appendDoubleToKey (std::string &key, double value)
+{
+    static_assert (sizeof (double) == sizeof (uint64_t), "double must be 64 bits");
+    uint64_t bits;
+    std::memcpy (&bits, &value, sizeof (bits));
+    appendToKey (key, bits);
+}
+
+void ImagerUseCaseCache::appendToKey (std::string &key, const std::string &value)
+{
+    appendToKey (key, value.size());
+    key.append (value);
+}
+
+void ImagerUseCaseCache::appendToKey (std::string &key, const ImagerUseCaseDefinition &useCase)
+{
+    // Deliberately not using ImagerUseCaseDefinition::operator=='s subset of the members,
+    // everything which can change a register value must be part of the key.
+    uint16_t columns, rows, roiCMin, roiRMin;
+    useCase.getImage (columns, rows);
+    useCase.getStartOfROI (roiCMin, roiRMin);
+
+    appendToKey (key, useCase.getTargetRate());
+    appendToKey (key, useCase.getRawFrameRate());
+    appendToKey (key, columns);
+    appendToKey (key, rows);
+    appendToKey (key, roiCMin);
+    appendToKey (key, roiRMin);
+    appendToKey (key, useCase.getSSCEnabled());
+    appendToKey (key, useCase.getMixedModeEnabled());
+
+    const auto &rawFrames = useCase.getRawFrames();
+    appendToKey (key, rawFrames.size());
+    for (const auto &rf : rawFrames)
+    {
+        appendToKey (key, rf.modulationFrequency);
+        appendDoubleToKey (key, rf.ssc_freq);
+        appendDoubleToKey (key, rf.ssc_kspread);
+        appendDoubleToKey (key, rf.ssc_delta);
+        appendToKey (key, rf.grayscale);
+        appendToKey (key, static_cast<uint64_t> (rf.dutyCycle));
+        appendToKey (key, rf.phaseAngle);
+        appendToKey (key, rf.exposureTime);
+        appendToKey (key, static_cast<uint64_t> (rf.alignment));
+        appendToKey (key, rf.isStartOfLinkedRawFrames);
+        appendToKey (key, rf.isEndOfLinkedRawFrames);
+        appendToKey (key, rf.isEndOfLinkedMeasurement);
+        appendDoubleToKey (key, rf.tEyeSafety);
+    }
+}
@@ -11,6 +11,7 @@
 #pragma once
 
 #include <hal/IBridgeImager.hpp>
+#include <hal/IBridgeImagerTransactionCost.hpp>
 #include <ISimImager.hpp>
 
 #include <map>
@@ -26,8 +27,12 @@ namespace royale
         /**
          * A virtual IBridgeImager with simulated imager hardware to respond to reading and writing
          * registers.
+         *
+         * By default this reports BridgeImagerTransactionCost::unknown(), so that ImagerBase never
+         * fills gaps between bursts and getWrittenRegisters() contains exactly the registers that
+         * the imager changed.  Tests for the gap filling can change this with setTransactionCost().
          */
-        class StubBridgeImager : public royale::hal::IBridgeImager
+        class StubBridgeImager : public royale::hal::IBridgeImager, public royale::hal::IBridgeImagerTransactionCost
         {
         public:
             StubBridgeImager (std::shared_ptr <royale::stub::ISimImager> simImager, std::ostream &file = std::cout);
@@ -46,6 +51,14 @@ namespace royale
 
             void sleepFor (std::chrono::microseconds sleepDuration) override;
 
+            royale::hal::BridgeImagerTransactionCost getTransactionCost() const override;
+
+            /**
+             * Sets the value returned by getTransactionCost(). ImagerBase reads this when it is
+             * constructed, so this has to be called before creating the imager.
+             */
+            void setTransactionCost (const royale::hal::BridgeImagerTransactionCost &cost);
+
             /**
              * Clears all entries from the written registers map.
              */
@@ -76,6 +89,7 @@ namespace royale
             bool m_hasBeenReset = false;
 
             uint32_t m_registerCalls;
+            royale::hal::BridgeImagerTransactionCost m_transactionCost;
         };
     }
 }
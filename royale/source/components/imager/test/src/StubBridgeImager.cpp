@@ -26,7 +26,8 @@ StubBridgeImager::StubBridgeImager (std::shared_ptr <ISimImager> simImager, std:
     m_file (file),
     m_simImager (std::move (simImager)),
     m_enableCorruptedCommunication (false),
-    m_registerCalls (0)
+    m_registerCalls (0),
+    m_transactionCost (royale::hal::BridgeImagerTransactionCost::unknown())
 {
     m_file << "";
     if (nullptr == m_simImager)
@@ -166,3 +167,13 @@ void StubBridgeImager::sleepFor (std::chrono::microseconds sleepDuration)
 {
     m_simImager->runSimulation (sleepDuration);
 }
+
+royale::hal::BridgeImagerTransactionCost StubBridgeImager::getTransactionCost() const
+{
+    return m_transactionCost;
+}
+
+void StubBridgeImager::setTransactionCost (const royale::hal::BridgeImagerTransactionCost &cost)
+{
+    m_transactionCost = cost;
+}
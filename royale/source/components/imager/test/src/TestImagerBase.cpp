@@ -0,0 +1,287 @@
+/****************************************************************************\
+* Copyright (C) 2019 pmdtechnologies ag
+*
+* THIS CODE AND INFORMATION ARE PROVIDED "AS IS" WITHOUT WARRANTY OF ANY
+* KIND, EITHER EXPRESSED OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE
+* IMPLIED WARRANTIES OF MERCHANTABILITY AND/OR FITNESS FOR A
+* PARTICULAR PURPOSE.
+*
+\****************************************************************************/
+
+#include <gtest/gtest.h>
+#include <hal/IBridgeImagerTransactionCost.hpp>
+#include <imager/ImagerEmpty.hpp>
+#include <imager/M2450_A12/PseudoDataInterpreter.hpp>
+
+#include <map>
+#include <memory>
+#include <vector>
+
+using namespace royale::common;
+using namespace royale::hal;
+using namespace royale::imager;
+
+namespace
+{
+    /**
+     * A bridge which remembers the register state and counts the number of transactions that
+     * were needed to reach it.
+     */
+    class CountingBridgeImager : public IBridgeImager
+    {
+    public:
+        CountingBridgeImager() :
+            m_transactions (0u),
+            m_registersWritten (0u)
+        {
+        }
+
+        void setImagerReset (bool state) override
+        {
+        }
+
+        void readImagerRegister (uint16_t regAddr, uint16_t &value) override
+        {
+            m_transactions++;
+            value = m_registers[regAddr];
+        }
+
+        void writeImagerRegister (uint16_t regAddr, uint16_t value) override
+        {
+            m_transactions++;
+            m_registersWritten++;
+            m_registers[regAddr] = value;
+        }
+
+        void readImagerBurst (uint16_t firstRegAddr, std::vector<uint16_t> &values) override
+        {
+            m_transactions++;
+            for (auto &value : values)
+            {
+                value = m_registers[firstRegAddr++];
+            }
+        }
+
+        void writeImagerBurst (uint16_t firstRegAddr, const std::vector<uint16_t> &values) override
+        {
+            m_transactions++;
+            m_registersWritten += values.size();
+            for (auto value : values)
+            {
+                m_registers[firstRegAddr++] = value;
+            }
+        }
+
+        void sleepFor (std::chrono::microseconds sleepDuration) override
+        {
+        }
+
+        void resetCounters()
+        {
+            m_transactions = 0u;
+            m_registersWritten = 0u;
+        }
+
+        std::map<uint16_t, uint16_t> m_registers;
+        std::size_t m_transactions;
+        std::size_t m_registersWritten;
+    };
+
+    /**
+     * A CountingBridgeImager which also reports its transaction cost.
+     */
+    class CostedBridgeImager : public CountingBridgeImager, public IBridgeImagerTransactionCost
+    {
+    public:
+        explicit CostedBridgeImager (const BridgeImagerTransactionCost &cost) :
+            m_cost (cost)
+        {
+        }
+
+        BridgeImagerTransactionCost getTransactionCost() const override
+        {
+            return m_cost;
+        }
+
+        const BridgeImagerTransactionCost m_cost;
+    };
+
+    /**
+     * A register outside of the addresses used by these tests, so that TrackingImager has a
+     * non-empty list of side-effect registers.
+     */
+    const uint16_t UNUSED_TRIGGER_REGISTER = 0x9900;
+
+    /**
+     * Exposes ImagerBase's register tracking, with a configurable list of side-effect registers.
+     */
+    class TrackingImager : public ImagerEmpty
+    {
+    public:
+        TrackingImager (std::shared_ptr<IBridgeImager> bridge, std::vector<uint16_t> sideEffectRegisters = { UNUSED_TRIGGER_REGISTER }) :
+            ImagerEmpty (bridge, std::unique_ptr<IPseudoDataInterpreter> (new M2450_A12::PseudoDataInterpreter())),
+            m_sideEffectRegisters (std::move (sideEffectRegisters))
+        {
+        }
+
+        void writeChanges (const std::map < uint16_t, uint16_t > &registers)
+        {
+            trackAndWriteRegisters (resolveConfiguration (registers));
+        }
+
+    protected:
+        std::vector < uint16_t > getSideEffectRegisters() const override
+        {
+            return m_sideEffectRegisters;
+        }
+
+    private:
+        const std::vector<uint16_t> m_sideEffectRegisters;
+    };
+
+    std::map < uint16_t, uint16_t > initialConfig()
+    {
+        std::map < uint16_t, uint16_t > config;
+        for (uint16_t i = 0; i < 16; i++)
+        {
+            config[static_cast<uint16_t> (0x9800 + i)] = static_cast<uint16_t> (0x100 + i);
+        }
+        return config;
+    }
+
+    /**
+     * Eight registers of initialConfig, each one of them followed by a register that isn't changed.
+     */
+    std::map < uint16_t, uint16_t > sparseChange()
+    {
+        std::map < uint16_t, uint16_t > config;
+        for (uint16_t i = 0; i < 16; i += 2)
+        {
+            config[static_cast<uint16_t> (0x9800 + i)] = static_cast<uint16_t> (0x200 + i);
+        }
+        return config;
+    }
+}
+
+TEST (TestImagerBase, ConsecutiveRegistersAreOneBurst)
+{
+    auto bridge = std::make_shared<CostedBridgeImager> (BridgeImagerTransactionCost::i2c());
+    TrackingImager imager (bridge);
+
+    imager.writeChanges (initialConfig());
+    EXPECT_EQ (1u, bridge->m_transactions);
+    EXPECT_EQ (initialConfig(), bridge->m_registers);
+}
+
+TEST (TestImagerBase, GapsOfUnknownRegistersAreNotFilled)
+{
+    auto bridge = std::make_shared<CostedBridgeImager> (BridgeImagerTransactionCost::usbControl());
+    TrackingImager imager (bridge);
+
+    imager.writeChanges (sparseChange());
+    EXPECT_EQ (sparseChange().size(), bridge->m_transactions);
+    EXPECT_EQ (sparseChange(), bridge->m_registers);
+}
+
+TEST (TestImagerBase, SparseChangeIsCoalesced)
+{
+    auto bridge = std::make_shared<CostedBridgeImager> (BridgeImagerTransactionCost::i2c());
+    TrackingImager imager (bridge);
+
+    imager.writeChanges (initialConfig());
+    bridge->resetCounters();
+
+    imager.writeChanges (sparseChange());
+    EXPECT_EQ (1u, bridge->m_transactions);
+    EXPECT_EQ (15u, bridge->m_registersWritten);
+
+    auto expected = initialConfig();
+    for (const auto &reg : sparseChange())
+    {
+        expected[reg.first] = reg.second;
+    }
+    EXPECT_EQ (expected, bridge->m_registers);
+
+    // The tracked state must match the hardware, so writing the same change again is a no-op
+    bridge->resetCounters();
+    imager.writeChanges (sparseChange());
+    EXPECT_EQ (0u, bridge->m_transactions);
+}
+
+TEST (TestImagerBase, GapLongerThanOverheadIsNotFilled)
+{
+    auto bridge = std::make_shared<CostedBridgeImager> (BridgeImagerTransactionCost::i2c());
+    TrackingImager imager (bridge);
+
+    imager.writeChanges (initialConfig());
+    bridge->resetCounters();
+
+    // For I2C a gap of two registers costs as much as a new transaction
+    imager.writeChanges ({ { 0x9800, 0x300 }, { 0x9803, 0x303 } });
+    EXPECT_EQ (2u, bridge->m_transactions);
+    EXPECT_EQ (2u, bridge->m_registersWritten);
+
+    // For USB, it's cheaper to rewrite the registers
+    auto usbBridge = std::make_shared<CostedBridgeImager> (BridgeImagerTransactionCost::usbControl());
+    TrackingImager usbImager (usbBridge);
+
+    usbImager.writeChanges (initialConfig());
+    usbBridge->resetCounters();
+
+    usbImager.writeChanges ({ { 0x9800, 0x300 }, { 0x9803, 0x303 } });
+    EXPECT_EQ (1u, usbBridge->m_transactions);
+    EXPECT_EQ (4u, usbBridge->m_registersWritten);
+    EXPECT_EQ (0x101, usbBridge->m_registers.at (0x9801));
+    EXPECT_EQ (0x102, usbBridge->m_registers.at (0x9802));
+    EXPECT_EQ (0x303, usbBridge->m_registers.at (0x9803));
+}
+
+TEST (TestImagerBase, SideEffectRegistersAreNotRewritten)
+{
+    auto bridge = std::make_shared<CostedBridgeImager> (BridgeImagerTransactionCost::usbControl());
+    TrackingImager imager (bridge, { UNUSED_TRIGGER_REGISTER, 0x9805 });
+
+    imager.writeChanges (initialConfig());
+    bridge->resetCounters();
+
+    imager.writeChanges (sparseChange());
+
+    // The gap at 0x9805 splits the change in to two bursts
+    EXPECT_EQ (2u, bridge->m_transactions);
+    EXPECT_EQ (14u, bridge->m_registersWritten);
+
+    // Explicitly changing the side-effect register writes it
+    bridge->resetCounters();
+    imager.writeChanges ({ { 0x9804, 0x404 }, { 0x9805, 0x405 }, { 0x9806, 0x406 } });
+    EXPECT_EQ (1u, bridge->m_transactions);
+    EXPECT_EQ (0x405, bridge->m_registers.at (0x9805));
+}
+
+TEST (TestImagerBase, NoGapFillingWithoutCostModel)
+{
+    // UVC and Amundsen bridges don't report their costs, their writes must not change
+    auto bridge = std::make_shared<CountingBridgeImager>();
+    TrackingImager imager (bridge);
+
+    imager.writeChanges (initialConfig());
+    bridge->resetCounters();
+
+    imager.writeChanges (sparseChange());
+    EXPECT_EQ (sparseChange().size(), bridge->m_transactions);
+    EXPECT_EQ (sparseChange().size(), bridge->m_registersWritten);
+}
+
+TEST (TestImagerBase, NoGapFillingWithoutSideEffectList)
+{
+    // An imager which doesn't list its side-effect registers might have registers in the gap
+    // that the firmware changes, so the cached values can't be written back
+    auto bridge = std::make_shared<CostedBridgeImager> (BridgeImagerTransactionCost::usbControl());
+    TrackingImager imager (bridge, {});
+
+    imager.writeChanges (initialConfig());
+    bridge->resetCounters();
+
+    imager.writeChanges (sparseChange());
+    EXPECT_EQ (sparseChange().size(), bridge->m_transactions);
+    EXPECT_EQ (sparseChange().size(), bridge->m_registersWritten);
+}
@@ -792,3 +792,61 @@ TEST_F (TestImagerM2452, UseCaseArbitraryPhase)
 
     ASSERT_NO_THROW (m_imager->executeUseCase (royale::factory::ImagerUseCaseDefinitionAdapter (simple, 0, 0, 0)));
 }
+
+TEST_F (TestImagerM2452, GapFillingKeepsTheRegisterState)
+{
+    // An imager whose bridge reports a high overhead for each transaction, so that ImagerBase
+    // rewrites short gaps between the changed registers instead of starting new bursts
+    auto fillingBridge = std::make_shared<StubBridgeImager> (std::unique_ptr<SimImagerM2452> (new SimImagerM2452 (imagerDesignStep)));
+    fillingBridge->setTransactionCost (royale::hal::BridgeImagerTransactionCost::usbControl());
+    ImagerParameters params{ fillingBridge, nullptr, true,
+                             royale::config::ImConnectedTemperatureSensor::NONE,
+                             ImgTrigger::I2C, ImgImageDataTransferType::MIPI_2LANE, 0.0000006f, {},
+                             SYSFREQ, ImagerRawFrame::ImagerDutyCycle::DC_50,
+                             ImgIlluminationPad::SE_P, 99900000, false };
+    ImagerM2452_Type fillingImager (params);
+    ASSERT_NO_THROW (fillingImager.sleep());
+    ASSERT_NO_THROW (fillingImager.wake());
+
+    UseCaseForM2452 ucs;
+    ASSERT_NO_THROW (m_imager->initialize());
+    ASSERT_NO_THROW (m_imager->executeUseCase (ucs));
+    ASSERT_NO_THROW (fillingImager.initialize());
+    ASSERT_NO_THROW (fillingImager.executeUseCase (ucs));
+
+    const auto initialState = fillingBridge->getWrittenRegisters();
+    ASSERT_EQ (m_bridge->getWrittenRegisters(), initialState);
+
+    UseCaseROIValid2 otherUcs;
+    otherUcs.setExposureTime (101);
+    m_bridge->clearRegisters();
+    m_bridge->resetRegisterCalls();
+    fillingBridge->clearRegisters();
+    fillingBridge->resetRegisterCalls();
+    ASSERT_NO_THROW (m_imager->executeUseCase (otherUcs));
+    ASSERT_NO_THROW (fillingImager.executeUseCase (otherUcs));
+
+    const auto changed = m_bridge->getWrittenRegisters();
+    const auto written = fillingBridge->getWrittenRegisters();
+
+    // Every changed register has been written with the same value, and every other register that
+    // was written still has the value it had before
+    for (const auto &reg : changed)
+    {
+        ASSERT_TRUE (written.count (reg.first) > 0);
+        EXPECT_EQ (reg.second, written.at (reg.first));
+    }
+    for (const auto &reg : written)
+    {
+        if (changed.count (reg.first) == 0)
+        {
+            ASSERT_TRUE (initialState.count (reg.first) > 0);
+            EXPECT_EQ (initialState.at (reg.first), reg.second);
+            EXPECT_NE (CFGCNT_TRIG, reg.first);
+            EXPECT_NE (MTCU_STATUS, reg.first);
+        }
+    }
+
+    EXPECT_GT (written.size(), changed.size());
+    EXPECT_LT (fillingBridge->registerCalls(), m_bridge->registerCalls());
+}
@@ -168,7 +168,8 @@ TEST (TestImagerRegisterAccess, PollSucceedsFirstTime)
 TEST (TestImagerRegisterAccess, PollSucceedsSecondTime)
 {
     const auto firstSleep = std::chrono::microseconds (3);
-    const auto pollSleep = std::chrono::microseconds (7);
+    const auto pollSleep = std::chrono::microseconds (80);
+    const auto firstPollSleep = std::chrono::microseconds (10);
     const auto valFinished = uint16_t {31};
     auto bridge = std::make_shared<MockBridgeImager> ();
     EXPECT_CALL (*bridge, setImagerReset (_)).Times (0);
@@ -181,7 +182,7 @@ TEST (TestImagerRegisterAccess, PollSucceedsSecondTime)
     InSequence inSequence;
     EXPECT_CALL (*bridge, sleepFor (firstSleep)).Times (1);
     EXPECT_CALL (*bridge, readImagerRegister (0xA000, _)).WillOnce (SetArgReferee<1> (uint16_t{1}));
-    EXPECT_CALL (*bridge, sleepFor (pollSleep)).Times (1);
+    EXPECT_CALL (*bridge, sleepFor (firstPollSleep)).Times (1);
     EXPECT_CALL (*bridge, readImagerRegister (0xA000, _)).WillRepeatedly (SetArgReferee<1> (valFinished));
 
     ImagerRegisterAccess access {bridge};
@@ -191,7 +192,7 @@ TEST (TestImagerRegisterAccess, PollSucceedsSecondTime)
 TEST (TestImagerRegisterAccess, PollTimesOut)
 {
     const auto firstSleep = std::chrono::microseconds (3);
-    const auto pollSleep = std::chrono::microseconds (7);
+    const auto pollSleep = std::chrono::microseconds (80);
     const auto valFinished = uint16_t {0};
     auto bridge = std::make_shared<MockBridgeImager> ();
     EXPECT_CALL (*bridge, setImagerReset (_)).Times (0);
@@ -202,16 +203,13 @@ TEST (TestImagerRegisterAccess, PollTimesOut)
     Sequence pollSequence;
     EXPECT_CALL (*bridge, sleepFor (firstSleep)).InSequence (pollSequence);
     EXPECT_CALL (*bridge, readImagerRegister (0xA000, _)).InSequence (pollSequence).WillOnce (SetArgReferee<1> (uint16_t{1}));
-    EXPECT_CALL (*bridge, sleepFor (pollSleep)).InSequence (pollSequence);
-    EXPECT_CALL (*bridge, readImagerRegister (0xA000, _)).InSequence (pollSequence).WillOnce (SetArgReferee<1> (uint16_t{1}));
-    EXPECT_CALL (*bridge, sleepFor (pollSleep)).InSequence (pollSequence);
-    EXPECT_CALL (*bridge, readImagerRegister (0xA000, _)).InSequence (pollSequence).WillOnce (SetArgReferee<1> (uint16_t{1}));
-    EXPECT_CALL (*bridge, sleepFor (pollSleep)).InSequence (pollSequence);
-    EXPECT_CALL (*bridge, readImagerRegister (0xA000, _)).InSequence (pollSequence).WillOnce (SetArgReferee<1> (uint16_t{1}));
-    EXPECT_CALL (*bridge, sleepFor (pollSleep)).InSequence (pollSequence);
-    EXPECT_CALL (*bridge, readImagerRegister (0xA000, _)).InSequence (pollSequence).WillOnce (SetArgReferee<1> (uint16_t{1}));
-    // This hardcodes the exact number of retries, and will break if ImagerRegisterAccess's
-    // MAX_POLL_RETRIES changes.
+    // This hardcodes the backoff, and will break if ImagerRegisterAccess's MAX_POLL_RETRIES or
+    // POLL_BACKOFF_DIVISOR change. The sleeps add up to MAX_POLL_RETRIES * pollSleep.
+    for (const auto sleep : { 10, 20, 40, 80, 80, 80, 10 })
+    {
+        EXPECT_CALL (*bridge, sleepFor (std::chrono::microseconds (sleep))).InSequence (pollSequence);
+        EXPECT_CALL (*bridge, readImagerRegister (0xA000, _)).InSequence (pollSequence).WillOnce (SetArgReferee<1> (uint16_t{1}));
+    }
 
     ImagerRegisterAccess access {bridge};
     EXPECT_THROW (access.pollUntil (0xA000, valFinished, firstSleep, pollSleep), Timeout);
@@ -0,0 +1,180 @@
+/****************************************************************************\
+* Copyright (C) 2019 pmdtechnologies ag
+*
+* THIS CODE AND INFORMATION ARE PROVIDED "AS IS" WITHOUT WARRANTY OF ANY
+* KIND, EITHER EXPRESSED OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE
+* IMPLIED WARRANTIES OF MERCHANTABILITY AND/OR FITNESS FOR A
+* PARTICULAR PURPOSE.
+*
+\****************************************************************************/
+
+#include <gtest/gtest.h>
+#include <StubBridgeImager.hpp>
+#include <SimImagerM2452.hpp>
+#include <TestImagerCommon.hpp>
+#include <imager/ImagerM2452_B1x_AIO.hpp>
+#include <imager/M2452/ImagerRegisters.hpp>
+
+#include <cstdio>
+#include <memory>
+#include <sstream>
+
+using namespace royale::imager;
+using namespace royale::stub;
+
+namespace
+{
+    const uint32_t SYSFREQ = 24000000;
+    const char *CACHE_FILE = "TestImagerUseCaseCache.bin";
+
+    /**
+    * Counts how often the register configuration is really calculated.
+    */
+    class CountingImager : public ImagerM2452_B1x_AIO
+    {
+    public:
+        explicit CountingImager (const ImagerParameters &params) :
+            ImagerM2452_B1x_AIO (params),
+            m_prepareCount (0u)
+        {
+        }
+
+        std::size_t m_prepareCount;
+
+    protected:
+        std::map < uint16_t, uint16_t > prepareUseCase (const ImagerUseCaseDefinition &useCase) override
+        {
+            m_prepareCount++;
+            return ImagerM2452_B1x_AIO::prepareUseCase (useCase);
+        }
+    };
+
+    /**
+    * An imager with its own simulated hardware.
+    */
+    struct ImagerRig
+    {
+        explicit ImagerRig (bool enableCache, double interfaceDelay = 0.0000006,
+                            const std::map < uint16_t, uint16_t > &baseConfig = {})
+        {
+            bridge = std::make_shared<StubBridgeImager> (std::make_shared<SimImagerM2452> (0xB11), log);
+            ImagerParameters params{ bridge, nullptr, true,
+                                     royale::config::ImConnectedTemperatureSensor::NONE,
+                                     ImgTrigger::I2C, ImgImageDataTransferType::MIPI_2LANE, interfaceDelay, baseConfig,
+                                     SYSFREQ, ImagerRawFrame::ImagerDutyCycle::DC_50,
+                                     ImgIlluminationPad::SE_P, 90000000, false };
+            imager.reset (new CountingImager (params));
+            imager->setUseCaseCacheEnabled (enableCache);
+
+            imager->sleep();
+            imager->wake();
+            bridge->writeImagerRegister (M2452::ANAIP_DESIGNSTEP, 0x0B12);
+            imager->initialize();
+        }
+
+        std::map < uint16_t, uint16_t > execute (const ImagerUseCaseDefinition &useCase)
+        {
+            bridge->clearRegisters();
+            imager->executeUseCase (useCase);
+            return bridge->getWrittenRegisters();
+        }
+
+        std::stringstream log;
+        std::shared_ptr<StubBridgeImager> bridge;
+        std::unique_ptr<CountingImager> imager;
+    };
+
+    std::vector<ImagerUseCaseDefinition> switchingUseCases()
+    {
+        UseCaseCustomMM_M2452 mixedMode (5u, 6u, 135u, 135u, 80320000u, 60240000u, 20600000u, 135u);
+        mixedMode.setImage (32, 32);
+
+        ImagerUseCaseFourPhase shortRange (10u, 4, 200u, 80320000u, 60240000u, 100u, true);
+        shortRange.setImage (32, 32);
+
+        ImagerUseCaseFourPhase longRange (5u, 8, 2000u, 60240000u, 20600000u, 200u, true);
+        longRange.setImage (32, 32);
+
+        return { shortRange, longRange, mixedMode };
+    }
+}
+
+TEST (TestImagerUseCaseCache, CachedConfigurationMatchesCalculated)
+{
+    ImagerRig cached (true);
+    ImagerRig uncached (false);
+    const auto useCases = switchingUseCases();
+
+    // The first round fills the cache, the others should be served from it
+    for (auto round = 0; round < 3; round++)
+    {
+        for (const auto &useCase : useCases)
+        {
+            ASSERT_EQ (uncached.execute (useCase), cached.execute (useCase));
+        }
+    }
+
+    EXPECT_EQ (3u * useCases.size(), uncached.imager->m_prepareCount);
+    EXPECT_EQ (useCases.size(), cached.imager->m_prepareCount);
+
+    // The measurement block list must also be restored, reconfigure() relies on it
+    auto firstUseCase = useCases.front();
+    ASSERT_EQ (uncached.execute (firstUseCase), cached.execute (firstUseCase));
+    uncached.imager->startCapture();
+    cached.imager->startCapture();
+    uint16_t uncachedIndex, cachedIndex;
+    uncached.bridge->clearRegisters();
+    cached.bridge->clearRegisters();
+    uncached.imager->reconfigure (firstUseCase, uncachedIndex);
+    cached.imager->reconfigure (firstUseCase, cachedIndex);
+    EXPECT_EQ (uncached.bridge->getWrittenRegisters(), cached.bridge->getWrittenRegisters());
+}
+
+TEST (TestImagerUseCaseCache, DisablingTheCacheRecalculates)
+{
+    ImagerRig rig (true);
+    const auto useCases = switchingUseCases();
+
+    // The second execution starts with a different LUT assignment, so it has its own entry
+    rig.execute (useCases.at (0));
+    rig.execute (useCases.at (0));
+    rig.execute (useCases.at (0));
+    EXPECT_EQ (2u, rig.imager->m_prepareCount);
+
+    rig.imager->setUseCaseCacheEnabled (false);
+    rig.execute (useCases.at (0));
+    EXPECT_EQ (3u, rig.imager->m_prepareCount);
+}
+
+TEST (TestImagerUseCaseCache, SaveAndLoad)
+{
+    const auto useCases = switchingUseCases();
+    {
+        ImagerRig source (true);
+        for (const auto &useCase : useCases)
+        {
+            source.execute (useCase);
+        }
+        ASSERT_TRUE (source.imager->saveUseCaseCache (CACHE_FILE));
+    }
+
+    ImagerRig loaded (true);
+    ImagerRig uncached (false);
+    ASSERT_TRUE (loaded.imager->loadUseCaseCache (CACHE_FILE));
+    for (const auto &useCase : useCases)
+    {
+        ASSERT_EQ (uncached.execute (useCase), loaded.execute (useCase));
+    }
+    EXPECT_EQ (0u, loaded.imager->m_prepareCount);
+
+    // A different module configuration must not use the saved cache
+    ImagerRig otherModule (true, 0.0000008);
+    EXPECT_FALSE (otherModule.imager->loadUseCaseCache (CACHE_FILE));
+
+    // The module's base config changes the readout timing that the frame rate is calculated from
+    ImagerRig otherBaseConfig (true, 0.0000006, { { M2452::CFGCNT_ROS, 0x0540 } });
+    EXPECT_FALSE (otherBaseConfig.imager->loadUseCaseCache (CACHE_FILE));
+
+    std::remove (CACHE_FILE);
+    EXPECT_FALSE (otherModule.imager->loadUseCaseCache (CACHE_FILE));
+}
@@ -0,0 +1,149 @@
+/****************************************************************************\
+* Copyright (C) 2019 pmdtechnologies ag
+*
+* THIS CODE AND INFORMATION ARE PROVIDED "AS IS" WITHOUT WARRANTY OF ANY
+* KIND, EITHER EXPRESSED OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE
+* IMPLIED WARRANTIES OF MERCHANTABILITY AND/OR FITNESS FOR A
+* PARTICULAR PURPOSE.
+*
+\****************************************************************************/
+
+#include <gmock/gmock.h>
+
+#include <common/ICapturedRawFrame.hpp>
+#include <imager/M2450_A11/PseudoDataInterpreter.hpp>
+#include <imager/M2450_A12/PseudoDataInterpreter.hpp>
+#include <imager/M2450_A12/PseudoDataInterpreter_AIO.hpp>
+#include <imager/M2452/PseudoDataInterpreter.hpp>
+#include <imager/M2452/PseudoDataInterpreter_AIO.hpp>
+#include <imager/M2453/PseudoDataInterpreter.hpp>
+#include <imager/M2453/PseudoDataInterpreter_B11.hpp>
+#include <imager/M2455/PseudoDataInterpreter.hpp>
+#include <imager/M2457/PseudoDataInterpreter.hpp>
+#include <imager/M2457/PseudoDataInterpreter_IC.hpp>
+
+#include <memory>
+#include <vector>
+
+using namespace royale::common;
+using namespace royale::imager;
+
+namespace
+{
+    /**
+     * More than any of the interpreters read.  This doesn't use getRequiredImageWidth(), as
+     * M2452::PseudoDataInterpreter_AIO reads beyond it.
+     */
+    const std::size_t PSEUDO_DATA_SIZE = 256u;
+
+    class TpdiCapturedRawFrame : public ICapturedRawFrame
+    {
+    public:
+        explicit TpdiCapturedRawFrame (std::size_t size) :
+            m_buffer (size)
+        {
+        }
+
+        uint16_t *getImageData() override
+        {
+            throw NotImplemented ("not supported for this test");
+        }
+
+        const uint16_t *getPseudoData() const override
+        {
+            return m_buffer.data();
+        }
+
+        std::vector<uint16_t> m_buffer;
+    };
+
+    /**
+     * Compares decodeFields() with the individual getters.  The pseudo data is filled so that over
+     * all 0x10000 iterations every word takes every 16-bit value, with a different value in each
+     * word of the same frame.
+     */
+    void expectSameFields (const IPseudoDataInterpreter &interpreter)
+    {
+        TpdiCapturedRawFrame frame (PSEUDO_DATA_SIZE);
+        for (uint32_t value = 0; value < 0x10000u; ++value)
+        {
+            for (std::size_t i = 0; i < PSEUDO_DATA_SIZE; ++i)
+            {
+                // Multiplying by an odd number is a permutation of the 16-bit values
+                frame.m_buffer[i] = static_cast<uint16_t> (value * 0x9E37u + i * 0x3C6Fu);
+            }
+
+            PseudoDataFields fields;
+            interpreter.decodeFields (frame, fields);
+            uint32_t eyeError = 0u;
+            interpreter.getEyeSafetyError (frame, eyeError);
+
+            ASSERT_EQ (interpreter.getFrameNumber (frame), fields.frameNumber) << "value " << value;
+            ASSERT_EQ (interpreter.getReconfigIndex (frame), fields.reconfigIndex) << "value " << value;
+            ASSERT_EQ (interpreter.getSequenceIndex (frame), fields.sequenceIndex) << "value " << value;
+            ASSERT_EQ (eyeError, fields.eyeError) << "value " << value;
+        }
+    }
+}
+
+TEST (TestPseudoDataInterpreterDecodeFields, M2450)
+{
+    ASSERT_NO_FATAL_FAILURE (expectSameFields (M2450_A11::PseudoDataInterpreter {}));
+    ASSERT_NO_FATAL_FAILURE (expectSameFields (M2450_A12::PseudoDataInterpreter {}));
+    ASSERT_NO_FATAL_FAILURE (expectSameFields (M2450_A12::PseudoDataInterpreter_AIO {}));
+}
+
+TEST (TestPseudoDataInterpreterDecodeFields, M2452)
+{
+    ASSERT_NO_FATAL_FAILURE (expectSameFields (M2452::PseudoDataInterpreter {}));
+}
+
+TEST (TestPseudoDataInterpreterDecodeFields, M2452_AIO)
+{
+    // The getSequenceIndex of this interpreter logs each call, so this only checks a few values
+    M2452::PseudoDataInterpreter_AIO interpreter;
+    TpdiCapturedRawFrame frame (PSEUDO_DATA_SIZE);
+    for (uint32_t value = 0; value < 0x10000u; value += 0x1111u)
+    {
+        for (std::size_t i = 0; i < PSEUDO_DATA_SIZE; ++i)
+        {
+            frame.m_buffer[i] = static_cast<uint16_t> (value * 0x9E37u + i * 0x3C6Fu);
+        }
+
+        PseudoDataFields fields;
+        interpreter.decodeFields (frame, fields);
+        uint32_t eyeError = 0u;
+        interpreter.getEyeSafetyError (frame, eyeError);
+
+        EXPECT_EQ (interpreter.getFrameNumber (frame), fields.frameNumber);
+        EXPECT_EQ (interpreter.getReconfigIndex (frame), fields.reconfigIndex);
+        EXPECT_EQ (interpreter.getSequenceIndex (frame), fields.sequenceIndex);
+        EXPECT_EQ (eyeError, fields.eyeError);
+    }
+}
+
+TEST (TestPseudoDataInterpreterDecodeFields, M2453)
+{
+    for (const auto currentMonitor : {false, true})
+    {
+        ASSERT_NO_FATAL_FAILURE (expectSameFields (M2453_A11::PseudoDataInterpreter {currentMonitor}));
+        ASSERT_NO_FATAL_FAILURE (expectSameFields (M2453_B11::PseudoDataInterpreterB11 {currentMonitor}));
+    }
+}
+
+TEST (TestPseudoDataInterpreterDecodeFields, M2455)
+{
+    for (const auto currentMonitor : {false, true})
+    {
+        ASSERT_NO_FATAL_FAILURE (expectSameFields (M2455::PseudoDataInterpreter {currentMonitor}));
+    }
+}
+
+TEST (TestPseudoDataInterpreterDecodeFields, M2457)
+{
+    for (const auto currentMonitor : {false, true})
+    {
+        ASSERT_NO_FATAL_FAILURE (expectSameFields (M2457::PseudoDataInterpreter {currentMonitor}));
+        ASSERT_NO_FATAL_FAILURE (expectSameFields (M2457::PseudoDataInterpreter_IC {currentMonitor}));
+    }
+}
@@ -10,6 +10,7 @@
 
 #pragma once
 
+#include <atomic>
 #include <cstdint>
 #include <memory>
 #include <vector>
@@ -124,18 +125,27 @@ namespace royale
             * @param depthData Depth data struct which should be filled
             * @param capturedTimes Only the exposure times relevant for this stream
             * @param newExposureTimes New exposure times returned from the auto exposure
+            * @param outputDemand OutputDemand bits of the outputs in depthData that have to be
+            *        filled, the others can be left unchanged
             */
             virtual void processFrame (std::vector<royale::common::ICapturedRawFrame *> &frames,
                                        std::unique_ptr<const royale::collector::CapturedUseCase> capturedCase,
                                        const DepthDataItem &depthData,
                                        const royale::Vector<uint32_t> &capturedTimes,
-                                       std::vector<uint32_t> &newExposureTimes) = 0;
+                                       std::vector<uint32_t> &newExposureTimes,
+                                       uint32_t outputDemand) = 0;
 
             /**
             * Listeners
             */
             DataListeners m_listeners;
 
+            /**
+            * m_listeners.outputDemand(), updated in registerDataListeners.  captureCallback reads
+            * it once per frame, so that the listeners can change while capturing.
+            */
+            std::atomic<uint32_t> m_outputDemand;
+
             /**
             * ExposureListener queue.
             */
@@ -191,7 +201,10 @@ namespace royale
             royale::IEventListener *m_eventListener;
             std::mutex m_eventMutex;
 
-            bool m_processingActivated;
+            /**
+            * Set by setProcessingActivated, which may be called while capturing
+            */
+            std::atomic<bool> m_processingActivated;
         };
     }
 }
@@ -76,7 +76,8 @@ namespace royale
                                std::unique_ptr<const royale::collector::CapturedUseCase> capturedCase,
                                const DepthDataItem &depthData,
                                const royale::Vector<uint32_t> &capturedTimes,
-                               std::vector<uint32_t> &newExposureTimes) override;
+                               std::vector<uint32_t> &newExposureTimes,
+                               uint32_t outputDemand) override;
 
             virtual void getLensCenterCalibration (uint16_t &centerX, uint16_t &centerY) override;
 
@@ -75,7 +75,8 @@ namespace royale
                                std::unique_ptr<const royale::collector::CapturedUseCase> capturedCase,
                                const DepthDataItem &depthData,
                                const royale::Vector<uint32_t> &capturedTimes,
-                               std::vector<uint32_t> &newExposureTimes) override;
+                               std::vector<uint32_t> &newExposureTimes,
+                               uint32_t outputDemand) override;
 
             virtual bool hasLensCenterCalibration() const override;
 
@@ -83,31 +84,63 @@ namespace royale
 
             virtual void getLensParameters (royale::LensParameters &params) override;
 
+            /**
+            * The Spectre results of the current frame.  Only the results which are needed for the
+            * demanded outputs are fetched, the others are left empty.
+            */
+            struct FrameResults
+            {
+                spectre::common::ArrayReference<float> coord3d;
+                spectre::common::ArrayReference<float> amplitudes;
+                spectre::common::ArrayReference<float> distanceNoises;
+                spectre::common::ArrayReference<uint32_t> flags;
+                spectre::common::ArrayReference<float> intensities;
+                spectre::common::ArrayReference<float> distances;
+                /// ProcessingFlag::NoiseThreshold_Float of the stream
+                float noiseThreshold = 0.0f;
+                /// ProcessingFlag::UseValidateImage_Bool of the stream
+                bool validateImage = false;
+            };
+
+            /**
+            * Fetches the results needed for the outputs in outputDemand.
+            */
+            void fetchResults (FrameResults &results, spectre::ISpectre &spectre,
+                               const royale::StreamId streamId, uint32_t outputDemand);
+
             /**
             * Fills the output struct.
             * @param target Depth data output
+            * @param results coordinates, amplitudes and distance noises of the current frame
             * @param streamId ID of the current stream
             */
-            void prepareDepthDataOutput (royale::DepthData *target, const royale::StreamId streamId);
+            void prepareDepthDataOutput (royale::DepthData *target, const FrameResults &results,
+                                         const royale::StreamId streamId);
 
-            void doPrepareDepthImage (const spectre::common::ArrayReference<float> &outCoord3d,
-                                      const spectre::common::ArrayReference<float> &outNoise,
-                                      const float noiseThreshold,
-                                      const spectre::common::ArrayReference<uint32_t> &outFlags,
-                                      royale::Vector<uint16_t> &data, const royale::StreamId streamId);
+            void doPrepareDepthImage (const FrameResults &results, royale::Vector<uint16_t> &data);
 
-            void prepareDepthImage (royale::DepthImage *target, const royale::StreamId streamId);
-            void prepareSparsePointCloud (royale::SparsePointCloud *target, const royale::StreamId streamId);
+            void prepareDepthImage (royale::DepthImage *target, const FrameResults &results, const royale::StreamId streamId);
+            void prepareSparsePointCloud (royale::SparsePointCloud *target, const FrameResults &results, const royale::StreamId streamId);
             void doPrepareIRImage (const spectre::common::ArrayReference<float> &outAmplitude, royale::Vector<uint8_t> &data);
-            void prepareIRImage (royale::IRImage *target, const royale::StreamId streamId);
-            void prepareDepthIRImage (royale::DepthIRImage *target, const royale::StreamId streamId);
+            void prepareIRImage (royale::IRImage *target, const FrameResults &results, const royale::StreamId streamId);
+
+            /**
+            * Fills the DepthIRImage.  If depthImage or irImage are not nullptr, they already contain
+            * the same frame and their data is copied instead of converting the results again.
+            */
+            void prepareDepthIRImage (royale::DepthIRImage *target, const FrameResults &results,
+                                      const royale::StreamId streamId,
+                                      const royale::DepthImage *depthImage,
+                                      const royale::IRImage *irImage);
 
             /**
             * Fills the intermediate output struct.
             * @param intermediateData Intermediate data output
+            * @param results flags, intensities, distances and amplitudes of the current frame
             * @param streamId ID of the current stream
             */
-            void prepareIntermediateOutput (royale::IntermediateData *intermediateData, const royale::StreamId streamId);
+            void prepareIntermediateOutput (royale::IntermediateData *intermediateData, const FrameResults &results,
+                                            const royale::StreamId streamId);
 
             royale::String getProcessingName() override;
             royale::String getProcessingVersion() override;
@@ -160,8 +193,6 @@ namespace royale
 
             inline uint8_t amplitudeToIRValue (float a);
 
-            inline bool useValidateImageActivated (const royale::StreamId streamId);
-
             /**
              * @brief Gets the SpectreInstanceInfo associated to the given StreamId.
              *
@@ -15,6 +15,7 @@
 #include <common/exceptions/RuntimeError.hpp>
 #include <common/MakeUnique.hpp>
 #include <common/RoyaleLogger.hpp>
+#include <common/RoyaleTrace.hpp>
 
 #include <algorithm>
 
@@ -27,7 +28,8 @@ using namespace royale;
 
 Processing::Processing (IFrameCaptureReleaser *releaser,
                         IRefineExposureTime *refineExposureTime)
-    : m_exposureListener (nullptr),
+    : m_outputDemand (OUTPUT_NONE),
+      m_exposureListener (nullptr),
       m_releaser (releaser),
       m_refineExposureTime (refineExposureTime),
       m_eventListener (nullptr),
@@ -46,12 +48,11 @@ void Processing::captureCallback (std::vector<ICapturedRawFrame *> &frames,
                                   royale::StreamId streamId,
                                   std::unique_ptr<const CapturedUseCase> capturedCase)
 {
-    if (!m_listeners.depthDataListener &&
-            !m_listeners.depthImageListener &&
-            !m_listeners.sparsePointCloudListener &&
-            !m_listeners.irImageListener &&
-            !m_listeners.depthIrImageListener &&
-            !m_listeners.extendedListener)
+    ROYALE_TRACE_ZONE ("Processing::captureCallback");
+    // The outputs for the listeners at the start of the frame are computed, listeners which are
+    // registered later in this frame are called from the next frame on
+    const uint32_t outputDemand = m_outputDemand;
+    if (outputDemand == OUTPUT_NONE)
     {
         m_releaser->releaseCapturedFrames (frames);
         return;
@@ -69,6 +70,7 @@ void Processing::captureCallback (std::vector<ICapturedRawFrame *> &frames,
     // We have to transform them back to raw frame set order and only use the ones for the
     // current stream.
     royale::Vector<uint32_t> capturedTimes;
+    capturedTimes.reserve (expoGroupIndices.size());
     for (auto expoIdx : expoGroupIndices)
     {
         capturedTimes.push_back (expTimes[expoIdx]);
@@ -76,18 +78,18 @@ void Processing::captureCallback (std::vector<ICapturedRawFrame *> &frames,
 
     m_depthDataBuffer.depthData->exposureTimes = capturedTimes; // copy exposureTimes
 
-    const auto &rawFrameSets = definition.getRawFrameSets();
-
-    royale::Vector<uint32_t> modulationFrequencies;
-    const auto &frameSetIdxs = definition.getRawFrameSetIndices (streamId, 0);
-    for (const auto frameSetIdx : frameSetIdxs)
+    if (outputDemand & OUTPUT_RAW_DATA)
     {
-        const auto &rawFrameSet = rawFrameSets.at (frameSetIdx);
-        modulationFrequencies.push_back (rawFrameSet.modulationFrequency);
-    }
+        const auto &rawFrameSets = definition.getRawFrameSets();
+
+        royale::Vector<uint32_t> modulationFrequencies;
+        const auto &frameSetIdxs = definition.getRawFrameSetIndices (streamId, 0);
+        for (const auto frameSetIdx : frameSetIdxs)
+        {
+            const auto &rawFrameSet = rawFrameSets.at (frameSetIdx);
+            modulationFrequencies.push_back (rawFrameSet.modulationFrequency);
+        }
 
-    if (m_listeners.extendedListener)
-    {
         definition.getImage (m_depthDataBuffer.rawData->width, m_depthDataBuffer.rawData->height);
         m_depthDataBuffer.rawData->rawData.resize (frames.size());
         m_depthDataBuffer.rawData->illuminationTemperature = capturedCase->getIlluminationTemperature();
@@ -140,7 +142,9 @@ void Processing::captureCallback (std::vector<ICapturedRawFrame *> &frames,
         std::lock_guard<std::mutex> lock (m_calcMutex);
         try
         {
-            processFrame (frames, std::move (capturedCase), m_depthDataBuffer, capturedTimes, newExposureTimes);
+            ROYALE_TRACE_ZONE ("Processing::processFrame");
+            processFrame (frames, std::move (capturedCase), m_depthDataBuffer, capturedTimes, newExposureTimes,
+                          outputDemand);
             dataWasProcessed = true;
         }
         catch (...)
@@ -151,16 +155,21 @@ void Processing::captureCallback (std::vector<ICapturedRawFrame *> &frames,
 
     {
         std::lock_guard<std::mutex> lock (m_listenerMutex);
+        ROYALE_TRACE_ZONE ("Processing::listeners");
 
         if (m_listeners.extendedListener)
         {
-            if (dataWasProcessed)
+            // If the extended listener was registered during this frame, there's no raw data
+            if (outputDemand & OUTPUT_RAW_DATA)
             {
-                m_depthDataBuffer.extendedData->setDepthData (m_depthDataBuffer.depthData.get());
-                m_depthDataBuffer.extendedData->setIntermediateData (m_depthDataBuffer.intermediateData.get());
+                if (dataWasProcessed)
+                {
+                    m_depthDataBuffer.extendedData->setDepthData (m_depthDataBuffer.depthData.get());
+                    m_depthDataBuffer.extendedData->setIntermediateData (m_depthDataBuffer.intermediateData.get());
+                }
+                m_depthDataBuffer.extendedData->setRawData (m_depthDataBuffer.rawData.get());
+                m_listeners.extendedListener->onNewData (m_depthDataBuffer.extendedData.get());
             }
-            m_depthDataBuffer.extendedData->setRawData (m_depthDataBuffer.rawData.get());
-            m_listeners.extendedListener->onNewData (m_depthDataBuffer.extendedData.get());
 
             m_releaser->releaseCapturedFrames (frames);
         }
@@ -170,23 +179,23 @@ void Processing::captureCallback (std::vector<ICapturedRawFrame *> &frames,
 
             if (dataWasProcessed)
             {
-                if (m_listeners.depthDataListener)
+                if (m_listeners.depthDataListener && (outputDemand & OUTPUT_DEPTH_DATA))
                 {
                     m_listeners.depthDataListener->onNewData (m_depthDataBuffer.depthData.get());
                 }
-                if (m_listeners.depthImageListener)
+                if (m_listeners.depthImageListener && (outputDemand & OUTPUT_DEPTH_IMAGE))
                 {
                     m_listeners.depthImageListener->onNewData (m_depthDataBuffer.depthImage.get());
                 }
-                if (m_listeners.sparsePointCloudListener)
+                if (m_listeners.sparsePointCloudListener && (outputDemand & OUTPUT_SPARSE_POINT_CLOUD))
                 {
                     m_listeners.sparsePointCloudListener->onNewData (m_depthDataBuffer.sparsePointCloud.get());
                 }
-                if (m_listeners.irImageListener)
+                if (m_listeners.irImageListener && (outputDemand & OUTPUT_IR_IMAGE))
                 {
                     m_listeners.irImageListener->onNewData (m_depthDataBuffer.irImage.get());
                 }
-                if (m_listeners.depthIrImageListener)
+                if (m_listeners.depthIrImageListener && (outputDemand & OUTPUT_DEPTH_IR_IMAGE))
                 {
                     m_listeners.depthIrImageListener->onNewData (m_depthDataBuffer.depthIrImage.get());
                 }
@@ -319,6 +328,7 @@ void Processing::registerDataListeners (const DataListeners &listeners)
 {
     std::lock_guard<std::mutex> lock (m_listenerMutex);
     m_listeners = listeners;
+    m_outputDemand = listeners.outputDemand();
 }
 
 uint32_t Processing::getRefinedExposureTime (const uint32_t exposureTime,
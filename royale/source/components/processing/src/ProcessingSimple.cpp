@@ -62,11 +62,11 @@ void ProcessingSimple::processFrame (std::vector<ICapturedRawFrame *> &frames,
                                      std::unique_ptr<const CapturedUseCase> capturedCase,
                                      const DepthDataItem &depthData,
                                      const royale::Vector<uint32_t> &capturedTimes,
-                                     std::vector<uint32_t> &newExposureTimes)
+                                     std::vector<uint32_t> &newExposureTimes,
+                                     uint32_t outputDemand)
 {
     std::lock_guard<std::mutex> lock (m_lock);
 
-
     // Calculate image
     depthData.depthData->timeStamp = capturedCase->getTimestamp();
     depthData.depthData->streamId = depthData.streamId;
@@ -74,6 +74,13 @@ void ProcessingSimple::processFrame (std::vector<ICapturedRawFrame *> &frames,
     depthData.depthData->width = m_currentWidth;
     depthData.depthData->height = m_currentHeight;
     depthData.depthData->exposureTimes = capturedTimes;
+
+    // This only calculates the DepthData, the other outputs aren't supported
+    if (! (outputDemand & OUTPUT_DEPTH_DATA))
+    {
+        return;
+    }
+
     auto block = depthData.depthData->width * depthData.depthData->height;
     depthData.depthData->points.resize (block);
 
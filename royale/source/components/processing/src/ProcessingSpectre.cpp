@@ -27,6 +27,7 @@
 #include <common/exceptions/RuntimeError.hpp>
 #include <RoyaleLogger.hpp>
 #include <RoyaleTime.hpp>
+#include <RoyaleTrace.hpp>
 
 #include <FileSystem.hpp>
 
@@ -278,7 +279,8 @@ void ProcessingSpectre::processFrame (std::vector<ICapturedRawFrame *> &frames,
                                       std::unique_ptr<const CapturedUseCase> capturedCase,
                                       const DepthDataItem &depthData,
                                       const royale::Vector<uint32_t> &capturedTimes,
-                                      std::vector<uint32_t> &newExposureTimes)
+                                      std::vector<uint32_t> &newExposureTimes,
+                                      uint32_t outputDemand)
 {
     std::lock_guard<std::recursive_mutex> lock (m_lock);
 
@@ -323,43 +325,89 @@ void ProcessingSpectre::processFrame (std::vector<ICapturedRawFrame *> &frames,
     // Run Spectre
     {
         ADD_TIME_MEASUREMENT (SpectreProcessing)
+        ROYALE_TRACE_ZONE ("Spectre::processWhole");
         auto spectreStatus = spectreInfo.spectre->processWhole (input);
         if (!spectreStatus)
         {
             throw RuntimeError ("Error running Spectre");
         }
     }
-    newExposureTimes = std::vector<uint32_t> (spectreInfo.spectre->results<ResultType::EXPOSURE_TIMES>().data(),
-                       spectreInfo.spectre->results<ResultType::EXPOSURE_TIMES>().data() + spectreInfo.spectre->results<ResultType::EXPOSURE_TIMES>().size());
+    const auto exposureTimes = spectreInfo.spectre->results<ResultType::EXPOSURE_TIMES>();
+    newExposureTimes.assign (exposureTimes.data(), exposureTimes.data() + exposureTimes.size());
 
-    // Fill the output struct
-    if (m_listeners.extendedListener)
+    // Fill the output structs, only the results needed for them are fetched
+    ROYALE_TRACE_ZONE ("Spectre::output");
+    FrameResults results;
+    fetchResults (results, *spectreInfo.spectre, depthData.streamId, outputDemand);
+
+    if (outputDemand & OUTPUT_INTERMEDIATE_DATA)
     {
-        prepareIntermediateOutput (depthData.intermediateData.get(), depthData.streamId);
-        prepareDepthDataOutput (depthData.depthData.get(), depthData.streamId);
+        prepareIntermediateOutput (depthData.intermediateData.get(), results, depthData.streamId);
     }
-    else
+    if (outputDemand & OUTPUT_DEPTH_DATA)
     {
-        if (m_listeners.depthDataListener)
-        {
-            prepareDepthDataOutput (depthData.depthData.get(), depthData.streamId);
-        }
-        if (m_listeners.depthImageListener)
-        {
-            prepareDepthImage (depthData.depthImage.get(), depthData.streamId);
-        }
-        if (m_listeners.sparsePointCloudListener)
-        {
-            prepareSparsePointCloud (depthData.sparsePointCloud.get(), depthData.streamId);
-        }
-        if (m_listeners.irImageListener)
-        {
-            prepareIRImage (depthData.irImage.get(), depthData.streamId);
-        }
-        if (m_listeners.depthIrImageListener)
+        prepareDepthDataOutput (depthData.depthData.get(), results, depthData.streamId);
+    }
+    if (outputDemand & OUTPUT_DEPTH_IMAGE)
+    {
+        prepareDepthImage (depthData.depthImage.get(), results, depthData.streamId);
+    }
+    if (outputDemand & OUTPUT_SPARSE_POINT_CLOUD)
+    {
+        prepareSparsePointCloud (depthData.sparsePointCloud.get(), results, depthData.streamId);
+    }
+    if (outputDemand & OUTPUT_IR_IMAGE)
+    {
+        prepareIRImage (depthData.irImage.get(), results, depthData.streamId);
+    }
+    if (outputDemand & OUTPUT_DEPTH_IR_IMAGE)
+    {
+        prepareDepthIRImage (depthData.depthIrImage.get(), results, depthData.streamId,
+                             (outputDemand & OUTPUT_DEPTH_IMAGE) ? depthData.depthImage.get() : nullptr,
+                             (outputDemand & OUTPUT_IR_IMAGE) ? depthData.irImage.get() : nullptr);
+    }
+}
+
+void ProcessingSpectre::fetchResults (FrameResults &results, ISpectre &spectre,
+                                      const royale::StreamId streamId, uint32_t outputDemand)
+{
+    const uint32_t needsCoordinates = OUTPUT_DEPTH_DATA | OUTPUT_DEPTH_IMAGE | OUTPUT_SPARSE_POINT_CLOUD | OUTPUT_DEPTH_IR_IMAGE;
+    const uint32_t needsAmplitudes = OUTPUT_DEPTH_DATA | OUTPUT_INTERMEDIATE_DATA | OUTPUT_IR_IMAGE | OUTPUT_DEPTH_IR_IMAGE;
+    const uint32_t needsDistanceNoises = OUTPUT_DEPTH_DATA | OUTPUT_DEPTH_IMAGE | OUTPUT_DEPTH_IR_IMAGE;
+    const uint32_t needsFlags = OUTPUT_INTERMEDIATE_DATA | OUTPUT_DEPTH_IMAGE | OUTPUT_SPARSE_POINT_CLOUD | OUTPUT_DEPTH_IR_IMAGE;
+    const uint32_t needsParameters = OUTPUT_DEPTH_IMAGE | OUTPUT_SPARSE_POINT_CLOUD | OUTPUT_DEPTH_IR_IMAGE;
+
+    if (outputDemand & needsCoordinates)
+    {
+        results.coord3d = spectre.results<ResultType::COORDINATES>();
+    }
+    if (outputDemand & needsAmplitudes)
+    {
+        results.amplitudes = spectre.results<ResultType::AMPLITUDES>();
+    }
+    if (outputDemand & needsDistanceNoises)
+    {
+        results.distanceNoises = spectre.results<ResultType::DISTANCE_NOISES>();
+    }
+    if (outputDemand & needsFlags)
+    {
+        results.flags = spectre.results<ResultType::FLAGS>();
+    }
+    if (outputDemand & OUTPUT_INTERMEDIATE_DATA)
+    {
+        results.intensities = spectre.results<ResultType::INTENSITIES>();
+        results.distances = spectre.results<ResultType::DISTANCES>();
+    }
+    if (outputDemand & needsParameters)
+    {
+        // Looked up in place, instead of copying the whole map for each output
+        auto parameters = m_parameters.find (streamId);
+        if (parameters == m_parameters.end())
         {
-            prepareDepthIRImage (depthData.depthIrImage.get(), depthData.streamId);
+            throw InvalidValue ("StreamID not found!");
         }
+        results.noiseThreshold = parameters->second[ProcessingFlag::NoiseThreshold_Float].getFloat();
+        results.validateImage = parameters->second[ProcessingFlag::UseValidateImage_Bool].getBool();
     }
 }
 
@@ -640,12 +688,13 @@ void ProcessingSpectre::getLensParameters (LensParameters &params)
     }
 }
 
-void ProcessingSpectre::prepareDepthDataOutput (DepthData *target, const royale::StreamId streamId)
+void ProcessingSpectre::prepareDepthDataOutput (DepthData *target, const FrameResults &results,
+        const royale::StreamId streamId)
 {
     auto &spectre = *getSpectreForStream (streamId).spectre;
-    auto outCoord3d = spectre.results<ResultType::COORDINATES>();
-    auto outAmplitude = spectre.results<ResultType::AMPLITUDES>();
-    auto outDistanceNoise = spectre.results<ResultType::DISTANCE_NOISES>();
+    const auto &outCoord3d = results.coord3d;
+    const auto &outAmplitude = results.amplitudes;
+    const auto &outDistanceNoise = results.distanceNoises;
 
     target->streamId = streamId;
     target->version = 3;
@@ -654,7 +703,7 @@ void ProcessingSpectre::prepareDepthDataOutput (DepthData *target, const royale:
     target->timeStamp = m_timeStamp;
 
     uint32_t numPixels = target->height * target->width;
-    target->points.resize (numPixels);
+    target->points.resizeNoInit (numPixels);
 
     DepthPoint *targetPoint = &target->points[0];
     size_t idx = 0;
@@ -670,14 +719,15 @@ void ProcessingSpectre::prepareDepthDataOutput (DepthData *target, const royale:
     }
 }
 
-void ProcessingSpectre::prepareIntermediateOutput (IntermediateData *intermediateData, const royale::StreamId streamId)
+void ProcessingSpectre::prepareIntermediateOutput (IntermediateData *intermediateData, const FrameResults &results,
+        const royale::StreamId streamId)
 {
     auto &spectreInfo = getSpectreForStream (streamId);
     auto &spectre = *spectreInfo.spectre;
-    auto outFlags = spectre.results<ResultType::FLAGS>();
-    auto outIntensity = spectre.results<ResultType::INTENSITIES>();
-    auto outDistance = spectre.results<ResultType::DISTANCES>();
-    auto outAmplitude = spectre.results<ResultType::AMPLITUDES>();
+    const auto &outFlags = results.flags;
+    const auto &outIntensity = results.intensities;
+    const auto &outDistance = results.distances;
+    const auto &outAmplitude = results.amplitudes;
 
     intermediateData->streamId = streamId;
     intermediateData->version = 3;
@@ -695,7 +745,7 @@ void ProcessingSpectre::prepareIntermediateOutput (IntermediateData *intermediat
 
     uint32_t numPixels = intermediateData->height * intermediateData->width;
 
-    intermediateData->points.resize (numPixels);
+    intermediateData->points.resizeNoInit (numPixels);
 
     IntermediatePoint *targetPoint = &intermediateData->points[0];
 
@@ -719,15 +769,18 @@ inline uint16_t noiseToConfidence (const float noise, const float threshold)
     return ( (static_cast<uint16_t> (maxConfidenceValue) + 1) - scaledNoiseLevelClipped) & 0x07;
 }
 
-void ProcessingSpectre::doPrepareDepthImage (const ArrayReference<float> &outCoord3d, const ArrayReference<float> &outNoise,
-        const float noiseThreshold, const ArrayReference<uint32_t> &outFlags,
-        royale::Vector<uint16_t> &data, StreamId streamId)
+void ProcessingSpectre::doPrepareDepthImage (const FrameResults &results, royale::Vector<uint16_t> &data)
 {
+    const auto &outCoord3d = results.coord3d;
+    const auto &outNoise = results.distanceNoises;
+    const auto &outFlags = results.flags;
+    const float noiseThreshold = results.noiseThreshold;
+
     const uint16_t invalidPixel = (1 << 13);
     data.clear();
     data.reserve (outFlags.size());
 
-    bool validImage = useValidateImageActivated (streamId);
+    bool validImage = results.validateImage;
 
     for (auto i = 0u; i < outFlags.size(); ++i)
     {
@@ -744,33 +797,27 @@ void ProcessingSpectre::doPrepareDepthImage (const ArrayReference<float> &outCoo
     }
 }
 
-void ProcessingSpectre::prepareDepthImage (royale::DepthImage *target, const royale::StreamId streamId)
+void ProcessingSpectre::prepareDepthImage (royale::DepthImage *target, const FrameResults &results,
+        const royale::StreamId streamId)
 {
     auto &spectre = *getSpectreForStream (streamId).spectre;
-    auto outCoord3d = spectre.results<ResultType::COORDINATES>();
-    auto outFlags = spectre.results<ResultType::FLAGS>();
-    auto outNoise = spectre.results<ResultType::DISTANCE_NOISES>();
 
     target->width = narrow_cast<uint16_t> (spectre.getOutputWidth());
     target->height = narrow_cast<uint16_t> (spectre.getOutputHeight());
 
-    royale::ProcessingParameterMap params;
-    this->getProcessingParameters (params, streamId);
-    float noiseThreshold = params[ProcessingFlag::NoiseThreshold_Float].getFloat();
-
     target->streamId = streamId;
     target->timestamp = m_timeStamp.count();
 
-    doPrepareDepthImage (outCoord3d, outNoise, noiseThreshold, outFlags, target->cdData, streamId);
+    doPrepareDepthImage (results, target->cdData);
 }
 
-void ProcessingSpectre::prepareSparsePointCloud (royale::SparsePointCloud *target, const royale::StreamId streamId)
+void ProcessingSpectre::prepareSparsePointCloud (royale::SparsePointCloud *target, const FrameResults &results,
+        const royale::StreamId streamId)
 {
-    auto &spectre = *getSpectreForStream (streamId).spectre;
-    auto outCoord3d = spectre.results<ResultType::COORDINATES>();
-    auto outFlags = spectre.results<ResultType::FLAGS>();
+    const auto &outCoord3d = results.coord3d;
+    const auto &outFlags = results.flags;
 
-    bool validImage = useValidateImageActivated (streamId);
+    bool validImage = results.validateImage;
 
     target->streamId = streamId;
     target->xyzcPoints.clear();
@@ -810,45 +857,48 @@ void ProcessingSpectre::doPrepareIRImage (const ArrayReference<float> &outAmplit
     }
 }
 
-void ProcessingSpectre::prepareIRImage (royale::IRImage *target, const royale::StreamId streamId)
+void ProcessingSpectre::prepareIRImage (royale::IRImage *target, const FrameResults &results,
+                                        const royale::StreamId streamId)
 {
     auto &spectre = *getSpectreForStream (streamId).spectre;
-    auto outAmplitude = spectre.results<ResultType::AMPLITUDES>();
     target->width = narrow_cast<uint16_t> (spectre.getOutputWidth());
     target->height = narrow_cast<uint16_t> (spectre.getOutputHeight());
 
     target->streamId = streamId;
     target->timestamp = m_timeStamp.count();
 
-    doPrepareIRImage (outAmplitude, target->data);
+    doPrepareIRImage (results.amplitudes, target->data);
 }
 
-void ProcessingSpectre::prepareDepthIRImage (royale::DepthIRImage *target, const royale::StreamId streamId)
+void ProcessingSpectre::prepareDepthIRImage (royale::DepthIRImage *target, const FrameResults &results,
+        const royale::StreamId streamId,
+        const royale::DepthImage *depthImage,
+        const royale::IRImage *irImage)
 {
     auto &spectre = *getSpectreForStream (streamId).spectre;
-    auto outCoord3d = spectre.results<ResultType::COORDINATES>();
-    auto outFlags = spectre.results<ResultType::FLAGS>();
-    auto outNoise = spectre.results<ResultType::DISTANCE_NOISES>();
-    auto outAmplitude = spectre.results<ResultType::AMPLITUDES>();
 
     target->width = narrow_cast<uint16_t> (spectre.getOutputWidth());
     target->height = narrow_cast<uint16_t> (spectre.getOutputHeight());
     target->streamId = streamId;
     target->timestamp = m_timeStamp.count();
 
-    royale::ProcessingParameterMap params;
-    this->getProcessingParameters (params, streamId);
-    float noiseThreshold = params[ProcessingFlag::NoiseThreshold_Float].getFloat();
-
-    doPrepareIRImage (outAmplitude, target->irData);
-    doPrepareDepthImage (outCoord3d, outNoise, noiseThreshold, outFlags, target->dpData, streamId);
-}
+    if (irImage)
+    {
+        target->irData = irImage->data;
+    }
+    else
+    {
+        doPrepareIRImage (results.amplitudes, target->irData);
+    }
 
-inline bool ProcessingSpectre::useValidateImageActivated (StreamId streamId)
-{
-    royale::ProcessingParameterMap params;
-    this->getProcessingParameters (params, streamId);
-    return params[ProcessingFlag::UseValidateImage_Bool].getBool();
+    if (depthImage)
+    {
+        target->dpData = depthImage->cdData;
+    }
+    else
+    {
+        doPrepareDepthImage (results, target->dpData);
+    }
 }
 
 bool ProcessingSpectre::isReadyToProcessDepthData()
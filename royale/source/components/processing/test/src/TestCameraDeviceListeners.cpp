@@ -0,0 +1,328 @@
+/****************************************************************************\
+* Copyright (C) 2019 pmdtechnologies ag
+*
+* THIS CODE AND INFORMATION ARE PROVIDED "AS IS" WITHOUT WARRANTY OF ANY
+* KIND, EITHER EXPRESSED OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE
+* IMPLIED WARRANTIES OF MERCHANTABILITY AND/OR FITNESS FOR A
+* PARTICULAR PURPOSE.
+*
+\****************************************************************************/
+
+#include <processing/ProcessingSimple.hpp>
+
+#include <BufferGeneratorStub.hpp>
+#include <StubCoreConfig.hpp>
+#include <StubImager.hpp>
+#include <StubStorage.hpp>
+#include <StubTemperatureSensor.hpp>
+
+#include <common/MakeUnique.hpp>
+#include <device/CameraCore.hpp>
+#include <device/CameraDevice.hpp>
+#include <usecase/UseCaseFourPhase.hpp>
+
+#include <royale/DepthData.hpp>
+#include <royale/IExtendedData.hpp>
+#include <royale/IExtendedDataListener.hpp>
+
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <limits>
+#include <mutex>
+
+using namespace royale;
+using namespace royale::common;
+using namespace royale::processing;
+using namespace royale::stub::config;
+using namespace royale::stub::hal;
+using namespace royale::usecase;
+
+namespace
+{
+    /**
+     * Time to wait for a frame to pass through the FrameCollector and the processing
+     */
+    const auto TCDL_FRAME_TIMEOUT = std::chrono::seconds (2);
+
+    /**
+     * Bridge which delivers the frames of the BufferGeneratorStub, and counts how often the
+     * capturing is started and stopped.
+     */
+    class TcdlBridge : public BufferGeneratorStub
+    {
+    public:
+        void startCapture() override
+        {
+            ++m_startCount;
+        }
+        void stopCapture() override
+        {
+            ++m_stopCount;
+        }
+        bool isConnected() const override
+        {
+            return true;
+        }
+        float getPeakTransferSpeed() override
+        {
+            return std::numeric_limits<float>::infinity();
+        }
+        royale::Vector<royale::Pair<royale::String, royale::String>> getBridgeInfo() override
+        {
+            return {};
+        }
+        void setEventListener (royale::IEventListener *listener) override
+        {
+        }
+
+        std::atomic<std::size_t> m_startCount {0u};
+        std::atomic<std::size_t> m_stopCount {0u};
+    };
+
+    /**
+     * Imager which sets up the TcdlBridge to generate the frames of each use case
+     */
+    class TcdlImager : public StubImager
+    {
+    public:
+        explicit TcdlImager (std::shared_ptr<TcdlBridge> bridge) :
+            m_bridge (bridge)
+        {
+        }
+
+        void executeUseCase (const UseCaseDefinition &useCase, uint16_t roiCMin, uint16_t roiRMin, uint16_t flowControlRate) override
+        {
+            StubImager::executeUseCase (useCase, roiCMin, roiRMin, flowControlRate);
+            m_bridge->configureFromUseCase (&useCase, getMeasurementBlockSizes());
+        }
+
+        std::unique_ptr<IPseudoDataInterpreter> createPseudoDataInterpreter() override
+        {
+            return m_bridge->createInterpreter();
+        }
+
+    private:
+        std::shared_ptr<TcdlBridge> m_bridge;
+    };
+
+    /**
+     * Counts the callbacks from the processing, for the extended data it also records which
+     * parts were included.
+     */
+    class TcdlListener : public IDepthDataListener, public IExtendedDataListener
+    {
+    public:
+        void onNewData (const DepthData *data) override
+        {
+            std::lock_guard<std::mutex> lock (m_lock);
+            ++m_depthFrames;
+            m_cond.notify_all();
+        }
+
+        void onNewData (const IExtendedData *data) override
+        {
+            std::lock_guard<std::mutex> lock (m_lock);
+            ++m_extendedFrames;
+            m_lastHadRawData = data->hasRawData();
+            m_cond.notify_all();
+        }
+
+        /**
+         * Waits until the total number of callbacks (of either type) reaches the given count
+         */
+        bool waitForFrames (std::size_t count)
+        {
+            std::unique_lock<std::mutex> lock (m_lock);
+            return m_cond.wait_for (lock, TCDL_FRAME_TIMEOUT, [this, count]
+            {
+                return m_depthFrames + m_extendedFrames >= count;
+            });
+        }
+
+        std::size_t depthFrames()
+        {
+            std::lock_guard<std::mutex> lock (m_lock);
+            return m_depthFrames;
+        }
+
+        std::size_t extendedFrames()
+        {
+            std::lock_guard<std::mutex> lock (m_lock);
+            return m_extendedFrames;
+        }
+
+        bool lastHadRawData()
+        {
+            std::lock_guard<std::mutex> lock (m_lock);
+            return m_lastHadRawData;
+        }
+
+    private:
+        std::mutex m_lock;
+        std::condition_variable m_cond;
+        std::size_t m_depthFrames = 0u;
+        std::size_t m_extendedFrames = 0u;
+        bool m_lastHadRawData = false;
+    };
+
+    /**
+     * A CameraDevice with the real ProcessingSimple, where the frames come from a
+     * BufferGeneratorStub.
+     */
+    class TestCameraDeviceListeners : public ::testing::Test
+    {
+    protected:
+        void SetUp() override
+        {
+            m_bridge = std::make_shared<TcdlBridge>();
+            m_imager = std::make_shared<TcdlImager> (m_bridge);
+
+            royale::Vector<royale::ProcessingParameterMap> ppMap{ {} };
+            auto ucd = std::make_shared<UseCaseDefinition> (UseCaseFourPhase (5, 30000000, { 50u, 1000u }, 1000u, 0));
+            m_bridge->reduceToMinimumImage (ucd.get());
+            m_rawFrameCount = ucd->getRawFrameCount();
+            uint16_t width, height;
+            ucd->getImage (width, height);
+            UseCaseList ucList {UseCase ("testcase", ucd, ppMap) };
+            auto coreConfig = std::make_shared<StubCoreConfig> (width, height, ucList);
+
+            auto core = makeUnique<device::CameraCore> (
+                            coreConfig,
+                            m_imager,
+                            m_bridge,
+                            std::make_shared<StubTemperatureSensor>(),
+                            std::make_shared<StubStorage>(),
+                            nullptr,
+                            nullptr,
+                            CameraAccessLevel::L2);
+            m_processing = std::make_shared<ProcessingSimple> (core->getCaptureReleaser());
+            m_device = makeUnique<device::CameraDevice> (CameraAccessLevel::L2, "0", std::move (core),
+                       coreConfig, m_processing, CallbackData::Depth);
+
+            ASSERT_EQ (CameraStatus::SUCCESS, m_device->initialize());
+            ASSERT_EQ (CameraStatus::SUCCESS, m_device->startCapture());
+            ASSERT_EQ (1u, m_bridge->m_startCount);
+        }
+
+        void TearDown() override
+        {
+            if (m_device)
+            {
+                EXPECT_EQ (CameraStatus::SUCCESS, m_device->stopCapture());
+                m_device.reset();
+            }
+            if (m_bridge)
+            {
+                EXPECT_TRUE (m_bridge->checkCounterBuffersBalance());
+            }
+        }
+
+        /**
+         * Sends one superframe, and waits until the listener has received the given number of
+         * callbacks.
+         */
+        void sendFrame (TcdlListener &listener, std::size_t expectedCallbacks)
+        {
+            m_bridge->generateSizeStart (m_rawFrameCount, m_frameNumber);
+            m_frameNumber = static_cast<uint16_t> (m_frameNumber + m_rawFrameCount);
+            ASSERT_TRUE (listener.waitForFrames (expectedCallbacks));
+        }
+
+        /**
+         * The capturing has been running without interruption since SetUp.
+         */
+        void expectNoRestart()
+        {
+            EXPECT_EQ (1u, m_bridge->m_startCount);
+            EXPECT_EQ (0u, m_bridge->m_stopCount);
+            EXPECT_EQ (1u, m_imager->m_startCount);
+            EXPECT_EQ (0u, m_imager->m_stopCount);
+            bool capturing = false;
+            EXPECT_EQ (CameraStatus::SUCCESS, m_device->isCapturing (capturing));
+            EXPECT_TRUE (capturing);
+        }
+
+        std::shared_ptr<TcdlBridge> m_bridge;
+        std::shared_ptr<TcdlImager> m_imager;
+        std::shared_ptr<ProcessingSimple> m_processing;
+        std::unique_ptr<ICameraDevice> m_device;
+        std::size_t m_rawFrameCount;
+        uint16_t m_frameNumber = 0u;
+    };
+}
+
+/**
+ * Registering and unregistering listeners while capturing only changes the outputs that the
+ * processing builds, each frame goes to the listeners that are registered when it arrives.
+ */
+TEST_F (TestCameraDeviceListeners, SwapListenersWhileCapturing)
+{
+    TcdlListener listener;
+
+    ASSERT_EQ (CameraStatus::SUCCESS, m_device->registerDataListener (&listener));
+    sendFrame (listener, 1u);
+    EXPECT_EQ (1u, listener.depthFrames());
+
+    // The extended listener takes over from the depth listener
+    ASSERT_EQ (CameraStatus::SUCCESS, m_device->registerDataListenerExtended (&listener));
+    sendFrame (listener, 2u);
+    EXPECT_EQ (1u, listener.depthFrames());
+    EXPECT_EQ (1u, listener.extendedFrames());
+
+    ASSERT_EQ (CameraStatus::SUCCESS, m_device->unregisterDataListenerExtended());
+    sendFrame (listener, 3u);
+    EXPECT_EQ (2u, listener.depthFrames());
+    EXPECT_EQ (1u, listener.extendedFrames());
+
+    // Without listeners the frames are released without processing
+    ASSERT_EQ (CameraStatus::SUCCESS, m_device->unregisterDataListener());
+    m_bridge->generateSizeStart (m_rawFrameCount, m_frameNumber);
+    EXPECT_TRUE (m_bridge->checkCounterBuffersBalance());
+    EXPECT_EQ (2u, listener.depthFrames());
+    EXPECT_EQ (1u, listener.extendedFrames());
+
+    expectNoRestart();
+}
+
+/**
+ * Switching between the depth, intermediate and raw callbacks doesn't stop the capturing or
+ * lose any frames, only switching back from raw needs the processing to be set up again.
+ */
+TEST_F (TestCameraDeviceListeners, SwitchCallbackDataWhileCapturing)
+{
+    TcdlListener listener;
+    ASSERT_EQ (CameraStatus::SUCCESS, m_device->registerDataListenerExtended (&listener));
+    sendFrame (listener, 1u);
+
+    ASSERT_EQ (CameraStatus::SUCCESS, m_device->setCallbackData (CallbackData::Intermediate));
+    sendFrame (listener, 2u);
+    EXPECT_TRUE (m_processing->getProcessingActivated());
+
+    ASSERT_EQ (CameraStatus::SUCCESS, m_device->setCallbackData (CallbackData::Depth));
+    sendFrame (listener, 3u);
+
+    // Only the raw data is passed on, without being processed
+    ASSERT_EQ (CameraStatus::SUCCESS, m_device->setCallbackData (CallbackData::Raw));
+    EXPECT_FALSE (m_processing->getProcessingActivated());
+    sendFrame (listener, 4u);
+    EXPECT_TRUE (listener.lastHadRawData());
+
+    EXPECT_EQ (4u, listener.extendedFrames());
+    EXPECT_EQ (0u, listener.depthFrames());
+    expectNoRestart();
+
+    // The capturing is stopped to set up the processing, and started again afterwards
+    ASSERT_EQ (CameraStatus::SUCCESS, m_device->setCallbackData (CallbackData::Depth));
+    EXPECT_TRUE (m_processing->getProcessingActivated());
+    bool capturing = false;
+    EXPECT_EQ (CameraStatus::SUCCESS, m_device->isCapturing (capturing));
+    EXPECT_TRUE (capturing);
+    EXPECT_EQ (2u, m_bridge->m_startCount);
+    EXPECT_EQ (1u, m_bridge->m_stopCount);
+
+    sendFrame (listener, 5u);
+    EXPECT_EQ (5u, listener.extendedFrames());
+}
@@ -14,8 +14,19 @@
 #include <FrameGeneratorStub.hpp>
 #include <MockProcessingListeners.hpp>
 
+#include <royale/DepthData.hpp>
+#include <royale/IExtendedData.hpp>
+#include <royale/IExtendedDataListener.hpp>
+#include <royale/IIRImageListener.hpp>
+#include <royale/VectorAllocator.hpp>
+#include <royale/VectorPool.hpp>
+
 #include <gtest/gtest.h>
 
+#include <mutex>
+#include <set>
+#include <vector>
+
 using namespace royale;
 using namespace royale::collector;
 using namespace royale::common;
@@ -25,6 +36,125 @@ using namespace royaletest;
 
 using TestThreadedProcessingSimple = FixtureTestProcessing<ProcessingSimple>;
 
+namespace
+{
+    /**
+     * Allocator which counts the calls, and passes them on to a VectorPool.  It also records each
+     * block that the pool returns, a block that hasn't been seen before was allocated by the pool
+     * from the heap.
+     */
+    class CountingVectorAllocator : public IVectorAllocator
+    {
+    public:
+        void *allocate (std::size_t bytes) override
+        {
+            auto block = m_pool.allocate (bytes);
+            std::lock_guard<std::mutex> lock (m_lock);
+            ++m_allocations;
+            m_blocks.insert (block);
+            return block;
+        }
+
+        void deallocate (void *block, std::size_t bytes) override
+        {
+            m_pool.deallocate (block, bytes);
+        }
+
+        std::size_t allocations()
+        {
+            std::lock_guard<std::mutex> lock (m_lock);
+            return m_allocations;
+        }
+
+        std::size_t distinctBlocks()
+        {
+            std::lock_guard<std::mutex> lock (m_lock);
+            return m_blocks.size();
+        }
+
+    private:
+        VectorPool m_pool;
+        std::mutex m_lock;
+        std::size_t m_allocations = 0u;
+        std::set<void *> m_blocks;
+    };
+
+    /**
+     * Records the buffer that each callback's points are in.
+     */
+    class PointsBufferListener : public IDepthDataListener
+    {
+    public:
+        void onNewData (const DepthData *data) override
+        {
+            m_buffers.push_back (data->points.data());
+        }
+
+        std::vector<const DepthPoint *> m_buffers;
+    };
+
+    /**
+     * Keeps a copy of the points of each DepthData that it receives, either directly or as part
+     * of the extended data.
+     */
+    class RecordingListener : public IDepthDataListener, public IExtendedDataListener, public IIRImageListener
+    {
+    public:
+        void onNewData (const DepthData *data) override
+        {
+            m_points.push_back (data->points);
+        }
+
+        void onNewData (const IExtendedData *data) override
+        {
+            ASSERT_TRUE (data->hasRawData());
+            ASSERT_TRUE (data->hasDepthData());
+            m_points.push_back (data->getDepthData()->points);
+        }
+
+        void onNewData (const IRImage *data) override
+        {
+            ++m_irImages;
+        }
+
+        std::vector<royale::Vector<DepthPoint> > m_points;
+        std::size_t m_irImages = 0u;
+    };
+
+    void expectSamePoints (const royale::Vector<DepthPoint> &expected, const royale::Vector<DepthPoint> &actual)
+    {
+        ASSERT_EQ (expected.size(), actual.size());
+        for (auto i = 0u; i < expected.size(); i++)
+        {
+            EXPECT_EQ (expected[i].x, actual[i].x);
+            EXPECT_EQ (expected[i].y, actual[i].y);
+            EXPECT_EQ (expected[i].z, actual[i].z);
+            EXPECT_EQ (expected[i].noise, actual[i].noise);
+            EXPECT_EQ (expected[i].grayValue, actual[i].grayValue);
+            EXPECT_EQ (expected[i].depthConfidence, actual[i].depthConfidence);
+        }
+    }
+}
+
+TEST (TestDataListeners, OutputDemand)
+{
+    RecordingListener listener;
+    DataListeners listeners;
+    EXPECT_EQ (static_cast<uint32_t> (OUTPUT_NONE), listeners.outputDemand());
+
+    listeners.depthDataListener = &listener;
+    EXPECT_EQ (static_cast<uint32_t> (OUTPUT_DEPTH_DATA), listeners.outputDemand());
+
+    listeners.depthDataListener = nullptr;
+    listeners.irImageListener = &listener;
+    EXPECT_EQ (static_cast<uint32_t> (OUTPUT_IR_IMAGE), listeners.outputDemand());
+
+    // Only the extended listener is called if there is one
+    listeners.extendedListener = &listener;
+    EXPECT_EQ (static_cast<uint32_t> (OUTPUT_DEPTH_DATA | OUTPUT_INTERMEDIATE_DATA | OUTPUT_RAW_DATA),
+               listeners.outputDemand());
+}
+
 TEST_F (TestThreadedProcessingSimple, ValidCallbacks)
 {
     setupUseCaseDefault();
@@ -65,3 +195,107 @@ TEST_F (TestThreadedProcessingSimple, sequentialCallbacks)
 
     ASSERT_NO_FATAL_FAILURE (checkingListener->checkForThreadedAssert());
 }
+
+/**
+ * Replays a sequence of frames through the processing.  After the first frames, the output
+ * container is not reallocated, and with a VectorPool installed the temporary vectors are served
+ * from the pool without allocating new blocks.  Each frame makes the same number of Vector
+ * allocations, which must not grow beyond the current MAX_ALLOCATIONS_PER_FRAME.
+ */
+TEST_F (TestThreadedProcessingSimple, ReplayWithoutReallocation)
+{
+    auto allocator = std::make_shared<CountingVectorAllocator>();
+    setVectorAllocator (allocator);
+
+    setupUseCaseDefault();
+    auto listener = std::make_shared<PointsBufferListener>();
+    replaceListener (listener);
+
+    const auto warmUpFrames = 3;
+    const auto replayFrames = 50;
+    const std::size_t MAX_ALLOCATIONS_PER_FRAME = 36u;
+    for (auto i = 0; i < warmUpFrames; i++)
+    {
+        ASSERT_NO_FATAL_FAILURE (m_frameGenerator->generateCallback (*m_useCase, m_useCase->getStreamIds().at (0)));
+    }
+    const auto blocksAfterWarmUp = allocator->distinctBlocks();
+
+    auto allocationsBefore = allocator->allocations();
+    ASSERT_NO_FATAL_FAILURE (m_frameGenerator->generateCallback (*m_useCase, m_useCase->getStreamIds().at (0)));
+    const auto allocationsPerFrame = allocator->allocations() - allocationsBefore;
+    for (auto i = 1; i < replayFrames; i++)
+    {
+        allocationsBefore = allocator->allocations();
+        ASSERT_NO_FATAL_FAILURE (m_frameGenerator->generateCallback (*m_useCase, m_useCase->getStreamIds().at (0)));
+        EXPECT_EQ (allocationsPerFrame, allocator->allocations() - allocationsBefore) << "frame " << i;
+    }
+    const auto blocksAfterReplay = allocator->distinctBlocks();
+    setVectorAllocator (nullptr);
+
+    EXPECT_LE (allocationsPerFrame, MAX_ALLOCATIONS_PER_FRAME);
+    EXPECT_EQ (blocksAfterWarmUp, blocksAfterReplay);
+
+    ASSERT_EQ (static_cast<std::size_t> (warmUpFrames + replayFrames), listener->m_buffers.size());
+    for (auto i = 1u; i < listener->m_buffers.size(); i++)
+    {
+        EXPECT_EQ (listener->m_buffers.front(), listener->m_buffers.at (i));
+    }
+}
+
+/**
+ * Replays the same frames with different combinations of listeners, which are changed between
+ * the frames without restarting the capture.  Each listener gets the same data, and listeners
+ * that aren't registered don't get any callbacks.
+ */
+TEST_F (TestThreadedProcessingSimple, ReplayListenerCombinations)
+{
+    setupUseCaseDefault();
+    const auto streamId = m_useCase->getStreamIds().at (0);
+
+    RecordingListener reference;
+    DataListeners listeners;
+    listeners.depthDataListener = &reference;
+    m_processing->registerDataListeners (listeners);
+    ASSERT_NO_FATAL_FAILURE (m_frameGenerator->generateCallback (*m_useCase, streamId));
+    ASSERT_EQ (1u, reference.m_points.size());
+    ASSERT_FALSE (reference.m_points.front().empty());
+    const auto expected = reference.m_points.front();
+
+    RecordingListener depthListener;
+    RecordingListener extendedListener;
+    RecordingListener irListener;
+
+    // Without listeners, nothing is processed
+    m_processing->registerDataListeners (DataListeners {});
+    ASSERT_NO_FATAL_FAILURE (m_frameGenerator->generateCallback (*m_useCase, streamId));
+
+    // An IR image consumer doesn't need the DepthData
+    listeners = DataListeners {};
+    listeners.irImageListener = &irListener;
+    m_processing->registerDataListeners (listeners);
+    ASSERT_NO_FATAL_FAILURE (m_frameGenerator->generateCallback (*m_useCase, streamId));
+    EXPECT_EQ (1u, irListener.m_irImages);
+
+    listeners.depthDataListener = &depthListener;
+    m_processing->registerDataListeners (listeners);
+    ASSERT_NO_FATAL_FAILURE (m_frameGenerator->generateCallback (*m_useCase, streamId));
+    EXPECT_EQ (2u, irListener.m_irImages);
+
+    // With an extended listener, the other listeners aren't called
+    listeners.extendedListener = &extendedListener;
+    m_processing->registerDataListeners (listeners);
+    ASSERT_NO_FATAL_FAILURE (m_frameGenerator->generateCallback (*m_useCase, streamId));
+    EXPECT_EQ (2u, irListener.m_irImages);
+
+    listeners = DataListeners {};
+    listeners.depthDataListener = &depthListener;
+    m_processing->registerDataListeners (listeners);
+    ASSERT_NO_FATAL_FAILURE (m_frameGenerator->generateCallback (*m_useCase, streamId));
+
+    EXPECT_EQ (1u, reference.m_points.size());
+    ASSERT_EQ (2u, depthListener.m_points.size());
+    ASSERT_EQ (1u, extendedListener.m_points.size());
+    expectSamePoints (expected, depthListener.m_points.at (0));
+    expectSamePoints (expected, depthListener.m_points.at (1));
+    expectSamePoints (expected, extendedListener.m_points.at (0));
+}
@@ -136,7 +136,7 @@ namespace
 
 RRFACCESSAPI royale_rrf_api_error royale_open_input_file (royale_rrf_handle *handle, const char *filename)
 {
-    std::unique_ptr<FileReaderDispatcher> curInstance (new FileReaderDispatcher());
+    std::unique_ptr<FileReaderDispatcher> curInstance (new FileReaderDispatcher (FileReaderBackend::MAPPED));
 
     try
     {
@@ -227,20 +227,13 @@ RRFACCESSAPI royale_rrf_api_error royale_get_frame (const royale_rrf_handle hand
 {
     CHECK_RRFHANDLE (FileReaderDispatcher, handle, royale_rrf_api_error::RRF_HANDLE_INVALID);
 
-    std::vector <std::vector<uint16_t>> imageData;
-    std::vector <std::vector<uint16_t>> pseudoData;
-    royale_frameheader_v3 frameHeader;
-    std::vector <royale_streamheader_v3> streamHeaders;
-    std::vector <royale_framegroupheader_v3> frameGroupHeaders;
-    std::vector <royale_exposuregroupheader_v3> exposureGroupHeaders;
-    std::vector <royale_rawframesetheader_v3> rawFrameSetHeaders;
-    std::vector <royale_processingparameter_v3> processingParameters;
-    std::vector<std::pair<std::string, std::vector<uint8_t>>> additionalData;
+    // If the file is mapped, the view points into the mapping, and the data is only copied once
+    // into the returned frame
+    FrameView view;
 
     try
     {
-        rw->get (imageData, pseudoData, &frameHeader, streamHeaders,
-                 frameGroupHeaders, exposureGroupHeaders, rawFrameSetHeaders, processingParameters, additionalData);
+        rw->getFrameView (view);
     }
     catch (...)
     {
@@ -253,43 +246,36 @@ RRFACCESSAPI royale_rrf_api_error royale_get_frame (const royale_rrf_handle hand
     memset (frame, 0, sizeof (royale_frame_v3));
 
     // Fill the frame header
-    memcpy (&frame->frameHeader, &frameHeader, sizeof (royale_frameheader_v3));
+    memcpy (&frame->frameHeader, view.frameHeader, sizeof (royale_frameheader_v3));
 
     // Fill stream headers
     if (frame->frameHeader.numStreams)
     {
         frame->streamHeaders = new royale_streamheader_v3[frame->frameHeader.numStreams];
-
-        for (auto i = 0u; i < frame->frameHeader.numStreams; ++i)
-        {
-            memcpy (&frame->streamHeaders[i], &streamHeaders[i], sizeof (royale_streamheader_v3));
-        }
+        memcpy (frame->streamHeaders, view.streamHeaders, sizeof (royale_streamheader_v3) * frame->frameHeader.numStreams);
     }
 
     // Fill frame group headers
     frame->frameGroupHeaders = new royale_framegroupheader_v3[frame->frameHeader.numFrameGroups];
-
-    for (auto i = 0u; i < frame->frameHeader.numFrameGroups; ++i)
+    if (frame->frameHeader.numFrameGroups)
     {
-        memcpy (&frame->frameGroupHeaders[i], &frameGroupHeaders[i], sizeof (royale_framegroupheader_v3));
+        memcpy (frame->frameGroupHeaders, view.frameGroupHeaders, sizeof (royale_framegroupheader_v3) * frame->frameHeader.numFrameGroups);
     }
 
     // Fill exposure group headers
     frame->exposureGroupHeaders = new royale_exposuregroupheader_v3[frame->frameHeader.numExposureGroups];
-
-    for (auto i = 0u; i < frame->frameHeader.numExposureGroups; ++i)
+    if (frame->frameHeader.numExposureGroups)
     {
-        memcpy (&frame->exposureGroupHeaders[i], &exposureGroupHeaders[i], sizeof (royale_exposuregroupheader_v3));
+        memcpy (frame->exposureGroupHeaders, view.exposureGroupHeaders, sizeof (royale_exposuregroupheader_v3) * frame->frameHeader.numExposureGroups);
     }
 
     // Fill raw frame sets
     if (frame->frameHeader.numRawFrames)
     {
         frame->rawFrameSetHeaders = new royale_rawframesetheader_v3[frame->frameHeader.numRawFrameSets];
-
-        for (auto i = 0u; i < frame->frameHeader.numRawFrameSets; ++i)
+        if (frame->frameHeader.numRawFrameSets)
         {
-            memcpy (&frame->rawFrameSetHeaders[i], &rawFrameSetHeaders[i], sizeof (royale_rawframesetheader_v3));
+            memcpy (frame->rawFrameSetHeaders, view.rawFrameSetHeaders, sizeof (royale_rawframesetheader_v3) * frame->frameHeader.numRawFrameSets);
         }
     }
 
@@ -297,11 +283,7 @@ RRFACCESSAPI royale_rrf_api_error royale_get_frame (const royale_rrf_handle hand
     if (frame->frameHeader.numParameters)
     {
         frame->processingParameters = new royale_processingparameter_v3[frame->frameHeader.numParameters];
-
-        for (auto i = 0u; i < frame->frameHeader.numParameters; ++i)
-        {
-            memcpy (&frame->processingParameters[i], &processingParameters[i], sizeof (royale_processingparameter_v3));
-        }
+        memcpy (frame->processingParameters, view.processingParameters, sizeof (royale_processingparameter_v3) * frame->frameHeader.numParameters);
     }
 
     // Copy the additional data
@@ -309,31 +291,31 @@ RRFACCESSAPI royale_rrf_api_error royale_get_frame (const royale_rrf_handle hand
     {
         frame->additionalData = new royale_additionaldata_v3[frame->frameHeader.numAdditionalData];
 
-        int i = 0;
-        for (auto curData = additionalData.begin(); curData != additionalData.end(); ++curData, ++i)
+        for (auto i = 0u; i < view.additionalData.size(); ++i)
         {
-            frame->additionalData[i].dataSize = static_cast<uint64_t> (curData->second.size());
-            frame->additionalData[i].data = new uint8_t[static_cast<size_t> (frame->additionalData[i].dataSize)];
-            memcpy (frame->additionalData[i].data, &curData->second[0], static_cast<size_t> (frame->additionalData[i].dataSize));
-            std::string tempName = curData->first;
-            tempName.resize (ROYALE_FILEHEADER_V3_ADDITIONAL_DATA_NAME_LENGTH);
-            memcpy (frame->additionalData[i].dataName, tempName.c_str(), ROYALE_FILEHEADER_V3_ADDITIONAL_DATA_NAME_LENGTH);
+            const auto &curData = view.additionalData[i];
+            frame->additionalData[i].dataSize = curData.size;
+            frame->additionalData[i].data = new uint8_t[static_cast<size_t> (curData.size)];
+            memcpy (frame->additionalData[i].data, curData.data, static_cast<size_t> (curData.size));
+            memcpy (frame->additionalData[i].dataName, curData.name, ROYALE_FILEHEADER_V3_ADDITIONAL_DATA_NAME_LENGTH);
         }
     }
 
-    // Copy the image data
-    frame->imageData = new uint16_t *[imageData.size()];
-    for (auto i = 0u; i < imageData.size(); ++i)
+    // Copy the image data, each raw frame in the view starts with its pseudo data line
+    const size_t numColumns = frame->frameHeader.numColumns;
+    const size_t imageSize = numColumns * frame->frameHeader.numRows;
+    const auto numRawFrames = frame->frameHeader.numRawFrames;
+    frame->imageData = new uint16_t *[numRawFrames];
+    frame->pseudoData = new uint16_t *[numRawFrames];
+    for (auto i = 0u; i < numRawFrames; ++i)
     {
-        frame->imageData[i] = new uint16_t[imageData[i].size()];
-        memcpy (&frame->imageData[i][0], &imageData[i][0], sizeof (uint16_t) * imageData[i].size ());
-    }
+        const auto slot = view.frameData + i * (numColumns + imageSize);
 
-    frame->pseudoData = new uint16_t *[pseudoData.size()];
-    for (auto i = 0u; i < pseudoData.size(); ++i)
-    {
-        frame->pseudoData[i] = new uint16_t[pseudoData[i].size()];
-        memcpy (&frame->pseudoData[i][0], &pseudoData[i][0], sizeof (uint16_t) * pseudoData[i].size());
+        frame->pseudoData[i] = new uint16_t[numColumns];
+        memcpy (frame->pseudoData[i], slot, sizeof (uint16_t) * numColumns);
+
+        frame->imageData[i] = new uint16_t[imageSize];
+        memcpy (frame->imageData[i], slot + numColumns, sizeof (uint16_t) * imageSize);
     }
 
     return royale_rrf_api_error::RRF_NO_ERROR;
@@ -15,6 +15,7 @@
 
 #include <device/CameraDeviceBase.hpp>
 #include <record/FileReaderDispatcher.hpp>
+#include <record/FramePrefetcher.hpp>
 #include <royale/IReplay.hpp>
 #include <royale/IRecordStopListener.hpp>
 #include <royale/IPlaybackStopListener.hpp>
@@ -22,6 +23,7 @@
 #include <collector/IFrameCaptureReleaser.hpp>
 #include <processing/Processing.hpp>
 #include <record/RecordedRawFrame.hpp>
+#include <record/UseCaseRecord.hpp>
 #include <processing/ExtendedData.hpp>
 #include <common/EventForwarder.hpp>
 
@@ -160,9 +162,19 @@ namespace royale
                                    std::unique_ptr<const royale::collector::CapturedUseCase> capturedCase,
                                    royale::StreamId streamId);
 
-            void readFrame (std::vector<std::vector<uint16_t>> &frames,
-                            std::unique_ptr<royale::usecase::UseCaseDefinition> &definition,
-                            std::chrono::milliseconds &timestamp,
+            /**
+             * Gets the current frame from m_prefetcher, and releases the previous one.
+             * m_recordedFrames point to the raw frames in the PrefetchedFrame's buffer, and
+             * m_definition is the use case of the frame.
+             *
+             * To avoid allocating memory for each frame, the buffers are reused and the
+             * UseCaseRecord is only created again if the use case hash of the frame changes.
+             * additionalData is swapped with the PrefetchedFrame's, so the caller should keep
+             * passing the same vector.
+             *
+             * \return true if m_definition was replaced
+             */
+            bool readFrame (std::chrono::milliseconds &timestamp,
                             float &illuminationTemperature,
                             std::vector<uint32_t> &capturedExposureTimes,
                             royale::ProcessingParameterMap &parameterMap,
@@ -206,6 +218,22 @@ namespace royale
             /** Event source */
             royale::EventForwarder m_eventForwarder;
 
+            // Reads the frames in advance, with its own FileReaderDispatcher. m_reader is
+            // only used for the playback position and the information about the recording.
+            std::unique_ptr<FramePrefetcher> m_prefetcher;
+            PrefetchedFrame *m_prefetchedFrame;
+
+            // The raw frames of m_prefetchedFrame
+            std::vector<RecordedRawFrame> m_recordedFrameSlots;
+            std::vector<royale::common::ICapturedRawFrame *> m_recordedFrames;
+
+            // Use case of the current frame and the hash it was created from
+            std::unique_ptr<UseCaseRecord> m_definition;
+            uint64_t m_definitionHash;
+
+            // Streams of m_definition that only use one modulation frequency
+            std::vector<royale::StreamId> m_singleFrequencyStreams;
+
 
             // Mutex that is used in the playback to synchronize the use case change
             std::mutex m_playbackMutex;
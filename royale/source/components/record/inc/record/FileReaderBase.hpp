@@ -45,6 +45,58 @@ namespace royale
 {
     namespace record
     {
+        /**
+        * How a reader accesses the file.
+        */
+        enum class FileReaderBackend
+        {
+            /**
+            * The frames are read with fread
+            */
+            BUFFERED,
+
+            /**
+            * The file is mapped into memory, and frames are returned without copying them.  If the
+            * file can't be mapped, or the recording's version doesn't support it, the reader uses
+            * BUFFERED instead.
+            */
+            MAPPED
+        };
+
+        /**
+        * A frame as returned by \sa FileReaderBase::getFrameView.  The number of elements behind
+        * each pointer is given by the corresponding field of the frame header.
+        *
+        * The pointers stay valid until the next call to getFrameView or close on the same reader.
+        */
+        struct FrameView
+        {
+            /**
+            * An additional data block, the name has ROYALE_FILEHEADER_V3_ADDITIONAL_DATA_NAME_LENGTH
+            * characters and isn't necessarily zero-terminated.
+            */
+            struct AdditionalData
+            {
+                const char *name;
+                const uint8_t *data;
+                uint64_t size;
+            };
+
+            const royale_frameheader_v3 *frameHeader;
+            const royale_streamheader_v3 *streamHeaders;
+            const royale_framegroupheader_v3 *frameGroupHeaders;
+            const royale_exposuregroupheader_v3 *exposureGroupHeaders;
+            const royale_rawframesetheader_v3 *rawFrameSetHeaders;
+
+            /**
+            * Pseudo data and image data of the raw frames, in the same layout as for \sa FileReaderBase::getFrame
+            */
+            const uint16_t *frameData;
+
+            const royale_processingparameter_v3 *processingParameters;
+            std::vector<AdditionalData> additionalData;
+        };
+
         /**
         * This contains the base for the different file reader classes.
         */
@@ -100,6 +152,47 @@ namespace royale
                                            std::vector <royale_processingparameter_v3> &processingParameters,
                                            std::vector<std::pair<std::string, std::vector<uint8_t>>> &additionalData) = 0;
 
+            /**
+            * Retrieves the current frame from the file, like \sa get, but puts the pseudo data and
+            * the image data of all raw frames into one buffer.  Each raw frame uses a slot of
+            * numColumns * (numRows + 1) values, the pseudo data line followed by the image data.
+            *
+            * The vectors are only resized, if the same vectors are used for the next frame of the
+            * same size no memory is allocated.
+            *
+            * @param frameData Pseudo data and image data of the frames
+            */
+            RRFACCESSAPI virtual void getFrame (std::vector<uint16_t> &frameData,
+                                                royale_frameheader_v3 *frameHeader,
+                                                std::vector <royale_streamheader_v3> &streamHeaders,
+                                                std::vector <royale_framegroupheader_v3> &frameGroupHeaders,
+                                                std::vector <royale_exposuregroupheader_v3> &exposureGroupHeaders,
+                                                std::vector <royale_rawframesetheader_v3> &rawFrameSetHeaders,
+                                                std::vector <royale_processingparameter_v3> &processingParameters,
+                                                std::vector<std::pair<std::string, std::vector<uint8_t>>> &additionalData);
+
+            /**
+            * Retrieves the current frame from the file without copying it, if the reader supports
+            * that.  The default implementation reads the frame with \sa getFrame into buffers
+            * owned by the reader.
+            * @param view Is set to the frame, the vector in it is only resized
+            */
+            RRFACCESSAPI virtual void getFrameView (FrameView &view);
+
+            /**
+            * Returns the backend that is used for the currently opened file.
+            */
+            RRFACCESSAPI virtual FileReaderBackend backend() const;
+
+            /**
+            * Tells the operating system that these frames will be read soon, so that it can start
+            * reading them from the disk in the background.  This is only a hint, the default
+            * implementation does nothing.
+            * @param firstFrame First frame that will be read
+            * @param numFrames Number of frames following firstFrame
+            */
+            RRFACCESSAPI virtual void adviseWillNeed (uint32_t firstFrame, uint32_t numFrames);
+
             /**
             * Retrieve the versions of all the components used for the recording
             */
@@ -201,6 +294,26 @@ namespace royale
 
             uint16_t m_maxSensorWidth;
             uint16_t m_maxSensorHeight;
+
+        private:
+
+            /**
+            * Used by the default implementation of getFrame, which copies the data from get
+            */
+            std::vector <std::vector<uint16_t>> m_imageDataBuffer;
+            std::vector <std::vector<uint16_t>> m_pseudoDataBuffer;
+
+            /**
+            * Used by the default implementation of getFrameView
+            */
+            royale_frameheader_v3 m_viewFrameHeader;
+            std::vector<uint16_t> m_viewFrameData;
+            std::vector <royale_streamheader_v3> m_viewStreamHeaders;
+            std::vector <royale_framegroupheader_v3> m_viewFrameGroupHeaders;
+            std::vector <royale_exposuregroupheader_v3> m_viewExposureGroupHeaders;
+            std::vector <royale_rawframesetheader_v3> m_viewRawFrameSetHeaders;
+            std::vector <royale_processingparameter_v3> m_viewProcessingParameters;
+            std::vector<std::pair<std::string, std::vector<uint8_t>>> m_viewAdditionalData;
         };
     }
 }
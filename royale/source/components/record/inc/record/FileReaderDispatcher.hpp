@@ -28,6 +28,14 @@ namespace royale
             */
             RRFACCESSAPI FileReaderDispatcher();
 
+            /**
+            * Constructor for a dispatcher that uses the given backend for the recordings that
+            * support it, which are recordings of version 3.  Older recordings are always read
+            * with FileReaderBackend::BUFFERED, as their frames are converted to the current
+            * format.
+            */
+            RRFACCESSAPI explicit FileReaderDispatcher (FileReaderBackend backend);
+
             /**
             * Destructor for the dispatcher.
             */
@@ -45,6 +53,17 @@ namespace royale
                                    std::vector <royale_rawframesetheader_v3> &rawFrameSetHeaders,
                                    std::vector <royale_processingparameter_v3> &processingParameters,
                                    std::vector<std::pair<std::string, std::vector<uint8_t>>> &additionalData) override;
+            RRFACCESSAPI void getFrame (std::vector<uint16_t> &frameData,
+                                        royale_frameheader_v3 *frameHeader,
+                                        std::vector <royale_streamheader_v3> &streamHeaders,
+                                        std::vector <royale_framegroupheader_v3> &frameGroupHeaders,
+                                        std::vector <royale_exposuregroupheader_v3> &exposureGroupHeaders,
+                                        std::vector <royale_rawframesetheader_v3> &rawFrameSetHeaders,
+                                        std::vector <royale_processingparameter_v3> &processingParameters,
+                                        std::vector<std::pair<std::string, std::vector<uint8_t>>> &additionalData) override;
+            RRFACCESSAPI void getFrameView (FrameView &view) override;
+            RRFACCESSAPI FileReaderBackend backend() const override;
+            RRFACCESSAPI void adviseWillNeed (uint32_t firstFrame, uint32_t numFrames) override;
             RRFACCESSAPI std::vector<royale_versioninformation_v3> getComponentVersions() const override;
             RRFACCESSAPI royale_rrf_platformtype platform() const override;
             RRFACCESSAPI std::string cameraName() const override;
@@ -74,6 +93,8 @@ namespace royale
             FileReaderBase *m_fileReader;
 
             uint16_t m_fileVersion;
+
+            FileReaderBackend m_backend;
         };
     }
 }
@@ -0,0 +1,155 @@
+/****************************************************************************\
+ * Copyright (C) 2019 pmdtechnologies ag
+ *
+ * THIS CODE AND INFORMATION ARE PROVIDED "AS IS" WITHOUT WARRANTY OF ANY
+ * KIND, EITHER EXPRESSED OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND/OR FITNESS FOR A
+ * PARTICULAR PURPOSE.
+ *
+ \****************************************************************************/
+
+#pragma once
+
+#include <record/FileReaderBase.hpp>
+#include <record/UseCaseRecord.hpp>
+
+#include <condition_variable>
+#include <cstdint>
+#include <exception>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+
+namespace royale
+{
+    namespace record
+    {
+        /**
+         * A frame that has been read by the FramePrefetcher, with the data as returned by
+         * FileReaderBase::getFrame.  The buffers are reused for another frame after the frame
+         * has been released.
+         */
+        struct PrefetchedFrame
+        {
+            uint32_t frameNumber;
+            uint64_t useCaseHash;
+            RecordUseCaseDefinition definition;
+            std::vector<uint16_t> frameData;
+            std::vector<royale_processingparameter_v3> processingParameters;
+            std::vector<std::pair<std::string, std::vector<uint8_t>>> additionalData;
+
+            /**
+             * Set if the reader threw an exception while reading this frame.
+             */
+            std::exception_ptr error;
+
+            /**
+             * Restart count of the FramePrefetcher when the frame was read, frames from before
+             * the last restart are dropped.
+             */
+            uint32_t generation;
+        };
+
+        /**
+         * Reads the frames of a recording in a separate thread, so that the time spent waiting
+         * for the disk isn't added to the time spent processing the frame.
+         *
+         * The frames are read in playback order, starting from the frame given to restart() and
+         * wrapping around at the end of the range if the playback loops.  If the frame requested
+         * with acquire() isn't the next one in that order (because the playback seeked), the
+         * frames that were read ahead are dropped and reading restarts at the requested frame.
+         *
+         * There are a fixed number of PrefetchedFrame buffers, one of them is held by the
+         * caller between acquire() and release(), the others are filled by the read thread.
+         */
+        class FramePrefetcher
+        {
+        public:
+            /**
+             * \param reader an opened reader, which is only used by the read thread
+             * \param depth number of frame buffers, at least two
+             */
+            RRFACCESSAPI FramePrefetcher (std::unique_ptr<FileReaderBase> reader, std::size_t depth);
+            RRFACCESSAPI ~FramePrefetcher();
+
+            /**
+             * Sets the order in which the frames are read ahead.
+             *
+             * \param first first frame of the range
+             * \param last the frame after the range, or zero for the end of the recording
+             * \param loop if false, reading stops at the end of the range
+             */
+            RRFACCESSAPI void setRange (uint32_t first, uint32_t last, bool loop);
+
+            /**
+             * Drops the frames that have been read ahead and starts reading at frameNumber.
+             */
+            RRFACCESSAPI void restart (uint32_t frameNumber);
+
+            /**
+             * Returns frameNumber, waiting until the read thread has read it.  The frame must be
+             * released before the next call to acquire().
+             *
+             * If the reader failed to read the frame, its exception is rethrown.  If the read
+             * thread is stopped because the FramePrefetcher is being destroyed,
+             * std::runtime_error is thrown instead of waiting.
+             */
+            RRFACCESSAPI PrefetchedFrame &acquire (uint32_t frameNumber);
+
+            /**
+             * Returns the frame to the read thread.
+             */
+            RRFACCESSAPI void release (PrefetchedFrame &frame);
+
+        private:
+            void readThread();
+
+            /**
+             * Returns true if there is a next frame, and sets next to it.
+             */
+            bool nextFrame (uint32_t frame, uint32_t &next) const;
+
+            /**
+             * Moves the frames that have been read to the free buffers.  Must be called with
+             * m_lock held.
+             */
+            void flush();
+
+            std::unique_ptr<FileReaderBase> m_reader;
+            const uint32_t m_numFrames;
+
+            std::vector<std::unique_ptr<PrefetchedFrame>> m_frames;
+
+            // Buffers that can be filled by the read thread
+            std::vector<PrefetchedFrame *> m_free;
+
+            // Frames that have been read, a ring of m_readyCount frames starting at m_readyHead
+            std::vector<PrefetchedFrame *> m_ready;
+            std::size_t m_readyHead;
+            std::size_t m_readyCount;
+
+            uint32_t m_rangeStart;
+            uint32_t m_rangeEnd;
+            bool m_loop;
+
+            // The frame the read thread reads next, unless m_atEnd is set
+            uint32_t m_nextRead;
+            bool m_atEnd;
+
+            // The frame the read thread is reading at the moment, if it hasn't been dropped
+            bool m_reading;
+            uint32_t m_readingFrame;
+
+            uint32_t m_generation;
+
+            bool m_stop;
+            std::mutex m_lock;
+            std::condition_variable m_readCondition;
+            std::condition_variable m_readyCondition;
+            std::thread m_thread;
+        };
+    }
+}
@@ -0,0 +1,82 @@
+/****************************************************************************\
+ * Copyright (C) 2019 pmdtechnologies ag
+ *
+ * THIS CODE AND INFORMATION ARE PROVIDED "AS IS" WITHOUT WARRANTY OF ANY
+ * KIND, EITHER EXPRESSED OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND/OR FITNESS FOR A
+ * PARTICULAR PURPOSE.
+ *
+ \****************************************************************************/
+
+#pragma once
+
+#include <record/CommonHeader.h>
+
+#include <cstdint>
+#include <stdio.h>
+
+namespace royale
+{
+    namespace record
+    {
+        /**
+        * A read-only memory mapping of a whole file.
+        *
+        * Mapping isn't possible for every file, map() returns false instead of throwing, and the
+        * caller is expected to fall back to buffered reads.
+        */
+        class MappedFile
+        {
+        public:
+            /**
+            * Files bigger than this aren't mapped by default.  On 32 bit systems a big recording
+            * would use up most of the address space.
+            */
+            RRFACCESSAPI static const uint64_t DEFAULT_MAX_SIZE;
+
+            RRFACCESSAPI MappedFile();
+            RRFACCESSAPI ~MappedFile();
+
+            MappedFile (const MappedFile &) = delete;
+            MappedFile &operator= (const MappedFile &) = delete;
+
+            /**
+            * Maps the file that is opened as file, the FILE stays owned by the caller and can be
+            * closed while the mapping exists.
+            *
+            * Returns false if the file can't be mapped, for example because it isn't a regular
+            * file (a pipe or a device), because it is empty, or because it is bigger than maxSize.
+            * @param file An opened file
+            * @param maxSize Maximum size of the file in bytes
+            */
+            RRFACCESSAPI bool map (FILE *file, uint64_t maxSize = DEFAULT_MAX_SIZE);
+
+            /**
+            * Removes the mapping, all pointers returned by at() become invalid.
+            */
+            RRFACCESSAPI void unmap();
+
+            RRFACCESSAPI bool isMapped() const;
+
+            /**
+            * Size of the mapped file in bytes.
+            */
+            RRFACCESSAPI uint64_t size() const;
+
+            /**
+            * Returns a pointer to the length bytes starting at offset.  Throws std::out_of_range
+            * if the range isn't completely inside the file.
+            */
+            RRFACCESSAPI const uint8_t *at (uint64_t offset, uint64_t length) const;
+
+        private:
+            const uint8_t *m_data;
+            uint64_t m_size;
+
+#ifdef ROYALE_TARGET_PLATFORM_WINDOWS
+            // HANDLE of the file mapping object
+            void *m_mapping;
+#endif
+        };
+    }
+}
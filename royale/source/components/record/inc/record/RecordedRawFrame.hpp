@@ -35,6 +35,15 @@ namespace royale
              */
             RecordedRawFrame (std::vector<uint16_t> &data, const uint16_t &columns);
 
+            /**
+             * Constructor for a frame inside a larger buffer, the pseudo data line starts at data
+             * and is followed by the image data.
+             *
+             * \param data start of this frame's data, the buffer isn't owned by the frame
+             * \param columns number of columns (used to calculate the offset to the image data)
+             */
+            RecordedRawFrame (uint16_t *data, uint16_t columns);
+
             ~RecordedRawFrame();
 
             /**
@@ -27,6 +27,16 @@ namespace royale
             std::vector<royale_rawframesetheader_v3>        rawFrameSets;
         };
 
+        /**
+         * Hash of the parts of a frame's headers that UseCaseRecord is created from.  Frames of a
+         * recording with the same hash can share the same UseCaseRecord.
+         *
+         * The hash is calculated field by field, the padding of the on-disk structures and the
+         * values that can change for each frame of the same use case (timestamp, temperature,
+         * captured exposure times, current stream) are not included.
+         */
+        RRFACCESSAPI uint64_t calculateUseCaseHash (const RecordUseCaseDefinition &definition);
+
         class UseCaseRecord : public royale::usecase::UseCaseDefinition
         {
         public:
@@ -11,6 +11,7 @@
 #pragma once
 
 #include <record/FileReaderBase.hpp>
+#include <record/MappedFile.hpp>
 #include <record/v3/FileHeader.h>
 
 namespace royale
@@ -26,7 +27,7 @@ namespace royale
             {
             public:
 
-                RRFACCESSAPI FileReader();
+                RRFACCESSAPI explicit FileReader (FileReaderBackend backend = FileReaderBackend::BUFFERED);
                 RRFACCESSAPI virtual ~FileReader();
 
                 RRFACCESSAPI void open (const std::string &filename) override;
@@ -41,6 +42,17 @@ namespace royale
                                        std::vector <royale_rawframesetheader_v3> &rawFrameSetHeaders,
                                        std::vector <royale_processingparameter_v3> &processingParameters,
                                        std::vector<std::pair<std::string, std::vector<uint8_t>>> &additionalData) override;
+                RRFACCESSAPI void getFrame (std::vector<uint16_t> &frameData,
+                                            royale_frameheader_v3 *frameHeader,
+                                            std::vector <royale_streamheader_v3> &streamHeaders,
+                                            std::vector <royale_framegroupheader_v3> &frameGroupHeaders,
+                                            std::vector <royale_exposuregroupheader_v3> &exposureGroupHeaders,
+                                            std::vector <royale_rawframesetheader_v3> &rawFrameSetHeaders,
+                                            std::vector <royale_processingparameter_v3> &processingParameters,
+                                            std::vector<std::pair<std::string, std::vector<uint8_t>>> &additionalData) override;
+                RRFACCESSAPI void getFrameView (FrameView &view) override;
+                RRFACCESSAPI FileReaderBackend backend() const override;
+                RRFACCESSAPI void adviseWillNeed (uint32_t firstFrame, uint32_t numFrames) override;
                 RRFACCESSAPI std::vector<royale_versioninformation_v3> getComponentVersions() const override;
                 RRFACCESSAPI royale_rrf_platformtype platform() const override;
                 RRFACCESSAPI std::string cameraName() const override;
@@ -62,6 +74,41 @@ namespace royale
                  */
                 void buildOffsetMap();
 
+                /**
+                 * Seeks to the current frame and reads the headers that precede the raw frames.
+                 */
+                void readFrameHeaders (royale_frameheader_v3 *frameHeader,
+                                       std::vector <royale_streamheader_v3> &streamHeaders,
+                                       std::vector <royale_framegroupheader_v3> &frameGroupHeaders,
+                                       std::vector <royale_exposuregroupheader_v3> &exposureGroupHeaders,
+                                       std::vector <royale_rawframesetheader_v3> &rawFrameSetHeaders);
+
+                /**
+                 * Reads the processing parameters and additional data that follow the raw frames.
+                 */
+                void readFrameTrailer (const royale_frameheader_v3 *frameHeader,
+                                       std::vector <royale_processingparameter_v3> &processingParameters,
+                                       std::vector<std::pair<std::string, std::vector<uint8_t>>> &additionalData);
+
+                /**
+                 * Sets view to the current frame inside the mapping.  Throws if the sections of
+                 * the frame don't fit into the frame size given in its header.
+                 */
+                void viewMappedFrame (FrameView &view);
+
+                /**
+                 * Copies everything except the raw frames from a view into the vectors used by get
+                 * and getFrame.
+                 */
+                void copyViewHeaders (const FrameView &view,
+                                      royale_frameheader_v3 *frameHeader,
+                                      std::vector <royale_streamheader_v3> &streamHeaders,
+                                      std::vector <royale_framegroupheader_v3> &frameGroupHeaders,
+                                      std::vector <royale_exposuregroupheader_v3> &exposureGroupHeaders,
+                                      std::vector <royale_rawframesetheader_v3> &rawFrameSetHeaders,
+                                      std::vector <royale_processingparameter_v3> &processingParameters,
+                                      std::vector<std::pair<std::string, std::vector<uint8_t>>> &additionalData);
+
                 /**
                  * The current frame
                  */
@@ -82,6 +129,23 @@ namespace royale
                 royale_fileheader_v3 m_fileHeader;
 
                 std::vector<royale_versioninformation_v3> m_componentVersions;
+
+                /**
+                 * Backend that was requested in the constructor, the file is only mapped if this
+                 * is FileReaderBackend::MAPPED
+                 */
+                const FileReaderBackend m_requestedBackend;
+                MappedFile m_mapping;
+
+                /**
+                 * Used by get and getFrame if the file is mapped
+                 */
+                FrameView m_mappedView;
+
+                /**
+                 * Copy of the frame data for frames that aren't aligned inside the file
+                 */
+                std::vector<uint16_t> m_alignedFrameData;
             };
         }
     }
@@ -24,11 +24,14 @@
 #include <processing/ProcessingSimple.hpp>
 
 #include <RoyaleLogger.hpp>
+#include <RoyaleTrace.hpp>
 #include <common/exceptions/RuntimeError.hpp>
 #include <FileSystem.hpp>
 #include <factory/ImagerFactory.hpp>
 #include <common/events/EventCaptureStream.hpp>
 
+#include <algorithm>
+
 using namespace royale;
 using namespace royale::record;
 using namespace royale::processing;
@@ -36,6 +39,14 @@ using namespace royale::common;
 using namespace royale::collector;
 using namespace royale::processing;
 
+namespace
+{
+    /**
+     * Number of frames that are read ahead of the playback, including the current frame
+     */
+    const std::size_t PREFETCH_DEPTH = 4u;
+}
+
 CameraPlayback::CameraPlayback (CameraAccessLevel level, const std::string &filename) :
     CameraDeviceBase (level, "", "UNINITIALIZED CAMERA", nullptr),
     m_captureListener (nullptr),
@@ -48,7 +59,9 @@ CameraPlayback::CameraPlayback (CameraAccessLevel level, const std::string &file
     m_seeked (false),
     m_rangeStart{},
     m_rangeEnd{},
-    m_eventForwarder()
+    m_eventForwarder(),
+    m_prefetchedFrame (nullptr),
+    m_definitionHash (0u)
 {
     m_supportedUseCaseNames.push_back ("MODE_PLAYBACK");
 
@@ -88,6 +101,11 @@ CameraStatus CameraPlayback::initialize()
     try
     {
         m_reader.open (m_filename.toStdString());
+
+        std::unique_ptr<FileReaderDispatcher> prefetchReader (new FileReaderDispatcher (FileReaderBackend::MAPPED));
+        prefetchReader->open (m_filename.toStdString());
+        m_prefetcher.reset (new FramePrefetcher (std::move (prefetchReader), PREFETCH_DEPTH));
+        m_prefetcher->setRange (m_rangeStart, m_rangeEnd, m_loop);
     }
     catch (const std::invalid_argument &)
     {
@@ -273,6 +291,12 @@ CameraStatus CameraPlayback::seek (const uint32_t frameNumber)
 {
     {
         std::lock_guard<std::mutex> lck (m_playbackMutex);
+        // Null if initialize() failed to open the recording
+        if (!m_prefetcher)
+        {
+            return CameraStatus::DEVICE_NOT_INITIALIZED;
+        }
+
         try
         {
             m_reader.seek (frameNumber);
@@ -287,6 +311,7 @@ CameraStatus CameraPlayback::seek (const uint32_t frameNumber)
         }
 
         m_seeked = true;
+        m_prefetcher->restart (frameNumber);
 
         if (!m_isCapturing)
         {
@@ -318,6 +343,10 @@ void CameraPlayback::loop (const bool restart)
 {
     std::lock_guard<std::mutex> lck (m_playbackMutex);
     m_loop = restart;
+    if (m_prefetcher)
+    {
+        m_prefetcher->setRange (m_rangeStart, m_rangeEnd, m_loop);
+    }
 }
 
 void CameraPlayback::useTimestamps (const bool timestampsUsed)
@@ -374,6 +403,10 @@ CameraStatus CameraPlayback::setPlaybackRange (uint32_t first, uint32_t last)
     {
         m_rangeEnd = last;
         m_rangeStart = first;
+        if (m_prefetcher)
+        {
+            m_prefetcher->setRange (m_rangeStart, m_rangeEnd, m_loop);
+        }
         return CameraStatus::SUCCESS;
     }
     else
@@ -417,8 +450,6 @@ namespace
 CameraStatus CameraPlayback::aquisitionFunction()
 {
     bool firstFrame = true;
-    std::vector<std::vector<uint16_t>> frames;
-    std::unique_ptr<royale::usecase::UseCaseDefinition> definition;
     std::chrono::milliseconds currentTimestampRecording;
     std::chrono::milliseconds lastTimestampRecording;
     std::chrono::milliseconds currentTimestampPlayback;
@@ -429,6 +460,7 @@ CameraStatus CameraPlayback::aquisitionFunction()
     std::vector<std::pair<std::string, std::vector<uint8_t>>> additionalData;
     StreamId streamId = 0;
     std::map<StreamId, bool> parametersSetForStream;
+    ROYALE_TRACE_THREAD_NAME ("CameraPlayback");
 
     while (true)
     {
@@ -452,12 +484,11 @@ CameraStatus CameraPlayback::aquisitionFunction()
             timestampsUsed = m_timestampsUsed;
         }
 
-        std::unique_ptr<royale::usecase::UseCaseDefinition> oldDefinition = std::move (definition);
-        readFrame (frames, definition, currentTimestampRecording, illuminationTemperature, m_capturedExposureTimes,
-                   parameterMap, additionalData, streamId);
+        const bool useCaseChanged = readFrame (currentTimestampRecording, illuminationTemperature, m_capturedExposureTimes,
+                                               parameterMap, additionalData, streamId);
+        const auto &definition = m_definition;
 
-        if (!m_ignoreUseCaseChange &&
-                (!oldDefinition || *oldDefinition != *definition || firstFrame))
+        if (!m_ignoreUseCaseChange && (useCaseChanged || firstFrame))
         {
             {
                 std::lock_guard<std::recursive_mutex> lckIds (m_currentUseCaseMutex);
@@ -565,20 +596,7 @@ CameraStatus CameraPlayback::aquisitionFunction()
             std::unique_ptr<CapturedUseCase> cuc{ new CapturedUseCase{ m_pseudoDataInterpreter.get(), illuminationTemperature,
                         std::chrono::duration_cast<std::chrono::microseconds> (currentTimestampRecording), m_capturedExposureTimes } };
 
-            std::vector<ICapturedRawFrame *> recordedFrames;
-            for (auto currentRawData = frames.begin(); currentRawData != frames.end(); ++currentRawData)
-            {
-                RecordedRawFrame *curFrame = new RecordedRawFrame (*currentRawData, columns);
-                recordedFrames.push_back (curFrame);
-            }
-
-            internalCallback (recordedFrames, *definition, std::move (cuc), streamId);
-
-            for (size_t idx = 0; idx < recordedFrames.size(); ++idx)
-            {
-                delete recordedFrames.at (idx);
-            }
-
+            internalCallback (m_recordedFrames, *definition, std::move (cuc), streamId);
         }
         else
         {
@@ -626,6 +644,7 @@ void CameraPlayback::internalCallback (std::vector<ICapturedRawFrame *> &frames,
                                        std::unique_ptr<const CapturedUseCase> capturedCase,
                                        royale::StreamId streamId)
 {
+    ROYALE_TRACE_ZONE ("CameraPlayback::callback");
     if (m_captureListener)
     {
         try
@@ -851,86 +870,103 @@ ROYALE_API uint32_t CameraPlayback::getBuildVersion()
     return m_reader.royaleBuild();
 }
 
-void CameraPlayback::readFrame (std::vector<std::vector<uint16_t>> &frames,
-                                std::unique_ptr<royale::usecase::UseCaseDefinition> &definition,
-                                std::chrono::milliseconds &timestamp,
+bool CameraPlayback::readFrame (std::chrono::milliseconds &timestamp,
                                 float &illuminationTemperature,
                                 std::vector<uint32_t> &capturedExposureTimes,
                                 royale::ProcessingParameterMap &parameterMap,
                                 std::vector<std::pair<std::string, std::vector<uint8_t>>> &additionalData,
                                 royale::StreamId &streamId)
 {
-    RecordUseCaseDefinition recordDefinition;
-
-    std::vector <std::vector<uint16_t>> imageData;
-    std::vector <std::vector<uint16_t>> pseudoData;
-    std::vector <royale_processingparameter_v3> processingParameters;
-
-    m_reader.get (imageData, pseudoData, &recordDefinition.frameHeader, recordDefinition.streams, recordDefinition.frameGroups,
-                  recordDefinition.exposureGroups, recordDefinition.rawFrameSets, processingParameters, additionalData);
-
+    ROYALE_TRACE_ZONE ("CameraPlayback::readFrame");
+    if (m_prefetchedFrame)
     {
-        std::lock_guard<std::recursive_mutex> lckIds (m_currentUseCaseMutex);
-        m_streams.clear();
-        for (auto curStream : recordDefinition.streams)
-        {
-            m_streams.push_back (curStream.streamId);
-        }
+        m_prefetcher->release (*m_prefetchedFrame);
+        m_prefetchedFrame = nullptr;
     }
-
-    streamId = recordDefinition.frameHeader.curStreamId;
-
-    frames.resize (recordDefinition.frameHeader.numRawFrames);
-    for (auto i = 0; i < recordDefinition.frameHeader.numRawFrames; ++i)
+    m_prefetchedFrame = &m_prefetcher->acquire (m_reader.currentFrame());
+
+    const auto &recordDefinition = m_prefetchedFrame->definition;
+    const auto &frameHeader = recordDefinition.frameHeader;
+    streamId = frameHeader.curStreamId;
+    timestamp = std::chrono::milliseconds (frameHeader.timestamp);
+    illuminationTemperature = frameHeader.illuTemperature;
+    // Swapping gives the PrefetchedFrame the previous frame's vectors to read the next frame
+    // into, the reader reuses their capacity
+    additionalData.swap (m_prefetchedFrame->additionalData);
+
+    capturedExposureTimes.resize (frameHeader.numRawFrameSets);
+    for (auto i = 0u; i < frameHeader.numRawFrameSets; ++i)
     {
-        frames.at (i).resize (pseudoData[i].size () + imageData[i].size ());
+        capturedExposureTimes[i] = recordDefinition.rawFrameSets[i].capturedExpTime;
     }
 
-    recordDefinition.rawFrameSets.resize (recordDefinition.frameHeader.numRawFrameSets);
+    const auto definitionHash = m_prefetchedFrame->useCaseHash;
+    const bool definitionChanged = !m_definition || definitionHash != m_definitionHash;
+    if (definitionChanged)
+    {
+        m_definition = common::makeUnique<UseCaseRecord> (recordDefinition);
+        m_definitionHash = definitionHash;
 
-    timestamp = std::chrono::milliseconds (recordDefinition.frameHeader.timestamp);
-    illuminationTemperature = recordDefinition.frameHeader.illuTemperature;
-    capturedExposureTimes.resize (recordDefinition.frameHeader.numRawFrameSets);
+        {
+            std::lock_guard<std::recursive_mutex> lckIds (m_currentUseCaseMutex);
+            m_streams.clear();
+            for (auto curStream : recordDefinition.streams)
+            {
+                m_streams.push_back (curStream.streamId);
+            }
+        }
 
-    for (auto j = 0u; j < recordDefinition.frameHeader.numRawFrames; ++j)
-    {
-        memcpy (&frames[j][0], &pseudoData[j][0], pseudoData[j].size() * sizeof (uint16_t));
-        memcpy (&frames[j][pseudoData[j].size()], &imageData[j][0], imageData[j].size() * sizeof (uint16_t));
+        m_singleFrequencyStreams.clear();
+        for (auto curStreamId : m_definition->getStreamIds())
+        {
+            uint16_t numFreqs = 0u;
+            auto rfsIndexes = m_definition->getRawFrameSetIndices (curStreamId, 0u);
+            for (auto curIndex : rfsIndexes)
+            {
+                if (m_definition->getRawFrameSets() [curIndex].isModulated())
+                {
+                    numFreqs++;
+                }
+            }
+            if (numFreqs == 1)
+            {
+                m_singleFrequencyStreams.push_back (curStreamId);
+            }
+        }
     }
 
-    definition = common::makeUnique<UseCaseRecord> (recordDefinition);
-
-    for (auto i = 0u; i < recordDefinition.frameHeader.numRawFrameSets; ++i)
+    // Each PrefetchedFrame has its own buffer, so the raw frames have to be set up for every frame.
+    // This only allocates memory if the number of raw frames grows.
+    auto &frameData = m_prefetchedFrame->frameData;
+    const uint16_t columns = frameHeader.numColumns;
+    const size_t slotSize = static_cast<size_t> (columns) * (frameHeader.numRows + 1u);
+    m_recordedFrameSlots.clear();
+    m_recordedFrames.clear();
+    for (auto i = 0u; i < frameHeader.numRawFrames; ++i)
     {
-        capturedExposureTimes[i] = recordDefinition.rawFrameSets[i].capturedExpTime;
+        m_recordedFrameSlots.emplace_back (&frameData[i * slotSize], columns);
     }
-
-    uint16_t numFreqs = 0u;
-    auto rfsIndexes = definition->getRawFrameSetIndices (streamId, 0u);
-    for (auto curIndex : rfsIndexes)
+    for (auto &curFrame : m_recordedFrameSlots)
     {
-        if (definition->getRawFrameSets() [curIndex].isModulated())
-        {
-            numFreqs++;
-        }
+        m_recordedFrames.push_back (&curFrame);
     }
 
-    if (recordDefinition.frameHeader.numParameters > 0)
+    const auto &processingParameters = m_prefetchedFrame->processingParameters;
+    for (auto i = 0u; i < frameHeader.numParameters; ++i)
     {
-        for (auto i = 0u; i < recordDefinition.frameHeader.numParameters; ++i)
-        {
-            ProcessingFlag curFlag = static_cast<ProcessingFlag> (processingParameters[i].processingFlag);
-            VariantType curType = static_cast<VariantType> (processingParameters[i].dataType);
-            parameterMap[curFlag] = Variant (curType, processingParameters[i].value);
-        }
+        ProcessingFlag curFlag = static_cast<ProcessingFlag> (processingParameters[i].processingFlag);
+        VariantType curType = static_cast<VariantType> (processingParameters[i].dataType);
+        parameterMap[curFlag] = Variant (curType, processingParameters[i].value);
     }
 
-    if (numFreqs == 1)
+    if (std::find (m_singleFrequencyStreams.begin(), m_singleFrequencyStreams.end(), streamId) != m_singleFrequencyStreams.end())
     {
         // Old recordings don't have this flag set which causes the configuration of Spectre
         // to break
         parameterMap[ProcessingFlag::UseFilter2Freq_Bool] = false;
     }
+
+    return definitionChanged;
 }
 
 royale::CameraStatus CameraPlayback::shiftLensCenter (int16_t tx, int16_t ty) ROYALE_API_EXCEPTION_SAFE_BEGIN
@@ -15,6 +15,7 @@
 
 #include <MakeUnique.hpp>
 #include <NarrowCast.hpp>
+#include <RoyaleTrace.hpp>
 #include <factory/ImagerFactory.hpp>
 
 using namespace royale::record;
@@ -127,6 +128,7 @@ void CameraRecord::captureCallback (std::vector<ICapturedRawFrame *> &frames,
                                     royale::StreamId streamId,
                                     std::unique_ptr<const CapturedUseCase> capturedCase)
 {
+    ROYALE_TRACE_ZONE ("CameraRecord::captureCallback");
     bool stopRecording = false;
     {
         std::lock_guard<std::mutex> lck (m_mutex);
@@ -204,6 +206,7 @@ void CameraRecord::putFrame (const std::vector<ICapturedRawFrame *> &frames,
                              const CapturedUseCase &capturedCase,
                              const ProcessingParameterMap &parameterMap)
 {
+    ROYALE_TRACE_ZONE ("CameraRecord::putFrame");
     royale_frameheader_v3 frameHeader;
 
     // Fill frame header
@@ -16,7 +16,8 @@ using namespace royale::record;
 FileReaderBase::FileReaderBase() :
     m_file (nullptr),
     m_maxSensorWidth (0),
-    m_maxSensorHeight (0)
+    m_maxSensorHeight (0),
+    m_viewFrameHeader {}
 {
 }
 
@@ -25,6 +26,63 @@ FileReaderBase::~FileReaderBase()
     m_file = nullptr;
 }
 
+void FileReaderBase::getFrame (std::vector<uint16_t> &frameData,
+                               royale_frameheader_v3 *frameHeader,
+                               std::vector <royale_streamheader_v3> &streamHeaders,
+                               std::vector <royale_framegroupheader_v3> &frameGroupHeaders,
+                               std::vector <royale_exposuregroupheader_v3> &exposureGroupHeaders,
+                               std::vector <royale_rawframesetheader_v3> &rawFrameSetHeaders,
+                               std::vector <royale_processingparameter_v3> &processingParameters,
+                               std::vector<std::pair<std::string, std::vector<uint8_t>>> &additionalData)
+{
+    get (m_imageDataBuffer, m_pseudoDataBuffer, frameHeader, streamHeaders, frameGroupHeaders,
+         exposureGroupHeaders, rawFrameSetHeaders, processingParameters, additionalData);
+
+    const size_t slotSize = frameHeader->numColumns * (frameHeader->numRows + 1u);
+    frameData.resize (slotSize * frameHeader->numRawFrames);
+    for (size_t i = 0u; i < frameHeader->numRawFrames; ++i)
+    {
+        const auto &pseudoData = m_pseudoDataBuffer[i];
+        const auto &imageData = m_imageDataBuffer[i];
+        memcpy (&frameData[i * slotSize], pseudoData.data(), pseudoData.size() * sizeof (uint16_t));
+        memcpy (&frameData[i * slotSize + frameHeader->numColumns], imageData.data(), imageData.size() * sizeof (uint16_t));
+    }
+}
+
+void FileReaderBase::getFrameView (FrameView &view)
+{
+    getFrame (m_viewFrameData, &m_viewFrameHeader, m_viewStreamHeaders, m_viewFrameGroupHeaders,
+              m_viewExposureGroupHeaders, m_viewRawFrameSetHeaders, m_viewProcessingParameters, m_viewAdditionalData);
+
+    view.frameHeader = &m_viewFrameHeader;
+    view.streamHeaders = m_viewStreamHeaders.data();
+    view.frameGroupHeaders = m_viewFrameGroupHeaders.data();
+    view.exposureGroupHeaders = m_viewExposureGroupHeaders.data();
+    view.rawFrameSetHeaders = m_viewRawFrameSetHeaders.data();
+    view.frameData = m_viewFrameData.data();
+    view.processingParameters = m_viewProcessingParameters.data();
+
+    view.additionalData.resize (m_viewAdditionalData.size());
+    for (size_t i = 0u; i < m_viewAdditionalData.size(); ++i)
+    {
+        const auto &curData = m_viewAdditionalData[i];
+        view.additionalData[i].name = curData.first.data();
+        view.additionalData[i].data = curData.second.data();
+        view.additionalData[i].size = curData.second.size();
+    }
+}
+
+FileReaderBackend FileReaderBase::backend() const
+{
+    return FileReaderBackend::BUFFERED;
+}
+
+void FileReaderBase::adviseWillNeed (uint32_t firstFrame, uint32_t numFrames)
+{
+    (void) firstFrame;
+    (void) numFrames;
+}
+
 std::string FileReaderBase::imagerSerial() const
 {
     FILE_OPEN_CHECK
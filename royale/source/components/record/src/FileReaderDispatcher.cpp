@@ -42,9 +42,15 @@ namespace
 }
 
 FileReaderDispatcher::FileReaderDispatcher() :
+    FileReaderDispatcher (FileReaderBackend::BUFFERED)
+{
+}
+
+FileReaderDispatcher::FileReaderDispatcher (FileReaderBackend backend) :
     FileReaderBase(),
     m_fileReader (nullptr),
-    m_fileVersion (0)
+    m_fileVersion (0),
+    m_backend (backend)
 {
 }
 
@@ -104,7 +110,7 @@ void FileReaderDispatcher::open (const std::string &filename)
             m_fileReader = new v2::FileReader();
             break;
         case 3:
-            m_fileReader = new v3::FileReader();
+            m_fileReader = new v3::FileReader (m_backend);
             break;
         default:
             throw (std::logic_error ("Version not supported"));
@@ -223,6 +229,38 @@ void FileReaderDispatcher::get (std::vector <std::vector<uint16_t>> &imageData,
                               frameGroupHeaders, exposureGroupHeaders, rawFrameSetHeaders, processingParameters, additionalData);
 }
 
+void FileReaderDispatcher::getFrame (std::vector<uint16_t> &frameData,
+                                     royale_frameheader_v3 *frameHeader,
+                                     std::vector <royale_streamheader_v3> &streamHeaders,
+                                     std::vector <royale_framegroupheader_v3> &frameGroupHeaders,
+                                     std::vector <royale_exposuregroupheader_v3> &exposureGroupHeaders,
+                                     std::vector <royale_rawframesetheader_v3> &rawFrameSetHeaders,
+                                     std::vector <royale_processingparameter_v3> &processingParameters,
+                                     std::vector<std::pair<std::string, std::vector<uint8_t>>> &additionalData)
+{
+    READER_OPEN_CHECK;
+    return m_fileReader->getFrame (frameData, frameHeader, streamHeaders, frameGroupHeaders,
+                                   exposureGroupHeaders, rawFrameSetHeaders, processingParameters, additionalData);
+}
+
+void FileReaderDispatcher::getFrameView (FrameView &view)
+{
+    READER_OPEN_CHECK;
+    m_fileReader->getFrameView (view);
+}
+
+FileReaderBackend FileReaderDispatcher::backend() const
+{
+    READER_OPEN_CHECK;
+    return m_fileReader->backend();
+}
+
+void FileReaderDispatcher::adviseWillNeed (uint32_t firstFrame, uint32_t numFrames)
+{
+    READER_OPEN_CHECK;
+    m_fileReader->adviseWillNeed (firstFrame, numFrames);
+}
+
 std::vector<royale_versioninformation_v3> FileReaderDispatcher::getComponentVersions() const
 {
     READER_OPEN_CHECK;
@@ -0,0 +1,229 @@
+/****************************************************************************\
+ * Copyright (C) 2019 pmdtechnologies ag
+ *
+ * THIS CODE AND INFORMATION ARE PROVIDED "AS IS" WITHOUT WARRANTY OF ANY
+ * KIND, EITHER EXPRESSED OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND/OR FITNESS FOR A
+ * PARTICULAR PURPOSE.
+ *
+ \****************************************************************************/
+
+#include <record/FramePrefetcher.hpp>
+
+#include <RoyaleTrace.hpp>
+
+#include <algorithm>
+#include <stdexcept>
+
+using namespace royale;
+using namespace royale::record;
+
+FramePrefetcher::FramePrefetcher (std::unique_ptr<FileReaderBase> reader, std::size_t depth) :
+    m_reader (std::move (reader)),
+    m_numFrames (m_reader->numFrames()),
+    m_readyHead (0u),
+    m_readyCount (0u),
+    m_rangeStart (0u),
+    m_rangeEnd (0u),
+    m_loop (true),
+    m_nextRead (0u),
+    m_atEnd (true),
+    m_reading (false),
+    m_readingFrame (0u),
+    m_generation (0u),
+    m_stop (false)
+{
+    depth = std::max<std::size_t> (depth, 2u);
+    m_frames.resize (depth);
+    m_free.reserve (depth);
+    m_ready.resize (depth);
+    for (auto &frame : m_frames)
+    {
+        frame.reset (new PrefetchedFrame());
+        m_free.push_back (frame.get());
+    }
+
+    m_thread = std::thread (&FramePrefetcher::readThread, this);
+}
+
+FramePrefetcher::~FramePrefetcher()
+{
+    {
+        std::lock_guard<std::mutex> lock (m_lock);
+        m_stop = true;
+    }
+    m_readCondition.notify_all();
+    m_readyCondition.notify_all();
+    m_thread.join();
+}
+
+void FramePrefetcher::setRange (uint32_t first, uint32_t last, bool loop)
+{
+    std::lock_guard<std::mutex> lock (m_lock);
+    m_rangeStart = first;
+    m_rangeEnd = last;
+    m_loop = loop;
+}
+
+void FramePrefetcher::restart (uint32_t frameNumber)
+{
+    {
+        std::lock_guard<std::mutex> lock (m_lock);
+        flush();
+        m_generation++;
+        m_nextRead = frameNumber;
+        m_atEnd = false;
+        m_reading = false;
+    }
+    m_readCondition.notify_all();
+}
+
+PrefetchedFrame &FramePrefetcher::acquire (uint32_t frameNumber)
+{
+    ROYALE_TRACE_ZONE ("FramePrefetcher::acquire");
+    std::unique_lock<std::mutex> lock (m_lock);
+
+    // If the frame isn't the one that will be at the front of the queue, the playback didn't
+    // follow the expected order
+    bool isNext;
+    if (m_readyCount > 0u)
+    {
+        isNext = m_ready[m_readyHead]->frameNumber == frameNumber;
+    }
+    else if (m_reading)
+    {
+        isNext = m_readingFrame == frameNumber;
+    }
+    else
+    {
+        isNext = !m_atEnd && m_nextRead == frameNumber;
+    }
+    if (!isNext)
+    {
+        flush();
+        m_generation++;
+        m_nextRead = frameNumber;
+        m_atEnd = false;
+        m_reading = false;
+        m_readCondition.notify_all();
+    }
+
+    m_readyCondition.wait (lock, [this] { return m_stop || m_readyCount > 0u; });
+    if (m_stop)
+    {
+        throw std::runtime_error ("The frame prefetcher has been stopped");
+    }
+
+    auto frame = m_ready[m_readyHead];
+    m_readyHead = (m_readyHead + 1u) % m_ready.size();
+    m_readyCount--;
+
+    if (frame->error)
+    {
+        const auto error = frame->error;
+        frame->error = nullptr;
+        m_free.push_back (frame);
+        m_readCondition.notify_all();
+        std::rethrow_exception (error);
+    }
+
+    return *frame;
+}
+
+void FramePrefetcher::release (PrefetchedFrame &frame)
+{
+    {
+        std::lock_guard<std::mutex> lock (m_lock);
+        m_free.push_back (&frame);
+    }
+    m_readCondition.notify_all();
+}
+
+bool FramePrefetcher::nextFrame (uint32_t frame, uint32_t &next) const
+{
+    const auto rangeEnd = (m_rangeEnd == 0u || m_rangeEnd > m_numFrames) ? m_numFrames : m_rangeEnd;
+    next = frame + 1u;
+    if (next < rangeEnd)
+    {
+        return true;
+    }
+    next = m_rangeStart;
+    return m_loop && m_rangeStart < rangeEnd;
+}
+
+void FramePrefetcher::flush()
+{
+    while (m_readyCount > 0u)
+    {
+        m_free.push_back (m_ready[m_readyHead]);
+        m_readyHead = (m_readyHead + 1u) % m_ready.size();
+        m_readyCount--;
+    }
+}
+
+void FramePrefetcher::readThread()
+{
+    ROYALE_TRACE_THREAD_NAME ("FramePrefetcher");
+
+    std::unique_lock<std::mutex> lock (m_lock);
+    while (true)
+    {
+        m_readCondition.wait (lock, [this] { return m_stop || (!m_atEnd && !m_free.empty()); });
+        if (m_stop)
+        {
+            return;
+        }
+
+        auto frame = m_free.back();
+        m_free.pop_back();
+        frame->frameNumber = m_nextRead;
+        frame->generation = m_generation;
+        m_reading = true;
+        m_readingFrame = m_nextRead;
+        m_atEnd = !nextFrame (m_nextRead, m_nextRead);
+        const auto adviseFrom = m_nextRead;
+        const auto adviseCount = static_cast<uint32_t> (m_frames.size());
+
+        lock.unlock();
+        {
+            ROYALE_TRACE_ZONE ("FramePrefetcher::read");
+            try
+            {
+                auto &definition = frame->definition;
+                m_reader->seek (frame->frameNumber);
+                m_reader->getFrame (frame->frameData, &definition.frameHeader, definition.streams,
+                                    definition.frameGroups, definition.exposureGroups, definition.rawFrameSets,
+                                    frame->processingParameters, frame->additionalData);
+                definition.rawFrameSets.resize (definition.frameHeader.numRawFrameSets);
+                frame->useCaseHash = calculateUseCaseHash (definition);
+
+                // Let the OS read the following frames while this one is processed
+                m_reader->adviseWillNeed (adviseFrom, adviseCount);
+            }
+            catch (...)
+            {
+                frame->error = std::current_exception();
+            }
+        }
+        lock.lock();
+
+        if (frame->generation != m_generation)
+        {
+            // Dropped by a restart, which also cleared m_reading
+            frame->error = nullptr;
+            m_free.push_back (frame);
+            continue;
+        }
+
+        m_reading = false;
+        if (frame->error)
+        {
+            // Don't read ahead after a failure, acquire will restart if needed
+            m_atEnd = true;
+        }
+
+        m_ready[ (m_readyHead + m_readyCount) % m_ready.size()] = frame;
+        m_readyCount++;
+        m_readyCondition.notify_all();
+    }
+}
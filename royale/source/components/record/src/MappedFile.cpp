@@ -0,0 +1,148 @@
+/****************************************************************************\
+ * Copyright (C) 2019 pmdtechnologies ag
+ *
+ * THIS CODE AND INFORMATION ARE PROVIDED "AS IS" WITHOUT WARRANTY OF ANY
+ * KIND, EITHER EXPRESSED OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND/OR FITNESS FOR A
+ * PARTICULAR PURPOSE.
+ *
+ \****************************************************************************/
+
+#include <record/MappedFile.hpp>
+
+#include <algorithm>
+#include <limits>
+#include <stdexcept>
+
+#if defined(ROYALE_TARGET_PLATFORM_WINDOWS)
+#include <io.h>
+#include <windows.h>
+#elif defined(ROYALE_TARGET_PLATFORM_LINUX) || defined(ROYALE_TARGET_PLATFORM_ANDROID) || defined(ROYALE_TARGET_PLATFORM_APPLE)
+#include <sys/mman.h>
+#include <sys/stat.h>
+#define ROYALE_RRF_MMAP
+#endif
+
+using namespace royale;
+using namespace royale::record;
+
+const uint64_t MappedFile::DEFAULT_MAX_SIZE = sizeof (void *) < 8u ? (uint64_t (1u) << 30) : (std::numeric_limits<uint64_t>::max)();
+
+MappedFile::MappedFile() :
+    m_data (nullptr),
+    m_size (0u)
+#ifdef ROYALE_TARGET_PLATFORM_WINDOWS
+    , m_mapping (nullptr)
+#endif
+{
+}
+
+MappedFile::~MappedFile()
+{
+    unmap();
+}
+
+bool MappedFile::map (FILE *file, uint64_t maxSize)
+{
+    unmap();
+
+    if (!file)
+    {
+        return false;
+    }
+
+    maxSize = (std::min) (maxSize, static_cast<uint64_t> ((std::numeric_limits<size_t>::max)()));
+
+#if defined(ROYALE_TARGET_PLATFORM_WINDOWS)
+    auto handle = reinterpret_cast<HANDLE> (_get_osfhandle (_fileno (file)));
+    LARGE_INTEGER fileSize;
+    if (handle == INVALID_HANDLE_VALUE ||
+            GetFileType (handle) != FILE_TYPE_DISK ||
+            !GetFileSizeEx (handle, &fileSize) ||
+            fileSize.QuadPart <= 0 ||
+            static_cast<uint64_t> (fileSize.QuadPart) > maxSize)
+    {
+        return false;
+    }
+
+    m_mapping = CreateFileMapping (handle, nullptr, PAGE_READONLY, 0, 0, nullptr);
+    if (!m_mapping)
+    {
+        return false;
+    }
+
+    m_data = static_cast<const uint8_t *> (MapViewOfFile (m_mapping, FILE_MAP_READ, 0, 0, 0));
+    if (!m_data)
+    {
+        CloseHandle (m_mapping);
+        m_mapping = nullptr;
+        return false;
+    }
+    m_size = static_cast<uint64_t> (fileSize.QuadPart);
+    return true;
+#elif defined(ROYALE_RRF_MMAP)
+    // fstat fails with EOVERFLOW for files that are too big for this process, which is handled
+    // like every other file that can't be mapped
+    const auto fd = fileno (file);
+    struct stat info;
+    if (fstat (fd, &info) != 0 ||
+            !S_ISREG (info.st_mode) ||
+            info.st_size <= 0 ||
+            static_cast<uint64_t> (info.st_size) > maxSize)
+    {
+        return false;
+    }
+
+    const auto length = static_cast<size_t> (info.st_size);
+    void *data = mmap (nullptr, length, PROT_READ, MAP_PRIVATE, fd, 0);
+    if (data == MAP_FAILED)
+    {
+        return false;
+    }
+
+    m_data = static_cast<const uint8_t *> (data);
+    m_size = length;
+    return true;
+#else
+    (void) maxSize;
+    return false;
+#endif
+}
+
+void MappedFile::unmap()
+{
+    if (!m_data)
+    {
+        return;
+    }
+
+#if defined(ROYALE_TARGET_PLATFORM_WINDOWS)
+    UnmapViewOfFile (m_data);
+    CloseHandle (m_mapping);
+    m_mapping = nullptr;
+#elif defined(ROYALE_RRF_MMAP)
+    munmap (const_cast<uint8_t *> (m_data), static_cast<size_t> (m_size));
+#endif
+
+    m_data = nullptr;
+    m_size = 0u;
+}
+
+bool MappedFile::isMapped() const
+{
+    return m_data != nullptr;
+}
+
+uint64_t MappedFile::size() const
+{
+    return m_size;
+}
+
+const uint8_t *MappedFile::at (uint64_t offset, uint64_t length) const
+{
+    if (!m_data || offset > m_size || length > m_size - offset)
+    {
+        throw std::out_of_range ("Read outside of the mapped file");
+    }
+    return m_data + offset;
+}
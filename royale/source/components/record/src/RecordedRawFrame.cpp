@@ -20,6 +20,12 @@ RecordedRawFrame::RecordedRawFrame (std::vector<uint16_t> &data, const uint16_t
     m_imageData = &data[columns];
 }
 
+RecordedRawFrame::RecordedRawFrame (uint16_t *data, uint16_t columns) :
+    m_imageData (data + columns),
+    m_pseudoData (data)
+{
+}
+
 RecordedRawFrame::~RecordedRawFrame()
 {
 }
@@ -13,6 +13,7 @@
 #include <stdint.h>
 #include <common/exceptions/RuntimeError.hpp>
 
+#include <algorithm>
 #include <cstring>
 #include <iomanip>
 #include <iostream>
@@ -23,6 +24,108 @@ using namespace royale::common;
 using namespace royale::usecase;
 using namespace royale::record;
 
+namespace
+{
+    /**
+     * 64-bit FNV-1a
+     */
+    class UseCaseHash
+    {
+    public:
+        UseCaseHash() :
+            m_hash (14695981039346656037ull)
+        {
+        }
+
+        void add (const void *data, size_t size)
+        {
+            const auto bytes = static_cast<const uint8_t *> (data);
+            for (size_t i = 0u; i < size; ++i)
+            {
+                m_hash ^= bytes[i];
+                m_hash *= 1099511628211ull;
+            }
+        }
+
+        template<typename T>
+        void add (const T &value)
+        {
+            add (&value, sizeof (T));
+        }
+
+        void addString (const char *str, size_t maxLength)
+        {
+            const auto length = strnlen (str, maxLength);
+            add (length);
+            add (str, length);
+        }
+
+        template<typename T, size_t N>
+        void addArray (const T (&values) [N], size_t count)
+        {
+            add (values, std::min (count, N) * sizeof (T));
+        }
+
+        uint64_t get() const
+        {
+            return m_hash;
+        }
+
+    private:
+        uint64_t m_hash;
+    };
+}
+
+uint64_t royale::record::calculateUseCaseHash (const RecordUseCaseDefinition &definition)
+{
+    UseCaseHash hash;
+
+    const auto &frameHeader = definition.frameHeader;
+    hash.addString (frameHeader.useCaseName, ROYALE_FILEHEADER_V3_USE_CASE_LENGTH);
+    hash.add (frameHeader.targetFrameRate);
+    hash.add (frameHeader.numColumns);
+    hash.add (frameHeader.numRows);
+    hash.add (frameHeader.numRawFrames);
+
+    hash.add (definition.streams.size());
+    for (const auto &curStream : definition.streams)
+    {
+        hash.add (curStream.streamId);
+        hash.add (curStream.numFrameGroups);
+        hash.addArray (curStream.frameGroupIdxs, curStream.numFrameGroups);
+    }
+
+    hash.add (definition.frameGroups.size());
+    for (const auto &curFrameGroup : definition.frameGroups)
+    {
+        hash.add (curFrameGroup.numRawFrameSets);
+        hash.addArray (curFrameGroup.rawFrameSetIdxs, curFrameGroup.numRawFrameSets);
+    }
+
+    hash.add (definition.exposureGroups.size());
+    for (const auto &curExpoGroup : definition.exposureGroups)
+    {
+        hash.addString (curExpoGroup.exposureGroupName, ROYALE_FILEHEADER_V3_EXPOSUREGROUP_NAME_LENGTH);
+        hash.add (curExpoGroup.exposureMin);
+        hash.add (curExpoGroup.exposureMax);
+        hash.add (curExpoGroup.exposureTime);
+    }
+
+    hash.add (definition.rawFrameSets.size());
+    for (const auto &curRawFrameSet : definition.rawFrameSets)
+    {
+        hash.add (curRawFrameSet.modFreq);
+        hash.add (curRawFrameSet.phaseDefinition);
+        hash.add (curRawFrameSet.numRawFrames);
+        hash.add (curRawFrameSet.dutyCycle);
+        hash.add (curRawFrameSet.alignment);
+        hash.add (curRawFrameSet.exposureGroupIdx);
+        hash.add (curRawFrameSet.eyeSafetyGap);
+    }
+
+    return hash.get();
+}
+
 //! generate custom definition for recordings
 UseCaseRecord::UseCaseRecord (const RecordUseCaseDefinition &definition)
 {
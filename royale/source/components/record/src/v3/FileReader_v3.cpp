@@ -10,13 +10,54 @@
 
 #include <record/v3/FileReader.hpp>
 
+#if defined(ROYALE_TARGET_PLATFORM_LINUX) || defined(ROYALE_TARGET_PLATFORM_ANDROID)
+#include <fcntl.h>
+#include <limits>
+#define ROYALE_RRF_FADVISE
+#endif
+
 using namespace royale;
 using namespace royale::record;
 
-v3::FileReader::FileReader() :
+namespace
+{
+    /**
+     * Walks through the sections of a mapped frame, and checks that none of them exceeds the
+     * frame size.
+     */
+    class FrameCursor
+    {
+    public:
+        FrameCursor (const uint8_t *frame, uint64_t frameSize, uint64_t position) :
+            m_frame (frame),
+            m_frameSize (frameSize),
+            m_position (position)
+        {
+        }
+
+        const uint8_t *take (uint64_t size)
+        {
+            if (size > m_frameSize - m_position)
+            {
+                throw (std::runtime_error ("Frame corrupted"));
+            }
+            auto data = m_frame + m_position;
+            m_position += size;
+            return data;
+        }
+
+    private:
+        const uint8_t *m_frame;
+        const uint64_t m_frameSize;
+        uint64_t m_position;
+    };
+}
+
+v3::FileReader::FileReader (FileReaderBackend backend) :
     FileReaderBase(),
     m_currentFrame (0),
-    m_fileHeader {}
+    m_fileHeader {},
+    m_requestedBackend (backend)
 {
 }
 
@@ -36,6 +77,11 @@ void v3::FileReader::open (const std::string &filename)
                                       + std::string (strerror_royale_rrf (fopenerror))));
     }
 
+#ifdef ROYALE_RRF_FADVISE
+    // Recordings are mostly read from the start to the end
+    posix_fadvise (fileno (m_file), 0, 0, POSIX_FADV_SEQUENTIAL);
+#endif
+
     fseek64_royale_rrf (m_file, 0, SEEK_SET);
 
     size_t elementsRead = fread (&m_fileHeader, sizeof (royale_fileheader_v3), 1, m_file);
@@ -104,6 +150,12 @@ void v3::FileReader::open (const std::string &filename)
         close();
         throw (std::length_error ("No frames in the recording"));
     }
+
+    if (m_requestedBackend == FileReaderBackend::MAPPED)
+    {
+        // If this fails the frames are read with fread
+        m_mapping.map (m_file);
+    }
 }
 
 void v3::FileReader::close()
@@ -117,6 +169,8 @@ void v3::FileReader::close()
 
     memset (&m_fileHeader, 0, sizeof (royale_fileheader_v3));
 
+    m_mapping.unmap();
+
     if (m_file)
     {
         fclose (m_file);
@@ -264,13 +318,26 @@ void v3::FileReader::get (std::vector <std::vector<uint16_t>> &imageData,
                           std::vector <royale_processingparameter_v3> &processingParameters,
                           std::vector<std::pair<std::string, std::vector<uint8_t>>> &additionalData)
 {
-    auto offset = m_offsetMap[m_currentFrame];
-    if (fseek64_royale_rrf (m_file, offset, SEEK_SET))
+    if (m_mapping.isMapped())
     {
-        throw (std::invalid_argument ("Get: OffsetMap corrupted"));
+        viewMappedFrame (m_mappedView);
+        copyViewHeaders (m_mappedView, frameHeader, streamHeaders, frameGroupHeaders, exposureGroupHeaders,
+                         rawFrameSetHeaders, processingParameters, additionalData);
+
+        const size_t numColumns = frameHeader->numColumns;
+        const size_t slotSize = numColumns * (frameHeader->numRows + 1u);
+        imageData.resize (frameHeader->numRawFrames);
+        pseudoData.resize (frameHeader->numRawFrames);
+        for (size_t i = 0u; i < frameHeader->numRawFrames; ++i)
+        {
+            const auto slot = m_mappedView.frameData + i * slotSize;
+            pseudoData[i].assign (slot, slot + numColumns);
+            imageData[i].assign (slot + numColumns, slot + slotSize);
+        }
+        return;
     }
 
-    fread_checked (frameHeader, sizeof (royale_frameheader_v3), 1, m_file);
+    readFrameHeaders (frameHeader, streamHeaders, frameGroupHeaders, exposureGroupHeaders, rawFrameSetHeaders);
 
     imageData.resize (frameHeader->numRawFrames);
     pseudoData.resize (frameHeader->numRawFrames);
@@ -280,6 +347,62 @@ void v3::FileReader::get (std::vector <std::vector<uint16_t>> &imageData,
         imageData.at (i).resize (frameHeader->numColumns * frameHeader->numRows);
     }
 
+    for (uint16_t j = 0u; j < frameHeader->numRawFrames; ++j)
+    {
+        fread_checked (&pseudoData[j][0], pseudoData[j].size() * sizeof (uint16_t), 1, m_file);
+        fread_checked (&imageData[j][0], imageData[j].size() * sizeof (uint16_t), 1, m_file);
+    }
+
+    readFrameTrailer (frameHeader, processingParameters, additionalData);
+}
+
+void v3::FileReader::getFrame (std::vector<uint16_t> &frameData,
+                               royale_frameheader_v3 *frameHeader,
+                               std::vector <royale_streamheader_v3> &streamHeaders,
+                               std::vector <royale_framegroupheader_v3> &frameGroupHeaders,
+                               std::vector <royale_exposuregroupheader_v3> &exposureGroupHeaders,
+                               std::vector <royale_rawframesetheader_v3> &rawFrameSetHeaders,
+                               std::vector <royale_processingparameter_v3> &processingParameters,
+                               std::vector<std::pair<std::string, std::vector<uint8_t>>> &additionalData)
+{
+    if (m_mapping.isMapped())
+    {
+        viewMappedFrame (m_mappedView);
+        copyViewHeaders (m_mappedView, frameHeader, streamHeaders, frameGroupHeaders, exposureGroupHeaders,
+                         rawFrameSetHeaders, processingParameters, additionalData);
+
+        const auto frameDataSize = static_cast<size_t> (frameHeader->numColumns) * (frameHeader->numRows + 1u) * frameHeader->numRawFrames;
+        frameData.assign (m_mappedView.frameData, m_mappedView.frameData + frameDataSize);
+        return;
+    }
+
+    readFrameHeaders (frameHeader, streamHeaders, frameGroupHeaders, exposureGroupHeaders, rawFrameSetHeaders);
+
+    // The file already contains the pseudo data line followed by the image for each raw frame,
+    // so all raw frames can be read at once
+    frameData.resize (static_cast<size_t> (frameHeader->numColumns) * (frameHeader->numRows + 1u) * frameHeader->numRawFrames);
+    if (!frameData.empty())
+    {
+        fread_checked (&frameData[0], frameData.size() * sizeof (uint16_t), 1, m_file);
+    }
+
+    readFrameTrailer (frameHeader, processingParameters, additionalData);
+}
+
+void v3::FileReader::readFrameHeaders (royale_frameheader_v3 *frameHeader,
+                                       std::vector <royale_streamheader_v3> &streamHeaders,
+                                       std::vector <royale_framegroupheader_v3> &frameGroupHeaders,
+                                       std::vector <royale_exposuregroupheader_v3> &exposureGroupHeaders,
+                                       std::vector <royale_rawframesetheader_v3> &rawFrameSetHeaders)
+{
+    auto offset = m_offsetMap[m_currentFrame];
+    if (fseek64_royale_rrf (m_file, offset, SEEK_SET))
+    {
+        throw (std::invalid_argument ("Get: OffsetMap corrupted"));
+    }
+
+    fread_checked (frameHeader, sizeof (royale_frameheader_v3), 1, m_file);
+
     streamHeaders.resize (frameHeader->numStreams);
     for (uint16_t i = 0u; i < frameHeader->numStreams; ++i)
     {
@@ -307,20 +430,18 @@ void v3::FileReader::get (std::vector <std::vector<uint16_t>> &imageData,
     {
         fread_checked (&rawFrameSetHeaders[i], sizeof (royale_rawframesetheader_v3), 1, m_file);
     }
+}
 
-    for (uint16_t j = 0u; j < frameHeader->numRawFrames; ++j)
-    {
-        fread_checked (&pseudoData[j][0], pseudoData[j].size() * sizeof (uint16_t), 1, m_file);
-        fread_checked (&imageData[j][0], imageData[j].size() * sizeof (uint16_t), 1, m_file);
-    }
-
-    if (frameHeader->numParameters > 0u)
+void v3::FileReader::readFrameTrailer (const royale_frameheader_v3 *frameHeader,
+                                       std::vector <royale_processingparameter_v3> &processingParameters,
+                                       std::vector<std::pair<std::string, std::vector<uint8_t>>> &additionalData)
+{
+    // Also resized if there are no parameters, otherwise the parameters of the previous frame
+    // would be returned again
+    processingParameters.resize (frameHeader->numParameters);
+    for (uint32_t i = 0u; i < frameHeader->numParameters; ++i)
     {
-        processingParameters.resize (frameHeader->numParameters);
-        for (uint32_t i = 0u; i < frameHeader->numParameters; ++i)
-        {
-            fread_checked (&processingParameters[i], sizeof (royale_processingparameter_v3), 1, m_file);
-        }
+        fread_checked (&processingParameters[i], sizeof (royale_processingparameter_v3), 1, m_file);
     }
 
     if (frameHeader->numAdditionalData > 0u)
@@ -344,6 +465,123 @@ void v3::FileReader::get (std::vector <std::vector<uint16_t>> &imageData,
     }
 }
 
+void v3::FileReader::getFrameView (FrameView &view)
+{
+    if (m_mapping.isMapped())
+    {
+        viewMappedFrame (view);
+    }
+    else
+    {
+        FileReaderBase::getFrameView (view);
+    }
+}
+
+FileReaderBackend v3::FileReader::backend() const
+{
+    return m_mapping.isMapped() ? FileReaderBackend::MAPPED : FileReaderBackend::BUFFERED;
+}
+
+void v3::FileReader::viewMappedFrame (FrameView &view)
+{
+    const auto offset = m_offsetMap[m_currentFrame];
+    auto frameHeader = reinterpret_cast<const royale_frameheader_v3 *> (m_mapping.at (offset, sizeof (royale_frameheader_v3)));
+
+    // The offset map was built from the frame sizes, so all sections of the frame have to be
+    // inside frameSize.  A truncated frame is reported like a failing fread.
+    const uint64_t frameSize = frameHeader->frameSize;
+    if (frameSize < sizeof (royale_frameheader_v3) || frameSize > m_mapping.size() - offset)
+    {
+        throw (std::runtime_error ("Frame corrupted"));
+    }
+    FrameCursor cursor (m_mapping.at (offset, frameSize), frameSize, sizeof (royale_frameheader_v3));
+
+    // The headers are packed structs, so there are no alignment requirements for them
+    view.frameHeader = frameHeader;
+    view.streamHeaders = reinterpret_cast<const royale_streamheader_v3 *> (
+                             cursor.take (frameHeader->numStreams * sizeof (royale_streamheader_v3)));
+    view.frameGroupHeaders = reinterpret_cast<const royale_framegroupheader_v3 *> (
+                                 cursor.take (frameHeader->numFrameGroups * sizeof (royale_framegroupheader_v3)));
+    view.exposureGroupHeaders = reinterpret_cast<const royale_exposuregroupheader_v3 *> (
+                                    cursor.take (frameHeader->numExposureGroups * sizeof (royale_exposuregroupheader_v3)));
+    view.rawFrameSetHeaders = reinterpret_cast<const royale_rawframesetheader_v3 *> (
+                                  cursor.take (frameHeader->numRawFrameSets * sizeof (royale_rawframesetheader_v3)));
+
+    const auto frameDataSize = static_cast<uint64_t> (frameHeader->numColumns) * (frameHeader->numRows + 1u) * frameHeader->numRawFrames;
+    const auto frameData = cursor.take (frameDataSize * sizeof (uint16_t));
+    if (reinterpret_cast<uintptr_t> (frameData) % alignof (uint16_t))
+    {
+        // Additional data of an odd size moves the following frames to odd offsets
+        m_alignedFrameData.resize (static_cast<size_t> (frameDataSize));
+        memcpy (m_alignedFrameData.data(), frameData, static_cast<size_t> (frameDataSize * sizeof (uint16_t)));
+        view.frameData = m_alignedFrameData.data();
+    }
+    else
+    {
+        view.frameData = reinterpret_cast<const uint16_t *> (frameData);
+    }
+
+    view.processingParameters = reinterpret_cast<const royale_processingparameter_v3 *> (
+                                    cursor.take (static_cast<uint64_t> (frameHeader->numParameters) * sizeof (royale_processingparameter_v3)));
+
+    view.additionalData.resize (frameHeader->numAdditionalData);
+    for (auto &curData : view.additionalData)
+    {
+        curData.name = reinterpret_cast<const char *> (cursor.take (ROYALE_FILEHEADER_V3_ADDITIONAL_DATA_NAME_LENGTH));
+        memcpy (&curData.size, cursor.take (sizeof (uint64_t)), sizeof (uint64_t));
+        curData.data = cursor.take (curData.size);
+    }
+}
+
+void v3::FileReader::copyViewHeaders (const FrameView &view,
+                                      royale_frameheader_v3 *frameHeader,
+                                      std::vector <royale_streamheader_v3> &streamHeaders,
+                                      std::vector <royale_framegroupheader_v3> &frameGroupHeaders,
+                                      std::vector <royale_exposuregroupheader_v3> &exposureGroupHeaders,
+                                      std::vector <royale_rawframesetheader_v3> &rawFrameSetHeaders,
+                                      std::vector <royale_processingparameter_v3> &processingParameters,
+                                      std::vector<std::pair<std::string, std::vector<uint8_t>>> &additionalData)
+{
+    memcpy (frameHeader, view.frameHeader, sizeof (royale_frameheader_v3));
+    streamHeaders.assign (view.streamHeaders, view.streamHeaders + frameHeader->numStreams);
+    frameGroupHeaders.assign (view.frameGroupHeaders, view.frameGroupHeaders + frameHeader->numFrameGroups);
+    exposureGroupHeaders.assign (view.exposureGroupHeaders, view.exposureGroupHeaders + frameHeader->numExposureGroups);
+    rawFrameSetHeaders.assign (view.rawFrameSetHeaders, view.rawFrameSetHeaders + frameHeader->numRawFrameSets);
+    processingParameters.assign (view.processingParameters, view.processingParameters + frameHeader->numParameters);
+
+    additionalData.resize (view.additionalData.size());
+    for (size_t i = 0u; i < view.additionalData.size(); ++i)
+    {
+        const auto &curData = view.additionalData[i];
+        additionalData[i].first.assign (curData.name, ROYALE_FILEHEADER_V3_ADDITIONAL_DATA_NAME_LENGTH);
+        additionalData[i].second.assign (curData.data, curData.data + static_cast<size_t> (curData.size));
+    }
+}
+
+void v3::FileReader::adviseWillNeed (uint32_t firstFrame, uint32_t numFrames)
+{
+#ifdef ROYALE_RRF_FADVISE
+    const auto first = m_offsetMap.find (firstFrame);
+    if (!m_file || numFrames == 0u || first == m_offsetMap.end())
+    {
+        return;
+    }
+
+    // A length of zero advises everything up to the end of the file
+    const auto last = m_offsetMap.find (firstFrame + numFrames);
+    const uint64_t length = last == m_offsetMap.end() ? 0u : last->second - first->second;
+    if (first->second + length > static_cast<uint64_t> (std::numeric_limits<off_t>::max()))
+    {
+        return;
+    }
+
+    posix_fadvise (fileno (m_file), static_cast<off_t> (first->second), static_cast<off_t> (length), POSIX_FADV_WILLNEED);
+#else
+    (void) firstFrame;
+    (void) numFrames;
+#endif
+}
+
 std::vector<royale_versioninformation_v3> v3::FileReader::getComponentVersions() const
 {
     return m_componentVersions;
@@ -0,0 +1,306 @@
+/****************************************************************************\
+ * Copyright (C) 2019 pmdtechnologies ag
+ *
+ * THIS CODE AND INFORMATION ARE PROVIDED "AS IS" WITHOUT WARRANTY OF ANY
+ * KIND, EITHER EXPRESSED OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND/OR FITNESS FOR A
+ * PARTICULAR PURPOSE.
+ *
+ \****************************************************************************/
+
+#include <gtest/gtest.h>
+
+#include <record/FramePrefetcher.hpp>
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <mutex>
+#include <stdexcept>
+#include <thread>
+
+using namespace royale::record;
+
+namespace
+{
+    const uint16_t TEST_COLUMNS = 4u;
+    const uint16_t TEST_ROWS = 2u;
+
+    /**
+     * A fake file layer which creates frames on the fly, every value of a frame is the frame
+     * number.  Reading a frame takes at least readLatency, like a slow disk or network share.
+     */
+    class ThrottledFileReader : public FileReaderBase
+    {
+    public:
+        ThrottledFileReader (uint32_t numFrames, std::chrono::milliseconds readLatency) :
+            m_numFrames (numFrames),
+            m_readLatency (readLatency),
+            m_currentFrame (0u),
+            m_failingFrame (numFrames),
+            m_framesRead (0u)
+        {
+        }
+
+        void failOnFrame (uint32_t frameNumber)
+        {
+            m_failingFrame = frameNumber;
+        }
+
+        uint32_t framesRead() const
+        {
+            return m_framesRead;
+        }
+
+        /**
+         * Waits until at least count frames have been read.  The timeout is only a safety net for
+         * a failing test, it isn't part of the checks.
+         */
+        bool waitForFramesRead (uint32_t count)
+        {
+            std::unique_lock<std::mutex> lock (m_mutex);
+            return m_readCondition.wait_for (lock, std::chrono::seconds (10), [this, count]
+            {
+                return m_framesRead >= count;
+            });
+        }
+
+        void open (const std::string &filename) override
+        {
+            (void) filename;
+        }
+
+        void close() override
+        {
+        }
+
+        void seek (uint32_t frameNumber) override
+        {
+            if (frameNumber >= m_numFrames)
+            {
+                throw std::logic_error ("Frame not found!");
+            }
+            m_currentFrame = frameNumber;
+        }
+
+        void get (std::vector <std::vector<uint16_t>> &imageData,
+                  std::vector <std::vector<uint16_t>> &pseudoData,
+                  royale_frameheader_v3 *frameHeader,
+                  std::vector <royale_streamheader_v3> &streamHeaders,
+                  std::vector <royale_framegroupheader_v3> &frameGroupHeaders,
+                  std::vector <royale_exposuregroupheader_v3> &exposureGroupHeaders,
+                  std::vector <royale_rawframesetheader_v3> &rawFrameSetHeaders,
+                  std::vector <royale_processingparameter_v3> &processingParameters,
+                  std::vector<std::pair<std::string, std::vector<uint8_t>>> &additionalData) override
+        {
+            std::this_thread::sleep_for (m_readLatency);
+            {
+                std::lock_guard<std::mutex> lock (m_mutex);
+                m_framesRead++;
+            }
+            m_readCondition.notify_all();
+            if (m_currentFrame == m_failingFrame)
+            {
+                throw std::runtime_error ("Read error");
+            }
+
+            memset (frameHeader, 0, sizeof (royale_frameheader_v3));
+            frameHeader->numColumns = TEST_COLUMNS;
+            frameHeader->numRows = TEST_ROWS;
+            frameHeader->numRawFrames = 1u;
+            frameHeader->timestamp = m_currentFrame * 50u;
+
+            pseudoData.assign (1u, std::vector<uint16_t> (TEST_COLUMNS, static_cast<uint16_t> (m_currentFrame)));
+            imageData.assign (1u, std::vector<uint16_t> (TEST_COLUMNS * TEST_ROWS, static_cast<uint16_t> (m_currentFrame)));
+
+            streamHeaders.clear();
+            frameGroupHeaders.clear();
+            exposureGroupHeaders.clear();
+            rawFrameSetHeaders.clear();
+            processingParameters.clear();
+            additionalData.clear();
+        }
+
+        std::vector<royale_versioninformation_v3> getComponentVersions() const override
+        {
+            return {};
+        }
+
+        royale_rrf_platformtype platform() const override
+        {
+            return RRF_ROYALE_UNDEFINED;
+        }
+
+        std::string cameraName() const override
+        {
+            return "throttled";
+        }
+
+        std::string imagerType() const override
+        {
+            return "";
+        }
+
+        std::string pseudoDataInterpreterType() const override
+        {
+            return "";
+        }
+
+        uint32_t royaleMajor() const override
+        {
+            return 0u;
+        }
+
+        uint32_t royaleMinor() const override
+        {
+            return 0u;
+        }
+
+        uint32_t royalePatch() const override
+        {
+            return 0u;
+        }
+
+        uint32_t royaleBuild() const override
+        {
+            return 0u;
+        }
+
+        uint32_t numFrames() const override
+        {
+            return m_numFrames;
+        }
+
+        uint32_t currentFrame() const override
+        {
+            return m_currentFrame;
+        }
+
+    private:
+        const uint32_t m_numFrames;
+        const std::chrono::milliseconds m_readLatency;
+        uint32_t m_currentFrame;
+        uint32_t m_failingFrame;
+        std::atomic<uint32_t> m_framesRead;
+        std::mutex m_mutex;
+        std::condition_variable m_readCondition;
+    };
+
+    class TestFramePrefetcher : public ::testing::Test
+    {
+    protected:
+        void createPrefetcher (uint32_t numFrames, std::chrono::milliseconds readLatency, std::size_t depth = 4u)
+        {
+            std::unique_ptr<ThrottledFileReader> reader (new ThrottledFileReader (numFrames, readLatency));
+            m_reader = reader.get();
+            m_prefetcher.reset (new FramePrefetcher (std::move (reader), depth));
+        }
+
+        /**
+         * Acquires and releases the frame, and checks that it contains the expected data.
+         */
+        void expectFrame (uint32_t frameNumber)
+        {
+            auto &frame = m_prefetcher->acquire (frameNumber);
+            EXPECT_EQ (frameNumber, frame.frameNumber);
+            EXPECT_EQ (frameNumber * 50u, frame.definition.frameHeader.timestamp);
+            ASSERT_EQ (static_cast<std::size_t> (TEST_COLUMNS * (TEST_ROWS + 1u)), frame.frameData.size());
+            for (auto value : frame.frameData)
+            {
+                ASSERT_EQ (frameNumber, value);
+            }
+            m_prefetcher->release (frame);
+        }
+
+        ThrottledFileReader *m_reader;
+        std::unique_ptr<FramePrefetcher> m_prefetcher;
+    };
+}
+
+TEST_F (TestFramePrefetcher, PlaybackOrder)
+{
+    createPrefetcher (10u, std::chrono::milliseconds (1));
+    m_prefetcher->restart (0u);
+    for (auto i = 0u; i < 10u; ++i)
+    {
+        expectFrame (i);
+    }
+}
+
+TEST_F (TestFramePrefetcher, LoopInRange)
+{
+    createPrefetcher (10u, std::chrono::milliseconds (1));
+    m_prefetcher->setRange (2u, 5u, true);
+    m_prefetcher->restart (2u);
+    for (auto loop = 0u; loop < 3u; ++loop)
+    {
+        for (auto i = 2u; i < 5u; ++i)
+        {
+            expectFrame (i);
+        }
+    }
+
+    // Frames that were read ahead but not used are dropped, so at most one buffer per frame
+    // is wasted
+    EXPECT_LE (m_reader->framesRead(), 9u + 4u);
+}
+
+TEST_F (TestFramePrefetcher, SeekRestartsPrefetch)
+{
+    createPrefetcher (20u, std::chrono::milliseconds (1));
+    m_prefetcher->restart (0u);
+    expectFrame (0u);
+    expectFrame (1u);
+
+    // Seek without telling the prefetcher, the frames that were read ahead don't match
+    expectFrame (12u);
+    expectFrame (13u);
+
+    // Seek backwards with restart
+    m_prefetcher->restart (3u);
+    expectFrame (3u);
+    expectFrame (4u);
+}
+
+TEST_F (TestFramePrefetcher, EndWithoutLoop)
+{
+    createPrefetcher (5u, std::chrono::milliseconds (1));
+    m_prefetcher->setRange (0u, 0u, false);
+    m_prefetcher->restart (3u);
+    expectFrame (3u);
+    expectFrame (4u);
+
+    // Nothing was read after the end of the recording, the next acquire restarts
+    expectFrame (0u);
+}
+
+TEST_F (TestFramePrefetcher, ReadErrorIsRethrown)
+{
+    createPrefetcher (10u, std::chrono::milliseconds (1));
+    m_reader->failOnFrame (2u);
+    m_prefetcher->restart (0u);
+    expectFrame (0u);
+    expectFrame (1u);
+    EXPECT_THROW (m_prefetcher->acquire (2u), std::runtime_error);
+    EXPECT_THROW (m_prefetcher->acquire (15u), std::logic_error);
+
+    // The prefetcher can still be used after the error
+    expectFrame (5u);
+}
+
+TEST_F (TestFramePrefetcher, ReadOverlapsProcessing)
+{
+    const auto numFrames = 10u;
+    createPrefetcher (numFrames, std::chrono::milliseconds (1));
+    m_prefetcher->restart (0u);
+    for (auto i = 0u; i < numFrames; ++i)
+    {
+        auto &frame = m_prefetcher->acquire (i);
+
+        // The frame is still being processed, the next one must be read meanwhile instead of
+        // only when it's acquired
+        EXPECT_TRUE (m_reader->waitForFramesRead (std::min (i + 2u, numFrames)));
+        m_prefetcher->release (frame);
+    }
+}
@@ -0,0 +1,598 @@
+/****************************************************************************\
+ * Copyright (C) 2019 pmdtechnologies ag
+ *
+ * THIS CODE AND INFORMATION ARE PROVIDED "AS IS" WITHOUT WARRANTY OF ANY
+ * KIND, EITHER EXPRESSED OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND/OR FITNESS FOR A
+ * PARTICULAR PURPOSE.
+ *
+ \****************************************************************************/
+
+#include <gtest/gtest.h>
+
+#include <record/FileReaderDispatcher.hpp>
+#include <record/MappedFile.hpp>
+#include <record/v1/FileHeader.h>
+#include <record/v2/FileHeader.h>
+#include <record/v3/FileHeader.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <stdexcept>
+#include <stdio.h>
+#include <string>
+#include <vector>
+
+using namespace royale::record;
+
+namespace
+{
+    const uint16_t TEST_COLUMNS = 5u;
+    const uint16_t TEST_ROWS = 3u;
+    const uint32_t TEST_FRAMES = 4u;
+    const uint16_t TEST_RAW_FRAMES_PER_SET[] = { 2u, 1u };
+    const uint16_t TEST_RAW_FRAME_SETS = 2u;
+    const uint16_t TEST_RAW_FRAMES = 3u;
+    const uint32_t TEST_PARAMETERS = 2u;
+
+    // An odd size, so that the frames following it aren't aligned in v3 files
+    const uint8_t TEST_ADDITIONAL_DATA[] = { 7u, 8u, 9u };
+    const uint8_t TEST_CALIBRATION[] = { 1u, 2u, 3u, 4u, 5u };
+
+    const std::string TEST_FILENAME = "testReaderBackends.rrf";
+
+    uint16_t testValue (uint32_t frame, uint32_t rawFrame, uint32_t idx)
+    {
+        return static_cast<uint16_t> (frame * 1000u + rawFrame * 100u + idx);
+    }
+
+    bool hasAdditionalData (uint32_t frame)
+    {
+        return frame % 2u == 0u;
+    }
+
+    template<typename T>
+    void append (std::vector<uint8_t> &buffer, const T &value)
+    {
+        const auto bytes = reinterpret_cast<const uint8_t *> (&value);
+        buffer.insert (buffer.end(), bytes, bytes + sizeof (T));
+    }
+
+    template<typename T>
+    void patch (std::vector<uint8_t> &buffer, size_t offset, const T &value)
+    {
+        memcpy (&buffer[offset], &value, sizeof (T));
+    }
+
+    void appendRawFrame (std::vector<uint8_t> &buffer, uint32_t frame, uint32_t rawFrame)
+    {
+        for (uint32_t idx = 0u; idx < TEST_COLUMNS * (TEST_ROWS + 1u); ++idx)
+        {
+            append (buffer, testValue (frame, rawFrame, idx));
+        }
+    }
+
+    void appendParameters (std::vector<uint8_t> &buffer, uint32_t frame)
+    {
+        for (uint32_t i = 0u; i < TEST_PARAMETERS; ++i)
+        {
+            royale_processingparameter_v1 param {};
+            param.processingFlag = i;
+            param.dataType = 1u;
+            param.value = frame + i;
+            append (buffer, param);
+        }
+    }
+
+    void appendAdditionalData (std::vector<uint8_t> &buffer)
+    {
+        char name[ROYALE_FILEHEADER_V3_ADDITIONAL_DATA_NAME_LENGTH] = "testData";
+        buffer.insert (buffer.end(), name, name + sizeof (name));
+        append (buffer, static_cast<uint64_t> (sizeof (TEST_ADDITIONAL_DATA)));
+        buffer.insert (buffer.end(), TEST_ADDITIONAL_DATA, TEST_ADDITIONAL_DATA + sizeof (TEST_ADDITIONAL_DATA));
+    }
+
+    /**
+     * The raw frame sets of v1 and v2, each raw frame is preceded by a raw frame header
+     */
+    void appendRawFrameSetsV1 (std::vector<uint8_t> &buffer, uint32_t frame)
+    {
+        uint32_t rawFrame = 0u;
+        for (uint16_t i = 0u; i < TEST_RAW_FRAME_SETS; ++i)
+        {
+            royale_rawframesetheader_v1 rfs {};
+            rfs.modFreq = 60000000u + i;
+            rfs.useCaseExpTime = 100u + i;
+            rfs.capturedExpTime = 90u + i;
+            rfs.phaseDefinition = static_cast<uint8_t> (i == 0u ? MODULATED : GREYSCALE);
+            rfs.numRawFrames = TEST_RAW_FRAMES_PER_SET[i];
+            rfs.rawFrameSize = TEST_COLUMNS * (TEST_ROWS + 1u) * sizeof (uint16_t);
+            rfs.active = 1u;
+            append (buffer, rfs);
+
+            for (uint16_t j = 0u; j < rfs.numRawFrames; ++j)
+            {
+                royale_rawframeheader_v1 rawFrameHeader {};
+                rawFrameHeader.rawFrameIndex = static_cast<uint16_t> (rawFrame);
+                append (buffer, rawFrameHeader);
+                appendRawFrame (buffer, frame, rawFrame++);
+            }
+        }
+    }
+
+    std::vector<uint8_t> createFileV1()
+    {
+        std::vector<uint8_t> buffer;
+
+        royale_fileheader_v1 fileHeader {};
+        memcpy (fileHeader.magic, ROYALE_FILEHEADER_MAGIC, ROYALE_FILEHEADER_MAGIC_LENGTH);
+        fileHeader.version = 1u;
+        fileHeader.platform = RRF_ROYALE_LINUX;
+        fileHeader.cameraType = 2u;
+        fileHeader.imagerType = 3u;
+        fileHeader.royaleMajor = 1u;
+        strcpy (fileHeader.imagerSerial, "0000-0001");
+        fileHeader.numFrames = TEST_FRAMES;
+        fileHeader.calibrationOffset = sizeof (fileHeader);
+        fileHeader.calibrationSize = sizeof (TEST_CALIBRATION);
+        fileHeader.framesOffset = sizeof (fileHeader) + sizeof (TEST_CALIBRATION);
+        append (buffer, fileHeader);
+        buffer.insert (buffer.end(), TEST_CALIBRATION, TEST_CALIBRATION + sizeof (TEST_CALIBRATION));
+
+        for (uint32_t frame = 0u; frame < TEST_FRAMES; ++frame)
+        {
+            const auto frameStart = buffer.size();
+
+            royale_frameheader_v1 frameHeader {};
+            frameHeader.numColumns = TEST_COLUMNS;
+            frameHeader.numRows = TEST_ROWS + 1u;
+            frameHeader.numRawFrames = TEST_RAW_FRAMES;
+            frameHeader.numRawFrameSets = TEST_RAW_FRAME_SETS;
+            frameHeader.timestamp = 5000u + frame;
+            frameHeader.illuTemperature = 30.5f;
+            frameHeader.numParameters = TEST_PARAMETERS;
+            frameHeader.exposureMin = 1u;
+            frameHeader.exposureMax = 2000u;
+            strcpy (frameHeader.useCaseName, "MODE_TEST");
+            append (buffer, frameHeader);
+
+            appendParameters (buffer, frame);
+            appendRawFrameSetsV1 (buffer, frame);
+
+            patch (buffer, frameStart, static_cast<uint32_t> (buffer.size() - frameStart));
+        }
+        return buffer;
+    }
+
+    std::vector<uint8_t> createFileV2()
+    {
+        std::vector<uint8_t> buffer;
+
+        royale_fileheader_v2 fileHeader {};
+        memcpy (fileHeader.magic, ROYALE_FILEHEADER_MAGIC, ROYALE_FILEHEADER_MAGIC_LENGTH);
+        fileHeader.version = 2u;
+        fileHeader.platform = RRF_ROYALE_LINUX;
+        strcpy (fileHeader.cameraName, "BACKENDS");
+        strcpy (fileHeader.imagerType, "M2452");
+        strcpy (fileHeader.pseudoDataInterpreter, "M2452");
+        fileHeader.royaleMajor = 2u;
+        strcpy (fileHeader.imagerSerial, "0000-0002");
+        fileHeader.numFrames = TEST_FRAMES;
+        fileHeader.numVersions = 1u;
+        fileHeader.calibrationOffset = sizeof (fileHeader) + sizeof (royale_versioninformation_v2);
+        fileHeader.calibrationSize = sizeof (TEST_CALIBRATION);
+        fileHeader.framesOffset = fileHeader.calibrationOffset + sizeof (TEST_CALIBRATION);
+        append (buffer, fileHeader);
+
+        royale_versioninformation_v2 version {};
+        strcpy (version.componentName, "royale");
+        strcpy (version.componentVersion, "2.0.0");
+        append (buffer, version);
+        buffer.insert (buffer.end(), TEST_CALIBRATION, TEST_CALIBRATION + sizeof (TEST_CALIBRATION));
+
+        for (uint32_t frame = 0u; frame < TEST_FRAMES; ++frame)
+        {
+            const auto frameStart = buffer.size();
+
+            royale_frameheader_v2 frameHeader {};
+            frameHeader.numColumns = TEST_COLUMNS;
+            frameHeader.numRows = TEST_ROWS + 1u;
+            frameHeader.numRawFrames = TEST_RAW_FRAMES;
+            frameHeader.numRawFrameSets = TEST_RAW_FRAME_SETS;
+            frameHeader.timestamp = 5000u + frame;
+            frameHeader.illuTemperature = 30.5f;
+            frameHeader.numParameters = TEST_PARAMETERS;
+            frameHeader.exposureMin = 1u;
+            frameHeader.exposureMax = 2000u;
+            strcpy (frameHeader.useCaseName, "MODE_TEST");
+            frameHeader.numAdditionalData = hasAdditionalData (frame) ? 1u : 0u;
+            append (buffer, frameHeader);
+
+            appendRawFrameSetsV1 (buffer, frame);
+            appendParameters (buffer, frame);
+            if (hasAdditionalData (frame))
+            {
+                appendAdditionalData (buffer);
+            }
+
+            patch (buffer, frameStart, static_cast<uint32_t> (buffer.size() - frameStart));
+        }
+        return buffer;
+    }
+
+    std::vector<uint8_t> createFileV3()
+    {
+        std::vector<uint8_t> buffer;
+
+        royale_fileheader_v3 fileHeader {};
+        memcpy (fileHeader.magic, ROYALE_FILEHEADER_MAGIC, ROYALE_FILEHEADER_MAGIC_LENGTH);
+        fileHeader.version = 3u;
+        fileHeader.platform = RRF_ROYALE_LINUX;
+        strcpy (fileHeader.cameraName, "BACKENDS");
+        strcpy (fileHeader.imagerType, "M2452");
+        strcpy (fileHeader.pseudoDataInterpreter, "M2452");
+        fileHeader.royaleMajor = 3u;
+        strcpy (fileHeader.imagerSerial, "0000-0003");
+        fileHeader.numFrames = TEST_FRAMES;
+        fileHeader.numVersions = 1u;
+        fileHeader.calibrationOffset = sizeof (fileHeader) + sizeof (royale_versioninformation_v3);
+        fileHeader.calibrationSize = sizeof (TEST_CALIBRATION);
+        fileHeader.framesOffset = fileHeader.calibrationOffset + sizeof (TEST_CALIBRATION);
+        append (buffer, fileHeader);
+
+        royale_versioninformation_v3 version {};
+        strcpy (version.componentName, "royale");
+        strcpy (version.componentType, "lib");
+        strcpy (version.componentVersion, "3.0.0");
+        append (buffer, version);
+        buffer.insert (buffer.end(), TEST_CALIBRATION, TEST_CALIBRATION + sizeof (TEST_CALIBRATION));
+
+        for (uint32_t frame = 0u; frame < TEST_FRAMES; ++frame)
+        {
+            const auto frameStart = buffer.size();
+
+            royale_frameheader_v3 frameHeader {};
+            frameHeader.numColumns = TEST_COLUMNS;
+            frameHeader.numRows = TEST_ROWS;
+            frameHeader.numRawFrames = TEST_RAW_FRAMES;
+            frameHeader.numRawFrameSets = TEST_RAW_FRAME_SETS;
+            frameHeader.timestamp = 5000u + frame;
+            frameHeader.illuTemperature = 30.5f;
+            frameHeader.numParameters = TEST_PARAMETERS;
+            strcpy (frameHeader.useCaseName, "MODE_TEST");
+            frameHeader.numAdditionalData = hasAdditionalData (frame) ? 1u : 0u;
+            frameHeader.curStreamId = 0xdefa;
+            frameHeader.numStreams = 1u;
+            frameHeader.numFrameGroups = 1u;
+            frameHeader.numExposureGroups = TEST_RAW_FRAME_SETS;
+            append (buffer, frameHeader);
+
+            royale_streamheader_v3 stream {};
+            stream.streamId = 0xdefa;
+            stream.numFrameGroups = 1u;
+            append (buffer, stream);
+
+            royale_framegroupheader_v3 frameGroup {};
+            frameGroup.numRawFrameSets = TEST_RAW_FRAME_SETS;
+            for (uint16_t i = 0u; i < TEST_RAW_FRAME_SETS; ++i)
+            {
+                frameGroup.rawFrameSetIdxs[i] = i;
+            }
+            append (buffer, frameGroup);
+
+            for (uint16_t i = 0u; i < TEST_RAW_FRAME_SETS; ++i)
+            {
+                royale_exposuregroupheader_v3 exposureGroup {};
+                strcpy (exposureGroup.exposureGroupName, i == 0u ? "gray" : "mod");
+                exposureGroup.exposureMax = 2000u;
+                exposureGroup.exposureTime = 100u + i;
+                append (buffer, exposureGroup);
+            }
+
+            for (uint16_t i = 0u; i < TEST_RAW_FRAME_SETS; ++i)
+            {
+                royale_rawframesetheader_v3 rfs {};
+                rfs.modFreq = 60000000u + i;
+                rfs.capturedExpTime = 90u + i;
+                rfs.numRawFrames = TEST_RAW_FRAMES_PER_SET[i];
+                rfs.exposureGroupIdx = i;
+                append (buffer, rfs);
+            }
+
+            for (uint16_t rawFrame = 0u; rawFrame < TEST_RAW_FRAMES; ++rawFrame)
+            {
+                appendRawFrame (buffer, frame, rawFrame);
+            }
+
+            appendParameters (buffer, frame);
+            if (hasAdditionalData (frame))
+            {
+                appendAdditionalData (buffer);
+            }
+
+            patch (buffer, frameStart, static_cast<uint32_t> (buffer.size() - frameStart));
+        }
+        return buffer;
+    }
+
+    void writeFile (const std::vector<uint8_t> &buffer, size_t size)
+    {
+        auto file = fopen (TEST_FILENAME.c_str(), "wb");
+        ASSERT_NE (nullptr, file);
+        ASSERT_EQ (1u, fwrite (buffer.data(), size, 1u, file));
+        fclose (file);
+    }
+
+    /**
+     * A frame in a form that can be compared, independent of the function used to read it
+     */
+    struct ReadFrame
+    {
+        royale_frameheader_v3 frameHeader;
+        std::vector <royale_streamheader_v3> streamHeaders;
+        std::vector <royale_framegroupheader_v3> frameGroupHeaders;
+        std::vector <royale_exposuregroupheader_v3> exposureGroupHeaders;
+        std::vector <royale_rawframesetheader_v3> rawFrameSetHeaders;
+        std::vector<uint16_t> frameData;
+        std::vector <royale_processingparameter_v3> processingParameters;
+        std::vector<std::pair<std::string, std::vector<uint8_t>>> additionalData;
+    };
+
+    ReadFrame readWithGet (FileReaderBase &reader)
+    {
+        ReadFrame frame;
+        std::vector <std::vector<uint16_t>> imageData;
+        std::vector <std::vector<uint16_t>> pseudoData;
+        reader.get (imageData, pseudoData, &frame.frameHeader, frame.streamHeaders, frame.frameGroupHeaders,
+                    frame.exposureGroupHeaders, frame.rawFrameSetHeaders, frame.processingParameters, frame.additionalData);
+        for (size_t i = 0u; i < imageData.size(); ++i)
+        {
+            frame.frameData.insert (frame.frameData.end(), pseudoData[i].begin(), pseudoData[i].end());
+            frame.frameData.insert (frame.frameData.end(), imageData[i].begin(), imageData[i].end());
+        }
+        return frame;
+    }
+
+    ReadFrame readWithGetFrame (FileReaderBase &reader)
+    {
+        ReadFrame frame;
+        reader.getFrame (frame.frameData, &frame.frameHeader, frame.streamHeaders, frame.frameGroupHeaders,
+                         frame.exposureGroupHeaders, frame.rawFrameSetHeaders, frame.processingParameters, frame.additionalData);
+        return frame;
+    }
+
+    ReadFrame readWithView (FileReaderBase &reader)
+    {
+        FrameView view;
+        reader.getFrameView (view);
+
+        // The frame data has to be usable as uint16_t, also for frames at odd offsets
+        EXPECT_EQ (0u, reinterpret_cast<uintptr_t> (view.frameData) % alignof (uint16_t));
+
+        ReadFrame frame;
+        const auto &header = *view.frameHeader;
+        memcpy (&frame.frameHeader, &header, sizeof (royale_frameheader_v3));
+        frame.streamHeaders.assign (view.streamHeaders, view.streamHeaders + header.numStreams);
+        frame.frameGroupHeaders.assign (view.frameGroupHeaders, view.frameGroupHeaders + header.numFrameGroups);
+        frame.exposureGroupHeaders.assign (view.exposureGroupHeaders, view.exposureGroupHeaders + header.numExposureGroups);
+        frame.rawFrameSetHeaders.assign (view.rawFrameSetHeaders, view.rawFrameSetHeaders + header.numRawFrameSets);
+        frame.frameData.assign (view.frameData, view.frameData + header.numColumns * (header.numRows + 1u) * header.numRawFrames);
+        frame.processingParameters.assign (view.processingParameters, view.processingParameters + header.numParameters);
+        for (const auto &curData : view.additionalData)
+        {
+            frame.additionalData.emplace_back (std::string (curData.name, ROYALE_FILEHEADER_V3_ADDITIONAL_DATA_NAME_LENGTH),
+                                               std::vector<uint8_t> (curData.data, curData.data + curData.size));
+        }
+        return frame;
+    }
+
+    template<typename T>
+    void expectSameBytes (const std::vector<T> &expected, const std::vector<T> &actual)
+    {
+        ASSERT_EQ (expected.size(), actual.size());
+        if (!expected.empty())
+        {
+            EXPECT_EQ (0, memcmp (expected.data(), actual.data(), expected.size() * sizeof (T)));
+        }
+    }
+
+    void expectSameFrame (const ReadFrame &expected, const ReadFrame &actual)
+    {
+        EXPECT_EQ (0, memcmp (&expected.frameHeader, &actual.frameHeader, sizeof (royale_frameheader_v3)));
+        expectSameBytes (expected.streamHeaders, actual.streamHeaders);
+        expectSameBytes (expected.frameGroupHeaders, actual.frameGroupHeaders);
+        expectSameBytes (expected.exposureGroupHeaders, actual.exposureGroupHeaders);
+        expectSameBytes (expected.rawFrameSetHeaders, actual.rawFrameSetHeaders);
+        EXPECT_EQ (expected.frameData, actual.frameData);
+        expectSameBytes (expected.processingParameters, actual.processingParameters);
+        EXPECT_EQ (expected.additionalData, actual.additionalData);
+    }
+
+    /**
+     * Checks a frame against the values that the create functions have written
+     */
+    void expectSyntheticFrame (const ReadFrame &frame, uint32_t frameNumber, uint8_t version)
+    {
+        EXPECT_EQ (5000u + frameNumber, frame.frameHeader.timestamp);
+        EXPECT_EQ (TEST_COLUMNS, frame.frameHeader.numColumns);
+        EXPECT_EQ (TEST_ROWS, frame.frameHeader.numRows);
+        EXPECT_EQ (TEST_RAW_FRAMES, frame.frameHeader.numRawFrames);
+        EXPECT_STREQ ("MODE_TEST", frame.frameHeader.useCaseName);
+
+        ASSERT_EQ (TEST_RAW_FRAME_SETS, frame.rawFrameSetHeaders.size());
+        for (uint16_t i = 0u; i < TEST_RAW_FRAME_SETS; ++i)
+        {
+            EXPECT_EQ (60000000u + i, frame.rawFrameSetHeaders[i].modFreq);
+            EXPECT_EQ (TEST_RAW_FRAMES_PER_SET[i], frame.rawFrameSetHeaders[i].numRawFrames);
+        }
+
+        const uint32_t slotSize = TEST_COLUMNS * (TEST_ROWS + 1u);
+        ASSERT_EQ (slotSize * TEST_RAW_FRAMES, frame.frameData.size());
+        for (uint32_t rawFrame = 0u; rawFrame < TEST_RAW_FRAMES; ++rawFrame)
+        {
+            for (uint32_t idx = 0u; idx < slotSize; ++idx)
+            {
+                ASSERT_EQ (testValue (frameNumber, rawFrame, idx), frame.frameData[rawFrame * slotSize + idx]);
+            }
+        }
+
+        ASSERT_EQ (TEST_PARAMETERS, frame.processingParameters.size());
+        for (uint32_t i = 0u; i < TEST_PARAMETERS; ++i)
+        {
+            EXPECT_EQ (i, frame.processingParameters[i].processingFlag);
+            EXPECT_EQ (frameNumber + i, frame.processingParameters[i].value);
+        }
+
+        // Version 1 doesn't support additional data
+        if (version > 1u && hasAdditionalData (frameNumber))
+        {
+            ASSERT_EQ (1u, frame.additionalData.size());
+            EXPECT_STREQ ("testData", frame.additionalData[0].first.c_str());
+            EXPECT_EQ (std::vector<uint8_t> (TEST_ADDITIONAL_DATA, TEST_ADDITIONAL_DATA + sizeof (TEST_ADDITIONAL_DATA)),
+                       frame.additionalData[0].second);
+        }
+        else
+        {
+            EXPECT_TRUE (frame.additionalData.empty());
+        }
+    }
+
+    class TestReaderBackends : public ::testing::Test
+    {
+    protected:
+        void TearDown() override
+        {
+            remove (TEST_FILENAME.c_str());
+        }
+
+        /**
+         * Opens the file with both backends, and checks that every way of reading each frame
+         * returns the same data with both backends.
+         */
+        void checkConformance (const std::vector<uint8_t> &file, uint8_t version)
+        {
+            writeFile (file, file.size());
+
+            FileReaderDispatcher buffered (FileReaderBackend::BUFFERED);
+            FileReaderDispatcher mapped (FileReaderBackend::MAPPED);
+            buffered.open (TEST_FILENAME);
+            mapped.open (TEST_FILENAME);
+
+            EXPECT_EQ (FileReaderBackend::BUFFERED, buffered.backend());
+            EXPECT_EQ (version == 3u ? FileReaderBackend::MAPPED : FileReaderBackend::BUFFERED, mapped.backend());
+
+            ASSERT_EQ (TEST_FRAMES, buffered.numFrames());
+            ASSERT_EQ (TEST_FRAMES, mapped.numFrames());
+            EXPECT_EQ (buffered.cameraName(), mapped.cameraName());
+            EXPECT_EQ (buffered.imagerSerial(), mapped.imagerSerial());
+            EXPECT_EQ (buffered.getCalibrationData(), mapped.getCalibrationData());
+            EXPECT_EQ (TEST_COLUMNS, mapped.getMaxWidth());
+            EXPECT_EQ (TEST_ROWS, mapped.getMaxHeight());
+
+            // Backwards as well, the frames don't depend on reading the previous one
+            const uint32_t order[] = { 0u, 1u, 2u, 3u, 2u, 0u };
+            for (auto frameNumber : order)
+            {
+                buffered.seek (frameNumber);
+                mapped.seek (frameNumber);
+
+                const auto expected = readWithGet (buffered);
+                expectSyntheticFrame (expected, frameNumber, version);
+
+                expectSameFrame (expected, readWithGetFrame (buffered));
+                expectSameFrame (expected, readWithView (buffered));
+                expectSameFrame (expected, readWithGet (mapped));
+                expectSameFrame (expected, readWithGetFrame (mapped));
+                expectSameFrame (expected, readWithView (mapped));
+            }
+        }
+    };
+}
+
+TEST_F (TestReaderBackends, ConformanceV1)
+{
+    checkConformance (createFileV1(), 1u);
+}
+
+TEST_F (TestReaderBackends, ConformanceV2)
+{
+    checkConformance (createFileV2(), 2u);
+}
+
+TEST_F (TestReaderBackends, ConformanceV3)
+{
+    checkConformance (createFileV3(), 3u);
+}
+
+TEST_F (TestReaderBackends, TruncatedFrame)
+{
+    // The last frame is cut off inside its raw frames
+    const auto file = createFileV3();
+    writeFile (file, file.size() - 50u);
+
+    FileReaderDispatcher buffered (FileReaderBackend::BUFFERED);
+    FileReaderDispatcher mapped (FileReaderBackend::MAPPED);
+    buffered.open (TEST_FILENAME);
+    mapped.open (TEST_FILENAME);
+    ASSERT_EQ (FileReaderBackend::MAPPED, mapped.backend());
+
+    buffered.seek (TEST_FRAMES - 2u);
+    mapped.seek (TEST_FRAMES - 2u);
+    expectSameFrame (readWithGetFrame (buffered), readWithGetFrame (mapped));
+
+    buffered.seek (TEST_FRAMES - 1u);
+    mapped.seek (TEST_FRAMES - 1u);
+    FrameView view;
+    EXPECT_THROW (readWithGetFrame (buffered), std::runtime_error);
+    EXPECT_THROW (readWithGetFrame (mapped), std::runtime_error);
+    EXPECT_THROW (mapped.getFrameView (view), std::runtime_error);
+}
+
+TEST_F (TestReaderBackends, SectionOutsideOfFrame)
+{
+    // The first frame claims to have more additional data than fits into its frame size
+    auto file = createFileV3();
+    const auto firstFrame = sizeof (royale_fileheader_v3) + sizeof (royale_versioninformation_v3) + sizeof (TEST_CALIBRATION);
+    patch (file, firstFrame + offsetof (royale_frameheader_v3, numAdditionalData), 1000u);
+    writeFile (file, file.size());
+
+    FileReaderDispatcher mapped (FileReaderBackend::MAPPED);
+    mapped.open (TEST_FILENAME);
+    ASSERT_EQ (FileReaderBackend::MAPPED, mapped.backend());
+
+    FrameView view;
+    EXPECT_THROW (mapped.getFrameView (view), std::runtime_error);
+
+    // The other frames are still readable
+    mapped.seek (1u);
+    expectSyntheticFrame (readWithView (mapped), 1u, 3u);
+}
+
+TEST_F (TestReaderBackends, MappedFileBounds)
+{
+    const std::vector<uint8_t> content (100u, 42u);
+    writeFile (content, content.size());
+
+    auto file = fopen (TEST_FILENAME.c_str(), "rb");
+    ASSERT_NE (nullptr, file);
+
+    MappedFile mapping;
+    EXPECT_FALSE (mapping.map (nullptr));
+    EXPECT_FALSE (mapping.map (file, 99u));
+    EXPECT_FALSE (mapping.isMapped());
+    EXPECT_THROW (mapping.at (0u, 1u), std::out_of_range);
+
+    ASSERT_TRUE (mapping.map (file));
+    fclose (file);
+
+    ASSERT_EQ (100u, mapping.size());
+    EXPECT_EQ (42u, mapping.at (0u, 100u)[99]);
+    EXPECT_NO_THROW (mapping.at (100u, 0u));
+    EXPECT_THROW (mapping.at (99u, 2u), std::out_of_range);
+    EXPECT_THROW (mapping.at (101u, 0u), std::out_of_range);
+    EXPECT_THROW (mapping.at (1u, std::numeric_limits<uint64_t>::max()), std::out_of_range);
+
+    mapping.unmap();
+    EXPECT_FALSE (mapping.isMapped());
+}
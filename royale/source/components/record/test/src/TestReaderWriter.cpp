@@ -9,7 +9,11 @@
  \****************************************************************************/
 
 #include <gtest/gtest.h>
+#include <atomic>
+#include <cstdlib>
+#include <cstring>
 #include <iostream>
+#include <new>
 #include <vector>
 #include <string>
 #include <stdio.h>
@@ -17,6 +21,7 @@
 #include <record/FileReaderDispatcher.hpp>
 #include <record/FileWriter.hpp>
 #include <record/CameraRecord.hpp>
+#include <record/UseCaseRecord.hpp>
 #include <collector/CapturedUseCase.hpp>
 
 #include <usecase/UseCaseFourPhase.hpp>
@@ -39,6 +44,56 @@ using namespace royale::collector;
 namespace
 {
     static const std::string testfilename = "testfile.rrf";
+    static const std::string additionalDataFilename = "testfile_additional.rrf";
+
+    /**
+     * Number of calls to the global operator new while an AllocationWindow exists, see the
+     * replacements below.  Outside of the window the replacements only forward to malloc/free.
+     */
+    std::atomic<bool> countingAllocations (false);
+    std::atomic<uint64_t> allocationCount (0u);
+
+    void *countedAlloc (std::size_t size)
+    {
+        if (countingAllocations.load (std::memory_order_relaxed))
+        {
+            allocationCount.fetch_add (1u, std::memory_order_relaxed);
+        }
+        return std::malloc (size ? size : 1u);
+    }
+
+    /**
+     * Counts the allocations (from all threads) from its construction until count() is called
+     * or it is destroyed.  Only one window may exist at a time.
+     */
+    class AllocationWindow
+    {
+    public:
+        AllocationWindow()
+        {
+            allocationCount = 0u;
+            countingAllocations = true;
+        }
+
+        ~AllocationWindow()
+        {
+            countingAllocations = false;
+        }
+
+        uint64_t count()
+        {
+            countingAllocations = false;
+            return allocationCount.load();
+        }
+    };
+
+    /**
+     * Value of the additional data with the given index in the frame curFrame.
+     */
+    uint8_t expectedAdditionalData (size_t curFrame, size_t index, size_t offset)
+    {
+        return static_cast<uint8_t> (curFrame + index * 7u + offset);
+    }
 
     /**
      * Value of CapturedUseCase.getExposureTime()[frameset] for depth frame number curFrame.
@@ -49,6 +104,53 @@ namespace
     }
 }
 
+// Replacements of the global allocation functions, so that tests can check that a code path
+// doesn't allocate memory
+void *operator new (std::size_t size)
+{
+    auto p = countedAlloc (size);
+    if (!p)
+    {
+        throw std::bad_alloc();
+    }
+    return p;
+}
+
+void *operator new[] (std::size_t size)
+{
+    return operator new (size);
+}
+
+void *operator new (std::size_t size, const std::nothrow_t &) noexcept
+{
+    return countedAlloc (size);
+}
+
+void *operator new[] (std::size_t size, const std::nothrow_t &) noexcept
+{
+    return countedAlloc (size);
+}
+
+void operator delete (void *p) noexcept
+{
+    std::free (p);
+}
+
+void operator delete[] (void *p) noexcept
+{
+    std::free (p);
+}
+
+void operator delete (void *p, const std::nothrow_t &) noexcept
+{
+    std::free (p);
+}
+
+void operator delete[] (void *p, const std::nothrow_t &) noexcept
+{
+    std::free (p);
+}
+
 void writeFile (std::vector<UseCaseDefinition> &ucVec)
 {
     CameraRecord writer (0, 0, 0, "testCamera", static_cast<ImagerType> (0));
@@ -100,6 +202,79 @@ void writeFile (std::vector<UseCaseDefinition> &ucVec)
     writer.stopRecord();
 }
 
+/**
+ * Copies the test recording to additionalDataFilename, adding two blocks of additional data of
+ * different sizes to each frame.
+ */
+void writeFileWithAdditionalData()
+{
+    FileReaderDispatcher reader;
+    reader.open (testfilename);
+
+    std::vector<std::string> componentNames;
+    std::vector<std::string> componentTypes;
+    std::vector<std::string> componentVersions;
+    for (const auto &version : reader.getComponentVersions())
+    {
+        componentNames.push_back (version.componentName);
+        componentTypes.push_back (version.componentType);
+        componentVersions.push_back (version.componentVersion);
+    }
+
+    FileWriter writer;
+    writer.open (additionalDataFilename, reader.getCalibrationData(), reader.imagerSerial(),
+                 reader.cameraName(), reader.imagerType(), reader.pseudoDataInterpreterType(),
+                 reader.royaleMajor(), reader.royaleMinor(), reader.royalePatch(), reader.royaleBuild(),
+                 reader.platform(), componentNames, componentTypes, componentVersions);
+
+    const std::vector<size_t> additionalSizes { 13u, 1000u };
+    std::vector<std::vector<uint8_t>> additionalBlocks (additionalSizes.size());
+    for (uint32_t curFrame = 0; curFrame < reader.numFrames(); ++curFrame)
+    {
+        std::vector<std::vector<uint16_t>> imageData;
+        std::vector<std::vector<uint16_t>> pseudoData;
+        royale_frameheader_v3 frameHeader;
+        std::vector<royale_streamheader_v3> streamHeaders;
+        std::vector<royale_framegroupheader_v3> frameGroupHeaders;
+        std::vector<royale_exposuregroupheader_v3> exposureGroupHeaders;
+        std::vector<royale_rawframesetheader_v3> rawFrameSetHeaders;
+        std::vector<royale_processingparameter_v3> processingParameters;
+        std::vector<std::pair<std::string, std::vector<uint8_t>>> additionalData;
+        reader.seek (curFrame);
+        reader.get (imageData, pseudoData, &frameHeader, streamHeaders, frameGroupHeaders,
+                    exposureGroupHeaders, rawFrameSetHeaders, processingParameters, additionalData);
+
+        std::vector<royale_additionaldata_v3> additionalHeaders (additionalSizes.size());
+        for (size_t i = 0u; i < additionalSizes.size(); ++i)
+        {
+            additionalBlocks[i].resize (additionalSizes[i]);
+            for (size_t offset = 0u; offset < additionalSizes[i]; ++offset)
+            {
+                additionalBlocks[i][offset] = expectedAdditionalData (curFrame, i, offset);
+            }
+            std::memset (additionalHeaders[i].dataName, 0, sizeof (additionalHeaders[i].dataName));
+            std::strncpy (additionalHeaders[i].dataName, ("block" + std::to_string (i)).c_str(), sizeof (additionalHeaders[i].dataName) - 1u);
+            additionalHeaders[i].dataSize = additionalBlocks[i].size();
+            additionalHeaders[i].data = additionalBlocks[i].data();
+        }
+        frameHeader.numAdditionalData = static_cast<uint32_t> (additionalHeaders.size());
+
+        std::vector<const uint16_t *> imagePointers;
+        std::vector<const uint16_t *> pseudoPointers;
+        for (size_t i = 0u; i < imageData.size(); ++i)
+        {
+            imagePointers.push_back (imageData[i].data());
+            pseudoPointers.push_back (pseudoData[i].data());
+        }
+
+        writer.put (imagePointers, pseudoPointers, &frameHeader, streamHeaders, frameGroupHeaders,
+                    exposureGroupHeaders, rawFrameSetHeaders, processingParameters, additionalHeaders);
+    }
+
+    writer.close();
+    reader.close();
+}
+
 /**
  * Load the data from the test recording, and compare it to the data written.
  *
@@ -280,6 +455,195 @@ TEST (TestReaderWriter, ReadWriteMixed)
     remove (testfilename.c_str());
 }
 
+TEST (TestReaderWriter, GetFrameMatchesGet)
+{
+    remove (testfilename.c_str());
+
+    UseCaseFourPhase testUC (45u, 30000000, {50u, 1000u}, 1000u, 1000u);
+    UseCaseEightPhase testUC2 (10u, 30000000, 20200000, { 200u, 1000u }, 1000u, 1000u, 1000u);
+
+    std::vector<UseCaseDefinition> ucVec;
+    ucVec.push_back (testUC);
+    ucVec.push_back (testUC2);
+    ucVec.push_back (testUC);
+
+    writeFile (ucVec);
+
+    FileReaderDispatcher reader;
+    ASSERT_NO_THROW (reader.open (testfilename));
+
+    royale_frameheader_v3 frameHeader;
+    RecordUseCaseDefinition definition;
+    std::vector<royale_processingparameter_v3> processingParameters;
+    std::vector<std::pair<std::string, std::vector<uint8_t>>> additionalData;
+
+    std::vector<uint16_t> frameData;
+    std::vector<uint64_t> hashes;
+    for (uint32_t curFrame = 0; curFrame < ucVec.size(); ++curFrame)
+    {
+        std::vector<std::vector<uint16_t>> imageData;
+        std::vector<std::vector<uint16_t>> pseudoData;
+        reader.seek (curFrame);
+        ASSERT_NO_THROW (reader.get (imageData, pseudoData, &frameHeader, definition.streams, definition.frameGroups,
+                                     definition.exposureGroups, definition.rawFrameSets, processingParameters, additionalData));
+
+        reader.seek (curFrame);
+        ASSERT_NO_THROW (reader.getFrame (frameData, &definition.frameHeader, definition.streams, definition.frameGroups,
+                                          definition.exposureGroups, definition.rawFrameSets, processingParameters, additionalData));
+        hashes.push_back (calculateUseCaseHash (definition));
+
+        EXPECT_EQ (0, memcmp (&frameHeader, &definition.frameHeader, sizeof (frameHeader)));
+
+        const size_t slotSize = frameHeader.numColumns * (frameHeader.numRows + 1u);
+        ASSERT_EQ (slotSize * frameHeader.numRawFrames, frameData.size());
+        for (size_t i = 0; i < frameHeader.numRawFrames; ++i)
+        {
+            EXPECT_EQ (0, memcmp (&frameData[i * slotSize], pseudoData[i].data(), pseudoData[i].size() * sizeof (uint16_t)));
+            EXPECT_EQ (0, memcmp (&frameData[i * slotSize + frameHeader.numColumns], imageData[i].data(), imageData[i].size() * sizeof (uint16_t)));
+        }
+    }
+
+    // The captured exposure times are different for each frame, but they are not part of the use case
+    EXPECT_EQ (hashes[0], hashes[2]);
+    EXPECT_NE (hashes[0], hashes[1]);
+
+    EXPECT_NO_THROW (reader.close());
+    remove (testfilename.c_str());
+}
+
+TEST (TestReaderWriter, GetFrameWithoutAllocations)
+{
+    remove (testfilename.c_str());
+
+    // A long recording with small frames
+    UseCaseFourPhase testUC (45u, 30000000, {50u, 1000u}, 1000u, 1000u);
+    testUC.setImage (32u, 8u);
+
+    const auto numFrames = 500u;
+    std::vector<UseCaseDefinition> ucVec (numFrames, testUC);
+    writeFile (ucVec);
+
+    FileReaderDispatcher reader;
+    ASSERT_NO_THROW (reader.open (testfilename));
+    ASSERT_EQ (numFrames, reader.numFrames());
+
+    std::vector<uint16_t> frameData;
+    RecordUseCaseDefinition definition;
+    std::vector<royale_processingparameter_v3> processingParameters;
+    std::vector<std::pair<std::string, std::vector<uint8_t>>> additionalData;
+
+    // The first frame sizes the buffers
+    reader.seek (0u);
+    reader.getFrame (frameData, &definition.frameHeader, definition.streams, definition.frameGroups,
+                     definition.exposureGroups, definition.rawFrameSets, processingParameters, additionalData);
+    const auto hash = calculateUseCaseHash (definition);
+
+    AllocationWindow window;
+    bool sameUseCase = true;
+    for (auto curFrame = 1u; curFrame < numFrames; ++curFrame)
+    {
+        reader.seek (curFrame);
+        reader.getFrame (frameData, &definition.frameHeader, definition.streams, definition.frameGroups,
+                         definition.exposureGroups, definition.rawFrameSets, processingParameters, additionalData);
+        sameUseCase &= calculateUseCaseHash (definition) == hash;
+    }
+    const auto allocations = window.count();
+
+    EXPECT_TRUE (sameUseCase);
+    EXPECT_EQ (0u, allocations);
+
+    // Check the data of the last frame, createFrames numbers the pseudo data line and the image
+    // data like the slot in frameData
+    const auto slotSize = definition.frameHeader.numColumns * (definition.frameHeader.numRows + 1u);
+    for (size_t i = 0; i < definition.frameHeader.numRawFrames; ++i)
+    {
+        for (auto idx = 0u; idx < slotSize; ++idx)
+        {
+            ASSERT_EQ (CommonTestRecord::expectedValue (idx, narrow_cast<uint16_t> (numFrames - 1), narrow_cast<uint16_t> (i)),
+                       frameData[i * slotSize + idx]);
+        }
+    }
+
+    EXPECT_NO_THROW (reader.close());
+    remove (testfilename.c_str());
+}
+
+/**
+ * Reads a recording with additional data the way that CameraPlayback does, with two prefetch
+ * buffers and the additional data swapped out of the buffer for each frame.  After the buffers
+ * have been sized, this doesn't allocate either.
+ */
+TEST (TestReaderWriter, GetFrameWithAdditionalDataWithoutAllocations)
+{
+    remove (testfilename.c_str());
+    remove (additionalDataFilename.c_str());
+
+    UseCaseFourPhase testUC (45u, 30000000, {50u, 1000u}, 1000u, 1000u);
+    testUC.setImage (32u, 8u);
+
+    const auto numFrames = 100u;
+    std::vector<UseCaseDefinition> ucVec (numFrames, testUC);
+    writeFile (ucVec);
+    writeFileWithAdditionalData();
+
+    FileReaderDispatcher reader;
+    ASSERT_NO_THROW (reader.open (additionalDataFilename));
+    ASSERT_EQ (numFrames, reader.numFrames());
+
+    struct Buffer
+    {
+        std::vector<uint16_t> frameData;
+        RecordUseCaseDefinition definition;
+        std::vector<royale_processingparameter_v3> processingParameters;
+        std::vector<std::pair<std::string, std::vector<uint8_t>>> additionalData;
+    };
+    Buffer buffers[2];
+    std::vector<std::pair<std::string, std::vector<uint8_t>>> playbackData;
+
+    const auto readFrame = [&] (uint32_t curFrame)
+    {
+        auto &buffer = buffers[curFrame % 2u];
+        reader.seek (curFrame);
+        reader.getFrame (buffer.frameData, &buffer.definition.frameHeader, buffer.definition.streams,
+                         buffer.definition.frameGroups, buffer.definition.exposureGroups,
+                         buffer.definition.rawFrameSets, buffer.processingParameters, buffer.additionalData);
+        playbackData.swap (buffer.additionalData);
+    };
+
+    // Until each of the three vectors has held a frame's additional data
+    const auto warmUpFrames = 3u;
+    for (auto curFrame = 0u; curFrame < warmUpFrames; ++curFrame)
+    {
+        readFrame (curFrame);
+    }
+
+    AllocationWindow window;
+    for (auto curFrame = warmUpFrames; curFrame < numFrames; ++curFrame)
+    {
+        readFrame (curFrame);
+    }
+    const auto allocations = window.count();
+
+    EXPECT_EQ (0u, allocations);
+
+    ASSERT_EQ (2u, playbackData.size());
+    EXPECT_STREQ ("block0", playbackData[0].first.c_str());
+    EXPECT_STREQ ("block1", playbackData[1].first.c_str());
+    ASSERT_EQ (13u, playbackData[0].second.size());
+    ASSERT_EQ (1000u, playbackData[1].second.size());
+    for (size_t i = 0u; i < playbackData.size(); ++i)
+    {
+        for (size_t offset = 0u; offset < playbackData[i].second.size(); ++offset)
+        {
+            ASSERT_EQ (expectedAdditionalData (numFrames - 1u, i, offset), playbackData[i].second[offset]);
+        }
+    }
+
+    EXPECT_NO_THROW (reader.close());
+    remove (testfilename.c_str());
+    remove (additionalDataFilename.c_str());
+}
+
 TEST (TestReaderWriter, WriteError)
 {
     remove (testfilename.c_str());
@@ -0,0 +1,143 @@
+/****************************************************************************\
+ * Copyright (C) 2019 pmdtechnologies ag
+ *
+ * THIS CODE AND INFORMATION ARE PROVIDED "AS IS" WITHOUT WARRANTY OF ANY
+ * KIND, EITHER EXPRESSED OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND/OR FITNESS FOR A
+ * PARTICULAR PURPOSE.
+ *
+ \****************************************************************************/
+
+#pragma once
+
+#include <FakeBridgeImager.hpp>
+#include <FakeFrameSource.hpp>
+
+#include <hal/IBridgeDataReceiver.hpp>
+#include <hal/ICapturedBuffer.hpp>
+
+#include <atomic>
+#include <condition_variable>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace royale
+{
+    namespace stub
+    {
+        /**
+         * An IBridgeDataReceiver which generates the frames of a FakeBridgeImager, one buffer per
+         * raw frame (individual frame transmission).  The image data comes from an
+         * IFakeFrameSource, the pseudo data is the M2450_A12 AIO layout with a continuous frame
+         * counter, the sequence index and the imager's reconfig index.
+         *
+         * Each buffer is timestamped when it's sent to the listener.  The raw frames of a
+         * sequence are sent back-to-back, so the timestamp of the resulting depth frame is the
+         * time at which its data was complete.
+         *
+         * Sequences are sent at a fixed rate.  If the listener hasn't returned enough buffers,
+         * raw frames are dropped as a real bridge would do.  With a rate of zero each sequence
+         * is sent as soon as buffers are available, which measures the maximum throughput of
+         * the processing chain.
+         *
+         * Nothing is allocated while capturing, all buffers are created in executeUseCase.
+         */
+        class FakeBridgeDataReceiver : public royale::hal::IBridgeDataReceiver
+        {
+        public:
+            FakeBridgeDataReceiver (std::shared_ptr<FakeBridgeImager> imager,
+                                    std::shared_ptr<IFakeFrameSource> source);
+            ~FakeBridgeDataReceiver() override;
+
+            /**
+             * Sets the sequence for the next capture.  Must be called while the capture is
+             * stopped.
+             *
+             * \param rawFramesPerSequence number of raw frames in each sequence
+             * \param sequencesPerSecond rate at which sequences are sent, or zero for as fast as
+             *        possible
+             */
+            void setSequence (std::size_t rawFramesPerSequence, double sequencesPerSecond);
+
+            /**
+             * Number of raw frames that were dropped because no buffer was free, since the last
+             * call to startCapture.
+             */
+            std::size_t getDroppedFrames() const;
+
+            // IBridgeDataReceiver
+            void setBufferCaptureListener (royale::hal::IBufferCaptureListener *collector) override;
+            std::size_t executeUseCase (int width, int height, std::size_t preferredBufferCount) override;
+            float getPeakTransferSpeed() override;
+            void startCapture() override;
+            void stopCapture() override;
+            bool isConnected() const override;
+            royale::Vector<royale::Pair<royale::String, royale::String>> getBridgeInfo() override;
+            void setEventListener (royale::IEventListener *listener) override;
+
+            // IBufferCaptureReleaser
+            void queueBuffer (royale::hal::ICapturedBuffer *buffer) override;
+
+        private:
+            class FakeCapturedBuffer : public royale::hal::ICapturedBuffer
+            {
+            public:
+                explicit FakeCapturedBuffer (std::size_t pixelCount) :
+                    m_data (pixelCount),
+                    m_time (0u)
+                {
+                }
+
+                uint16_t *getPixelData() override
+                {
+                    return m_data.data();
+                }
+
+                std::size_t getPixelCount() override
+                {
+                    return m_data.size();
+                }
+
+                uint64_t getTimeMicroseconds() override
+                {
+                    return m_time;
+                }
+
+                std::vector<uint16_t> m_data;
+                uint64_t m_time;
+            };
+
+            void generateThread();
+
+            /**
+             * Returns a free buffer, or nullptr if none is free.  If wait is true, waits until a
+             * buffer is free or the capture is stopped.
+             */
+            FakeCapturedBuffer *dequeueBuffer (bool wait);
+
+            void sendFrame (FakeCapturedBuffer *buffer, uint16_t sequenceIndex, uint16_t reconfigIndex);
+
+            const std::shared_ptr<FakeBridgeImager> m_imager;
+            const std::shared_ptr<IFakeFrameSource> m_source;
+
+            std::mutex m_lock;
+            std::condition_variable m_cv;
+            royale::hal::IBufferCaptureListener *m_listener;
+            std::vector<std::unique_ptr<FakeCapturedBuffer>> m_buffers;
+            std::vector<FakeCapturedBuffer *> m_freeBuffers;
+            std::size_t m_width;
+            std::size_t m_height;
+
+            std::size_t m_rawFramesPerSequence;
+            double m_sequencesPerSecond;
+
+            std::thread m_thread;
+            std::atomic<bool> m_running;
+            std::atomic<std::size_t> m_droppedFrames;
+            uint32_t m_frameCounter;
+            uint32_t m_sequenceCounter;
+        };
+    }
+}
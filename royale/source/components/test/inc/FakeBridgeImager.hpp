@@ -0,0 +1,73 @@
+/****************************************************************************\
+ * Copyright (C) 2019 pmdtechnologies ag
+ *
+ * THIS CODE AND INFORMATION ARE PROVIDED "AS IS" WITHOUT WARRANTY OF ANY
+ * KIND, EITHER EXPRESSED OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND/OR FITNESS FOR A
+ * PARTICULAR PURPOSE.
+ *
+ \****************************************************************************/
+
+#pragma once
+
+#include <hal/IBridgeImager.hpp>
+
+#include <atomic>
+#include <map>
+#include <mutex>
+
+namespace royale
+{
+    namespace stub
+    {
+        /**
+         * An IBridgeImager without hardware, which answers register accesses like an
+         * M2450_A12 running the AllInOne firmware (the imager of the pico flexx).  This is the
+         * same model as the SimImagerM2450_A12_AIO of the imager component's unit tests, plus
+         * the firmware's handling of the safe-reconfig counter.
+         *
+         * Registers that the model doesn't know read back the last value written to them, or
+         * zero.  sleepFor() returns immediately, so that switching use cases doesn't add
+         * imager-specific waits to the measurements.
+         *
+         * The FakeBridgeDataReceiver uses isCapturing() and startSequence() to generate the
+         * frames that the imager would be sending.
+         */
+        class FakeBridgeImager : public royale::hal::IBridgeImager
+        {
+        public:
+            FakeBridgeImager();
+            ~FakeBridgeImager() = default;
+
+            void setImagerReset (bool state) override;
+            void readImagerRegister (uint16_t regAddr, uint16_t &value) override;
+            void writeImagerRegister (uint16_t regAddr, uint16_t value) override;
+            void readImagerBurst (uint16_t firstRegAddr, std::vector<uint16_t> &values) override;
+            void writeImagerBurst (uint16_t firstRegAddr, const std::vector<uint16_t> &values) override;
+            void sleepFor (std::chrono::microseconds sleepDuration) override;
+
+            /**
+             * True between the imager's start and stop triggers.
+             */
+            bool isCapturing() const;
+
+            /**
+             * Called at the start of each sequence that the imager sends.  A pending safe
+             * reconfiguration is applied here, as the firmware does between two sequences.
+             *
+             * \return the reconfig index to put in the pseudo data of the sequence's frames
+             */
+            uint16_t startSequence();
+
+        private:
+            void writeLocked (uint16_t regAddr, uint16_t value);
+            void startCapturing();
+            void stopCapturing();
+
+            std::mutex m_lock;
+            std::map<uint16_t, uint16_t> m_registers;
+            std::atomic<bool> m_capturing;
+            bool m_reconfigPending;
+        };
+    }
+}
@@ -0,0 +1,105 @@
+/****************************************************************************\
+ * Copyright (C) 2019 pmdtechnologies ag
+ *
+ * THIS CODE AND INFORMATION ARE PROVIDED "AS IS" WITHOUT WARRANTY OF ANY
+ * KIND, EITHER EXPRESSED OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND/OR FITNESS FOR A
+ * PARTICULAR PURPOSE.
+ *
+ \****************************************************************************/
+
+#pragma once
+
+#include <cstdint>
+#include <map>
+#include <string>
+#include <tuple>
+#include <vector>
+
+namespace royale
+{
+    namespace stub
+    {
+        /**
+         * Provides the image part of the frames that the FakeBridgeDataReceiver sends.  The pseudo
+         * data is always generated by the FakeBridgeDataReceiver.
+         *
+         * fillImage is called from the receiver's thread for every frame, implementations must not
+         * allocate memory there.
+         */
+        class IFakeFrameSource
+        {
+        public:
+            virtual ~IFakeFrameSource() = default;
+
+            /**
+             * Fills width * height pixels (12 bit, native endian) of image data.
+             *
+             * \param sequenceIndex position of the raw frame in the use case's sequence
+             * \param sequenceCounter incremented for each sequence that the receiver sends
+             */
+            virtual void fillImage (uint16_t *image, std::size_t width, std::size_t height,
+                                    uint16_t sequenceIndex, uint32_t sequenceCounter) = 0;
+        };
+
+        /**
+         * A gradient which moves with every frame.  Processing the data won't give a sensible
+         * depth image, but the processing does the same work as for a real scene.
+         */
+        class SyntheticFrameSource : public IFakeFrameSource
+        {
+        public:
+            void fillImage (uint16_t *image, std::size_t width, std::size_t height,
+                            uint16_t sequenceIndex, uint32_t sequenceCounter) override;
+        };
+
+        /**
+         * Replays the raw frames of a recording.  All frames are read when the source is
+         * created, so that reading the file doesn't influence the measurements.
+         *
+         * The frames are selected by size and sequence index, if the recording doesn't contain
+         * a matching frame then the SyntheticFrameSource is used instead.
+         */
+        class RrfFrameSource : public IFakeFrameSource
+        {
+        public:
+            /**
+             * \param filename the recording
+             * \param maxFrames only the first maxFrames frames (each consisting of several raw
+             *        frames) are kept in memory
+             * \throw std::exception subclass if the file can't be read
+             */
+            RrfFrameSource (const std::string &filename, uint32_t maxFrames);
+
+            void fillImage (uint16_t *image, std::size_t width, std::size_t height,
+                            uint16_t sequenceIndex, uint32_t sequenceCounter) override;
+
+            /**
+             * The calibration stored in the recording, may be empty.
+             */
+            const std::vector<uint8_t> &getCalibrationData() const;
+
+            /**
+             * The number of raw frames that were read from the recording.
+             */
+            std::size_t getRawFrameCount() const;
+
+        private:
+            struct FrameKey
+            {
+                std::size_t width;
+                std::size_t height;
+                uint16_t sequenceIndex;
+
+                bool operator< (const FrameKey &rhs) const
+                {
+                    return std::tie (width, height, sequenceIndex) < std::tie (rhs.width, rhs.height, rhs.sequenceIndex);
+                }
+            };
+
+            std::map<FrameKey, std::vector<std::vector<uint16_t>>> m_frames;
+            std::vector<uint8_t> m_calibration;
+            SyntheticFrameSource m_fallback;
+        };
+    }
+}
@@ -0,0 +1,263 @@
+/****************************************************************************\
+ * Copyright (C) 2019 pmdtechnologies ag
+ *
+ * THIS CODE AND INFORMATION ARE PROVIDED "AS IS" WITHOUT WARRANTY OF ANY
+ * KIND, EITHER EXPRESSED OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND/OR FITNESS FOR A
+ * PARTICULAR PURPOSE.
+ *
+ \****************************************************************************/
+
+#include <FakeBridgeDataReceiver.hpp>
+
+#include <common/exceptions/LogicError.hpp>
+#include <hal/IBufferCaptureListener.hpp>
+#include <imager/M2450_A12/PseudoDataInterpreter_AIO.hpp>
+
+#include <algorithm>
+#include <chrono>
+#include <limits>
+
+using namespace royale::stub;
+using namespace royale::common;
+using royale::imager::M2450_A12::PseudoDataInterpreter_AIO;
+
+namespace
+{
+    /**
+     * Temperature sensor values for the pseudo data, these give about 30 degrees with the
+     * M2450_A12 interpreter's formula.
+     */
+    const uint16_t TEMPERATURE_ADC = 3265;
+    const uint16_t TEMPERATURE_CALIBRATION = 68;
+
+    /**
+     * How long the thread waits for the imager to be started before checking again.
+     */
+    const auto IMAGER_POLL_INTERVAL = std::chrono::milliseconds (1);
+}
+
+FakeBridgeDataReceiver::FakeBridgeDataReceiver (std::shared_ptr<FakeBridgeImager> imager,
+        std::shared_ptr<IFakeFrameSource> source) :
+    m_imager (std::move (imager)),
+    m_source (std::move (source)),
+    m_listener (nullptr),
+    m_width (0u),
+    m_height (0u),
+    m_rawFramesPerSequence (1u),
+    m_sequencesPerSecond (0.),
+    m_running (false),
+    m_droppedFrames (0u),
+    m_frameCounter (0u),
+    m_sequenceCounter (0u)
+{
+}
+
+FakeBridgeDataReceiver::~FakeBridgeDataReceiver()
+{
+    stopCapture();
+}
+
+void FakeBridgeDataReceiver::setSequence (std::size_t rawFramesPerSequence, double sequencesPerSecond)
+{
+    std::lock_guard<std::mutex> lock (m_lock);
+    m_rawFramesPerSequence = std::max<std::size_t> (rawFramesPerSequence, 1u);
+    m_sequencesPerSecond = std::max (sequencesPerSecond, 0.);
+}
+
+std::size_t FakeBridgeDataReceiver::getDroppedFrames() const
+{
+    return m_droppedFrames;
+}
+
+void FakeBridgeDataReceiver::setBufferCaptureListener (royale::hal::IBufferCaptureListener *collector)
+{
+    std::lock_guard<std::mutex> lock (m_lock);
+    m_listener = collector;
+}
+
+std::size_t FakeBridgeDataReceiver::executeUseCase (int width, int height, std::size_t preferredBufferCount)
+{
+    if (width < PseudoDataInterpreter_AIO::METAFRAMECNTR + 1 || height < 2)
+    {
+        throw LogicError ("The use case's frames are too small for the pseudo data");
+    }
+
+    std::unique_lock<std::mutex> lock (m_lock);
+    m_cv.wait (lock, [this] { return m_freeBuffers.size() == m_buffers.size(); });
+
+    const auto pixelCount = static_cast<std::size_t> (width) * static_cast<std::size_t> (height);
+    if (m_buffers.size() != preferredBufferCount || pixelCount != m_width * m_height)
+    {
+        m_freeBuffers.clear();
+        m_buffers.clear();
+        for (std::size_t i = 0; i < preferredBufferCount; i++)
+        {
+            m_buffers.emplace_back (new FakeCapturedBuffer (pixelCount));
+            m_freeBuffers.push_back (m_buffers.back().get());
+        }
+    }
+    m_width = static_cast<std::size_t> (width);
+    m_height = static_cast<std::size_t> (height);
+    return m_buffers.size();
+}
+
+float FakeBridgeDataReceiver::getPeakTransferSpeed()
+{
+    return std::numeric_limits<float>::infinity();
+}
+
+void FakeBridgeDataReceiver::startCapture()
+{
+    if (m_running)
+    {
+        return;
+    }
+    m_droppedFrames = 0u;
+    m_running = true;
+    m_thread = std::thread (&FakeBridgeDataReceiver::generateThread, this);
+}
+
+void FakeBridgeDataReceiver::stopCapture()
+{
+    {
+        std::lock_guard<std::mutex> lock (m_lock);
+        m_running = false;
+    }
+    m_cv.notify_all();
+    if (m_thread.joinable())
+    {
+        m_thread.join();
+    }
+}
+
+bool FakeBridgeDataReceiver::isConnected() const
+{
+    return true;
+}
+
+royale::Vector<royale::Pair<royale::String, royale::String>> FakeBridgeDataReceiver::getBridgeInfo()
+{
+    royale::Vector<royale::Pair<royale::String, royale::String>> info;
+    info.push_back (royale::Pair<royale::String, royale::String> ("BRIDGE_TYPE", "Fake"));
+    return info;
+}
+
+void FakeBridgeDataReceiver::setEventListener (royale::IEventListener *)
+{
+    // The fake bridge has no errors to report
+}
+
+void FakeBridgeDataReceiver::queueBuffer (royale::hal::ICapturedBuffer *buffer)
+{
+    {
+        std::lock_guard<std::mutex> lock (m_lock);
+        m_freeBuffers.push_back (static_cast<FakeCapturedBuffer *> (buffer));
+    }
+    m_cv.notify_all();
+}
+
+FakeBridgeDataReceiver::FakeCapturedBuffer *FakeBridgeDataReceiver::dequeueBuffer (bool wait)
+{
+    std::unique_lock<std::mutex> lock (m_lock);
+    if (wait)
+    {
+        m_cv.wait (lock, [this] { return !m_freeBuffers.empty() || !m_running; });
+    }
+    if (m_freeBuffers.empty() || !m_running)
+    {
+        return nullptr;
+    }
+    auto buffer = m_freeBuffers.back();
+    m_freeBuffers.pop_back();
+    return buffer;
+}
+
+void FakeBridgeDataReceiver::generateThread()
+{
+    using clock = std::chrono::steady_clock;
+
+    std::size_t rawFramesPerSequence;
+    clock::duration period;
+    {
+        std::lock_guard<std::mutex> lock (m_lock);
+        rawFramesPerSequence = m_rawFramesPerSequence;
+        period = m_sequencesPerSecond > 0. ?
+                 std::chrono::duration_cast<clock::duration> (std::chrono::duration<double> (1. / m_sequencesPerSecond)) :
+                 clock::duration::zero();
+    }
+    const bool freeRunning = period == clock::duration::zero();
+
+    auto nextSequence = clock::now();
+    while (m_running)
+    {
+        if (!m_imager->isCapturing())
+        {
+            std::this_thread::sleep_for (IMAGER_POLL_INTERVAL);
+            nextSequence = clock::now();
+            continue;
+        }
+
+        if (!freeRunning)
+        {
+            {
+                std::unique_lock<std::mutex> lock (m_lock);
+                if (m_cv.wait_until (lock, nextSequence, [this] { return !m_running; }))
+                {
+                    break;
+                }
+            }
+            // An imager doesn't catch up on sequences which it couldn't send
+            const auto now = clock::now();
+            nextSequence = std::max (nextSequence + period, now);
+        }
+
+        const auto reconfigIndex = m_imager->startSequence();
+        for (std::size_t i = 0; i < rawFramesPerSequence && m_running; i++)
+        {
+            auto buffer = dequeueBuffer (freeRunning);
+            if (buffer)
+            {
+                sendFrame (buffer, static_cast<uint16_t> (i), reconfigIndex);
+            }
+            else if (m_running)
+            {
+                m_droppedFrames++;
+            }
+            m_frameCounter++;
+        }
+        m_sequenceCounter++;
+    }
+}
+
+void FakeBridgeDataReceiver::sendFrame (FakeCapturedBuffer *buffer, uint16_t sequenceIndex, uint16_t reconfigIndex)
+{
+    auto pseudoData = buffer->m_data.data();
+    std::fill (pseudoData, pseudoData + m_width, uint16_t (0));
+    pseudoData[1] = static_cast<uint16_t> ( (m_width / 16) & 31);
+    pseudoData[2] = static_cast<uint16_t> ( (m_height - 1) & 511);
+    pseudoData[5] = TEMPERATURE_ADC;
+    pseudoData[7] = TEMPERATURE_CALIBRATION;
+    pseudoData[PseudoDataInterpreter_AIO::RECONFIG_INDEX] = reconfigIndex;
+    pseudoData[PseudoDataInterpreter_AIO::METASEQ_INDEX] = sequenceIndex;
+    pseudoData[PseudoDataInterpreter_AIO::METAFRAMECNTR] = static_cast<uint16_t> (m_frameCounter & 0xfff);
+
+    m_source->fillImage (pseudoData + m_width, m_width, m_height - 1, sequenceIndex, m_sequenceCounter);
+
+    buffer->m_time = static_cast<uint64_t> (std::chrono::duration_cast<std::chrono::microseconds> (
+            std::chrono::system_clock::now().time_since_epoch()).count());
+
+    royale::hal::IBufferCaptureListener *listener;
+    {
+        std::lock_guard<std::mutex> lock (m_lock);
+        listener = m_listener;
+    }
+    if (listener)
+    {
+        listener->bufferCallback (buffer);
+    }
+    else
+    {
+        queueBuffer (buffer);
+    }
+}
@@ -0,0 +1,179 @@
+/****************************************************************************\
+ * Copyright (C) 2019 pmdtechnologies ag
+ *
+ * THIS CODE AND INFORMATION ARE PROVIDED "AS IS" WITHOUT WARRANTY OF ANY
+ * KIND, EITHER EXPRESSED OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND/OR FITNESS FOR A
+ * PARTICULAR PURPOSE.
+ *
+ \****************************************************************************/
+
+#include <FakeBridgeImager.hpp>
+
+#include <imager/M2450_A12/ImagerRegisters.hpp>
+
+using namespace royale::stub;
+using namespace royale::imager::M2450_A12;
+
+namespace
+{
+    const uint16_t AIO_SR_RECONFIGFLAGS = CFGCNT_S30_PS;
+    const uint16_t AIO_SR_RECONFIG_COUNTER = CFGCNT_S30_PLLSET;
+    const uint16_t AIO_SR_TRIGGER = CFGCNT_S31_EXPOTIME;
+
+    /**
+     * CFGCNT_STATUS after the firmware has run once and is idle
+     */
+    const uint16_t STATUS_IDLE = 0x8001;
+}
+
+FakeBridgeImager::FakeBridgeImager() :
+    m_capturing (false),
+    m_reconfigPending (false)
+{
+    m_registers = std::map<uint16_t, uint16_t>
+    {
+        { ANAIP_DESIGNSTEP, 0x0A12 },
+        { ANAIP_EFUSEVAL1, 0x0100 },
+        { CFGCNT_STATUS, STATUS_IDLE },
+        { MTCU_STATUS, 0x0001 },
+        { iSM_ISMSTATE, 0x1000 },
+        { MTCU_SEQNUM, 0x0000 },
+        { CFGCNT_TRIG, 0x0000 },
+        { 0xB04F, 0x5529 },
+        { 0xB050, 0x5555 },
+        { 0xB051, 0x4E15 },
+        { 0xB052, 0xC71B },
+        { 0xB053, 0x0000 },
+        { RECONFIG_COUNTER, 0x0000 },
+        { AIO_SR_RECONFIGFLAGS, 0x0000 },
+        { AIO_SR_RECONFIG_COUNTER, 0x0000 }
+    };
+}
+
+void FakeBridgeImager::setImagerReset (bool)
+{
+}
+
+void FakeBridgeImager::readImagerRegister (uint16_t regAddr, uint16_t &value)
+{
+    std::lock_guard<std::mutex> lock (m_lock);
+    const auto reg = m_registers.find (regAddr);
+    value = reg == m_registers.end() ? 0 : reg->second;
+}
+
+void FakeBridgeImager::writeImagerRegister (uint16_t regAddr, uint16_t value)
+{
+    std::lock_guard<std::mutex> lock (m_lock);
+    writeLocked (regAddr, value);
+}
+
+void FakeBridgeImager::readImagerBurst (uint16_t firstRegAddr, std::vector<uint16_t> &values)
+{
+    std::lock_guard<std::mutex> lock (m_lock);
+    for (std::size_t i = 0; i < values.size(); i++)
+    {
+        const auto reg = m_registers.find (static_cast<uint16_t> (firstRegAddr + i));
+        values[i] = reg == m_registers.end() ? 0 : reg->second;
+    }
+}
+
+void FakeBridgeImager::writeImagerBurst (uint16_t firstRegAddr, const std::vector<uint16_t> &values)
+{
+    std::lock_guard<std::mutex> lock (m_lock);
+    for (std::size_t i = 0; i < values.size(); i++)
+    {
+        writeLocked (static_cast<uint16_t> (firstRegAddr + i), values[i]);
+    }
+}
+
+void FakeBridgeImager::sleepFor (std::chrono::microseconds)
+{
+}
+
+bool FakeBridgeImager::isCapturing() const
+{
+    return m_capturing.load();
+}
+
+uint16_t FakeBridgeImager::startSequence()
+{
+    std::lock_guard<std::mutex> lock (m_lock);
+    if (m_reconfigPending)
+    {
+        // The imager has read the counter before triggering the reconfiguration, all frames
+        // with the new configuration have a higher index
+        m_registers[AIO_SR_RECONFIG_COUNTER]++;
+        m_reconfigPending = false;
+    }
+    return m_registers[AIO_SR_RECONFIG_COUNTER];
+}
+
+void FakeBridgeImager::writeLocked (uint16_t regAddr, uint16_t value)
+{
+    m_registers[regAddr] = value;
+
+    switch (regAddr)
+    {
+        case iSM_EN:
+            if (m_registers[iSM_CTRL] == 1 && value == 1)
+            {
+                m_registers[MTCU_STATUS] &= static_cast<uint16_t> (~ (0x1 << 2));
+                m_registers[iSM_ISMSTATE] = 0x1000;
+            }
+            if (m_registers[iSM_CTRL] == 2 && value == 2)
+            {
+                m_registers[iSM_ISMSTATE] = 0;
+            }
+            break;
+
+        case CFGCNT_TRIG:
+            if (value & 0x01)
+            {
+                startCapturing();
+            }
+            else
+            {
+                stopCapturing();
+            }
+            break;
+
+        case AIO_SR_RECONFIGFLAGS:
+            // The firmware clears the flags when it has copied the safe-reconfig registers to the
+            // shadow config, this copy always succeeds
+            m_registers[AIO_SR_RECONFIGFLAGS] = 0;
+            m_reconfigPending |= (value != 0);
+            break;
+
+        case AIO_SR_TRIGGER:
+            if (value & 0x01)
+            {
+                m_registers[iSM_ISMSTATE] = (1 << 14);
+                startCapturing();
+            }
+            else
+            {
+                stopCapturing();
+            }
+            break;
+
+        default:
+            break;
+    }
+}
+
+void FakeBridgeImager::startCapturing()
+{
+    // busy, no errors
+    m_registers[CFGCNT_STATUS] = 0;
+    m_registers[MTCU_STATUS] = 0;
+    m_capturing = true;
+}
+
+void FakeBridgeImager::stopCapturing()
+{
+    // idle, no errors
+    m_registers[CFGCNT_STATUS] = STATUS_IDLE;
+    m_registers[MTCU_STATUS] = 1;
+    m_capturing = false;
+}
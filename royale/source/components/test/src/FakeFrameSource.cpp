@@ -0,0 +1,97 @@
+/****************************************************************************\
+ * Copyright (C) 2019 pmdtechnologies ag
+ *
+ * THIS CODE AND INFORMATION ARE PROVIDED "AS IS" WITHOUT WARRANTY OF ANY
+ * KIND, EITHER EXPRESSED OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND/OR FITNESS FOR A
+ * PARTICULAR PURPOSE.
+ *
+ \****************************************************************************/
+
+#include <FakeFrameSource.hpp>
+
+#include <record/FileReaderDispatcher.hpp>
+
+#include <algorithm>
+#include <cstring>
+
+using namespace royale::stub;
+
+void SyntheticFrameSource::fillImage (uint16_t *image, std::size_t width, std::size_t height,
+                                      uint16_t sequenceIndex, uint32_t sequenceCounter)
+{
+    const auto offset = static_cast<std::size_t> (sequenceIndex) * 512u + sequenceCounter;
+    for (std::size_t y = 0; y < height; y++)
+    {
+        auto line = image + y * width;
+        for (std::size_t x = 0; x < width; x++)
+        {
+            line[x] = static_cast<uint16_t> ( (x * 16u + y * 8u + offset) & 0xfff);
+        }
+    }
+}
+
+RrfFrameSource::RrfFrameSource (const std::string &filename, uint32_t maxFrames)
+{
+    royale::record::FileReaderDispatcher reader;
+    reader.open (filename);
+
+    if (reader.hasCalibrationData())
+    {
+        m_calibration = reader.getCalibrationData();
+    }
+
+    std::vector<std::vector<uint16_t>> imageData;
+    std::vector<std::vector<uint16_t>> pseudoData;
+    royale_frameheader_v3 frameHeader;
+    std::vector<royale_streamheader_v3> streams;
+    std::vector<royale_framegroupheader_v3> frameGroups;
+    std::vector<royale_exposuregroupheader_v3> exposureGroups;
+    std::vector<royale_rawframesetheader_v3> rawFrameSets;
+    std::vector<royale_processingparameter_v3> processingParameters;
+    std::vector<std::pair<std::string, std::vector<uint8_t>>> additionalData;
+
+    const auto numFrames = std::min (reader.numFrames(), maxFrames);
+    for (uint32_t i = 0; i < numFrames; i++)
+    {
+        reader.seek (i);
+        reader.get (imageData, pseudoData, &frameHeader, streams, frameGroups, exposureGroups,
+                    rawFrameSets, processingParameters, additionalData);
+
+        for (std::size_t idx = 0; idx < imageData.size(); idx++)
+        {
+            const FrameKey key { frameHeader.numColumns, frameHeader.numRows, static_cast<uint16_t> (idx) };
+            m_frames[key].push_back (std::move (imageData[idx]));
+        }
+    }
+    reader.close();
+}
+
+void RrfFrameSource::fillImage (uint16_t *image, std::size_t width, std::size_t height,
+                                uint16_t sequenceIndex, uint32_t sequenceCounter)
+{
+    const auto frames = m_frames.find (FrameKey { width, height, sequenceIndex });
+    if (frames == m_frames.end())
+    {
+        m_fallback.fillImage (image, width, height, sequenceIndex, sequenceCounter);
+        return;
+    }
+
+    const auto &frame = frames->second[sequenceCounter % frames->second.size()];
+    std::memcpy (image, frame.data(), std::min (frame.size(), width * height) * sizeof (uint16_t));
+}
+
+const std::vector<uint8_t> &RrfFrameSource::getCalibrationData() const
+{
+    return m_calibration;
+}
+
+std::size_t RrfFrameSource::getRawFrameCount() const
+{
+    std::size_t count = 0;
+    for (const auto &frames : m_frames)
+    {
+        count += frames.second.size();
+    }
+    return count;
+}
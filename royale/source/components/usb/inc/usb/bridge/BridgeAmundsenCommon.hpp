@@ -152,14 +152,17 @@ namespace royale
                  *
                  * If the subclass successfully queues this data area for IO, it should return
                  * SUCCESS. If it reaches an internal limit on the number of data areas that can be
-                 * queued, it should return ALL_BUFFERS_ALREADY_PREPARED.
+                 * queued, it should return ALL_BUFFERS_ALREADY_PREPARED.  BridgeAmundsenCommon
+                 * chooses how many areas it queues (see executeUseCase), the subclass' limit only
+                 * needs to be large enough for fast connections.
                  *
                  * This may (and optimally will) be called before all of the previously-prepared
                  * buffers have been used, which does not cancel the previous call.  Separate calls to
-                 * this function may use non-contiguous areas of memory, or may wrap-round on a
-                 * large circular buffer; the only guarantee is that the BridgeAmundsenCommon will
-                 * ensure that an already-prepared area won't be reused until after the
-                 * corresponding call to receivePayload or cancelPendingPayloads.
+                 * this function may use non-contiguous areas of memory, may wrap-round on a
+                 * large circular buffer, or may point directly in to the frame buffers; the only
+                 * guarantee is that the BridgeAmundsenCommon will ensure that an already-prepared
+                 * area won't be reused until after the corresponding call to receivePayload or
+                 * cancelPendingPayloads.
                  *
                  * The implementation of stopCapture() will call cancelPendingPayloads().
                  */
@@ -225,6 +228,37 @@ namespace royale
                  */
                 void acquisitionFunction();
 
+                /**
+                 * State of the direct receive mode of acquisitionFunction, defined in the .cpp.
+                 */
+                struct DirectReceive;
+
+                /**
+                 * Parts of acquisitionFunction for the direct receive mode.  Queues payloads in to
+                 * the frame buffers, up to m_receiveQueueDepth of them.
+                 */
+                void prepareDirectPayloads (DirectReceive &direct);
+
+                /**
+                 * Parts of acquisitionFunction for the direct receive mode.  Receives the next
+                 * payload, and passes the frame to the IBufferCaptureListener if it's complete.
+                 *
+                 * \return false if the payload doesn't fit in the layout of the frames, and the
+                 * direct receive mode has to be stopped
+                 */
+                bool receiveDirectPayload (DirectReceive &direct, bool &currentFrameIdentifier);
+
+                /**
+                 * Cancels the payloads of the direct receive mode and releases its frame buffers.
+                 */
+                void stopDirectReceive (DirectReceive &direct);
+
+                /**
+                 * Version of dequeueInternalBuffer() that returns nullptr instead of waiting for a
+                 * buffer.
+                 */
+                royale::buffer::OffsetBasedCapturedBuffer *tryDequeueInternalBuffer();
+
                 /**
                  * Control variable, set to false to signal the m_acquisitionThread to finish.
                  *
@@ -250,6 +284,29 @@ namespace royale
                  */
                 std::size_t m_receiveBufferStrides;
 
+                /**
+                 * Where the pixel data starts in each frame buffer.  The direct receive mode reads
+                 * the payloads in to the start of the frame buffer, one per stride, and converts
+                 * them in place.  This offset keeps the converted data from overwriting the
+                 * payloads that haven't been converted yet.
+                 *
+                 * Must only be changed while the acquisition thread is stopped.
+                 */
+                std::size_t m_pixelOffset;
+
+                /**
+                 * The number of payloads that the direct receive mode keeps queued for I/O,
+                 * depending on the size of the frames and on the USB speed.
+                 *
+                 * Must only be changed while the acquisition thread is stopped.
+                 */
+                std::size_t m_receiveQueueDepth;
+
+                /**
+                 * Set by the acquisition thread while it calls tryDequeueInternalBuffer().
+                 */
+                bool m_nonBlockingDequeue {false};
+
                 /**
                  * Whether the data received will be in RAW12 or RAW16 format, or auto-detect.
                  *
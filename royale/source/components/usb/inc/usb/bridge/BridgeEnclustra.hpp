@@ -12,6 +12,7 @@
 
 #include <buffer/BridgeInternalBufferAlloc.hpp>
 #include <hal/IBridgeImager.hpp>
+#include <hal/IBridgeImagerTransactionCost.hpp>
 #include <storage/IBridgeWithPagedFlash.hpp>
 #include <pal/II2cBusAccess.hpp>
 #include <common/EventForwarder.hpp>
@@ -81,7 +82,7 @@ namespace royale
              * options are handled by different subclasses of BridgeEnclustra, and the
              * bridge factory should create the appropriate subclass.
              */
-            class BridgeEnclustra : public buffer::BridgeInternalBufferAlloc, public royale::pal::II2cBusAccess, public royale::hal::IBridgeImager, public royale::storage::IBridgeWithPagedFlash
+            class BridgeEnclustra : public buffer::BridgeInternalBufferAlloc, public royale::pal::II2cBusAccess, public royale::hal::IBridgeImager, public royale::hal::IBridgeImagerTransactionCost, public royale::storage::IBridgeWithPagedFlash
             {
                 typedef std::vector<uint16_t>::size_type reg16VectorSize_t;
 
@@ -109,6 +110,9 @@ namespace royale
                 ROYALE_API void writeImagerBurst (uint16_t firstRegAddr, const std::vector<uint16_t> &values) override;
                 ROYALE_API void sleepFor (std::chrono::microseconds sleepDuration) override;
 
+                // From IBridgeImagerTransactionCost
+                ROYALE_API royale::hal::BridgeImagerTransactionCost getTransactionCost() const override;
+
                 /**
                  * As readImagerBurst, but the registers will all be read in a single I2C operation.
                  */
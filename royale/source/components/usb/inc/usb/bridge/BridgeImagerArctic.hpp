@@ -11,6 +11,7 @@
 #pragma once
 
 #include <hal/IBridgeImager.hpp>
+#include <hal/IBridgeImagerTransactionCost.hpp>
 #include <usb/bridge/UvcExtensionArctic.hpp>
 
 namespace royale
@@ -24,7 +25,7 @@ namespace royale
              * common command set, and are accessed via a platform-specific bridge.
              * All I2C commands are tunnelled through the UVC extension.
              */
-            class BridgeImagerArctic : public royale::hal::IBridgeImager
+            class BridgeImagerArctic : public royale::hal::IBridgeImager, public royale::hal::IBridgeImagerTransactionCost
             {
             public:
                 ROYALE_API explicit BridgeImagerArctic (std::shared_ptr<UvcExtensionArctic> extension);
@@ -38,6 +39,9 @@ namespace royale
                 void writeImagerBurst (uint16_t firstRegAddr, const std::vector<uint16_t> &values) override;
                 void sleepFor (std::chrono::microseconds sleepDuration) override;
 
+                // IBridgeImagerTransactionCost
+                royale::hal::BridgeImagerTransactionCost getTransactionCost() const override;
+
             private:
                 /**
                  * The platform-specific low-level part of the control channel implementation.
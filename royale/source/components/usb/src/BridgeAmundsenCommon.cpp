@@ -27,6 +27,9 @@
 #include <buffer/BufferUtils.hpp>
 
 #include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <deque>
 
 using namespace royale::buffer;
 using namespace royale::common;
@@ -51,6 +54,23 @@ namespace
      */
     const std::size_t MIN_PAYLOAD_DATA_SIZE = 0x2c00;
 
+    /**
+     * How much data the direct receive mode keeps queued for I/O, in seconds at the USB speed.
+     * This has to cover the time that the acquisition thread may not be scheduled, but queuing
+     * much more than a frame only holds back more of the frame buffers.
+     */
+    const float RECEIVE_QUEUE_TIME = 0.005f;
+
+    /**
+     * Limits for the number of payloads queued in the direct receive mode.
+     */
+    const std::size_t MIN_RECEIVE_QUEUE_DEPTH = 2;
+
+    /**
+     * Alignment of the pixel data in the frame buffers.
+     */
+    const std::size_t PIXEL_OFFSET_ALIGNMENT = 16;
+
     static_assert (MIN_PAYLOAD_DATA_SIZE <= 0x2fd0,
                    "minimum payload is larger than the CX3 Arctic devices' output");
     static_assert (MIN_PAYLOAD_DATA_SIZE + AMUNDSEN_UVC_HEADER_SIZE < BridgeAmundsenCommon::AMUNDSEN_STRIDE_SIZE,
@@ -116,6 +136,24 @@ namespace
         return (payload[1] & 0x02) != 0;
     }
 
+    /**
+     * The direct receive mode reads each payload of a frame in to its own stride at the start of
+     * the frame buffer, and then converts the data in place.  Like copyAndNormalizeStrides, this
+     * works from the back to the front, so each element's pixels must not start before the
+     * element's own data, and must not overlap the data of the elements in front of it.  This
+     * returns the offset of the pixel data that is needed for that.
+     *
+     * Elements that get larger than a stride when converted move away from the data in front of
+     * them, smaller ones need a little more offset for each stride.
+     */
+    std::size_t inPlacePixelOffset (std::size_t elementSize, std::size_t payloadsPerFrame, BufferDataFormat format)
+    {
+        const std::size_t strideSize = BridgeAmundsenCommon::AMUNDSEN_STRIDE_SIZE;
+        const auto convertedSize = BufferUtils::expectedPixelCount (elementSize, format) * sizeof (uint16_t);
+        const auto shrink = strideSize - std::min (convertedSize, strideSize);
+        return AMUNDSEN_UVC_HEADER_SIZE + (payloadsPerFrame - 1) * shrink;
+    }
+
 #if defined (ROYALE_LOGGING_VERBOSE_BRIDGE)
     void debugDumpHeader (const uint8_t *payload)
     {
@@ -140,6 +178,31 @@ namespace
 #endif
 }
 
+/**
+ * In the direct receive mode each payload is received in to its final place in a frame buffer, one
+ * payload per stride, starting at the frame buffer's underlying buffer.  A slot is one of these
+ * strides.  The slots are numbered in the order that the payloads arrive, starting with the first
+ * slot of the front frame, so slot s is stride (s % payloadsPerFrame) of frames[s /
+ * payloadsPerFrame].
+ */
+struct BridgeAmundsenCommon::DirectReceive
+{
+    /** True while the payloads are received in to the frame buffers */
+    bool active = false;
+    /** Size of each payload including the header, except for the final payload of each frame */
+    std::size_t payloadSize = 0;
+    std::size_t payloadsPerFrame = 0;
+    /** Frame buffers that slots have been prepared in, in slot order */
+    std::deque<OffsetBasedCapturedBuffer *> frames;
+    /** Areas passed to prepareToReceivePayload, in the order that they will receive data */
+    std::deque<uint8_t *> pending;
+    /** The number of slots that have been prepared, and that have been received */
+    std::size_t preparedSlots = 0;
+    std::size_t receivedSlots = 0;
+    /** The frame identifier of the front frame, from its first payload */
+    bool frameIdentifier = false;
+};
+
 BridgeAmundsenCommon::BridgeAmundsenCommon() = default;
 BridgeAmundsenCommon::~BridgeAmundsenCommon() = default;
 
@@ -201,11 +264,8 @@ std::size_t BridgeAmundsenCommon::executeUseCase (int imageWidth, int imageHeigh
     waitCaptureBufferDealloc();
 
     // The UVC protocol's overhead goes in each received block (of up to 16kB), so we have to remove
-    // it while receiving the data.  For the data that we copy to the buffer, the protocol overhead
-    // is omitted, so the only data in the buffer is the pixels.
-    const size_t pixelOffset = 0;
+    // it while receiving the data.  The pixel data is normalized without the protocol overhead.
     const size_t pixelCount = static_cast<size_t> (imageWidth * imageHeight);
-    const size_t bufferSize = pixelCount * sizeof (uint16_t);
 
     m_rawDataSize = BufferUtils::maxRawSize (pixelCount, m_transferFormat);
 
@@ -223,7 +283,33 @@ std::size_t BridgeAmundsenCommon::executeUseCase (int imageWidth, int imageHeigh
         m_receiveBufferStrides = (m_rawDataSize / MIN_PAYLOAD_DATA_SIZE) + 1;
     }
 
-    createAndQueueInternalBuffers (bufferCount, bufferSize, pixelOffset, pixelCount);
+    // For the direct receive mode, the frame buffers also hold the payloads before they are
+    // converted.  The pixel offset is calculated for the smallest payloads that the devices use,
+    // and the data format that needs the larger offset.  For small images any payload size is
+    // accepted.
+    {
+        const auto elementSize = (m_rawDataSize < MIN_PAYLOAD_DATA_SIZE) ? 0 : MIN_PAYLOAD_DATA_SIZE;
+        const auto format = (m_transferFormat == BufferDataFormat::RAW12) ? BufferDataFormat::RAW12 : BufferDataFormat::RAW16;
+        m_pixelOffset = roundUpToUnit (inPlacePixelOffset (elementSize, m_receiveBufferStrides, format), PIXEL_OFFSET_ALIGNMENT);
+    }
+    const size_t bufferSize = std::max (m_pixelOffset + pixelCount * sizeof (uint16_t),
+                                        m_receiveBufferStrides * AMUNDSEN_STRIDE_SIZE);
+
+    // Queue enough payloads to cover RECEIVE_QUEUE_TIME, but not much more than a frame.  With an
+    // unknown speed this is limited by the frame size.
+    {
+        const auto bytesPerSecond = royale::usb::pal::UsbSpeedUtils::calculatePeakTransferSpeed (m_usbSpeed, BufferDataFormat::RAW16) * sizeof (uint16_t);
+        const auto queueBytes = bytesPerSecond * RECEIVE_QUEUE_TIME;
+        const auto maxDepth = m_receiveBufferStrides + 1;
+        m_receiveQueueDepth = maxDepth;
+        if (queueBytes < static_cast<float> (maxDepth * AMUNDSEN_STRIDE_SIZE))
+        {
+            const auto depth = static_cast<std::size_t> (std::ceil (queueBytes / AMUNDSEN_STRIDE_SIZE));
+            m_receiveQueueDepth = std::max (depth, MIN_RECEIVE_QUEUE_DEPTH);
+        }
+    }
+
+    createAndQueueInternalBuffers (bufferCount, bufferSize, m_pixelOffset, pixelCount);
 
     // as createAndQueueInternalBuffers didn't throw, we have all the requested buffers
     return bufferCount;
@@ -254,14 +340,154 @@ void BridgeAmundsenCommon::stopCapture()
 
 bool BridgeAmundsenCommon::shouldBlockForDequeue()
 {
-    return m_runAcquisition;
+    return m_runAcquisition && !m_nonBlockingDequeue;
+}
+
+OffsetBasedCapturedBuffer *BridgeAmundsenCommon::tryDequeueInternalBuffer()
+{
+    m_nonBlockingDequeue = true;
+    auto buffer = dequeueInternalBuffer();
+    m_nonBlockingDequeue = false;
+    return buffer;
+}
+
+void BridgeAmundsenCommon::prepareDirectPayloads (DirectReceive &direct)
+{
+    if (direct.frames.empty())
+    {
+        auto frame = dequeueInternalBuffer (BUFFER_WAIT_TIMEOUT);
+        if (!frame)
+        {
+            return;
+        }
+        direct.frames.push_back (frame);
+    }
+
+    while (direct.pending.size() < m_receiveQueueDepth)
+    {
+        const auto frameIndex = direct.preparedSlots / direct.payloadsPerFrame;
+        if (frameIndex == direct.frames.size())
+        {
+            // Payloads are already queued, so don't wait for the IBufferCaptureListener
+            auto frame = tryDequeueInternalBuffer();
+            if (!frame)
+            {
+                return;
+            }
+            direct.frames.push_back (frame);
+        }
+
+        const auto stride = direct.preparedSlots % direct.payloadsPerFrame;
+        const auto first = direct.frames[frameIndex]->getUnderlyingBuffer() + stride * AMUNDSEN_STRIDE_SIZE;
+        if (prepareToReceivePayload (first) != PrepareStatus::SUCCESS)
+        {
+            return;
+        }
+        direct.pending.push_back (first);
+        direct.preparedSlots++;
+    }
+}
+
+bool BridgeAmundsenCommon::receiveDirectPayload (DirectReceive &direct, bool &currentFrameIdentifier)
+{
+    const auto payload = direct.pending.front();
+    direct.pending.pop_front();
+
+    const auto receivedSize = receivePayload (payload, m_runAcquisition);
+    if (receivedSize == 0)
+    {
+        // The following payloads have been queued for the slots after this one
+        LOG (WARN) << "receivePayload() returned zero, probably timed out";
+        return false;
+    }
+    if (receivedSize < AMUNDSEN_UVC_HEADER_SIZE || receivedSize > direct.payloadSize)
+    {
+        LOG (WARN) << "receivePayload() returned a payload of " << receivedSize << " bytes, which doesn't fit the frame layout";
+        return false;
+    }
+    getDataOffset (payload);
+
+    auto frame = direct.frames.front();
+    const auto stride = direct.receivedSlots;
+    const auto slot = frame->getUnderlyingBuffer() + stride * AMUNDSEN_STRIDE_SIZE;
+    if (payload != slot)
+    {
+        // This was queued before switching to the direct receive mode
+        std::copy (payload, payload + receivedSize, slot);
+    }
+
+    const bool lastPayloadOfFrame = (stride + 1 == direct.payloadsPerFrame);
+    if (stride == 0)
+    {
+        direct.frameIdentifier = getFrameIdentifier (slot);
+    }
+    else if (direct.frameIdentifier != getFrameIdentifier (slot))
+    {
+        LOG (WARN) << "FrameIdentifier changed without receiving an end-of-frame";
+        return false;
+    }
+    if (isEndOfFrame (slot) != lastPayloadOfFrame)
+    {
+        LOG (WARN) << "End-of-frame in payload " << stride << ", expected it in payload " << direct.payloadsPerFrame - 1;
+        return false;
+    }
+    if (!lastPayloadOfFrame && receivedSize != direct.payloadSize)
+    {
+        LOG (WARN) << "Odd-sized payload, and not end of frame";
+        return false;
+    }
+
+    direct.receivedSlots++;
+    if (!lastPayloadOfFrame)
+    {
+        return true;
+    }
+
+    const auto elementSize = direct.payloadSize - AMUNDSEN_UVC_HEADER_SIZE;
+    const auto rawDataSize = elementSize * stride + (receivedSize - AMUNDSEN_UVC_HEADER_SIZE);
+    if (rawDataSize > BufferUtils::expectedRawSize (frame->getPixelCount(), m_transferFormat))
+    {
+        LOG (ERROR) << "Received more data than can fit in to the frame";
+        return false;
+    }
+
+    // The payloads are converted in place, inPlacePixelOffset was checked before switching to
+    // the direct receive mode.
+    BufferUtils::copyAndNormalizeStrides (*frame,
+                                          frame->getUnderlyingBuffer() + AMUNDSEN_UVC_HEADER_SIZE,
+                                          slot + receivedSize,
+                                          elementSize, AMUNDSEN_STRIDE_SIZE,
+                                          m_transferFormat);
+    direct.frames.pop_front();
+    direct.preparedSlots -= direct.payloadsPerFrame;
+    direct.receivedSlots = 0;
+    currentFrameIdentifier = !direct.frameIdentifier;
+    bufferCallback (frame); // may throw
+    return true;
+}
+
+void BridgeAmundsenCommon::stopDirectReceive (DirectReceive &direct)
+{
+    cancelPendingPayloads();
+    for (auto frame : direct.frames)
+    {
+        // don't use the IBufferCaptureListener, these frames are incomplete
+        queueBuffer (frame);
+    }
+    direct = DirectReceive {};
 }
 
 void BridgeAmundsenCommon::acquisitionFunction()
 {
     // With UVC, the data for a frame is split in to a series of payloads, each about 16k, with each
-    // payload having a header. So we receive these payloads and then copy the data in to the buffer
-    // for the complete frame.
+    // payload having a header. To start with, we receive these payloads in to a circular buffer and
+    // then copy the data in to the buffer for the complete frame.
+    //
+    // The first complete frame shows the layout of the frames (the size and number of payloads).
+    // With that known, the direct receive mode reads each payload straight in to the frame buffer,
+    // and the data is converted in place without another copy.  If a payload doesn't fit the
+    // layout, the direct receive mode is stopped, and the next complete frame received via the
+    // circular buffer starts it again.
     if (!m_receiveBufferStrides)
     {
         LOG (ERROR) << "Trying to receive data without knowing the image size, acquisitionFunction quitting";
@@ -278,9 +504,25 @@ void BridgeAmundsenCommon::acquisitionFunction()
     // allows it to be set only when startOfFrame == nullptr (so the first payload of each frame).
     std::size_t firstPayloadSize = 0;
 
-    // The next data capture goes in to this buffer
+    // The next data capture goes in to this buffer, unless the direct receive mode is active
     OffsetBasedCapturedBuffer *frame = nullptr;
 
+    DirectReceive direct;
+
+    const auto handleNoFreeBuffer = [this]
+    {
+        // We're probably stopping after stopCapture has been called.  If it hasn't, the
+        // IBufferCaptureListener is holding all of the buffers.  The dequeue was already waiting
+        // for BUFFER_WAIT_TIMEOUT and is woken by queueBuffer, so just try again.
+        if (m_runAcquisition)
+        {
+            reportStarvation (m_eventForwarder);
+        }
+        // In the device, data starts being discarded if we're not reading it.  There will be a
+        // dropped frame when we start reading again, but that is handled by the existing error
+        // handling for dropped frames.
+    };
+
     // If the acquisition thread catches an unexpected exception (possibly a Disconnect) then the
     // thread should stop.  But leave m_runAcquisition as true so that the thread cleanup and join()
     // is still done.
@@ -290,24 +532,35 @@ void BridgeAmundsenCommon::acquisitionFunction()
     {
         try
         {
+            if (direct.active)
+            {
+                prepareDirectPayloads (direct);
+                if (direct.frames.empty())
+                {
+                    // Payloads queued via the circular buffer stay queued until there's a frame
+                    handleNoFreeBuffer();
+                    continue;
+                }
+                if (direct.pending.empty())
+                {
+                    throw RuntimeError ("Can't queue any USB receive buffers");
+                }
+
+                if (!receiveDirectPayload (direct, currentFrameIdentifier))
+                {
+                    stopDirectReceive (direct);
+                    receiveBuffer.clearStartOfFrame();
+                }
+                continue;
+            }
+
             if (!frame)
             {
-                frame = dequeueInternalBuffer();
+                frame = dequeueInternalBuffer (BUFFER_WAIT_TIMEOUT);
                 if (!frame)
                 {
-                    // We're probably stopping after stopCapture has been called.  If it hasn't,
-                    // have a short delay so that this doesn't become a busy loop.
-                    if (m_runAcquisition)
-                    {
-                        LOG (ERROR) << "No free buffers from BridgeInternalBufferAlloc";
-                        m_eventForwarder.event<royale::event::EventCaptureStream> (royale::EventSeverity::ROYALE_WARNING, "No free buffers from BridgeInternalBufferAlloc");
-                        std::chrono::microseconds usec (100000);
-                        std::this_thread::sleep_for (usec);
-                    }
+                    handleNoFreeBuffer();
                     continue;
-                    // In the device, data starts being discarded if we're not reading it.  There
-                    // will be a dropped frame when we start reading again, but that is handled by the
-                    // existing error handling for dropped frames.
                 }
                 receiveBuffer.clearStartOfFrame();
             }
@@ -479,10 +732,36 @@ void BridgeAmundsenCommon::acquisitionFunction()
                                                           firstPayloadSize - AMUNDSEN_UVC_HEADER_SIZE, AMUNDSEN_STRIDE_SIZE,
                                                           m_transferFormat);
                 }
+                // The layout of a complete frame is used for the direct receive mode
+                const auto payloadsPerFrame = receiveBuffer.countUsedStridesExcludingCurrentBuffer() + 1;
+                const auto elementSize = firstPayloadSize - AMUNDSEN_UVC_HEADER_SIZE;
+                const auto canReceiveDirect =
+                    rawDataSize == BufferUtils::expectedRawSize (frame->getPixelCount(), m_transferFormat) &&
+                    payloadsPerFrame <= m_receiveBufferStrides &&
+                    (payloadsPerFrame == 1 || elementSize % (m_transferFormat == BufferDataFormat::RAW12 ? 3 : 2) == 0) &&
+                    inPlacePixelOffset (elementSize, payloadsPerFrame, m_transferFormat) <= m_pixelOffset;
+
                 receiveBuffer.clearStartOfFrame();
                 currentFrameIdentifier = !currentFrameIdentifier;
-                bufferCallback (frame); // may throw
+                auto completeFrame = frame;
                 frame = nullptr;
+
+                if (canReceiveDirect)
+                {
+                    // The payloads that are already queued in the circular buffer are the first
+                    // slots, and are copied to the frame buffer when they are received.
+                    direct.active = true;
+                    direct.payloadSize = firstPayloadSize;
+                    direct.payloadsPerFrame = payloadsPerFrame;
+                    while (receiveBuffer.hasPrepared())
+                    {
+                        direct.pending.push_back (receiveBuffer.firstPrepared());
+                        receiveBuffer.setUsed();
+                    }
+                    direct.preparedSlots = direct.pending.size();
+                }
+
+                bufferCallback (completeFrame); // may throw
             }
         }
         catch (const Disconnected &)
@@ -494,8 +773,15 @@ void BridgeAmundsenCommon::acquisitionFunction()
         }
         catch (const CurrentFrameIsCorrupt &)
         {
+            if (direct.active)
+            {
+                stopDirectReceive (direct);
+            }
 #if defined (ROYALE_LOGGING_VERBOSE_BRIDGE)
-            LOG (WARN) << "Discarding corrupt frame, which had " << receiveBuffer.countUsedStridesExcludingCurrentBuffer() << " strides before the current payload";
+            else
+            {
+                LOG (WARN) << "Discarding corrupt frame, which had " << receiveBuffer.countUsedStridesExcludingCurrentBuffer() << " strides before the current payload";
+            }
 #endif
             receiveBuffer.clearStartOfFrame();
         }
@@ -509,9 +795,13 @@ void BridgeAmundsenCommon::acquisitionFunction()
 
     cancelPendingPayloads();
 
+    // don't use the IBufferCaptureListener, its thread may have already finished
+    for (auto directFrame : direct.frames)
+    {
+        queueBuffer (directFrame);
+    }
     if (frame)
     {
-        // don't use the IBufferCaptureListener, its thread may have already finished
         queueBuffer (frame);
     }
 }
@@ -107,9 +107,11 @@ namespace
     /**
      * Maximum number of async I/O operations to have pending simultaneously.
      *
-     * This constant is arbitrary.
+     * BridgeAmundsenCommon chooses how many it uses from the frame size and USB speed, this is
+     * only an upper limit for large frames on SuperSpeed connections.  No memory is allocated for
+     * the data, the transfers are read in to BridgeAmundsenCommon's buffers.
      */
-    const std::size_t NUMBER_OF_ASYNC_OPS = 30;
+    const std::size_t NUMBER_OF_ASYNC_OPS = 64;
 }
 
 namespace
@@ -364,17 +364,15 @@ void BridgeEnclustra::acquisitionFunction()
         {
             if (!frame)
             {
-                frame = dequeueInternalBuffer();
+                frame = dequeueInternalBuffer (BUFFER_WAIT_TIMEOUT);
                 if (!frame)
                 {
                     // We're probably stopping after stopCapture has been called.  If it hasn't,
-                    // have a short delay so that this doesn't become a busy loop.
+                    // the dequeue has already waited, and is woken by queueBuffer, so just try
+                    // again.
                     if (m_runAcquisition)
                     {
-                        LOG (ERROR) << "No free buffers from BridgeInternalBufferAlloc";
-                        m_eventForwarder.event<royale::event::EventCaptureStream> (royale::EventSeverity::ROYALE_WARNING, "No free buffers from BridgeInternalBufferAlloc");
-                        std::chrono::microseconds usec (100000);
-                        std::this_thread::sleep_for (usec);
+                        reportStarvation (m_eventForwarder);
                     }
                     continue;
                     // In the Enclustra, data starts being discarded if we're not reading it.  There
@@ -631,3 +629,8 @@ void BridgeEnclustra::sleepFor (std::chrono::microseconds sleepDuration)
 {
     std::this_thread::sleep_for (sleepDuration);
 }
+
+royale::hal::BridgeImagerTransactionCost BridgeEnclustra::getTransactionCost() const
+{
+    return royale::hal::BridgeImagerTransactionCost::usbControl();
+}
@@ -115,3 +115,8 @@ void BridgeImagerArctic::sleepFor (std::chrono::microseconds sleepDuration)
 {
     std::this_thread::sleep_for (sleepDuration);
 }
+
+royale::hal::BridgeImagerTransactionCost BridgeImagerArctic::getTransactionCost() const
+{
+    return royale::hal::BridgeImagerTransactionCost::usbControl();
+}
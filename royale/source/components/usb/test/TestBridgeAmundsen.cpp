@@ -9,6 +9,7 @@
 \****************************************************************************/
 
 #include <usb/bridge/BridgeAmundsenCommon.hpp>
+#include <buffer/OffsetBasedCapturedBuffer.hpp>
 
 #include <common/IteratorBoundsCheck.hpp>
 #include <common/exceptions/LogicError.hpp>
@@ -23,6 +24,7 @@
 #include <deque>
 #include <limits>
 #include <memory>
+#include <set>
 #include <thread>
 #include <vector>
 
@@ -173,6 +175,10 @@ namespace
             }
 
             m_preparedBuffers.push_back (first);
+            {
+                std::lock_guard<std::mutex> lock (m_mutex);
+                m_preparedAddresses.insert (first);
+            }
             return PrepareStatus::SUCCESS;
         }
 
@@ -263,6 +269,17 @@ namespace
             }
         }
 
+        /**
+         * True if any of the areas passed to prepareToReceivePayload was in the range first to
+         * last.
+         */
+        bool wasPreparedIn (const uint8_t *first, const uint8_t *last)
+        {
+            std::lock_guard<std::mutex> lock (m_mutex);
+            const auto found = m_preparedAddresses.lower_bound (const_cast<uint8_t *> (first));
+            return found != m_preparedAddresses.end() && *found < last;
+        }
+
     private:
         /** Synchronization between receivePayload and setPayloads */
         std::mutex m_mutex;
@@ -278,6 +295,8 @@ namespace
          * all elements to check that an address hasn't been added twice.
          */
         std::deque<uint8_t *> m_preparedBuffers;
+        /** All areas that have been prepared, accessed with m_mutex held */
+        std::set<uint8_t *> m_preparedAddresses;
         /**
          * The size of m_preparedBuffers at which prepareToReceivePayload returns
          * ALL_BUFFERS_ALREADY_PREPARED
@@ -297,6 +316,16 @@ namespace
         {
             auto vec = std::vector<uint16_t> (buffer->getPixelData(), buffer->getPixelData() + buffer->getPixelCount());
             checkBuffer (vec);
+
+            {
+                std::lock_guard<std::mutex> lock (m_mutex);
+                auto offsetBuffer = dynamic_cast<OffsetBasedCapturedBuffer *> (buffer);
+                if (offsetBuffer)
+                {
+                    m_underlyingBuffers.insert (offsetBuffer->getUnderlyingBuffer());
+                    m_underlyingBufferSize = offsetBuffer->getUnderlyingBufferSize();
+                }
+            }
             m_releaser->queueBuffer (buffer);
 
             {
@@ -328,9 +357,24 @@ namespace
             return m_counterCallbacks;
         }
 
+        /**
+         * True if pred returns true for the (first, last) range of any buffer's underlying buffer.
+         */
+        template <typename Predicate>
+        bool anyUnderlyingBuffer (Predicate pred)
+        {
+            std::lock_guard<std::mutex> lock {m_mutex};
+            return std::any_of (m_underlyingBuffers.cbegin(), m_underlyingBuffers.cend(), [&] (uint8_t *first)
+            {
+                return pred (first, first + m_underlyingBufferSize);
+            });
+        }
+
     private:
         std::shared_ptr<IBufferCaptureReleaser> m_releaser;
         unsigned int m_counterCallbacks = 0u;
+        std::set<uint8_t *> m_underlyingBuffers;
+        std::size_t m_underlyingBufferSize = 0u;
         std::mutex m_mutex;
         std::condition_variable m_cv;
     };
@@ -629,3 +673,87 @@ TEST_F (TestBridgeAmundsen, AutoDetectRaw16)
     m_listener->getCounterCallbacks (2, std::chrono::hours (10));
     ASSERT_NO_THROW (m_bridge->setBufferCaptureListener (nullptr));
 }
+
+/**
+ * After the first complete frame, the payloads are received directly in to the frame buffers and
+ * converted there.  The frames must be the same as when they were copied from the circular buffer.
+ */
+TEST_F (TestBridgeAmundsen, DirectReceiveRaw12)
+{
+    using namespace ::testing;
+    const auto &testData = monstarImage;
+    const auto &rawData = testData.raw12;
+    const auto &testPixels = testData.pixels;
+
+    m_bridge->setPayloads ({rawData, rawData}, 0x2fcdu);
+
+    EXPECT_CALL (*m_listener, checkBuffer (Eq (testPixels)))
+    .Times (AtLeast (1))
+    .WillRepeatedly (Return());
+
+    ASSERT_NO_THROW (m_bridge->executeUseCase (static_cast<int> (testPixels.size()), 1, 4));
+    ASSERT_NO_THROW (m_bridge->startCapture());
+    ASSERT_GE (m_listener->getCounterCallbacks (8, std::chrono::seconds (5)), 8u);
+    ASSERT_NO_THROW (m_bridge->stopCapture());
+
+    auto bridge = m_bridge;
+    EXPECT_TRUE (m_listener->anyUnderlyingBuffer ([bridge] (const uint8_t *first, const uint8_t *last)
+    {
+        return bridge->wasPreparedIn (first, last);
+    }));
+}
+
+/**
+ * The DirectReceiveRaw12 test with RAW16 data, which needs a larger pixel offset to be converted
+ * in place.
+ */
+TEST_F (TestBridgeAmundsen, DirectReceiveRaw16)
+{
+    using namespace ::testing;
+    const auto &testData = monstarImage;
+    const auto &rawData = testData.raw16;
+    const auto &testPixels = testData.pixels;
+
+    m_bridge->setTransferFormat (royale::buffer::BufferDataFormat::RAW16);
+    m_bridge->setPayloads ({rawData, rawData}, 0x2c10u);
+
+    EXPECT_CALL (*m_listener, checkBuffer (Eq (testPixels)))
+    .Times (AtLeast (1))
+    .WillRepeatedly (Return());
+
+    ASSERT_NO_THROW (m_bridge->executeUseCase (static_cast<int> (testPixels.size()), 1, 4));
+    ASSERT_NO_THROW (m_bridge->startCapture());
+    ASSERT_GE (m_listener->getCounterCallbacks (8, std::chrono::seconds (5)), 8u);
+    ASSERT_NO_THROW (m_bridge->stopCapture());
+
+    auto bridge = m_bridge;
+    EXPECT_TRUE (m_listener->anyUnderlyingBuffer ([bridge] (const uint8_t *first, const uint8_t *last)
+    {
+        return bridge->wasPreparedIn (first, last);
+    }));
+}
+
+/**
+ * A frame that ends early doesn't fit the layout of the frames, the direct receive mode must drop
+ * it and start again from the following frames.
+ */
+TEST_F (TestBridgeAmundsen, DirectReceiveShortFrame)
+{
+    using namespace ::testing;
+    const auto &testData = monstarImage;
+    const auto &rawData = testData.raw12;
+    const auto &testPixels = testData.pixels;
+    const auto shortFrame = std::vector<uint8_t> (rawData.size() / 2, 0u);
+
+    m_bridge->setPayloads ({rawData, rawData, shortFrame, rawData, rawData, rawData}, 0x2fcdu);
+
+    // The short frame must not reach the listener
+    EXPECT_CALL (*m_listener, checkBuffer (Eq (testPixels)))
+    .Times (AtLeast (1))
+    .WillRepeatedly (Return());
+
+    ASSERT_NO_THROW (m_bridge->executeUseCase (static_cast<int> (testPixels.size()), 1, 4));
+    ASSERT_NO_THROW (m_bridge->startCapture());
+    ASSERT_GE (m_listener->getCounterCallbacks (12, std::chrono::seconds (5)), 12u);
+    ASSERT_NO_THROW (m_bridge->setBufferCaptureListener (nullptr));
+}
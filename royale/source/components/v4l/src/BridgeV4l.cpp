@@ -25,6 +25,7 @@
 #include <common/MakeUnique.hpp>
 #include <common/NarrowCast.hpp>
 #include <common/RoyaleLogger.hpp>
+#include <common/RoyaleTrace.hpp>
 
 #include <algorithm>
 #include <array>
@@ -391,6 +392,7 @@ void BridgeV4l::acquisitionFunction()
     // thread should stop.  But leave m_runAcquisition as true so that the thread cleanup and join()
     // is still done.
     bool keepRunning = true;
+    ROYALE_TRACE_THREAD_NAME ("BridgeV4l acquisition");
 
     while (m_runAcquisition && keepRunning)
     {
@@ -459,6 +461,7 @@ void BridgeV4l::acquisitionFunction()
         LOG (DEBUG) << "Captured a frame in V4L buffer " << ioctlBuffer.index;
 #endif
         auto *buffer = static_cast<CapturedV4lBuffer *> (m_currentBuffers[ioctlBuffer.index].get());
+        ROYALE_TRACE_ZONE ("BridgeV4l::acquire");
 
         // Does the data need normalisation?
         if (m_transferFormat == BufferDataFormat::UNKNOWN)
@@ -479,6 +482,7 @@ void BridgeV4l::acquisitionFunction()
         }
         else
         {
+            ROYALE_TRACE_ZONE ("BridgeV4l::normalizeData");
             buffer->normalizeData ();
         }
 
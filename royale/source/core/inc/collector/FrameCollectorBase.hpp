@@ -292,10 +292,15 @@ namespace royale
             void clearPendingExposureTimes();
 
             /**
-            * Checks the eye safety monitor status (if it's available)
+            * Checks the eye safety monitor status (from PseudoDataFields::eyeError)
             * and generates an event if the monitor was triggered.
             */
-            void updateEyeSafetyErrorAndState (const royale::common::ICapturedRawFrame &frame);
+            void updateEyeSafetyErrorAndState (uint32_t eyeError);
+
+            /**
+            * The frame's cached PseudoDataFields, or decodes them if the frame doesn't have them.
+            */
+            royale::common::PseudoDataFields getFields (const royale::common::ICapturedRawFrame &frame) const;
 
         private:
             /**
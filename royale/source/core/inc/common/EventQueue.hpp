@@ -12,10 +12,11 @@
 
 #include <royale/Definitions.hpp>
 #include <royale/IEventListener.hpp>
-#include <deque>
+#include <cstddef>
 #include <mutex>
 #include <condition_variable>
 #include <thread>
+#include <vector>
 
 namespace royale
 {
@@ -24,10 +25,21 @@ namespace royale
     *
     * Threadsafe, but not reentrant. In particular, this means event listener code
     * is not supposed to call setEventListener() or cause the destructor to run.
+    *
+    * Events which implement ICoalescableEvent are merged with the previous event if that hasn't
+    * been delivered yet, so that a burst of frame drops doesn't queue an event for each frame.
+    * The queue is bounded, when MAX_QUEUED_EVENTS are waiting further events are discarded
+    * unless they are errors.  The order of the delivered events is the order of onEvent().
     */
     class EventQueue : public royale::IEventListener
     {
     public:
+        /**
+        * Number of events that can wait for delivery, the space for these is allocated in the
+        * constructor.
+        */
+        static const std::size_t MAX_QUEUED_EVENTS = 64u;
+
         ROYALE_API EventQueue();
         ROYALE_API ~EventQueue();
         // No copies allowed.
@@ -48,14 +60,16 @@ namespace royale
 
     private:
         // data
-        std::deque<std::unique_ptr<royale::IEvent>> m_queue;
-        bool                                        m_callbackActive;
-        std::mutex                                  m_queueMutex;
-        std::condition_variable                     m_queueCond;    // signals queue change (with m_queueMutex)
-        std::condition_variable                     m_callbackCond; // signals callback activity change (with m_queueMutex)
-        std::unique_ptr<std::thread>                m_eventNotifier;
-        std::mutex                                  m_listenerMutex;
-        royale::IEventListener                     *m_listener;
+        std::vector<std::unique_ptr<royale::IEvent>> m_queue;
+        std::vector<std::unique_ptr<royale::IEvent>> m_delivering;   // events taken by eventNotifier, only used by that thread
+        std::size_t                                  m_discardedEvents; // events discarded because the queue was full
+        bool                                         m_callbackActive;
+        std::mutex                                   m_queueMutex;
+        std::condition_variable                      m_queueCond;    // signals queue change (with m_queueMutex)
+        std::condition_variable                      m_callbackCond; // signals callback activity change (with m_queueMutex)
+        std::unique_ptr<std::thread>                 m_eventNotifier;
+        std::mutex                                   m_listenerMutex;
+        royale::IEventListener                      *m_listener;
 
     }; // class EventQueue
 }
@@ -0,0 +1,75 @@
+/****************************************************************************\
+* Copyright (C) 2019 pmdtechnologies ag
+*
+* THIS CODE AND INFORMATION ARE PROVIDED "AS IS" WITHOUT WARRANTY OF ANY
+* KIND, EITHER EXPRESSED OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE
+* IMPLIED WARRANTIES OF MERCHANTABILITY AND/OR FITNESS FOR A
+* PARTICULAR PURPOSE.
+*
+\****************************************************************************/
+
+#pragma once
+
+#include <algorithm>
+#include <chrono>
+
+namespace royale
+{
+    namespace common
+    {
+        /**
+        * Calculates the delays between attempts when polling for a condition.  The first delay is
+        * `initial`, each following one is twice the previous one up to `maximum`.  Once the delays
+        * add up to `timeout` there are no more attempts; the last delay is shortened so that the
+        * total is exactly `timeout`.
+        *
+        * This only does the arithmetic, the caller does the sleeping (so that a bridge's sleepFor or
+        * a simulated clock can be used).
+        */
+        class ExponentialBackoff
+        {
+        public:
+            ExponentialBackoff (std::chrono::microseconds initial,
+                                std::chrono::microseconds maximum,
+                                std::chrono::microseconds timeout) :
+                m_next (std::max (initial, std::chrono::microseconds (1))),
+                m_maximum (std::max (maximum, m_next)),
+                m_timeout (timeout),
+                m_elapsed (std::chrono::microseconds::zero())
+            {
+            }
+
+            /**
+            * Returns the time to wait before the next attempt in delay.
+            *
+            * \return false if the timeout has been reached, in which case delay is unchanged
+            */
+            bool next (std::chrono::microseconds &delay)
+            {
+                if (m_elapsed >= m_timeout)
+                {
+                    return false;
+                }
+
+                delay = std::min (m_next, m_timeout - m_elapsed);
+                m_elapsed += delay;
+                m_next = std::min (m_next * 2, m_maximum);
+                return true;
+            }
+
+            /**
+            * The sum of all delays returned so far.
+            */
+            std::chrono::microseconds elapsed() const
+            {
+                return m_elapsed;
+            }
+
+        private:
+            std::chrono::microseconds m_next;
+            const std::chrono::microseconds m_maximum;
+            const std::chrono::microseconds m_timeout;
+            std::chrono::microseconds m_elapsed;
+        };
+    }
+}
@@ -16,6 +16,8 @@ namespace royale
 {
     namespace common
     {
+        struct PseudoDataFields;
+
         /**
          * This contains the data from one Raw Frame of the imager.
          *
@@ -46,6 +48,18 @@ namespace royale
              * The pointer is valid until CaptureReleaser::releaseCapturedFrames() is called.
              */
             virtual const uint16_t *getPseudoData() const = 0;
+
+            /**
+             * Returns the PseudoDataFields of this frame if they have already been decoded (the
+             * FrameCollector decodes them once when the frame is received), otherwise nullptr.
+             * Callers fall back to IPseudoDataInterpreter::decodeFields().
+             *
+             * The pointer is valid until CaptureReleaser::releaseCapturedFrames() is called.
+             */
+            virtual const PseudoDataFields *getPseudoDataFields() const
+            {
+                return nullptr;
+            }
         };
     }
 }
@@ -19,6 +19,18 @@ namespace royale
 {
     namespace common
     {
+        /**
+         * The values that IPseudoDataInterpreter::decodeFields() reads from the pseudo data, these
+         * are the ones that the FrameCollector needs for every raw frame.
+         */
+        struct PseudoDataFields
+        {
+            uint16_t frameNumber;   //!< as returned by getFrameNumber()
+            uint16_t reconfigIndex; //!< as returned by getReconfigIndex()
+            uint16_t sequenceIndex; //!< as returned by getSequenceIndex()
+            uint32_t eyeError;      //!< as returned by getEyeSafetyError()
+        };
+
         /**
          * An instance of this class translates the opaque array returned from
          * CapturedRawFrame::getPseudoData.
@@ -164,6 +176,24 @@ namespace royale
              * the modulation frequency.
              */
             virtual uint32_t getExposureTime (const common::ICapturedRawFrame &frame, uint32_t modulationFrequency) const = 0;
+
+            /**
+             * Reads all of the PseudoDataFields of a frame, with the same results as calling each
+             * of the corresponding methods.
+             *
+             * This implementation calls those methods, the interpreters override it to read the
+             * pseudo data in one pass.
+             *
+             * \param   frame   Contains the data from one raw frame of the imager.
+             * \param   fields  Receives the values.
+             */
+            virtual void decodeFields (const common::ICapturedRawFrame &frame, PseudoDataFields &fields) const
+            {
+                fields.frameNumber = getFrameNumber (frame);
+                fields.reconfigIndex = getReconfigIndex (frame);
+                fields.sequenceIndex = getSequenceIndex (frame);
+                getEyeSafetyError (frame, fields.eyeError);
+            }
         };
     }
 }
@@ -0,0 +1,176 @@
+/****************************************************************************\
+ * Copyright (C) 2019 pmdtechnologies ag
+ *
+ * THIS CODE AND INFORMATION ARE PROVIDED "AS IS" WITHOUT WARRANTY OF ANY
+ * KIND, EITHER EXPRESSED OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND/OR FITNESS FOR A
+ * PARTICULAR PURPOSE.
+ *
+ \****************************************************************************/
+
+#pragma once
+
+#include <royale/Definitions.hpp>
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <ostream>
+#include <string>
+#include <vector>
+
+// Insert into code to trace the time until the end of the enclosing scope.  The name must be a
+// string literal (only the pointer is stored).  Nested zones on the same thread are shown as a
+// hierarchy by the trace viewer.
+//
+// ROYALE_TRACE_THREAD_NAME names the calling thread in the exported trace.
+//
+// Both are statements which need a trailing semicolon, and compile to nothing unless
+// ROYALE_ENABLE_TRACING is set.
+#ifdef ROYALE_ENABLE_TRACING
+#define ROYALE_TRACE_CONCAT_INNER(a, b) a##b
+#define ROYALE_TRACE_CONCAT(a, b) ROYALE_TRACE_CONCAT_INNER(a, b)
+#define ROYALE_TRACE_ZONE(name) royale::common::TraceZone ROYALE_TRACE_CONCAT(_royaleTraceZone, __LINE__) (name)
+#define ROYALE_TRACE_THREAD_NAME(name) royale::common::Tracer::setThreadName (name)
+#else
+#define ROYALE_TRACE_ZONE(name) static_cast<void> (0)
+#define ROYALE_TRACE_THREAD_NAME(name) static_cast<void> (0)
+#endif
+
+namespace royale
+{
+    namespace common
+    {
+        /**
+        * One recorded zone, as returned by Tracer::getZones().
+        */
+        struct TraceZoneRecord
+        {
+            const char *name;
+            uint32_t threadId;
+            int64_t startNs;
+            int64_t endNs;
+        };
+
+        /**
+        * Collects timed zones from all threads and exports them in the Chrome trace event format
+        * (which can be opened in chrome://tracing or https://ui.perfetto.dev).
+        *
+        * Each thread writes to its own fixed-size ring buffer without taking a lock, when the
+        * buffer is full the oldest events are overwritten.  Only registering a new thread and a
+        * thread's exit take a lock.  Recording is off until setEnabled (true) is called; a
+        * disabled zone costs one atomic load.
+        *
+        * When a thread exits, its buffer is freed if it's empty.  Otherwise it's kept so that the
+        * trace still contains the thread's events, until clear() is called or the buffer is
+        * needed for a new thread.  At most MAX_THREAD_BUFFERS buffers exist; if all of them
+        * belong to running threads, further threads are not recorded.
+        *
+        * If Royale is built with ROYALE_ENABLE_TRACING and the environment variable
+        * ROYALE_TRACE_FILE is set, tracing is enabled at startup and the trace is written to that
+        * file when the library is unloaded.
+        */
+        class Tracer
+        {
+        public:
+            /**
+            * Number of events kept per thread.
+            */
+            static const std::size_t EVENTS_PER_THREAD = 1u << 16;
+
+            /**
+            * Maximum number of ring buffers, including those of threads that have exited.
+            */
+            static const std::size_t MAX_THREAD_BUFFERS = 32u;
+
+            static ROYALE_API void setEnabled (bool enabled);
+
+            static bool isEnabled()
+            {
+                return m_enabled.load (std::memory_order_relaxed);
+            }
+
+            /**
+            * Names the calling thread.  The name must be a string literal.  This doesn't allocate
+            * the thread's buffer, a thread which doesn't record any zones isn't in the trace.
+            */
+            static ROYALE_API void setThreadName (const char *name);
+
+            /**
+            * Records a zone for the calling thread, the times are from now().
+            */
+            static ROYALE_API void addZone (const char *name, int64_t startNs, int64_t endNs);
+
+            /**
+            * Monotonic time in nanoseconds.
+            */
+            static int64_t now()
+            {
+                return std::chrono::duration_cast<std::chrono::nanoseconds> (
+                           std::chrono::steady_clock::now().time_since_epoch()).count();
+            }
+
+            /**
+            * Drops all recorded events, and frees the buffers of threads which have exited.  Must
+            * not be called while zones are being recorded.
+            */
+            static ROYALE_API void clear();
+
+            /**
+            * Returns the number of ring buffers that are currently allocated.
+            */
+            static ROYALE_API std::size_t getBufferCount();
+
+            /**
+            * Writes all recorded events as JSON.  If zones are still being recorded while this
+            * runs, the oldest events of a thread may be overwritten while they are written, so
+            * tracing should normally be disabled first.
+            */
+            static ROYALE_API void writeChromeTrace (std::ostream &os);
+
+            /**
+            * \return false if the file couldn't be written
+            */
+            static ROYALE_API bool writeChromeTrace (const std::string &filename);
+
+            /**
+            * Returns all recorded events, for tools which evaluate the zones themselves.  The
+            * events of each thread are in the order in which the zones ended.  The same caveat as
+            * for writeChromeTrace applies.
+            */
+            static ROYALE_API std::vector<TraceZoneRecord> getZones();
+
+        private:
+            static std::atomic<bool> m_enabled;
+        };
+
+        /**
+        * Records the time from construction to destruction, use ROYALE_TRACE_ZONE instead of
+        * using this directly.
+        */
+        class TraceZone
+        {
+        public:
+            explicit TraceZone (const char *name) :
+                m_name (Tracer::isEnabled() ? name : nullptr),
+                m_start (m_name ? Tracer::now() : 0)
+            {
+            }
+
+            ~TraceZone()
+            {
+                if (m_name)
+                {
+                    Tracer::addZone (m_name, m_start, Tracer::now());
+                }
+            }
+
+            TraceZone (const TraceZone &) = delete;
+            TraceZone &operator= (const TraceZone &) = delete;
+
+        private:
+            const char *const m_name;
+            const int64_t m_start;
+        };
+    }
+}
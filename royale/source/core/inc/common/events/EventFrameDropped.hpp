@@ -12,6 +12,7 @@
 
 #include <royale/Definitions.hpp>
 #include <royale/IEvent.hpp>
+#include <common/events/ICoalescableEvent.hpp>
 
 namespace royale
 {
@@ -20,8 +21,10 @@ namespace royale
 
         /**
         * Event that is fired for every frame drop
+        *
+        * Consecutive frame drops that haven't been delivered yet are reported as a single event.
         */
-        class EventFrameDropped : public royale::IEvent
+        class EventFrameDropped : public royale::IEvent, public ICoalescableEvent
         {
         public:
             ROYALE_API EventFrameDropped (unsigned nrOfFramesDropped = 1u);
@@ -30,6 +33,11 @@ namespace royale
             royale::EventSeverity severity() const override;
             const royale::String describe() const override;
             royale::EventType type() const override;
+
+            // implement ICoalescableEvent
+            bool coalesce (const royale::IEvent &next) override;
+
+            ROYALE_API unsigned getNrOfFramesDropped() const;
         private:
             unsigned m_nrOfFramesDropped;
         };
@@ -12,6 +12,7 @@
 
 #include <royale/Definitions.hpp>
 #include <royale/IEvent.hpp>
+#include <common/events/ICoalescableEvent.hpp>
 
 namespace royale
 {
@@ -20,8 +21,11 @@ namespace royale
 
         /**
         * Statistics for raw frames and frame drops.
+        *
+        * If the statistics of several periods are still waiting for delivery, they are reported
+        * as a single event with the sums of the counters.
         */
-        class EventRawFrameStats : public royale::IEvent
+        class EventRawFrameStats : public royale::IEvent, public ICoalescableEvent
         {
         public:
             ROYALE_API EventRawFrameStats (uint16_t totalFrames, uint16_t frameDropsBridge, uint16_t frameDropsCollector);
@@ -31,6 +35,9 @@ namespace royale
             const royale::String describe() const override;
             royale::EventType type() const override;
 
+            // implement ICoalescableEvent
+            bool coalesce (const royale::IEvent &next) override;
+
             // data
             uint16_t m_totalFrames;
             uint16_t m_frameDropsBridge;
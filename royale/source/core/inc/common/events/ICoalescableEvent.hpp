@@ -0,0 +1,41 @@
+/****************************************************************************\
+* Copyright (C) 2019 pmdtechnologies ag
+*
+* THIS CODE AND INFORMATION ARE PROVIDED "AS IS" WITHOUT WARRANTY OF ANY
+* KIND, EITHER EXPRESSED OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE
+* IMPLIED WARRANTIES OF MERCHANTABILITY AND/OR FITNESS FOR A
+* PARTICULAR PURPOSE.
+*
+\****************************************************************************/
+
+#pragma once
+
+#include <royale/IEvent.hpp>
+
+namespace royale
+{
+    namespace event
+    {
+        /**
+        * Interface for events that are generated repeatedly (for example for each dropped frame),
+        * where several consecutive events can be reported as one.
+        *
+        * If the EventQueue hasn't delivered an event of this kind yet when the next event arrives,
+        * it asks the queued event to take over the information of the next one.
+        */
+        class ICoalescableEvent
+        {
+        public:
+            virtual ~ICoalescableEvent() = default;
+
+            /**
+            * Merges the next event in to this one, if it is of the same kind.
+            *
+            * @param next the event that was generated after this one
+            * @return true if this event now also describes next, false if next has to be
+            * delivered separately
+            */
+            virtual bool coalesce (const royale::IEvent &next) = 0;
+        };
+    }
+}
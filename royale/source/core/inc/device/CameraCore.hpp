@@ -20,6 +20,7 @@
 #include <common/IFlowControlStrategy.hpp>
 #include <common/EventQueue.hpp>
 #include <device/RoiLensCenter.hpp>
+#include <device/TemperatureSampler.hpp>
 
 namespace royale
 {
@@ -272,6 +273,8 @@ namespace royale
             std::shared_ptr<royale::hal::INonVolatileStorage> m_storage;
             std::shared_ptr<royale::hal::IPsdTemperatureSensor> m_psdTemperatureSensor;
             std::shared_ptr<royale::hal::ITemperatureSensor> m_temperatureSensor;
+            /** Reads m_temperatureSensor while capturing, null if there's only a PSD sensor */
+            std::shared_ptr<royale::device::TemperatureSampler> m_temperatureSampler;
             std::shared_ptr<royale::hal::IBridgeDataReceiver> m_bridgeReceiver;
             std::shared_ptr<royale::hal::IImager> m_imager;
             std::unique_ptr<royale::collector::IFrameCollector> m_frameCollector;
@@ -0,0 +1,51 @@
+/****************************************************************************\
+* Copyright (C) 2019 pmdtechnologies ag
+*
+* THIS CODE AND INFORMATION ARE PROVIDED "AS IS" WITHOUT WARRANTY OF ANY
+* KIND, EITHER EXPRESSED OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE
+* IMPLIED WARRANTIES OF MERCHANTABILITY AND/OR FITNESS FOR A
+* PARTICULAR PURPOSE.
+*
+\****************************************************************************/
+
+#pragma once
+
+#include <hal/IPsdTemperatureSensor.hpp>
+
+#include <chrono>
+#include <memory>
+
+namespace royale
+{
+    namespace device
+    {
+        /**
+        * Decorator class which wraps an IPsdTemperatureSensor and only passes a set of frames to
+        * it once per period.  For the other frames the previous temperature is returned, without
+        * decoding the pseudo data.
+        *
+        * Anything wrapped by this sampler (for example a PsdTemperatureSensorFilter) sees one
+        * temperature per period instead of one per frame.
+        */
+        class PsdTemperatureSampler : public royale::hal::IPsdTemperatureSensor
+        {
+        public:
+            ROYALE_API PsdTemperatureSampler (std::shared_ptr<royale::hal::IPsdTemperatureSensor> sensor,
+                                              std::chrono::milliseconds period);
+
+            // implement IPsdTemperatureSensor
+            ROYALE_API float calcTemperature (const std::vector<common::ICapturedRawFrame *> &frames) override;
+
+        private:
+            std::shared_ptr<royale::hal::IPsdTemperatureSensor> m_baseSensor;
+            const std::chrono::milliseconds m_period;
+
+            bool m_hasTemperature;
+            float m_temperature;
+            std::chrono::steady_clock::time_point m_timestamp;
+
+        }; // class PsdTemperatureSampler
+
+    } // namespace device
+
+} // namespace royale
@@ -0,0 +1,96 @@
+/****************************************************************************\
+* Copyright (C) 2019 pmdtechnologies ag
+*
+* THIS CODE AND INFORMATION ARE PROVIDED "AS IS" WITHOUT WARRANTY OF ANY
+* KIND, EITHER EXPRESSED OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE
+* IMPLIED WARRANTIES OF MERCHANTABILITY AND/OR FITNESS FOR A
+* PARTICULAR PURPOSE.
+*
+\****************************************************************************/
+
+#pragma once
+
+#include <hal/ITemperatureSensor.hpp>
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <exception>
+#include <memory>
+#include <mutex>
+#include <thread>
+
+namespace royale
+{
+    namespace device
+    {
+        /**
+        * Decorator class which wraps an ITemperatureSensor and reads it on its own thread, so that
+        * the I/O of the sensor (for example an I2C transfer) isn't done on the thread that asks
+        * for the temperature.
+        *
+        * Between start() and stop() the wrapped sensor is read once per period, and
+        * getTemperature() only returns the most recent reading.  Outside of that, getTemperature()
+        * reads the wrapped sensor directly.
+        */
+        class TemperatureSampler : public royale::hal::ITemperatureSensor
+        {
+        public:
+            ROYALE_API TemperatureSampler (std::shared_ptr<royale::hal::ITemperatureSensor> sensor,
+                                           std::chrono::milliseconds period);
+            ROYALE_API ~TemperatureSampler() override;
+
+            /**
+            * Reads the sensor once on the calling thread, so that there is a reading before the
+            * first frame, and then starts the sampling thread.  Does nothing if it's already
+            * running.
+            */
+            ROYALE_API void start();
+
+            /**
+            * Stops the sampling thread, waiting for a read that is in progress.
+            */
+            ROYALE_API void stop();
+
+            /**
+            * Returns the most recent reading while the sampler is running.
+            *
+            * If the most recent attempt to read the wrapped sensor failed, this rethrows the
+            * exception that the wrapped sensor threw.
+            */
+            ROYALE_API float getTemperature() override;
+
+        private:
+            /**
+            * Reads the wrapped sensor and updates the cached reading.  The caller must hold
+            * m_sensorLock.
+            */
+            void sample();
+
+            void samplingFunction();
+
+            std::shared_ptr<royale::hal::ITemperatureSensor> m_baseSensor;
+            const std::chrono::milliseconds m_period;
+
+            /**
+            * Ensures that there's only one I/O request to the wrapped sensor at a time.
+            */
+            std::mutex m_sensorLock;
+
+            std::atomic<float> m_temperature;
+
+            /** The exception of the most recent read, or null if it succeeded */
+            std::exception_ptr m_error;
+            std::mutex m_errorLock;
+
+            /** Protects m_running, and the start and end of m_samplingThread */
+            std::mutex m_threadLock;
+            std::condition_variable m_stopCV;
+            std::atomic<bool> m_running;
+            std::thread m_samplingThread;
+
+        }; // class TemperatureSampler
+
+    } // namespace device
+
+} // namespace royale
@@ -0,0 +1,77 @@
+/****************************************************************************\
+ * Copyright (C) 2019 pmdtechnologies ag
+ *
+ * THIS CODE AND INFORMATION ARE PROVIDED "AS IS" WITHOUT WARRANTY OF ANY
+ * KIND, EITHER EXPRESSED OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND/OR FITNESS FOR A
+ * PARTICULAR PURPOSE.
+ *
+ \****************************************************************************/
+
+#pragma once
+
+#include <cstdint>
+
+namespace royale
+{
+    namespace hal
+    {
+        /**
+         * Relative cost of writing registers through an IBridgeImager.
+         *
+         * The units are arbitrary (only the ratio between the two values matters), the presets
+         * below use bytes on the wire.  A burst of n registers is assumed to cost
+         * perTransaction + n * perRegister.
+         */
+        struct BridgeImagerTransactionCost
+        {
+            uint32_t perTransaction; //!< fixed overhead of starting a new writeImagerBurst
+            uint32_t perRegister;    //!< cost of each register value in a burst
+
+            /**
+             * A directly attached I2C bus: start condition, device address and the two bytes of
+             * the register address, compared to two data bytes per register.
+             */
+            static BridgeImagerTransactionCost i2c()
+            {
+                return { 4u, 2u };
+            }
+
+            /**
+             * A bridge whose costs are not known.  With no overhead for starting a transaction,
+             * rewriting registers is never cheaper, so ImagerBase writes exactly the registers
+             * that changed.
+             */
+            static BridgeImagerTransactionCost unknown()
+            {
+                return { 0u, 1u };
+            }
+
+            /**
+             * An imager behind a USB bridge, where each burst is at least one USB control
+             * transfer (setup, data and status stages, and the bridge's own I2C transaction).
+             */
+            static BridgeImagerTransactionCost usbControl()
+            {
+                return { 64u, 2u };
+            }
+        };
+
+        /**
+         * Optional interface for an IBridgeImager, which tells the imager how expensive it is to
+         * start a new burst compared to extending an existing one.  ImagerBase uses this to decide
+         * whether two bursts separated by a short gap of registers with already-known values
+         * should be merged in to a single burst.
+         *
+         * Bridges that don't implement this interface are treated as BridgeImagerTransactionCost::unknown(),
+         * so their register writes are not changed.
+         */
+        class IBridgeImagerTransactionCost
+        {
+        public:
+            virtual ~IBridgeImagerTransactionCost() = default;
+
+            virtual BridgeImagerTransactionCost getTransactionCost() const = 0;
+        };
+    }
+}
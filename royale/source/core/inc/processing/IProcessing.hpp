@@ -29,12 +29,28 @@
 #include <royale/StreamId.hpp>
 #include <royale/ExposureMode.hpp>
 
+#include <cstdint>
 #include <vector>
 
 namespace royale
 {
     namespace processing
     {
+        /**
+        * Bit mask of the outputs that the processing has to produce for each frame.
+        */
+        enum OutputDemand : uint32_t
+        {
+            OUTPUT_NONE = 0u,
+            OUTPUT_DEPTH_DATA = 1u << 0,
+            OUTPUT_INTERMEDIATE_DATA = 1u << 1,
+            OUTPUT_RAW_DATA = 1u << 2,
+            OUTPUT_DEPTH_IMAGE = 1u << 3,
+            OUTPUT_SPARSE_POINT_CLOUD = 1u << 4,
+            OUTPUT_IR_IMAGE = 1u << 5,
+            OUTPUT_DEPTH_IR_IMAGE = 1u << 6
+        };
+
         struct DataListeners
         {
             DataListeners() :
@@ -56,6 +72,42 @@ namespace royale
                 extendedListener = nullptr;
             }
 
+            /**
+            * Returns the OutputDemand bits of the outputs these listeners receive.  If an
+            * extended listener is registered, it is the only listener that is called, so only the
+            * depth, intermediate and raw data are needed.
+            */
+            uint32_t outputDemand() const
+            {
+                if (extendedListener)
+                {
+                    return OUTPUT_DEPTH_DATA | OUTPUT_INTERMEDIATE_DATA | OUTPUT_RAW_DATA;
+                }
+
+                uint32_t demand = OUTPUT_NONE;
+                if (depthDataListener)
+                {
+                    demand |= OUTPUT_DEPTH_DATA;
+                }
+                if (depthImageListener)
+                {
+                    demand |= OUTPUT_DEPTH_IMAGE;
+                }
+                if (sparsePointCloudListener)
+                {
+                    demand |= OUTPUT_SPARSE_POINT_CLOUD;
+                }
+                if (irImageListener)
+                {
+                    demand |= OUTPUT_IR_IMAGE;
+                }
+                if (depthIrImageListener)
+                {
+                    demand |= OUTPUT_DEPTH_IR_IMAGE;
+                }
+                return demand;
+            }
+
             royale::IDepthDataListener *depthDataListener;
             royale::IDepthImageListener *depthImageListener;
             royale::ISparsePointCloudListener *sparsePointCloudListener;
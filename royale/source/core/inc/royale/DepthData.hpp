@@ -69,11 +69,11 @@ namespace royale
                 this->width = dd.width;
                 this->height = dd.height;
 
-                this->exposureTimes.resize (dd.exposureTimes.size());
-                memcpy (&this->exposureTimes[0], &dd.exposureTimes[0], dd.exposureTimes.size() * sizeof (uint32_t));
+                this->exposureTimes.resizeNoInit (dd.exposureTimes.size());
+                memcpy (this->exposureTimes.data(), dd.exposureTimes.data(), dd.exposureTimes.size() * sizeof (uint32_t));
 
-                this->points.resize (dd.points.size());
-                memcpy (&this->points[0], &dd.points[0], dd.points.size() * sizeof (royale::DepthPoint));
+                this->points.resizeNoInit (dd.points.size());
+                memcpy (this->points.data(), dd.points.data(), dd.points.size() * sizeof (royale::DepthPoint));
             }
             return *this;
         }
@@ -64,14 +64,14 @@ namespace royale
                 this->width = dd.width;
                 this->height = dd.height;
 
-                this->points.resize (dd.points.size());
-                memcpy (&this->points[0], &dd.points[0], dd.points.size() * sizeof (royale::IntermediatePoint));
+                this->points.resizeNoInit (dd.points.size());
+                memcpy (this->points.data(), dd.points.data(), dd.points.size() * sizeof (royale::IntermediatePoint));
 
-                this->modulationFrequencies.resize (dd.modulationFrequencies.size());
-                memcpy (&this->modulationFrequencies[0], &dd.modulationFrequencies[0], dd.modulationFrequencies.size() * sizeof (uint32_t));
+                this->modulationFrequencies.resizeNoInit (dd.modulationFrequencies.size());
+                memcpy (this->modulationFrequencies.data(), dd.modulationFrequencies.data(), dd.modulationFrequencies.size() * sizeof (uint32_t));
 
-                this->exposureTimes.resize (dd.exposureTimes.size());
-                memcpy (&this->exposureTimes[0], &dd.exposureTimes[0], dd.exposureTimes.size() * sizeof (uint32_t));
+                this->exposureTimes.resizeNoInit (dd.exposureTimes.size());
+                memcpy (this->exposureTimes.data(), dd.exposureTimes.data(), dd.exposureTimes.size() * sizeof (uint32_t));
 
                 this->numFrequencies = dd.numFrequencies;
             }
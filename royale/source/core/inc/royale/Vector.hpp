@@ -24,7 +24,9 @@
 #include <map>
 #include <iostream>
 #include <royale/Pair.hpp>
+#include <royale/VectorAllocator.hpp>
 #include <cassert>
+#include <type_traits>
 
 namespace royale
 {
@@ -91,7 +93,7 @@ namespace royale
         *
         * \param v The royale vector which's memory shall be moved
         */
-        Vector<T> (Vector<T> &&v);
+        Vector<T> (Vector<T> &&v) noexcept;
 
         /**
         * Copy-Constructor for STL compliant vector (std::vector)
@@ -703,18 +705,29 @@ namespace royale
         * Assign another royale compliant vector.
         * Assigns new contents to the container, replacing its current contents,
         * and modifying its size accordingly.
-        * This method copies all elements held by v into the container
+        * This method copies all elements held by v into the container, if the
+        * capacity is already large enough then the existing memory is reused
         *
         * \param v A vector of the same storage type
         * \return Vector<T>& Returns *this
         */
-        Vector<T> &operator= (Vector<T> v);
+        Vector<T> &operator= (const Vector<T> &v);
+
+        /**
+        * Move-Assignment for royale compliant vector
+        * Takes over the memory of v, which is left empty (NOTE: performs a shallow copy!)
+        *
+        * \param v The royale vector which's memory shall be moved
+        * \return Vector<T>& Returns *this
+        */
+        Vector<T> &operator= (Vector<T> &&v) noexcept;
 
         /**
         * Assign the contents of an STL compliant vector container by
         * replacing container's current contents if necessary
         * and modifying its size accordingly.
-        * This method copies all elements held by v into the container
+        * This method copies all elements held by v into the container, if the
+        * capacity is already large enough then the existing memory is reused
         *
         * \param v An STL compliant vector of the same storage type
         * \return Vector<T>& Returns *this
@@ -760,34 +773,41 @@ namespace royale
         void clear();
 
         /**
-        * Modifies the vector to the given allocation size and initializes the elements (it may shrink)
+        * Modifies the vector to the given size and initializes the new elements (it may shrink)
         *
-        * Creates any amount of elements (allocates the memory already)
-        * and moves the existing elements to these slots; afterwards the old space is dumped.
+        * If the new size fits in the current capacity, the elements are created in the already
+        * allocated memory.  Otherwise a block of exactly newSize elements is allocated, the existing
+        * elements are moved to it, and afterwards the old space is dumped.
         *
         * If the given newSize is smaller than the already used slots, the vector will shrink.
         * This means that all elements which are not covered within this capacity (the last ones) will be
-        * deleted.
+        * deleted, but the capacity is kept (see shrink_to_fit).
         *
         * \param newSize The amount of slots to remain in the vector (might shrink or enlarge the vector)
         */
         void resize (size_t newSize);
 
         /**
-        * Modifies the vector to the given allocation size and initializes the elements (it may shrink)
-        *
-        * Creates any amount of elements (allocates the memory already)
-        * and moves the existing elements to these slots; afterwards the old space is dumped.
+        * Modifies the vector to the given size and initializes the new elements (it may shrink)
         *
-        * If the given newSize is smaller than the already used slots, the vector will shrink.
-        * This means that all elements which are not covered within this capacity (the last ones) will be
-        * deleted.
+        * This behaves as resize (newSize), but the new elements are copies of initVal.
         *
         * \param newSize The amount of slots to remain in the vector (might shrink or enlarge the vector)
         * \param initVal The initializer value by which the vector shall be initialized
         */
         void resize (size_t newSize, T initVal);
 
+        /**
+        * Modifies the vector to the given size without initializing the new elements
+        *
+        * This is for buffers which are completely overwritten afterwards, for example the points of
+        * a DepthData that is refilled for each frame, and is only available for POD types.  The
+        * memory is reused in the same way as by resize (newSize).
+        *
+        * \param newSize The amount of slots to remain in the vector (might shrink or enlarge the vector)
+        */
+        void resizeNoInit (size_t newSize);
+
         /**
         * Extends the vector to a higher allocation size and allocates the buffers
         *
@@ -902,6 +922,21 @@ namespace royale
 
         inline void freeAllocation();
 
+        /**
+        * Allocates an uninitialized buffer for the given number of elements
+        */
+        static std::shared_ptr<V_TYPE> allocateBuffer (size_t n);
+
+        /**
+        * Replaces the contents with copies of the n elements starting at source
+        */
+        void assignElements (const T *source, size_t n);
+
+        /**
+        * Moves the elements to a new buffer of exactly newCapacity elements
+        */
+        void reallocate (size_t newCapacity);
+
         void memAssign (size_t potentialIndex, const T &value);
 
         std::shared_ptr<V_TYPE> m_data;
@@ -954,7 +989,7 @@ namespace royale
 
     template<class T>
     Vector<T>::Vector (size_t size) :
-        m_data (std::shared_ptr<V_TYPE> (new V_TYPE[sizeof (T) * size], std::default_delete<V_TYPE[]>())),
+        m_data (allocateBuffer (size)),
         m_allocationSize (size),
         m_actualSize (size)
     {
@@ -966,7 +1001,7 @@ namespace royale
 
     template<class T>
     Vector<T>::Vector (size_t n, const T &item) :
-        m_data (std::shared_ptr<V_TYPE> (new V_TYPE[sizeof (T) * n], std::default_delete<V_TYPE[]>())),
+        m_data (allocateBuffer (n)),
         m_allocationSize (n),
         m_actualSize (n)
     {
@@ -978,7 +1013,7 @@ namespace royale
 
     template<class T>
     Vector<T>::Vector (const Vector<T> &v) :
-        m_data (std::shared_ptr<V_TYPE> (new V_TYPE[sizeof (T) * v.m_allocationSize], std::default_delete<V_TYPE[]>())),
+        m_data (allocateBuffer (v.m_allocationSize)),
         m_allocationSize (v.m_allocationSize),
         m_actualSize (v.m_actualSize)
     {
@@ -990,7 +1025,7 @@ namespace royale
 
     template<class T>
     Vector<T>::Vector (const std::vector<T> &v) :
-        m_data (std::shared_ptr<V_TYPE> (new V_TYPE[sizeof (T) * v.size()], std::default_delete<V_TYPE[]>())),
+        m_data (allocateBuffer (v.size())),
         m_allocationSize (v.size()),
         m_actualSize (v.size())
     {
@@ -1001,7 +1036,7 @@ namespace royale
     }
 
     template<typename T>
-    Vector<T>::Vector (Vector<T> &&v) :
+    Vector<T>::Vector (Vector<T> &&v) noexcept :
         Vector<T>()
     {
         classswap (*this, v);
@@ -1010,7 +1045,7 @@ namespace royale
     template <typename T>
     template <class InputIterator>
     Vector<T>::Vector (InputIterator first, InputIterator last) :
-        m_data (std::shared_ptr<V_TYPE> (new V_TYPE[sizeof (T) * (last - first)], std::default_delete<V_TYPE[]>())),
+        m_data (allocateBuffer (static_cast<size_t> (last - first))),
         m_allocationSize (static_cast<size_t>(last - first)),
         m_actualSize (static_cast<size_t>(last - first))
     {
@@ -1317,7 +1352,7 @@ namespace royale
             m_actualSize = 0;
             m_allocationSize = (numItems + (capacity() * GROWTH_FACTOR));
 
-            std::shared_ptr<V_TYPE> newBuffer (new V_TYPE[sizeof (T) * m_allocationSize], std::default_delete<V_TYPE[]>());
+            auto newBuffer = allocateBuffer (m_allocationSize);
 
             // copy old data, till the insert point is reached
             size_t i = 0;
@@ -1395,7 +1430,7 @@ namespace royale
             // allocate a bigger block and move data
             m_allocationSize = (n * GROWTH_FACTOR);
 
-            std::shared_ptr<V_TYPE> newBuffer (new V_TYPE[sizeof (T) * m_allocationSize], std::default_delete<V_TYPE[]>());
+            auto newBuffer = allocateBuffer (m_allocationSize);
             m_data = newBuffer;
 
             // insert given data
@@ -1452,7 +1487,7 @@ namespace royale
             // allocate a bigger block and move data
             m_allocationSize = (numItems * GROWTH_FACTOR);
 
-            std::shared_ptr<V_TYPE> newBuffer (new V_TYPE[sizeof (T) * m_allocationSize], std::default_delete<V_TYPE[]>());
+            auto newBuffer = allocateBuffer (m_allocationSize);
             m_data = newBuffer;
 
             // insert given data
@@ -1523,7 +1558,7 @@ namespace royale
             // allocate a bigger block and move data
             m_allocationSize = (indexFromIterator (position) + numItems) * GROWTH_FACTOR;
 
-            std::shared_ptr<V_TYPE> newBuffer (new V_TYPE[sizeof (T) * m_allocationSize], std::default_delete<V_TYPE[]>());
+            auto newBuffer = allocateBuffer (m_allocationSize);
 
             // copy old data, till the insert point is reached
             size_t newSize = 0;
@@ -1727,11 +1762,32 @@ namespace royale
     }
 
     template<class T>
-    Vector<T> &Vector<T>::operator= (Vector<T> v)
+    Vector<T> &Vector<T>::operator= (const Vector<T> &v)
+    {
+        if (this != &v)
+        {
+            if (v.size() <= m_allocationSize)
+            {
+                assignElements (v.data(), v.size());
+            }
+            else
+            {
+                // Create a non-const copy, so we can swap elements
+                Vector<T> copy (v);
+                classswap (*this, copy);
+            }
+        }
+        return *this;
+    }
+
+    template<class T>
+    Vector<T> &Vector<T>::operator= (Vector<T> &&v) noexcept
     {
         if (this != &v)
         {
             classswap (*this, v);
+            v.clear();
+            v.freeAllocation();
         }
         return *this;
     }
@@ -1739,9 +1795,16 @@ namespace royale
     template<class T>
     Vector<T> &Vector<T>::operator= (const std::vector<T> &v)
     {
-        // Create a non-const copy, so we can swap elements
-        Vector<T> copy (v);
-        classswap (*this, copy);
+        if (v.size() <= m_allocationSize)
+        {
+            assignElements (v.data(), v.size());
+        }
+        else
+        {
+            // Create a non-const copy, so we can swap elements
+            Vector<T> copy (v);
+            classswap (*this, copy);
+        }
         return *this;
     }
 
@@ -1817,84 +1880,109 @@ namespace royale
     }
 
     template<class T>
-    void Vector<T>::reserve (size_t capacity)
+    std::shared_ptr<typename Vector<T>::V_TYPE> Vector<T>::allocateBuffer (size_t n)
     {
-        if (capacity > m_allocationSize)
-        {
-            std::shared_ptr<V_TYPE> newBuffer (new V_TYPE[sizeof (T) * capacity], std::default_delete<V_TYPE[]>());
-            for (size_t i = 0; i < m_actualSize; ++i)
-            {
-                new (newBuffer.get() + sizeof (T) * i) T (std::move (operator[] (i)));
-                (data() [i]).~T();
-            }
+        return detail::allocateVectorBuffer (sizeof (T) * n);
+    }
 
-            m_allocationSize = capacity;
+    template<class T>
+    void Vector<T>::reallocate (size_t newCapacity)
+    {
+        assert (newCapacity >= m_actualSize);
 
-            m_data.reset();
-            m_data = newBuffer;
+        auto newBuffer = allocateBuffer (newCapacity);
+        for (size_t i = 0; i < m_actualSize; ++i)
+        {
+            new (newBuffer.get() + sizeof (T) * i) T (std::move (operator[] (i)));
+            (data() [i]).~T();
         }
+
+        m_allocationSize = newCapacity;
+        m_data = std::move (newBuffer);
     }
 
     template<class T>
-    void Vector<T>::resize (size_t newSize)
+    void Vector<T>::assignElements (const T *source, size_t n)
     {
-        if (newSize != m_actualSize)
+        assert (n <= m_allocationSize);
+
+        const size_t assigned = n < m_actualSize ? n : m_actualSize;
+        for (size_t i = 0; i < assigned; ++i)
         {
-            std::shared_ptr<V_TYPE> newBuffer (new V_TYPE[sizeof (T) * newSize], std::default_delete<V_TYPE[]>());
-            for (size_t i = 0; i < newSize; ++i)
-            {
-                if (i < m_actualSize)
-                {
-                    new (newBuffer.get() + sizeof (T) * i) T (std::move (operator[] (i)));
-                }
-                else
-                {
-                    new (newBuffer.get() + sizeof (T) * i) T();
-                }
-            }
+            data() [i] = source[i];
+        }
+        for (size_t i = assigned; i < n; ++i)
+        {
+            new (data() + i) T (source[i]);
+        }
+        for (size_t i = n; i < m_actualSize; ++i)
+        {
+            (data() [i]).~T();
+        }
 
-            for (size_t i = 0; i < m_actualSize; ++i)
-            {
-                (data() [i]).~T();
-            }
+        m_actualSize = n;
+    }
 
-            m_actualSize = newSize;
-            m_allocationSize = newSize;
+    template<class T>
+    void Vector<T>::reserve (size_t capacity)
+    {
+        if (capacity > m_allocationSize)
+        {
+            reallocate (capacity);
+        }
+    }
 
-            m_data.reset();
-            m_data = newBuffer;
+    template<class T>
+    void Vector<T>::resize (size_t newSize)
+    {
+        if (newSize > m_allocationSize)
+        {
+            reallocate (newSize);
         }
+
+        for (size_t i = m_actualSize; i < newSize; ++i)
+        {
+            new (data() + i) T();
+        }
+        for (size_t i = newSize; i < m_actualSize; ++i)
+        {
+            (data() [i]).~T();
+        }
+
+        m_actualSize = newSize;
     }
 
     template<class T>
     void Vector<T>::resize (size_t newSize, T initVal)
     {
-        if (newSize != m_actualSize)
+        if (newSize > m_allocationSize)
         {
-            std::shared_ptr<V_TYPE> newBuffer (new V_TYPE[sizeof (T) * newSize], std::default_delete<V_TYPE[]>());
-            for (size_t i = 0; i < newSize; ++i)
-            {
-                if (i < m_actualSize)
-                {
-                    new (newBuffer.get() + sizeof (T) * i) T (std::move (operator[] (i)));
-                }
-                else
-                {
-                    new (newBuffer.get() + sizeof (T) * i) T (initVal);
-                }
-            }
+            reallocate (newSize);
+        }
 
-            for (size_t i = 0; i < m_actualSize; ++i)
-            {
-                (data() [i]).~T();
-            }
+        for (size_t i = m_actualSize; i < newSize; ++i)
+        {
+            new (data() + i) T (initVal);
+        }
+        for (size_t i = newSize; i < m_actualSize; ++i)
+        {
+            (data() [i]).~T();
+        }
 
-            m_actualSize = newSize;
-            m_allocationSize = newSize;
+        m_actualSize = newSize;
+    }
 
-            m_data.reset();
-            m_data = newBuffer;
+    template<class T>
+    void Vector<T>::resizeNoInit (size_t newSize)
+    {
+        static_assert (std::is_pod<T>::value, "resizeNoInit is only available for POD types");
+
+        if (newSize > m_allocationSize)
+        {
+            reallocate (newSize);
         }
+
+        m_actualSize = newSize;
     }
 
     template<class T>
@@ -1905,17 +1993,7 @@ namespace royale
             return;
         }
 
-        std::shared_ptr<V_TYPE> newBuffer (new V_TYPE[sizeof (T) * m_actualSize], std::default_delete<V_TYPE[]>());
-        for (size_t i = 0; i < m_actualSize; ++i)
-        {
-            new (newBuffer.get() + sizeof (T) * i) T (std::move (operator[] (i)));
-            (data() [i]).~T();
-        }
-
-        m_allocationSize = m_actualSize;
-
-        m_data.reset();
-        m_data = newBuffer;
+        reallocate (m_actualSize);
     }
 
     template<class T>
@@ -0,0 +1,69 @@
+/****************************************************************************\
+* Copyright (C) 2019 pmdtechnologies ag
+*
+* THIS CODE AND INFORMATION ARE PROVIDED "AS IS" WITHOUT WARRANTY OF ANY
+* KIND, EITHER EXPRESSED OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE
+* IMPLIED WARRANTIES OF MERCHANTABILITY AND/OR FITNESS FOR A
+* PARTICULAR PURPOSE.
+*
+\****************************************************************************/
+
+#pragma once
+
+#include <royale/Definitions.hpp>
+#include <cstddef>
+#include <memory>
+
+namespace royale
+{
+    /**
+    * Source of the memory that royale::Vector keeps its elements in.
+    *
+    * Both functions may be called from any thread.  deallocate() is called with the same size
+    * that was passed to allocate(), and it must not throw.
+    *
+    * Each buffer keeps a reference to the allocator that it was allocated from, so replacing the
+    * allocator with setVectorAllocator() doesn't affect buffers which already exist.
+    *
+    * Without an allocator the buffers are allocated with new[] and freed with delete[].
+    */
+    class IVectorAllocator
+    {
+    public:
+        virtual ~IVectorAllocator() = default;
+
+        /**
+        * Returns a block of at least the given size, aligned for any fundamental type.
+        * Throws std::bad_alloc if the memory can't be allocated.
+        */
+        virtual void *allocate (std::size_t bytes) = 0;
+
+        /**
+        * Returns a block which was returned by allocate (bytes).
+        */
+        virtual void deallocate (void *block, std::size_t bytes) = 0;
+    };
+
+    /**
+    * Returns the allocator that new royale::Vector buffers are allocated from, or nullptr if
+    * they are allocated with new[].
+    */
+    ROYALE_API std::shared_ptr<IVectorAllocator> getVectorAllocator();
+
+    /**
+    * Replaces the allocator that new royale::Vector buffers are allocated from, for example to
+    * count the allocations, to use a VectorPool (royale/VectorPool.hpp) or to use memory that the
+    * application manages.
+    * Passing nullptr restores the default, which allocates the buffers with new[].
+    */
+    ROYALE_API void setVectorAllocator (std::shared_ptr<IVectorAllocator> allocator);
+
+    namespace detail
+    {
+        /**
+        * Allocates a buffer of the given size from the current allocator, or with new[] if
+        * there is none.
+        */
+        ROYALE_API std::shared_ptr<char> allocateVectorBuffer (std::size_t bytes);
+    }
+}
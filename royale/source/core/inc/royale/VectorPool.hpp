@@ -0,0 +1,153 @@
+/****************************************************************************\
+* Copyright (C) 2019 pmdtechnologies ag
+*
+* THIS CODE AND INFORMATION ARE PROVIDED "AS IS" WITHOUT WARRANTY OF ANY
+* KIND, EITHER EXPRESSED OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE
+* IMPLIED WARRANTIES OF MERCHANTABILITY AND/OR FITNESS FOR A
+* PARTICULAR PURPOSE.
+*
+\****************************************************************************/
+
+#pragma once
+
+#include <royale/VectorAllocator.hpp>
+#include <cstddef>
+#include <mutex>
+#include <new>
+#include <vector>
+
+namespace royale
+{
+    /**
+    * An IVectorAllocator which keeps freed blocks and hands them out again for the next
+    * allocation of a similar size.  It isn't used unless it's installed with
+    * setVectorAllocator (std::make_shared<VectorPool>()).
+    *
+    * Most of the vectors that are passed through the API are created or resized once per frame
+    * with the same sizes as the previous frame, and with this pool these don't call the global
+    * allocator after the first few frames.  This only pays off if the global allocator is slow
+    * for blocks of this size, as each call takes a lock shared by all threads, and the cached
+    * blocks are only freed when the pool is destroyed.
+    *
+    * The sizes are rounded up to size classes, with four classes for each power of two, so a
+    * block is never more than 25% larger than requested.  Blocks larger than MAX_POOLED_SIZE are
+    * not kept, and the number of blocks and the total size kept are limited.
+    */
+    class VectorPool : public IVectorAllocator
+    {
+    public:
+        static const std::size_t MIN_BLOCK_SIZE = 64u;
+        static const std::size_t MAX_POOLED_SIZE = 64u * 1024u * 1024u;
+        static const std::size_t MAX_CACHED_BLOCKS = 64u;
+        static const std::size_t MAX_CACHED_BYTES = 128u * 1024u * 1024u;
+
+        VectorPool() :
+            m_freeBlocks (sizeClass (MAX_POOLED_SIZE) + 1u),
+            m_cachedBytes (0u)
+        {
+            for (auto &freeList : m_freeBlocks)
+            {
+                freeList.reserve (MAX_CACHED_BLOCKS);
+            }
+        }
+
+        ~VectorPool() override
+        {
+            for (auto &freeList : m_freeBlocks)
+            {
+                for (auto block : freeList)
+                {
+                    ::operator delete (block);
+                }
+            }
+        }
+
+        VectorPool (const VectorPool &) = delete;
+        VectorPool &operator= (const VectorPool &) = delete;
+
+        void *allocate (std::size_t bytes) override
+        {
+            if (bytes > MAX_POOLED_SIZE)
+            {
+                return ::operator new (bytes);
+            }
+
+            const auto index = sizeClass (bytes);
+            {
+                std::lock_guard<std::mutex> lock (m_lock);
+                auto &freeList = m_freeBlocks[index];
+                if (!freeList.empty())
+                {
+                    auto block = freeList.back();
+                    freeList.pop_back();
+                    m_cachedBytes -= blockSize (index);
+                    return block;
+                }
+            }
+            return ::operator new (blockSize (index));
+        }
+
+        void deallocate (void *block, std::size_t bytes) override
+        {
+            if (block == nullptr)
+            {
+                return;
+            }
+
+            if (bytes <= MAX_POOLED_SIZE)
+            {
+                const auto index = sizeClass (bytes);
+                std::lock_guard<std::mutex> lock (m_lock);
+                auto &freeList = m_freeBlocks[index];
+                // The capacity was reserved in the constructor, so push_back won't allocate
+                if (freeList.size() < MAX_CACHED_BLOCKS && m_cachedBytes + blockSize (index) <= MAX_CACHED_BYTES)
+                {
+                    freeList.push_back (block);
+                    m_cachedBytes += blockSize (index);
+                    return;
+                }
+            }
+            ::operator delete (block);
+        }
+
+        /**
+        * The index of the size class that an allocation of the given size is served from.
+        */
+        static std::size_t sizeClass (std::size_t bytes)
+        {
+            if (bytes <= MIN_BLOCK_SIZE)
+            {
+                return 0u;
+            }
+
+            // Split the range between each power of two (2^bit, 2^(bit + 1)] in to four classes
+            const auto n = bytes - 1u;
+            std::size_t bit = 6u;
+            while ( (n >> (bit + 1u)) != 0u)
+            {
+                ++bit;
+            }
+            return 1u + (bit - 6u) * 4u + ( (n >> (bit - 2u)) - 4u);
+        }
+
+        /**
+        * The size of the blocks in the given size class.
+        */
+        static std::size_t blockSize (std::size_t index)
+        {
+            if (index == 0u)
+            {
+                return MIN_BLOCK_SIZE;
+            }
+
+            const auto bit = 6u + (index - 1u) / 4u;
+            const auto quarter = (index - 1u) % 4u;
+            return (std::size_t (5u) + quarter) << (bit - 2u);
+        }
+
+    private:
+        std::mutex m_lock;
+        std::vector<std::vector<void *> > m_freeBlocks;
+        std::size_t m_cachedBytes;
+    };
+}
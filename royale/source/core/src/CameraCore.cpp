@@ -15,6 +15,7 @@
 #include <device/TemperatureMonitor.hpp>
 #include <device/TemperatureSensorCheckAdapter.hpp>
 #include <device/PsdTemperatureSensorCheckAdapter.hpp>
+#include <device/PsdTemperatureSampler.hpp>
 #include <common/events/EventCaptureStream.hpp>
 #include <collector/BufferActionCalcIndividual.hpp>
 #include <collector/BufferActionCalcSuper.hpp>
@@ -29,6 +30,21 @@ using namespace royale::config;
 using namespace royale::usecase;
 using namespace royale::collector;
 
+namespace
+{
+    /**
+     * How often the temperature sensor is read while capturing.  The frames use the most recent
+     * reading, so a sensor that needs I/O (for example I2C) doesn't delay them.
+     */
+    const std::chrono::milliseconds TEMPERATURE_SAMPLE_PERIOD{ 500 };
+
+    /**
+     * How often the temperature is decoded from the pseudo data, the frames in between use the
+     * previous temperature.
+     */
+    const std::chrono::milliseconds PSD_TEMPERATURE_SAMPLE_PERIOD{ 100 };
+}
+
 CameraCore::CameraCore (std::shared_ptr<const royale::config::ICoreConfig> config,
                         std::shared_ptr<royale::hal::IImager> imager,
                         std::shared_ptr<royale::hal::IBridgeDataReceiver> bridgeReceiver,
@@ -118,7 +134,8 @@ void CameraCore::init ()
                            m_config->getTemperatureLimitHard());
         checker->setEventListener (&m_eventQueueInt);
         auto adapter = std::make_shared<TemperatureSensorCheckAdapter> (m_temperatureSensor, std::move (checker));
-        m_temperatureSensor = adapter;
+        m_temperatureSampler = std::make_shared<TemperatureSampler> (adapter, TEMPERATURE_SAMPLE_PERIOD);
+        m_temperatureSensor = m_temperatureSampler;
         m_frameCollector->setTemperatureSensor (m_temperatureSensor);
     }
     if (!m_temperatureSensor && m_psdTemperatureSensor)
@@ -128,7 +145,7 @@ void CameraCore::init ()
                            m_config->getTemperatureLimitHard());
         checker->setEventListener (&m_eventQueueInt);
         auto adapter = std::make_shared<PsdTemperatureSensorCheckAdapter> (m_psdTemperatureSensor, std::move (checker));
-        m_psdTemperatureSensor = adapter;
+        m_psdTemperatureSensor = std::make_shared<PsdTemperatureSampler> (adapter, PSD_TEMPERATURE_SAMPLE_PERIOD);
         m_frameCollector->setTemperatureSensor (m_psdTemperatureSensor);
     }
 
@@ -170,6 +187,10 @@ CameraCore::~CameraCore()
             // Silently catch any exception
         }
     }
+    if (m_temperatureSampler)
+    {
+        m_temperatureSampler->stop();
+    }
     m_frameCollector->setEventListener (nullptr);
     m_bridgeReceiver->setEventListener (nullptr);
     m_bridgeReceiver->setBufferCaptureListener (nullptr);
@@ -179,7 +200,23 @@ CameraCore::~CameraCore()
 void CameraCore::startCapture()
 {
     m_imager->startCapture();
-    m_bridgeReceiver->startCapture();
+    // The sampler reads the sensor once when it starts, so that the first frame has a reading
+    if (m_temperatureSampler)
+    {
+        m_temperatureSampler->start();
+    }
+    try
+    {
+        m_bridgeReceiver->startCapture();
+    }
+    catch (...)
+    {
+        if (m_temperatureSampler)
+        {
+            m_temperatureSampler->stop();
+        }
+        throw;
+    }
     m_isCapturing = true;
 }
 
@@ -188,6 +225,10 @@ void CameraCore::stopCapture()
     // Even if something goes wrong we will assume
     // the capturing was stopped
     m_isCapturing = false;
+    if (m_temperatureSampler)
+    {
+        m_temperatureSampler->stop();
+    }
     try
     {
         // This may fail if we've lost our USB device.
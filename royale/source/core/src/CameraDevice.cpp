@@ -1145,17 +1145,6 @@ CameraStatus CameraDevice::setCallbackData (uint16_t cbData) ROYALE_API_EXCEPTIO
         return CameraStatus::NO_CALIBRATION_DATA;
     }
 
-    bool restartCapture{ false };
-    if (isCapturing())
-    {
-        restartCapture = true;
-        auto status = stopCapture();
-        if (status != CameraStatus::SUCCESS)
-        {
-            LOG (ERROR) << "Cameras stopCapture method failed inside its setCallbackData method. CameraStatus = \"" << royale::getStatusString (status) << "\"";
-        }
-    }
-
     // If we switch from raw to depth we have to make sure that
     // the processing is set up correctly and that the use case
     // is also available for depth
@@ -1166,6 +1155,20 @@ CameraStatus CameraDevice::setCallbackData (uint16_t cbData) ROYALE_API_EXCEPTIO
         switchFromRaw = true;
     }
 
+    // Only setting up the processing again needs the capturing to be stopped. For the other
+    // switches the processing picks up the new listeners at the next frame, so that no frames
+    // are lost.
+    bool restartCapture{ false };
+    if (m_isInitialized && switchFromRaw && isCapturing())
+    {
+        restartCapture = true;
+        auto status = stopCapture();
+        if (status != CameraStatus::SUCCESS)
+        {
+            LOG (ERROR) << "Cameras stopCapture method failed inside its setCallbackData method. CameraStatus = \"" << royale::getStatusString (status) << "\"";
+        }
+    }
+
     uint16_t oldCbData = m_callbackData;
 
     m_callbackData = cbData;
@@ -34,3 +34,19 @@ royale::EventType EventFrameDropped::type() const
 {
     return royale::EventType::ROYALE_FRAME_DROP;
 }
+
+bool EventFrameDropped::coalesce (const royale::IEvent &next)
+{
+    auto dropped = dynamic_cast<const EventFrameDropped *> (&next);
+    if (dropped == nullptr)
+    {
+        return false;
+    }
+    m_nrOfFramesDropped += dropped->m_nrOfFramesDropped;
+    return true;
+}
+
+unsigned EventFrameDropped::getNrOfFramesDropped() const
+{
+    return m_nrOfFramesDropped;
+}
@@ -11,6 +11,7 @@
 #include <common/EventQueue.hpp>
 #include <royale/IEvent.hpp>
 #include <common/RoyaleLogger.hpp>
+#include <common/events/ICoalescableEvent.hpp>
 
 #include <cassert>
 
@@ -18,6 +19,8 @@ using namespace royale;
 
 EventQueue::EventQueue()
     : m_queue(),
+      m_delivering(),
+      m_discardedEvents (0u),
       m_callbackActive (false),
       m_queueMutex(),
       m_queueCond(),
@@ -26,7 +29,9 @@ EventQueue::EventQueue()
       m_listenerMutex(),
       m_listener (nullptr)
 {
-
+    // The notifier swaps the two vectors, so neither allocates while the queue is bounded
+    m_queue.reserve (MAX_QUEUED_EVENTS);
+    m_delivering.reserve (MAX_QUEUED_EVENTS);
 }
 
 EventQueue::~EventQueue()
@@ -74,9 +79,35 @@ void EventQueue::onEvent (std::unique_ptr<royale::IEvent> &&event)
 {
     std::unique_lock<std::mutex> lock (m_queueMutex);
     // It makes no sense to push events if there is no listener.
-    if (m_listener)
+    if (!m_listener)
+    {
+        return;
+    }
+
+    // The last event in the queue hasn't been taken by the notifier, so it can still be merged
+    // with this one.  The merged event stays with the caller, and is freed after the lock has
+    // been released.
+    if (!m_queue.empty())
     {
-        m_queue.push_back (std::move (event));
+        auto previous = dynamic_cast<event::ICoalescableEvent *> (m_queue.back().get());
+        if (previous && previous->coalesce (*event))
+        {
+            return;
+        }
+    }
+
+    if (m_queue.size() >= MAX_QUEUED_EVENTS &&
+            event->severity() < EventSeverity::ROYALE_ERROR)
+    {
+        ++m_discardedEvents;
+        return;
+    }
+
+    const auto wasEmpty = m_queue.empty();
+    m_queue.push_back (std::move (event));
+    if (wasEmpty)
+    {
+        // The notifier only waits while the queue is empty
         m_queueCond.notify_all();
     }
 }
@@ -103,18 +134,18 @@ void EventQueue::eventNotifier()
             m_queueCond.wait (queueLock);
         }
 
-        std::unique_lock<std::mutex> listenerLock (m_listenerMutex);
-
         if (!m_listener)
         {
             return; // listener was unset, so this thread finishes.
         }
         assert (!m_queue.empty());
-        assert (m_listener);
-
-        auto event    = std::move (m_queue.front());
+        assert (m_delivering.empty());
 
-        m_queue.pop_front();
+        // Take all waiting events at once, so that the threads generating events only have to
+        // wait for this swap instead of for each event.
+        m_delivering.swap (m_queue);
+        const auto discardedEvents = m_discardedEvents;
+        m_discardedEvents = 0u;
         m_queueCond.notify_all();
 
         // Queue lock is released while user event handler is running,
@@ -122,17 +153,31 @@ void EventQueue::eventNotifier()
         m_callbackActive = true;
         m_callbackCond.notify_all();
         queueLock.unlock();
-        // m_listenerMutex stays locked.
 
-        try
+        if (discardedEvents)
         {
-            m_listener->onEvent (std::move (event));
+            LOG (WARN) << "EventQueue: queue full, discarded " << discardedEvents << " event(s)";
         }
-        catch (...)
+
+        for (auto &event : m_delivering)
         {
-            LOG (WARN) << "EventQueue: callback failed (exception)";
+            std::lock_guard<std::mutex> listenerLock (m_listenerMutex);
+            if (!m_listener)
+            {
+                break; // listener was unset, the remaining events are discarded.
+            }
+
+            try
+            {
+                m_listener->onEvent (std::move (event));
+            }
+            catch (...)
+            {
+                LOG (WARN) << "EventQueue: callback failed (exception)";
+            }
         }
-        listenerLock.unlock();
+        m_delivering.clear();
+
         queueLock.lock();
         m_callbackActive = false;
         m_callbackCond.notify_all();
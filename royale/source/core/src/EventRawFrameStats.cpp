@@ -9,10 +9,24 @@
 \****************************************************************************/
 
 #include <common/events/EventRawFrameStats.hpp>
+#include <algorithm>
+#include <limits>
 #include <sstream>
 
 using namespace royale::event;
 
+namespace
+{
+    /**
+    * Adds the counters, saturating instead of wrapping around.
+    */
+    uint16_t addCounters (uint16_t a, uint16_t b)
+    {
+        const auto sum = static_cast<uint32_t> (a) + b;
+        return static_cast<uint16_t> (std::min<uint32_t> (sum, std::numeric_limits<uint16_t>::max()));
+    }
+}
+
 EventRawFrameStats::EventRawFrameStats (uint16_t totalFrames, uint16_t frameDropsBridge, uint16_t frameDropsCollector)
     : m_totalFrames (totalFrames),
       m_frameDropsBridge (frameDropsBridge),
@@ -44,3 +58,16 @@ royale::EventType EventRawFrameStats::type() const
 {
     return royale::EventType::ROYALE_RAW_FRAME_STATS;
 }
+
+bool EventRawFrameStats::coalesce (const royale::IEvent &next)
+{
+    auto stats = dynamic_cast<const EventRawFrameStats *> (&next);
+    if (stats == nullptr)
+    {
+        return false;
+    }
+    m_totalFrames = addCounters (m_totalFrames, stats->m_totalFrames);
+    m_frameDropsBridge = addCounters (m_frameDropsBridge, stats->m_frameDropsBridge);
+    m_frameDropsCollector = addCounters (m_frameDropsCollector, stats->m_frameDropsCollector);
+    return true;
+}
@@ -18,6 +18,7 @@
 #include <common/MakeUnique.hpp>
 #include <common/NarrowCast.hpp>
 #include <common/RoyaleLogger.hpp>
+#include <common/RoyaleTrace.hpp>
 
 using namespace royale::common;
 using namespace royale::usecase;
@@ -85,12 +86,15 @@ namespace
          * \param buffer where the data is stored, must have a equal or longer lifespan than this class
          * \param imageOffset where in the buffer's pixels the UCD's image data starts (offset in pixels, not bytes)
          * \param pseudoOffset where in the buffer's pixels pseudo data starts (offset in pixels, not bytes)
+         * \param fields the values decoded from this frame's pseudo data
          */
-        WrappedRawFrame (BufferHolder *holder, ICapturedBuffer *buffer, std::size_t imageOffset, std::size_t pseudoOffset) :
+        WrappedRawFrame (BufferHolder *holder, ICapturedBuffer *buffer, std::size_t imageOffset, std::size_t pseudoOffset,
+                         const PseudoDataFields &fields) :
             m_holder {holder},
             m_buffer {buffer},
             m_imageOffset {imageOffset},
-            m_pseudoOffset {pseudoOffset}
+            m_pseudoOffset {pseudoOffset},
+            m_fields (fields)
         {
         }
 
@@ -107,6 +111,14 @@ namespace
             return m_buffer->getTimeMicroseconds();
         }
 
+        /**
+         * The pseudo data fields, decoded once when the frame was received.
+         */
+        const PseudoDataFields *getPseudoDataFields() const override
+        {
+            return &m_fields;
+        }
+
         uint16_t *getImageData() override
         {
             return &m_buffer->getPixelData() [m_imageOffset];
@@ -126,6 +138,7 @@ namespace
         ICapturedBuffer *m_buffer;
         std::size_t m_imageOffset;
         std::size_t m_pseudoOffset;
+        PseudoDataFields m_fields;
         friend class BufferHolder;
     };
 
@@ -165,11 +178,11 @@ namespace
         /**
          * Returns one of the frames within the buffer, incrementing the refcount.
          */
-        WrappedRawFrame *getWrapper (std::size_t frame)
+        WrappedRawFrame *getWrapper (std::size_t frame, const PseudoDataFields &fields)
         {
             auto basePixel = frame * m_pixelsPerFrame;
             m_wrapperCount++;
-            return new WrappedRawFrame (this, m_buffer, basePixel + m_imageOffset, basePixel + m_pseudoOffset);
+            return new WrappedRawFrame (this, m_buffer, basePixel + m_imageOffset, basePixel + m_pseudoOffset, fields);
         }
 
         /**
@@ -614,6 +627,7 @@ void FrameCollectorBase::conveyanceFunction()
     // it.  The destructor will set m_stopConveyance to signal this thread to finish, and the local
     // runConveyance variable will be cleared once all queued buffers have been released.
     bool runConveyance = true;
+    ROYALE_TRACE_THREAD_NAME ("FrameCollector conveyance");
     while (runConveyance)
     {
         if (m_temperatureSensor && !m_stopConveyance && !m_releaseAllBuffers)
@@ -667,6 +681,7 @@ void FrameCollectorBase::conveyanceFunction()
                 {
                     try
                     {
+                        ROYALE_TRACE_ZONE ("FrameCollector::conveyance");
                         ownershipPassedToListener = true;
                         m_captureListener->captureCallback (callback->frames, *callback->definition, callback->streamId, std::move (callback->capturedCase));
                     }
@@ -688,6 +703,7 @@ void FrameCollectorBase::conveyanceFunction()
 
 void FrameCollectorBase::bufferCallback (royale::hal::ICapturedBuffer *buffer)
 {
+    ROYALE_TRACE_ZONE ("FrameCollector::bufferCallback");
     std::unique_lock<std::mutex> eucLock (m_executeUseCaseLock, std::try_to_lock);
     if (!eucLock.owns_lock())
     {
@@ -702,10 +718,12 @@ void FrameCollectorBase::bufferCallback (royale::hal::ICapturedBuffer *buffer)
     auto holder = makeUnique<BufferHolder> (buffer, m_bufferReleaser.get(), m_imageWidth, 0, m_pixelsPerFrame);
     buffer = nullptr;
 
-    auto firstFrame = holder->getPseudoData (0);
-    const auto frameNumber = m_pseudoDataInterpreter->getFrameNumber (firstFrame);
-    const auto sequence = m_pseudoDataInterpreter->getSequenceIndex (firstFrame);
-    const auto capturedReconfigIndex = m_pseudoDataInterpreter->getReconfigIndex (firstFrame);
+    // Each frame's pseudo data is decoded once, the WrappedRawFrames keep the result
+    PseudoDataFields firstFields;
+    m_pseudoDataInterpreter->decodeFields (holder->getPseudoData (0), firstFields);
+    const auto frameNumber = firstFields.frameNumber;
+    const auto sequence = firstFields.sequenceIndex;
+    const auto capturedReconfigIndex = firstFields.reconfigIndex;
 
     std::lock_guard<std::mutex> lock (m_bufferLock);
 
@@ -843,19 +861,30 @@ void FrameCollectorBase::bufferCallback (royale::hal::ICapturedBuffer *buffer)
     auto holderForLoop = holder.get();
     for (std::size_t i = 0; i < frameCount; i++)
     {
+        if (action.mapping[i].empty())
+        {
+            continue;
+        }
+
+        PseudoDataFields fields = firstFields;
+        if (i != 0)
+        {
+            m_pseudoDataInterpreter->decodeFields (holderForLoop->getPseudoData (i), fields);
+        }
+
         for (const auto &mapFramesTo : action.mapping[i])
         {
             auto &destination = m_capturedFrames[mapFramesTo.group][mapFramesTo.index];
             if (destination)
             {
                 LOG (WARN) << "Two frames mapped to the same destination: "
-                           << uint32_t {m_pseudoDataInterpreter->getFrameNumber (*destination) }
+                           << uint32_t {getFields (*destination).frameNumber }
                            << " and "
-                           << uint32_t {m_pseudoDataInterpreter->getFrameNumber (holderForLoop->getPseudoData (i)) };
+                           << uint32_t {fields.frameNumber };
             }
             else
             {
-                destination = holderForLoop->getWrapper (i);
+                destination = holderForLoop->getWrapper (i, fields);
                 (void) holder.release();
             }
         }
@@ -866,6 +895,18 @@ void FrameCollectorBase::bufferCallback (royale::hal::ICapturedBuffer *buffer)
     processReadyGroups (action.ready);
 }
 
+PseudoDataFields FrameCollectorBase::getFields (const ICapturedRawFrame &frame) const
+{
+    const auto cached = frame.getPseudoDataFields();
+    if (cached)
+    {
+        return *cached;
+    }
+    PseudoDataFields fields;
+    m_pseudoDataInterpreter->decodeFields (frame, fields);
+    return fields;
+}
+
 void FrameCollectorBase::processReadyGroups (const decltype (BufferAction::ready) &ready)
 {
     for (const auto group : ready)
@@ -880,7 +921,7 @@ void FrameCollectorBase::processReadyGroups (const decltype (BufferAction::ready
         bool allAsExpected = true;
         for (std::size_t i = 0; i < collected.size(); i++)
         {
-            if (collected[i] == nullptr || expectation.sequence[i] != m_pseudoDataInterpreter->getSequenceIndex (*collected[i]))
+            if (collected[i] == nullptr || expectation.sequence[i] != getFields (*collected[i]).sequenceIndex)
             {
                 allAsExpected = false;
                 break;
@@ -891,7 +932,7 @@ void FrameCollectorBase::processReadyGroups (const decltype (BufferAction::ready
         {
             // sequence is complete, move it to a vector that's safe after unlocking the mutex
 
-            updateEyeSafetyErrorAndState (*collected.front());
+            updateEyeSafetyErrorAndState (getFields (*collected.front()).eyeError);
 
             if (m_temperatureSensor)
             {
@@ -1014,10 +1055,8 @@ void FrameCollectorBase::releaseSparseCollection (std::vector<ICapturedRawFrame
     updateStats (dropped, 0u);
 }
 
-void FrameCollectorBase::updateEyeSafetyErrorAndState (const royale::common::ICapturedRawFrame &frame)
+void FrameCollectorBase::updateEyeSafetyErrorAndState (uint32_t eyeError)
 {
-    uint32_t eyeError = 0u;
-    m_pseudoDataInterpreter->getEyeSafetyError (frame, eyeError);
     if (eyeError != 0u)
     {
         m_eventForwarder.event<event::EventEyeSafety> (eyeError);
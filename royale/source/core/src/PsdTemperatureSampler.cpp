@@ -0,0 +1,40 @@
+/****************************************************************************\
+* Copyright (C) 2019 pmdtechnologies ag
+*
+* THIS CODE AND INFORMATION ARE PROVIDED "AS IS" WITHOUT WARRANTY OF ANY
+* KIND, EITHER EXPRESSED OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE
+* IMPLIED WARRANTIES OF MERCHANTABILITY AND/OR FITNESS FOR A
+* PARTICULAR PURPOSE.
+*
+\****************************************************************************/
+
+
+#include <device/PsdTemperatureSampler.hpp>
+
+
+using namespace royale::device;
+using namespace royale::common;
+
+
+PsdTemperatureSampler::PsdTemperatureSampler (std::shared_ptr<royale::hal::IPsdTemperatureSensor> sensor,
+        std::chrono::milliseconds period)
+    : m_baseSensor (sensor),
+      m_period (period),
+      m_hasTemperature (false),
+      m_temperature (0.0f),
+      m_timestamp()
+{
+}
+
+float PsdTemperatureSampler::calcTemperature (const std::vector<ICapturedRawFrame *> &frames)
+{
+    const auto now = std::chrono::steady_clock::now();
+    if (!m_hasTemperature || now - m_timestamp >= m_period)
+    {
+        // If this throws, the next set of frames will try again
+        m_temperature = m_baseSensor->calcTemperature (frames);
+        m_hasTemperature = true;
+        m_timestamp = now;
+    }
+    return m_temperature;
+}
@@ -0,0 +1,408 @@
+/****************************************************************************\
+ * Copyright (C) 2019 pmdtechnologies ag
+ *
+ * THIS CODE AND INFORMATION ARE PROVIDED "AS IS" WITHOUT WARRANTY OF ANY
+ * KIND, EITHER EXPRESSED OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND/OR FITNESS FOR A
+ * PARTICULAR PURPOSE.
+ *
+ \****************************************************************************/
+
+#include <common/RoyaleTrace.hpp>
+#include <common/RoyaleLogger.hpp>
+
+#include <algorithm>
+#include <cstdlib>
+#include <fstream>
+#include <iomanip>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+using namespace royale::common;
+
+const std::size_t Tracer::EVENTS_PER_THREAD;
+const std::size_t Tracer::MAX_THREAD_BUFFERS;
+std::atomic<bool> Tracer::m_enabled (false);
+
+namespace
+{
+    struct TraceEvent
+    {
+        const char *name;
+        int64_t startNs;
+        int64_t endNs;
+    };
+
+    /**
+    * Written only by the owning thread.  The reader uses the written counter to find out which
+    * entries are valid.  The tid and finished flag are protected by the registry's lock.
+    */
+    struct ThreadBuffer
+    {
+        explicit ThreadBuffer (uint32_t id) :
+            tid (id),
+            name (nullptr),
+            events (Tracer::EVENTS_PER_THREAD),
+            written (0u),
+            finished (false)
+        {
+        }
+
+        uint32_t tid;
+        std::atomic<const char *> name;
+        std::vector<TraceEvent> events;
+        std::atomic<uint64_t> written;
+        bool finished;
+    };
+
+    /**
+    * Set when the registry is destroyed, threads that exit after this must not touch it.  This is
+    * trivially destructible, so it's still valid during and after static destruction.
+    */
+    std::atomic<bool> registryDestroyed (false);
+
+    struct Registry
+    {
+        Registry() :
+            nextTid (1u)
+        {
+        }
+
+        ~Registry()
+        {
+            registryDestroyed = true;
+        }
+
+        std::mutex lock;
+        std::vector<std::unique_ptr<ThreadBuffer>> buffers;
+        uint32_t nextTid;
+    };
+
+    Registry &registry()
+    {
+        static Registry instance;
+        return instance;
+    }
+
+    /**
+    * Returns a buffer for a new thread.  A new buffer is allocated while the limit hasn't been
+    * reached, otherwise the buffer of the thread that exited first is reused.  Returns nullptr if
+    * all buffers belong to running threads.
+    */
+    ThreadBuffer *acquireBuffer()
+    {
+        auto &reg = registry();
+        std::lock_guard<std::mutex> lock (reg.lock);
+        if (reg.buffers.size() < Tracer::MAX_THREAD_BUFFERS)
+        {
+            reg.buffers.emplace_back (new ThreadBuffer (reg.nextTid++));
+            return reg.buffers.back().get();
+        }
+
+        auto recycled = std::find_if (reg.buffers.begin(), reg.buffers.end(),
+                                      [] (const std::unique_ptr<ThreadBuffer> &buffer)
+        {
+            return buffer->finished;
+        });
+        if (recycled == reg.buffers.end())
+        {
+            return nullptr;
+        }
+
+        // Move it to the end, so that the buffers stay in the order in which they were acquired
+        std::rotate (recycled, recycled + 1, reg.buffers.end());
+        auto buffer = reg.buffers.back().get();
+        buffer->tid = reg.nextTid++;
+        buffer->name.store (nullptr, std::memory_order_relaxed);
+        buffer->written.store (0u, std::memory_order_release);
+        buffer->finished = false;
+        return buffer;
+    }
+
+    /**
+    * Called when the buffer's thread exits.
+    */
+    void releaseBuffer (ThreadBuffer *buffer)
+    {
+        auto &reg = registry();
+        std::lock_guard<std::mutex> lock (reg.lock);
+        if (buffer->written.load (std::memory_order_relaxed) == 0u)
+        {
+            reg.buffers.erase (std::find_if (reg.buffers.begin(), reg.buffers.end(),
+                                             [buffer] (const std::unique_ptr<ThreadBuffer> &b)
+            {
+                return b.get() == buffer;
+            }));
+        }
+        else
+        {
+            buffer->finished = true;
+        }
+    }
+
+    /**
+    * The calling thread's buffer, which is released when the thread exits.
+    */
+    struct ThreadBufferOwner
+    {
+        ThreadBufferOwner() :
+            buffer (nullptr),
+            name (nullptr),
+            unavailable (false)
+        {
+        }
+
+        ~ThreadBufferOwner()
+        {
+            if (buffer && !registryDestroyed)
+            {
+                releaseBuffer (buffer);
+            }
+        }
+
+        ThreadBuffer *buffer;
+        const char *name; //!< from setThreadName, copied to the buffer when it's acquired
+        bool unavailable; //!< true if acquireBuffer failed, it's not retried for this thread
+    };
+
+    thread_local ThreadBufferOwner threadBuffer;
+
+    ThreadBuffer *getThreadBuffer()
+    {
+        if (!threadBuffer.buffer && !threadBuffer.unavailable)
+        {
+            threadBuffer.buffer = acquireBuffer();
+            threadBuffer.unavailable = (threadBuffer.buffer == nullptr);
+            if (threadBuffer.buffer)
+            {
+                threadBuffer.buffer->name.store (threadBuffer.name, std::memory_order_release);
+            }
+        }
+        return threadBuffer.buffer;
+    }
+
+    bool writeTraceFile (const std::string &filename)
+    {
+        std::ofstream f (filename, std::ios_base::out | std::ios_base::trunc);
+        if (!f.is_open())
+        {
+            return false;
+        }
+        Tracer::writeChromeTrace (f);
+        return f.good();
+    }
+
+    void writeJsonString (std::ostream &os, const char *str)
+    {
+        os << '"';
+        for (; *str; ++str)
+        {
+            const char c = *str;
+            if (c == '"' || c == '\\')
+            {
+                os << '\\' << c;
+            }
+            else if (static_cast<unsigned char> (c) < 0x20)
+            {
+                os << ' ';
+            }
+            else
+            {
+                os << c;
+            }
+        }
+        os << '"';
+    }
+
+    /**
+    * The trace format uses microseconds, this keeps the nanosecond resolution without going
+    * through floating point.
+    */
+    void writeMicroseconds (std::ostream &os, int64_t ns)
+    {
+        if (ns < 0)
+        {
+            os << '-';
+            ns = -ns;
+        }
+        os << ns / 1000 << '.' << std::setw (3) << std::setfill ('0') << ns % 1000 << std::setfill (' ');
+    }
+
+#ifdef ROYALE_ENABLE_TRACING
+    /**
+    * Implements the ROYALE_TRACE_FILE environment variable.
+    */
+    class TraceFileSession
+    {
+    public:
+        TraceFileSession()
+        {
+            // Constructing the registry first means that it is destroyed after this object
+            registry();
+
+            const char *filename = std::getenv ("ROYALE_TRACE_FILE");
+            if (filename && *filename)
+            {
+                m_filename = filename;
+                Tracer::setEnabled (true);
+            }
+        }
+
+        ~TraceFileSession()
+        {
+            // The logger may already have been destroyed, so a failure can't be reported here
+            if (!m_filename.empty())
+            {
+                Tracer::setEnabled (false);
+                writeTraceFile (m_filename);
+            }
+        }
+
+    private:
+        std::string m_filename;
+    };
+
+    TraceFileSession traceFileSession;
+#endif
+}
+
+void Tracer::setEnabled (bool enabled)
+{
+    m_enabled.store (enabled, std::memory_order_relaxed);
+}
+
+void Tracer::setThreadName (const char *name)
+{
+    // The buffer is only acquired when the thread records its first zone, so that naming a thread
+    // while tracing is disabled doesn't allocate anything
+    threadBuffer.name = name;
+    if (threadBuffer.buffer)
+    {
+        threadBuffer.buffer->name.store (name, std::memory_order_release);
+    }
+}
+
+void Tracer::addZone (const char *name, int64_t startNs, int64_t endNs)
+{
+    auto buffer = getThreadBuffer();
+    if (!buffer)
+    {
+        return;
+    }
+    const auto index = buffer->written.load (std::memory_order_relaxed);
+    buffer->events[static_cast<std::size_t> (index % EVENTS_PER_THREAD)] = { name, startNs, endNs };
+    buffer->written.store (index + 1, std::memory_order_release);
+}
+
+void Tracer::clear()
+{
+    auto &reg = registry();
+    std::lock_guard<std::mutex> lock (reg.lock);
+    reg.buffers.erase (std::remove_if (reg.buffers.begin(), reg.buffers.end(),
+                                       [] (const std::unique_ptr<ThreadBuffer> &buffer)
+    {
+        return buffer->finished;
+    }), reg.buffers.end());
+    for (auto &buffer : reg.buffers)
+    {
+        buffer->written.store (0u, std::memory_order_release);
+    }
+}
+
+std::size_t Tracer::getBufferCount()
+{
+    auto &reg = registry();
+    std::lock_guard<std::mutex> lock (reg.lock);
+    return reg.buffers.size();
+}
+
+void Tracer::writeChromeTrace (std::ostream &os)
+{
+    auto &reg = registry();
+    std::lock_guard<std::mutex> lock (reg.lock);
+
+    // Use the first event as the time origin, the viewers don't cope well with uptime-based
+    // timestamps
+    int64_t origin = 0;
+    bool haveOrigin = false;
+    for (const auto &buffer : reg.buffers)
+    {
+        const auto written = buffer->written.load (std::memory_order_acquire);
+        const auto first = written > EVENTS_PER_THREAD ? written - EVENTS_PER_THREAD : 0u;
+        for (auto i = first; i < written; i++)
+        {
+            const auto start = buffer->events[static_cast<std::size_t> (i % EVENTS_PER_THREAD)].startNs;
+            if (!haveOrigin || start < origin)
+            {
+                origin = start;
+                haveOrigin = true;
+            }
+        }
+    }
+
+    os << "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[";
+    bool firstEvent = true;
+    auto separator = [&os, &firstEvent] ()
+    {
+        os << (firstEvent ? "\n" : ",\n");
+        firstEvent = false;
+    };
+
+    for (const auto &buffer : reg.buffers)
+    {
+        const char *name = buffer->name.load (std::memory_order_acquire);
+        if (name)
+        {
+            separator();
+            os << "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":" << buffer->tid << ",\"args\":{\"name\":";
+            writeJsonString (os, name);
+            os << "}}";
+        }
+
+        const auto written = buffer->written.load (std::memory_order_acquire);
+        const auto first = written > EVENTS_PER_THREAD ? written - EVENTS_PER_THREAD : 0u;
+        for (auto i = first; i < written; i++)
+        {
+            const auto &event = buffer->events[static_cast<std::size_t> (i % EVENTS_PER_THREAD)];
+            separator();
+            os << "{\"name\":";
+            writeJsonString (os, event.name);
+            os << ",\"ph\":\"X\",\"pid\":1,\"tid\":" << buffer->tid << ",\"ts\":";
+            writeMicroseconds (os, event.startNs - origin);
+            os << ",\"dur\":";
+            writeMicroseconds (os, event.endNs - event.startNs);
+            os << "}";
+        }
+    }
+    os << "\n]}\n";
+}
+
+bool Tracer::writeChromeTrace (const std::string &filename)
+{
+    if (!writeTraceFile (filename))
+    {
+        LOG (WARN) << "Can't write trace file " << filename;
+        return false;
+    }
+    return true;
+}
+
+std::vector<TraceZoneRecord> Tracer::getZones()
+{
+    auto &reg = registry();
+    std::lock_guard<std::mutex> lock (reg.lock);
+
+    std::vector<TraceZoneRecord> zones;
+    for (const auto &buffer : reg.buffers)
+    {
+        const auto written = buffer->written.load (std::memory_order_acquire);
+        const auto first = written > EVENTS_PER_THREAD ? written - EVENTS_PER_THREAD : 0u;
+        for (auto i = first; i < written; i++)
+        {
+            const auto &event = buffer->events[static_cast<std::size_t> (i % EVENTS_PER_THREAD)];
+            zones.push_back ({ event.name, buffer->tid, event.startNs, event.endNs });
+        }
+    }
+    return zones;
+}
@@ -0,0 +1,117 @@
+/****************************************************************************\
+* Copyright (C) 2019 pmdtechnologies ag
+*
+* THIS CODE AND INFORMATION ARE PROVIDED "AS IS" WITHOUT WARRANTY OF ANY
+* KIND, EITHER EXPRESSED OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE
+* IMPLIED WARRANTIES OF MERCHANTABILITY AND/OR FITNESS FOR A
+* PARTICULAR PURPOSE.
+*
+\****************************************************************************/
+
+
+#include <device/TemperatureSampler.hpp>
+#include <common/RoyaleLogger.hpp>
+#include <common/RoyaleTrace.hpp>
+
+
+using namespace royale::device;
+using namespace royale::common;
+
+
+TemperatureSampler::TemperatureSampler (std::shared_ptr<royale::hal::ITemperatureSensor> sensor,
+                                        std::chrono::milliseconds period)
+    : m_baseSensor (sensor),
+      m_period (period),
+      m_temperature (0.0f),
+      m_running (false)
+{
+}
+
+TemperatureSampler::~TemperatureSampler()
+{
+    stop();
+}
+
+void TemperatureSampler::start()
+{
+    std::lock_guard<std::mutex> threadLock (m_threadLock);
+    if (m_running)
+    {
+        return;
+    }
+
+    {
+        std::lock_guard<std::mutex> lock (m_sensorLock);
+        sample();
+    }
+
+    m_running = true;
+    m_samplingThread = std::thread (&TemperatureSampler::samplingFunction, this);
+}
+
+void TemperatureSampler::stop()
+{
+    {
+        std::lock_guard<std::mutex> threadLock (m_threadLock);
+        if (!m_running)
+        {
+            return;
+        }
+        m_running = false;
+    }
+    m_stopCV.notify_all();
+    m_samplingThread.join();
+}
+
+float TemperatureSampler::getTemperature()
+{
+    if (!m_running)
+    {
+        std::lock_guard<std::mutex> lock (m_sensorLock);
+        sample();
+    }
+
+    std::exception_ptr error;
+    {
+        std::lock_guard<std::mutex> lock (m_errorLock);
+        error = m_error;
+    }
+    if (error)
+    {
+        std::rethrow_exception (error);
+    }
+    return m_temperature;
+}
+
+void TemperatureSampler::sample()
+{
+    std::exception_ptr error;
+    try
+    {
+        m_temperature = m_baseSensor->getTemperature();
+    }
+    catch (const std::exception &e)
+    {
+        // The failure is reported to the caller of getTemperature(), and the next sample retries
+        LOG (DEBUG) << "Reading the temperature sensor failed: " << e.what();
+        error = std::current_exception();
+    }
+
+    std::lock_guard<std::mutex> lock (m_errorLock);
+    m_error = error;
+}
+
+void TemperatureSampler::samplingFunction()
+{
+    ROYALE_TRACE_THREAD_NAME ("TemperatureSampler");
+    std::unique_lock<std::mutex> threadLock (m_threadLock);
+    while (!m_stopCV.wait_for (threadLock, m_period, [this] { return !m_running; }))
+    {
+        threadLock.unlock();
+        {
+            std::lock_guard<std::mutex> lock (m_sensorLock);
+            sample();
+        }
+        threadLock.lock();
+    }
+}
@@ -0,0 +1,134 @@
+/****************************************************************************\
+* Copyright (C) 2019 pmdtechnologies ag
+*
+* THIS CODE AND INFORMATION ARE PROVIDED "AS IS" WITHOUT WARRANTY OF ANY
+* KIND, EITHER EXPRESSED OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE
+* IMPLIED WARRANTIES OF MERCHANTABILITY AND/OR FITNESS FOR A
+* PARTICULAR PURPOSE.
+*
+\****************************************************************************/
+
+#include <royale/VectorAllocator.hpp>
+
+#include <atomic>
+#include <mutex>
+
+using namespace royale;
+
+namespace
+{
+    /**
+    * The allocator installed with setVectorAllocator().  hasAllocator is only true while
+    * allocator is set, so that the default allocations don't need to take the lock.
+    */
+    struct VectorAllocatorHolder
+    {
+        ~VectorAllocatorHolder()
+        {
+            // Vectors with static storage duration may still be allocated after this, they
+            // get buffers from new[].  Existing buffers keep their own allocator.
+            hasAllocator = false;
+        }
+
+        std::atomic<bool> hasAllocator {false};
+        std::mutex lock;
+        std::shared_ptr<IVectorAllocator> allocator;
+    };
+
+    VectorAllocatorHolder &vectorAllocatorHolder()
+    {
+        static VectorAllocatorHolder holder;
+        return holder;
+    }
+
+    /**
+    * Deleter of a royale::Vector buffer, which returns it to the allocator it came from.
+    */
+    struct VectorBufferDeleter
+    {
+        std::shared_ptr<IVectorAllocator> allocator;
+        std::size_t bytes;
+
+        void operator() (char *block) const
+        {
+            allocator->deallocate (block, bytes);
+        }
+    };
+
+    /**
+    * Allocator for the shared_ptr's control block, so that a buffer from a pool doesn't still
+    * need a heap allocation for its reference count.
+    */
+    template<typename U>
+    struct VectorControlBlockAllocator
+    {
+        using value_type = U;
+
+        explicit VectorControlBlockAllocator (std::shared_ptr<IVectorAllocator> a) :
+            allocator (std::move (a))
+        {
+        }
+
+        template<typename V>
+        VectorControlBlockAllocator (const VectorControlBlockAllocator<V> &other) :
+            allocator (other.allocator)
+        {
+        }
+
+        U *allocate (std::size_t n)
+        {
+            return static_cast<U *> (allocator->allocate (n * sizeof (U)));
+        }
+
+        void deallocate (U *block, std::size_t n)
+        {
+            allocator->deallocate (block, n * sizeof (U));
+        }
+
+        template<typename V>
+        bool operator== (const VectorControlBlockAllocator<V> &other) const
+        {
+            return allocator == other.allocator;
+        }
+
+        template<typename V>
+        bool operator!= (const VectorControlBlockAllocator<V> &other) const
+        {
+            return allocator != other.allocator;
+        }
+
+        std::shared_ptr<IVectorAllocator> allocator;
+    };
+}
+
+std::shared_ptr<IVectorAllocator> royale::getVectorAllocator()
+{
+    auto &holder = vectorAllocatorHolder();
+    if (!holder.hasAllocator)
+    {
+        return nullptr;
+    }
+    std::lock_guard<std::mutex> lock (holder.lock);
+    return holder.allocator;
+}
+
+void royale::setVectorAllocator (std::shared_ptr<IVectorAllocator> allocator)
+{
+    auto &holder = vectorAllocatorHolder();
+    std::lock_guard<std::mutex> lock (holder.lock);
+    holder.allocator.swap (allocator);
+    holder.hasAllocator = holder.allocator != nullptr;
+}
+
+std::shared_ptr<char> royale::detail::allocateVectorBuffer (std::size_t bytes)
+{
+    auto allocator = getVectorAllocator();
+    if (allocator == nullptr)
+    {
+        return std::shared_ptr<char> (new char[bytes], std::default_delete<char[]>());
+    }
+    auto block = static_cast<char *> (allocator->allocate (bytes));
+    // If the control block can't be allocated, the shared_ptr constructor calls the deleter
+    return std::shared_ptr<char> (block, VectorBufferDeleter {allocator, bytes},
+                                  VectorControlBlockAllocator<char> (allocator));
+}
@@ -0,0 +1,92 @@
+/****************************************************************************\
+ * Copyright (C) 2017 Infineon Technologies
+ *
+ * THIS CODE AND INFORMATION ARE PROVIDED "AS IS" WITHOUT WARRANTY OF ANY
+ * KIND, EITHER EXPRESSED OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND/OR FITNESS FOR A
+ * PARTICULAR PURPOSE.
+ *
+\****************************************************************************/
+
+#pragma once
+
+#include <config/ICoreConfig.hpp>
+
+namespace royale
+{
+    namespace stub
+    {
+        namespace config
+        {
+            /**
+             * Core config for a module with the given maximum image size and use cases.
+             */
+            class StubCoreConfig : public royale::config::ICoreConfig
+            {
+            public:
+                StubCoreConfig (uint16_t width, uint16_t height, const royale::usecase::UseCaseList &useCaseList) :
+                    m_width (width),
+                    m_height (height),
+                    m_useCaseList (useCaseList)
+                {
+                }
+
+                void getLensCenterDesign (uint16_t &column, uint16_t &row) const override
+                {
+                    column = m_width / 2;
+                    row = m_height / 2;
+                }
+
+                uint16_t getMaxImageWidth() const override
+                {
+                    return m_width;
+                }
+
+                uint16_t getMaxImageHeight() const override
+                {
+                    return m_height;
+                }
+
+                const royale::usecase::UseCaseList &getSupportedUseCases() const override
+                {
+                    return m_useCaseList;
+                }
+
+                royale::config::FrameTransmissionMode getFrameTransmissionMode() const override
+                {
+                    return royale::config::FrameTransmissionMode::SUPERFRAME;
+                }
+
+                royale::String getCameraName() const override
+                {
+                    return "TestConfig";
+                }
+
+                float getTemperatureLimitSoft() const override
+                {
+                    return 60.f;
+                }
+
+                float getTemperatureLimitHard() const override
+                {
+                    return 65.f;
+                }
+
+                bool isAutoExposureSupported() const override
+                {
+                    return false;
+                }
+
+                royale::config::BandwidthRequirementCategory getBandwidthRequirementCategory() const override
+                {
+                    return royale::config::BandwidthRequirementCategory::NO_THROTTLING;
+                }
+
+            private:
+                const uint16_t m_width;
+                const uint16_t m_height;
+                const royale::usecase::UseCaseList m_useCaseList;
+            };
+        }
+    }
+}
@@ -0,0 +1,163 @@
+/****************************************************************************\
+ * Copyright (C) 2017 Infineon Technologies
+ *
+ * THIS CODE AND INFORMATION ARE PROVIDED "AS IS" WITHOUT WARRANTY OF ANY
+ * KIND, EITHER EXPRESSED OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND/OR FITNESS FOR A
+ * PARTICULAR PURPOSE.
+ *
+\****************************************************************************/
+
+#pragma once
+
+#include <common/exceptions/NotImplemented.hpp>
+#include <common/MakeUnique.hpp>
+#include <common/PseudoDataTwelveBitCalculator.hpp>
+#include <hal/IImager.hpp>
+
+#include <atomic>
+
+namespace royale
+{
+    namespace stub
+    {
+        namespace hal
+        {
+            /**
+             * Pseudo data interpreter for the StubImager, which only supports the methods that
+             * the CameraCore calls when it's created.
+             */
+            class StubImagerPDI : public royale::common::PseudoDataTwelveBitCalculator
+            {
+            public:
+                const uint16_t MIN_WIDTH = 20; // arbitrary value
+
+                royale::common::IPseudoDataInterpreter *clone() override
+                {
+                    return new StubImagerPDI (*this);
+                }
+
+                uint16_t getFrameNumber (const royale::common::ICapturedRawFrame &frame) const override
+                {
+                    throw royale::common::NotImplemented();
+                }
+                uint16_t getReconfigIndex (const royale::common::ICapturedRawFrame &frame) const override
+                {
+                    throw royale::common::NotImplemented();
+                }
+                uint16_t getSequenceIndex (const royale::common::ICapturedRawFrame &frame) const override
+                {
+                    throw royale::common::NotImplemented();
+                }
+                uint8_t getBinning (const royale::common::ICapturedRawFrame &frame) const override
+                {
+                    throw royale::common::NotImplemented();
+                }
+                uint16_t getHorizontalSize (const royale::common::ICapturedRawFrame &frame) const override
+                {
+                    throw royale::common::NotImplemented();
+                }
+                uint16_t getVerticalSize (const royale::common::ICapturedRawFrame &frame) const override
+                {
+                    throw royale::common::NotImplemented();
+                }
+                float getImagerTemperature (const royale::common::ICapturedRawFrame &frame) const override
+                {
+                    throw royale::common::NotImplemented();
+                }
+                std::vector<uint16_t> getTemperatureRawValues (const royale::common::ICapturedRawFrame &) const override
+                {
+                    throw royale::common::NotImplemented ("Not supported");
+                }
+                uint16_t getRequiredImageWidth() const override
+                {
+                    return MIN_WIDTH;
+                }
+                void getEyeSafetyError (const royale::common::ICapturedRawFrame &frame, uint32_t &eyeError) const override
+                {
+                    eyeError = 0u;
+                }
+                bool supportsExposureFromPseudoData() const override
+                {
+                    return false;
+                }
+                uint32_t getExposureTime (const royale::common::ICapturedRawFrame &frame, uint32_t modulationFrequency)  const override
+                {
+                    throw royale::common::NotImplemented();
+                }
+            };
+
+            /**
+             * Imager which accepts every use case, and counts how often the capturing is started
+             * and stopped.  Accessing the registers throws NotImplemented.
+             */
+            class StubImager : public royale::hal::IImager
+            {
+            public:
+                void wake() override
+                {
+                }
+                void initialize() override
+                {
+                }
+                void startCapture() override
+                {
+                    ++m_startCount;
+                }
+                void reconfigureExposureTimes (const std::vector<uint32_t> &exposureTimes, uint16_t &reconfigIndex) override
+                {
+                    reconfigIndex = 0u;
+                }
+                void reconfigureTargetFrameRate (uint16_t targetFrameRate, uint16_t &reconfigIndex) override
+                {
+                    reconfigIndex = 0u;
+                }
+                void stopCapture() override
+                {
+                    ++m_stopCount;
+                }
+                void sleep() override
+                {
+                }
+                royale::usecase::VerificationStatus verifyUseCase (const royale::usecase::UseCaseDefinition &useCase, uint16_t roiCMin, uint16_t roiRMin, uint16_t flowControlRate) override
+                {
+                    return royale::usecase::VerificationStatus::SUCCESS;
+                }
+                void executeUseCase (const royale::usecase::UseCaseDefinition &useCase, uint16_t roiCMin, uint16_t roiRMin, uint16_t flowControlRate) override
+                {
+                    m_rawFrameCount = useCase.getRawFrameCount();
+                }
+                royale::Vector<std::size_t> getMeasurementBlockSizes() const override
+                {
+                    return { m_rawFrameCount };
+                }
+                std::string getSerialNumber() override
+                {
+                    return "0000-0000-0000-0000";
+                }
+                std::unique_ptr<royale::common::IPseudoDataInterpreter> createPseudoDataInterpreter() override
+                {
+                    return royale::common::makeUnique<StubImagerPDI>();
+                }
+                void writeRegisters (const royale::Vector<royale::Pair<royale::String, uint64_t>> &registers) override
+                {
+                    throw royale::common::NotImplemented();
+                }
+                void readRegisters (royale::Vector<royale::Pair<royale::String, uint64_t>> &registers) override
+                {
+                    throw royale::common::NotImplemented();
+                }
+                void setExternalTrigger (bool useExternalTrigger) override
+                {
+                    throw royale::common::NotImplemented();
+                }
+
+                std::atomic<std::size_t> m_startCount {0u};
+                std::atomic<std::size_t> m_stopCount {0u};
+
+            private:
+                std::size_t m_rawFrameCount = 0u;
+            };
+        }
+    }
+}
@@ -0,0 +1,65 @@
+/****************************************************************************\
+ * Copyright (C) 2017 Infineon Technologies
+ *
+ * THIS CODE AND INFORMATION ARE PROVIDED "AS IS" WITHOUT WARRANTY OF ANY
+ * KIND, EITHER EXPRESSED OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND/OR FITNESS FOR A
+ * PARTICULAR PURPOSE.
+ *
+\****************************************************************************/
+
+#pragma once
+
+#include <common/exceptions/NotImplemented.hpp>
+#include <hal/INonVolatileStorage.hpp>
+
+namespace royale
+{
+    namespace stub
+    {
+        namespace hal
+        {
+            /**
+             * Storage which only holds calibration data, which can be set by the test.  Everything
+             * else throws NotImplemented.
+             */
+            class StubStorage : public royale::hal::INonVolatileStorage
+            {
+            public:
+                royale::Vector<uint8_t> getModuleIdentifier() override
+                {
+                    throw royale::common::NotImplemented();
+                }
+                royale::String getModuleSuffix() override
+                {
+                    throw royale::common::NotImplemented();
+                }
+                royale::String getModuleSerialNumber() override
+                {
+                    throw royale::common::NotImplemented();
+                }
+                royale::Vector<uint8_t> getCalibrationData() override
+                {
+                    return m_calibrationData;
+                }
+                uint32_t getCalibrationDataChecksum() override
+                {
+                    throw royale::common::NotImplemented();
+                }
+                void writeCalibrationData (const royale::Vector<uint8_t> &data) override
+                {
+                    throw royale::common::NotImplemented();
+                }
+                void writeCalibrationData (const royale::Vector<uint8_t> &calibrationData,
+                                           const royale::Vector<uint8_t> &identifier,
+                                           const royale::String &suffix,
+                                           const royale::String &serialNumber) override
+                {
+                    throw royale::common::NotImplemented();
+                }
+
+                royale::Vector<uint8_t> m_calibrationData;
+            };
+        }
+    }
+}
@@ -20,6 +20,9 @@
 #include <common/MakeUnique.hpp>
 #include <royale/CameraAccessLevel.hpp>
 
+#include <atomic>
+#include <thread>
+
 using namespace royale;
 using namespace royale::common;
 using namespace royale::config;
@@ -207,12 +210,26 @@ namespace
 
     class TestTemperatureSensor : public hal::ITemperatureSensor
     {
+    public:
+        /**
+         * Reads on the thread that created the sensor, reads from the FC conveyance thread aren't
+         * counted
+         */
+        std::atomic<unsigned> m_reads {0u};
+
+    private:
         float getTemperature() override
         {
             // This may get called from the FC conveyance thread even without capturing active
+            if (std::this_thread::get_id() == m_thread)
+            {
+                ++m_reads;
+            }
             return 15.f; // ICAO ISA MSL temperature
         }
 
+        const std::thread::id m_thread = std::this_thread::get_id();
+
     }; // class TestTemperatureSensor
 
     class TestStorage : public hal::INonVolatileStorage
@@ -355,3 +372,32 @@ TEST (TestCameraCore, InvalidImageWidth)
     // ...and check.
     EXPECT_EQ (core->verifyUseCase (ucd.get()), VerificationStatus::REGION);
 }
+
+/**
+ * If the imager can't start, the temperature sampler isn't started either, and isn't left
+ * reading the sensor without a capture.
+ */
+TEST (TestCameraCore, StartCaptureFailureLeavesSamplerStopped)
+{
+    royale::Vector<royale::ProcessingParameterMap> ppMap{ {} };
+    auto ucd = std::make_shared<UseCaseDefinition> (UseCaseFourPhase (5, 30000000, { 50u, 1000u }, 1000u, 0));
+    ucd->setImage (48, 96);
+    UseCaseList ucList {UseCase ("testcase", ucd, ppMap) };
+    auto coreConfig = std::make_shared<TestCoreConfig> (96, 96, ucList);
+
+    auto tempSensor = std::make_shared<TestTemperatureSensor>();
+    auto core = makeUnique< royale::device::CameraCore > (
+                    coreConfig,
+                    std::make_shared<TestImager>(),
+                    std::make_shared<TestBridgeDataReceiver>(),
+                    tempSensor,
+                    std::make_shared<TestStorage>(),
+                    nullptr,
+                    nullptr,
+                    royale::CameraAccessLevel::L1);
+
+    // A started sampler would have read the sensor once in startCapture()
+    EXPECT_THROW (core->startCapture(), NotImplemented);
+    EXPECT_FALSE (core->isCapturing());
+    EXPECT_EQ (0u, tempSensor->m_reads.load());
+}
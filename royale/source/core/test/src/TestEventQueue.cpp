@@ -1,10 +1,83 @@
 #include <common/EventQueue.hpp>
+#include <common/events/EventFrameDropped.hpp>
+#include <common/events/EventRawFrameStats.hpp>
 #include <royale/IEvent.hpp>
 #include <royale/IEventListener.hpp>
 #include <gtest/gtest.h>
 
+#include <condition_variable>
+#include <mutex>
+#include <vector>
+
 using namespace royale;
 
+namespace
+{
+    class TeqEvent : public royale::IEvent
+    {
+    public:
+        explicit TeqEvent (royale::EventSeverity severity = royale::EventSeverity::ROYALE_INFO) :
+            m_severity (severity)
+        {
+        }
+
+        royale::EventSeverity severity() const override
+        {
+            return m_severity;
+        }
+
+        const royale::String describe() const override
+        {
+            return royale::String();
+        }
+
+        royale::EventType type() const override
+        {
+            return royale::EventType::ROYALE_CAPTURE_STREAM;
+        }
+
+    private:
+        royale::EventSeverity m_severity;
+    };
+
+    /**
+     * Keeps the received events.  The first callback blocks until release() is called, so that
+     * the test can fill the queue while the notifier thread is busy.
+     */
+    class BlockingListener : public royale::IEventListener
+    {
+    public:
+        void onEvent (std::unique_ptr<royale::IEvent> &&event) override
+        {
+            std::unique_lock<std::mutex> lock (m_mutex);
+            m_events.push_back (std::move (event));
+            m_cond.notify_all();
+            m_cond.wait (lock, [this] { return m_released; });
+        }
+
+        /** Waits until the notifier thread is in the first callback */
+        void waitForFirstEvent()
+        {
+            std::unique_lock<std::mutex> lock (m_mutex);
+            m_cond.wait (lock, [this] { return !m_events.empty(); });
+        }
+
+        void release()
+        {
+            std::lock_guard<std::mutex> lock (m_mutex);
+            m_released = true;
+            m_cond.notify_all();
+        }
+
+        std::vector<std::unique_ptr<royale::IEvent>> m_events;
+
+    private:
+        std::mutex m_mutex;
+        std::condition_variable m_cond;
+        bool m_released = false;
+    };
+}
+
 /** Testing register/unregister */
 TEST (TestEventQueue, RegUnreg)
 {
@@ -72,3 +145,85 @@ TEST (TestEventQueue, RegUnreg)
 
 }
 
+/**
+ * Consecutive frame drops and frame statistics are delivered as one event each, while the order
+ * of the different events is kept.
+ */
+TEST (TestEventQueue, CoalesceRepetitiveEvents)
+{
+    EventQueue eventQueue;
+    BlockingListener listener;
+    eventQueue.setEventListener (&listener);
+
+    eventQueue.onEvent (std::unique_ptr<royale::IEvent> (new TeqEvent()));
+    listener.waitForFirstEvent();
+
+    for (auto i = 0; i < 10; ++i)
+    {
+        eventQueue.onEvent (std::unique_ptr<royale::IEvent> (new event::EventFrameDropped (1u)));
+    }
+    eventQueue.onEvent (std::unique_ptr<royale::IEvent> (new event::EventRawFrameStats (100u, 4u, 6u)));
+    eventQueue.onEvent (std::unique_ptr<royale::IEvent> (new event::EventRawFrameStats (50u, 0u, 1u)));
+    eventQueue.onEvent (std::unique_ptr<royale::IEvent> (new event::EventFrameDropped (2u)));
+    eventQueue.onEvent (std::unique_ptr<royale::IEvent> (new TeqEvent()));
+    eventQueue.onEvent (std::unique_ptr<royale::IEvent> (new event::EventFrameDropped (3u)));
+
+    listener.release();
+    eventQueue.sync();
+    eventQueue.setEventListener (nullptr);
+
+    ASSERT_EQ (6u, listener.m_events.size());
+    EXPECT_EQ (EventType::ROYALE_CAPTURE_STREAM, listener.m_events[0]->type());
+
+    auto dropped = dynamic_cast<event::EventFrameDropped *> (listener.m_events[1].get());
+    ASSERT_NE (nullptr, dropped);
+    EXPECT_EQ (10u, dropped->getNrOfFramesDropped());
+
+    auto stats = dynamic_cast<event::EventRawFrameStats *> (listener.m_events[2].get());
+    ASSERT_NE (nullptr, stats);
+    EXPECT_EQ (150u, stats->m_totalFrames);
+    EXPECT_EQ (4u, stats->m_frameDropsBridge);
+    EXPECT_EQ (7u, stats->m_frameDropsCollector);
+
+    dropped = dynamic_cast<event::EventFrameDropped *> (listener.m_events[3].get());
+    ASSERT_NE (nullptr, dropped);
+    EXPECT_EQ (2u, dropped->getNrOfFramesDropped());
+
+    // Events of other types separate the frame drops
+    EXPECT_EQ (EventType::ROYALE_CAPTURE_STREAM, listener.m_events[4]->type());
+    dropped = dynamic_cast<event::EventFrameDropped *> (listener.m_events[5].get());
+    ASSERT_NE (nullptr, dropped);
+    EXPECT_EQ (3u, dropped->getNrOfFramesDropped());
+}
+
+/**
+ * When the listener doesn't keep up, the queue is limited to MAX_QUEUED_EVENTS, but errors are
+ * still delivered.
+ */
+TEST (TestEventQueue, BoundedQueue)
+{
+    EventQueue eventQueue;
+    BlockingListener listener;
+    eventQueue.setEventListener (&listener);
+
+    eventQueue.onEvent (std::unique_ptr<royale::IEvent> (new TeqEvent()));
+    listener.waitForFirstEvent();
+
+    for (auto i = 0u; i < EventQueue::MAX_QUEUED_EVENTS + 10u; ++i)
+    {
+        eventQueue.onEvent (std::unique_ptr<royale::IEvent> (new TeqEvent()));
+    }
+    eventQueue.onEvent (std::unique_ptr<royale::IEvent> (new TeqEvent (EventSeverity::ROYALE_ERROR)));
+
+    listener.release();
+    eventQueue.sync();
+
+    ASSERT_EQ (EventQueue::MAX_QUEUED_EVENTS + 2u, listener.m_events.size());
+    EXPECT_EQ (EventSeverity::ROYALE_ERROR, listener.m_events.back()->severity());
+
+    // Once the queue has been emptied, events are accepted again
+    eventQueue.onEvent (std::unique_ptr<royale::IEvent> (new TeqEvent()));
+    eventQueue.sync();
+    EXPECT_EQ (EventQueue::MAX_QUEUED_EVENTS + 3u, listener.m_events.size());
+    eventQueue.setEventListener (nullptr);
+}
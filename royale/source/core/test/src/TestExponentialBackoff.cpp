@@ -0,0 +1,64 @@
+/****************************************************************************\
+* Copyright (C) 2019 pmdtechnologies ag
+*
+* THIS CODE AND INFORMATION ARE PROVIDED "AS IS" WITHOUT WARRANTY OF ANY
+* KIND, EITHER EXPRESSED OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE
+* IMPLIED WARRANTIES OF MERCHANTABILITY AND/OR FITNESS FOR A
+* PARTICULAR PURPOSE.
+*
+\****************************************************************************/
+
+#include <gtest/gtest.h>
+#include <common/ExponentialBackoff.hpp>
+
+#include <vector>
+
+using namespace royale::common;
+using std::chrono::microseconds;
+
+namespace
+{
+    std::vector<microseconds::rep> allDelays (ExponentialBackoff &backoff)
+    {
+        std::vector<microseconds::rep> delays;
+        microseconds delay;
+        while (backoff.next (delay))
+        {
+            delays.push_back (delay.count());
+        }
+        return delays;
+    }
+}
+
+TEST (TestExponentialBackoff, DoublesUpToMaximum)
+{
+    ExponentialBackoff backoff (microseconds (10), microseconds (80), microseconds (320));
+    const std::vector<microseconds::rep> expected { 10, 20, 40, 80, 80, 80, 10 };
+    EXPECT_EQ (expected, allDelays (backoff));
+    EXPECT_EQ (microseconds (320), backoff.elapsed());
+}
+
+TEST (TestExponentialBackoff, StopsAtTimeout)
+{
+    ExponentialBackoff backoff (microseconds (100), microseconds (1000), microseconds (250));
+    const std::vector<microseconds::rep> expected { 100, 150 };
+    EXPECT_EQ (expected, allDelays (backoff));
+
+    // Once the timeout is reached, it stays reached
+    microseconds delay (7);
+    EXPECT_FALSE (backoff.next (delay));
+    EXPECT_EQ (microseconds (7), delay);
+}
+
+TEST (TestExponentialBackoff, ZeroInitialDelayStillMakesProgress)
+{
+    ExponentialBackoff backoff (microseconds (0), microseconds (4), microseconds (10));
+    const std::vector<microseconds::rep> expected { 1, 2, 4, 3 };
+    EXPECT_EQ (expected, allDelays (backoff));
+}
+
+TEST (TestExponentialBackoff, ZeroTimeout)
+{
+    ExponentialBackoff backoff (microseconds (10), microseconds (80), microseconds (0));
+    EXPECT_TRUE (allDelays (backoff).empty());
+}
@@ -0,0 +1,245 @@
+/****************************************************************************\
+ * Copyright (C) 2019 pmdtechnologies ag
+ *
+ * THIS CODE AND INFORMATION ARE PROVIDED "AS IS" WITHOUT WARRANTY OF ANY
+ * KIND, EITHER EXPRESSED OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND/OR FITNESS FOR A
+ * PARTICULAR PURPOSE.
+ *
+ \****************************************************************************/
+
+#include <gtest/gtest.h>
+#include <common/RoyaleTrace.hpp>
+
+#include <sstream>
+#include <string>
+#include <thread>
+
+using namespace royale::common;
+
+namespace
+{
+    class TestRoyaleTrace : public ::testing::Test
+    {
+    protected:
+        void SetUp() override
+        {
+            Tracer::clear();
+            Tracer::setEnabled (true);
+        }
+
+        void TearDown() override
+        {
+            Tracer::setEnabled (false);
+            Tracer::clear();
+        }
+
+        static std::string exportTrace()
+        {
+            std::stringstream ss;
+            Tracer::writeChromeTrace (ss);
+            return ss.str();
+        }
+
+        static std::size_t countOccurrences (const std::string &haystack, const std::string &needle)
+        {
+            std::size_t count = 0;
+            for (auto pos = haystack.find (needle); pos != std::string::npos; pos = haystack.find (needle, pos + 1))
+            {
+                count++;
+            }
+            return count;
+        }
+    };
+}
+
+TEST_F (TestRoyaleTrace, NestedZones)
+{
+    {
+        TraceZone outer ("outer");
+        {
+            TraceZone inner ("inner");
+        }
+    }
+
+    const auto trace = exportTrace();
+    EXPECT_EQ (0u, trace.find ("{\"displayTimeUnit\":\"ms\",\"traceEvents\":["));
+    EXPECT_EQ (1u, countOccurrences (trace, "\"name\":\"outer\",\"ph\":\"X\""));
+    EXPECT_EQ (1u, countOccurrences (trace, "\"name\":\"inner\",\"ph\":\"X\""));
+
+    // The inner zone finishes first, so it's recorded first
+    EXPECT_LT (trace.find ("\"inner\""), trace.find ("\"outer\""));
+}
+
+TEST_F (TestRoyaleTrace, DisabledRecordsNothing)
+{
+    Tracer::setEnabled (false);
+    {
+        TraceZone zone ("disabled");
+    }
+    Tracer::setEnabled (true);
+
+    EXPECT_EQ (0u, countOccurrences (exportTrace(), "\"disabled\""));
+}
+
+TEST_F (TestRoyaleTrace, ThreadsAreSeparated)
+{
+    std::thread worker ([]
+    {
+        Tracer::setThreadName ("worker \"1\"");
+        TraceZone zone ("work");
+    });
+    worker.join();
+    {
+        TraceZone zone ("main");
+    }
+
+    const auto trace = exportTrace();
+    EXPECT_EQ (1u, countOccurrences (trace, "\"args\":{\"name\":\"worker \\\"1\\\"\"}"));
+
+    // The worker's zone is still exported after the thread has finished, with its own tid
+    auto tidOf = [&trace] (const std::string & name) -> std::string
+    {
+        const auto event = trace.find ("\"name\":\"" + name + "\"");
+        const auto tid = trace.find ("\"tid\":", event);
+        return trace.substr (tid, trace.find (',', tid) - tid);
+    };
+    EXPECT_NE (tidOf ("work"), tidOf ("main"));
+}
+
+TEST_F (TestRoyaleTrace, RingBufferKeepsNewest)
+{
+    for (std::size_t i = 0; i < Tracer::EVENTS_PER_THREAD; i++)
+    {
+        Tracer::addZone ("old", 0, 1);
+    }
+    Tracer::addZone ("new", 2, 3);
+
+    const auto trace = exportTrace();
+    EXPECT_EQ (Tracer::EVENTS_PER_THREAD - 1, countOccurrences (trace, "\"old\""));
+    EXPECT_EQ (1u, countOccurrences (trace, "\"new\""));
+}
+
+TEST_F (TestRoyaleTrace, Timestamps)
+{
+    Tracer::addZone ("zone", 1000, 3500);
+    Tracer::addZone ("later", 2001000, 2001001);
+
+    const auto trace = exportTrace();
+    EXPECT_NE (std::string::npos, trace.find ("\"name\":\"zone\",\"ph\":\"X\",\"pid\":1,"));
+    EXPECT_NE (std::string::npos, trace.find ("\"ts\":0.000,\"dur\":2.500}"));
+    EXPECT_NE (std::string::npos, trace.find ("\"ts\":2000.000,\"dur\":0.001}"));
+}
+
+TEST_F (TestRoyaleTrace, GetZones)
+{
+    Tracer::addZone ("first", 10, 20);
+    std::thread worker ([]
+    {
+        Tracer::addZone ("worker", 15, 25);
+    });
+    worker.join();
+    Tracer::addZone ("second", 30, 40);
+
+    const auto zones = Tracer::getZones();
+    ASSERT_EQ (3u, zones.size());
+
+    const TraceZoneRecord *first = nullptr;
+    const TraceZoneRecord *second = nullptr;
+    const TraceZoneRecord *work = nullptr;
+    for (const auto &zone : zones)
+    {
+        const std::string name (zone.name);
+        if (name == "first")
+        {
+            first = &zone;
+        }
+        else if (name == "second")
+        {
+            second = &zone;
+        }
+        else if (name == "worker")
+        {
+            work = &zone;
+        }
+    }
+    ASSERT_NE (nullptr, first);
+    ASSERT_NE (nullptr, second);
+    ASSERT_NE (nullptr, work);
+
+    EXPECT_EQ (10, first->startNs);
+    EXPECT_EQ (20, first->endNs);
+    EXPECT_EQ (first->threadId, second->threadId);
+    EXPECT_NE (first->threadId, work->threadId);
+    EXPECT_LT (first, second);
+}
+
+TEST_F (TestRoyaleTrace, MacroMatchesBuildOption)
+{
+    {
+        ROYALE_TRACE_ZONE ("macro");
+    }
+
+#ifdef ROYALE_ENABLE_TRACING
+    EXPECT_EQ (1u, countOccurrences (exportTrace(), "\"macro\""));
+#else
+    EXPECT_EQ (0u, countOccurrences (exportTrace(), "\"macro\""));
+#endif
+}
+
+TEST_F (TestRoyaleTrace, ThreadWithoutZonesIsFreed)
+{
+    const auto buffers = Tracer::getBufferCount();
+    std::thread worker ([]
+    {
+        Tracer::setThreadName ("idle");
+    });
+    worker.join();
+
+    EXPECT_EQ (buffers, Tracer::getBufferCount());
+    EXPECT_EQ (0u, countOccurrences (exportTrace(), "\"idle\""));
+}
+
+TEST_F (TestRoyaleTrace, ThreadNameDoesNotAllocate)
+{
+    Tracer::setEnabled (false);
+    const auto buffers = Tracer::getBufferCount();
+    std::size_t buffersWhileNamed = 0u;
+    std::thread worker ([&buffersWhileNamed]
+    {
+        Tracer::setThreadName ("named");
+        buffersWhileNamed = Tracer::getBufferCount();
+        Tracer::setEnabled (true);
+        Tracer::addZone ("afterName", 0, 1);
+    });
+    worker.join();
+    EXPECT_EQ (buffers, buffersWhileNamed);
+
+    // The name is still applied when the thread's buffer is acquired later
+    const auto trace = exportTrace();
+    EXPECT_EQ (1u, countOccurrences (trace, "\"afterName\""));
+    EXPECT_EQ (1u, countOccurrences (trace, "\"named\""));
+}
+
+TEST_F (TestRoyaleTrace, FinishedThreadsAreRecycled)
+{
+    // More threads than buffers, one after another, so that each can reuse a finished one
+    const auto threadCount = Tracer::MAX_THREAD_BUFFERS + 4u;
+    for (std::size_t i = 0; i < threadCount; i++)
+    {
+        std::thread worker ([i, threadCount]
+        {
+            Tracer::addZone (i + 1 == threadCount ? "last" : "work", 0, 1);
+        });
+        worker.join();
+    }
+
+    EXPECT_LE (Tracer::getBufferCount(), Tracer::MAX_THREAD_BUFFERS);
+    const auto trace = exportTrace();
+    EXPECT_EQ (1u, countOccurrences (trace, "\"last\""));
+    EXPECT_GE (Tracer::MAX_THREAD_BUFFERS - 1, countOccurrences (trace, "\"work\""));
+
+    // The buffers of the finished threads are freed, only the main thread's can remain
+    Tracer::clear();
+    EXPECT_LE (Tracer::getBufferCount(), 1u);
+}
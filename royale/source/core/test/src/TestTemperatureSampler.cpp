@@ -0,0 +1,257 @@
+/****************************************************************************\
+* Copyright (C) 2019 pmdtechnologies ag
+*
+* THIS CODE AND INFORMATION ARE PROVIDED "AS IS" WITHOUT WARRANTY OF ANY
+* KIND, EITHER EXPRESSED OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE
+* IMPLIED WARRANTIES OF MERCHANTABILITY AND/OR FITNESS FOR A
+* PARTICULAR PURPOSE.
+*
+\****************************************************************************/
+#include <device/TemperatureSampler.hpp>
+#include <device/PsdTemperatureSampler.hpp>
+#include <common/exceptions/Disconnected.hpp>
+#include <common/exceptions/RuntimeError.hpp>
+#include <MockRawFrame.hpp>
+#include <gmock/gmock.h>
+
+#include <atomic>
+#include <thread>
+
+using namespace royale;
+using testing::_;
+using testing::Return;
+using royale::common::Disconnected;
+using royale::common::RuntimeError;
+using sensors::test::MockRawFrame;
+
+namespace
+{
+    /**
+     * Sensor that counts how often it is read, standing in for a sensor that needs I2C for each
+     * reading.
+     */
+    class CountingTemperatureSensor : public hal::ITemperatureSensor
+    {
+    public:
+        float getTemperature() override
+        {
+            ++m_reads;
+            if (m_fail)
+            {
+                throw RuntimeError ("test sensor failure");
+            }
+            return m_temperature;
+        }
+
+        std::atomic<float> m_temperature {20.0f};
+        std::atomic<bool> m_fail {false};
+        std::atomic<unsigned> m_reads {0u};
+    };
+
+    class MockPsdTemperatureSensor : public hal::IPsdTemperatureSensor
+    {
+    public:
+        MOCK_METHOD1 (calcTemperature, float (const std::vector<common::ICapturedRawFrame *> &frames));
+    };
+
+    /**
+     * Polls the sampler until it returns the expected value, or a generous timeout expires.
+     */
+    bool waitForTemperature (device::TemperatureSampler &sampler, float expected)
+    {
+        for (auto i = 0; i < 1000; ++i)
+        {
+            if (sampler.getTemperature() == expected)
+            {
+                return true;
+            }
+            std::this_thread::sleep_for (std::chrono::milliseconds (5));
+        }
+        return false;
+    }
+}
+
+/**
+ * When the sampler isn't running, each call reads the sensor.
+ */
+TEST (TestTemperatureSampler, NotRunningReadsDirectly)
+{
+    auto sensor = std::make_shared<CountingTemperatureSensor>();
+    device::TemperatureSampler sampler (sensor, std::chrono::milliseconds (1000));
+
+    EXPECT_FLOAT_EQ (20.0f, sampler.getTemperature());
+    sensor->m_temperature = 30.0f;
+    EXPECT_FLOAT_EQ (30.0f, sampler.getTemperature());
+    EXPECT_EQ (2u, sensor->m_reads.load());
+}
+
+/**
+ * While running, the frames only read the cached value.  start() reads the sensor once, so the
+ * first frame already has a valid reading.
+ */
+TEST (TestTemperatureSampler, CachedWhileRunning)
+{
+    auto sensor = std::make_shared<CountingTemperatureSensor>();
+    device::TemperatureSampler sampler (sensor, std::chrono::milliseconds (10000));
+
+    sampler.start();
+    EXPECT_EQ (1u, sensor->m_reads.load());
+
+    sensor->m_temperature = 30.0f;
+    for (auto i = 0; i < 1000; ++i)
+    {
+        EXPECT_FLOAT_EQ (20.0f, sampler.getTemperature());
+    }
+    EXPECT_EQ (1u, sensor->m_reads.load());
+    sampler.stop();
+}
+
+TEST (TestTemperatureSampler, UpdatesEachPeriod)
+{
+    auto sensor = std::make_shared<CountingTemperatureSensor>();
+    device::TemperatureSampler sampler (sensor, std::chrono::milliseconds (10));
+
+    sampler.start();
+    EXPECT_FLOAT_EQ (20.0f, sampler.getTemperature());
+    sensor->m_temperature = 30.0f;
+    EXPECT_TRUE (waitForTemperature (sampler, 30.0f));
+    sampler.stop();
+
+    // After stop() there are no more reads from the sampling thread
+    const auto reads = sensor->m_reads.load();
+    std::this_thread::sleep_for (std::chrono::milliseconds (50));
+    EXPECT_EQ (reads, sensor->m_reads.load());
+
+    // It can be started again
+    sensor->m_temperature = 40.0f;
+    sampler.start();
+    EXPECT_FLOAT_EQ (40.0f, sampler.getTemperature());
+    sampler.stop();
+}
+
+/**
+ * The error of the sensor is reported to the caller, and the sampler recovers once the sensor can
+ * be read again.
+ */
+TEST (TestTemperatureSampler, SensorFailure)
+{
+    auto sensor = std::make_shared<CountingTemperatureSensor>();
+    device::TemperatureSampler sampler (sensor, std::chrono::milliseconds (10));
+
+    sensor->m_fail = true;
+    sampler.start();
+    EXPECT_THROW (sampler.getTemperature(), RuntimeError);
+
+    sensor->m_fail = false;
+    sensor->m_temperature = 30.0f;
+    bool recovered = false;
+    for (auto i = 0; i < 1000 && !recovered; ++i)
+    {
+        try
+        {
+            recovered = (sampler.getTemperature() == 30.0f);
+        }
+        catch (const RuntimeError &)
+        {
+        }
+        std::this_thread::sleep_for (std::chrono::milliseconds (5));
+    }
+    EXPECT_TRUE (recovered);
+}
+
+/**
+ * The caller gets the exception that the sensor threw, not a generic one.
+ */
+TEST (TestTemperatureSampler, SensorFailureKeepsExceptionType)
+{
+    class DisconnectedTemperatureSensor : public hal::ITemperatureSensor
+    {
+    public:
+        float getTemperature() override
+        {
+            throw Disconnected ("test sensor disconnected");
+        }
+    };
+
+    device::TemperatureSampler sampler (std::make_shared<DisconnectedTemperatureSensor>(), std::chrono::milliseconds (10000));
+    EXPECT_THROW (sampler.getTemperature(), Disconnected);
+
+    sampler.start();
+    EXPECT_THROW (sampler.getTemperature(), Disconnected);
+    sampler.stop();
+}
+
+/**
+ * Destroying a running sampler stops the thread.
+ */
+TEST (TestTemperatureSampler, DestroyWhileRunning)
+{
+    auto sensor = std::make_shared<CountingTemperatureSensor>();
+    {
+        device::TemperatureSampler sampler (sensor, std::chrono::milliseconds (1));
+        sampler.start();
+        std::this_thread::sleep_for (std::chrono::milliseconds (10));
+    }
+    const auto reads = sensor->m_reads.load();
+    std::this_thread::sleep_for (std::chrono::milliseconds (20));
+    EXPECT_EQ (reads, sensor->m_reads.load());
+}
+
+/**
+ * The pseudo data is only decoded once per period.
+ */
+TEST (TestPsdTemperatureSampler, DecodesOncePerPeriod)
+{
+    std::vector<common::ICapturedRawFrame *> frames;
+    MockRawFrame frame;
+    frames.push_back (&frame);
+
+    auto sensor = std::make_shared<MockPsdTemperatureSensor>();
+    device::PsdTemperatureSampler sampler (sensor, std::chrono::milliseconds (10000));
+
+    EXPECT_CALL (*sensor, calcTemperature (_))
+    .Times (1)
+    .WillOnce (Return (25.0f));
+    for (auto i = 0; i < 100; ++i)
+    {
+        EXPECT_FLOAT_EQ (25.0f, sampler.calcTemperature (frames));
+    }
+}
+
+TEST (TestPsdTemperatureSampler, DecodesAfterPeriod)
+{
+    std::vector<common::ICapturedRawFrame *> frames;
+    MockRawFrame frame;
+    frames.push_back (&frame);
+
+    auto sensor = std::make_shared<MockPsdTemperatureSensor>();
+    device::PsdTemperatureSampler sampler (sensor, std::chrono::milliseconds (10));
+
+    EXPECT_CALL (*sensor, calcTemperature (_))
+    .Times (2)
+    .WillOnce (Return (25.0f))
+    .WillOnce (Return (26.0f));
+    EXPECT_FLOAT_EQ (25.0f, sampler.calcTemperature (frames));
+    std::this_thread::sleep_for (std::chrono::milliseconds (20));
+    EXPECT_FLOAT_EQ (26.0f, sampler.calcTemperature (frames));
+}
+
+/**
+ * If decoding fails, the next set of frames tries again instead of waiting for the period.
+ */
+TEST (TestPsdTemperatureSampler, RetriesAfterFailure)
+{
+    std::vector<common::ICapturedRawFrame *> frames;
+    MockRawFrame frame;
+    frames.push_back (&frame);
+
+    auto sensor = std::make_shared<MockPsdTemperatureSensor>();
+    device::PsdTemperatureSampler sampler (sensor, std::chrono::milliseconds (10000));
+
+    EXPECT_CALL (*sensor, calcTemperature (_))
+    .Times (2)
+    .WillOnce (testing::Throw (RuntimeError ("no temperature in pseudo data")))
+    .WillOnce (Return (25.0f));
+    EXPECT_THROW (sampler.calcTemperature (frames), RuntimeError);
+    EXPECT_FLOAT_EQ (25.0f, sampler.calcTemperature (frames));
+}
@@ -0,0 +1,375 @@
+/****************************************************************************\
+* Copyright (C) 2019 pmdtechnologies ag
+*
+* THIS CODE AND INFORMATION ARE PROVIDED "AS IS" WITHOUT WARRANTY OF ANY
+* KIND, EITHER EXPRESSED OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE
+* IMPLIED WARRANTIES OF MERCHANTABILITY AND/OR FITNESS FOR A
+* PARTICULAR PURPOSE.
+*
+\****************************************************************************/
+
+#include <royale/DepthData.hpp>
+#include <royale/Vector.hpp>
+#include <royale/VectorAllocator.hpp>
+#include <royale/VectorPool.hpp>
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <iostream>
+#include <string>
+
+using namespace royale;
+
+namespace
+{
+    /**
+     * Allocator which counts the calls, and passes them on to a VectorPool.
+     */
+    class CountingVectorAllocator : public IVectorAllocator
+    {
+    public:
+        void *allocate (std::size_t bytes) override
+        {
+            ++m_allocations;
+            return m_pool.allocate (bytes);
+        }
+
+        void deallocate (void *block, std::size_t bytes) override
+        {
+            ++m_deallocations;
+            m_pool.deallocate (block, bytes);
+        }
+
+        VectorPool m_pool;
+        std::atomic<std::size_t> m_allocations {0u};
+        std::atomic<std::size_t> m_deallocations {0u};
+    };
+
+    /**
+     * Installs a CountingVectorAllocator for the lifetime of the fixture.
+     */
+    class TestVectorAllocator : public ::testing::Test
+    {
+    protected:
+        void SetUp() override
+        {
+            m_allocator = std::make_shared<CountingVectorAllocator>();
+            setVectorAllocator (m_allocator);
+        }
+
+        void TearDown() override
+        {
+            setVectorAllocator (nullptr);
+        }
+
+        std::size_t allocations() const
+        {
+            return m_allocator->m_allocations;
+        }
+
+        std::shared_ptr<CountingVectorAllocator> m_allocator;
+    };
+}
+
+TEST (TestVectorPool, SizeClasses)
+{
+    EXPECT_EQ (0u, VectorPool::sizeClass (0u));
+    EXPECT_EQ (0u, VectorPool::sizeClass (VectorPool::MIN_BLOCK_SIZE));
+
+    std::size_t previousClass = 0u;
+    for (std::size_t bytes = 1u; bytes <= 1024u * 1024u; bytes += (bytes < 4096u ? 1u : 97u))
+    {
+        const auto index = VectorPool::sizeClass (bytes);
+        const auto blockSize = VectorPool::blockSize (index);
+        ASSERT_GE (blockSize, bytes) << "bytes " << bytes;
+        if (bytes > VectorPool::MIN_BLOCK_SIZE)
+        {
+            // Never more than 25% larger than requested
+            ASSERT_LE (blockSize * 4u, bytes * 5u) << "bytes " << bytes;
+        }
+        // The classes are contiguous and increase with the size
+        ASSERT_GE (index, previousClass) << "bytes " << bytes;
+        ASSERT_LE (index, previousClass + 1u) << "bytes " << bytes;
+        ASSERT_EQ (index, VectorPool::sizeClass (blockSize)) << "bytes " << bytes;
+        previousClass = index;
+    }
+
+    const auto maxPooled = VectorPool::MAX_POOLED_SIZE;
+    EXPECT_EQ (maxPooled, VectorPool::blockSize (VectorPool::sizeClass (maxPooled)));
+}
+
+TEST (TestVectorPool, ReusesBlocks)
+{
+    VectorPool pool;
+    auto block = pool.allocate (1000u);
+    pool.deallocate (block, 1000u);
+
+    // The same size class, so the cached block is returned
+    auto reused = pool.allocate (990u);
+    EXPECT_EQ (block, reused);
+
+    // A different size class can't reuse it
+    auto other = pool.allocate (4000u);
+    EXPECT_NE (block, other);
+
+    pool.deallocate (reused, 990u);
+    pool.deallocate (other, 4000u);
+}
+
+TEST (TestVectorPool, LargeBlocks)
+{
+    VectorPool pool;
+    const auto size = VectorPool::MAX_POOLED_SIZE + 1u;
+    auto block = static_cast<char *> (pool.allocate (size));
+    block[0] = 1;
+    block[size - 1u] = 2;
+    pool.deallocate (block, size);
+}
+
+/**
+ * Without an allocator the buffers come from new[], setVectorAllocator (nullptr) restores that.
+ */
+TEST (TestVectorPool, DefaultIsNotPooled)
+{
+    EXPECT_EQ (nullptr, getVectorAllocator());
+
+    auto pool = std::make_shared<VectorPool>();
+    setVectorAllocator (pool);
+    EXPECT_EQ (pool, getVectorAllocator());
+    Vector<uint32_t> pooled (100u);
+
+    setVectorAllocator (nullptr);
+    EXPECT_EQ (nullptr, getVectorAllocator());
+    Vector<uint32_t> plain (100u);
+    plain = pooled;
+    EXPECT_EQ (100u, plain.size());
+}
+
+TEST_F (TestVectorAllocator, BuffersUseHook)
+{
+    {
+        Vector<uint32_t> v (100u);
+        EXPECT_GT (allocations(), 0u);
+    }
+    EXPECT_EQ (m_allocator->m_allocations.load(), m_allocator->m_deallocations.load());
+
+    // Buffers keep the allocator that they were allocated from
+    Vector<uint32_t> v (100u);
+    const auto deallocations = m_allocator->m_deallocations.load();
+    setVectorAllocator (nullptr);
+    v = Vector<uint32_t> ();
+    EXPECT_GT (m_allocator->m_deallocations.load(), deallocations);
+}
+
+TEST_F (TestVectorAllocator, MoveDoesNotAllocate)
+{
+    Vector<uint32_t> a (std::size_t (1000u), 7u);
+    const auto buffer = a.data();
+    const auto before = allocations();
+
+    Vector<uint32_t> b (std::move (a));
+    EXPECT_TRUE (a.empty());
+    EXPECT_EQ (0u, a.capacity());
+    EXPECT_EQ (buffer, b.data());
+
+    Vector<uint32_t> c;
+    c = std::move (b);
+    EXPECT_TRUE (b.empty());
+    EXPECT_EQ (0u, b.capacity());
+    EXPECT_EQ (buffer, c.data());
+    EXPECT_EQ (1000u, c.size());
+    EXPECT_EQ (7u, c[999]);
+
+    EXPECT_EQ (before, allocations());
+}
+
+TEST_F (TestVectorAllocator, CopyAssignReusesCapacity)
+{
+    Vector<uint32_t> src (std::size_t (1000u), 3u);
+    Vector<uint32_t> dst (1000u);
+    const auto buffer = dst.data();
+    const auto before = allocations();
+
+    dst = src;
+    EXPECT_EQ (buffer, dst.data());
+    EXPECT_TRUE (dst == src);
+
+    std::vector<uint32_t> stdSrc (500u, 4u);
+    dst = stdSrc;
+    EXPECT_EQ (buffer, dst.data());
+    EXPECT_EQ (500u, dst.size());
+    EXPECT_EQ (1000u, dst.capacity());
+    EXPECT_TRUE (dst == stdSrc);
+
+    EXPECT_EQ (before, allocations());
+
+    // Larger than the capacity, so this has to allocate
+    Vector<uint32_t> bigger (std::size_t (2000u), 5u);
+    dst = bigger;
+    EXPECT_TRUE (dst == bigger);
+}
+
+TEST_F (TestVectorAllocator, CopyAssignNonTrivial)
+{
+    Vector<std::string> src {"one", "two", "three"};
+    Vector<std::string> dst {"a"};
+    dst.reserve (4u);
+    const auto buffer = dst.data();
+
+    // Assigns the first element and constructs the others
+    dst = src;
+    EXPECT_EQ (buffer, dst.data());
+    EXPECT_TRUE (dst == src);
+
+    // Assigns the first element and destroys the others
+    const Vector<std::string> single {"b"};
+    dst = single;
+    EXPECT_EQ (buffer, dst.data());
+    ASSERT_EQ (1u, dst.size());
+    EXPECT_EQ ("b", dst[0]);
+}
+
+TEST_F (TestVectorAllocator, ResizeReusesCapacity)
+{
+    Vector<uint32_t> v (std::size_t (100u), 1u);
+    const auto buffer = v.data();
+    const auto before = allocations();
+
+    v.resize (50u);
+    EXPECT_EQ (50u, v.size());
+    EXPECT_EQ (100u, v.capacity());
+    v.resize (100u, 2u);
+    EXPECT_EQ (1u, v[49]);
+    EXPECT_EQ (2u, v[50]);
+    EXPECT_EQ (buffer, v.data());
+    EXPECT_EQ (before, allocations());
+
+    v.resize (200u);
+    EXPECT_EQ (200u, v.capacity());
+    EXPECT_EQ (1u, v[0]);
+    EXPECT_EQ (2u, v[99]);
+    EXPECT_EQ (0u, v[199]);
+
+    v.shrink_to_fit();
+    EXPECT_EQ (200u, v.capacity());
+    v.resize (10u);
+    v.shrink_to_fit();
+    EXPECT_EQ (10u, v.capacity());
+}
+
+TEST_F (TestVectorAllocator, ResizeNoInit)
+{
+    Vector<uint16_t> v {1u, 2u, 3u};
+    v.resizeNoInit (2u);
+    EXPECT_EQ (2u, v.size());
+    EXPECT_EQ (3u, v.capacity());
+
+    // Growing keeps the existing elements
+    v.resizeNoInit (1000u);
+    ASSERT_EQ (1000u, v.size());
+    EXPECT_EQ (1u, v[0]);
+    EXPECT_EQ (2u, v[1]);
+
+    const auto buffer = v.data();
+    const auto before = allocations();
+    v.resizeNoInit (10u);
+    v.resizeNoInit (1000u);
+    EXPECT_EQ (buffer, v.data());
+    EXPECT_EQ (before, allocations());
+}
+
+/**
+ * Copying the DepthData for each frame, as done when the data is passed on to a queue, doesn't
+ * allocate once the destination has the right size.
+ */
+TEST_F (TestVectorAllocator, DepthDataCopy)
+{
+    DepthData src;
+    src.exposureTimes = Vector<uint32_t> {100u, 200u};
+    src.points.resize (224u * 172u);
+    src.points[10].z = 1.5f;
+
+    DepthData dst;
+    dst = src;
+    const auto before = allocations();
+    for (auto i = 0; i < 10; ++i)
+    {
+        src.points[10].z = static_cast<float> (i);
+        dst = src;
+        EXPECT_EQ (static_cast<float> (i), dst.points[10].z);
+    }
+    EXPECT_EQ (before, allocations());
+    EXPECT_TRUE (dst.exposureTimes == src.exposureTimes);
+}
+
+/**
+ * Compares the time for the allocations that happen for each frame, with the buffers allocated
+ * by new[] directly, by the default allocateVectorBuffer and by a VectorPool.
+ */
+TEST (TestVectorPool, DISABLED_Benchmark)
+{
+    const std::size_t numPoints = 224u * 172u;
+    const auto bytes = numPoints * sizeof (DepthPoint);
+    const int repetitions = 10000;
+
+    using Clock = std::chrono::steady_clock;
+    auto start = Clock::now();
+    for (auto i = 0; i < repetitions; ++i)
+    {
+        std::shared_ptr<char> buffer (new char[bytes], std::default_delete<char[]>());
+        buffer.get() [0] = 0;
+    }
+    const auto newTime = std::chrono::duration_cast<std::chrono::nanoseconds> (Clock::now() - start);
+
+    start = Clock::now();
+    for (auto i = 0; i < repetitions; ++i)
+    {
+        auto buffer = detail::allocateVectorBuffer (bytes);
+        buffer.get() [0] = 0;
+    }
+    const auto defaultTime = std::chrono::duration_cast<std::chrono::nanoseconds> (Clock::now() - start);
+
+    setVectorAllocator (std::make_shared<VectorPool>());
+    start = Clock::now();
+    for (auto i = 0; i < repetitions; ++i)
+    {
+        auto buffer = detail::allocateVectorBuffer (bytes);
+        buffer.get() [0] = 0;
+    }
+    const auto poolTime = std::chrono::duration_cast<std::chrono::nanoseconds> (Clock::now() - start);
+    setVectorAllocator (nullptr);
+
+    Vector<DepthPoint> points (numPoints);
+    start = Clock::now();
+    for (auto i = 0; i < repetitions; ++i)
+    {
+        Vector<DepthPoint> copy (points);
+        copy[0].x = 0.0f;
+    }
+    const auto copyConstructTime = std::chrono::duration_cast<std::chrono::nanoseconds> (Clock::now() - start);
+
+    Vector<DepthPoint> target (numPoints);
+    start = Clock::now();
+    for (auto i = 0; i < repetitions; ++i)
+    {
+        target = points;
+    }
+    const auto copyAssignTime = std::chrono::duration_cast<std::chrono::nanoseconds> (Clock::now() - start);
+
+    start = Clock::now();
+    for (auto i = 0; i < repetitions; ++i)
+    {
+        Vector<DepthPoint> moved (std::move (points));
+        points = std::move (moved);
+    }
+    const auto moveTime = std::chrono::duration_cast<std::chrono::nanoseconds> (Clock::now() - start);
+
+    std::cout << "new[] buffer:     " << newTime.count() / repetitions << " ns per frame" << std::endl;
+    std::cout << "default buffer:   " << defaultTime.count() / repetitions << " ns per frame" << std::endl;
+    std::cout << "pooled buffer:    " << poolTime.count() / repetitions << " ns per frame" << std::endl;
+    std::cout << "copy constructor: " << copyConstructTime.count() / repetitions << " ns per frame" << std::endl;
+    std::cout << "copy assignment:  " << copyAssignTime.count() / repetitions << " ns per frame" << std::endl;
+    std::cout << "move and back:    " << moveTime.count() / repetitions << " ns per frame" << std::endl;
+}
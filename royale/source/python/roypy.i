@@ -23,6 +23,11 @@
 
 #include <royale.hpp>
 #include <royale/IReplay.hpp>
+
+#include <algorithm>
+#include <cstddef>
+#include <initializer_list>
+#include <tuple>
 using namespace royale;
 %}
 
@@ -254,22 +259,215 @@ WRAP_VECTOR_ARG(uint32_t);
 
 
 
+// Read-only NumPy views of the data of the callbacks, without copying it.  The views point to
+// the memory of the C++ struct and keep the Python object of the struct alive, but the structs
+// that are passed to a listener are only valid until onNewData returns.  Use copy() on the
+// struct (or the view) to keep the data for longer.
 #ifdef ROYALE_ACTIVATE_NUMPY
+%{
+    /**
+     * Returns a structured dtype, the fields are given as (name, format, offset).
+     */
+    inline PyArray_Descr *roypyStructDescr (std::initializer_list<std::tuple<const char *, const char *, size_t>> fields, size_t itemSize)
+    {
+        auto names = PyList_New (0);
+        auto formats = PyList_New (0);
+        auto offsets = PyList_New (0);
+        for (const auto &field : fields)
+        {
+            auto name = PyUnicode_FromString (std::get<0> (field));
+            auto format = PyUnicode_FromString (std::get<1> (field));
+            auto offset = PyLong_FromSize_t (std::get<2> (field));
+            PyList_Append (names, name);
+            PyList_Append (formats, format);
+            PyList_Append (offsets, offset);
+            Py_DECREF (name);
+            Py_DECREF (format);
+            Py_DECREF (offset);
+        }
+        auto itemSizeObj = PyLong_FromSize_t (itemSize);
+        auto spec = PyDict_New();
+        PyDict_SetItemString (spec, "names", names);
+        PyDict_SetItemString (spec, "formats", formats);
+        PyDict_SetItemString (spec, "offsets", offsets);
+        PyDict_SetItemString (spec, "itemsize", itemSizeObj);
+        Py_DECREF (names);
+        Py_DECREF (formats);
+        Py_DECREF (offsets);
+        Py_DECREF (itemSizeObj);
+
+        PyArray_Descr *descr = nullptr;
+        PyArray_DescrConverter (spec, &descr);
+        Py_DECREF (spec);
+        return descr;
+    }
+
+    /**
+     * The dtypes of the point structs, these return a new reference.
+     */
+    inline PyArray_Descr *roypyDepthPointDescr()
+    {
+        // Created once, and never released
+        static auto descr = roypyStructDescr (
+        {
+            std::make_tuple ("x", "f4", offsetof (royale::DepthPoint, x)),
+            std::make_tuple ("y", "f4", offsetof (royale::DepthPoint, y)),
+            std::make_tuple ("z", "f4", offsetof (royale::DepthPoint, z)),
+            std::make_tuple ("noise", "f4", offsetof (royale::DepthPoint, noise)),
+            std::make_tuple ("grayValue", "u2", offsetof (royale::DepthPoint, grayValue)),
+            std::make_tuple ("depthConfidence", "u1", offsetof (royale::DepthPoint, depthConfidence))
+        }, sizeof (royale::DepthPoint));
+        Py_XINCREF (descr);
+        return descr;
+    }
+
+    inline PyArray_Descr *roypyIntermediatePointDescr()
+    {
+        static auto descr = roypyStructDescr (
+        {
+            std::make_tuple ("distance", "f4", offsetof (royale::IntermediatePoint, distance)),
+            std::make_tuple ("amplitude", "f4", offsetof (royale::IntermediatePoint, amplitude)),
+            std::make_tuple ("intensity", "f4", offsetof (royale::IntermediatePoint, intensity)),
+            std::make_tuple ("flags", "u4", offsetof (royale::IntermediatePoint, flags))
+        }, sizeof (royale::IntermediatePoint));
+        Py_XINCREF (descr);
+        return descr;
+    }
+
+    /**
+     * Creates a read-only array of count elements at data, with the shape (height, width) if the
+     * image has that size.  The array keeps owner alive, and takes over the reference to descr.
+     */
+    inline PyObject *roypyArrayView (PyObject *owner, PyArray_Descr *descr, const void *data, size_t count,
+                                     uint16_t width, uint16_t height)
+    {
+        if (descr == nullptr)
+        {
+            PyErr_SetString (PyExc_RuntimeError, "Could not create the NumPy dtype");
+            return nullptr;
+        }
+
+        npy_intp dims[2];
+        int nd;
+        if (width > 0 && static_cast<size_t> (width) * height == count)
+        {
+            dims[0] = height;
+            dims[1] = width;
+            nd = 2;
+        }
+        else
+        {
+            dims[0] = static_cast<npy_intp> (count);
+            nd = 1;
+        }
+
+        // Without NPY_ARRAY_WRITEABLE the array is read-only
+        auto array = PyArray_NewFromDescr (&PyArray_Type, descr, nd, dims, nullptr, const_cast<void *> (data),
+                                           NPY_ARRAY_C_CONTIGUOUS | NPY_ARRAY_ALIGNED, nullptr);
+        if (array == nullptr)
+        {
+            return nullptr;
+        }
+
+        Py_INCREF (owner);
+        if (PyArray_SetBaseObject (reinterpret_cast<PyArrayObject *> (array), owner) < 0)
+        {
+            Py_DECREF (array);
+            return nullptr;
+        }
+        return array;
+    }
+%}
+
+// The views call the Python C API, so the wrappers mustn't release the GIL
+%feature("nothread") royale::DepthData::_pointsView;
+%feature("nothread") royale::IntermediateData::_pointsView;
+%feature("nothread") royale::DepthImage::_cdDataView;
+%feature("nothread") royale::IRImage::_dataView;
+
 %extend royale::DepthData {
+    PyObject *_pointsView (PyObject *owner) {
+        return roypyArrayView (owner, roypyDepthPointDescr(), $self->points.data(), $self->points.size(), $self->width, $self->height);
+    }
+
     void fastPoints (double * p, int n) {
-        for (auto i = 0; i < n; i+=6) {
-            p[i] = $self->points[i/6].x;
-            p[i+1] = $self->points[i/6].y;
-            p[i+2] = $self->points[i/6].z;
-            p[i+3] = $self->points[i/6].noise;
-            p[i+4] = $self->points[i/6].grayValue;
-            p[i+5] = $self->points[i/6].depthConfidence;
+        const auto count = std::min (static_cast<size_t> (n / 6), $self->points.size());
+        const auto *point = $self->points.data();
+        for (size_t i = 0; i < count; ++i, ++point, p += 6) {
+            p[0] = point->x;
+            p[1] = point->y;
+            p[2] = point->z;
+            p[3] = point->noise;
+            p[4] = point->grayValue;
+            p[5] = point->depthConfidence;
         }
     }
-  
+
     %pythoncode %{
 def npoints (self):
     return self.fastPoints(self.width * self.height * 6).reshape(-1,self.width,6)
+
+def pointsView (self):
+    """Read-only structured array (height x width) of the points, with the fields x, y, z,
+    noise (float32), grayValue (uint16) and depthConfidence (uint8).  The data isn't copied,
+    the view is only valid as long as this DepthData is."""
+    return self._pointsView (self)
+
+def __array__ (self, dtype=None):
+    view = self.pointsView ()
+    return view if dtype is None else view.astype (dtype)
+%}
+}
+
+%extend royale::IntermediateData {
+    PyObject *_pointsView (PyObject *owner) {
+        return roypyArrayView (owner, roypyIntermediatePointDescr(), $self->points.data(), $self->points.size(), $self->width, $self->height);
+    }
+
+    %pythoncode %{
+def pointsView (self):
+    """Read-only structured array (height x width) of the points, with the fields distance,
+    amplitude, intensity (float32) and flags (uint32).  The data isn't copied, the view is only
+    valid as long as this IntermediateData is."""
+    return self._pointsView (self)
+
+def __array__ (self, dtype=None):
+    view = self.pointsView ()
+    return view if dtype is None else view.astype (dtype)
+%}
+}
+
+%extend royale::DepthImage {
+    PyObject *_cdDataView (PyObject *owner) {
+        return roypyArrayView (owner, PyArray_DescrFromType (NPY_UINT16), $self->cdData.data(), $self->cdData.size(), $self->width, $self->height);
+    }
+
+    %pythoncode %{
+def cdDataView (self):
+    """Read-only uint16 array (height x width) of the depth and confidence values, without
+    copying them.  The view is only valid as long as this DepthImage is."""
+    return self._cdDataView (self)
+
+def __array__ (self, dtype=None):
+    view = self.cdDataView ()
+    return view if dtype is None else view.astype (dtype)
+%}
+}
+
+%extend royale::IRImage {
+    PyObject *_dataView (PyObject *owner) {
+        return roypyArrayView (owner, PyArray_DescrFromType (NPY_UINT8), $self->data.data(), $self->data.size(), $self->width, $self->height);
+    }
+
+    %pythoncode %{
+def dataView (self):
+    """Read-only uint8 array (height x width) of the IR image, without copying it.  The view is
+    only valid as long as this IRImage is."""
+    return self._dataView (self)
+
+def __array__ (self, dtype=None):
+    view = self.dataView ()
+    return view if dtype is None else view.astype (dtype)
 %}
 }
 #else
@@ -281,10 +479,62 @@ def npoints (self):
 def npoints (self):
     print('Roypy was compiled without numpy support!')
     raise RuntimeError('Roypy was compiled without numpy support!')
+
+def pointsView (self):
+    raise RuntimeError('Roypy was compiled without numpy support!')
+%}
+}
+
+%extend royale::IntermediateData {
+    %pythoncode %{
+def pointsView (self):
+    raise RuntimeError('Roypy was compiled without numpy support!')
+%}
+}
+
+%extend royale::DepthImage {
+    %pythoncode %{
+def cdDataView (self):
+    raise RuntimeError('Roypy was compiled without numpy support!')
+%}
+}
+
+%extend royale::IRImage {
+    %pythoncode %{
+def dataView (self):
+    raise RuntimeError('Roypy was compiled without numpy support!')
 %}
 }
 #endif
 
+// Copies that own their data, for keeping the data of a callback
+%newobject royale::DepthData::copy;
+%newobject royale::IntermediateData::copy;
+%newobject royale::DepthImage::copy;
+%newobject royale::IRImage::copy;
+%extend royale::DepthData {
+    royale::DepthData *copy() {
+        return new royale::DepthData (*$self);
+    }
+}
+%extend royale::IntermediateData {
+    royale::IntermediateData *copy() {
+        auto data = new royale::IntermediateData;
+        *data = *$self;
+        return data;
+    }
+}
+%extend royale::DepthImage {
+    royale::DepthImage *copy() {
+        return new royale::DepthImage (*$self);
+    }
+}
+%extend royale::IRImage {
+    royale::IRImage *copy() {
+        return new royale::IRImage (*$self);
+    }
+}
+
 
 // Access to points member in DepthData struct
 %extend royale::DepthData {
@@ -649,6 +899,8 @@ ICameraDevicePtr.getLensCenter = getLensCenter
 %include <royale/IDepthDataListener.hpp>
 %feature("director") royale::IDepthImageListener;
 %include <royale/IDepthImageListener.hpp>
+%feature("director") royale::IIRImageListener;
+%include <royale/IIRImageListener.hpp>
 %include <royale/IExtendedData.hpp>
 %ignore royale::RawData::rawData;
 %include <royale/RawData.hpp>
@@ -676,6 +928,8 @@ ICameraDevicePtr.getLensCenter = getLensCenter
 %include <royale/IRecordStopListener.hpp>
 %include <royale/DepthData.hpp>
 %include <royale/DepthImage.hpp>
+%ignore royale::IRImage::data;
+%include <royale/IRImage.hpp>
 %include <royale/RawData.hpp>
 //%include <processing/ExtendedData.hpp>
 %include <royale/ProcessingFlag.hpp>
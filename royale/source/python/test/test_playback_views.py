@@ -0,0 +1,230 @@
+#!/usr/bin/python3
+
+"""Tests for the NumPy views of the callback data, using a recording.
+
+Run with pytest, by default the ListenerTest.rrf from the Royale unit tests is played back.  A
+different recording can be given in the environment variable ROYPY_TEST_RRF:
+
+    ROYPY_TEST_RRF=recording.rrf python3 -m pytest test_playback_views.py
+"""
+
+import os
+
+import numpy as np
+import pytest
+import roypy
+
+RRF_FILE = os.environ.get("ROYPY_TEST_RRF",
+                          "${ROYALE_SOURCE_DIR}/source/royale/test/files/ListenerTest.rrf")
+
+# Number of frames that are played back for each test
+NUM_FRAMES = 5
+
+
+class CheckingListener(object):
+    """Calls check for each frame inside of the callback. Exceptions in the callback don't reach
+    the test, so they are collected and raised afterwards."""
+
+    def __init__(self, check):
+        self.check = check
+        self.errors = []
+        self.frames = 0
+
+    def handle(self, data):
+        try:
+            self.check(data)
+            self.frames += 1
+        except Exception as e:
+            self.errors.append(e)
+
+    def verify(self):
+        if self.errors:
+            raise self.errors[0]
+        assert self.frames > 0
+
+
+class DepthListener(roypy.IDepthDataListener):
+    def __init__(self, checker):
+        super(DepthListener, self).__init__()
+        self.checker = checker
+
+    def onNewData(self, data):
+        self.checker.handle(data)
+
+
+class DepthImageListener(roypy.IDepthImageListener):
+    def __init__(self, checker):
+        super(DepthImageListener, self).__init__()
+        self.checker = checker
+
+    def onNewData(self, data):
+        self.checker.handle(data)
+
+
+class IRImageListener(roypy.IIRImageListener):
+    def __init__(self, checker):
+        super(IRImageListener, self).__init__()
+        self.checker = checker
+
+    def onNewData(self, data):
+        self.checker.handle(data)
+
+
+class ExtendedListener(roypy.IExtendedDataListener):
+    def __init__(self, checker):
+        super(ExtendedListener, self).__init__()
+        self.checker = checker
+
+    def onNewData(self, data):
+        if data.hasIntermediateData():
+            self.checker.handle(data.getIntermediateData())
+
+
+@pytest.fixture
+def camera():
+    manager = roypy.CameraManager("${ROYALE_ACCESS_CODE_LEVEL2}")
+    cam = manager.createCamera(RRF_FILE)
+    cam.initialize()
+    replay = cam.asReplay()
+    replay.useTimestamps(False)
+    replay.loop(False)
+    yield cam
+    cam = None
+
+
+def play(cam):
+    """Seeking while not capturing plays back one frame, the callbacks are called before seek
+    returns."""
+    replay = cam.asReplay()
+    for frame in range(min(NUM_FRAMES, replay.frameCount())):
+        replay.seek(frame)
+
+
+def test_depth_view_matches_accessors(camera):
+    def check(data):
+        view = data.pointsView()
+        assert view.shape == (data.height, data.width)
+        assert not view.flags.writeable
+        assert view.dtype.names == ("x", "y", "z", "noise", "grayValue", "depthConfidence")
+        assert view.dtype["x"] == np.float32
+        assert view.dtype["grayValue"] == np.uint16
+        assert view.dtype["depthConfidence"] == np.uint8
+
+        flat = view.reshape(-1)
+        assert len(flat) == data.getNumPoints()
+        for i in range(0, len(flat), 997):
+            assert flat["x"][i] == np.float32(data.getX(i))
+            assert flat["y"][i] == np.float32(data.getY(i))
+            assert flat["z"][i] == np.float32(data.getZ(i))
+            assert flat["noise"][i] == np.float32(data.getNoise(i))
+            assert flat["grayValue"][i] == data.getGrayValue(i)
+            assert flat["depthConfidence"][i] == data.getDepthConfidence(i)
+
+        # The old conversion gives the same values
+        points = data.npoints()
+        assert np.array_equal(points[..., 0], view["x"])
+        assert np.array_equal(points[..., 4], view["grayValue"])
+
+    checker = CheckingListener(check)
+    listener = DepthListener(checker)
+    camera.registerDataListener(listener)
+    play(camera)
+    camera.unregisterDataListener()
+    checker.verify()
+
+
+def test_depth_view_is_not_a_copy(camera):
+    def check(data):
+        first = data.pointsView()
+        second = np.asarray(data)
+        assert np.shares_memory(first, second)
+        with pytest.raises(ValueError):
+            first["z"][0, 0] = 1.0
+
+    checker = CheckingListener(check)
+    listener = DepthListener(checker)
+    camera.registerDataListener(listener)
+    play(camera)
+    camera.unregisterDataListener()
+    checker.verify()
+
+
+def test_depth_copy_outlives_callback(camera):
+    copies = []
+
+    def check(data):
+        copy = data.copy()
+        assert not np.shares_memory(copy.pointsView(), data.pointsView())
+        copies.append((copy, data.pointsView().copy()))
+
+    checker = CheckingListener(check)
+    listener = DepthListener(checker)
+    camera.registerDataListener(listener)
+    play(camera)
+    camera.unregisterDataListener()
+    checker.verify()
+
+    for copy, expected in copies:
+        assert np.array_equal(copy.pointsView(), expected)
+
+
+def test_depth_image_view(camera):
+    def check(data):
+        view = data.cdDataView()
+        assert view.shape == (data.height, data.width)
+        assert view.dtype == np.uint16
+        assert not view.flags.writeable
+        flat = view.reshape(-1)
+        for i in range(0, len(flat), 997):
+            assert flat[i] == data.getCDData(i)
+
+    checker = CheckingListener(check)
+    listener = DepthImageListener(checker)
+    camera.registerDepthImageListener(listener)
+    play(camera)
+    camera.unregisterDepthImageListener()
+    checker.verify()
+
+
+def test_ir_image_view(camera):
+    copies = []
+
+    def check(data):
+        view = data.dataView()
+        assert view.shape == (data.height, data.width)
+        assert view.dtype == np.uint8
+        assert not view.flags.writeable
+        copies.append((data.copy(), view.copy()))
+
+    checker = CheckingListener(check)
+    listener = IRImageListener(checker)
+    camera.registerIRImageListener(listener)
+    play(camera)
+    camera.unregisterIRImageListener()
+    checker.verify()
+
+    for copy, expected in copies:
+        assert np.array_equal(copy.dataView(), expected)
+
+
+def test_intermediate_view(camera):
+    def check(data):
+        view = data.pointsView()
+        assert view.shape == (data.height, data.width)
+        assert view.dtype.names == ("distance", "amplitude", "intensity", "flags")
+        assert view.dtype["flags"] == np.uint32
+        assert not view.flags.writeable
+        flat = view.reshape(-1)
+        for i in range(0, len(flat), 997):
+            assert flat["distance"][i] == np.float32(data.getDistance(i))
+            assert flat["amplitude"][i] == np.float32(data.getAmplitude(i))
+            assert flat["intensity"][i] == np.float32(data.getIntensity(i))
+            assert flat["flags"][i] == data.getFlags(i)
+
+    checker = CheckingListener(check)
+    listener = ExtendedListener(checker)
+    camera.setCallbackData(4)  # CallbackData::Intermediate
+    camera.registerDataListenerExtended(listener)
+    play(camera)
+    camera.unregisterDataListenerExtended()
+    checker.verify()
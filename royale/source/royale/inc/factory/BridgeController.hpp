@@ -10,11 +10,13 @@
 
 #pragma once
 
+#include <royale/Definitions.hpp>
 #include <factory/ICameraCoreBuilder.hpp>
 #include <factory/IProcessingParameterMapFactory.hpp>
 #include <usb/enumerator/IBusEnumerator.hpp>
 #include <usb/config/UsbProbeData.hpp>
 
+#include <functional>
 #include <vector>
 #include <memory>
 
@@ -25,10 +27,26 @@ namespace royale
         /**
          * The BridgeController can probe USB-based devices, but can also generate
          * the correct bridge interfaces. After creation, the bridge is already connected.
+         *
+         * The bus enumerators run concurrently, and each device that they find is probed in its
+         * own thread, so that opening several cameras takes as long as the slowest one.  Builds
+         * where the bridges depend on the calling thread (DirectShow needs its COM apartment, and
+         * on Android all enumerators share the device's file descriptor) probe one device after
+         * another instead.
          */
         class BridgeController
         {
         public:
+            /**
+            * Callback of the IBusEnumerator, called for each device that matches the probe data.
+            */
+            using ProbeCallback = std::function<void (const royale::usb::config::UsbProbeData &, std::unique_ptr<royale::factory::IBridgeFactory>) >;
+
+            /**
+            * Runs one bus enumerator, passing each device that it finds to the callback.
+            */
+            using BusEnumeration = std::function<void (const ProbeCallback &) >;
+
             /**
             * Construct a BridgeController which probes all camera modules officially supported by Royale.
             */
@@ -37,8 +55,8 @@ namespace royale
             /**
             * Construct a BridgeController with a list of camera modules to probe.
             */
-            explicit BridgeController (const royale::usb::config::UsbProbeDataList &probeData,
-                                       const std::shared_ptr<IProcessingParameterMapFactory> &paramFactory);
+            ROYALE_API explicit BridgeController (const royale::usb::config::UsbProbeDataList &probeData,
+                                                  const std::shared_ptr<IProcessingParameterMapFactory> &paramFactory);
 
             /**
             * This probes for all attached USB-based cameras and delivers a list of
@@ -62,6 +80,23 @@ namespace royale
 #else
             std::vector<std::unique_ptr<royale::factory::ICameraCoreBuilder>> probeDevices (royale::CameraAccessLevel accessLevel);
 #endif
+
+            /**
+            * Runs the enumerations, and then probes the module config of each device that they
+            * found.  This is used by probeDevices(), with the enumerators of the bridge types that
+            * Royale was built with.
+            *
+            * If concurrent is true, each enumeration and each device's probe runs in its own
+            * thread, otherwise they all run in the calling thread.  All threads have finished when
+            * this returns.
+            *
+            * The order of the returned list is the order of the enumerations, and within each
+            * enumeration the order in which the devices were found.  Devices that couldn't be
+            * configured are not included.
+            */
+            ROYALE_API std::vector<std::unique_ptr<royale::factory::ICameraCoreBuilder>> probeDevices (const std::vector<BusEnumeration> &enumerations,
+                    royale::CameraAccessLevel accessLevel, bool concurrent = true);
+
             /**
              * Set the event listener for this bridge controller. For the events which could occur,
              * see probeDevices().
@@ -8,9 +8,13 @@
  *
  \****************************************************************************/
 
+#include <future>
 #include <memory>
+#include <system_error>
+#include <thread>
 
 #include <common/events/EventProbedDevicesNotMatched.hpp>
+#include <common/MakeUnique.hpp>
 #include <common/RoyaleLogger.hpp>
 
 #include <factory/BridgeController.hpp>
@@ -69,50 +73,77 @@ using royale::factory::ICameraCoreBuilder;
 
 namespace
 {
-    // Function object suitable for passing to IBusEnumerator::enumerateDevices
-    // which creates the CameraCoreBuilder and adds it to a list.
-    class CameraCoreBuilderInserter
+    /**
+     * A device found by one of the bus enumerators, and the result of probing it.  The thread
+     * that probes the device sets the coreBuilder, probeDevices() reads it after joining the
+     * thread.
+     */
+    struct DeviceProbe
     {
-    public:
-        explicit CameraCoreBuilderInserter (std::vector<std::unique_ptr<ICameraCoreBuilder>> &coreBuilders,
-                                            std::shared_ptr<IProcessingParameterMapFactory> &paramFactory,
-                                            royale::CameraAccessLevel accessLevel) :
-            m_coreBuilders (coreBuilders),
-            m_paramFactory (paramFactory),
-            m_accessLevel (accessLevel)
+        DeviceProbe (const UsbProbeData &probeData, std::unique_ptr<IBridgeFactory> factory) :
+            pd (probeData),
+            bridgeFactory (std::move (factory))
         {
         }
 
+        /** A copy, as the enumerator's probe data doesn't outlive the enumeration */
+        const UsbProbeData pd;
+        std::unique_ptr<IBridgeFactory> bridgeFactory;
+        std::unique_ptr<ICameraCoreBuilder> coreBuilder;
+    };
 
-        void operator() (const UsbProbeData &pd, std::unique_ptr<royale::factory::IBridgeFactory> bridgeFactory)
+    using DeviceProbeList = std::vector<std::unique_ptr<DeviceProbe>>;
+
+    /**
+     * Creates the CameraCoreBuilder for a device found by a bus enumerator.  Depending on the
+     * IModuleConfigFactory, this may need to read the module's storage.
+     *
+     * Returns nullptr if the device can't be configured.
+     */
+    std::unique_ptr<ICameraCoreBuilder> createCoreBuilder (const UsbProbeData &pd,
+            std::unique_ptr<royale::factory::IBridgeFactory> bridgeFactory,
+            const std::shared_ptr<IProcessingParameterMapFactory> &paramFactory,
+            royale::CameraAccessLevel accessLevel)
+    {
+        try
         {
-            try
-            {
-                bridgeFactory->initialize();
-                auto moduleConfig = pd.moduleConfigFactory->probeAndCreate (*bridgeFactory, m_accessLevel);
-                if (moduleConfig == nullptr)
-                {
-                    throw RuntimeError ("Unable to determine moduleConfig");
-                }
-                std::shared_ptr<const royale::config::ICoreConfig> coreConfig = CoreConfigFactory (*moduleConfig, m_paramFactory) ();
-                auto cameraCoreBuilder = CameraCoreBuilderFactory (pd.bridgeType, *moduleConfig) ();
-                cameraCoreBuilder->setBridgeFactory (std::move (bridgeFactory));
-                cameraCoreBuilder->setConfig (coreConfig,
-                                              std::make_shared<const config::ImagerConfig> (moduleConfig->imagerConfig),
-                                              moduleConfig->illuminationConfig);
-                m_coreBuilders.push_back (std::move (cameraCoreBuilder));
-            }
-            catch (const Exception &e)
+            bridgeFactory->initialize();
+            auto moduleConfig = pd.moduleConfigFactory->probeAndCreate (*bridgeFactory, accessLevel);
+            if (moduleConfig == nullptr)
             {
-                LOG (DEBUG) << "Unable to configure device: " << e.getTechnicalDescription();
+                throw RuntimeError ("Unable to determine moduleConfig");
             }
+            std::shared_ptr<const royale::config::ICoreConfig> coreConfig = CoreConfigFactory (*moduleConfig, paramFactory) ();
+            auto cameraCoreBuilder = CameraCoreBuilderFactory (pd.bridgeType, *moduleConfig) ();
+            cameraCoreBuilder->setBridgeFactory (std::move (bridgeFactory));
+            cameraCoreBuilder->setConfig (coreConfig,
+                                          std::make_shared<const config::ImagerConfig> (moduleConfig->imagerConfig),
+                                          moduleConfig->illuminationConfig);
+            return cameraCoreBuilder;
+        }
+        catch (const Exception &e)
+        {
+            LOG (DEBUG) << "Unable to configure device: " << e.getTechnicalDescription();
         }
+        return nullptr;
+    }
 
-    private:
-        std::vector<std::unique_ptr<ICameraCoreBuilder>> &m_coreBuilders;
-        std::shared_ptr<IProcessingParameterMapFactory> m_paramFactory;
-        royale::CameraAccessLevel m_accessLevel;
-    };
+    /**
+     * Thread function for probing a single device.
+     */
+    void runDeviceProbe (DeviceProbe *probe,
+                         std::shared_ptr<IProcessingParameterMapFactory> paramFactory,
+                         royale::CameraAccessLevel accessLevel)
+    {
+        try
+        {
+            probe->coreBuilder = createCoreBuilder (probe->pd, std::move (probe->bridgeFactory), paramFactory, accessLevel);
+        }
+        catch (...)
+        {
+            LOG (WARN) << "Unexpected error while probing a device";
+        }
+    }
 
     /**
      * The BridgeAmundsen implementation may also be used with UVC devices; however on some operating systems the
@@ -124,14 +155,14 @@ namespace
 #if defined(ROYALE_BRIDGE_AMUNDSEN)
 #if defined(TARGET_PLATFORM_ANDROID)
     void probeAmundsenDevices (
-        CameraCoreBuilderInserter &appendCoreBuilder,
+        const BridgeController::ProbeCallback &appendCoreBuilder,
         uint32_t androidUsbDeviceFD,
         uint32_t androidUsbDeviceVid,
         uint32_t androidUsbDevicePid,
         UsbProbeDataList &probeListAmundsen)
 #else
     void probeAmundsenDevices (
-        CameraCoreBuilderInserter &appendCoreBuilder,
+        const BridgeController::ProbeCallback &appendCoreBuilder,
         UsbProbeDataList &probeListAmundsen)
 #endif
     {
@@ -172,55 +203,72 @@ std::vector<std::unique_ptr<ICameraCoreBuilder>> BridgeController::probeDevices
 std::vector<std::unique_ptr<ICameraCoreBuilder>> BridgeController::probeDevices (royale::CameraAccessLevel accessLevel)
 #endif
 {
-    std::vector<std::unique_ptr<ICameraCoreBuilder> > deviceList;
-    CameraCoreBuilderInserter appendCoreBuilder (deviceList, m_paramFactory, accessLevel);
+    std::vector<BusEnumeration> enumerations;
     royale::device::ProbeResultInfo probeResultInfo;
 
 #if defined(ROYALE_BRIDGE_AMUNDSEN)
     auto probeListAmundsen = filterUsbProbeDataByBridgeType (m_probeData, BridgeType::AMUNDSEN);
+    enumerations.push_back ([&] (const ProbeCallback & appendCoreBuilder)
+    {
 #if defined(TARGET_PLATFORM_ANDROID)
-    probeAmundsenDevices (appendCoreBuilder, androidUsbDeviceFD, androidUsbDeviceVid,
-                          androidUsbDevicePid, probeListAmundsen);
+        probeAmundsenDevices (appendCoreBuilder, androidUsbDeviceFD, androidUsbDeviceVid,
+                              androidUsbDevicePid, probeListAmundsen);
 #else
-    probeAmundsenDevices (appendCoreBuilder, probeListAmundsen);
+        probeAmundsenDevices (appendCoreBuilder, probeListAmundsen);
 #endif
+    });
 #endif
 
 #if defined(ROYALE_BRIDGE_ENCLUSTRA)
     auto probeListEnclustra = filterUsbProbeDataByBridgeType (m_probeData, BridgeType::ENCLUSTRA);
+    enumerations.push_back ([&] (const ProbeCallback & appendCoreBuilder)
+    {
 #if defined(ROYALE_BRIDGE_ENCLUSTRA_LIBUSB)
 #if defined(TARGET_PLATFORM_ANDROID)
-    BusEnumeratorEnclustraLibUsb (probeListEnclustra).enumerateDevices (appendCoreBuilder, androidUsbDeviceFD,
-            androidUsbDeviceVid, androidUsbDevicePid);
+        BusEnumeratorEnclustraLibUsb (probeListEnclustra).enumerateDevices (appendCoreBuilder, androidUsbDeviceFD,
+                androidUsbDeviceVid, androidUsbDevicePid);
 #else
-    BusEnumeratorEnclustraLibUsb (probeListEnclustra).enumerateDevices (appendCoreBuilder);
+        BusEnumeratorEnclustraLibUsb (probeListEnclustra).enumerateDevices (appendCoreBuilder);
 #endif
 #endif
 #if defined(ROYALE_BRIDGE_ENCLUSTRA_CYAPI)
-    BusEnumeratorEnclustraCyApi (probeListEnclustra).enumerateDevices (appendCoreBuilder);
+        BusEnumeratorEnclustraCyApi (probeListEnclustra).enumerateDevices (appendCoreBuilder);
 #endif
+    });
 #endif
 
 #if defined(ROYALE_BRIDGE_UVC)
     auto probeListUVC = filterUsbProbeDataByBridgeType (m_probeData, BridgeType::UVC);
+    enumerations.push_back ([&] (const ProbeCallback & appendCoreBuilder)
+    {
 #if defined(ROYALE_BRIDGE_UVC_DIRECTSHOW)
-    BusEnumeratorUvcDirectShow busEnumeratorUvcDirectShow (probeListUVC);
+        BusEnumeratorUvcDirectShow busEnumeratorUvcDirectShow (probeListUVC);
 
-    busEnumeratorUvcDirectShow.enumerateDevicesWithInfo (appendCoreBuilder, &probeResultInfo);
+        busEnumeratorUvcDirectShow.enumerateDevicesWithInfo (appendCoreBuilder, &probeResultInfo);
 #endif
 #if defined(ROYALE_BRIDGE_UVC_AMUNDSEN)
 #if defined(TARGET_PLATFORM_ANDROID)
-    probeAmundsenDevices (appendCoreBuilder, androidUsbDeviceFD, androidUsbDeviceVid,
-                          androidUsbDevicePid, probeListUVC);
+        probeAmundsenDevices (appendCoreBuilder, androidUsbDeviceFD, androidUsbDeviceVid,
+                              androidUsbDevicePid, probeListUVC);
 #else
-    probeAmundsenDevices (appendCoreBuilder, probeListUVC);
+        probeAmundsenDevices (appendCoreBuilder, probeListUVC);
 #endif
 #endif
 #if defined(ROYALE_BRIDGE_UVC_V4L)
-    BusEnumeratorUvcV4l (probeListUVC).enumerateDevices (appendCoreBuilder);
+        BusEnumeratorUvcV4l (probeListUVC).enumerateDevices (appendCoreBuilder);
 #endif
+    });
 #endif
 
+#if defined(ROYALE_BRIDGE_UVC_DIRECTSHOW) || defined(TARGET_PLATFORM_ANDROID)
+    // DirectShow's COM objects belong to the apartment of the calling thread, and on Android all
+    // enumerators open the device through the same androidUsbDeviceFD
+    const bool concurrent = false;
+#else
+    const bool concurrent = true;
+#endif
+    auto deviceList = probeDevices (enumerations, accessLevel, concurrent);
+
     if (m_listener && deviceList.empty() &&
             probeResultInfo.devicesWereFound())
     {
@@ -234,6 +282,93 @@ std::vector<std::unique_ptr<ICameraCoreBuilder>> BridgeController::probeDevices
     return deviceList;
 }
 
+std::vector<std::unique_ptr<ICameraCoreBuilder>> BridgeController::probeDevices (const std::vector<BusEnumeration> &enumerations,
+        royale::CameraAccessLevel accessLevel, bool concurrent)
+{
+    // Each enumerator collects the devices in its own list, so that the order of the devices
+    // doesn't depend on the timing of the threads
+    std::vector<DeviceProbeList> foundDevices (enumerations.size());
+    const auto enumerate = [&enumerations, &foundDevices] (std::size_t i)
+    {
+        auto &devices = foundDevices[i];
+        enumerations[i] ([&devices] (const UsbProbeData & pd, std::unique_ptr<IBridgeFactory> bridgeFactory)
+        {
+            devices.push_back (common::makeUnique<DeviceProbe> (pd, std::move (bridgeFactory)));
+        });
+    };
+
+    if (concurrent)
+    {
+        std::vector<std::future<void>> enumerating;
+        for (std::size_t i = 0; i < enumerations.size(); ++i)
+        {
+            enumerating.push_back (std::async (std::launch::async, enumerate, i));
+        }
+        // Rethrows the exception if one of the enumerators failed, the destructors of the
+        // remaining futures wait for the other enumerators
+        for (auto &enumeration : enumerating)
+        {
+            enumeration.get();
+        }
+    }
+    else
+    {
+        for (std::size_t i = 0; i < enumerations.size(); ++i)
+        {
+            enumerate (i);
+        }
+    }
+
+    DeviceProbeList probes;
+    for (auto &devices : foundDevices)
+    {
+        for (auto &device : devices)
+        {
+            probes.push_back (std::move (device));
+        }
+    }
+
+    if (concurrent)
+    {
+        std::vector<std::thread> probeThreads;
+        probeThreads.reserve (probes.size());
+        for (const auto &probe : probes)
+        {
+            try
+            {
+                probeThreads.emplace_back (runDeviceProbe, probe.get(), m_paramFactory, accessLevel);
+            }
+            catch (const std::system_error &)
+            {
+                // No more threads can be started, so probe this device in the calling thread
+                runDeviceProbe (probe.get(), m_paramFactory, accessLevel);
+            }
+        }
+        for (auto &thread : probeThreads)
+        {
+            thread.join();
+        }
+    }
+    else
+    {
+        for (const auto &probe : probes)
+        {
+            runDeviceProbe (probe.get(), m_paramFactory, accessLevel);
+        }
+    }
+
+    std::vector<std::unique_ptr<ICameraCoreBuilder> > deviceList;
+    for (const auto &probe : probes)
+    {
+        if (probe->coreBuilder)
+        {
+            deviceList.push_back (std::move (probe->coreBuilder));
+        }
+    }
+
+    return deviceList;
+}
+
 void BridgeController::setEventListener (std::shared_ptr<royale::IEventListener> listener)
 {
     m_listener = listener;
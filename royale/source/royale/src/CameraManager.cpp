@@ -36,7 +36,7 @@ struct CameraManager::CameraManagerData
 {
     CameraManagerData() :
         //accessLevel (CameraAccessLevel::L1)
-        accessLevel (CameraAccessLevel::L3)
+        accessLevel (CameraAccessLevel::L3),
         eventQueue (std::make_shared<royale::EventQueue> ())
     {
     }
@@ -0,0 +1,255 @@
+/****************************************************************************\
+ * Copyright (C) 2019 pmdtechnologies ag
+ *
+ * THIS CODE AND INFORMATION ARE PROVIDED "AS IS" WITHOUT WARRANTY OF ANY
+ * KIND, EITHER EXPRESSED OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND/OR FITNESS FOR A
+ * PARTICULAR PURPOSE.
+ *
+ \****************************************************************************/
+
+#include <common/exceptions/CouldNotOpen.hpp>
+#include <common/MakeUnique.hpp>
+#include <factory/BridgeController.hpp>
+#include <factory/IModuleConfigFactory.hpp>
+#include <modules/UsbProbeDataListRoyale.hpp>
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <chrono>
+#include <mutex>
+#include <thread>
+
+using namespace royale;
+using namespace royale::factory;
+using namespace royale::config;
+using namespace royale::usb::config;
+using namespace royale::common;
+
+/* Note: files in this directory that are named UnitTest* can run without hardware */
+
+namespace
+{
+    class TbcBridgeFactory : public IBridgeFactory
+    {
+    public:
+        explicit TbcBridgeFactory (int id) :
+            m_id (id)
+        {
+        }
+
+        void initialize() override
+        {
+        }
+
+        const int m_id;
+    };
+
+    /**
+     * Counts the probes that are running at the same time, shared by several
+     * TbcModuleConfigFactory instances.
+     */
+    class TbcProbeCounter
+    {
+    public:
+        void enter()
+        {
+            std::lock_guard<std::mutex> lock (m_mutex);
+            ++m_running;
+            m_peak = std::max (m_peak, m_running);
+        }
+
+        void leave()
+        {
+            std::lock_guard<std::mutex> lock (m_mutex);
+            --m_running;
+        }
+
+        /** The highest number of probes that were running at the same time */
+        int peak()
+        {
+            std::lock_guard<std::mutex> lock (m_mutex);
+            return m_peak;
+        }
+
+    private:
+        std::mutex m_mutex;
+        int m_running = 0;
+        int m_peak = 0;
+    };
+
+    /**
+     * Simulates a module config factory which reads the module's storage, by waiting for the
+     * given latency.
+     */
+    class TbcModuleConfigFactory : public IModuleConfigFactory
+    {
+    public:
+        TbcModuleConfigFactory (std::shared_ptr<const ModuleConfig> config, std::chrono::milliseconds latency,
+                                std::shared_ptr<TbcProbeCounter> counter = std::make_shared<TbcProbeCounter>()) :
+            m_config (config),
+            m_latency (latency),
+            m_counter (counter)
+        {
+        }
+
+        std::shared_ptr<const ModuleConfig> probeAndCreate (IBridgeFactory &bridgeFactory,
+                CameraAccessLevel accessLevel) const override
+        {
+            (void) bridgeFactory;
+            (void) accessLevel;
+            m_counter->enter();
+            std::this_thread::sleep_for (m_latency);
+            m_counter->leave();
+            return m_config;
+        }
+
+        royale::Vector<std::shared_ptr<const ModuleConfig>> enumerateConfigs() const override
+        {
+            return {};
+        }
+
+    private:
+        const std::shared_ptr<const ModuleConfig> m_config;
+        const std::chrono::milliseconds m_latency;
+        const std::shared_ptr<TbcProbeCounter> m_counter;
+    };
+
+    class UnitTestBridgeController : public ::testing::Test
+    {
+    protected:
+        void SetUp() override
+        {
+            // Any module that Royale supports will do, the configs are only passed through
+            for (const auto &pd : getUsbProbeDataRoyale())
+            {
+                const auto configs = pd.moduleConfigFactory->enumerateConfigs();
+                if (!configs.empty())
+                {
+                    m_bridgeType = pd.bridgeType;
+                    m_config = configs.at (0);
+                    break;
+                }
+            }
+            ASSERT_TRUE (m_config != nullptr);
+        }
+
+        UsbProbeData makeProbeData (const std::shared_ptr<IModuleConfigFactory> &moduleConfigFactory)
+        {
+            return UsbProbeData { 0x1c28, 0xc012, m_bridgeType, moduleConfigFactory };
+        }
+
+        /**
+         * An enumeration which takes the given time, and then finds a device for each of the
+         * probe data, with the bridge factories numbered from firstId.
+         */
+        BridgeController::BusEnumeration makeEnumeration (std::chrono::milliseconds latency, UsbProbeDataList probeData, int firstId)
+        {
+            return [latency, probeData, firstId] (const BridgeController::ProbeCallback & callback)
+            {
+                std::this_thread::sleep_for (latency);
+                auto id = firstId;
+                for (const auto &pd : probeData)
+                {
+                    callback (pd, makeUnique<TbcBridgeFactory> (id++));
+                }
+            };
+        }
+
+        static std::vector<int> getIds (std::vector<std::unique_ptr<ICameraCoreBuilder>> &devices)
+        {
+            std::vector<int> ids;
+            for (auto &device : devices)
+            {
+                auto bridgeFactory = dynamic_cast<TbcBridgeFactory *> (&device->getBridgeFactory());
+                ids.push_back (bridgeFactory ? bridgeFactory->m_id : -1);
+            }
+            return ids;
+        }
+
+        BridgeController makeController()
+        {
+            return BridgeController (UsbProbeDataList(), getProcessingParameterMapFactoryRoyale());
+        }
+
+        BridgeType m_bridgeType;
+        std::shared_ptr<const ModuleConfig> m_config;
+    };
+}
+
+/**
+ * The devices are probed concurrently, but returned in the order of the enumerations and of the
+ * devices within each enumeration, even if the first devices are the slowest.
+ */
+TEST_F (UnitTestBridgeController, ParallelProbing)
+{
+    auto counter = std::make_shared<TbcProbeCounter>();
+    auto slow = std::make_shared<TbcModuleConfigFactory> (m_config, std::chrono::milliseconds (300), counter);
+    auto fast = std::make_shared<TbcModuleConfigFactory> (m_config, std::chrono::milliseconds (10), counter);
+
+    std::vector<BridgeController::BusEnumeration> enumerations;
+    enumerations.push_back (makeEnumeration (std::chrono::milliseconds (100), { makeProbeData (slow), makeProbeData (fast) }, 0));
+    enumerations.push_back (makeEnumeration (std::chrono::milliseconds (100), { makeProbeData (slow), makeProbeData (slow) }, 2));
+
+    auto controller = makeController();
+    auto devices = controller.probeDevices (enumerations, CameraAccessLevel::L1);
+
+    EXPECT_EQ ( (std::vector<int> {0, 1, 2, 3}), getIds (devices));
+    EXPECT_GT (counter->peak(), 1);
+}
+
+/**
+ * Without concurrency (as used for DirectShow and Android) the devices are probed one after
+ * another, and returned in the same order.
+ */
+TEST_F (UnitTestBridgeController, SequentialProbing)
+{
+    auto counter = std::make_shared<TbcProbeCounter>();
+    auto slow = std::make_shared<TbcModuleConfigFactory> (m_config, std::chrono::milliseconds (30), counter);
+    auto fast = std::make_shared<TbcModuleConfigFactory> (m_config, std::chrono::milliseconds (0), counter);
+
+    std::vector<BridgeController::BusEnumeration> enumerations;
+    enumerations.push_back (makeEnumeration (std::chrono::milliseconds (0), { makeProbeData (slow), makeProbeData (fast) }, 0));
+    enumerations.push_back (makeEnumeration (std::chrono::milliseconds (0), { makeProbeData (slow) }, 2));
+
+    auto controller = makeController();
+    auto devices = controller.probeDevices (enumerations, CameraAccessLevel::L1, false);
+
+    EXPECT_EQ ( (std::vector<int> {0, 1, 2}), getIds (devices));
+    EXPECT_EQ (1, counter->peak());
+}
+
+/**
+ * A device whose module config can't be determined is left out, without affecting the others.
+ */
+TEST_F (UnitTestBridgeController, ProbeFailure)
+{
+    auto good = std::make_shared<TbcModuleConfigFactory> (m_config, std::chrono::milliseconds (10));
+    auto bad = std::make_shared<TbcModuleConfigFactory> (nullptr, std::chrono::milliseconds (10));
+
+    std::vector<BridgeController::BusEnumeration> enumerations;
+    enumerations.push_back (makeEnumeration (std::chrono::milliseconds (0), { makeProbeData (good), makeProbeData (bad), makeProbeData (good) }, 0));
+
+    auto controller = makeController();
+    auto devices = controller.probeDevices (enumerations, CameraAccessLevel::L1);
+    EXPECT_EQ ( (std::vector<int> {0, 2}), getIds (devices));
+}
+
+/**
+ * An error in one of the bus enumerators is passed on to the caller.
+ */
+TEST_F (UnitTestBridgeController, EnumerationError)
+{
+    auto good = std::make_shared<TbcModuleConfigFactory> (m_config, std::chrono::milliseconds (0));
+
+    std::vector<BridgeController::BusEnumeration> enumerations;
+    enumerations.push_back (makeEnumeration (std::chrono::milliseconds (0), { makeProbeData (good) }, 0));
+    enumerations.push_back ([] (const BridgeController::ProbeCallback &)
+    {
+        throw CouldNotOpen ("Error in enumerating devices");
+    });
+
+    auto controller = makeController();
+    EXPECT_THROW (controller.probeDevices (enumerations, CameraAccessLevel::L1), CouldNotOpen);
+}
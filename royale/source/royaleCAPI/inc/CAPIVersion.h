@@ -32,6 +32,9 @@
  * 32400 - C API as of Royale v3.24.0
  *         added royale_camera_device_set_filter_level
  *         added royale_camera_device_get_filter_level
+ * 33100 - C API as of Royale v3.31.0
+ *         added the frame ring (royale_camera_device_open_frame_ring, royale_frame_ring_acquire,
+ *         royale_frame_ring_release, ...) as an alternative to the depth data callback
  *
  * Older C API versions were already deprecated in previous releases and have now been removed.
  *
@@ -54,7 +57,7 @@
  */
 
 #ifndef ROYALE_C_API_VERSION
-#define ROYALE_C_API_VERSION 32400
+#define ROYALE_C_API_VERSION 33100
 #endif
 
 /* old, now unsupported way of selecting API versions: */
@@ -92,7 +95,9 @@
  */
 #endif
 
-#if ROYALE_C_API_VERSION == 32400
+#if ROYALE_C_API_VERSION == 33100
+#include <CAPIVersion33100.h>
+#elif ROYALE_C_API_VERSION == 32400
 #include <CAPIVersion32400.h>
 #elif ROYALE_C_API_VERSION == 31000
 #include <CAPIVersion31000.h>
@@ -24,6 +24,7 @@
 #include <SparsePointCloudCAPI.h>
 #include <ExposureModeCAPI.h>
 #include <FilterLevelCAPI.h>
+#include <FrameRingCAPI.h>
 #include <RecordCAPI.h>
 #include <ExposureCAPI.h>
 #include <StatusCAPI.h>
@@ -430,6 +431,61 @@ ROYALE_CAPI royale_camera_status royale_camera_device_set_filter_level_v32400 (r
 */
 ROYALE_CAPI royale_camera_status royale_camera_device_get_filter_level_v32400 (royale_camera_handle handle, royale_stream_id stream_id, royale_filter_level *filter_level);
 
+/**
+* Opens a frame ring for the depth data of the camera device. Instead of receiving the depth
+* data in a callback, the application takes the frames out of the ring with
+* royale_frame_ring_acquire() whenever it is ready for the next one.
+*
+* The ring consists of capacity preallocated slots. If all slots hold frames that were not
+* acquired yet, the oldest of these frames is overwritten by the new one. If the application
+* holds all slots, new frames are discarded until a slot is released. Both cases are counted,
+* see royale_frame_ring_get_stats().
+*
+* The ring takes the place of the depth data listener: a previously registered
+* ROYALE_DEPTH_DATA_CALLBACK is unregistered, and registering a callback or calling
+* royale_camera_device_unregister_data_listener() closes the ring.
+*
+* @param[in] handle camera device instance handle.
+* @param[in] capacity number of slots, at least 1. A capacity of 2 or more allows the camera
+*            device to deliver the next frame while the application works on the previous one.
+*/
+ROYALE_CAPI royale_camera_status royale_camera_device_open_frame_ring_v33100 (royale_camera_handle handle, uint32_t capacity);
+
+/**
+* Closes the frame ring of the camera device. Frames that are still acquired must not be
+* accessed after this call. A thread that waits in royale_frame_ring_acquire() returns with
+* ROYALE_STATUS_DATA_NOT_FOUND.
+* @param[in] handle camera device instance handle.
+*/
+ROYALE_CAPI royale_camera_status royale_camera_device_close_frame_ring_v33100 (royale_camera_handle handle);
+
+/**
+* Takes the oldest frame out of the frame ring. The data stays valid and unchanged until it is
+* given back with royale_frame_ring_release(), the ring doesn't write to acquired slots.
+*
+* Returns ROYALE_STATUS_TIMEOUT if no frame arrives within the timeout and
+* ROYALE_STATUS_DATA_NOT_FOUND if no ring is open.
+*
+* @param[in] handle camera device instance handle.
+* @param[in] timeout_ms time to wait for a frame in milliseconds, 0 returns immediately.
+* @param[out] data pointer to the depth data in the ring.
+*/
+ROYALE_CAPI royale_camera_status royale_frame_ring_acquire_v33100 (royale_camera_handle handle, uint32_t timeout_ms, royale_depth_data **data);
+
+/**
+* Gives a frame that was returned by royale_frame_ring_acquire() back to the ring.
+* @param[in] handle camera device instance handle.
+* @param[in] data the pointer returned by royale_frame_ring_acquire().
+*/
+ROYALE_CAPI royale_camera_status royale_frame_ring_release_v33100 (royale_camera_handle handle, royale_depth_data *data);
+
+/**
+* Retrieves the counters of the frame ring since it was opened.
+* @param[in] handle camera device instance handle.
+* @param[out] stats pointer where the counters should be written to.
+*/
+ROYALE_CAPI royale_camera_status royale_frame_ring_get_stats_v33100 (royale_camera_handle handle, royale_frame_ring_stats *stats);
+
 // ----------------------------------------------------------------------------------------------
 // Level 2: Experienced users (Laser Class 1 guaranteed) - activation key required
 // ----------------------------------------------------------------------------------------------
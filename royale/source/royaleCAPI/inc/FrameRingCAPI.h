@@ -0,0 +1,38 @@
+/****************************************************************************\
+* Copyright (C) 2019 pmdtechnologies ag
+*
+* THIS CODE AND INFORMATION ARE PROVIDED "AS IS" WITHOUT WARRANTY OF ANY
+* KIND, EITHER EXPRESSED OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE
+* IMPLIED WARRANTIES OF MERCHANTABILITY AND/OR FITNESS FOR A
+* PARTICULAR PURPOSE.
+*
+\****************************************************************************/
+
+/**
+* \addtogroup royaleCAPI
+* @{
+*/
+
+#pragma once
+
+#include <DefinitionsCAPI.h>
+#include <stdint.h>
+
+ROYALE_CAPI_LINKAGE_TOP
+
+/**
+* Counters of a frame ring, see royale_frame_ring_get_stats().
+*
+* Every frame that is received is either acquired, overwritten or discarded (or is still
+* waiting in the ring).
+*/
+typedef struct
+{
+    uint64_t    frames_received;    //!< depth data frames that the camera device delivered to the ring
+    uint64_t    frames_acquired;    //!< frames that were returned by royale_frame_ring_acquire()
+    uint64_t    frames_overwritten; //!< frames that were dropped, because a newer frame arrived while all other slots were waiting to be acquired
+    uint64_t    frames_discarded;   //!< new frames that were dropped, because the application held all slots of the ring
+} royale_frame_ring_stats;
+
+ROYALE_CAPI_LINKAGE_BOTTOM
+/** @}*/
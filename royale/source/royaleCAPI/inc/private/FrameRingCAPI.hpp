@@ -0,0 +1,93 @@
+/****************************************************************************\
+* Copyright (C) 2019 pmdtechnologies ag
+*
+* THIS CODE AND INFORMATION ARE PROVIDED "AS IS" WITHOUT WARRANTY OF ANY
+* KIND, EITHER EXPRESSED OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE
+* IMPLIED WARRANTIES OF MERCHANTABILITY AND/OR FITNESS FOR A
+* PARTICULAR PURPOSE.
+*
+\****************************************************************************/
+
+#pragma once
+
+#include <DepthDataCAPI.h>
+#include <FrameRingCAPI.h>
+#include <StatusCAPI.h>
+#include <royale/IDepthDataListener.hpp>
+
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <mutex>
+#include <vector>
+
+/**
+ * Depth data listener that copies each frame into one of a fixed number of slots, from where
+ * the application takes them with acquire() and gives them back with release().
+ *
+ * The copy is made on the processing thread, into memory that is allocated once when the ring
+ * is created; the application reads the slots in place.
+ */
+class FrameRingCAPI : public royale::IDepthDataListener
+{
+public:
+    /**
+     * @param capacity number of slots
+     * @param maxPoints number of points each slot is allocated for, larger frames cause a
+     *        reallocation of the slot
+     */
+    FrameRingCAPI (std::size_t capacity, std::size_t maxPoints);
+
+    void onNewData (const royale::DepthData *data) override;
+
+    /**
+     * Waits until a frame is available, and hands out the oldest one.  Returns
+     * ROYALE_STATUS_TIMEOUT if there is none after timeoutMs, and ROYALE_STATUS_DATA_NOT_FOUND
+     * if the ring was closed.
+     */
+    royale_camera_status acquire (uint32_t timeoutMs, royale_depth_data **data);
+
+    /**
+     * Returns a slot from acquire() to the ring.  Returns ROYALE_STATUS_INVALID_VALUE if data
+     * is not currently acquired from this ring.
+     */
+    royale_camera_status release (const royale_depth_data *data);
+
+    /**
+     * Wakes all threads that are waiting in acquire(), further calls to acquire() fail.
+     */
+    void close();
+
+    royale_frame_ring_stats getStats();
+
+private:
+    enum class SlotState
+    {
+        FREE,
+        WRITING,
+        READY,
+        ACQUIRED
+    };
+
+    struct Slot
+    {
+        SlotState state = SlotState::FREE;
+        std::vector<royale_depth_point> points;
+        std::vector<uint32_t> exposureTimes;
+        royale_depth_data data;
+    };
+
+    /**
+     * Chooses the slot for the next frame, or returns nullptr if the frame is discarded.
+     * Must be called with m_lock held.
+     */
+    Slot *takeSlotForWriting();
+
+    std::mutex m_lock;
+    std::condition_variable m_frameAvailable;
+    std::vector<Slot> m_slots;
+    /** Slots in the READY state, oldest frame first */
+    std::deque<Slot *> m_ready;
+    bool m_closed;
+    royale_frame_ring_stats m_stats;
+};
@@ -22,6 +22,7 @@
 #include <private/EventListenerCAPI.hpp>
 #include <private/RecordStopListenerCAPI.hpp>
 #include <private/ExposureListenerCAPI.hpp>
+#include <private/FrameRingCAPI.hpp>
 #include <private/ProcessingParametersConverterCAPI.hpp>
 #include <private/HelperFunctionsCAPI.hpp>
 
@@ -42,6 +43,9 @@ std::map<royale_camera_handle, std::unique_ptr<royale::IExtendedDataListener>> m
 std::map<royale_camera_handle, std::unique_ptr<royale::IIRImageListener>> m_irImageListenerMap;
 std::map<royale_camera_handle, std::unique_ptr<royale::IRecordStopListener>> m_recordStopListenerMap;
 std::map<royale_camera_handle, std::unique_ptr<royale::ISparsePointCloudListener>> m_spcListenerMap;
+// a frame ring is registered as the depth data listener, the shared_ptr keeps it alive while
+// another thread is waiting in royale_frame_ring_acquire
+std::map<royale_camera_handle, std::shared_ptr<FrameRingCAPI>> m_frameRingMap;
 
 royale_camera_handle royale_camera_device_create (std::shared_ptr<royale::ICameraDevice> cameraInstance)
 {
@@ -58,6 +62,28 @@ template<typename T> void delete_previously_created_listener (royale_camera_hand
     }
 }
 
+static std::shared_ptr<FrameRingCAPI> get_frame_ring (royale_camera_handle handle)
+{
+    std::lock_guard<std::mutex> lock (m_listenerMapLock);
+    auto it = m_frameRingMap.find (handle);
+    if (it == m_frameRingMap.end())
+    {
+        return nullptr;
+    }
+    return it->second;
+}
+
+static void close_frame_ring (royale_camera_handle handle)
+{
+    std::lock_guard<std::mutex> lock (m_listenerMapLock);
+    auto it = m_frameRingMap.find (handle);
+    if (it != m_frameRingMap.end())
+    {
+        it->second->close();
+        m_frameRingMap.erase (it);
+    }
+}
+
 ROYALE_CAPI_LINKAGE_TOP
 
 // ----------------------------------------------------------------------------------------------
@@ -68,7 +94,10 @@ ROYALE_CAPI void royale_camera_device_destroy_v210 (royale_camera_handle handle)
 {
     GET_INSTANCE_AND_RETURN_VALUE_IF_NULL ( (void) 0);
 
+    // The ring is the device's data listener, it must not be destroyed before the device has
+    // stopped capturing
     m_instanceManager.DeleteInstance (handle);
+    close_frame_ring (handle);
 }
 
 ROYALE_CAPI royale_camera_status royale_camera_device_initialize_v210 (royale_camera_handle handle)
@@ -398,6 +427,7 @@ ROYALE_CAPI royale_camera_status royale_camera_device_unregister_data_listener_v
     if (status == ROYALE_STATUS_SUCCESS)
     {
         delete_previously_created_listener<royale::IDepthDataListener> (handle, m_depthDataListenerMap);
+        close_frame_ring (handle);
     }
 
     return status;
@@ -696,6 +726,94 @@ ROYALE_CAPI royale_camera_status royale_camera_device_get_filter_level_v32400 (r
     return (royale_camera_status) status;
 }
 
+ROYALE_CAPI royale_camera_status royale_camera_device_open_frame_ring_v33100 (royale_camera_handle handle, uint32_t capacity)
+{
+    GET_INSTANCE_AND_RETURN_VALUE_IF_NULL (ROYALE_STATUS_INVALID_HANDLE);
+
+    if (capacity == 0)
+    {
+        return ROYALE_STATUS_INVALID_VALUE;
+    }
+
+    auto status = royale_camera_device_unregister_data_listener (handle);
+    if (status == ROYALE_STATUS_SUCCESS)
+    {
+        // allocate the slots for the full sensor, if the size isn't known yet they grow with the
+        // first frames
+        uint16_t maxWidth = 0;
+        uint16_t maxHeight = 0;
+        if (instance->getMaxSensorWidth (maxWidth) != CameraStatus::SUCCESS ||
+                instance->getMaxSensorHeight (maxHeight) != CameraStatus::SUCCESS)
+        {
+            maxWidth = 0;
+            maxHeight = 0;
+        }
+
+        auto ring = std::make_shared<FrameRingCAPI> (capacity, static_cast<std::size_t> (maxWidth) * maxHeight);
+        status = (royale_camera_status) instance->registerDataListener (ring.get());
+
+        if (ROYALE_STATUS_SUCCESS == status)
+        {
+            std::lock_guard<std::mutex> lock (m_listenerMapLock);
+            m_frameRingMap[handle] = std::move (ring);
+        }
+    }
+
+    return status;
+}
+
+ROYALE_CAPI royale_camera_status royale_camera_device_close_frame_ring_v33100 (royale_camera_handle handle)
+{
+    GET_INSTANCE_AND_RETURN_VALUE_IF_NULL (ROYALE_STATUS_INVALID_HANDLE);
+
+    if (get_frame_ring (handle) == nullptr)
+    {
+        return ROYALE_STATUS_DATA_NOT_FOUND;
+    }
+
+    return royale_camera_device_unregister_data_listener (handle);
+}
+
+ROYALE_CAPI royale_camera_status royale_frame_ring_acquire_v33100 (royale_camera_handle handle, uint32_t timeout_ms, royale_depth_data **data)
+{
+    GET_INSTANCE_AND_RETURN_VALUE_IF_NULL (ROYALE_STATUS_INVALID_HANDLE);
+
+    auto ring = get_frame_ring (handle);
+    if (ring == nullptr)
+    {
+        return ROYALE_STATUS_DATA_NOT_FOUND;
+    }
+
+    return ring->acquire (timeout_ms, data);
+}
+
+ROYALE_CAPI royale_camera_status royale_frame_ring_release_v33100 (royale_camera_handle handle, royale_depth_data *data)
+{
+    GET_INSTANCE_AND_RETURN_VALUE_IF_NULL (ROYALE_STATUS_INVALID_HANDLE);
+
+    auto ring = get_frame_ring (handle);
+    if (ring == nullptr)
+    {
+        return ROYALE_STATUS_DATA_NOT_FOUND;
+    }
+
+    return ring->release (data);
+}
+
+ROYALE_CAPI royale_camera_status royale_frame_ring_get_stats_v33100 (royale_camera_handle handle, royale_frame_ring_stats *stats)
+{
+    GET_INSTANCE_AND_RETURN_VALUE_IF_NULL (ROYALE_STATUS_INVALID_HANDLE);
+
+    auto ring = get_frame_ring (handle);
+    if (ring == nullptr)
+    {
+        return ROYALE_STATUS_DATA_NOT_FOUND;
+    }
+
+    *stats = ring->getStats();
+    return ROYALE_STATUS_SUCCESS;
+}
+
 // ----------------------------------------------------------------------------------------------
 // Level 2: Experienced users (Laser Class 1 guaranteed) - activation key required
 // ----------------------------------------------------------------------------------------------
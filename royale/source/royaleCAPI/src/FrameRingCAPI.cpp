@@ -0,0 +1,148 @@
+/****************************************************************************\
+* Copyright (C) 2019 pmdtechnologies ag
+*
+* THIS CODE AND INFORMATION ARE PROVIDED "AS IS" WITHOUT WARRANTY OF ANY
+* KIND, EITHER EXPRESSED OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE
+* IMPLIED WARRANTIES OF MERCHANTABILITY AND/OR FITNESS FOR A
+* PARTICULAR PURPOSE.
+*
+\****************************************************************************/
+
+#include <private/FrameRingCAPI.hpp>
+
+#include <chrono>
+
+static_assert (sizeof (royale_depth_point) == sizeof (royale::DepthPoint),
+               "royale_depth_point must match royale::DepthPoint");
+
+FrameRingCAPI::FrameRingCAPI (std::size_t capacity, std::size_t maxPoints) :
+    m_slots (capacity),
+    m_closed (false),
+    m_stats ()
+{
+    for (auto &slot : m_slots)
+    {
+        slot.points.reserve (maxPoints);
+        slot.data = royale_depth_data ();
+    }
+}
+
+FrameRingCAPI::Slot *FrameRingCAPI::takeSlotForWriting()
+{
+    for (auto &slot : m_slots)
+    {
+        if (slot.state == SlotState::FREE)
+        {
+            return &slot;
+        }
+    }
+
+    if (!m_ready.empty())
+    {
+        auto slot = m_ready.front();
+        m_ready.pop_front();
+        m_stats.frames_overwritten++;
+        return slot;
+    }
+
+    m_stats.frames_discarded++;
+    return nullptr;
+}
+
+void FrameRingCAPI::onNewData (const royale::DepthData *data)
+{
+    Slot *slot;
+    {
+        std::lock_guard<std::mutex> lock (m_lock);
+        m_stats.frames_received++;
+        slot = takeSlotForWriting();
+        if (slot == nullptr)
+        {
+            return;
+        }
+        slot->state = SlotState::WRITING;
+    }
+
+    // The slot isn't visible to acquire() while it's in the WRITING state, so the copy doesn't
+    // need the lock.  The vectors keep their capacity, after the first frames this doesn't
+    // allocate.
+    const auto points = reinterpret_cast<const royale_depth_point *> (data->points.data());
+    slot->points.assign (points, points + data->points.size());
+    slot->exposureTimes.assign (data->exposureTimes.begin(), data->exposureTimes.end());
+
+    auto &dd = slot->data;
+    dd.version = data->version;
+    dd.timestamp = data->timeStamp.count();
+    dd.stream_id = data->streamId;
+    dd.width = data->width;
+    dd.height = data->height;
+    dd.nr_exposure_times = static_cast<uint32_t> (slot->exposureTimes.size());
+    dd.exposure_times = slot->exposureTimes.data();
+    dd.nr_points = static_cast<uint32_t> (slot->points.size());
+    dd.points = slot->points.data();
+
+    {
+        std::lock_guard<std::mutex> lock (m_lock);
+        slot->state = SlotState::READY;
+        m_ready.push_back (slot);
+    }
+    m_frameAvailable.notify_one();
+}
+
+royale_camera_status FrameRingCAPI::acquire (uint32_t timeoutMs, royale_depth_data **data)
+{
+    std::unique_lock<std::mutex> lock (m_lock);
+    const auto ready = m_frameAvailable.wait_for (lock, std::chrono::milliseconds (timeoutMs), [this]
+    {
+        return m_closed || !m_ready.empty();
+    });
+
+    if (m_closed)
+    {
+        return ROYALE_STATUS_DATA_NOT_FOUND;
+    }
+    if (!ready)
+    {
+        return ROYALE_STATUS_TIMEOUT;
+    }
+
+    auto slot = m_ready.front();
+    m_ready.pop_front();
+    slot->state = SlotState::ACQUIRED;
+    m_stats.frames_acquired++;
+    *data = &slot->data;
+    return ROYALE_STATUS_SUCCESS;
+}
+
+royale_camera_status FrameRingCAPI::release (const royale_depth_data *data)
+{
+    std::lock_guard<std::mutex> lock (m_lock);
+    for (auto &slot : m_slots)
+    {
+        if (&slot.data == data)
+        {
+            if (slot.state != SlotState::ACQUIRED)
+            {
+                break;
+            }
+            slot.state = SlotState::FREE;
+            return ROYALE_STATUS_SUCCESS;
+        }
+    }
+    return ROYALE_STATUS_INVALID_VALUE;
+}
+
+void FrameRingCAPI::close()
+{
+    {
+        std::lock_guard<std::mutex> lock (m_lock);
+        m_closed = true;
+    }
+    m_frameAvailable.notify_all();
+}
+
+royale_frame_ring_stats FrameRingCAPI::getStats()
+{
+    std::lock_guard<std::mutex> lock (m_lock);
+    return m_stats;
+}
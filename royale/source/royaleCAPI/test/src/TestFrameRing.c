@@ -0,0 +1,255 @@
+/****************************************************************************\
+* Copyright (C) 2019 pmdtechnologies ag
+*
+* THIS CODE AND INFORMATION ARE PROVIDED "AS IS" WITHOUT WARRANTY OF ANY
+* KIND, EITHER EXPRESSED OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE
+* IMPLIED WARRANTIES OF MERCHANTABILITY AND/OR FITNESS FOR A
+* PARTICULAR PURPOSE.
+*
+\****************************************************************************/
+
+#include <unity.h>
+#include <stdio.h>
+
+#include <royaleCAPI.h>
+#include <CameraManagerCAPI.h>
+#include <TestFrameRing.h>
+
+#ifdef _WINDOWS
+#include <Windows.h>
+#define TEST_SLEEP_MS(x)        Sleep(x)
+#else
+#include <unistd.h>
+#define TEST_SLEEP_MS(x)        usleep((x)*1000)
+#endif
+
+#define RRF_FILE_NAME           ROYALE_TEST_FILE_PATH "/ListenerTest.rrf"
+#define ACQUIRE_TIMEOUT_MS      5000
+#define STATS_TIMEOUT_MS        10000
+#define STATS_POLL_MS           20
+
+static royale_cam_manager_hnd man_hnd;
+static royale_camera_handle cam_hnd;
+
+static void open_playback (void)
+{
+    man_hnd = royale_camera_manager_create();
+    TEST_ASSERT_NOT_EQUAL_MESSAGE (0, man_hnd, "Failed to create camera manager.");
+
+    cam_hnd = royale_camera_manager_create_camera (man_hnd, RRF_FILE_NAME);
+    TEST_ASSERT_NOT_EQUAL_MESSAGE (0, cam_hnd, "Failed to open " RRF_FILE_NAME);
+
+    royale_camera_status status = royale_camera_device_initialize (cam_hnd);
+    TEST_ASSERT_EQUAL_MESSAGE (ROYALE_STATUS_SUCCESS, status, "Failed to initialize the playback.");
+}
+
+static void close_playback (void)
+{
+    royale_camera_device_destroy (cam_hnd);
+    royale_camera_manager_destroy (man_hnd);
+}
+
+static royale_frame_ring_stats get_stats (void)
+{
+    royale_frame_ring_stats stats;
+    royale_camera_status status = royale_frame_ring_get_stats (cam_hnd, &stats);
+    TEST_ASSERT_EQUAL_MESSAGE (ROYALE_STATUS_SUCCESS, status, "Failed to get the frame ring stats.");
+    return stats;
+}
+
+/**
+ * Captures until the ring has received at least count more frames, and stops the capture.
+ */
+static royale_frame_ring_stats capture_frames (uint64_t count)
+{
+    const uint64_t target = get_stats().frames_received + count;
+
+    royale_camera_status status = royale_camera_device_start_capture (cam_hnd);
+    TEST_ASSERT_EQUAL_MESSAGE (ROYALE_STATUS_SUCCESS, status, "Failed to start capturing.");
+
+    int waited = 0;
+    while (get_stats().frames_received < target && waited < STATS_TIMEOUT_MS)
+    {
+        TEST_SLEEP_MS (STATS_POLL_MS);
+        waited += STATS_POLL_MS;
+    }
+
+    status = royale_camera_device_stop_capture (cam_hnd);
+    TEST_ASSERT_EQUAL_MESSAGE (ROYALE_STATUS_SUCCESS, status, "Failed to stop capturing.");
+
+    royale_frame_ring_stats stats = get_stats();
+    TEST_ASSERT_TRUE_MESSAGE (stats.frames_received >= target, "Playback didn't deliver enough frames.");
+    return stats;
+}
+
+static void check_depth_data (const royale_depth_data *data)
+{
+    TEST_ASSERT_NOT_NULL (data);
+    TEST_ASSERT_NOT_EQUAL (0, data->width);
+    TEST_ASSERT_NOT_EQUAL (0, data->height);
+    TEST_ASSERT_EQUAL_UINT32 ( (uint32_t) data->width * data->height, data->nr_points);
+    TEST_ASSERT_NOT_NULL (data->points);
+    TEST_ASSERT_NOT_EQUAL (0, data->nr_exposure_times);
+    TEST_ASSERT_NOT_NULL (data->exposure_times);
+    TEST_ASSERT_NOT_EQUAL (0, data->timestamp);
+}
+
+void test_frame_ring_without_ring (void)
+{
+    royale_depth_data *data = NULL;
+    royale_frame_ring_stats stats;
+
+    TEST_ASSERT_EQUAL (ROYALE_STATUS_INVALID_HANDLE, royale_frame_ring_acquire (0, 0, &data));
+    TEST_ASSERT_EQUAL (ROYALE_STATUS_INVALID_HANDLE, royale_camera_device_open_frame_ring (0, 2));
+
+    open_playback();
+
+    TEST_ASSERT_EQUAL (ROYALE_STATUS_INVALID_VALUE, royale_camera_device_open_frame_ring (cam_hnd, 0));
+    TEST_ASSERT_EQUAL (ROYALE_STATUS_DATA_NOT_FOUND, royale_frame_ring_acquire (cam_hnd, 0, &data));
+    TEST_ASSERT_EQUAL (ROYALE_STATUS_DATA_NOT_FOUND, royale_frame_ring_release (cam_hnd, data));
+    TEST_ASSERT_EQUAL (ROYALE_STATUS_DATA_NOT_FOUND, royale_frame_ring_get_stats (cam_hnd, &stats));
+    TEST_ASSERT_EQUAL (ROYALE_STATUS_DATA_NOT_FOUND, royale_camera_device_close_frame_ring (cam_hnd));
+
+    close_playback();
+}
+
+void test_frame_ring_acquire_release (void)
+{
+    const uint32_t capacity = 3;
+    const int nr_frames = 10;
+
+    open_playback();
+
+    royale_camera_status status = royale_camera_device_open_frame_ring (cam_hnd, capacity);
+    TEST_ASSERT_EQUAL_MESSAGE (ROYALE_STATUS_SUCCESS, status, "Failed to open the frame ring.");
+
+    status = royale_camera_device_start_capture (cam_hnd);
+    TEST_ASSERT_EQUAL_MESSAGE (ROYALE_STATUS_SUCCESS, status, "Failed to start capturing.");
+
+    for (int i = 0; i < nr_frames; ++i)
+    {
+        royale_depth_data *data = NULL;
+        status = royale_frame_ring_acquire (cam_hnd, ACQUIRE_TIMEOUT_MS, &data);
+        TEST_ASSERT_EQUAL_MESSAGE (ROYALE_STATUS_SUCCESS, status, "Failed to acquire a frame.");
+        check_depth_data (data);
+
+        status = royale_frame_ring_release (cam_hnd, data);
+        TEST_ASSERT_EQUAL_MESSAGE (ROYALE_STATUS_SUCCESS, status, "Failed to release a frame.");
+        status = royale_frame_ring_release (cam_hnd, data);
+        TEST_ASSERT_EQUAL_MESSAGE (ROYALE_STATUS_INVALID_VALUE, status, "Released the same frame twice.");
+    }
+
+    status = royale_camera_device_stop_capture (cam_hnd);
+    TEST_ASSERT_EQUAL_MESSAGE (ROYALE_STATUS_SUCCESS, status, "Failed to stop capturing.");
+
+    // Every frame is either acquired, dropped or still waiting in the ring
+    royale_frame_ring_stats stats = get_stats();
+    TEST_ASSERT_EQUAL_UINT64 (nr_frames, stats.frames_acquired);
+    TEST_ASSERT_EQUAL_UINT64 (0, stats.frames_discarded);
+    const uint64_t waiting = stats.frames_received - stats.frames_acquired - stats.frames_overwritten;
+    TEST_ASSERT_TRUE (waiting <= capacity);
+
+    // The waiting frames can be acquired after the capture stopped
+    for (uint64_t i = 0; i < waiting; ++i)
+    {
+        royale_depth_data *data = NULL;
+        TEST_ASSERT_EQUAL (ROYALE_STATUS_SUCCESS, royale_frame_ring_acquire (cam_hnd, 0, &data));
+        TEST_ASSERT_EQUAL (ROYALE_STATUS_SUCCESS, royale_frame_ring_release (cam_hnd, data));
+    }
+
+    royale_depth_data *data = NULL;
+    TEST_ASSERT_EQUAL (ROYALE_STATUS_TIMEOUT, royale_frame_ring_acquire (cam_hnd, 0, &data));
+
+    status = royale_camera_device_close_frame_ring (cam_hnd);
+    TEST_ASSERT_EQUAL_MESSAGE (ROYALE_STATUS_SUCCESS, status, "Failed to close the frame ring.");
+    TEST_ASSERT_EQUAL (ROYALE_STATUS_DATA_NOT_FOUND, royale_frame_ring_acquire (cam_hnd, 0, &data));
+
+    close_playback();
+}
+
+void test_frame_ring_drop_oldest (void)
+{
+    const uint32_t capacity = 2;
+
+    open_playback();
+
+    royale_camera_status status = royale_camera_device_open_frame_ring (cam_hnd, capacity);
+    TEST_ASSERT_EQUAL_MESSAGE (ROYALE_STATUS_SUCCESS, status, "Failed to open the frame ring.");
+
+    // Nothing is acquired, the ring keeps the newest frames
+    royale_frame_ring_stats stats = capture_frames (3 * capacity);
+    TEST_ASSERT_EQUAL_UINT64 (stats.frames_received - capacity, stats.frames_overwritten);
+    TEST_ASSERT_EQUAL_UINT64 (0, stats.frames_discarded);
+
+    royale_depth_data *first = NULL;
+    royale_depth_data *second = NULL;
+    royale_depth_data *third = NULL;
+    TEST_ASSERT_EQUAL (ROYALE_STATUS_SUCCESS, royale_frame_ring_acquire (cam_hnd, 0, &first));
+    TEST_ASSERT_EQUAL (ROYALE_STATUS_SUCCESS, royale_frame_ring_acquire (cam_hnd, 0, &second));
+    TEST_ASSERT_EQUAL (ROYALE_STATUS_TIMEOUT, royale_frame_ring_acquire (cam_hnd, 0, &third));
+    check_depth_data (first);
+    check_depth_data (second);
+    TEST_ASSERT_TRUE (first != second);
+
+    // While the application holds all slots, new frames are discarded and the acquired data
+    // isn't changed
+    const long long first_timestamp = first->timestamp;
+    const long long second_timestamp = second->timestamp;
+    const royale_frame_ring_stats before = stats;
+    stats = capture_frames (3);
+    TEST_ASSERT_EQUAL_UINT64 (stats.frames_received - before.frames_received, stats.frames_discarded);
+    TEST_ASSERT_EQUAL_UINT64 (before.frames_overwritten, stats.frames_overwritten);
+    TEST_ASSERT_EQUAL (first_timestamp, first->timestamp);
+    TEST_ASSERT_EQUAL (second_timestamp, second->timestamp);
+    TEST_ASSERT_EQUAL (ROYALE_STATUS_TIMEOUT, royale_frame_ring_acquire (cam_hnd, 0, &third));
+
+    // After releasing a slot, it is used again
+    TEST_ASSERT_EQUAL (ROYALE_STATUS_SUCCESS, royale_frame_ring_release (cam_hnd, first));
+    capture_frames (1);
+    TEST_ASSERT_EQUAL (ROYALE_STATUS_SUCCESS, royale_frame_ring_acquire (cam_hnd, 0, &third));
+    TEST_ASSERT_TRUE (third == first);
+    check_depth_data (third);
+
+    TEST_ASSERT_EQUAL (ROYALE_STATUS_SUCCESS, royale_frame_ring_release (cam_hnd, second));
+    TEST_ASSERT_EQUAL (ROYALE_STATUS_SUCCESS, royale_frame_ring_release (cam_hnd, third));
+
+    // Unregistering the data listener closes the ring
+    status = royale_camera_device_unregister_data_listener (cam_hnd);
+    TEST_ASSERT_EQUAL (ROYALE_STATUS_SUCCESS, status);
+    TEST_ASSERT_EQUAL (ROYALE_STATUS_DATA_NOT_FOUND, royale_frame_ring_acquire (cam_hnd, 0, &third));
+
+    close_playback();
+}
+
+void test_frame_ring_destroy_while_capturing (void)
+{
+    for (int i = 0; i < 3; ++i)
+    {
+        open_playback();
+
+        royale_camera_status status = royale_camera_device_open_frame_ring (cam_hnd, 2);
+        TEST_ASSERT_EQUAL_MESSAGE (ROYALE_STATUS_SUCCESS, status, "Failed to open the frame ring.");
+
+        status = royale_camera_device_start_capture (cam_hnd);
+        TEST_ASSERT_EQUAL_MESSAGE (ROYALE_STATUS_SUCCESS, status, "Failed to start capturing.");
+
+        // Wait until frames arrive, and leave one of them acquired
+        royale_depth_data *data = NULL;
+        status = royale_frame_ring_acquire (cam_hnd, ACQUIRE_TIMEOUT_MS, &data);
+        TEST_ASSERT_EQUAL_MESSAGE (ROYALE_STATUS_SUCCESS, status, "Failed to acquire a frame.");
+
+        // Destroying the device stops the capture, the ring must stay valid until then
+        royale_camera_device_destroy (cam_hnd);
+        TEST_ASSERT_EQUAL (ROYALE_STATUS_INVALID_HANDLE, royale_frame_ring_acquire (cam_hnd, 0, &data));
+
+        royale_camera_manager_destroy (man_hnd);
+    }
+}
+
+void test_royaleCAPI_FrameRing (void)
+{
+    RUN_TEST (test_frame_ring_without_ring);
+    RUN_TEST (test_frame_ring_acquire_release);
+    RUN_TEST (test_frame_ring_drop_oldest);
+    RUN_TEST (test_frame_ring_destroy_while_capturing);
+}
@@ -0,0 +1,45 @@
+/****************************************************************************\
+* Copyright (C) 2019 pmdtechnologies ag
+*
+* THIS CODE AND INFORMATION ARE PROVIDED "AS IS" WITHOUT WARRANTY OF ANY
+* KIND, EITHER EXPRESSED OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE
+* IMPLIED WARRANTIES OF MERCHANTABILITY AND/OR FITNESS FOR A
+* PARTICULAR PURPOSE.
+*
+\****************************************************************************/
+
+#include <unity.h>
+#include <royaleCAPI.h>
+#include <PlatformResourcesCAPI.h>
+#include <TestFrameRing.h>
+#include <stdio.h>
+
+void setUp (void)
+{
+}
+
+void tearDown (void)
+{
+}
+
+int main (void)
+{
+    UNITY_BEGIN();
+
+    royale_camera_status status = royale_platform_resources_initialize();
+    if (ROYALE_STATUS_SUCCESS != status)
+    {
+        printf ("Failed to initialize platform resources: %d", status);
+        return -1;
+    }
+
+    printf ("===========================================================\n");
+    printf ("testing royaleCAPI %d with playback\n", ROYALE_C_API_VERSION);
+    printf ("===========================================================\n");
+
+    test_royaleCAPI_FrameRing();
+
+    royale_platform_resources_uninitialize();
+
+    return UNITY_END();
+}
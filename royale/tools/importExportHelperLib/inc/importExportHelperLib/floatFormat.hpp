@@ -0,0 +1,58 @@
+/****************************************************************************\
+ * Copyright (C) 2019 pmdtechnologies ag
+ *
+ * THIS CODE AND INFORMATION ARE PROVIDED "AS IS" WITHOUT WARRANTY OF ANY
+ * KIND, EITHER EXPRESSED OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND/OR FITNESS FOR A
+ * PARTICULAR PURPOSE.
+ *
+ \****************************************************************************/
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+namespace royale
+{
+    namespace importExportHelperLib
+    {
+        /**
+         * Number of chars that the format functions below may write.
+         */
+        const std::size_t FLOAT_FORMAT_BUFFER_SIZE = 64u;
+
+        /**
+         * Writes the shortest decimal representation of value that is read back as the same
+         * float (by strtof or std::stof), using the Ryu algorithm.
+         *
+         * Numbers in the range 1e-5 to 1e9 are written without an exponent ("0.001", "12.5",
+         * "300"), other numbers in scientific notation ("1.5e-7", "3e+20").  NaN and infinity
+         * are written as "nan", "inf" and "-inf".
+         *
+         * No terminating null is written.  Returns the position after the last char.
+         *
+         * @param buffer at least FLOAT_FORMAT_BUFFER_SIZE chars
+         */
+        char *formatFloatShortest (float value, char *buffer);
+
+        /**
+         * Writes value with precision digits after the decimal point, which gives the same
+         * result as printf ("%.*f", precision, value), but much faster.
+         *
+         * No terminating null is written.  Returns the position after the last char.
+         *
+         * @param precision number of digits after the decimal point, at most 9
+         * @param buffer at least FLOAT_FORMAT_BUFFER_SIZE chars
+         */
+        char *formatFloatFixed (float value, unsigned precision, char *buffer);
+
+        /**
+         * Writes value in decimal.  No terminating null is written.  Returns the position after
+         * the last char.
+         *
+         * @param buffer at least FLOAT_FORMAT_BUFFER_SIZE chars
+         */
+        char *formatUnsigned (uint32_t value, char *buffer);
+    }
+}
@@ -23,5 +23,11 @@ namespace royale
         royale::CameraStatus encodePLY (const royale::DepthData *depthData, std::string &outPLY);
 
         royale::CameraStatus encodePLY (const royale::DepthData *depthData, std::ostream &outPLY);
+
+        /**
+         * Writes the same point cloud as encodePLY, in the binary_little_endian format of PLY.
+         * The stream has to be opened in binary mode.
+         */
+        royale::CameraStatus encodePLYBinary (const royale::DepthData *depthData, std::ostream &outPLY);
     }
 }
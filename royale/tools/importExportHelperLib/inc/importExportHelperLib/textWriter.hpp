@@ -0,0 +1,117 @@
+/****************************************************************************\
+ * Copyright (C) 2019 pmdtechnologies ag
+ *
+ * THIS CODE AND INFORMATION ARE PROVIDED "AS IS" WITHOUT WARRANTY OF ANY
+ * KIND, EITHER EXPRESSED OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND/OR FITNESS FOR A
+ * PARTICULAR PURPOSE.
+ *
+ \****************************************************************************/
+
+#pragma once
+
+#include <importExportHelperLib/floatFormat.hpp>
+
+#include <cstring>
+#include <iostream>
+
+namespace royale
+{
+    namespace importExportHelperLib
+    {
+        /**
+         * Collects formatted text in a buffer and passes it to the stream in big blocks.  The
+         * numbers are formatted with the functions from floatFormat.hpp, which are much
+         * faster than the operators of std::ostream.
+         */
+        class TextWriter
+        {
+        public:
+            explicit TextWriter (std::ostream &os) :
+                m_os (os),
+                m_used (0u)
+            {
+            }
+
+            ~TextWriter()
+            {
+                flush();
+            }
+
+            void put (char c)
+            {
+                reserve();
+                m_buffer[m_used++] = c;
+            }
+
+            void put (const char *text)
+            {
+                const auto length = std::strlen (text);
+                if (length >= FLOAT_FORMAT_BUFFER_SIZE)
+                {
+                    flush();
+                    m_os.write (text, static_cast<std::streamsize> (length));
+                    return;
+                }
+                reserve();
+                std::memcpy (&m_buffer[m_used], text, length);
+                m_used += length;
+            }
+
+            /**
+             * Writes the shortest text that is read back as value.
+             */
+            void putFloat (float value)
+            {
+                reserve();
+                advance (formatFloatShortest (value, &m_buffer[m_used]));
+            }
+
+            /**
+             * Writes value like std::fixed with std::setprecision (precision).
+             */
+            void putFixed (float value, unsigned precision)
+            {
+                reserve();
+                advance (formatFloatFixed (value, precision, &m_buffer[m_used]));
+            }
+
+            void putUnsigned (uint32_t value)
+            {
+                reserve();
+                advance (formatUnsigned (value, &m_buffer[m_used]));
+            }
+
+            void flush()
+            {
+                if (m_used > 0u)
+                {
+                    m_os.write (m_buffer, static_cast<std::streamsize> (m_used));
+                    m_used = 0u;
+                }
+            }
+
+        private:
+            // Small enough for the stack of a worker thread
+            static const std::size_t BUFFER_SIZE = 16u * 1024u;
+
+            // Makes sure that one formatted number fits into the buffer
+            void reserve()
+            {
+                if (m_used + FLOAT_FORMAT_BUFFER_SIZE > BUFFER_SIZE)
+                {
+                    flush();
+                }
+            }
+
+            void advance (const char *end)
+            {
+                m_used = static_cast<std::size_t> (end - m_buffer);
+            }
+
+            std::ostream &m_os;
+            char m_buffer[BUFFER_SIZE];
+            std::size_t m_used;
+        };
+    }
+}
@@ -9,11 +9,11 @@
  \****************************************************************************/
 
 #include <importExportHelperLib/csvHelper.hpp>
+#include <importExportHelperLib/textWriter.hpp>
 
 #include <common/StringFunctions.hpp>
 
 #include <sstream>
-#include <iomanip>
 
 using namespace royale;
 using namespace royale::common;
@@ -21,14 +21,12 @@ using namespace royale::importExportHelperLib;
 
 CameraStatus royale::importExportHelperLib::encodeDepthCSV (const royale::DepthData *depthData, std::ostream &outCSV)
 {
-    // Create the data for the CSV-File
-    outCSV << std::showpoint;
-    outCSV << std::fixed;
-    outCSV << std::setprecision (4);
-
+    // Create the data for the CSV-File, with 4 digits after the decimal point
+    TextWriter writer (outCSV);
     for (const auto &p : depthData->points)
     {
-        outCSV << p.z << ',';
+        writer.putFixed (p.z, 4u);
+        writer.put (',');
     }
 
     return CameraStatus::SUCCESS;
@@ -63,13 +61,11 @@ royale::CameraStatus royale::importExportHelperLib::encodeAmplCSV (const royale:
 royale::CameraStatus royale::importExportHelperLib::encodeAmplCSV (const royale::DepthData *depthData, std::ostream &outCSV)
 {
     // Create the data for the CSV-File
-    outCSV << std::showpoint;
-    outCSV << std::fixed;
-    outCSV << std::setprecision (4);
-
+    TextWriter writer (outCSV);
     for (const auto &p : depthData->points)
     {
-        outCSV << static_cast<uint32_t> (p.grayValue) << ',';
+        writer.putUnsigned (p.grayValue);
+        writer.put (',');
     }
 
     return CameraStatus::SUCCESS;
@@ -78,23 +74,21 @@ royale::CameraStatus royale::importExportHelperLib::encodeAmplCSV (const royale:
 royale::CameraStatus royale::importExportHelperLib::encodeRawCSV (const royale::RawData *rawData, std::ostream &outCSV)
 {
     // Create the data for the CSV-File
-    outCSV << std::showpoint;
-    outCSV << std::fixed;
-    outCSV << std::setprecision (4);
-
+    TextWriter writer (outCSV);
     for (size_t x = 0u; x < rawData->rawData.size(); ++x)
     {
+        const auto frame = rawData->rawData.at (x);
         size_t idx = 0u;
         for (size_t i = 0; i < rawData->height; ++i)
         {
             for (size_t j = 0; j < rawData->width; ++j, ++idx)
             {
-                outCSV << rawData->rawData.at (x) [idx] << ",";
+                writer.putUnsigned (frame[idx]);
+                writer.put (',');
             }
-            outCSV << std::endl;
+            writer.put ('\n');
         }
-        outCSV << std::endl;
-        outCSV << std::endl;
+        writer.put ("\n\n");
     }
 
     return CameraStatus::SUCCESS;
@@ -0,0 +1,439 @@
+/****************************************************************************\
+ * Copyright (C) 2019 pmdtechnologies ag
+ *
+ * THIS CODE AND INFORMATION ARE PROVIDED "AS IS" WITHOUT WARRANTY OF ANY
+ * KIND, EITHER EXPRESSED OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND/OR FITNESS FOR A
+ * PARTICULAR PURPOSE.
+ *
+ \****************************************************************************/
+
+#include <importExportHelperLib/floatFormat.hpp>
+
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+
+using namespace royale::importExportHelperLib;
+
+namespace
+{
+    // The shortest representation is calculated with the Ryu algorithm for 32 bit floats, see
+    // Ulf Adams, "Ryu: Fast Float-to-String Conversion", PLDI 2018.  The value is expanded to
+    // the interval of decimals that round to it, and digits are removed from the interval's
+    // bounds as long as they are still different.  All calculations are done with integers.
+
+    const int FLOAT_MANTISSA_BITS = 23;
+    const int FLOAT_BIAS = 127;
+
+    const int FLOAT_POW5_INV_BITCOUNT = 59;
+    const int FLOAT_POW5_BITCOUNT = 61;
+
+    // FLOAT_POW5_INV_SPLIT[i] = floor (2^(pow5bits (i) - 1 + FLOAT_POW5_INV_BITCOUNT) / 5^i) + 1
+    const uint64_t FLOAT_POW5_INV_SPLIT[31] =
+    {
+        0x0800000000000001u, 0x0666666666666667u, 0x051eb851eb851eb9u,
+        0x04189374bc6a7efau, 0x068db8bac710cb2au, 0x053e2d6238da3c22u,
+        0x0431bde82d7b634eu, 0x06b5fca6af2bd216u, 0x055e63b88c230e78u,
+        0x044b82fa09b5a52du, 0x06df37f675ef6eaeu, 0x057f5ff85e592558u,
+        0x0465e6604b7a8447u, 0x0709709a125da071u, 0x05a126e1a84ae6c1u,
+        0x0480ebe7b9d58567u, 0x0734aca5f6226f0bu, 0x05c3bd5191b525a3u,
+        0x049c97747490eae9u, 0x0760f253edb4ab0eu, 0x05e72843249088d8u,
+        0x04b8ed0283a6d3e0u, 0x078e480405d7b966u, 0x060b6cd004ac9452u,
+        0x04d5f0a66a23a9dbu, 0x07bcb43d769f762bu, 0x063090312bb2c4efu,
+        0x04f3a68dbc8f03f3u, 0x07ec3daf94180651u, 0x065697bfa9acd1dau,
+        0x051212ffbaf0a7e2u,
+    };
+
+    // FLOAT_POW5_SPLIT[i] = 5^i scaled to FLOAT_POW5_BITCOUNT bits
+    const uint64_t FLOAT_POW5_SPLIT[47] =
+    {
+        0x1000000000000000u, 0x1400000000000000u, 0x1900000000000000u,
+        0x1f40000000000000u, 0x1388000000000000u, 0x186a000000000000u,
+        0x1e84800000000000u, 0x1312d00000000000u, 0x17d7840000000000u,
+        0x1dcd650000000000u, 0x12a05f2000000000u, 0x174876e800000000u,
+        0x1d1a94a200000000u, 0x12309ce540000000u, 0x16bcc41e90000000u,
+        0x1c6bf52634000000u, 0x11c37937e0800000u, 0x16345785d8a00000u,
+        0x1bc16d674ec80000u, 0x1158e460913d0000u, 0x15af1d78b58c4000u,
+        0x1b1ae4d6e2ef5000u, 0x10f0cf064dd59200u, 0x152d02c7e14af680u,
+        0x1a784379d99db420u, 0x108b2a2c28029094u, 0x14adf4b7320334b9u,
+        0x19d971e4fe8401e7u, 0x1027e72f1f128130u, 0x1431e0fae6d7217cu,
+        0x193e5939a08ce9dbu, 0x1f8def8808b02452u, 0x13b8b5b5056e16b3u,
+        0x18a6e32246c99c60u, 0x1ed09bead87c0378u, 0x13426172c74d822bu,
+        0x1812f9cf7920e2b6u, 0x1e17b84357691b64u, 0x12ced32a16a1b11eu,
+        0x178287f49c4a1d66u, 0x1d6329f1c35ca4bfu, 0x125dfa371a19e6f7u,
+        0x16f578c4e0a060b5u, 0x1cb2d6f618c878e3u, 0x11efc659cf7d4b8du,
+        0x166bb7f0435c9e71u, 0x1c06a5ec5433c60du,
+    };
+
+    const uint32_t POW10[10] =
+    {
+        1u, 10u, 100u, 1000u, 10000u, 100000u, 1000000u, 10000000u, 100000000u, 1000000000u
+    };
+
+    // Number of bits of 5^e, which is ceil (log2 (5^e)) for e > 0
+    inline int32_t pow5bits (int32_t e)
+    {
+        return static_cast<int32_t> ( (static_cast<uint32_t> (e) * 1217359u) >> 19) + 1;
+    }
+
+    // floor (log10 (2^e))
+    inline uint32_t log10Pow2 (int32_t e)
+    {
+        return (static_cast<uint32_t> (e) * 78913u) >> 18;
+    }
+
+    // floor (log10 (5^e))
+    inline uint32_t log10Pow5 (int32_t e)
+    {
+        return (static_cast<uint32_t> (e) * 732923u) >> 20;
+    }
+
+    inline uint32_t pow5Factor (uint32_t value)
+    {
+        uint32_t count = 0u;
+        while (value % 5u == 0u)
+        {
+            value /= 5u;
+            count++;
+        }
+        return count;
+    }
+
+    inline bool multipleOfPowerOf5 (uint32_t value, uint32_t p)
+    {
+        return pow5Factor (value) >= p;
+    }
+
+    inline bool multipleOfPowerOf2 (uint32_t value, uint32_t p)
+    {
+        return (value & ( (1u << p) - 1u)) == 0u;
+    }
+
+    // (m * factor) >> shift, with shift > 32
+    inline uint32_t mulShift (uint32_t m, uint64_t factor, int32_t shift)
+    {
+        const uint64_t bits0 = static_cast<uint64_t> (m) * static_cast<uint32_t> (factor);
+        const uint64_t bits1 = static_cast<uint64_t> (m) * static_cast<uint32_t> (factor >> 32);
+        const uint64_t sum = (bits0 >> 32) + bits1;
+        return static_cast<uint32_t> (sum >> (shift - 32));
+    }
+
+    /**
+     * Calculates the shortest decimal digits and the decimal exponent of a finite, positive
+     * float, given as the bits of its mantissa and exponent.
+     */
+    void shortestDecimal (uint32_t ieeeMantissa, uint32_t ieeeExponent, uint32_t &digits, int32_t &exponent)
+    {
+        int32_t e2;
+        uint32_t m2;
+        if (ieeeExponent == 0u)
+        {
+            e2 = 1 - FLOAT_BIAS - FLOAT_MANTISSA_BITS - 2;
+            m2 = ieeeMantissa;
+        }
+        else
+        {
+            e2 = static_cast<int32_t> (ieeeExponent) - FLOAT_BIAS - FLOAT_MANTISSA_BITS - 2;
+            m2 = (1u << FLOAT_MANTISSA_BITS) | ieeeMantissa;
+        }
+        const bool acceptBounds = (m2 & 1u) == 0u;
+
+        // The value and the bounds of the interval that rounds to it, times 4
+        const uint32_t mv = 4u * m2;
+        const uint32_t mmShift = (ieeeMantissa != 0u || ieeeExponent <= 1u) ? 1u : 0u;
+        const uint32_t mp = 4u * m2 + 2u;
+        const uint32_t mm = 4u * m2 - 1u - mmShift;
+
+        // The same, converted to decimal and reduced to about 10 digits
+        uint32_t vr, vp, vm;
+        int32_t e10;
+        bool vmIsTrailingZeros = false;
+        bool vrIsTrailingZeros = false;
+        uint32_t lastRemovedDigit = 0u;
+        if (e2 >= 0)
+        {
+            const uint32_t q = log10Pow2 (e2);
+            e10 = static_cast<int32_t> (q);
+            const int32_t k = FLOAT_POW5_INV_BITCOUNT + pow5bits (static_cast<int32_t> (q)) - 1;
+            const int32_t i = -e2 + static_cast<int32_t> (q) + k;
+            vr = mulShift (mv, FLOAT_POW5_INV_SPLIT[q], i);
+            vp = mulShift (mp, FLOAT_POW5_INV_SPLIT[q], i);
+            vm = mulShift (mm, FLOAT_POW5_INV_SPLIT[q], i);
+            if (q != 0u && (vp - 1u) / 10u <= vm / 10u)
+            {
+                // The loop below won't remove any digit, but the last removed digit is
+                // needed for rounding
+                const int32_t l = FLOAT_POW5_INV_BITCOUNT + pow5bits (static_cast<int32_t> (q - 1u)) - 1;
+                lastRemovedDigit = mulShift (mv, FLOAT_POW5_INV_SPLIT[q - 1u], -e2 + static_cast<int32_t> (q) - 1 + l) % 10u;
+            }
+            if (q <= 9u)
+            {
+                // Only one of mp, mv and mm can be a multiple of 5
+                if (mv % 5u == 0u)
+                {
+                    vrIsTrailingZeros = multipleOfPowerOf5 (mv, q);
+                }
+                else if (acceptBounds)
+                {
+                    vmIsTrailingZeros = multipleOfPowerOf5 (mm, q);
+                }
+                else if (multipleOfPowerOf5 (mp, q))
+                {
+                    vp--;
+                }
+            }
+        }
+        else
+        {
+            const uint32_t q = log10Pow5 (-e2);
+            e10 = static_cast<int32_t> (q) + e2;
+            const int32_t i = -e2 - static_cast<int32_t> (q);
+            const int32_t k = pow5bits (i) - FLOAT_POW5_BITCOUNT;
+            int32_t j = static_cast<int32_t> (q) - k;
+            vr = mulShift (mv, FLOAT_POW5_SPLIT[i], j);
+            vp = mulShift (mp, FLOAT_POW5_SPLIT[i], j);
+            vm = mulShift (mm, FLOAT_POW5_SPLIT[i], j);
+            if (q != 0u && (vp - 1u) / 10u <= vm / 10u)
+            {
+                j = static_cast<int32_t> (q) - 1 - (pow5bits (i + 1) - FLOAT_POW5_BITCOUNT);
+                lastRemovedDigit = mulShift (mv, FLOAT_POW5_SPLIT[i + 1], j) % 10u;
+            }
+            if (q <= 1u)
+            {
+                // mv has at least q trailing zero bits
+                vrIsTrailingZeros = true;
+                if (acceptBounds)
+                {
+                    vmIsTrailingZeros = mmShift == 1u;
+                }
+                else
+                {
+                    vp--;
+                }
+            }
+            else if (q < 31u)
+            {
+                vrIsTrailingZeros = multipleOfPowerOf2 (mv, q - 1u);
+            }
+        }
+
+        // Remove the digits that aren't needed to tell the value apart from its neighbours
+        int32_t removed = 0;
+        uint32_t output;
+        if (vmIsTrailingZeros || vrIsTrailingZeros)
+        {
+            // Rare case, the exact decimal value of a bound matters
+            while (vp / 10u > vm / 10u)
+            {
+                vmIsTrailingZeros &= vm % 10u == 0u;
+                vrIsTrailingZeros &= lastRemovedDigit == 0u;
+                lastRemovedDigit = vr % 10u;
+                vr /= 10u;
+                vp /= 10u;
+                vm /= 10u;
+                removed++;
+            }
+            if (vmIsTrailingZeros)
+            {
+                while (vm % 10u == 0u)
+                {
+                    vrIsTrailingZeros &= lastRemovedDigit == 0u;
+                    lastRemovedDigit = vr % 10u;
+                    vr /= 10u;
+                    vp /= 10u;
+                    vm /= 10u;
+                    removed++;
+                }
+            }
+            if (vrIsTrailingZeros && lastRemovedDigit == 5u && vr % 2u == 0u)
+            {
+                // Round half to even
+                lastRemovedDigit = 4u;
+            }
+            output = vr + ( ( (vr == vm && (!acceptBounds || !vmIsTrailingZeros)) || lastRemovedDigit >= 5u) ? 1u : 0u);
+        }
+        else
+        {
+            while (vp / 10u > vm / 10u)
+            {
+                lastRemovedDigit = vr % 10u;
+                vr /= 10u;
+                vp /= 10u;
+                vm /= 10u;
+                removed++;
+            }
+            output = vr + ( (vr == vm || lastRemovedDigit >= 5u) ? 1u : 0u);
+        }
+
+        digits = output;
+        exponent = e10 + removed;
+    }
+
+    uint32_t decimalLength (uint32_t value)
+    {
+        uint32_t length = 1u;
+        while (length < 10u && value >= POW10[length])
+        {
+            length++;
+        }
+        return length;
+    }
+
+    // Writes exactly length digits of value, with leading zeros
+    void writeDigits (uint32_t value, uint32_t length, char *buffer)
+    {
+        for (uint32_t i = length; i > 0u; i--)
+        {
+            buffer[i - 1u] = static_cast<char> ('0' + value % 10u);
+            value /= 10u;
+        }
+    }
+
+    char *writeSpecial (float value, char *buffer)
+    {
+        const char *text = std::isnan (value) ? "nan" : (value < 0.0f ? "-inf" : "inf");
+        const auto length = std::strlen (text);
+        std::memcpy (buffer, text, length);
+        return buffer + length;
+    }
+}
+
+char *royale::importExportHelperLib::formatFloatShortest (float value, char *buffer)
+{
+    if (!std::isfinite (value))
+    {
+        return writeSpecial (value, buffer);
+    }
+
+    uint32_t bits;
+    std::memcpy (&bits, &value, sizeof (bits));
+    const uint32_t ieeeMantissa = bits & ( (1u << FLOAT_MANTISSA_BITS) - 1u);
+    const uint32_t ieeeExponent = (bits >> FLOAT_MANTISSA_BITS) & 0xffu;
+
+    if (bits >> 31)
+    {
+        *buffer++ = '-';
+    }
+    if (ieeeMantissa == 0u && ieeeExponent == 0u)
+    {
+        *buffer++ = '0';
+        return buffer;
+    }
+
+    uint32_t digits;
+    int32_t exponent;
+    shortestDecimal (ieeeMantissa, ieeeExponent, digits, exponent);
+
+    // value = digits * 10^exponent, with point digits before the decimal point
+    const auto length = static_cast<int32_t> (decimalLength (digits));
+    const int32_t point = length + exponent;
+
+    if (point > -5 && point <= 9)
+    {
+        if (point <= 0)
+        {
+            *buffer++ = '0';
+            *buffer++ = '.';
+            for (int32_t i = point; i < 0; i++)
+            {
+                *buffer++ = '0';
+            }
+            writeDigits (digits, static_cast<uint32_t> (length), buffer);
+            return buffer + length;
+        }
+        if (point < length)
+        {
+            writeDigits (digits / POW10[length - point], static_cast<uint32_t> (point), buffer);
+            buffer += point;
+            *buffer++ = '.';
+            writeDigits (digits % POW10[length - point], static_cast<uint32_t> (length - point), buffer);
+            return buffer + (length - point);
+        }
+        writeDigits (digits, static_cast<uint32_t> (length), buffer);
+        buffer += length;
+        for (int32_t i = length; i < point; i++)
+        {
+            *buffer++ = '0';
+        }
+        return buffer;
+    }
+
+    // Scientific notation, d.ddde+x
+    const auto leading = digits / POW10[length - 1];
+    *buffer++ = static_cast<char> ('0' + leading);
+    if (length > 1)
+    {
+        *buffer++ = '.';
+        writeDigits (digits % POW10[length - 1], static_cast<uint32_t> (length - 1), buffer);
+        buffer += length - 1;
+    }
+    *buffer++ = 'e';
+    int32_t scientificExponent = point - 1;
+    if (scientificExponent < 0)
+    {
+        *buffer++ = '-';
+        scientificExponent = -scientificExponent;
+    }
+    else
+    {
+        *buffer++ = '+';
+    }
+    return formatUnsigned (static_cast<uint32_t> (scientificExponent), buffer);
+}
+
+char *royale::importExportHelperLib::formatFloatFixed (float value, unsigned precision, char *buffer)
+{
+    if (precision > 9u)
+    {
+        precision = 9u;
+    }
+
+    // A float has 24 significant bits and 10^9 needs 30 bits, so the product is exact in a
+    // double.  nearbyint rounds the exact value half to even, like printf does.  Bigger
+    // values, which need more than 64 bits as an integer, are left to printf.
+    const double scaled = static_cast<double> (value) * POW10[precision];
+    if (!std::isfinite (value) || std::fabs (scaled) >= 1e18)
+    {
+        const auto length = std::snprintf (buffer, FLOAT_FORMAT_BUFFER_SIZE, "%.*f", static_cast<int> (precision),
+                                           static_cast<double> (value));
+        return buffer + (length < 0 ? 0 : (std::min) (static_cast<std::size_t> (length), FLOAT_FORMAT_BUFFER_SIZE - 1u));
+    }
+
+    if (std::signbit (value))
+    {
+        *buffer++ = '-';
+    }
+    const auto rounded = static_cast<uint64_t> (std::nearbyint (std::fabs (scaled)));
+    const uint64_t integerPart = rounded / POW10[precision];
+    const auto fraction = static_cast<uint32_t> (rounded % POW10[precision]);
+
+    if (integerPart > 0xffffffffu)
+    {
+        // At most 18 digits, split into two parts that fit into 32 bits
+        const auto high = static_cast<uint32_t> (integerPart / POW10[9]);
+        buffer = formatUnsigned (high, buffer);
+        writeDigits (static_cast<uint32_t> (integerPart % POW10[9]), 9u, buffer);
+        buffer += 9;
+    }
+    else
+    {
+        buffer = formatUnsigned (static_cast<uint32_t> (integerPart), buffer);
+    }
+
+    if (precision > 0u)
+    {
+        *buffer++ = '.';
+        writeDigits (fraction, precision, buffer);
+        buffer += precision;
+    }
+    return buffer;
+}
+
+char *royale::importExportHelperLib::formatUnsigned (uint32_t value, char *buffer)
+{
+    const auto length = decimalLength (value);
+    writeDigits (value, length, buffer);
+    return buffer + length;
+}
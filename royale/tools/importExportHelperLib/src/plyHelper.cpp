@@ -9,71 +9,158 @@
  \****************************************************************************/
 
 #include <importExportHelperLib/plyHelper.hpp>
+#include <importExportHelperLib/textWriter.hpp>
 
+#include <algorithm>
+#include <cstring>
 #include <sstream>
+#include <vector>
 
 using namespace royale;
 using namespace royale::importExportHelperLib;
 
-CameraStatus royale::importExportHelperLib::encodePLY (const royale::DepthData *depthData, std::ostream &outPLY)
+namespace
 {
-    outPLY <<
-           "ply\n"
-           "format ascii 1.0\n"
-           "comment Generated by royaleviewer " << ROYALE_VERSION_MAJOR << "." << ROYALE_VERSION_MINOR << "." << ROYALE_VERSION_PATCH << "." << ROYALE_VERSION_BUILD << "\n"
-           "element vertex " << depthData->points.size() << "\n"
-           "property float x\n"
-           "property float y\n"
-           "property float z\n"
-           "property float amplitude\n"
-           "property uchar red\n"
-           "property uchar green\n"
-           "property uchar blue\n"
-           "element face 0\n"
-           "property list uchar int vertex_index\n"
-           "end_header\n";
-
-    uint16_t minAmp{ 65535 };
-    uint16_t maxAmp{ 0 };
+    std::string plyHeader (const royale::DepthData *depthData, const char *format)
+    {
+        std::ostringstream header;
+        header <<
+               "ply\n"
+               "format " << format << " 1.0\n"
+               "comment Generated by royaleviewer " << ROYALE_VERSION_MAJOR << "." << ROYALE_VERSION_MINOR << "." << ROYALE_VERSION_PATCH << "." << ROYALE_VERSION_BUILD << "\n"
+               "element vertex " << depthData->points.size() << "\n"
+               "property float x\n"
+               "property float y\n"
+               "property float z\n"
+               "property float amplitude\n"
+               "property uchar red\n"
+               "property uchar green\n"
+               "property uchar blue\n"
+               "element face 0\n"
+               "property list uchar int vertex_index\n"
+               "end_header\n";
+        return header.str();
+    }
 
-    for (const auto &point : depthData->points)
+    /**
+     * The points are colored with their amplitude, scaled to the range of the valid points.
+     */
+    class AmplitudeColor
     {
-        if (point.depthConfidence > 0)
+    public:
+        explicit AmplitudeColor (const royale::DepthData *depthData) :
+            m_minAmp (65535),
+            m_range (1.0f)
         {
-            if (point.grayValue < minAmp)
+            uint16_t maxAmp{ 0 };
+
+            for (const auto &point : depthData->points)
+            {
+                if (point.depthConfidence > 0)
+                {
+                    if (point.grayValue < m_minAmp)
+                    {
+                        m_minAmp = point.grayValue;
+                    }
+                    if (point.grayValue > maxAmp)
+                    {
+                        maxAmp = point.grayValue;
+                    }
+                }
+            }
+
+            auto range = static_cast<float> (maxAmp - m_minAmp);
+            if (range != 0.0f)
             {
-                minAmp = point.grayValue;
+                m_range = range;
             }
-            else if (point.grayValue > maxAmp)
+        }
+
+        uint32_t operator() (const royale::DepthPoint &point) const
+        {
+            if (point.depthConfidence == 0)
             {
-                maxAmp = point.grayValue;
+                return 0u;
             }
+            // The property is a uchar, the cast of a larger float would be undefined
+            const auto scaled = (static_cast<float> (point.grayValue - m_minAmp) / m_range) * 255.0f;
+            return static_cast<uint32_t> (std::min (std::max (scaled, 0.0f), 255.0f));
         }
+
+    private:
+        uint16_t m_minAmp;
+        float m_range;
+    };
+
+    // Size of a vertex in the binary format, four floats and three uchars
+    const size_t BINARY_VERTEX_SIZE = 4u * sizeof (float) + 3u;
+
+    inline uint8_t *putLittleEndian (float value, uint8_t *dst)
+    {
+        uint32_t bits;
+        std::memcpy (&bits, &value, sizeof (bits));
+        dst[0] = static_cast<uint8_t> (bits);
+        dst[1] = static_cast<uint8_t> (bits >> 8);
+        dst[2] = static_cast<uint8_t> (bits >> 16);
+        dst[3] = static_cast<uint8_t> (bits >> 24);
+        return dst + 4;
     }
+}
 
-    auto range = static_cast<float> (maxAmp - minAmp);
-    if (range == 0.0f)
+CameraStatus royale::importExportHelperLib::encodePLY (const royale::DepthData *depthData, std::ostream &outPLY)
+{
+    const AmplitudeColor color (depthData);
+
+    TextWriter writer (outPLY);
+    writer.put (plyHeader (depthData, "ascii").c_str());
+
+    for (const auto &point : depthData->points)
     {
-        range = 1.0f;
+        const auto pixelColor = color (point);
+        writer.putFloat (point.x);
+        writer.put (' ');
+        writer.putFloat (point.y);
+        writer.put (' ');
+        writer.putFloat (point.z);
+        writer.put (' ');
+        writer.putFloat (static_cast<float> (point.grayValue));
+        writer.put (' ');
+        writer.putUnsigned (pixelColor);
+        writer.put (' ');
+        writer.putUnsigned (pixelColor);
+        writer.put (' ');
+        writer.putUnsigned (pixelColor);
+        writer.put ('\n');
     }
 
+    return CameraStatus::SUCCESS;
+}
+
+CameraStatus royale::importExportHelperLib::encodePLYBinary (const royale::DepthData *depthData, std::ostream &outPLY)
+{
+    const AmplitudeColor color (depthData);
+    const auto header = plyHeader (depthData, "binary_little_endian");
+
+    // The whole file is assembled in memory, and written with one call
+    std::vector<uint8_t> buffer (header.size() + depthData->points.size() * BINARY_VERTEX_SIZE);
+    std::memcpy (buffer.data(), header.data(), header.size());
+
+    auto dst = buffer.data() + header.size();
     for (const auto &point : depthData->points)
     {
-        uint32_t pixelColor{ 0 };
-        if (point.depthConfidence > 0)
-        {
-            pixelColor = static_cast<uint32_t> ( (static_cast<float> (point.grayValue - minAmp) / range) * 255.0f);
-        }
-        outPLY
-                << point.x << ' '
-                << point.y << ' '
-                << point.z << ' '
-                << static_cast<float> (point.grayValue) << ' '
-                << pixelColor << ' '
-                << pixelColor << ' '
-                << pixelColor << '\n';
+        dst = putLittleEndian (point.x, dst);
+        dst = putLittleEndian (point.y, dst);
+        dst = putLittleEndian (point.z, dst);
+        dst = putLittleEndian (static_cast<float> (point.grayValue), dst);
+
+        const auto pixelColor = static_cast<uint8_t> (color (point));
+        *dst++ = pixelColor;
+        *dst++ = pixelColor;
+        *dst++ = pixelColor;
     }
 
+    outPLY.write (reinterpret_cast<const char *> (buffer.data()), static_cast<std::streamsize> (buffer.size()));
+
     return CameraStatus::SUCCESS;
 }
 
@@ -0,0 +1,259 @@
+/****************************************************************************\
+* Copyright (C) 2019 pmdtechnologies ag
+*
+* THIS CODE AND INFORMATION ARE PROVIDED "AS IS" WITHOUT WARRANTY OF ANY
+* KIND, EITHER EXPRESSED OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE
+* IMPLIED WARRANTIES OF MERCHANTABILITY AND/OR FITNESS FOR A
+* PARTICULAR PURPOSE.
+*
+\****************************************************************************/
+
+#include <importExportHelperLib/floatFormat.hpp>
+#include <gtest/gtest.h>
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <iomanip>
+#include <iostream>
+#include <limits>
+#include <random>
+#include <sstream>
+#include <string>
+#include <vector>
+
+using namespace royale::importExportHelperLib;
+
+namespace
+{
+    std::string shortest (float value)
+    {
+        char buffer[FLOAT_FORMAT_BUFFER_SIZE];
+        return std::string (buffer, formatFloatShortest (value, buffer));
+    }
+
+    std::string fixed (float value, unsigned precision)
+    {
+        char buffer[FLOAT_FORMAT_BUFFER_SIZE];
+        return std::string (buffer, formatFloatFixed (value, precision, buffer));
+    }
+
+    uint32_t toBits (float value)
+    {
+        uint32_t bits;
+        std::memcpy (&bits, &value, sizeof (bits));
+        return bits;
+    }
+
+    float fromBits (uint32_t bits)
+    {
+        float value;
+        std::memcpy (&value, &bits, sizeof (value));
+        return value;
+    }
+
+    /**
+     * Number of significant digits needed by printf to write a string that is read back as value
+     */
+    int printfDigits (float value)
+    {
+        char buffer[64];
+        for (int digits = 1; digits < 9; ++digits)
+        {
+            std::snprintf (buffer, sizeof (buffer), "%.*e", digits - 1, static_cast<double> (value));
+            if (std::strtof (buffer, nullptr) == value)
+            {
+                return digits;
+            }
+        }
+        return 9;
+    }
+
+    int significantDigits (const std::string &text)
+    {
+        const auto mantissa = text.substr (0, text.find ('e'));
+        const auto first = mantissa.find_first_of ("123456789");
+        if (first == std::string::npos)
+        {
+            return 0;
+        }
+        auto last = mantissa.find_last_of ("0123456789");
+        if (mantissa.find ('.') == std::string::npos)
+        {
+            // Integers are padded with zeros
+            last = mantissa.find_last_of ("123456789");
+        }
+        int digits = 0;
+        for (auto i = first; i <= last; ++i)
+        {
+            if (mantissa[i] != '.')
+            {
+                digits++;
+            }
+        }
+        return digits;
+    }
+}
+
+TEST (TestFloatFormat, Shortest)
+{
+    EXPECT_EQ ("0", shortest (0.0f));
+    EXPECT_EQ ("-0", shortest (-0.0f));
+    EXPECT_EQ ("1", shortest (1.0f));
+    EXPECT_EQ ("-1", shortest (-1.0f));
+    EXPECT_EQ ("0.1", shortest (0.1f));
+    EXPECT_EQ ("0.3", shortest (0.3f));
+    EXPECT_EQ ("1.5", shortest (1.5f));
+    EXPECT_EQ ("300", shortest (300.0f));
+    EXPECT_EQ ("1234.5677", shortest (1234.5678f));
+    EXPECT_EQ ("0.0001", shortest (0.0001f));
+    EXPECT_EQ ("0.00001", shortest (0.00001f));
+    EXPECT_EQ ("1e-6", shortest (0.000001f));
+    EXPECT_EQ ("1.5e-7", shortest (1.5e-7f));
+    EXPECT_EQ ("100000000", shortest (1e8f));
+    EXPECT_EQ ("1e+10", shortest (1e10f));
+    EXPECT_EQ ("3.4028235e+38", shortest (std::numeric_limits<float>::max()));
+    EXPECT_EQ ("1e-45", shortest (std::numeric_limits<float>::denorm_min()));
+    EXPECT_EQ ("1.1754944e-38", shortest (std::numeric_limits<float>::min()));
+    EXPECT_EQ ("inf", shortest (std::numeric_limits<float>::infinity()));
+    EXPECT_EQ ("-inf", shortest (-std::numeric_limits<float>::infinity()));
+    EXPECT_EQ ("nan", shortest (std::numeric_limits<float>::quiet_NaN()));
+}
+
+TEST (TestFloatFormat, ShortestRoundTrip)
+{
+    // Every float with one of these exponents, which covers the range of the point clouds, and
+    // random samples of all other floats
+    std::vector<uint32_t> bits;
+    for (uint32_t exponent = 120u; exponent <= 130u; exponent += 5u)
+    {
+        for (uint32_t mantissa = 0u; mantissa < (1u << 23); mantissa += 7u)
+        {
+            bits.push_back ( (exponent << 23) | mantissa);
+        }
+    }
+    std::mt19937 random (42u);
+    for (auto i = 0; i < 200000; ++i)
+    {
+        bits.push_back (static_cast<uint32_t> (random()));
+    }
+
+    for (const auto b : bits)
+    {
+        const auto value = fromBits (b);
+        if (std::isnan (value))
+        {
+            continue;
+        }
+        const auto text = shortest (value);
+        ASSERT_EQ (b, toBits (std::strtof (text.c_str(), nullptr))) << text;
+    }
+}
+
+TEST (TestFloatFormat, ShortestIsShortest)
+{
+    std::mt19937 random (7u);
+    for (auto i = 0; i < 100000; ++i)
+    {
+        const auto value = fromBits (static_cast<uint32_t> (random()) & 0x7fffffffu);
+        if (!std::isfinite (value) || value == 0.0f)
+        {
+            continue;
+        }
+        const auto text = shortest (value);
+        ASSERT_EQ (printfDigits (value), significantDigits (text)) << text;
+    }
+}
+
+TEST (TestFloatFormat, FixedMatchesPrintf)
+{
+    const float values[] = { 0.0f, -0.0f, 1.0f, 0.5f, 0.00005f, 0.00015f, 2.5f, 3.5f, -1.23456f,
+                             1234.56789f, 4294967296.0f, 1e17f, 1e20f, 3.4e38f, -0.00001f
+                           };
+    char buffer[64];
+    for (const auto value : values)
+    {
+        for (unsigned precision = 0u; precision <= 9u; ++precision)
+        {
+            std::snprintf (buffer, sizeof (buffer), "%.*f", precision, static_cast<double> (value));
+            EXPECT_EQ (std::string (buffer), fixed (value, precision));
+        }
+    }
+
+    std::mt19937 random (3u);
+    std::uniform_real_distribution<float> distribution (-10.0f, 10.0f);
+    for (auto i = 0; i < 100000; ++i)
+    {
+        const auto value = distribution (random);
+        std::snprintf (buffer, sizeof (buffer), "%.4f", static_cast<double> (value));
+        ASSERT_EQ (std::string (buffer), fixed (value, 4u));
+    }
+
+    // The iostream settings used by the CSV export
+    std::ostringstream stream;
+    stream << std::showpoint << std::fixed << std::setprecision (4) << 1.25f;
+    EXPECT_EQ (stream.str(), fixed (1.25f, 4u));
+}
+
+TEST (TestFloatFormat, Unsigned)
+{
+    char buffer[FLOAT_FORMAT_BUFFER_SIZE];
+    EXPECT_EQ ("0", std::string (buffer, formatUnsigned (0u, buffer)));
+    EXPECT_EQ ("9", std::string (buffer, formatUnsigned (9u, buffer)));
+    EXPECT_EQ ("10", std::string (buffer, formatUnsigned (10u, buffer)));
+    EXPECT_EQ ("65535", std::string (buffer, formatUnsigned (65535u, buffer)));
+    EXPECT_EQ ("4294967295", std::string (buffer, formatUnsigned (4294967295u, buffer)));
+}
+
+/**
+ * Compares the time for writing the coordinates of a 224 x 172 point cloud with iostreams
+ * and with the format functions.
+ */
+TEST (TestFloatFormat, DISABLED_Benchmark)
+{
+    const size_t numPoints = 224u * 172u;
+    const int repetitions = 20;
+
+    std::mt19937 random (1u);
+    std::uniform_real_distribution<float> distribution (-2.0f, 2.0f);
+    std::vector<float> values (numPoints * 3u);
+    for (auto &value : values)
+    {
+        value = distribution (random);
+    }
+
+    using Clock = std::chrono::steady_clock;
+    size_t streamSize = 0u;
+    auto start = Clock::now();
+    for (auto i = 0; i < repetitions; ++i)
+    {
+        std::ostringstream stream;
+        for (const auto value : values)
+        {
+            stream << value << ' ';
+        }
+        streamSize += stream.str().size();
+    }
+    const auto streamTime = std::chrono::duration_cast<std::chrono::microseconds> (Clock::now() - start);
+
+    size_t formatSize = 0u;
+    std::vector<char> buffer (values.size() * (FLOAT_FORMAT_BUFFER_SIZE + 1u));
+    start = Clock::now();
+    for (auto i = 0; i < repetitions; ++i)
+    {
+        auto pos = buffer.data();
+        for (const auto value : values)
+        {
+            pos = formatFloatShortest (value, pos);
+            *pos++ = ' ';
+        }
+        formatSize += static_cast<size_t> (pos - buffer.data());
+    }
+    const auto formatTime = std::chrono::duration_cast<std::chrono::microseconds> (Clock::now() - start);
+
+    std::cout << "ostream:             " << streamTime.count() / repetitions << " us per frame ("
+              << streamSize / repetitions << " bytes)" << std::endl;
+    std::cout << "formatFloatShortest: " << formatTime.count() / repetitions << " us per frame ("
+              << formatSize / repetitions << " bytes)" << std::endl;
+}
@@ -0,0 +1,204 @@
+/****************************************************************************\
+* Copyright (C) 2019 pmdtechnologies ag
+*
+* THIS CODE AND INFORMATION ARE PROVIDED "AS IS" WITHOUT WARRANTY OF ANY
+* KIND, EITHER EXPRESSED OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE
+* IMPLIED WARRANTIES OF MERCHANTABILITY AND/OR FITNESS FOR A
+* PARTICULAR PURPOSE.
+*
+\****************************************************************************/
+
+#include <importExportHelperLib/plyHelper.hpp>
+#include <gtest/gtest.h>
+
+#include <cstdint>
+#include <cstring>
+#include <sstream>
+#include <string>
+#include <vector>
+
+using namespace royale;
+using namespace royale::importExportHelperLib;
+
+namespace
+{
+    struct TphVertex
+    {
+        float x;
+        float y;
+        float z;
+        float amplitude;
+        uint32_t red;
+        uint32_t green;
+        uint32_t blue;
+    };
+
+    /**
+     * A frame with a point of each interesting kind: the highest amplitude first, an invalid
+     * point, the lowest amplitude, and values that need all digits of a float.
+     */
+    void tphFillDepthData (DepthData &depthData)
+    {
+        depthData.version = 1;
+        depthData.streamId = 0;
+        depthData.width = 2;
+        depthData.height = 2;
+
+        DepthPoint point {};
+        point.x = -0.123456789f;
+        point.y = 1.0f / 3.0f;
+        point.z = 2.5f;
+        point.grayValue = 2000u;
+        point.depthConfidence = 255u;
+        depthData.points.push_back (point);
+
+        point.x = 0.0f;
+        point.y = 0.0f;
+        point.z = 0.0f;
+        point.grayValue = 3000u;
+        point.depthConfidence = 0u;
+        depthData.points.push_back (point);
+
+        point.x = 1e-7f;
+        point.y = -7.25f;
+        point.z = 0.3f;
+        point.grayValue = 100u;
+        point.depthConfidence = 10u;
+        depthData.points.push_back (point);
+
+        point.x = 3.4e38f;
+        point.y = -1e-38f;
+        point.z = 0.1f;
+        point.grayValue = 1050u;
+        point.depthConfidence = 128u;
+        depthData.points.push_back (point);
+    }
+
+    /**
+     * Splits a PLY file into the header and the data after "end_header\n".
+     */
+    void tphSplit (const std::string &ply, std::string &header, std::string &data)
+    {
+        const std::string end = "end_header\n";
+        const auto pos = ply.find (end);
+        ASSERT_NE (std::string::npos, pos);
+        header = ply.substr (0, pos + end.size());
+        data = ply.substr (pos + end.size());
+    }
+
+    float tphReadLittleEndian (const uint8_t *src)
+    {
+        const uint32_t bits = static_cast<uint32_t> (src[0]) |
+                              static_cast<uint32_t> (src[1]) << 8 |
+                              static_cast<uint32_t> (src[2]) << 16 |
+                              static_cast<uint32_t> (src[3]) << 24;
+        float value;
+        std::memcpy (&value, &bits, sizeof (value));
+        return value;
+    }
+
+    std::vector<TphVertex> tphParseBinary (const std::string &data)
+    {
+        const size_t vertexSize = 4u * sizeof (float) + 3u;
+        EXPECT_EQ (0u, data.size() % vertexSize);
+
+        std::vector<TphVertex> vertices;
+        const auto bytes = reinterpret_cast<const uint8_t *> (data.data());
+        for (size_t offset = 0u; offset + vertexSize <= data.size(); offset += vertexSize)
+        {
+            TphVertex vertex;
+            vertex.x = tphReadLittleEndian (bytes + offset);
+            vertex.y = tphReadLittleEndian (bytes + offset + 4u);
+            vertex.z = tphReadLittleEndian (bytes + offset + 8u);
+            vertex.amplitude = tphReadLittleEndian (bytes + offset + 12u);
+            vertex.red = bytes[offset + 16u];
+            vertex.green = bytes[offset + 17u];
+            vertex.blue = bytes[offset + 18u];
+            vertices.push_back (vertex);
+        }
+        return vertices;
+    }
+
+    std::vector<TphVertex> tphParseAscii (const std::string &data)
+    {
+        std::vector<TphVertex> vertices;
+        std::istringstream is (data);
+        TphVertex vertex;
+        while (is >> vertex.x >> vertex.y >> vertex.z >> vertex.amplitude >> vertex.red >> vertex.green >> vertex.blue)
+        {
+            vertices.push_back (vertex);
+        }
+        return vertices;
+    }
+}
+
+/**
+ * The binary PLY is read back as the same points, with the same colors as the ASCII PLY.
+ */
+TEST (TestPlyHelper, BinaryRoundTrip)
+{
+    DepthData depthData;
+    tphFillDepthData (depthData);
+
+    std::ostringstream binary;
+    ASSERT_EQ (CameraStatus::SUCCESS, encodePLYBinary (&depthData, binary));
+    std::string binaryHeader;
+    std::string binaryData;
+    tphSplit (binary.str(), binaryHeader, binaryData);
+
+    std::ostringstream ascii;
+    ASSERT_EQ (CameraStatus::SUCCESS, encodePLY (&depthData, ascii));
+    std::string asciiHeader;
+    std::string asciiData;
+    tphSplit (ascii.str(), asciiHeader, asciiData);
+
+    EXPECT_NE (std::string::npos, binaryHeader.find ("format binary_little_endian 1.0\n"));
+    EXPECT_NE (std::string::npos, binaryHeader.find ("element vertex 4\n"));
+    EXPECT_NE (std::string::npos, asciiHeader.find ("format ascii 1.0\n"));
+
+    const auto binaryVertices = tphParseBinary (binaryData);
+    const auto asciiVertices = tphParseAscii (asciiData);
+    ASSERT_EQ (depthData.points.size(), binaryVertices.size());
+    ASSERT_EQ (depthData.points.size(), asciiVertices.size());
+
+    for (size_t i = 0u; i < depthData.points.size(); ++i)
+    {
+        const auto &point = depthData.points[i];
+        const auto &vertex = binaryVertices[i];
+        EXPECT_EQ (point.x, vertex.x);
+        EXPECT_EQ (point.y, vertex.y);
+        EXPECT_EQ (point.z, vertex.z);
+        EXPECT_EQ (static_cast<float> (point.grayValue), vertex.amplitude);
+        EXPECT_EQ (vertex.red, vertex.green);
+        EXPECT_EQ (vertex.red, vertex.blue);
+
+        // The ASCII file uses the shortest text that is read back as the same float
+        EXPECT_EQ (vertex.x, asciiVertices[i].x);
+        EXPECT_EQ (vertex.y, asciiVertices[i].y);
+        EXPECT_EQ (vertex.z, asciiVertices[i].z);
+        EXPECT_EQ (vertex.red, asciiVertices[i].red);
+    }
+}
+
+/**
+ * The amplitude is scaled to the colors 0 to 255 over the valid points, even if the highest
+ * amplitude is the first point.  Invalid points are black.
+ */
+TEST (TestPlyHelper, AmplitudeColor)
+{
+    DepthData depthData;
+    tphFillDepthData (depthData);
+
+    std::ostringstream binary;
+    ASSERT_EQ (CameraStatus::SUCCESS, encodePLYBinary (&depthData, binary));
+    std::string header;
+    std::string data;
+    tphSplit (binary.str(), header, data);
+    const auto vertices = tphParseBinary (data);
+    ASSERT_EQ (4u, vertices.size());
+
+    EXPECT_EQ (255u, vertices[0].red);
+    EXPECT_EQ (0u, vertices[1].red);
+    EXPECT_EQ (0u, vertices[2].red);
+    EXPECT_EQ (127u, vertices[3].red);
+}
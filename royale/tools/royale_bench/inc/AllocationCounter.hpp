@@ -0,0 +1,27 @@
+/****************************************************************************\
+ * Copyright (C) 2019 pmdtechnologies ag
+ *
+ * THIS CODE AND INFORMATION ARE PROVIDED "AS IS" WITHOUT WARRANTY OF ANY
+ * KIND, EITHER EXPRESSED OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND/OR FITNESS FOR A
+ * PARTICULAR PURPOSE.
+ *
+ \****************************************************************************/
+
+#pragma once
+
+#include <cstdint>
+
+namespace royale
+{
+    namespace bench
+    {
+        /**
+         * Number of calls to the global operator new (all variants) since the program started.
+         *
+         * The operators are replaced in AllocationCounter.cpp.  Royale is linked statically into
+         * the benchmark, so the allocations of the capture and processing chain are counted too.
+         */
+        uint64_t getAllocationCount();
+    }
+}
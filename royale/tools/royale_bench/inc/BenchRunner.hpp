@@ -0,0 +1,151 @@
+/****************************************************************************\
+ * Copyright (C) 2019 pmdtechnologies ag
+ *
+ * THIS CODE AND INFORMATION ARE PROVIDED "AS IS" WITHOUT WARRANTY OF ANY
+ * KIND, EITHER EXPRESSED OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND/OR FITNESS FOR A
+ * PARTICULAR PURPOSE.
+ *
+ \****************************************************************************/
+
+#pragma once
+
+#include <FakeBridgeDataReceiver.hpp>
+#include <StageTimingProcessing.hpp>
+
+#include <royale/ICameraDevice.hpp>
+#include <royale/IDepthDataListener.hpp>
+#include <royale/IExtendedDataListener.hpp>
+#include <usecase/UseCaseDefinition.hpp>
+
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <mutex>
+#include <string>
+#include <vector>
+
+namespace royale
+{
+    namespace bench
+    {
+        struct BenchOptions
+        {
+            /**
+             * Frames that are received before the measurement starts.
+             */
+            std::size_t warmupFrames = 10u;
+
+            /**
+             * Frames that are measured for each use case.
+             */
+            std::size_t measuredFrames = 100u;
+
+            /**
+             * Sequences per second, or zero for as fast as possible.  Negative means that the
+             * use case's target rate is used.
+             */
+            double rate = -1.;
+        };
+
+        /**
+         * Latencies in milliseconds, nearest-rank percentiles.
+         */
+        struct LatencyPercentiles
+        {
+            double p50 = 0.;
+            double p90 = 0.;
+            double p99 = 0.;
+            double max = 0.;
+        };
+
+        struct UseCaseResult
+        {
+            std::string name;
+
+            /**
+             * If not empty, the use case couldn't be measured and none of the other values are
+             * set.
+             */
+            std::string error;
+
+            std::size_t frames = 0u;
+            double framesPerSecond = 0.;
+            std::size_t droppedRawFrames = 0u;
+            double allocationsPerFrame = 0.;
+
+            /**
+             * From the time the sequence's raw frames were sent by the bridge until the listener
+             * was called.
+             */
+            LatencyPercentiles total;
+
+            /**
+             * The stages of the total latency:
+             * - collect: bridge until the FrameCollector handed the complete frame to processing
+             * - process: the processing itself
+             * - deliver: end of processing until the listener was called
+             */
+            LatencyPercentiles collect;
+            LatencyPercentiles process;
+            LatencyPercentiles deliver;
+        };
+
+        /**
+         * Runs each use case on an initialized ICameraDevice which uses the
+         * FakeBridgeDataReceiver, and measures the frames that arrive at the listener.
+         *
+         * The listener runs in Royale's processing thread, it only stores a timestamp per frame
+         * in a preallocated array.  Everything else is calculated after the capture has stopped.
+         */
+        class BenchRunner : public royale::IDepthDataListener, public royale::IExtendedDataListener
+        {
+        public:
+            /**
+             * \param stages written by the device's StageTimingProcessing
+             * \param rawData if true, the device has been created with CallbackData::Raw and
+             *        this registers as the extended listener instead of the depth listener
+             */
+            BenchRunner (royale::ICameraDevice &device, royale::stub::FakeBridgeDataReceiver &receiver,
+                         const StageTimestamps &stages, bool rawData);
+            ~BenchRunner();
+
+            UseCaseResult run (const royale::String &useCase,
+                               const royale::usecase::UseCaseDefinition &definition,
+                               const BenchOptions &options);
+
+            void onNewData (const royale::DepthData *data) override;
+            void onNewData (const royale::IExtendedData *data) override;
+
+        private:
+            struct Sample
+            {
+                int64_t captureNs;
+                int64_t callbackNs;
+                int64_t processedNs;
+                int64_t arrivalNs;
+            };
+
+            void addSample (std::chrono::microseconds timeStamp);
+
+            royale::ICameraDevice &m_device;
+            royale::stub::FakeBridgeDataReceiver &m_receiver;
+            const StageTimestamps &m_stages;
+            const bool m_rawData;
+
+            /**
+             * Difference between the system clock, which is used for the frame timestamps, and
+             * the monotonic clock of the measurements
+             */
+            int64_t m_clockOffsetNs;
+
+            std::mutex m_lock;
+            std::condition_variable m_cv;
+            std::vector<Sample> m_samples;
+            std::atomic<std::size_t> m_sampleCount;
+            std::size_t m_firstMeasured;
+            uint64_t m_allocationsAtFirst;
+            uint64_t m_allocationsAtLast;
+        };
+    }
+}
@@ -0,0 +1,89 @@
+/****************************************************************************\
+ * Copyright (C) 2019 pmdtechnologies ag
+ *
+ * THIS CODE AND INFORMATION ARE PROVIDED "AS IS" WITHOUT WARRANTY OF ANY
+ * KIND, EITHER EXPRESSED OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND/OR FITNESS FOR A
+ * PARTICULAR PURPOSE.
+ *
+ \****************************************************************************/
+
+#pragma once
+
+#include <processing/Processing.hpp>
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <memory>
+#include <utility>
+#include <vector>
+
+namespace royale
+{
+    namespace bench
+    {
+        /**
+         * Monotonic clock in nanoseconds, used for all latencies of the benchmark.
+         */
+        inline int64_t monotonicNs()
+        {
+            return std::chrono::duration_cast<std::chrono::nanoseconds> (
+                       std::chrono::steady_clock::now().time_since_epoch()).count();
+        }
+
+        /**
+         * When the processing of the current frame started and finished.  Both are written and
+         * read in the processing thread, the listener is called from the same capture callback.
+         */
+        struct StageTimestamps
+        {
+            std::atomic<int64_t> callbackNs {0};
+            std::atomic<int64_t> processedNs {0};
+        };
+
+        /**
+         * Wraps the processing (ProcessingSpectre or ProcessingSimple) to record when the
+         * FrameCollector handed over a frame and when its processing finished.  This doesn't
+         * depend on the trace zones, so the stage latencies are available in every build.
+         */
+        template <typename Base>
+        class StageTimingProcessing : public Base
+        {
+        public:
+            template <typename... Args>
+            explicit StageTimingProcessing (StageTimestamps &timestamps, Args &&... args) :
+                Base (std::forward<Args> (args)...),
+                m_timestamps (timestamps)
+            {
+            }
+
+            void captureCallback (std::vector<royale::common::ICapturedRawFrame *> &frames,
+                                  const royale::usecase::UseCaseDefinition &definition,
+                                  royale::StreamId streamId,
+                                  std::unique_ptr<const royale::collector::CapturedUseCase> capturedCase) override
+            {
+                const auto now = monotonicNs();
+                m_timestamps.callbackNs = now;
+                // If the frame isn't processed, the processing stage has zero length
+                m_timestamps.processedNs = now;
+                Base::captureCallback (frames, definition, streamId, std::move (capturedCase));
+            }
+
+        protected:
+            void processFrame (std::vector<royale::common::ICapturedRawFrame *> &frames,
+                               std::unique_ptr<const royale::collector::CapturedUseCase> capturedCase,
+                               const typename Base::DepthDataItem &depthData,
+                               const royale::Vector<uint32_t> &capturedTimes,
+                               std::vector<uint32_t> &newExposureTimes,
+                               uint32_t outputDemand) override
+            {
+                Base::processFrame (frames, std::move (capturedCase), depthData, capturedTimes, newExposureTimes, outputDemand);
+                m_timestamps.processedNs = monotonicNs();
+            }
+
+        private:
+            StageTimestamps &m_timestamps;
+        };
+    }
+}
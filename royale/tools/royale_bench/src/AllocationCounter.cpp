@@ -0,0 +1,76 @@
+/****************************************************************************\
+ * Copyright (C) 2019 pmdtechnologies ag
+ *
+ * THIS CODE AND INFORMATION ARE PROVIDED "AS IS" WITHOUT WARRANTY OF ANY
+ * KIND, EITHER EXPRESSED OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND/OR FITNESS FOR A
+ * PARTICULAR PURPOSE.
+ *
+ \****************************************************************************/
+
+#include <AllocationCounter.hpp>
+
+#include <atomic>
+#include <cstdlib>
+#include <new>
+
+namespace
+{
+    std::atomic<uint64_t> allocations (0u);
+
+    void *countedAlloc (std::size_t size)
+    {
+        allocations.fetch_add (1u, std::memory_order_relaxed);
+        return std::malloc (size ? size : 1u);
+    }
+}
+
+uint64_t royale::bench::getAllocationCount()
+{
+    return allocations.load (std::memory_order_relaxed);
+}
+
+void *operator new (std::size_t size)
+{
+    auto p = countedAlloc (size);
+    if (!p)
+    {
+        throw std::bad_alloc();
+    }
+    return p;
+}
+
+void *operator new[] (std::size_t size)
+{
+    return operator new (size);
+}
+
+void *operator new (std::size_t size, const std::nothrow_t &) noexcept
+{
+    return countedAlloc (size);
+}
+
+void *operator new[] (std::size_t size, const std::nothrow_t &) noexcept
+{
+    return countedAlloc (size);
+}
+
+void operator delete (void *p) noexcept
+{
+    std::free (p);
+}
+
+void operator delete[] (void *p) noexcept
+{
+    std::free (p);
+}
+
+void operator delete (void *p, const std::nothrow_t &) noexcept
+{
+    std::free (p);
+}
+
+void operator delete[] (void *p, const std::nothrow_t &) noexcept
+{
+    std::free (p);
+}
@@ -0,0 +1,212 @@
+/****************************************************************************\
+ * Copyright (C) 2019 pmdtechnologies ag
+ *
+ * THIS CODE AND INFORMATION ARE PROVIDED "AS IS" WITHOUT WARRANTY OF ANY
+ * KIND, EITHER EXPRESSED OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND/OR FITNESS FOR A
+ * PARTICULAR PURPOSE.
+ *
+ \****************************************************************************/
+
+#include <BenchRunner.hpp>
+#include <AllocationCounter.hpp>
+
+#include <common/RoyaleTrace.hpp>
+#include <royale/IExtendedData.hpp>
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+
+using namespace royale;
+using namespace royale::bench;
+using royale::stub::FakeBridgeDataReceiver;
+
+namespace
+{
+    /**
+     * Time allowed for the capture to start, in addition to the time needed for the frames
+     */
+    const auto START_TIMEOUT = std::chrono::seconds (10);
+
+    LatencyPercentiles calculatePercentiles (std::vector<int64_t> &valuesNs)
+    {
+        LatencyPercentiles result;
+        if (valuesNs.empty())
+        {
+            return result;
+        }
+        std::sort (valuesNs.begin(), valuesNs.end());
+        auto percentile = [&valuesNs] (double p)
+        {
+            const auto rank = static_cast<std::size_t> (std::ceil (p * static_cast<double> (valuesNs.size())));
+            return static_cast<double> (valuesNs[std::max<std::size_t> (rank, 1u) - 1u]) * 1e-6;
+        };
+        result.p50 = percentile (.5);
+        result.p90 = percentile (.9);
+        result.p99 = percentile (.99);
+        result.max = static_cast<double> (valuesNs.back()) * 1e-6;
+        return result;
+    }
+}
+
+BenchRunner::BenchRunner (ICameraDevice &device, FakeBridgeDataReceiver &receiver,
+                          const StageTimestamps &stages, bool rawData) :
+    m_device (device),
+    m_receiver (receiver),
+    m_stages (stages),
+    m_rawData (rawData),
+    m_sampleCount (0u),
+    m_firstMeasured (0u),
+    m_allocationsAtFirst (0u),
+    m_allocationsAtLast (0u)
+{
+    const auto systemNs = std::chrono::duration_cast<std::chrono::nanoseconds> (
+                              std::chrono::system_clock::now().time_since_epoch()).count();
+    m_clockOffsetNs = systemNs - monotonicNs();
+
+    if (m_rawData)
+    {
+        m_device.registerDataListenerExtended (this);
+    }
+    else
+    {
+        m_device.registerDataListener (this);
+    }
+}
+
+BenchRunner::~BenchRunner()
+{
+    if (m_rawData)
+    {
+        m_device.unregisterDataListenerExtended();
+    }
+    else
+    {
+        m_device.unregisterDataListener();
+    }
+}
+
+void BenchRunner::onNewData (const DepthData *data)
+{
+    addSample (data->timeStamp);
+}
+
+void BenchRunner::onNewData (const IExtendedData *data)
+{
+    if (data->hasRawData())
+    {
+        addSample (data->getRawData()->timeStamp);
+    }
+}
+
+void BenchRunner::addSample (std::chrono::microseconds timeStamp)
+{
+    const auto arrivalNs = monotonicNs();
+    const auto allocations = getAllocationCount();
+
+    const auto index = m_sampleCount.load();
+    if (index >= m_samples.size())
+    {
+        return;
+    }
+
+    m_samples[index] = { timeStamp.count() * 1000 - m_clockOffsetNs, m_stages.callbackNs, m_stages.processedNs, arrivalNs };
+    if (index == m_firstMeasured)
+    {
+        m_allocationsAtFirst = allocations;
+    }
+    if (index + 1 == m_samples.size())
+    {
+        m_allocationsAtLast = allocations;
+        std::lock_guard<std::mutex> lock (m_lock);
+        m_sampleCount = index + 1;
+        m_cv.notify_all();
+    }
+    else
+    {
+        m_sampleCount = index + 1;
+    }
+}
+
+UseCaseResult BenchRunner::run (const String &useCase,
+                                const usecase::UseCaseDefinition &definition,
+                                const BenchOptions &options)
+{
+    UseCaseResult result;
+    result.name = useCase.toStdString();
+
+    if (definition.getStreamIds().size() != 1)
+    {
+        result.error = "mixed mode is not supported";
+        return result;
+    }
+
+    const double rate = options.rate < 0. ? definition.getTargetRate() : options.rate;
+    m_receiver.setSequence (definition.getRawFrameCount(), rate);
+
+    auto status = m_device.setUseCase (useCase);
+    if (status != CameraStatus::SUCCESS)
+    {
+        result.error = "setUseCase failed: " + getStatusString (status).toStdString();
+        return result;
+    }
+
+    const auto measuredFrames = std::max<std::size_t> (options.measuredFrames, 2u);
+    m_samples.assign (options.warmupFrames + measuredFrames, Sample{ 0, 0, 0, 0 });
+    m_firstMeasured = options.warmupFrames;
+    m_sampleCount = 0u;
+#ifdef ROYALE_ENABLE_TRACING
+    royale::common::Tracer::clear();
+#endif
+
+    status = m_device.startCapture();
+    if (status != CameraStatus::SUCCESS)
+    {
+        result.error = "startCapture failed: " + getStatusString (status).toStdString();
+        return result;
+    }
+
+    const double expectedRate = rate > 0. ? rate : std::max<double> (definition.getTargetRate(), 1.);
+    const auto timeout = START_TIMEOUT + std::chrono::milliseconds (
+                             static_cast<int64_t> (3000. * static_cast<double> (m_samples.size()) / expectedRate));
+    {
+        std::unique_lock<std::mutex> lock (m_lock);
+        m_cv.wait_for (lock, timeout, [this] { return m_sampleCount == m_samples.size(); });
+    }
+
+    m_device.stopCapture();
+    result.droppedRawFrames = m_receiver.getDroppedFrames();
+
+    if (m_sampleCount != m_samples.size())
+    {
+        result.error = "timed out after " + std::to_string (m_sampleCount) + " frames";
+        return result;
+    }
+
+    const auto first = m_firstMeasured;
+    const auto last = m_samples.size() - 1u;
+    result.frames = last - first + 1u;
+
+    const auto durationNs = m_samples[last].arrivalNs - m_samples[first].arrivalNs;
+    result.framesPerSecond = durationNs > 0 ? 1e9 * static_cast<double> (last - first) / static_cast<double> (durationNs) : 0.;
+    result.allocationsPerFrame = static_cast<double> (m_allocationsAtLast - m_allocationsAtFirst) / static_cast<double> (last - first);
+
+    std::vector<int64_t> total;
+    std::vector<int64_t> collect;
+    std::vector<int64_t> process;
+    std::vector<int64_t> deliver;
+    for (auto i = first; i <= last; i++)
+    {
+        const auto &sample = m_samples[i];
+        total.push_back (sample.arrivalNs - sample.captureNs);
+        collect.push_back (sample.callbackNs - sample.captureNs);
+        process.push_back (sample.processedNs - sample.callbackNs);
+        deliver.push_back (sample.arrivalNs - sample.processedNs);
+    }
+    result.total = calculatePercentiles (total);
+    result.collect = calculatePercentiles (collect);
+    result.process = calculatePercentiles (process);
+    result.deliver = calculatePercentiles (deliver);
+    return result;
+}
@@ -0,0 +1,323 @@
+/****************************************************************************\
+ * Copyright (C) 2019 pmdtechnologies ag
+ *
+ * THIS CODE AND INFORMATION ARE PROVIDED "AS IS" WITHOUT WARRANTY OF ANY
+ * KIND, EITHER EXPRESSED OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND/OR FITNESS FOR A
+ * PARTICULAR PURPOSE.
+ *
+ \****************************************************************************/
+
+/**
+ * Measures the capture and processing pipeline of Royale without a camera.  A CameraDevice is
+ * created on top of a FakeBridgeImager and FakeBridgeDataReceiver which behave like a pico
+ * flexx, and each use case is run for a fixed number of frames.
+ *
+ * The image data is either a synthetic pattern or the raw data from a recording.  Depth data
+ * is only calculated if calibration data is available (from the recording or from the
+ * --calibration option), otherwise the raw data is measured.
+ */
+
+#include <BenchRunner.hpp>
+#include <FakeBridgeDataReceiver.hpp>
+#include <FakeBridgeImager.hpp>
+#include <FakeFrameSource.hpp>
+#include <StageTimingProcessing.hpp>
+
+#include <common/RoyaleLogger.hpp>
+#include <common/RoyaleTrace.hpp>
+#include <device/CameraCore.hpp>
+#include <device/CameraDevice.hpp>
+#include <factory/CoreConfigFactory.hpp>
+#include <factory/ImagerFactory.hpp>
+#include <hal/ITemperatureSensor.hpp>
+#include <modules/ModuleConfigData.hpp>
+#include <modules/UsbProbeDataListRoyale.hpp>
+
+#ifdef USE_SPECTRE
+#include <processing/ProcessingSpectre.hpp>
+#else
+#include <processing/ProcessingSimple.hpp>
+#endif
+
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <iterator>
+#include <memory>
+#include <sstream>
+#include <string>
+
+using namespace royale;
+using namespace royale::bench;
+using namespace royale::stub;
+
+namespace
+{
+    /**
+     * Recorded frames kept in memory when replaying an RRF file
+     */
+    const uint32_t MAX_RECORDED_FRAMES = 32u;
+
+    /**
+     * The module doesn't have a temperature sensor, the imager's pseudo data has the same value
+     */
+    class FixedTemperatureSensor : public royale::hal::ITemperatureSensor
+    {
+    public:
+        float getTemperature() override
+        {
+            return 30.0f;
+        }
+    };
+
+    struct CommandLine
+    {
+        BenchOptions bench;
+        std::string rrfFile;
+        std::string calibrationFile;
+        std::string useCase;
+        std::string traceFile;
+        bool verbose = false;
+    };
+
+    void printUsage (const char *name)
+    {
+        std::cout << "Usage: " << name << " [options]" << std::endl
+                  << std::endl
+                  << "Runs Royale's capture and processing chain on a simulated pico flexx and reports" << std::endl
+                  << "frames/s, latency percentiles and allocations per frame for each use case." << std::endl
+                  << std::endl
+                  << "  --rrf <file>          replay the raw data (and calibration) of a recording" << std::endl
+                  << "  --calibration <file>  calibration data, enables depth processing of synthetic data" << std::endl
+                  << "  --usecase <name>      only run this use case" << std::endl
+                  << "  --frames <n>          frames measured per use case (default 100)" << std::endl
+                  << "  --warmup <n>          frames skipped before measuring (default 10)" << std::endl
+                  << "  --rate <fps>          send frames at this rate instead of the use case's rate" << std::endl
+                  << "  --max-rate            send frames as fast as the pipeline returns the buffers" << std::endl
+                  << "  --trace <file>        write the trace zones in Chrome's trace format" << std::endl
+                  << "  --verbose             don't suppress Royale's warnings" << std::endl
+                  << std::endl
+                  << "The --trace option needs a Royale build with ROYALE_ENABLE_TRACING." << std::endl;
+    }
+
+    bool parseCommandLine (int argc, char *argv[], CommandLine &cmd)
+    {
+        for (int i = 1; i < argc; i++)
+        {
+            const std::string arg = argv[i];
+            const bool hasValue = i + 1 < argc;
+            if (arg == "--rrf" && hasValue)
+            {
+                cmd.rrfFile = argv[++i];
+            }
+            else if (arg == "--calibration" && hasValue)
+            {
+                cmd.calibrationFile = argv[++i];
+            }
+            else if (arg == "--usecase" && hasValue)
+            {
+                cmd.useCase = argv[++i];
+            }
+            else if (arg == "--frames" && hasValue)
+            {
+                cmd.bench.measuredFrames = std::stoul (argv[++i]);
+            }
+            else if (arg == "--warmup" && hasValue)
+            {
+                cmd.bench.warmupFrames = std::stoul (argv[++i]);
+            }
+            else if (arg == "--rate" && hasValue)
+            {
+                cmd.bench.rate = std::stod (argv[++i]);
+            }
+            else if (arg == "--max-rate")
+            {
+                cmd.bench.rate = 0.;
+            }
+            else if (arg == "--trace" && hasValue)
+            {
+#ifdef ROYALE_ENABLE_TRACING
+                cmd.traceFile = argv[++i];
+#else
+                std::cerr << "--trace needs a Royale build with ROYALE_ENABLE_TRACING" << std::endl;
+                return false;
+#endif
+            }
+            else if (arg == "--verbose")
+            {
+                cmd.verbose = true;
+            }
+            else
+            {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    std::string formatPercentiles (const LatencyPercentiles &p)
+    {
+        std::ostringstream ss;
+        ss << std::fixed << std::setprecision (2) << p.p50 << " / " << p.p90 << " / " << p.p99;
+        return ss.str();
+    }
+
+    void printResult (const UseCaseResult &result)
+    {
+        std::cout << result.name << std::endl;
+        if (!result.error.empty())
+        {
+            std::cout << "    skipped: " << result.error << std::endl;
+            return;
+        }
+
+        std::cout << std::fixed << std::setprecision (2)
+                  << "    frames/s           " << result.framesPerSecond
+                  << " (" << result.frames << " frames, " << result.droppedRawFrames << " raw frames dropped)" << std::endl
+                  << "    allocations/frame  " << std::setprecision (1) << result.allocationsPerFrame << std::endl
+                  << "    latency ms         p50 / p90 / p99         max" << std::endl
+                  << "      total            " << std::left << std::setw (24) << formatPercentiles (result.total)
+                  << std::right << std::setprecision (2) << result.total.max << std::endl
+                  << "      collect          " << std::left << std::setw (24) << formatPercentiles (result.collect)
+                  << std::right << result.collect.max << std::endl
+                  << "      process          " << std::left << std::setw (24) << formatPercentiles (result.process)
+                  << std::right << result.process.max << std::endl
+                  << "      deliver          " << std::left << std::setw (24) << formatPercentiles (result.deliver)
+                  << std::right << result.deliver.max << std::endl;
+    }
+}
+
+int main (int argc, char *argv[])
+{
+    CommandLine cmd;
+    try
+    {
+        if (!parseCommandLine (argc, argv, cmd))
+        {
+            printUsage (argv[0]);
+            return 1;
+        }
+    }
+    catch (const std::exception &)
+    {
+        printUsage (argv[0]);
+        return 1;
+    }
+
+    royale::common::LogSettings::getInstance()->setLogLevel (static_cast<uint16_t> (cmd.verbose ?
+            (static_cast<uint16_t> (RoyaleLoggerLevels::WARN_) | static_cast<uint16_t> (RoyaleLoggerLevels::ERROR_)) :
+            static_cast<uint16_t> (RoyaleLoggerLevels::ERROR_)));
+
+    std::shared_ptr<IFakeFrameSource> source;
+    std::vector<uint8_t> calibration;
+    if (cmd.rrfFile.empty())
+    {
+        source = std::make_shared<SyntheticFrameSource>();
+    }
+    else
+    {
+        try
+        {
+            auto rrf = std::make_shared<RrfFrameSource> (cmd.rrfFile, MAX_RECORDED_FRAMES);
+            std::cout << "Replaying " << rrf->getRawFrameCount() << " raw frames from " << cmd.rrfFile << std::endl;
+            calibration = rrf->getCalibrationData();
+            source = rrf;
+        }
+        catch (const std::exception &e)
+        {
+            std::cerr << "Can't read " << cmd.rrfFile << ": " << e.what() << std::endl;
+            return 1;
+        }
+    }
+
+    if (!cmd.calibrationFile.empty())
+    {
+        std::ifstream file (cmd.calibrationFile, std::ios::binary);
+        if (!file.is_open())
+        {
+            std::cerr << "Can't open " << cmd.calibrationFile << std::endl;
+            return 1;
+        }
+        calibration.assign (std::istreambuf_iterator<char> (file), std::istreambuf_iterator<char>());
+    }
+    const bool rawData = calibration.empty();
+
+    const auto &moduleConfig = royale::config::moduleconfig::PicoFlexxU6;
+    std::shared_ptr<const royale::config::ICoreConfig> coreConfig =
+        royale::factory::CoreConfigFactory (moduleConfig, royale::config::getProcessingParameterMapFactoryRoyale()) ();
+
+    auto fakeImager = std::make_shared<FakeBridgeImager>();
+    auto receiver = std::make_shared<FakeBridgeDataReceiver> (fakeImager, source);
+
+    StageTimestamps stages;
+    std::unique_ptr<device::CameraDevice> cameraDevice;
+    try
+    {
+        auto imager = royale::factory::ImagerFactory::createImager (
+                          fakeImager, coreConfig,
+                          std::make_shared<const royale::config::ImagerConfig> (moduleConfig.imagerConfig),
+                          moduleConfig.illuminationConfig, false);
+
+        std::unique_ptr<device::CameraCore> cameraCore
+        {
+            new device::CameraCore (coreConfig, imager, receiver, std::make_shared<FixedTemperatureSensor>(),
+                                    nullptr, nullptr, nullptr, CameraAccessLevel::L3)
+        };
+
+#ifdef USE_SPECTRE
+        std::shared_ptr<processing::IProcessing> processing (
+            new StageTimingProcessing<processing::ProcessingSpectre> (stages, cameraCore->getCaptureReleaser()));
+#else
+        std::shared_ptr<processing::IProcessing> processing (
+            new StageTimingProcessing<processing::ProcessingSimple> (stages, cameraCore->getCaptureReleaser()));
+#endif
+
+        cameraDevice.reset (new device::CameraDevice (CameraAccessLevel::L3, "fake", std::move (cameraCore), coreConfig,
+                            processing, rawData ? CallbackData::Raw : CallbackData::Depth));
+    }
+    catch (const std::exception &e)
+    {
+        std::cerr << "Can't create the camera: " << e.what() << std::endl;
+        return 1;
+    }
+
+    if (!rawData && cameraDevice->setCalibrationData (Vector<uint8_t>::fromStdVector (calibration)) != CameraStatus::SUCCESS)
+    {
+        std::cerr << "Can't use the calibration data" << std::endl;
+        return 1;
+    }
+    const auto status = cameraDevice->initialize();
+    if (status != CameraStatus::SUCCESS)
+    {
+        std::cerr << "Can't initialize the camera: " << getStatusString (status) << std::endl;
+        return 1;
+    }
+    std::cout << (rawData ? "No calibration data, measuring raw data without processing" : "Measuring depth data") << std::endl
+              << std::endl;
+
+#ifdef ROYALE_ENABLE_TRACING
+    royale::common::Tracer::setEnabled (true);
+#endif
+    {
+        BenchRunner runner (*cameraDevice, *receiver, stages, rawData);
+        for (const auto &useCase : coreConfig->getSupportedUseCases())
+        {
+            if (!cmd.useCase.empty() && useCase.getName().toStdString() != cmd.useCase)
+            {
+                continue;
+            }
+            printResult (runner.run (useCase.getName(), *useCase.getDefinition(), cmd.bench));
+        }
+    }
+#ifdef ROYALE_ENABLE_TRACING
+    royale::common::Tracer::setEnabled (false);
+
+    if (!cmd.traceFile.empty() && !royale::common::Tracer::writeChromeTrace (cmd.traceFile))
+    {
+        std::cerr << "Can't write " << cmd.traceFile << std::endl;
+        return 1;
+    }
+#endif
+    return 0;
+}
@@ -12,6 +12,7 @@
 
 #include "IView.hpp"
 #include "ColorHelper.hpp"
+#include "Colorizer.hpp"
 #include <royale/DepthData.hpp>
 #include "PixelInfoManager.hpp"
 
@@ -85,7 +86,7 @@ private:
     void setTooltipText (QMouseEvent *event);
     void adjustDrawingRectangle();
 private:
-    std::vector<uint8_t>      m_imageBuffer;
+    Colorizer                 m_colorizer;
     QImage                    m_image;
     QString                   m_toolTipText;
     const royale::DepthData  *m_currentDataset;
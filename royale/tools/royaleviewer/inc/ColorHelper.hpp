@@ -128,6 +128,27 @@ public:
     void enableGammaCorrection (bool enable);
     void setGammaValue (float val);
 
+    /**
+     * The lookup tables and the ranges that getColor and getGrayColor use, for colorizing a
+     * whole image without a call per pixel (see Colorizer).  The pointers stay valid for the
+     * lifetime of the ColorHelper, the contents change with the ranges and gamma.
+     */
+    struct Lookup
+    {
+        const RgbColor *colors;
+        uint8_t colorCount;
+        float minDist;
+        float maxDist;
+        float oneThroughSpanDist;
+
+        const RgbColor *grays;
+        uint8_t grayCount;
+        uint16_t minVal;
+        uint16_t maxVal;
+        uint16_t spanVal;
+    };
+    Lookup getLookup() const;
+
 private:
     RgbColor HsvToRgb (const HsvColor &hsv);
 
@@ -0,0 +1,96 @@
+/****************************************************************************\
+ * Copyright (C) 2019 pmdtechnologies ag
+ *
+ * THIS CODE AND INFORMATION ARE PROVIDED "AS IS" WITHOUT WARRANTY OF ANY
+ * KIND, EITHER EXPRESSED OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND/OR FITNESS FOR A
+ * PARTICULAR PURPOSE.
+ *
+ \****************************************************************************/
+
+#pragma once
+
+#include "ColorHelper.hpp"
+#include <royale/DepthData.hpp>
+#include <royale/IntermediateData.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+/**
+ * Converts the depth data to the 2D view's image, without using Qt so that it can be tested and
+ * measured without a display.
+ *
+ * The output is in the format of QImage::Format_ARGB32, each pixel is a uint32_t 0xAARRGGBB.  The
+ * colors are the same as ColorHelper::getColor and ColorHelper::getGrayColor return, but they are
+ * taken from tables of complete pixels, so each pixel is a single store.  Mirroring is done while
+ * writing the pixels.
+ */
+class Colorizer
+{
+public:
+    enum class Mode
+    {
+        DISTANCE,   //!< color for the distance, gray for pixels with the SBI flag
+        GRAY,       //!< gray value, through the ColorHelper's gray range and gamma
+        IR,         //!< gray value as received, without scaling
+        OVERLAY,    //!< color for the distance, darkened by the gray value
+        FLAGS       //!< black for pixels with any flag set, white for the others
+    };
+
+    Colorizer();
+
+    /**
+     * Takes the ranges and tables of the ColorHelper.  This must be called again after they
+     * change, it only rebuilds the tables that have changed.
+     */
+    void setColors (const ColorHelper &colorHelper);
+
+    /**
+     * Pixels with a distance outside this range are black.
+     */
+    void setFilter (float filterMin, float filterMax);
+
+    void setMirrored (bool horizontally, bool vertically);
+
+    /**
+     * Writes the image for data to dest, which has depthData.height lines of bytesPerLine bytes.
+     * The intermediate data is only used for the DISTANCE and FLAGS modes, and must have the same
+     * size as the depth data.
+     */
+    void colorize (Mode mode, const royale::DepthData &depthData, const royale::IntermediateData &intData,
+                   uint8_t *dest, std::size_t bytesPerLine);
+
+private:
+    void colorizeLine (Mode mode, const royale::DepthPoint *points, const royale::IntermediatePoint *intPoints,
+                       std::size_t width, uint32_t *dest, std::ptrdiff_t step);
+
+    /**
+     * The colors of ColorHelper::getColor, followed by black and the color for the SBI flag.
+     */
+    std::vector<uint32_t> m_distanceTable;
+    std::size_t m_blackDistance;
+    std::size_t m_sbiDistance;
+    float m_minDist;
+    float m_maxDist;
+    float m_oneThroughSpanDist;
+    float m_maxDistIndex;
+
+    /**
+     * The color of ColorHelper::getGrayColor for each value from m_minVal to m_maxVal, followed
+     * by black.  Indexing this directly avoids a division for each pixel.
+     */
+    std::vector<uint32_t> m_grayTable;
+    std::vector<RgbColor> m_grays;
+    uint16_t m_minVal;
+    uint16_t m_maxVal;
+
+    float m_filterMin;
+    float m_filterMax;
+    bool m_mirrorHorizontally;
+    bool m_mirrorVertically;
+
+    /** Table indices for one line of the image */
+    std::vector<uint32_t> m_lineIndex;
+};
@@ -1,22 +0,0 @@
-/****************************************************************************\
- * Copyright (C) 2015 pmdtechnologies ag
- *
- * THIS CODE AND INFORMATION ARE PROVIDED "AS IS" WITHOUT WARRANTY OF ANY
- * KIND, EITHER EXPRESSED OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE
- * IMPLIED WARRANTIES OF MERCHANTABILITY AND/OR FITNESS FOR A
- * PARTICULAR PURPOSE.
- *
- \****************************************************************************/
-
-#pragma once
-
-#include <string>
-#include <royale/DepthData.hpp>
-
-class PLYWriter
-{
-public:
-
-    static void writePLY (const std::string &filename, const royale::DepthData *data);
-
-};
@@ -335,6 +335,9 @@ private:
     bool                                            m_isConnected;
     std::map<royale::StreamId, royale::DepthData>   m_currentData;
     std::map<royale::StreamId, royale::IntermediateData> m_currentIntermediateData;
+    /** Back buffers for m_currentData and m_currentIntermediateData, only used in onNewData */
+    std::map<royale::StreamId, royale::DepthData>   m_nextData;
+    std::map<royale::StreamId, royale::IntermediateData> m_nextIntermediateData;
     QMutex                                         *m_dataMutex;
     QTimer                                          m_fpsTimer;
     QTimer                                          m_validPixelsNumberTimer;
@@ -61,128 +61,27 @@ void TwoDView::fillImage()
         return;
     }
 
-    m_imageBuffer.resize (m_currentDataset->height * m_currentDataset->width * 4);
-
-    unsigned int numPoints = m_currentDataset->height * m_currentDataset->width;
-
-    const DepthPoint *currentPoint = &m_currentDataset->points[0];
-    const IntermediatePoint *currentInterPoint = &m_currentInterDataset->points[0];
-    uint8_t *currentImagerBuffer = &m_imageBuffer[0];
-
+    Colorizer::Mode mode;
     if (m_showGrayimage || m_irMode)
     {
-        for (auto idx = 0u; idx < numPoints; ++idx, ++currentPoint, ++currentInterPoint)
-        {
-            if (currentPoint->z < m_filterMin || currentPoint->z > m_filterMax)
-            {
-                //note: qt's QImage::Format_ARGB32, i.e. 32-bit ARGB format (0xAARRGGBB).
-                * (currentImagerBuffer++) = 0u;
-                * (currentImagerBuffer++) = 0u;
-                * (currentImagerBuffer++) = 0u;
-                * (currentImagerBuffer++) = 255u; // full opaque
-            }
-            else
-            {
-                if (m_irMode)
-                {
-                    // For IR mode we just take the value returned from Spectre
-                    //note: qt's QImage::Format_ARGB32, i.e. 32-bit ARGB format (0xAARRGGBB).s
-                    * (currentImagerBuffer++) = static_cast<uint8_t> (currentPoint->grayValue);
-                    * (currentImagerBuffer++) = static_cast<uint8_t> (currentPoint->grayValue);
-                    * (currentImagerBuffer++) = static_cast<uint8_t> (currentPoint->grayValue);
-                    * (currentImagerBuffer++) = 255u; // full opaque
-                }
-                else
-                {
-                    const RgbColor &curColor = m_colorHelper->getGrayColor (currentPoint->grayValue);
-
-                    //note: qt's QImage::Format_ARGB32, i.e. 32-bit ARGB format (0xAARRGGBB).s
-                    * (currentImagerBuffer++) = curColor.b;
-                    * (currentImagerBuffer++) = curColor.g;
-                    * (currentImagerBuffer++) = curColor.r;
-                    * (currentImagerBuffer++) = 255u; // full opaque
-                }
-            }
-        }
+        mode = m_irMode ? Colorizer::Mode::IR : Colorizer::Mode::GRAY;
     }
     else if (m_showDistance)
     {
-        for (auto idx = 0u; idx < numPoints; ++idx, ++currentPoint, ++currentInterPoint)
-        {
-            if (currentInterPoint->flags & FLAGS_SBI_ON)
-            {
-                //note: qt's QImage::Format_ARGB32, i.e. 32-bit ARGB format (0xAARRGGBB).
-                * (currentImagerBuffer++) = 120u;
-                * (currentImagerBuffer++) = 120u;
-                * (currentImagerBuffer++) = 120u;
-                * (currentImagerBuffer++) = 255u; // full opaque
-            }
-            else if (currentPoint->z == 0.f || currentPoint->z < m_filterMin || currentPoint->z > m_filterMax)
-            {
-                //note: qt's QImage::Format_ARGB32, i.e. 32-bit ARGB format (0xAARRGGBB).
-                * (currentImagerBuffer++) = 0u;
-                * (currentImagerBuffer++) = 0u;
-                * (currentImagerBuffer++) = 0u;
-                * (currentImagerBuffer++) = 255u; // full opaque
-            }
-            else
-            {
-                const RgbColor &curColor = m_colorHelper->getColor (currentPoint->z);
-
-                //note: qt's QImage::Format_ARGB32, i.e. 32-bit ARGB format (0xAARRGGBB).
-                * (currentImagerBuffer++) = curColor.b;
-                * (currentImagerBuffer++) = curColor.g;
-                * (currentImagerBuffer++) = curColor.r;
-                * (currentImagerBuffer++) = 255u; // full opaque
-            }
-        }
+        mode = Colorizer::Mode::DISTANCE;
     }
     else if (m_showOverlayimage)
     {
-        for (auto idx = 0u; idx < numPoints; ++idx, ++currentPoint, ++currentInterPoint)
-        {
-            if (currentPoint->z == 0.f || currentPoint->z < m_filterMin || currentPoint->z > m_filterMax)
-            {
-                //note: qt's QImage::Format_ARGB32, i.e. 32-bit ARGB format (0xAARRGGBB).
-                * (currentImagerBuffer++) = 0u;
-                * (currentImagerBuffer++) = 0u;
-                * (currentImagerBuffer++) = 0u;
-                * (currentImagerBuffer++) = 255u; // full opaque
-            }
-            else
-            {
-                const RgbColor &curColor = m_colorHelper->getColor (currentPoint->z);
-                float grayVal = (float) m_colorHelper->getGrayColor (currentPoint->grayValue).r;
-                float scaleTmp = 8.0f * std::pow (currentPoint->z, 1.5f) * grayVal / 255.f;
-                float scale = qBound (0.f, scaleTmp, 1.f);
-
-                //note: qt's QImage::Format_ARGB32, i.e. 32-bit ARGB format (0xAARRGGBB).
-                * (currentImagerBuffer++) = static_cast<uint8_t> (scale * curColor.b);
-                * (currentImagerBuffer++) = static_cast<uint8_t> (scale * curColor.g);
-                * (currentImagerBuffer++) = static_cast<uint8_t> (scale * curColor.r);
-                * (currentImagerBuffer++) = 255u; // full opaque
-            }
-        }
+        mode = Colorizer::Mode::OVERLAY;
     }
     else if (m_showFlagimage)
     {
-        for (auto idx = 0u; idx < numPoints; ++idx, ++currentInterPoint)
-        {
-            if (currentInterPoint->flags)
-            {
-                * (currentImagerBuffer++) = 0u;
-                * (currentImagerBuffer++) = 0u;
-                * (currentImagerBuffer++) = 0u;
-                * (currentImagerBuffer++) = 255u;
-            }
-            else
-            {
-                * (currentImagerBuffer++) = 255u;
-                * (currentImagerBuffer++) = 255u;
-                * (currentImagerBuffer++) = 255u;
-                * (currentImagerBuffer++) = 255u;
-            }
-        }
+        mode = Colorizer::Mode::FLAGS;
+    }
+    else
+    {
+        update();
+        return;
     }
 
     if (m_image.width() != m_currentDataset->width ||
@@ -191,15 +90,12 @@ void TwoDView::fillImage()
         m_image = QImage (m_currentDataset->width, m_currentDataset->height, QImage::Format_ARGB32);
     }
 
-    for (int y = 0; y < m_image.height(); y++)
-    {
-        memcpy (m_image.scanLine (y), &m_imageBuffer[y * m_image.bytesPerLine()], m_image.bytesPerLine());
-    }
-
-    if (m_isHorizontallyFlipped || m_isVerticallyFlipped)
-    {
-        m_image = m_image.mirrored (m_isHorizontallyFlipped, m_isVerticallyFlipped);
-    }
+    // The pixels and the mirroring are written directly in to the image
+    m_colorizer.setColors (*m_colorHelper);
+    m_colorizer.setFilter (m_filterMin, m_filterMax);
+    m_colorizer.setMirrored (m_isHorizontallyFlipped, m_isVerticallyFlipped);
+    m_colorizer.colorize (mode, *m_currentDataset, *m_currentInterDataset,
+                          m_image.bits(), static_cast<std::size_t> (m_image.bytesPerLine()));
 
     update();
 }
@@ -127,6 +127,22 @@ const RgbColor &ColorHelper::getColor (const float dist)
     return m_colorLookup[index];
 }
 
+ColorHelper::Lookup ColorHelper::getLookup() const
+{
+    Lookup lookup;
+    lookup.colors = m_colorLookup;
+    lookup.colorCount = M_COLOR_LOOKUP_SIZE;
+    lookup.minDist = m_minDist;
+    lookup.maxDist = m_maxDist;
+    lookup.oneThroughSpanDist = m_oneThroughSpanDist;
+    lookup.grays = m_grayLookup;
+    lookup.grayCount = M_GRAY_LOOKUP_SIZE;
+    lookup.minVal = m_minVal;
+    lookup.maxVal = m_maxVal;
+    lookup.spanVal = m_spanVal;
+    return lookup;
+}
+
 void ColorHelper::setMinDist (float dist)
 {
     if (dist < 0)
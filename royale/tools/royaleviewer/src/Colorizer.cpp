@@ -0,0 +1,245 @@
+/****************************************************************************\
+ * Copyright (C) 2019 pmdtechnologies ag
+ *
+ * THIS CODE AND INFORMATION ARE PROVIDED "AS IS" WITHOUT WARRANTY OF ANY
+ * KIND, EITHER EXPRESSED OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND/OR FITNESS FOR A
+ * PARTICULAR PURPOSE.
+ *
+ \****************************************************************************/
+
+#include "Colorizer.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+
+using namespace royale;
+
+namespace
+{
+    const uint32_t OPAQUE = 0xff000000u;
+    const uint32_t BLACK = OPAQUE;
+    const uint32_t WHITE = 0xffffffffu;
+
+    /**
+     * The gray of the pixels with the SBI flag in the DISTANCE mode
+     */
+    const uint32_t SBI_GRAY = OPAQUE | 0x787878u;
+
+    uint32_t toArgb (const RgbColor &color)
+    {
+        return OPAQUE | (static_cast<uint32_t> (color.r) << 16) | (static_cast<uint32_t> (color.g) << 8) | color.b;
+    }
+
+    uint8_t channel (uint32_t argb, unsigned shift)
+    {
+        return static_cast<uint8_t> (argb >> shift);
+    }
+}
+
+Colorizer::Colorizer() :
+    m_blackDistance (0u),
+    m_sbiDistance (0u),
+    m_minDist (0.f),
+    m_maxDist (0.f),
+    m_oneThroughSpanDist (0.f),
+    m_maxDistIndex (0.f),
+    m_minVal (0u),
+    m_maxVal (0u),
+    m_filterMin (0.f),
+    m_filterMax (0.f),
+    m_mirrorHorizontally (false),
+    m_mirrorVertically (false)
+{
+}
+
+void Colorizer::setColors (const ColorHelper &colorHelper)
+{
+    const auto lookup = colorHelper.getLookup();
+
+    // This is only a few hundred entries, it's simpler to always rebuild it
+    m_distanceTable.resize (lookup.colorCount + 2u);
+    std::transform (lookup.colors, lookup.colors + lookup.colorCount, m_distanceTable.begin(), toArgb);
+    m_blackDistance = lookup.colorCount;
+    m_sbiDistance = lookup.colorCount + 1u;
+    m_distanceTable[m_blackDistance] = BLACK;
+    m_distanceTable[m_sbiDistance] = SBI_GRAY;
+    m_minDist = lookup.minDist;
+    m_maxDist = lookup.maxDist;
+    m_oneThroughSpanDist = lookup.oneThroughSpanDist;
+    m_maxDistIndex = static_cast<float> (lookup.colorCount - 1);
+
+    // The gray table has an entry for each value in the range, which can be up to 64k entries
+    if (!m_grayTable.empty() && m_minVal == lookup.minVal && m_maxVal == lookup.maxVal &&
+            m_grays.size() == lookup.grayCount &&
+            std::memcmp (m_grays.data(), lookup.grays, lookup.grayCount * sizeof (RgbColor)) == 0)
+    {
+        return;
+    }
+    m_grays.assign (lookup.grays, lookup.grays + lookup.grayCount);
+    m_minVal = lookup.minVal;
+    m_maxVal = lookup.maxVal;
+
+    // Same calculation as ColorHelper::getGrayColor, for each value after clamping it
+    const std::size_t count = (m_maxVal >= m_minVal) ? m_maxVal - m_minVal + 1u : 1u;
+    const unsigned maxGrayIndex = lookup.grayCount - 1u;
+    m_grayTable.resize (count + 1u);
+    for (std::size_t i = 0; i < count; ++i)
+    {
+        const auto index = lookup.spanVal ? std::min (maxGrayIndex, static_cast<unsigned> (maxGrayIndex * i / lookup.spanVal)) : 0u;
+        m_grayTable[i] = toArgb (lookup.grays[index]);
+    }
+    m_grayTable[count] = BLACK;
+}
+
+void Colorizer::setFilter (float filterMin, float filterMax)
+{
+    m_filterMin = filterMin;
+    m_filterMax = filterMax;
+}
+
+void Colorizer::setMirrored (bool horizontally, bool vertically)
+{
+    m_mirrorHorizontally = horizontally;
+    m_mirrorVertically = vertically;
+}
+
+void Colorizer::colorize (Mode mode, const DepthData &depthData, const IntermediateData &intData,
+                          uint8_t *dest, std::size_t bytesPerLine)
+{
+    const std::size_t width = depthData.width;
+    const std::size_t height = depthData.height;
+    m_lineIndex.resize (width);
+
+    for (std::size_t y = 0; y < height; ++y)
+    {
+        const auto destY = m_mirrorVertically ? height - 1u - y : y;
+        auto destLine = reinterpret_cast<uint32_t *> (dest + destY * bytesPerLine);
+        std::ptrdiff_t step = 1;
+        if (m_mirrorHorizontally)
+        {
+            destLine += width - 1u;
+            step = -1;
+        }
+
+        const IntermediatePoint *intPoints = nullptr;
+        if (mode == Mode::DISTANCE || mode == Mode::FLAGS)
+        {
+            intPoints = &intData.points[y * width];
+        }
+        colorizeLine (mode, &depthData.points[y * width], intPoints, width, destLine, step);
+    }
+}
+
+void Colorizer::colorizeLine (Mode mode, const DepthPoint *points, const IntermediatePoint *intPoints,
+                              std::size_t width, uint32_t *dest, std::ptrdiff_t step)
+{
+    // Local copies, so that the compiler doesn't reload them after each store to dest
+    const float filterMin = m_filterMin;
+    const float filterMax = m_filterMax;
+    const float minDist = m_minDist;
+    const float maxDist = m_maxDist;
+    const float oneThroughSpanDist = m_oneThroughSpanDist;
+    const float maxDistIndex = m_maxDistIndex;
+    const auto lastColor = static_cast<uint32_t> (m_blackDistance - 1u);
+    const auto blackDistance = static_cast<uint32_t> (m_blackDistance);
+    const auto sbiDistance = static_cast<uint32_t> (m_sbiDistance);
+    const uint32_t minVal = m_minVal;
+    const uint32_t maxVal = m_maxVal;
+    const auto blackGray = static_cast<uint32_t> (m_grayTable.size() - 1u);
+    const uint32_t *distanceTable = m_distanceTable.data();
+    const uint32_t *grayTable = m_grayTable.data();
+    uint32_t *index = m_lineIndex.data();
+
+    // Same calculations as ColorHelper::getColor and getGrayColor
+    const auto distanceIndex = [ = ] (float z)
+    {
+        float clampedDist = std::min (maxDist, z);
+        clampedDist = std::max (minDist, clampedDist);
+        const auto i = static_cast<uint32_t> (static_cast<int32_t> (maxDistIndex * (clampedDist - minDist) * oneThroughSpanDist));
+        return std::min (lastColor, i);
+    };
+    const auto grayIndex = [ = ] (uint16_t value)
+    {
+        uint32_t clampedVal = std::min<uint32_t> (maxVal, value);
+        clampedVal = std::max (minVal, clampedVal);
+        return clampedVal - minVal;
+    };
+
+    // The lines are written in two passes, first the table indices with arithmetic only (which
+    // the compiler can vectorize), then the lookups that store the pixels.
+    switch (mode)
+    {
+        case Mode::DISTANCE:
+            for (std::size_t x = 0; x < width; ++x)
+            {
+                const float z = points[x].z;
+                const bool filtered = (z == 0.f) | (z < filterMin) | (z > filterMax);
+                const bool sbi = (intPoints[x].flags & FLAGS_SBI_ON) != 0;
+                const auto i = distanceIndex (z);
+                index[x] = sbi ? sbiDistance : (filtered ? blackDistance : i);
+            }
+            for (std::size_t x = 0; x < width; ++x)
+            {
+                dest[static_cast<std::ptrdiff_t> (x) * step] = distanceTable[index[x]];
+            }
+            break;
+
+        case Mode::GRAY:
+            for (std::size_t x = 0; x < width; ++x)
+            {
+                const float z = points[x].z;
+                const bool filtered = (z < filterMin) | (z > filterMax);
+                const auto i = grayIndex (points[x].grayValue);
+                index[x] = filtered ? blackGray : i;
+            }
+            for (std::size_t x = 0; x < width; ++x)
+            {
+                dest[static_cast<std::ptrdiff_t> (x) * step] = grayTable[index[x]];
+            }
+            break;
+
+        case Mode::IR:
+            for (std::size_t x = 0; x < width; ++x)
+            {
+                const float z = points[x].z;
+                const bool filtered = (z < filterMin) | (z > filterMax);
+                // The low byte of the gray value, as returned by the processing for IR
+                const auto value = static_cast<uint32_t> (static_cast<uint8_t> (points[x].grayValue));
+                dest[static_cast<std::ptrdiff_t> (x) * step] = filtered ? BLACK : (OPAQUE | value * 0x010101u);
+            }
+            break;
+
+        case Mode::OVERLAY:
+            for (std::size_t x = 0; x < width; ++x)
+            {
+                const float z = points[x].z;
+                if ( (z == 0.f) | (z < filterMin) | (z > filterMax))
+                {
+                    dest[static_cast<std::ptrdiff_t> (x) * step] = BLACK;
+                    continue;
+                }
+
+                const auto color = distanceTable[distanceIndex (z)];
+                const auto grayVal = static_cast<float> (channel (grayTable[grayIndex (points[x].grayValue)], 16));
+                const float scaleTmp = 8.0f * std::pow (z, 1.5f) * grayVal / 255.f;
+                // The order of the comparisons is the same as qBound, which matters for NaN
+                float scale = (1.f < scaleTmp) ? 1.f : scaleTmp;
+                scale = (0.f < scale) ? scale : 0.f;
+
+                dest[static_cast<std::ptrdiff_t> (x) * step] = OPAQUE |
+                        (static_cast<uint32_t> (static_cast<uint8_t> (scale * channel (color, 16))) << 16) |
+                        (static_cast<uint32_t> (static_cast<uint8_t> (scale * channel (color, 8))) << 8) |
+                        static_cast<uint32_t> (static_cast<uint8_t> (scale * channel (color, 0)));
+            }
+            break;
+
+        case Mode::FLAGS:
+            for (std::size_t x = 0; x < width; ++x)
+            {
+                dest[static_cast<std::ptrdiff_t> (x) * step] = intPoints[x].flags ? BLACK : WHITE;
+            }
+            break;
+    }
+}
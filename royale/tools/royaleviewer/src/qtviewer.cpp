@@ -9,6 +9,7 @@
  \****************************************************************************/
 
 #include "qtviewer.hpp"
+#include <algorithm>
 #include <iomanip>
 #include <memory>
 #include <regex>
@@ -88,6 +89,60 @@ namespace
     const QString qStrStartText = QString ("Start");
 
     const QString qStrSaveFolder = QString ("SaveFolder");
+
+    /**
+     * Copies the depth data, multiplying the coordinates by the factors for mirroring the point
+     * cloud.  The buffers of dest are reused if they already have the right size.
+     */
+    void copyDepthData (const DepthData &src, DepthData &dest, float factorX, float factorY)
+    {
+        dest.version = src.version;
+        dest.timeStamp = src.timeStamp;
+        dest.streamId = src.streamId;
+        dest.width = src.width;
+        dest.height = src.height;
+        dest.exposureTimes.resize (src.exposureTimes.size());
+        std::copy (src.exposureTimes.begin(), src.exposureTimes.end(), dest.exposureTimes.begin());
+
+        const auto count = src.points.size();
+        dest.points.resize (count);
+        const DepthPoint *in = src.points.data();
+        DepthPoint *out = dest.points.data();
+        for (size_t i = 0; i < count; ++i)
+        {
+            out[i] = in[i];
+            out[i].x *= factorX;
+            out[i].y *= factorY;
+        }
+    }
+
+    /**
+     * Swaps the contents, which only swaps the pointers of the buffers.  The assignment
+     * operators of DepthData and IntermediateData always copy.
+     */
+    void swapData (DepthData &a, DepthData &b)
+    {
+        std::swap (a.version, b.version);
+        std::swap (a.timeStamp, b.timeStamp);
+        std::swap (a.streamId, b.streamId);
+        std::swap (a.width, b.width);
+        std::swap (a.height, b.height);
+        a.exposureTimes.swap (std::move (b.exposureTimes));
+        a.points.swap (std::move (b.points));
+    }
+
+    void swapData (IntermediateData &a, IntermediateData &b)
+    {
+        std::swap (a.version, b.version);
+        std::swap (a.timeStamp, b.timeStamp);
+        std::swap (a.streamId, b.streamId);
+        std::swap (a.width, b.width);
+        std::swap (a.height, b.height);
+        a.points.swap (std::move (b.points));
+        a.modulationFrequencies.swap (std::move (b.modulationFrequencies));
+        a.exposureTimes.swap (std::move (b.exposureTimes));
+        std::swap (a.numFrequencies, b.numFrequencies);
+    }
 }
 
 #ifdef TARGET_PLATFORM_ANDROID
@@ -1327,15 +1382,24 @@ void QTViewer::onNewData (const royale::IExtendedData *data)
     if (data->hasDepthData() &&
             data->hasIntermediateData())
     {
+        auto curDepthData = data->getDepthData();
+        auto curIntermediateData = data->getIntermediateData();
+
+        // The frame is copied to the back buffers without holding the lock, so the views are only
+        // blocked while the buffers are swapped.  The back buffers are only used in this thread.
+        const float factorX = m_flipHorizontal ? -1.0f : 1.0f;
+        const float factorY = m_flipVertical ? -1.0f : 1.0f;
+        auto &nextData = m_nextData[curDepthData->streamId];
+        auto &nextIntermediateData = m_nextIntermediateData[curDepthData->streamId];
+        copyDepthData (*curDepthData, nextData, factorX, factorY);
+        nextIntermediateData = *curIntermediateData;
+
         MutexTryLocker tlocker (*m_dataMutex);
         if (!tlocker.isLocked())
         {
             return;
         }
 
-        auto curDepthData = data->getDepthData();
-        auto curIntermediateData = data->getIntermediateData();
-
         unsigned curViewIdx = 0;
         if (m_streamIdMap.find (curDepthData->streamId) == m_streamIdMap.end())
         {
@@ -1358,36 +1422,14 @@ void QTViewer::onNewData (const royale::IExtendedData *data)
             }
         }
 
-        m_currentData[curDepthData->streamId] = *curDepthData;
-        m_currentIntermediateData[curDepthData->streamId] = *curIntermediateData;
+        swapData (m_currentData[curDepthData->streamId], nextData);
+        swapData (m_currentIntermediateData[curDepthData->streamId], nextIntermediateData);
 
         if (m_firstData[curDepthData->streamId])
         {
             findMinMax (&m_currentData[curDepthData->streamId], curDepthData->streamId);
         }
 
-        if (m_flipHorizontal ||
-                m_flipVertical)
-        {
-            float factorX = 1.0f;
-            float factorY = 1.0f;
-
-            if (m_flipHorizontal)
-            {
-                factorX = -1.0f;
-            }
-            if (m_flipVertical)
-            {
-                factorY = -1.0f;
-            }
-
-            for (auto &curPoint : m_currentData[curDepthData->streamId].points)
-            {
-                curPoint.x *= factorX;
-                curPoint.y *= factorY;
-            }
-        }
-
         m_hasData[curDepthData->streamId] = true;
         m_frameCounter[curDepthData->streamId]++;
 
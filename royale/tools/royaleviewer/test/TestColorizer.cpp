@@ -0,0 +1,327 @@
+/****************************************************************************\
+ * Copyright (C) 2019 pmdtechnologies ag
+ *
+ * THIS CODE AND INFORMATION ARE PROVIDED "AS IS" WITHOUT WARRANTY OF ANY
+ * KIND, EITHER EXPRESSED OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND/OR FITNESS FOR A
+ * PARTICULAR PURPOSE.
+ *
+ \****************************************************************************/
+
+#include <Colorizer.hpp>
+#include <gtest/gtest.h>
+
+#include <chrono>
+#include <cmath>
+#include <cstring>
+#include <iostream>
+#include <limits>
+#include <random>
+#include <vector>
+
+using namespace royale;
+
+namespace
+{
+    const Colorizer::Mode ALL_MODES[] =
+    {
+        Colorizer::Mode::DISTANCE,
+        Colorizer::Mode::GRAY,
+        Colorizer::Mode::IR,
+        Colorizer::Mode::OVERLAY,
+        Colorizer::Mode::FLAGS
+    };
+
+    void setPixel (uint8_t *pixel, uint8_t r, uint8_t g, uint8_t b)
+    {
+        // QImage::Format_ARGB32 on a little-endian machine
+        pixel[0] = b;
+        pixel[1] = g;
+        pixel[2] = r;
+        pixel[3] = 255u;
+    }
+
+    /**
+     * The calculation that TwoDView used before the Colorizer, one pixel at a time with the
+     * ColorHelper, followed by mirroring the image.
+     */
+    std::vector<uint8_t> referenceImage (Colorizer::Mode mode, const DepthData &depthData, const IntermediateData &intData,
+                                         ColorHelper &colorHelper, float filterMin, float filterMax,
+                                         bool mirrorHorizontally, bool mirrorVertically)
+    {
+        const size_t width = depthData.width;
+        const size_t height = depthData.height;
+        std::vector<uint8_t> image (width * height * 4u);
+        for (size_t i = 0; i < width * height; ++i)
+        {
+            const auto &point = depthData.points[i];
+            const auto &intPoint = intData.points[i];
+            auto pixel = &image[i * 4u];
+            const bool filtered = point.z < filterMin || point.z > filterMax;
+            switch (mode)
+            {
+                case Colorizer::Mode::DISTANCE:
+                    if (intPoint.flags & FLAGS_SBI_ON)
+                    {
+                        setPixel (pixel, 120u, 120u, 120u);
+                    }
+                    else if (point.z == 0.f || filtered)
+                    {
+                        setPixel (pixel, 0u, 0u, 0u);
+                    }
+                    else
+                    {
+                        const auto &color = colorHelper.getColor (point.z);
+                        setPixel (pixel, color.r, color.g, color.b);
+                    }
+                    break;
+                case Colorizer::Mode::GRAY:
+                    if (filtered)
+                    {
+                        setPixel (pixel, 0u, 0u, 0u);
+                    }
+                    else
+                    {
+                        const auto &color = colorHelper.getGrayColor (point.grayValue);
+                        setPixel (pixel, color.r, color.g, color.b);
+                    }
+                    break;
+                case Colorizer::Mode::IR:
+                    {
+                        const auto value = filtered ? 0u : static_cast<uint8_t> (point.grayValue);
+                        setPixel (pixel, value, value, value);
+                    }
+                    break;
+                case Colorizer::Mode::OVERLAY:
+                    if (point.z == 0.f || filtered)
+                    {
+                        setPixel (pixel, 0u, 0u, 0u);
+                    }
+                    else
+                    {
+                        const auto &color = colorHelper.getColor (point.z);
+                        float grayVal = (float) colorHelper.getGrayColor (point.grayValue).r;
+                        float scaleTmp = 8.0f * std::pow (point.z, 1.5f) * grayVal / 255.f;
+                        // qBound (0.f, scaleTmp, 1.f)
+                        float scale = (1.f < scaleTmp) ? 1.f : scaleTmp;
+                        scale = (0.f < scale) ? scale : 0.f;
+                        setPixel (pixel, static_cast<uint8_t> (scale * color.r), static_cast<uint8_t> (scale * color.g),
+                                  static_cast<uint8_t> (scale * color.b));
+                    }
+                    break;
+                case Colorizer::Mode::FLAGS:
+                    {
+                        const uint8_t value = intPoint.flags ? 0u : 255u;
+                        setPixel (pixel, value, value, value);
+                    }
+                    break;
+            }
+        }
+
+        // QImage::mirrored
+        std::vector<uint8_t> mirrored (image.size());
+        for (size_t y = 0; y < height; ++y)
+        {
+            for (size_t x = 0; x < width; ++x)
+            {
+                const auto destX = mirrorHorizontally ? width - 1u - x : x;
+                const auto destY = mirrorVertically ? height - 1u - y : y;
+                std::memcpy (&mirrored[ (destY * width + destX) * 4u], &image[ (y * width + x) * 4u], 4u);
+            }
+        }
+        return mirrored;
+    }
+
+    /**
+     * Random data, including the special cases of the colorization: zero and NaN distances,
+     * distances outside of the ranges, and the SBI flag.
+     */
+    void createData (uint16_t width, uint16_t height, DepthData &depthData, IntermediateData &intData)
+    {
+        std::mt19937 random (1u);
+        std::uniform_real_distribution<float> distance (-0.5f, 8.0f);
+        std::uniform_int_distribution<uint32_t> gray (0u, 2000u);
+        std::uniform_int_distribution<uint32_t> special (0u, 19u);
+
+        depthData.width = width;
+        depthData.height = height;
+        depthData.points.resize (static_cast<size_t> (width * height));
+        intData.width = width;
+        intData.height = height;
+        intData.points.resize (static_cast<size_t> (width * height));
+        for (size_t i = 0; i < depthData.points.size(); ++i)
+        {
+            auto &point = depthData.points[i];
+            auto &intPoint = intData.points[i];
+            point.x = 0.f;
+            point.y = 0.f;
+            point.z = distance (random);
+            point.noise = 0.f;
+            point.grayValue = static_cast<uint16_t> (gray (random));
+            point.depthConfidence = 255u;
+            intPoint.distance = point.z;
+            intPoint.amplitude = 0.f;
+            intPoint.intensity = 0.f;
+            intPoint.flags = 0u;
+
+            switch (special (random))
+            {
+                case 0:
+                    point.z = 0.f;
+                    break;
+                case 1:
+                    point.z = std::numeric_limits<float>::quiet_NaN();
+                    break;
+                case 2:
+                    intPoint.flags = FLAGS_SBI_ON;
+                    break;
+                case 3:
+                    intPoint.flags = 0x1u;
+                    break;
+                case 4:
+                    point.grayValue = std::numeric_limits<uint16_t>::max();
+                    break;
+                default:
+                    break;
+            }
+        }
+    }
+
+    void expectSameImage (Colorizer &colorizer, ColorHelper &colorHelper, const DepthData &depthData, const IntermediateData &intData,
+                          float filterMin, float filterMax)
+    {
+        const size_t bytesPerLine = depthData.width * 4u;
+        std::vector<uint8_t> image (bytesPerLine * depthData.height);
+        colorizer.setColors (colorHelper);
+        colorizer.setFilter (filterMin, filterMax);
+        for (const auto mode : ALL_MODES)
+        {
+            for (auto mirror = 0; mirror < 4; ++mirror)
+            {
+                const bool mirrorHorizontally = (mirror & 1) != 0;
+                const bool mirrorVertically = (mirror & 2) != 0;
+                colorizer.setMirrored (mirrorHorizontally, mirrorVertically);
+                std::fill (image.begin(), image.end(), uint8_t (0x55u));
+                colorizer.colorize (mode, depthData, intData, image.data(), bytesPerLine);
+
+                const auto reference = referenceImage (mode, depthData, intData, colorHelper, filterMin, filterMax,
+                                                       mirrorHorizontally, mirrorVertically);
+                EXPECT_TRUE (reference == image) << "mode " << static_cast<int> (mode) << ", mirror " << mirror;
+            }
+        }
+    }
+}
+
+TEST (TestColorizer, SameAsColorHelper)
+{
+    DepthData depthData;
+    IntermediateData intData;
+    createData (37u, 11u, depthData, intData);
+
+    ColorHelper colorHelper;
+    Colorizer colorizer;
+    expectSameImage (colorizer, colorHelper, depthData, intData, 0.0f, 7.5f);
+    expectSameImage (colorizer, colorHelper, depthData, intData, 0.5f, 2.0f);
+}
+
+/**
+ * The gray table is only rebuilt when the ColorHelper's range or gamma changes, check that it
+ * does change.
+ */
+TEST (TestColorizer, ChangedColors)
+{
+    DepthData depthData;
+    IntermediateData intData;
+    createData (37u, 11u, depthData, intData);
+
+    ColorHelper colorHelper;
+    Colorizer colorizer;
+    expectSameImage (colorizer, colorHelper, depthData, intData, 0.0f, 7.5f);
+
+    colorHelper.setMinDist (0.3f);
+    colorHelper.setMaxDist (4.0f);
+    colorHelper.setMinVal (50u);
+    colorHelper.setMaxVal (1500u);
+    expectSameImage (colorizer, colorHelper, depthData, intData, 0.0f, 7.5f);
+
+    colorHelper.enableGammaCorrection (true);
+    colorHelper.setGammaValue (0.5f);
+    expectSameImage (colorizer, colorHelper, depthData, intData, 0.0f, 7.5f);
+
+    // The full range of gray values
+    colorHelper.setMinVal (0u);
+    colorHelper.setMaxVal (std::numeric_limits<uint16_t>::max());
+    expectSameImage (colorizer, colorHelper, depthData, intData, 0.0f, 7.5f);
+}
+
+/**
+ * The image may have padding at the end of each line, which is left as it is.
+ */
+TEST (TestColorizer, BytesPerLine)
+{
+    DepthData depthData;
+    IntermediateData intData;
+    createData (5u, 3u, depthData, intData);
+
+    ColorHelper colorHelper;
+    Colorizer colorizer;
+    colorizer.setColors (colorHelper);
+    colorizer.setFilter (0.0f, 7.5f);
+    colorizer.setMirrored (true, true);
+
+    const size_t bytesPerLine = 5u * 4u + 8u;
+    std::vector<uint8_t> image (bytesPerLine * 3u, 0x55u);
+    colorizer.colorize (Colorizer::Mode::DISTANCE, depthData, intData, image.data(), bytesPerLine);
+
+    const auto reference = referenceImage (Colorizer::Mode::DISTANCE, depthData, intData, colorHelper, 0.0f, 7.5f, true, true);
+    for (size_t y = 0; y < 3u; ++y)
+    {
+        EXPECT_EQ (0, std::memcmp (&image[y * bytesPerLine], &reference[y * 5u * 4u], 5u * 4u));
+        for (size_t i = 5u * 4u; i < bytesPerLine; ++i)
+        {
+            EXPECT_EQ (0x55u, image[y * bytesPerLine + i]);
+        }
+    }
+}
+
+/**
+ * Compares the time of the Colorizer with the calculation that TwoDView used before, for a VGA
+ * image that is mirrored in both directions.
+ */
+TEST (TestColorizer, DISABLED_Benchmark)
+{
+    const int repetitions = 50;
+
+    DepthData depthData;
+    IntermediateData intData;
+    createData (640u, 480u, depthData, intData);
+
+    ColorHelper colorHelper;
+    Colorizer colorizer;
+    colorizer.setColors (colorHelper);
+    colorizer.setFilter (0.0f, 7.5f);
+    colorizer.setMirrored (true, true);
+    std::vector<uint8_t> image (640u * 480u * 4u);
+
+    using Clock = std::chrono::steady_clock;
+    for (const auto mode : ALL_MODES)
+    {
+        auto start = Clock::now();
+        for (auto i = 0; i < repetitions; ++i)
+        {
+            const auto reference = referenceImage (mode, depthData, intData, colorHelper, 0.0f, 7.5f, true, true);
+            image[i % image.size()] = reference[i % reference.size()];
+        }
+        const auto referenceTime = std::chrono::duration_cast<std::chrono::microseconds> (Clock::now() - start);
+
+        start = Clock::now();
+        for (auto i = 0; i < repetitions; ++i)
+        {
+            colorizer.colorize (mode, depthData, intData, image.data(), 640u * 4u);
+        }
+        const auto colorizerTime = std::chrono::duration_cast<std::chrono::microseconds> (Clock::now() - start);
+
+        std::cout << "mode " << static_cast<int> (mode) << ": per-pixel " << referenceTime.count() / repetitions
+                  << " us, Colorizer " << colorizerTime.count() / repetitions << " us per frame" << std::endl;
+    }
+}
@@ -12,10 +12,16 @@
 #include <thread>
 #include <chrono>
 #include <mutex>
+#include <condition_variable>
+#include <cstdlib>
+#include <deque>
 #include <fstream>
+#include <limits>
+#include <memory>
 #include <regex>
 #include <sstream>
 #include <string>
+#include <vector>
 
 #ifdef ROYALE_TARGET_PLATFORM_WINDOWS
 #include <direct.h>
@@ -39,179 +45,278 @@ using namespace std;
 
 namespace
 {
-    class MyListener : public royale::IExtendedDataListener
+    /**
+     * Everything that is needed to write the outputs of one callback.  The data is copied out of
+     * the callback, because the buffers of IExtendedData are only valid until onNewData returns.
+     */
+    struct ExportFrame
     {
-    public:
-        MyListener (string rrfFile, string outpath, uint32_t numFrames,
-                    const std::map<royale::StreamId, bool> &irModes) :
-            m_numFrames (numFrames),
-            m_rrfFile (std::move (rrfFile)),
-            m_outpath (outpath),
-            m_currentFrame (0u),
-            m_irModes (irModes)
+        uint32_t frameNumber;
+        bool irMode;
+        royale::DepthData depthData;
+        royale::IntermediateData intermediateData;
+        royale::RawData rawData;
+
+        // Owns the raw frames that rawData.rawData points to
+        std::vector<std::vector<uint16_t>> rawFrames;
+    };
+
+    unique_ptr<const ExportFrame> copyFrame (uint32_t frameNumber, bool irMode, const royale::IExtendedData *data)
+    {
+        unique_ptr<ExportFrame> frame (new ExportFrame);
+        frame->frameNumber = frameNumber;
+        frame->irMode = irMode;
+        frame->depthData = *data->getDepthData();
+
+        if (irMode)
         {
+            frame->intermediateData = *data->getIntermediateData();
         }
-
-        void onNewData (const royale::IExtendedData *data) override
+        else if (data->hasRawData())
         {
-            m_currentFrame++;
-            cout << "Exporting frame " << m_currentFrame << " of " << m_numFrames << endl;
+            const auto rawData = data->getRawData();
+            frame->rawData = *rawData;
 
-            auto streamId = data->getDepthData()->streamId;
-            std::string streamNumber = "_" + std::to_string (streamId);
+            const size_t frameSize = rawData->width * rawData->height;
+            frame->rawFrames.resize (rawData->rawData.size());
+            for (size_t i = 0; i < rawData->rawData.size(); ++i)
+            {
+                frame->rawFrames[i].assign (rawData->rawData[i], rawData->rawData[i] + frameSize);
+                frame->rawData.rawData[i] = frame->rawFrames[i].data();
+            }
+        }
 
-            std::string fileNamePart = m_outpath + "/" + std::to_string (m_currentFrame) + streamNumber;
+        return unique_ptr<const ExportFrame> (std::move (frame));
+    }
 
-            if (m_irModes[streamId])
-            {
-                cout << "Exporting IR frame" << endl;
+    void writePNG (const std::string &path, QImage &img)
+    {
+        img.save (QString::fromStdString (path), 0);
+    }
 
-                //PNG
-                //IR1
-                {
-                    const std::string csvPath = fileNamePart + "_IR_IlluOn-FPN.png";
-                    QImage img ( (int) data->getDepthData()->width, (int) data->getDepthData()->height, QImage::Format_Grayscale8);
-                    royale::importExportHelperLib::encodeIR1PNG (data->getDepthData(), img);
-                    QString qFilePath = QString::fromStdString (csvPath);
-                    img.save (qFilePath, 0);
-                }
+    template<typename Encoder>
+    void writeFile (const std::string &path, ios_base::openmode mode, Encoder encode)
+    {
+        std::ofstream fileOutput{};
+        fileOutput.open (path, mode);
 
-                //IR2
-                {
-                    const std::string csvPath = fileNamePart + "_IR_IlluOn-IlluOff.png";
-                    QImage img ( (int) data->getIntermediateData()->width, (int) data->getIntermediateData()->height, QImage::Format_Grayscale8);
-                    royale::importExportHelperLib::encodeIR2PNG (data->getIntermediateData(), img);
-                    QString qFilePath = QString::fromStdString (csvPath);
-                    img.save (qFilePath, 0);
-                }
+        if (fileOutput.is_open())
+        {
+            encode (fileOutput);
+            fileOutput.close();
+        }
+    }
+
+    /**
+     * \param binaryPly write the PLY in the binary_little_endian format instead of ASCII
+     */
+    void exportFrame (const std::string &outpath, bool binaryPly, const ExportFrame &frame)
+    {
+        const auto depthData = &frame.depthData;
+        const std::string fileNamePart = outpath + "/" + std::to_string (frame.frameNumber) + "_" +
+                                         std::to_string (depthData->streamId);
+        const auto text = ofstream::out;
+        const auto binary = ofstream::out | ofstream::binary;
+
+        if (frame.irMode)
+        {
+            //PNG
+            //IR1
+            {
+                QImage img ( (int) depthData->width, (int) depthData->height, QImage::Format_Grayscale8);
+                royale::importExportHelperLib::encodeIR1PNG (depthData, img);
+                writePNG (fileNamePart + "_IR_IlluOn-FPN.png", img);
             }
-            else
+
+            //IR2
             {
-                //PNG
-                //ampl
-                {
-                    const std::string csvPath = fileNamePart + "_ampl.png";
-                    QImage img ( (int) data->getDepthData()->width, (int) data->getDepthData()->height, QImage::Format_Grayscale8);
-                    royale::importExportHelperLib::encodeAmplPNG (data->getDepthData(), img);
-                    QString qFilePath = QString::fromStdString (csvPath);
-                    img.save (qFilePath, 0);
-                }
+                const auto intermediateData = &frame.intermediateData;
+                QImage img ( (int) intermediateData->width, (int) intermediateData->height, QImage::Format_Grayscale8);
+                royale::importExportHelperLib::encodeIR2PNG (intermediateData, img);
+                writePNG (fileNamePart + "_IR_IlluOn-IlluOff.png", img);
+            }
+            return;
+        }
 
-                //CSV
-                //ampl
-                {
-                    const std::string csvPath = fileNamePart + "_ampl.csv";
-                    std::ofstream fileOutput{};
-                    fileOutput.open (csvPath);
+        //PNG
+        //ampl
+        {
+            QImage img ( (int) depthData->width, (int) depthData->height, QImage::Format_Grayscale8);
+            royale::importExportHelperLib::encodeAmplPNG (depthData, img);
+            writePNG (fileNamePart + "_ampl.png", img);
+        }
 
-                    if (fileOutput.is_open())
-                    {
-                        royale::importExportHelperLib::encodeAmplCSV (data->getDepthData(), fileOutput);
-                        fileOutput.close();
-                    }
-                }
+        //CSV
+        writeFile (fileNamePart + "_ampl.csv", text, [&] (std::ostream & os)
+        {
+            royale::importExportHelperLib::encodeAmplCSV (depthData, os);
+        });
+        writeFile (fileNamePart + "_depth.csv", text, [&] (std::ostream & os)
+        {
+            royale::importExportHelperLib::encodeDepthCSV (depthData, os);
+        });
+        writeFile (fileNamePart + "_raw.csv", text, [&] (std::ostream & os)
+        {
+            royale::importExportHelperLib::encodeRawCSV (&frame.rawData, os);
+        });
 
-                //depth
-                {
-                    const std::string csvPath = fileNamePart + "_depth.csv";
-                    std::ofstream fileOutput{};
-                    fileOutput.open (csvPath);
+        //PLY
+        //ampl + depth
+        if (binaryPly)
+        {
+            writeFile (fileNamePart + "_depth_ampl.ply", binary, [&] (std::ostream & os)
+            {
+                royale::importExportHelperLib::encodePLYBinary (depthData, os);
+            });
+        }
+        else
+        {
+            writeFile (fileNamePart + "_depth_ampl.ply", text, [&] (std::ostream & os)
+            {
+                royale::importExportHelperLib::encodePLY (depthData, os);
+            });
+        }
 
-                    if (fileOutput.is_open())
-                    {
-                        royale::importExportHelperLib::encodeDepthCSV (data->getDepthData(), fileOutput);
-                        fileOutput.close();
-                    }
+        //BIN
+        writeFile (fileNamePart + "_ampl.bin", binary, [&] (std::ostream & os)
+        {
+            royale::importExportHelperLib::encodeAmplBIN (depthData, os);
+        });
+        //depth (in Meter)
+        writeFile (fileNamePart + "_depthFloat.bin", binary, [&] (std::ostream & os)
+        {
+            royale::importExportHelperLib::encodeDepthBIN (depthData, os);
+        });
+        //depthMillimeter
+        writeFile (fileNamePart + "_depthMillimeter.bin", binary, [&] (std::ostream & os)
+        {
+            royale::importExportHelperLib::encodeDepthMMBIN (depthData, os);
+        });
+        //raw (16Bit per pixel)
+        writeFile (fileNamePart + "_raw.bin", binary, [&] (std::ostream & os)
+        {
+            royale::importExportHelperLib::encodeRawBIN (&frame.rawData, os);
+        });
+    }
 
+    /**
+     * Writes the frames with a number of worker threads.  The queue is bounded, if the workers
+     * can't keep up push() blocks the playback instead of buffering the whole recording.
+     */
+    class ExportPool
+    {
+    public:
+        ExportPool (string outpath, bool binaryPly, size_t numJobs) :
+            m_outpath (std::move (outpath)),
+            m_binaryPly (binaryPly),
+            m_maxQueued (2 * numJobs),
+            m_finished (false)
+        {
+            for (size_t i = 0; i < numJobs; ++i)
+            {
+                m_workers.emplace_back (&ExportPool::worker, this);
+            }
+        }
 
-                    //raw
-                    {
-                        const std::string csvPath = fileNamePart + "_raw.csv";
-                        std::ofstream fileOutput{};
-                        fileOutput.open (csvPath);
-
-                        if (fileOutput.is_open())
-                        {
-                            royale::importExportHelperLib::encodeRawCSV (data->getRawData(), fileOutput);
-                            fileOutput.close();
-                        }
-                    }
+        ~ExportPool()
+        {
+            finish();
+        }
 
+        void push (unique_ptr<const ExportFrame> frame)
+        {
+            unique_lock<mutex> lock (m_mutex);
+            m_spaceCondition.wait (lock, [this] { return m_queue.size() < m_maxQueued; });
+            m_queue.push_back (std::move (frame));
+            m_workCondition.notify_one();
+        }
 
-                    //PLY
-                    //ampl + depth
-                    {
-                        const std::string csvPath = fileNamePart + "_depth_ampl.ply";
-                        std::ofstream fileOutput{};
-                        fileOutput.open (csvPath);
-
-                        if (fileOutput.is_open())
-                        {
-                            royale::importExportHelperLib::encodePLY (data->getDepthData(), fileOutput);
-                            fileOutput.close();
-                        }
-                    }
+        /**
+         * Waits until all frames that have been pushed are written.
+         */
+        void finish()
+        {
+            {
+                lock_guard<mutex> lock (m_mutex);
+                m_finished = true;
+            }
+            m_workCondition.notify_all();
+            for (auto &worker : m_workers)
+            {
+                if (worker.joinable())
+                {
+                    worker.join();
+                }
+            }
+        }
 
-                    //BIN
-                    //ampl
+    private:
+        void worker()
+        {
+            while (true)
+            {
+                unique_ptr<const ExportFrame> frame;
+                {
+                    unique_lock<mutex> lock (m_mutex);
+                    m_workCondition.wait (lock, [this] { return m_finished || !m_queue.empty(); });
+                    if (m_queue.empty())
                     {
-                        const std::string csvPath = fileNamePart + "_ampl.bin";
-                        std::ofstream fileOutput{};
-                        fileOutput.open (csvPath, ofstream::out | ofstream::binary);
-
-                        if (fileOutput.is_open())
-                        {
-                            royale::importExportHelperLib::encodeAmplBIN (data->getDepthData(), fileOutput);
-                            fileOutput.close();
-                        }
+                        return;
                     }
+                    frame = std::move (m_queue.front());
+                    m_queue.pop_front();
+                }
+                m_spaceCondition.notify_one();
 
-                    //depth (in Meter)
-                    {
-                        const std::string csvPath = fileNamePart + "_depthFloat.bin";
-                        std::ofstream fileOutput{};
-                        fileOutput.open (csvPath, ofstream::out | ofstream::binary);
-
-                        if (fileOutput.is_open())
-                        {
-                            royale::importExportHelperLib::encodeDepthBIN (data->getDepthData(), fileOutput);
-                            fileOutput.close();
-                        }
-                    }
+                exportFrame (m_outpath, m_binaryPly, *frame);
+            }
+        }
 
-                    //depthMillimeter
-                    {
-                        const std::string csvPath = fileNamePart + "_depthMillimeter.bin";
-                        std::ofstream fileOutput{};
-                        fileOutput.open (csvPath, ofstream::out | ofstream::binary);
-
-                        if (fileOutput.is_open())
-                        {
-                            royale::importExportHelperLib::encodeDepthMMBIN (data->getDepthData(), fileOutput);
-                            fileOutput.close();
-                        }
-                    }
+        const string m_outpath;
+        const bool m_binaryPly;
+        const size_t m_maxQueued;
+        bool m_finished;
+        deque<unique_ptr<const ExportFrame>> m_queue;
+        mutex m_mutex;
+        condition_variable m_workCondition;
+        condition_variable m_spaceCondition;
+        vector<thread> m_workers;
+    };
 
-                    //raw (16Bit per pixel)
-                    {
-                        const std::string csvPath = fileNamePart + "_raw.bin";
-                        std::ofstream fileOutput{};
-                        fileOutput.open (csvPath, ofstream::out | ofstream::binary);
-
-                        if (fileOutput.is_open())
-                        {
-                            royale::importExportHelperLib::encodeRawBIN (data->getRawData(), fileOutput);
-                            fileOutput.close();
-                        }
-                    }
-                }
+    class MyListener : public royale::IExtendedDataListener
+    {
+    public:
+        /**
+         * \param firstFrame number of the first frame that is played back, the files are named
+         *        after the frame numbers (counting from 1), so that exporting a range writes the
+         *        same files as exporting the whole recording
+         */
+        MyListener (ExportPool &pool, uint32_t firstFrame, uint32_t lastFrame,
+                    const std::map<royale::StreamId, bool> &irModes) :
+            m_pool (pool),
+            m_lastFrame (lastFrame),
+            m_currentFrame (firstFrame - 1),
+            m_irModes (irModes)
+        {
+        }
+
+        void onNewData (const royale::IExtendedData *data) override
+        {
+            m_currentFrame++;
+            cout << "Exporting frame " << m_currentFrame << " of " << m_lastFrame << endl;
+
+            const auto irMode = m_irModes[data->getDepthData()->streamId];
+            if (irMode)
+            {
+                cout << "Exporting IR frame" << endl;
             }
+
+            m_pool.push (copyFrame (m_currentFrame, irMode, data));
         }
 
     private:
-        uint32_t m_numFrames;   // Total number of frames in the recording
-        string m_rrfFile;       // Recording file that was opened
-        string m_outpath;
+        ExportPool &m_pool;
+        uint32_t m_lastFrame;   // Last frame that is exported
         uint32_t m_currentFrame;
         std::map<royale::StreamId, bool> m_irModes;
     };
@@ -281,8 +386,67 @@ string getFileName (const string &s)
     return retVal;
 }
 
+/**
+ * Parses a decimal number without sign or whitespace, returns false if the value isn't one or
+ * is outside of [1, max].
+ */
+bool parsePositiveNumber (const char *value, unsigned long max, uint32_t &result)
+{
+    if (*value < '0' || *value > '9')
+    {
+        return false;
+    }
+    char *end = nullptr;
+    const auto parsed = strtoul (value, &end, 10);
+    if (*end != '\0' || parsed == 0u || parsed > max)
+    {
+        return false;
+    }
+    result = static_cast<uint32_t> (parsed);
+    return true;
+}
+
+/**
+ * Parses the value of --first or --last, returns false if it isn't a positive frame number.
+ */
+bool parseFrameOption (const char *value, uint32_t &result)
+{
+    return parsePositiveNumber (value, numeric_limits<uint32_t>::max(), result);
+}
+
+/**
+ * Most threads that --jobs accepts, the export is limited by the disk long before this.
+ */
+const unsigned long MAX_JOBS = 256u;
+
+/**
+ * Parses the value of --jobs, returns false if it isn't a number of threads from 1 to MAX_JOBS.
+ */
+bool parseJobsOption (const char *value, uint32_t &result)
+{
+    return parsePositiveNumber (value, MAX_JOBS, result);
+}
+
+void printUsage (const char *name)
+{
+    cout << "Usage " << name << " [options] rrfFileToExport [cfgFile]" << endl;
+    cout << endl;
+    cout << "Each frame of the recording is saved as a separate file " << endl;
+    cout << "in the current directory." << endl;
+    cout << endl;
+    cout << "Options:" << endl;
+    cout << "  --jobs N   number of threads that write the files, 1 to " << MAX_JOBS << " (default: number of cores)" << endl;
+    cout << "  --first N  first frame to export, counting from 1 like the file names" << endl;
+    cout << "  --last N   last frame to export, the frames outside of the range aren't read" << endl;
+    cout << "  --ply-binary  write the PLY files in binary instead of ASCII, which is faster" << endl;
+}
+
 int main (int argc, char *argv[])
 {
+    // The listener hands the frames to this pool, so it's declared before the listener and the
+    // cameraDevice and is destroyed after both of them.
+    unique_ptr<ExportPool> pool;
+
     // This is the data listener which will receive callbacks.  It's declared
     // before the cameraDevice so that, if this function exits with a 'return'
     // statement while the camera is still capturing, it will still be in scope
@@ -295,15 +459,65 @@ int main (int argc, char *argv[])
     // Royale's API treats the .rrf file as a camera, which it captures data from.
     unique_ptr<royale::ICameraDevice> cameraDevice;
 
+    uint32_t numJobs = max (thread::hardware_concurrency(), 1u);
+    uint32_t firstFrame = 0u;
+    uint32_t lastFrame = 0u;
+    bool binaryPly = false;
+    vector<const char *> positional;
+
+    for (int i = 1; i < argc; ++i)
+    {
+        const string arg (argv[i]);
+        uint32_t *option = nullptr;
+        if (arg == "--jobs")
+        {
+            if (i + 1 >= argc || !parseJobsOption (argv[i + 1], numJobs))
+            {
+                cerr << arg << " needs a number of threads from 1 to " << MAX_JOBS << endl;
+                return 1;
+            }
+            ++i;
+            continue;
+        }
+        else if (arg == "--first")
+        {
+            option = &firstFrame;
+        }
+        else if (arg == "--last")
+        {
+            option = &lastFrame;
+        }
+        else if (arg == "--ply-binary")
+        {
+            binaryPly = true;
+            continue;
+        }
+        else if (arg == "-h" || arg == "--help")
+        {
+            printUsage (argv[0]);
+            return 0;
+        }
+        else
+        {
+            positional.push_back (argv[i]);
+            continue;
+        }
+
+        if (i + 1 >= argc || !parseFrameOption (argv[i + 1], *option))
+        {
+            cerr << arg << " needs a positive number" << endl;
+            return 1;
+        }
+        ++i;
+    }
+
     // check the command line for a given file
-    if (argc < 2)
+    if (positional.empty() || positional.size() > 2)
     {
-        cout << "Usage " << argv[0] << " rrfFileToExport cfgFile" << endl;
-        cout << endl;
-        cout << "Each frame of the recording is saved as a separate file " << endl;
-        cout << "in the current directory." << endl;
+        printUsage (argv[0]);
         return 1;
     }
+    const char *rrfFile = positional[0];
 
     // Use the camera manager to open the recorded file, this block scope is because we can allow
     // the CameraManager to go out of scope once the file has been opened.
@@ -320,16 +534,14 @@ int main (int argc, char *argv[])
         royale::CameraManager manager (ROYALE_ACCESS_CODE_LEVEL3);  //Running.G edit
 
         // create a device from the file
-        cameraDevice = manager.createCamera (argv[1]);
+        cameraDevice = manager.createCamera (rrfFile);
     }
 
 
-
-
     // if the file was loaded correctly the cameraDevice is now available
     if (cameraDevice == nullptr)
     {
-        cerr << "Cannot load the file " << argv[1] << endl;
+        cerr << "Cannot load the file " << rrfFile << endl;
         return 1;
     }
 
@@ -351,9 +563,9 @@ int main (int argc, char *argv[])
         cerr << "Cannot initialize the camera device" << endl;
         return 1;
     }
-    if (argc >= 3)
+    if (positional.size() >= 2)
     {
-        royale::String cfgFile (argv[2]);
+        royale::String cfgFile (positional[1]);
 
         if (!royale::common::fileexists (cfgFile))
         {
@@ -383,7 +595,41 @@ int main (int argc, char *argv[])
     // was recorded at 5FPS will generate callbacks to onNewData() at only 5 callbacks per second.
     replayControls->useTimestamps (false);
 
-    auto fileName = getFileName (argv[1]);
+    // Restrict the playback to the requested frames, the frames before the range are skipped
+    // by seeking, and the playback stops at the end of the range, so neither is read from the
+    // file or processed
+    auto numFrames = replayControls->frameCount();
+    if (lastFrame == 0u)
+    {
+        lastFrame = numFrames;
+    }
+    if (firstFrame == 0u)
+    {
+        firstFrame = 1u;
+    }
+    if (firstFrame > lastFrame || lastFrame > numFrames)
+    {
+        cerr << "The frame range " << firstFrame << " to " << lastFrame << " is outside of the recording, which has "
+             << numFrames << " frames" << endl;
+        return 1;
+    }
+    if (replayControls->setPlaybackRange (firstFrame - 1, lastFrame) != royale::CameraStatus::SUCCESS)
+    {
+        cerr << "Error setting the playback range" << endl;
+        return 1;
+    }
+    if (firstFrame > 1u)
+    {
+        // This is done before the listener is registered, seeking while not capturing plays
+        // back the frame once, which would otherwise be exported twice
+        if (replayControls->seek (firstFrame - 1) != royale::CameraStatus::SUCCESS)
+        {
+            cerr << "Error seeking to frame " << firstFrame << endl;
+            return 1;
+        }
+    }
+
+    auto fileName = getFileName (rrfFile);
 
 #ifdef ROYALE_TARGET_PLATFORM_WINDOWS
     _mkdir (fileName.c_str());
@@ -394,8 +640,6 @@ int main (int argc, char *argv[])
     royale::Vector<royale::StreamId> streamIds;
     cameraDevice->getStreams (streamIds);
 
-    auto numFrames = replayControls->frameCount();
-
     std::map<royale::StreamId, bool> irModes;
 
     for (auto curStream : streamIds)
@@ -421,9 +665,10 @@ int main (int argc, char *argv[])
         }
     }
 
+    pool.reset (new ExportPool (fileName, binaryPly, numJobs));
+
     // Create and register the data listener
-    listener.reset (new MyListener (argv[1], fileName, numFrames,
-                                    irModes));
+    listener.reset (new MyListener (*pool, firstFrame, lastFrame, irModes));
     if (cameraDevice->registerDataListenerExtended (listener.get()) != royale::CameraStatus::SUCCESS)
     {
         cerr << "Error registering extended data listener" << endl;
@@ -451,5 +696,8 @@ int main (int argc, char *argv[])
         return 1;
     }
 
+    // wait until the workers have written the remaining frames
+    pool->finish();
+
     return 0;
 }